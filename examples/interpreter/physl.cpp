@@ -133,28 +133,37 @@ std::tuple<bool, std::string> get_env_physl_ir()
 ///////////////////////////////////////////////////////////////////////////////
 void dump_ast(std::vector<phylanx::ast::expression> const& ast, std::string path)
 {
-    std::ofstream ast_stream(path, std::ios::binary);
-    if (!ast_stream.good())
+    // Write the AST in its flat binary encoding, this can be loaded without
+    // any per-node allocation
+    phylanx::ast::flat_ast(ast).save(path);
+}
+
+// Load an AST dump, the flat encoding is used in place and is compiled
+// without expanding it (see compile_and_run)
+void load_ast_buffer(std::vector<char> bytes,
+    std::vector<phylanx::ast::expression>& ast,
+    phylanx::ast::flat_ast& flat)
+{
+    if (phylanx::ast::flat_ast::is_flat_ast(bytes.data(), bytes.size()))
     {
-        HPX_THROW_EXCEPTION(hpx::filesystem_error,
-            "dump_ast",
-            "Failed to open the specified file: " + path);
+        flat = phylanx::ast::flat_ast::from_buffer(std::move(bytes));
+        return;
     }
 
-    // Serialize the AST into a byte array
-    std::vector<char> bytes = phylanx::util::serialize(ast);
-
-    // char is 1 byte
-    ast_stream.write(bytes.data(), bytes.size());
+    // AST dumps written by older versions use the HPX serialization
+    ast = phylanx::util::unserialize<std::vector<phylanx::ast::expression>>(
+        std::move(bytes));
 }
 
-std::vector<phylanx::ast::expression> load_ast_dump(std::string const& path)
+void load_ast_dump(std::string const& path,
+    std::vector<phylanx::ast::expression>& ast,
+    phylanx::ast::flat_ast& flat)
 {
     std::ifstream ast_stream(path, std::ios::binary | std::ios::ate);
     if (!ast_stream.good())
     {
         HPX_THROW_EXCEPTION(hpx::filesystem_error,
-            "dump_ast",
+            "load_ast",
             "Failed to open the specified file: " + path);
     }
 
@@ -168,12 +177,33 @@ std::vector<phylanx::ast::expression> load_ast_dump(std::string const& path)
             "Failed to read the specified file: " + path);
     }
 
+    // Check for the flat encoding, which is memory-mapped
+    char magic[sizeof(phylanx::ast::flat_ast::header)];
+    if (std::size_t(data_size) >= sizeof(magic) &&
+        ast_stream.read(magic, sizeof(magic)) &&
+        phylanx::ast::flat_ast::is_flat_ast(magic, sizeof(magic)))
+    {
+        flat = phylanx::ast::flat_ast::load(path);
+        return;
+    }
+
     // Allocate all the memory needed to load the AST upfront
-    std::vector<char> bytes;
-    bytes.reserve(data_size);
+    std::vector<char> bytes(data_size);
+    if (!ast_stream.seekg(0, std::ios::beg) ||
+        !ast_stream.read(bytes.data(), bytes.size()))
+    {
+        HPX_THROW_EXCEPTION(hpx::filesystem_error,
+            "load_ast",
+            "Failed to read the specified file: " + path);
+    }
 
-    return phylanx::util::unserialize<std::vector<phylanx::ast::expression>>(
-        std::move(bytes));
+    load_ast_buffer(std::move(bytes), ast, flat);
+}
+
+// Return whether the code was loaded from a dump in the flat encoding
+bool is_flat_ast_loaded(phylanx::ast::flat_ast const& flat)
+{
+    return flat.data() != nullptr;
 }
 
 void print_physl_code(std::vector<phylanx::ast::expression> const& ast)
@@ -246,6 +276,8 @@ int handle_command_line(int argc, char* argv[], po::variables_map& vm)
                 "of the created execution tree as a Newick tree to a file")
             ("transform,t", po::value<std::string>(),
                 "file to read transformation rules from")
+            ("transform-statistics", "Print how often each of the "
+                "transformation rules was applied")
             ("no-ast-env,e", po::value<std::string>()->implicit_value("<none>"),
                 "do not check PHYSL_IR for PhySL code")
             ("base64,b", po::value<std::string>()->implicit_value("<none>"),
@@ -322,9 +354,11 @@ std::string get_dump_file(po::variables_map const& vm,
     return dump_file;
 }
 
+// A dump in the flat encoding is returned in 'flat' and is expanded into
+// the returned AST only if it has to be transformed
 std::vector<phylanx::ast::expression> ast_from_code_or_dump(
     po::variables_map const& vm, std::vector<std::string>& positional_args,
-    std::string& code_source_name)
+    std::string& code_source_name, phylanx::ast::flat_ast& flat)
 {
     // Return value
     std::vector<phylanx::ast::expression> ast;
@@ -338,7 +372,9 @@ std::vector<phylanx::ast::expression> ast_from_code_or_dump(
         auto physl_ir = get_env_physl_ir();
         physl_ir_env_found = std::get<0>(physl_ir);
         if(physl_ir_env_found) {
-            ast = load_ast_dump(std::get<1>(physl_ir));
+            std::string const& ir = std::get<1>(physl_ir);
+            load_ast_buffer(
+                std::vector<char>(ir.begin(), ir.end()), ast, flat);
             code_source_name = "<environment_variable>";
         }
     }
@@ -363,7 +399,7 @@ std::vector<phylanx::ast::expression> ast_from_code_or_dump(
         }
 
         std::string ast_dump_file = vm["load-ast"].as<std::string>();
-        ast = load_ast_dump(ast_dump_file);
+        load_ast_dump(ast_dump_file, ast, flat);
         code_source_name = fs::path(ast_dump_file).filename().string();
     }
     // Read PhySL source code from a file or the provided argument
@@ -401,11 +437,25 @@ std::vector<phylanx::ast::expression> ast_from_code_or_dump(
     // Apply transformation rules to AST, if requested
     if (vm.count("transform") != 0)
     {
+        if (is_flat_ast_loaded(flat))
+        {
+            ast = flat.expressions();
+            flat = phylanx::ast::flat_ast{};
+        }
+
         std::string const transform_rules =
             read_user_code(vm["transform"].as<std::string>());
 
-        ast = phylanx::ast::transform_ast(
-            ast, phylanx::ast::generate_transform_rules(transform_rules));
+        phylanx::ast::rule_set rules(
+            phylanx::ast::generate_transform_rules(transform_rules));
+        rules.apply(ast);
+
+        if (vm.count("transform-statistics") != 0)
+        {
+            std::ostringstream strm;
+            rules.print_statistics(strm);
+            hpx::cout << strm.str() << std::flush;
+        }
     }
 
     // Dump the AST to a file, if requested
@@ -413,7 +463,14 @@ std::vector<phylanx::ast::expression> ast_from_code_or_dump(
     {
         std::string dump_file =
             get_dump_file(vm, std::move(code_source_path), code_is_file);
-        dump_ast(ast, std::move(dump_file));
+        if (is_flat_ast_loaded(flat))
+        {
+            flat.save(dump_file);
+        }
+        else
+        {
+            dump_ast(ast, std::move(dump_file));
+        }
     }
 
     return ast;
@@ -421,6 +478,7 @@ std::vector<phylanx::ast::expression> ast_from_code_or_dump(
 
 phylanx::execution_tree::compiler::result_type compile_and_run(
     std::vector<phylanx::ast::expression> const& ast,
+    phylanx::ast::flat_ast const& flat,
     std::vector<std::string> const& positional_args,
     phylanx::execution_tree::compiler::function_list& snippets,
     std::string const& code_source_name, bool dry_run, bool print_time)
@@ -441,8 +499,12 @@ phylanx::execution_tree::compiler::result_type compile_and_run(
     phylanx::execution_tree::eval_context ctx;
     def.run(ctx);
 
-    auto const& code = phylanx::execution_tree::compile(
-        code_source_name, ast, snippets, env);
+    // A loaded flat AST is compiled in place, one expression at a time
+    auto const& code = is_flat_ast_loaded(flat) ?
+        phylanx::execution_tree::compile(
+            code_source_name, flat, snippets, env) :
+        phylanx::execution_tree::compile(
+            code_source_name, ast, snippets, env);
 
     // Re-init all performance counters to guarantee correct measurement
     // results if those are requested on the command line.
@@ -600,24 +662,37 @@ void interpreter(po::variables_map const& vm)
 
     // The AST that is either generated from PhySL code or loaded from an AST
     // dump. This also sets the name of the source code 'code_source_name'.
+    phylanx::ast::flat_ast flat;
     std::vector<phylanx::ast::expression> ast =
-        ast_from_code_or_dump(vm, positional_args, code_source_name);
+        ast_from_code_or_dump(vm, positional_args, code_source_name, flat);
 
-    // Dump the code that is to be executed to the standard output, if requested
-    if (vm.count("print-code") != 0)
+    if (vm.count("print-code") != 0 || vm.count("dump-code") != 0)
     {
-        print_physl_code(ast);
-    }
+        // A loaded flat AST is expanded for printing only
+        std::vector<phylanx::ast::expression> expanded;
+        if (is_flat_ast_loaded(flat))
+        {
+            expanded = flat.expressions();
+        }
+        auto const& code = is_flat_ast_loaded(flat) ? expanded : ast;
 
-    // Dump the code that is to be executed to a file, if requested
-    if (vm.count("dump-code") != 0)
-    {
-        std::string const physl_file = vm["dump-code"].as<std::string>();
-        dump_physl_code(ast, physl_file);
+        // Dump the code that is to be executed to the standard output, if
+        // requested
+        if (vm.count("print-code") != 0)
+        {
+            print_physl_code(code);
+        }
+
+        // Dump the code that is to be executed to a file, if requested
+        if (vm.count("dump-code") != 0)
+        {
+            std::string const physl_file = vm["dump-code"].as<std::string>();
+            dump_physl_code(code, physl_file);
+        }
     }
 
     phylanx::execution_tree::compiler::function_list snippets;
-    auto const result = compile_and_run(ast, positional_args, snippets,
+    auto const result = compile_and_run(ast, flat, positional_args, snippets,
         code_source_name, vm.count("dry-run") != 0, vm.count("time") != 0);
 
     // Print the result of the last PhySL expression, if requested
@@ -0,0 +1,181 @@
+//  Copyright (c) 2019 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#if !defined(PHYLANX_AST_FLAT_AST_HPP)
+#define PHYLANX_AST_FLAT_AST_HPP
+
+#include <phylanx/config.hpp>
+#include <phylanx/ast/node.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace phylanx { namespace ast
+{
+    ///////////////////////////////////////////////////////////////////////////
+    /// Compact binary representation of a list of ASTs.
+    ///
+    /// All nodes are stored in a single array and refer to their children by
+    /// index (through a separate child table), names and string literals are
+    /// interned in a string table, and the values of numeric literals are
+    /// stored in a data section of 8-byte words. The encoding does not
+    /// contain any pointers, a file holding it can be memory-mapped and used
+    /// in place without allocating anything per node.
+    class flat_ast
+    {
+    public:
+        enum class node_kind : std::uint8_t
+        {
+            expression = 0,     // children: operand, operations...
+            operation = 1,      // op, children: operand
+            unary_expr = 2,     // op, children: operand
+            nil = 3,
+            boolean = 4,        // value: 0 or 1
+            identifier = 5,     // value: name
+            string = 6,         // value: string
+            double_data = 7,    // value: data offset, dimensions
+            int64_data = 8,     // value: data offset, dimensions
+            parenthesized = 9,  // children: expression
+            function_call = 10, // value: name, extra: attribute,
+                                // children: argument expressions
+            list = 11           // children: expressions
+        };
+
+        /// A single AST node. Positions are -1 if the node was not tagged.
+        struct node
+        {
+            node_kind kind;
+            std::uint8_t op;            // optoken of unary_expr and operation
+            std::uint8_t dimensions;    // dimensionality of numeric data
+            std::uint8_t reserved;
+            std::int32_t line;
+            std::int32_t column;
+            std::uint32_t value;        // string id or data offset
+            std::uint32_t extra;        // attribute string id
+            std::uint32_t first_child;  // index into the child table
+            std::uint32_t child_count;
+        };
+
+        /// Layout of the binary encoding, all sections follow the header in
+        /// this order, each of them aligned to 8 bytes: data words, nodes,
+        /// child table, string offsets (string_count + 1 entries), and the
+        /// characters of all strings.
+        struct header
+        {
+            char magic[8];
+            std::uint32_t version;
+            std::uint32_t byte_order;
+            std::uint32_t data_count;
+            std::uint32_t node_count;
+            std::uint32_t child_count;
+            std::uint32_t string_count;
+            std::uint32_t string_bytes;
+            std::uint32_t root_first;   // roots are stored in the child table
+            std::uint32_t root_count;
+            std::uint32_t reserved;
+        };
+
+        flat_ast() = default;
+
+        /// Encode the given ASTs
+        PHYLANX_EXPORT explicit flat_ast(
+            std::vector<ast::expression> const& exprs);
+
+        /// Use the given encoded data, the buffer is verified
+        PHYLANX_EXPORT static flat_ast from_buffer(std::vector<char> buffer);
+
+        /// Load the encoded data from a file, the file is memory-mapped if
+        /// possible and verified
+        PHYLANX_EXPORT static flat_ast load(std::string const& path);
+
+        /// Write the encoded data to a file
+        PHYLANX_EXPORT void save(std::string const& path) const;
+
+        /// Return whether the given bytes start with the header of an
+        /// encoded AST
+        PHYLANX_EXPORT static bool is_flat_ast(
+            char const* data, std::size_t size);
+
+        ///////////////////////////////////////////////////////////////////////
+        // raw access to the encoded data
+        char const* data() const
+        {
+            return data_;
+        }
+        std::size_t size() const
+        {
+            return size_;
+        }
+
+        std::size_t root_count() const
+        {
+            return header_ != nullptr ? header_->root_count : 0;
+        }
+        std::size_t node_count() const
+        {
+            return header_ != nullptr ? header_->node_count : 0;
+        }
+        std::size_t string_count() const
+        {
+            return header_ != nullptr ? header_->string_count : 0;
+        }
+
+        node const& root(std::size_t i) const
+        {
+            return nodes_[children_[header_->root_first + i]];
+        }
+        node const& get_node(std::uint32_t index) const
+        {
+            return nodes_[index];
+        }
+        node const& child(node const& n, std::size_t i) const
+        {
+            return nodes_[children_[n.first_child + i]];
+        }
+
+        PHYLANX_EXPORT std::string get_string(std::uint32_t id) const;
+
+        /// Return whether the string with the given id is equal to the given
+        /// one (without copying the string)
+        PHYLANX_EXPORT bool string_equals(
+            std::uint32_t id, char const* str) const;
+
+        ///////////////////////////////////////////////////////////////////////
+        /// Convert the given top-level expression back into the tree based
+        /// representation
+        PHYLANX_EXPORT ast::expression expression(std::size_t root) const;
+
+        /// Convert all top-level expressions
+        PHYLANX_EXPORT std::vector<ast::expression> expressions() const;
+
+    private:
+        void attach(std::shared_ptr<void const> storage, char const* data,
+            std::size_t size, char const* source);
+
+        ast::expression expand_expression(node const& n) const;
+        ast::operand expand_operand(node const& n) const;
+        ast::primary_expr expand_primary(node const& n) const;
+        template <typename T>
+        ast::primary_expr expand_data(node const& n) const;
+
+        // keeps the encoded data alive (a buffer or a memory mapping)
+        std::shared_ptr<void const> storage_;
+
+        char const* data_ = nullptr;
+        std::size_t size_ = 0;
+
+        header const* header_ = nullptr;
+        std::uint64_t const* words_ = nullptr;
+        node const* nodes_ = nullptr;
+        std::uint32_t const* children_ = nullptr;
+        std::uint32_t const* string_offsets_ = nullptr;
+        char const* strings_ = nullptr;
+    };
+}}
+
+#endif
@@ -25,6 +25,12 @@ namespace phylanx { namespace ast
     /// Parse the given string and convert it into a list of AST instances
     PHYLANX_EXPORT std::vector<ast::expression> generate_ast(
         std::string const& input);
+
+    /// Parse the given string using the Spirit based grammar. This is slower
+    /// than generate_ast (it needs a second pass over the AST to compute the
+    /// line/column information) but produces identical results.
+    PHYLANX_EXPORT std::vector<ast::expression> generate_ast_qi(
+        std::string const& input);
 }}
 
 #endif
@@ -0,0 +1,27 @@
+//  Copyright (c) 2019 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#if !defined(PHYLANX_AST_PARSER_PHYSL_PARSER_HPP)
+#define PHYLANX_AST_PARSER_PHYSL_PARSER_HPP
+
+#include <phylanx/config.hpp>
+#include <phylanx/ast/node.hpp>
+
+#include <string>
+#include <vector>
+
+namespace phylanx { namespace ast { namespace parser
+{
+    ///////////////////////////////////////////////////////////////////////////
+    /// Parse the given PhySL code in a single pass. This accepts the same
+    /// language as the Spirit grammar (see expression_def.hpp) and produces
+    /// identical ASTs, but it tags the nodes with their line/column while
+    /// scanning and converts numeric array literals directly into their
+    /// node_data storage.
+    PHYLANX_EXPORT std::vector<ast::expression> parse_physl(
+        std::string const& input);
+}}}
+
+#endif
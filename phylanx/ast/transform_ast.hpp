@@ -1,4 +1,4 @@
-//  Copyright (c) 2017 Hartmut Kaiser
+//  Copyright (c) 2017-2019 Hartmut Kaiser
 //
 //  Distributed under the Boost Software License, Version 1.0. (See accompanying
 //  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
@@ -9,8 +9,13 @@
 #include <phylanx/config.hpp>
 #include <phylanx/ast/node.hpp>
 
-#include <vector>
+#include <array>
+#include <cstddef>
+#include <iosfwd>
+#include <map>
+#include <string>
 #include <utility>
+#include <vector>
 
 namespace phylanx { namespace ast
 {
@@ -37,6 +42,101 @@ namespace phylanx { namespace ast
     PHYLANX_EXPORT std::vector<expression> transform_ast(
         std::vector<expression> const& in,
         std::vector<transform_rule> const& rules);
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// Statistics collected while applying a rule_set
+    struct transform_statistics
+    {
+        std::size_t expressions_visited = 0;    // expression nodes inspected
+        std::size_t match_attempts = 0;         // invocations of match_ast
+        std::size_t rewrites = 0;               // successful rule applications
+        std::vector<std::size_t> applications;  // rewrites per rule
+    };
+
+    /// A set of transformation rules which are applied to an AST until none
+    /// of them matches anymore.
+    ///
+    /// The rules are indexed by the head symbol of their match expressions
+    /// (the leading operator of binary expressions, the operator of unary
+    /// expressions, the name and number of arguments of function calls, or
+    /// the name of an identifier). Only the rules sharing the head symbol of
+    /// an expression node (and the rules which may match any node) are tried
+    /// for that node. The AST is rewritten in place, bottom-up: all nested
+    /// expressions are transformed before the expression containing them,
+    /// and the result of a rewrite is transformed again. If more than one
+    /// rule matches an expression, the rule listed first is applied.
+    class rule_set
+    {
+    public:
+        /// Build the index for the given rules. A top-level expression may be
+        /// rewritten at most max_rewrites times, exceeding this number is
+        /// reported as an error as the rules most likely do not terminate.
+        PHYLANX_EXPORT explicit rule_set(std::vector<transform_rule> rules,
+            std::size_t max_rewrites = 10000);
+
+        /// Apply the rules to the given expression, return whether it was
+        /// modified
+        PHYLANX_EXPORT bool apply(expression& expr);
+
+        /// Apply the rules to all of the given expressions, return whether
+        /// any of them was modified
+        PHYLANX_EXPORT bool apply(std::vector<expression>& exprs);
+
+        std::vector<transform_rule> const& rules() const
+        {
+            return rules_;
+        }
+
+        transform_statistics const& statistics() const
+        {
+            return statistics_;
+        }
+        PHYLANX_EXPORT void reset_statistics();
+
+        /// Print the collected statistics, one line per applied rule
+        PHYLANX_EXPORT void print_statistics(std::ostream& os) const;
+
+    private:
+        using rule_indices = std::vector<std::size_t>;
+
+        void add_to_index(std::size_t rule, expression const& match);
+        void collect_candidates(expression const& expr);
+        void append_candidates(rule_indices const& rules);
+
+        bool rewrite(expression& expr, std::size_t& budget);
+        bool rewrite_children(expression& expr, std::size_t& budget);
+        bool rewrite_children(operand& op, std::size_t& budget);
+        bool rewrite_children(primary_expr& pe, std::size_t& budget);
+
+        std::vector<transform_rule> rules_;
+        std::size_t max_rewrites_;
+
+        // rules whose match expression may match any expression
+        rule_indices any_rules_;
+
+        // rules indexed by the leading operator of binary expressions and
+        // by the operator of unary expressions
+        static constexpr std::size_t num_optokens =
+            std::size_t(optoken::op_unknown) + 1;
+        std::array<rule_indices, num_optokens> binary_rules_;
+        std::array<rule_indices, num_optokens> unary_rules_;
+
+        // rules indexed by function name and number of arguments, and rules
+        // matching any function name
+        struct call_rules
+        {
+            std::map<std::size_t, rule_indices> by_arity;
+            rule_indices variadic;      // arguments contain ellipses
+        };
+        std::map<std::string, call_rules> call_rules_;
+        rule_indices any_call_rules_;
+
+        // rules indexed by identifier name
+        std::map<std::string, rule_indices> identifier_rules_;
+
+        rule_indices candidates_;
+        transform_statistics statistics_;
+    };
 }}
 
 #endif
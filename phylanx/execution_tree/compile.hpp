@@ -1,4 +1,4 @@
-//  Copyright (c) 2017-2018 Hartmut Kaiser
+//  Copyright (c) 2017-2019 Hartmut Kaiser
 //
 //  Distributed under the Boost Software License, Version 1.0. (See accompanying
 //  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
@@ -7,12 +7,16 @@
 #define PHYLANX_EXECUTION_TREE_COMPILE_HPP
 
 #include <phylanx/config.hpp>
+#include <phylanx/ast/flat_ast.hpp>
 #include <phylanx/ast/node.hpp>
 #include <phylanx/execution_tree/primitives/base_primitive.hpp>
 #include <phylanx/execution_tree/compiler/compiler.hpp>
+#include <phylanx/execution_tree/compiler/specialization.hpp>
 
 #include <hpx/include/naming.hpp>
 
+#include <cstddef>
+#include <memory>
 #include <string>
 #include <vector>
 
@@ -110,6 +114,34 @@ namespace phylanx { namespace execution_tree
         compiler::function_list& snippets, compiler::environment& env,
         hpx::id_type const& default_locality = hpx::find_here());
 
+    /// Compile the expressions stored in the given flat AST. Every top-level
+    /// expression is expanded only while it is being compiled. Reuse the
+    /// given compilation environment.
+    PHYLANX_EXPORT compiler::entry_point const& compile(
+        std::string const& name, ast::flat_ast const& ast,
+        compiler::function_list& snippets, compiler::environment& env,
+        hpx::id_type const& default_locality = hpx::find_here());
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// Compile the given code and return a function object for the function
+    /// \a func_name defined by it. The returned function compiles a separate
+    /// variant of itself for each argument signature (dtype and
+    /// dimensionality of all arguments, arguments of different extents share
+    /// a variant) it is invoked with and caches it, falling back to the
+    /// generic tree for non-numeric arguments or once \a max_variants has
+    /// been reached. A variant is compiled with the types of the arguments
+    /// of \a func_name known, which allows the compiler to select the typed
+    /// variants of the operations whose dtype follows from them (see
+    /// compiler::type_inference). The variants are compiled into environments
+    /// nested into \a env, both \a env and \a snippets have to outlive the
+    /// returned object.
+    PHYLANX_EXPORT std::shared_ptr<compiler::specialized_function>
+    compile_specialized(std::string const& name, std::string const& expr,
+        std::string const& func_name, compiler::function_list& snippets,
+        compiler::environment& env, eval_context ctx,
+        std::size_t max_variants = 16,
+        hpx::id_type const& default_locality = hpx::find_here());
+
     ///////////////////////////////////////////////////////////////////////////
     /// Add the given variable to the compilation environment
     PHYLANX_EXPORT compiler::function define_variable(
@@ -7,6 +7,7 @@
 #define PHYLANX_EXECUTION_TREE_ACTORS_HPP
 
 #include <phylanx/config.hpp>
+#include <phylanx/execution_tree/compiler/type_inference.hpp>
 #include <phylanx/execution_tree/primitives/base_primitive.hpp>
 
 #include <hpx/include/util.hpp>
@@ -532,6 +533,7 @@ namespace phylanx { namespace execution_tree { namespace compiler
         std::size_t compile_id_;    // sequence number of this compiler invocation
         program program_;           // storage for top-level code
         std::map<std::string, std::size_t> sequence_numbers_;
+        type_inference types_;      // statically known shapes and dtypes
     };
 
     ///////////////////////////////////////////////////////////////////////////
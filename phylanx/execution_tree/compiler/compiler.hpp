@@ -468,16 +468,18 @@ namespace phylanx { namespace execution_tree { namespace compiler
         {}
 
         template <typename F>
-        compiled_function* define_variable(std::string name, F&& f)
+        compiled_function* define_variable(std::string const& name, F&& f)
         {
-            auto existing = definitions_.find(name);
+            util::hashed_string key(name);
+
+            auto existing = definitions_.find(key);
             if (existing != definitions_.end())
             {
                 definitions_.erase(existing);
             }
 
-            auto result = definitions_.emplace(value_type(
-                std::move(name), compiled_function(std::forward<F>(f))));
+            auto result = definitions_.emplace(
+                value_type(key, compiled_function(std::forward<F>(f))));
 
             if (!result.second)
             {
@@ -490,16 +492,18 @@ namespace phylanx { namespace execution_tree { namespace compiler
         }
 
         template <typename F>
-        compiled_function* define(std::string name, F&& f)
+        compiled_function* define(std::string const& name, F&& f)
         {
-            auto existing = definitions_.find(name);
+            util::hashed_string key(name);
+
+            auto existing = definitions_.find(key);
             if (existing != definitions_.end())
             {
                 definitions_.erase(existing);
             }
 
-            auto result = definitions_.emplace(value_type(
-                std::move(name), compiled_function(std::forward<F>(f))));
+            auto result = definitions_.emplace(
+                value_type(key, compiled_function(std::forward<F>(f))));
 
             if (!result.second)
             {
@@ -511,7 +515,9 @@ namespace phylanx { namespace execution_tree { namespace compiler
             return &result.first->second;
         }
 
-        compiled_function* find(std::string const& name)
+        // names are interned once, the lookup in the enclosing environments
+        // compares symbols only
+        compiled_function* find(util::hashed_string const& name)
         {
             iterator it = definitions_.find(name);
             if (it != definitions_.end())
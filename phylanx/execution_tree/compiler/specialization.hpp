@@ -0,0 +1,212 @@
+// Copyright (c) 2019 Hartmut Kaiser
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#if !defined(PHYLANX_EXECUTION_TREE_SPECIALIZATION_HPP)
+#define PHYLANX_EXECUTION_TREE_SPECIALIZATION_HPP
+
+#include <phylanx/config.hpp>
+#include <phylanx/execution_tree/compiler/actors.hpp>
+#include <phylanx/execution_tree/compiler/type_inference.hpp>
+#include <phylanx/execution_tree/primitives/base_primitive.hpp>
+
+#include <hpx/lcos/local/mutex.hpp>
+#include <hpx/include/util.hpp>
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <iosfwd>
+#include <list>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace phylanx { namespace execution_tree { namespace compiler
+{
+    ///////////////////////////////////////////////////////////////////////////
+    // The signature of a single argument consists of the type of the value
+    // stored in the argument (the variant index, which implies the dtype for
+    // numeric values) and its dimensionality. The extents are not part of
+    // the signature, a variant serves all shapes of the same rank.
+    struct argument_signature_entry
+    {
+        std::uint8_t index_;
+        std::uint8_t ndim_;
+
+        friend bool operator==(argument_signature_entry const& lhs,
+            argument_signature_entry const& rhs)
+        {
+            return lhs.index_ == rhs.index_ && lhs.ndim_ == rhs.ndim_;
+        }
+    };
+
+    // The signatures of all arguments of an invocation. This is extracted
+    // for every call of a specialized function, it is stored in place to
+    // avoid allocating memory.
+    class argument_signature
+    {
+    public:
+        static constexpr std::size_t max_arguments = 16;
+
+        using const_iterator = argument_signature_entry const*;
+
+        argument_signature()
+          : size_(0)
+        {
+        }
+
+        std::size_t size() const
+        {
+            return size_;
+        }
+        const_iterator begin() const
+        {
+            return entries_.data();
+        }
+        const_iterator end() const
+        {
+            return entries_.data() + size_;
+        }
+
+        void clear()
+        {
+            size_ = 0;
+        }
+
+        // return false if the maximal number of arguments was exceeded
+        bool push_back(argument_signature_entry const& entry)
+        {
+            if (size_ == max_arguments)
+            {
+                return false;
+            }
+            entries_[size_++] = entry;
+            return true;
+        }
+
+        friend bool operator==(
+            argument_signature const& lhs, argument_signature const& rhs)
+        {
+            return lhs.size_ == rhs.size_ &&
+                std::equal(lhs.begin(), lhs.end(), rhs.begin());
+        }
+        friend bool operator!=(
+            argument_signature const& lhs, argument_signature const& rhs)
+        {
+            return !(lhs == rhs);
+        }
+
+    private:
+        std::array<argument_signature_entry, max_arguments> entries_;
+        std::size_t size_;
+    };
+
+    /// Extract the signature of the given arguments. Return false if any of
+    /// the arguments does not hold a numeric value (nil, strings, lists,
+    /// dictionaries, or functions) or if there are more than
+    /// argument_signature::max_arguments arguments, in which case no
+    /// specialization is possible.
+    PHYLANX_EXPORT bool extract_argument_signature(
+        arguments_type const& args, argument_signature& sig);
+
+    PHYLANX_EXPORT std::ostream& operator<<(
+        std::ostream& os, argument_signature const& sig);
+
+    /// Convert the given signature into the argument types assumed while
+    /// compiling a variant.
+    PHYLANX_EXPORT std::vector<inferred_type> inferred_argument_types(
+        argument_signature const& sig);
+
+    ///////////////////////////////////////////////////////////////////////////
+    // A function that holds variants of itself, each compiled separately for
+    // a particular argument signature. The variants are created on first
+    // invocation with a new signature using the supplied compile function.
+    // Invocations with arguments that can't be specialized on, or after the
+    // maximum number of variants was reached, fall back to the generic
+    // function.
+    //
+    // Selecting the variant for an invocation does not take any locks. The
+    // known variants are kept in an immutable table which is replaced (and
+    // published through an atomic pointer) whenever a variant is added.
+    // Replaced tables are kept alive as long as the function exists, as
+    // invocations may still be searching them. There are at most
+    // max_variants of them.
+    class specialized_function
+    {
+    public:
+        using compile_function =
+            hpx::util::function_nonser<function(argument_signature const&)>;
+
+        PHYLANX_EXPORT specialized_function(function generic,
+            compile_function compile, std::size_t max_variants = 16);
+
+        specialized_function(specialized_function const&) = delete;
+        specialized_function& operator=(specialized_function const&) = delete;
+
+        PHYLANX_EXPORT result_type operator()(
+            arguments_type&& args, eval_context ctx) const;
+
+        /// Return the function to use for the given arguments, compile a new
+        /// variant if needed.
+        PHYLANX_EXPORT function const& select(arguments_type const& args) const;
+
+        function const& generic() const
+        {
+            return generic_;
+        }
+
+        std::size_t num_variants() const
+        {
+            return variants_.load(std::memory_order_acquire)->size();
+        }
+
+        // number of invocations which were served by a specialized variant
+        std::int64_t specialized_calls() const
+        {
+            return specialized_calls_.load(std::memory_order_relaxed);
+        }
+
+        // number of invocations which fell back to the generic function
+        std::int64_t generic_calls() const
+        {
+            return generic_calls_.load(std::memory_order_relaxed);
+        }
+
+    private:
+        using compile_mutex_type = hpx::lcos::local::mutex;
+
+        struct variant
+        {
+            argument_signature signature_;
+            function const* function_;
+        };
+        using variants_table = std::vector<variant>;
+
+        static function const* find_variant(
+            variants_table const& variants, argument_signature const& sig);
+
+        function const& generic_call() const;
+
+        function generic_;
+        compile_function compile_;
+        std::size_t max_variants_;
+
+        // the current table of variants
+        mutable std::atomic<variants_table const*> variants_;
+
+        // the compiled variants and all tables ever published, these are
+        // modified while holding compile_mtx_ only
+        mutable compile_mutex_type compile_mtx_;
+        mutable std::list<function> functions_;
+        mutable std::list<variants_table> tables_;
+
+        mutable std::atomic<std::int64_t> specialized_calls_;
+        mutable std::atomic<std::int64_t> generic_calls_;
+    };
+}}}
+
+#endif
@@ -0,0 +1,175 @@
+// Copyright (c) 2019 Hartmut Kaiser
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#if !defined(PHYLANX_EXECUTION_TREE_TYPE_INFERENCE_HPP)
+#define PHYLANX_EXECUTION_TREE_TYPE_INFERENCE_HPP
+
+#include <phylanx/config.hpp>
+#include <phylanx/ast/flat_ast.hpp>
+#include <phylanx/ast/node.hpp>
+#include <phylanx/execution_tree/primitives/node_data_helpers.hpp>
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <iosfwd>
+#include <map>
+#include <set>
+#include <string>
+#include <tuple>
+#include <vector>
+
+namespace phylanx { namespace execution_tree { namespace compiler
+{
+    ///////////////////////////////////////////////////////////////////////////
+    // The statically known part of the type of a value: its dtype, its
+    // dimensionality, and its shape. Each of those may be unknown, in which
+    // case it has to be determined at runtime.
+    struct inferred_type
+    {
+        static constexpr std::int64_t unknown = -1;
+
+        inferred_type()
+          : dtype(node_data_type_unknown)
+          , ndim(unknown)
+        {
+            dims.fill(unknown);
+        }
+
+        explicit inferred_type(node_data_type dtype_,
+                std::int64_t ndim_ = unknown)
+          : dtype(dtype_)
+          , ndim(ndim_)
+        {
+            dims.fill(unknown);
+        }
+
+        bool has_dtype() const
+        {
+            return dtype != node_data_type_unknown;
+        }
+        bool has_ndim() const
+        {
+            return ndim != unknown;
+        }
+
+        // all dimensions are known
+        bool has_shape() const
+        {
+            if (!has_ndim())
+            {
+                return false;
+            }
+            for (std::int64_t i = 0; i != ndim; ++i)
+            {
+                if (dims[i] == unknown)
+                {
+                    return false;
+                }
+            }
+            return true;
+        }
+
+        // nothing is known about the value
+        bool is_unknown() const
+        {
+            return !has_dtype() && !has_ndim();
+        }
+
+        friend bool operator==(
+            inferred_type const& lhs, inferred_type const& rhs)
+        {
+            return lhs.dtype == rhs.dtype && lhs.ndim == rhs.ndim &&
+                lhs.dims == rhs.dims;
+        }
+        friend bool operator!=(
+            inferred_type const& lhs, inferred_type const& rhs)
+        {
+            return !(lhs == rhs);
+        }
+
+        node_data_type dtype;
+        std::int64_t ndim;
+        std::array<std::int64_t, PHYLANX_MAX_DIMENSIONS> dims;
+    };
+
+    PHYLANX_EXPORT std::ostream& operator<<(
+        std::ostream& os, inferred_type const& t);
+
+    /// Combine the types of two values either of which may be produced at
+    /// runtime (e.g. the branches of an if), keeps what both agree on.
+    PHYLANX_EXPORT inferred_type join(
+        inferred_type const& lhs, inferred_type const& rhs);
+
+    ///////////////////////////////////////////////////////////////////////////
+    // Abstract interpretation of the expressions passed to the compiler.
+    //
+    // Shapes and dtypes are propagated from literals, constant(), random(),
+    // and annotated function arguments through variable definitions and the
+    // element-wise arithmetic and comparison operations, dot(), transpose(),
+    // block(), and if(). Everything else yields an unknown type. Operations
+    // whose operand shapes are known to be incompatible are reported before
+    // any code is executed. The compiler uses the inferred dtypes to select
+    // the typed variant of the element-wise arithmetic operations (see
+    // operation_dtype), which then skip determining the common type of their
+    // operands at runtime.
+    //
+    // Variables that are the target of a store() are never assumed to have
+    // a known type. Global variables may be modified by code compiled later,
+    // only their shape is assumed to be known.
+    class type_inference
+    {
+    public:
+        using key_type = std::tuple<std::int64_t, std::int64_t, std::string>;
+        using results_type = std::map<key_type, inferred_type>;
+
+        type_inference() = default;
+
+        type_inference(type_inference const&) = delete;
+        type_inference& operator=(type_inference const&) = delete;
+
+        /// Assume the given argument types while analyzing the definition of
+        /// the function with the given name.
+        PHYLANX_EXPORT void annotate(std::string const& function_name,
+            std::vector<inferred_type> args);
+        PHYLANX_EXPORT void clear_annotations();
+
+        /// Collect the names of all variables that are the target of a
+        /// store() operation in the given expressions.
+        PHYLANX_EXPORT void prescan(ast::expression const& expr);
+        PHYLANX_EXPORT void prescan(std::vector<ast::expression> const& exprs);
+        PHYLANX_EXPORT void prescan(ast::flat_ast const& flat);
+
+        /// Analyze the given top-level expression compiled with the given
+        /// compile id. Return the type of the expression, throws if it
+        /// contains operations with known incompatible operands.
+        PHYLANX_EXPORT inferred_type infer(std::string const& codename,
+            ast::expression const& expr, std::size_t compile_id);
+
+        /// Return the dtype an element-wise arithmetic operation created
+        /// for the node at the given position of the expression analyzed
+        /// last is known to be performed in (unknown otherwise).
+        PHYLANX_EXPORT node_data_type operation_dtype(std::size_t compile_id,
+            ast::tagged const& id, std::string const& name) const;
+
+        /// The types inferred for the last analyzed expression, indexed by
+        /// the position of the node and the name of the primitive.
+        results_type const& results() const
+        {
+            return results_;
+        }
+
+    private:
+        friend struct inference_visitor;
+
+        std::map<std::string, inferred_type> globals_;
+        std::map<std::string, std::vector<inferred_type>> annotations_;
+        std::set<std::string> stored_;
+        results_type results_;
+        std::size_t compile_id_ = std::size_t(-1);
+    };
+}}}
+
+#endif
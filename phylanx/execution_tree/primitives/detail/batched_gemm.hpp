@@ -0,0 +1,278 @@
+// Copyright (c) 2019 Hartmut Kaiser
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#if !defined(PHYLANX_DETAIL_BATCHED_GEMM_JUL_09_2019_0910AM)
+#define PHYLANX_DETAIL_BATCHED_GEMM_JUL_09_2019_0910AM
+
+#include <phylanx/config.hpp>
+
+#include <hpx/include/parallel_for_loop.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+#include <utility>
+
+namespace phylanx { namespace execution_tree { namespace detail
+{
+    ///////////////////////////////////////////////////////////////////////////
+    // Non-owning view of a (small) matrix with arbitrary strides. Transposing
+    // a view swaps the strides, no data is moved.
+    template <typename T>
+    struct strided_matrix
+    {
+        T* data_;
+        std::size_t rows_;
+        std::size_t columns_;
+        std::ptrdiff_t row_stride_;
+        std::ptrdiff_t column_stride_;
+
+        T& operator()(std::size_t i, std::size_t j) const
+        {
+            return data_[std::ptrdiff_t(i) * row_stride_ +
+                std::ptrdiff_t(j) * column_stride_];
+        }
+
+        strided_matrix trans() const
+        {
+            return strided_matrix{
+                data_, columns_, rows_, column_stride_, row_stride_};
+        }
+    };
+
+    // View of the given row of a matrix as a 1 x N matrix
+    template <typename Matrix>
+    auto row_view(Matrix& m, std::size_t i)
+    ->  strided_matrix<std::remove_reference_t<decltype(m(0, 0))>>
+    {
+        return {&m(i, 0), 1, m.columns(), 0, 1};
+    }
+
+    // View of the given row of a matrix as a N x 1 matrix
+    template <typename Matrix>
+    auto column_view_of_row(Matrix& m, std::size_t i)
+    ->  strided_matrix<std::remove_reference_t<decltype(m(0, 0))>>
+    {
+        return row_view(m, i).trans();
+    }
+
+    // View of the given page of a tensor
+    template <typename Tensor>
+    auto page_view(Tensor& t, std::size_t k)
+    ->  strided_matrix<std::remove_reference_t<decltype(t(0, 0, 0))>>
+    {
+        auto* data = &t(k, 0, 0);
+        std::ptrdiff_t row_stride = t.rows() > 1 ? &t(k, 1, 0) - data : 0;
+        return {data, t.rows(), t.columns(), row_stride, 1};
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    // The kernels below keep their operands on the stack, which is small for
+    // HPX threads. Limit the fixed size kernels to a few kB of local arrays.
+    constexpr std::size_t gemm_fixed_max_scratch_bytes = 8192;
+
+    // c = a * b for matrices with sizes known at compile time. The operands
+    // are packed into local arrays to allow for the compiler to fully unroll
+    // and vectorize the inner loops.
+    template <std::size_t M, std::size_t N, std::size_t K, typename T,
+        typename TA, typename TB>
+    void gemm_fixed(strided_matrix<TA> const& a, strided_matrix<TB> const& b,
+        strided_matrix<T> const& c)
+    {
+        static_assert((M * K + K * N + M * N) * sizeof(T) <=
+                gemm_fixed_max_scratch_bytes,
+            "the operands of gemm_fixed should fit into the scratch space");
+
+        T a_local[M][K];
+        T b_local[K][N];
+        T c_local[M][N] = {};
+
+        for (std::size_t i = 0; i != M; ++i)
+        {
+            for (std::size_t k = 0; k != K; ++k)
+            {
+                a_local[i][k] = a(i, k);
+            }
+        }
+        for (std::size_t k = 0; k != K; ++k)
+        {
+            for (std::size_t j = 0; j != N; ++j)
+            {
+                b_local[k][j] = b(k, j);
+            }
+        }
+
+        for (std::size_t i = 0; i != M; ++i)
+        {
+            for (std::size_t k = 0; k != K; ++k)
+            {
+                T const aik = a_local[i][k];
+                for (std::size_t j = 0; j != N; ++j)
+                {
+                    c_local[i][j] += aik * b_local[k][j];
+                }
+            }
+        }
+
+        for (std::size_t i = 0; i != M; ++i)
+        {
+            for (std::size_t j = 0; j != N; ++j)
+            {
+                c(i, j) = c_local[i][j];
+            }
+        }
+    }
+
+    // c = a * b for a single row a with a size known at compile time. b is
+    // used in place, packing it would cost as much as the product itself.
+    template <std::size_t N, typename T, typename TA, typename TB>
+    void gemv_fixed(strided_matrix<TA> const& a, strided_matrix<TB> const& b,
+        strided_matrix<T> const& c)
+    {
+        static_assert(2 * N * sizeof(T) <= gemm_fixed_max_scratch_bytes,
+            "the operands of gemv_fixed should fit into the scratch space");
+
+        T a_local[N];
+        T c_local[N] = {};
+
+        for (std::size_t k = 0; k != N; ++k)
+        {
+            a_local[k] = a(0, k);
+        }
+
+        for (std::size_t k = 0; k != N; ++k)
+        {
+            T const ak = a_local[k];
+            for (std::size_t j = 0; j != N; ++j)
+            {
+                c_local[j] += ak * b(k, j);
+            }
+        }
+
+        for (std::size_t j = 0; j != N; ++j)
+        {
+            c(0, j) = c_local[j];
+        }
+    }
+
+    // c = a * b for arbitrary sizes
+    template <typename T, typename TA, typename TB>
+    void gemm_generic(strided_matrix<TA> const& a,
+        strided_matrix<TB> const& b, strided_matrix<T> const& c)
+    {
+        std::size_t const m = a.rows_;
+        std::size_t const n = b.columns_;
+        std::size_t const kk = a.columns_;
+
+        for (std::size_t i = 0; i != m; ++i)
+        {
+            for (std::size_t j = 0; j != n; ++j)
+            {
+                c(i, j) = T(0);
+            }
+            for (std::size_t k = 0; k != kk; ++k)
+            {
+                T const aik = a(i, k);
+                for (std::size_t j = 0; j != n; ++j)
+                {
+                    c(i, j) += aik * b(k, j);
+                }
+            }
+        }
+    }
+
+    // c = a * b, dispatches to a specialized kernel for the small square
+    // sizes and for matrix-vector products with small vectors
+    template <typename T, typename TA, typename TB>
+    void gemm_small(strided_matrix<TA> const& a, strided_matrix<TB> const& b,
+        strided_matrix<T> const& c)
+    {
+        std::size_t const m = a.rows_;
+        std::size_t const n = b.columns_;
+        std::size_t const k = a.columns_;
+
+        if (m == n && n == k)
+        {
+            switch (m)
+            {
+            case 4:
+                gemm_fixed<4, 4, 4>(a, b, c);
+                return;
+            case 8:
+                gemm_fixed<8, 8, 8>(a, b, c);
+                return;
+            case 16:
+                gemm_fixed<16, 16, 16>(a, b, c);
+                return;
+            default:
+                break;
+            }
+        }
+        else if (m == 1 && n == k)
+        {
+            switch (n)
+            {
+            case 4:
+                gemv_fixed<4>(a, b, c);
+                return;
+            case 8:
+                gemv_fixed<8>(a, b, c);
+                return;
+            case 16:
+                gemv_fixed<16>(a, b, c);
+                return;
+            case 32:
+                gemv_fixed<32>(a, b, c);
+                return;
+            case 64:
+                gemv_fixed<64>(a, b, c);
+                return;
+            default:
+                break;
+            }
+        }
+
+        gemm_generic(a, b, c);
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    // batches requiring less multiply-adds than this are run sequentially
+    constexpr std::size_t batched_gemm_min_work = 65536;
+
+    // Compute c(i) = a(i) * b(i) for all i in [0, batch). The functions
+    // a, b, and c return the strided_matrix views of the batch entries. The
+    // batch entries are processed in parallel if the overall amount of work
+    // is sufficiently large.
+    template <typename FA, typename FB, typename FC>
+    void batched_gemm(std::size_t batch, FA&& a, FB&& b, FC&& c)
+    {
+        if (batch == 0)
+        {
+            return;
+        }
+
+        auto gemm = [&](std::size_t i)
+        {
+            gemm_small(a(i), b(i), c(i));
+        };
+
+        auto const a0 = a(0);
+        auto const b0 = b(0);
+        std::size_t const work = batch * a0.rows_ * a0.columns_ * b0.columns_;
+        if (batch == 1 || work < batched_gemm_min_work)
+        {
+            for (std::size_t i = 0; i != batch; ++i)
+            {
+                gemm(i);
+            }
+            return;
+        }
+
+        hpx::parallel::for_loop(
+            hpx::parallel::execution::par, std::size_t(0), batch, gemm);
+    }
+}}}
+
+#endif
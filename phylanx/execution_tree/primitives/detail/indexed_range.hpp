@@ -0,0 +1,77 @@
+// Copyright (c) 2019 Hartmut Kaiser
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#if !defined(PHYLANX_DETAIL_INDEXED_RANGE_JUL_03_2019_1130AM)
+#define PHYLANX_DETAIL_INDEXED_RANGE_JUL_03_2019_1130AM
+
+#include <phylanx/config.hpp>
+#include <phylanx/execution_tree/primitives/base_primitive.hpp>
+#include <phylanx/ir/ranges.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+
+namespace phylanx { namespace execution_tree { namespace detail
+{
+    ///////////////////////////////////////////////////////////////////////////
+    // Random access to the elements of a range as needed by the parallel
+    // algorithms. Integer ranges are not materialized, lists are moved (or
+    // copied if the range refers to a part of another list).
+    class indexed_range
+    {
+    public:
+        explicit indexed_range(ir::range&& r)
+          : is_xrange_(r.is_xrange())
+          , start_(0)
+          , step_(0)
+          , size_(0)
+        {
+            if (is_xrange_)
+            {
+                auto const& xr = r.xrange();
+                start_ = xr.start();
+                step_ = xr.step();
+                size_ = static_cast<std::size_t>(xr.size());
+            }
+            else
+            {
+                if (r.is_args() && !r.is_args_ref())
+                {
+                    elements_ = std::move(r.args());
+                }
+                else
+                {
+                    elements_ = r.copy();
+                }
+                size_ = elements_.size();
+            }
+        }
+
+        std::size_t size() const
+        {
+            return size_;
+        }
+
+        primitive_argument_type operator[](std::size_t i) const
+        {
+            if (is_xrange_)
+            {
+                return primitive_argument_type{
+                    start_ + static_cast<std::int64_t>(i) * step_};
+            }
+            return elements_[i];
+        }
+
+    private:
+        bool is_xrange_;
+        std::int64_t start_;
+        std::int64_t step_;
+        std::size_t size_;
+        primitive_arguments_type elements_;
+    };
+}}}
+
+#endif
@@ -0,0 +1,238 @@
+// Copyright (c) 2019 Hartmut Kaiser
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#if !defined(PHYLANX_DETAIL_SLIDING_WINDOW_JUL_15_2019_1120AM)
+#define PHYLANX_DETAIL_SLIDING_WINDOW_JUL_15_2019_1120AM
+
+#include <phylanx/config.hpp>
+#include <phylanx/execution_tree/primitives/base_primitive.hpp>
+#include <phylanx/util/generate_error_message.hpp>
+
+#include <hpx/include/parallel_for_loop.hpp>
+#include <hpx/include/runtime.hpp>
+#include <hpx/throw_exception.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace phylanx { namespace execution_tree { namespace detail
+{
+    ///////////////////////////////////////////////////////////////////////////
+    // Padding modes as supported by Keras' convolution and pooling layers
+    enum class padding_mode
+    {
+        valid,      // no padding, windows have to fit into the input
+        same,       // pad evenly such that output size == ceil(input / stride)
+        causal      // pad at the front only (1-D convolutions only)
+    };
+
+    inline bool parse_padding_mode(std::string const& name, padding_mode& mode)
+    {
+        if (name == "valid")
+        {
+            mode = padding_mode::valid;
+        }
+        else if (name == "same")
+        {
+            mode = padding_mode::same;
+        }
+        else if (name == "causal")
+        {
+            mode = padding_mode::causal;
+        }
+        else
+        {
+            return false;
+        }
+        return true;
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    // Geometry of a (strided, dilated) window sliding along one dimension.
+    // Window element k of output element i reads input element
+    // i * stride + k * dilation - pad_before, which may lie in the (implicit)
+    // padding.
+    struct window_geometry
+    {
+        std::size_t size_;          // number of input elements
+        std::size_t window_;        // number of window elements
+        std::size_t stride_;
+        std::size_t dilation_;
+        std::size_t pad_before_;
+        std::size_t output_size_;
+
+        std::ptrdiff_t input_index(std::size_t i, std::size_t k) const
+        {
+            return std::ptrdiff_t(i * stride_ + k * dilation_) -
+                std::ptrdiff_t(pad_before_);
+        }
+
+        bool is_valid(std::ptrdiff_t index) const
+        {
+            return index >= 0 && index < std::ptrdiff_t(size_);
+        }
+
+        // The range [first, last) of output elements for which window
+        // element k reads from the input (as opposed to the padding).
+        std::array<std::size_t, 2> valid_outputs(std::size_t k) const
+        {
+            std::ptrdiff_t const offset =
+                std::ptrdiff_t(k * dilation_) - std::ptrdiff_t(pad_before_);
+            std::ptrdiff_t const stride = std::ptrdiff_t(stride_);
+
+            std::ptrdiff_t first = 0;
+            if (offset < 0)
+            {
+                first = (-offset + stride - 1) / stride;
+            }
+
+            std::ptrdiff_t last = 0;
+            if (std::ptrdiff_t(size_) > offset)
+            {
+                last = (std::ptrdiff_t(size_) - offset - 1) / stride + 1;
+            }
+
+            last = (std::min)(last, std::ptrdiff_t(output_size_));
+            if (first >= last)
+            {
+                return {{0, 0}};
+            }
+            return {{std::size_t(first), std::size_t(last)}};
+        }
+    };
+
+    inline window_geometry make_window_geometry(std::size_t size,
+        std::size_t window, std::size_t stride, std::size_t dilation,
+        padding_mode mode)
+    {
+        // the number of input elements spanned by a dilated window
+        std::size_t const extent = dilation * (window - 1) + 1;
+
+        window_geometry g{size, window, stride, dilation, 0, 0};
+        switch (mode)
+        {
+        case padding_mode::same:
+            g.output_size_ = (size + stride - 1) / stride;
+            if (g.output_size_ != 0)
+            {
+                std::size_t const needed =
+                    (g.output_size_ - 1) * stride + extent;
+                g.pad_before_ = needed > size ? (needed - size) / 2 : 0;
+            }
+            break;
+
+        case padding_mode::causal:
+            g.pad_before_ = extent - 1;
+            g.output_size_ = size == 0 ? 0 : (size - 1) / stride + 1;
+            break;
+
+        case padding_mode::valid: HPX_FALLTHROUGH;
+        default:
+            g.output_size_ = size >= extent ? (size - extent) / stride + 1 : 0;
+            break;
+        }
+        return g;
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    // Extract a size for each of the given number of spatial dimensions from
+    // either a single integer (used for all dimensions) or a list of
+    // integers. All sizes have to be positive.
+    inline std::array<std::size_t, 2> extract_window_sizes(
+        primitive_argument_type const& arg, std::size_t dims,
+        std::size_t default_value, char const* what,
+        std::string const& name, std::string const& codename)
+    {
+        std::array<std::size_t, 2> result{{default_value, default_value}};
+        if (!valid(arg))
+        {
+            return result;
+        }
+
+        auto check = [&](std::int64_t value) -> std::size_t
+        {
+            if (value <= 0)
+            {
+                HPX_THROW_EXCEPTION(hpx::bad_parameter,
+                    "detail::extract_window_sizes",
+                    util::generate_error_message(
+                        std::string("the ") + what + " must be positive",
+                        name, codename));
+            }
+            return std::size_t(value);
+        };
+
+        if (is_list_operand_strict(arg))
+        {
+            ir::range list = extract_list_value_strict(arg, name, codename);
+            if (std::size_t(list.size()) != dims)
+            {
+                HPX_THROW_EXCEPTION(hpx::bad_parameter,
+                    "detail::extract_window_sizes",
+                    util::generate_error_message(
+                        std::string("the ") + what + " must have " +
+                            std::to_string(dims) + " element(s)",
+                        name, codename));
+            }
+
+            std::size_t i = 0;
+            for (auto const& value : list)
+            {
+                result[i++] = check(extract_scalar_integer_value_strict(
+                    value, name, codename));
+            }
+            return result;
+        }
+
+        result[0] = result[1] =
+            check(extract_scalar_integer_value_strict(arg, name, codename));
+        return result;
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    // Invoke f(batch, first, last) for blocks of output rows of all batch
+    // entries. The rows are split such that there are enough blocks to keep
+    // all worker threads busy even for small batches. Small problems (less
+    // than 2^16 operations overall) are processed sequentially.
+    template <typename F>
+    void for_each_window_block(std::size_t batch, std::size_t rows,
+        std::size_t work_per_row, F&& f)
+    {
+        if (batch == 0 || rows == 0)
+        {
+            return;
+        }
+
+        std::size_t const workers = hpx::get_num_worker_threads();
+        std::size_t const blocks_per_batch = (std::min)(rows,
+            (std::max)(std::size_t(1), (2 * workers + batch - 1) / batch));
+        std::size_t const block_size =
+            (rows + blocks_per_batch - 1) / blocks_per_batch;
+        std::size_t const blocks = (rows + block_size - 1) / block_size;
+
+        auto body = [&](std::size_t i)
+        {
+            std::size_t const first = (i % blocks) * block_size;
+            f(i / blocks, first, (std::min)(first + block_size, rows));
+        };
+
+        if (workers == 1 || batch * rows * work_per_row < 65536)
+        {
+            for (std::size_t i = 0; i != batch * blocks; ++i)
+            {
+                body(i);
+            }
+            return;
+        }
+
+        hpx::parallel::for_loop(hpx::parallel::execution::par,
+            std::size_t(0), batch * blocks, body);
+    }
+}}}
+
+#endif
@@ -0,0 +1,113 @@
+// Copyright (c) 2019 Hartmut Kaiser
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#if !defined(PHYLANX_DETAIL_SOFTMAX_JUL_17_2019_0915AM)
+#define PHYLANX_DETAIL_SOFTMAX_JUL_17_2019_0915AM
+
+#include <phylanx/config.hpp>
+
+#include <hpx/include/parallel_for_loop.hpp>
+#include <hpx/include/runtime.hpp>
+
+#include <cmath>
+#include <cstddef>
+
+#include <blaze/Math.h>
+
+namespace phylanx { namespace execution_tree { namespace detail
+{
+    ///////////////////////////////////////////////////////////////////////////
+    // The kernels below operate on a single line (row, column, or fiber) of
+    // an array. All of them subtract the maximum of the line before
+    // exponentiating, which avoids overflows for large inputs. Input and
+    // output may refer to the same memory.
+    template <typename Vector>
+    blaze::UniformVector<double, blaze::IsRowVector<Vector>::value>
+    uniform_like(Vector const& v, double value)
+    {
+        return blaze::UniformVector<double, blaze::IsRowVector<Vector>::value>(
+            v.size(), value);
+    }
+
+    // log(sum(exp(in))), computed without overflow
+    template <typename In>
+    double log_sum_exp(In const& in, double max)
+    {
+        return max +
+            std::log(blaze::sum(blaze::exp(in - uniform_like(in, max))));
+    }
+
+    // out = exp(in) / sum(exp(in))
+    template <typename In, typename Out>
+    void softmax_line(In const& in, Out&& out)
+    {
+        if (in.size() == 0)
+        {
+            return;
+        }
+
+        double const max = blaze::max(in);
+        out = blaze::serial(blaze::exp(in - uniform_like(in, max)));
+        out *= 1.0 / blaze::sum(out);
+    }
+
+    // out = log(softmax(in)) = in - log(sum(exp(in)))
+    template <typename In, typename Out>
+    void log_softmax_line(In const& in, Out&& out)
+    {
+        if (in.size() == 0)
+        {
+            return;
+        }
+
+        double const lse = log_sum_exp(in, blaze::max(in));
+        out = blaze::serial(in - uniform_like(in, lse));
+    }
+
+    // -sum(labels * log(softmax(logits))), for labels given as
+    // probabilities (e.g. one-hot encoded)
+    template <typename Logits, typename Labels>
+    double softmax_cross_entropy_line(
+        Logits const& logits, Labels const& labels)
+    {
+        if (logits.size() == 0)
+        {
+            return 0.0;
+        }
+
+        double const lse = log_sum_exp(logits, blaze::max(logits));
+        return lse * blaze::sum(labels) - blaze::sum(labels * logits);
+    }
+
+    // -log(softmax(logits))[label], for labels given as class indices
+    template <typename Logits>
+    double sparse_softmax_cross_entropy_line(
+        Logits const& logits, std::size_t label)
+    {
+        return log_sum_exp(logits, blaze::max(logits)) - logits[label];
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    // Invoke f(i) for all lines i of an array, in parallel if there is
+    // enough work (at least 2^16 elements).
+    template <typename F>
+    void for_each_line(std::size_t lines, std::size_t length, F&& f)
+    {
+        if (lines > 1 && lines * length >= 65536 &&
+            hpx::get_num_worker_threads() > 1)
+        {
+            hpx::parallel::for_loop(hpx::parallel::execution::par,
+                std::size_t(0), lines, f);
+            return;
+        }
+
+        for (std::size_t i = 0; i != lines; ++i)
+        {
+            f(i);
+        }
+    }
+}}}
+
+#endif
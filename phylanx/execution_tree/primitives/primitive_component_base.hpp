@@ -16,6 +16,7 @@
 #include <hpx/runtime/naming_fwd.hpp>
 #include <hpx/util/internal_allocator.hpp>
 
+#include <atomic>
 #include <cstddef>
 #include <cstdint>
 #include <iosfwd>
@@ -36,6 +37,7 @@ namespace phylanx { namespace execution_tree
     namespace primitives
     {
         class primitive_component;
+        class primitive_type_data;
 
         struct PHYLANX_EXPORT primitive_component_base
         {
@@ -46,7 +48,7 @@ namespace phylanx { namespace execution_tree
                 std::string const& name, std::string const& codename,
                 bool eval_direct = false);
 
-            virtual ~primitive_component_base() = default;
+            virtual ~primitive_component_base();
 
             // eval_action
             virtual hpx::future<primitive_argument_type> eval(
@@ -81,6 +83,7 @@ namespace phylanx { namespace execution_tree
 
         protected:
             friend class primitive_component;
+            friend class primitive_type_data;
 
             // helper functions to invoke eval functionalities
             hpx::future<primitive_argument_type> do_eval(
@@ -95,8 +98,22 @@ namespace phylanx { namespace execution_tree
             std::int64_t get_eval_duration(bool reset) const;
             std::int64_t get_direct_execution(bool reset) const;
 
+            // the number of bytes of array data held by this primitive (as
+            // of the last call to update_memory_usage)
+            std::int64_t get_memory_usage() const;
+
+            // recompute the number of bytes of array data held by this
+            // primitive: the bytes owned by the operands plus the given
+            // number of bytes held elsewhere by the derived primitive. This
+            // has to be called whenever a held value is replaced, the
+            // registry reads the stored value only.
+            void update_memory_usage(std::int64_t extra_bytes = 0) const;
+
             void enable_measurements();
 
+            // the id of this primitive in the recorded trace events
+            std::uint32_t trace_name() const;
+
             // decide whether to execute eval directly
             hpx::launch select_direct_eval_execution(hpx::launch policy) const;
 
@@ -117,6 +134,10 @@ namespace phylanx { namespace execution_tree
 
             std::string extract_function_name(std::string const& name);
 
+            // the number of bytes of array data owned by the given value
+            static std::int64_t owned_bytes(
+                primitive_argument_type const& value);
+
         protected:
             std::string generate_error_message(std::string const& msg) const;
             static bool get_sync_execution();
@@ -137,6 +158,17 @@ namespace phylanx { namespace execution_tree
             mutable std::int64_t execute_directly_;
             bool measurements_enabled_;
 
+            // see trace_name(), registered on first use
+            mutable std::atomic<std::int64_t> trace_name_{-1};
+
+            // see update_memory_usage()
+            mutable std::atomic<std::int64_t> memory_usage_{0};
+
+            // the registry entry of the type of this primitive, collects the
+            // statistics of all instances of this type
+            primitive_type_data* type_data_ = nullptr;
+            std::int64_t sequence_number_ = -1;
+
 #if defined(HPX_HAVE_APEX)
             std::string eval_name_;
 #endif
@@ -0,0 +1,158 @@
+//  Copyright (c) 2019 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#if !defined(PHYLANX_PRIMITIVES_PRIMITIVE_REGISTRY_JUL_24_2019_0945AM)
+#define PHYLANX_PRIMITIVES_PRIMITIVE_REGISTRY_JUL_24_2019_0945AM
+
+#include <phylanx/config.hpp>
+
+#include <hpx/lcos/local/spinlock.hpp>
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace phylanx { namespace execution_tree { namespace primitives
+{
+    ///////////////////////////////////////////////////////////////////////////
+    struct primitive_component_base;
+
+    // Durations are collected in a histogram with logarithmic buckets: bucket
+    // 0 counts evaluations faster than 1024ns, bucket i > 0 counts
+    // evaluations taking [2^(i+9), 2^(i+10)) ns, the last bucket counts all
+    // longer evaluations.
+    constexpr std::size_t primitive_duration_buckets = 24;
+
+    // The statistics of all evaluations of the primitives of one type
+    // (collected only while measurements are enabled for the type or for the
+    // evaluated instance)
+    struct primitive_type_statistics
+    {
+        std::int64_t instances = 0;         // number of live instances
+        std::int64_t eval_count = 0;
+        std::int64_t eval_duration = 0;     // in ns, summed over all evals
+        std::int64_t min_duration = 0;
+        std::int64_t max_duration = 0;
+        std::int64_t result_bytes = 0;      // size of the produced arrays
+        std::array<std::int64_t, primitive_duration_buckets> histogram = {};
+
+        // The statistics as a flat list of values, in the order of the
+        // members above
+        PHYLANX_EXPORT std::vector<std::int64_t> values() const;
+    };
+
+    ///////////////////////////////////////////////////////////////////////////
+    // The data kept for all live primitive instances of one type on this
+    // locality. The objects are created on first use and are never
+    // destroyed.
+    class primitive_type_data
+    {
+    public:
+        // the per-instance performance data (see primitive_component_base)
+        enum instance_counter
+        {
+            eval_count,
+            eval_duration,
+            direct_execution,
+            memory_usage
+        };
+
+        explicit primitive_type_data(std::string const& type);
+
+        primitive_type_data(primitive_type_data const&) = delete;
+        primitive_type_data& operator=(primitive_type_data const&) = delete;
+
+        std::string const& type() const
+        {
+            return type_;
+        }
+
+        // measurements are enabled for all instances of this type
+        bool measurements_enabled() const
+        {
+            return measurements_enabled_.load(std::memory_order_relaxed);
+        }
+        PHYLANX_EXPORT void enable_measurements();
+
+        // add the statistics of one evaluation
+        PHYLANX_EXPORT void record_eval(
+            std::int64_t duration, std::int64_t result_bytes);
+
+        PHYLANX_EXPORT primitive_type_statistics statistics(bool reset);
+
+        // the given counter for all live instances, ordered by sequence
+        // number
+        PHYLANX_EXPORT std::vector<std::int64_t> instance_values(
+            instance_counter counter, bool reset) const;
+
+        // the given counters of the named instance, return false if no such
+        // instance exists
+        PHYLANX_EXPORT bool instance_values(std::string const& name,
+            std::vector<instance_counter> const& counters,
+            std::vector<std::int64_t>& values) const;
+
+        // the names of all live instances together with the given counters
+        // of each of them, collected in a single pass (the names and values
+        // are consistent even if instances are created or destroyed
+        // concurrently)
+        using instance_entry =
+            std::pair<std::string, std::vector<std::int64_t>>;
+
+        PHYLANX_EXPORT std::vector<instance_entry> instances(
+            std::vector<instance_counter> const& counters,
+            bool reset) const;
+
+    private:
+        friend struct primitive_component_base;
+
+        using mutex_type = hpx::lcos::local::spinlock;
+        using instance_key = std::pair<std::int64_t, std::string>;
+
+        static std::int64_t instance_value(
+            primitive_component_base const* instance,
+            instance_counter counter, bool reset);
+
+        void add_instance(std::int64_t sequence_number,
+            primitive_component_base const* instance);
+        void remove_instance(std::int64_t sequence_number,
+            primitive_component_base const* instance);
+
+        std::string const type_;
+        std::atomic<bool> measurements_enabled_;
+
+        std::atomic<std::int64_t> eval_count_;
+        std::atomic<std::int64_t> eval_duration_;
+        std::atomic<std::int64_t> min_duration_;
+        std::atomic<std::int64_t> max_duration_;
+        std::atomic<std::int64_t> result_bytes_;
+        std::array<std::atomic<std::int64_t>, primitive_duration_buckets>
+            histogram_;
+
+        mutable mutex_type mtx_;
+        std::multimap<instance_key, primitive_component_base const*>
+            instances_;
+    };
+
+    ///////////////////////////////////////////////////////////////////////////
+    // Return the data for the given primitive type, create it if needed
+    PHYLANX_EXPORT primitive_type_data& get_primitive_type_data(
+        std::string const& type);
+
+    // Return the data for the given primitive type or nullptr if no primitive
+    // of this type was created yet
+    PHYLANX_EXPORT primitive_type_data* find_primitive_type_data(
+        std::string const& type);
+
+    // Return the data of all primitive types with at least one instance
+    // created on this locality
+    PHYLANX_EXPORT std::vector<primitive_type_data*> all_primitive_type_data();
+}}}
+
+#endif
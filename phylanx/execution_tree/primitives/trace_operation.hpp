@@ -0,0 +1,64 @@
+//  Copyright (c) 2019 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#if !defined(PHYLANX_TRACE_OPERATION_JUL_22_2019_0210PM)
+#define PHYLANX_TRACE_OPERATION_JUL_22_2019_0210PM
+
+#include <phylanx/config.hpp>
+#include <phylanx/execution_tree/primitives/base_primitive.hpp>
+#include <phylanx/execution_tree/primitives/primitive_component_base.hpp>
+
+#include <hpx/lcos/future.hpp>
+
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace phylanx { namespace execution_tree { namespace primitives
+{
+    /// \brief Control the recording of evaluation events (see
+    /// phylanx/util/tracer.hpp): start_trace() and stop_trace() enable and
+    /// disable the recording, dump_trace(filename) writes all recorded
+    /// events in the Chrome trace event format.
+    class trace_operation
+      : public primitive_component_base
+      , public std::enable_shared_from_this<trace_operation>
+    {
+    public:
+        static std::vector<match_pattern_type> const match_data;
+
+        trace_operation() = default;
+
+        trace_operation(primitive_arguments_type&& operands,
+            std::string const& name, std::string const& codename);
+
+    private:
+        hpx::future<primitive_argument_type> eval(
+            primitive_arguments_type const& operands,
+            primitive_arguments_type const& args,
+            eval_context ctx) const override;
+
+        enum trace_mode
+        {
+            trace_start,
+            trace_stop,
+            trace_dump
+        };
+
+        trace_mode mode_;
+    };
+
+    PHYLANX_EXPORT primitive create_start_trace(hpx::id_type const& locality,
+        primitive_arguments_type&& operands,
+        std::string const& name = "", std::string const& codename = "");
+    PHYLANX_EXPORT primitive create_stop_trace(hpx::id_type const& locality,
+        primitive_arguments_type&& operands,
+        std::string const& name = "", std::string const& codename = "");
+    PHYLANX_EXPORT primitive create_dump_trace(hpx::id_type const& locality,
+        primitive_arguments_type&& operands,
+        std::string const& name = "", std::string const& codename = "");
+}}}
+
+#endif
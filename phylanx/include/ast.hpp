@@ -12,6 +12,7 @@
 #include <phylanx/ast/detail/is_literal_value.hpp>
 #include <phylanx/ast/detail/is_placeholder.hpp>
 #include <phylanx/ast/detail/is_placeholder_ellipses.hpp>
+#include <phylanx/ast/flat_ast.hpp>
 #include <phylanx/ast/generate_ast.hpp>
 #include <phylanx/ast/generate_transform_rules.hpp>
 #include <phylanx/ast/match_ast.hpp>
@@ -7,14 +7,18 @@
 #define PHYLANX_UTIL_HPP
 
 #include <phylanx/config.hpp>
+#include <phylanx/util/gemm.hpp>
 #include <phylanx/util/hashed_string.hpp>
+#include <phylanx/util/interned_string.hpp>
 #include <phylanx/util/none_manip.hpp>
 #include <phylanx/util/performance_data.hpp>
+#include <phylanx/util/philox.hpp>
 #include <phylanx/util/random.hpp>
 #include <phylanx/util/repr_manip.hpp>
 #include <phylanx/util/serialization/ast.hpp>
 #include <phylanx/util/serialization/blaze.hpp>
 #include <phylanx/util/serialization/variant.hpp>
+#include <phylanx/util/tracer.hpp>
 #include <phylanx/util/truncated_normal_distribution.hpp>
 #include <phylanx/util/variant.hpp>
 
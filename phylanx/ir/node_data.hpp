@@ -100,6 +100,60 @@ namespace phylanx { namespace ir
             node_data<T> const& nd_;
             std::size_t index_;
         };
+
+        ///////////////////////////////////////////////////////////////////////
+        // The number of bytes of storage owned by a node_data instance as
+        // accounted for in the memory statistics of node_data<T>. Copies
+        // start out empty, the owning node_data updates the accounted size
+        // whenever its storage is replaced (the size stays zero while the
+        // accounting is disabled).
+        template <typename T>
+        class node_data_allocation
+        {
+        public:
+            node_data_allocation() = default;
+
+            node_data_allocation(node_data_allocation const&) noexcept {}
+            node_data_allocation(node_data_allocation&& rhs) noexcept
+              : bytes_(rhs.bytes_)
+            {
+                rhs.bytes_ = 0;
+            }
+
+            ~node_data_allocation()
+            {
+                update(0);
+            }
+
+            node_data_allocation& operator=(
+                node_data_allocation const&) noexcept
+            {
+                return *this;
+            }
+            node_data_allocation& operator=(
+                node_data_allocation&& rhs) noexcept
+            {
+                if (this != &rhs)
+                {
+                    update(0);
+                    bytes_ = rhs.bytes_;
+                    rhs.bytes_ = 0;
+                }
+                return *this;
+            }
+
+            void update(std::int64_t bytes) noexcept
+            {
+                if (bytes != bytes_)
+                {
+                    node_data<T>::account_allocation(bytes - bytes_);
+                    bytes_ = bytes;
+                }
+            }
+
+        private:
+            std::int64_t bytes_ = 0;
+        };
     }
 
     constexpr static std::size_t const max_dimensions = PHYLANX_MAX_DIMENSIONS;
@@ -121,6 +175,29 @@ namespace phylanx { namespace ir
 
         static bool enable_counts(bool enable);
 
+        // Memory accounting for the storage owned by all node_data<T>
+        // instances (views referring to other instances are not accounted).
+        // Modifications of the storage through the *_non_ref() accessors are
+        // accounted for only once the storage is replaced. The accounting is
+        // disabled by default (it is enabled at startup if
+        // phylanx.memory_accounting=1), only storage allocated while it is
+        // enabled is accounted for.
+        static bool enable_memory_accounting(bool enable);
+
+        static std::int64_t allocated_bytes(bool reset);
+        static std::int64_t allocated_bytes_high_water(bool reset);
+        static std::int64_t deep_copy_count(bool reset);
+        static std::int64_t deep_copy_bytes(bool reset);
+
+    private:
+        friend class detail::node_data_allocation<T>;
+
+        static void account_allocation(std::int64_t bytes);
+
+        // update the accounted size after the storage was replaced, count
+        // the new storage as a deep copy if requested
+        void track_allocation(bool deep_copy = false);
+
     public:
         using storage0d_type = T;
         using storage1d_type = blaze::DynamicVector<T>;
@@ -280,6 +357,7 @@ namespace phylanx { namespace ir
         explicit node_data(node_data<U> const& d)
           : data_(init_data_from_type(d))
         {
+            track_allocation(true);
         }
 
         node_data& operator=(storage0d_type val);
@@ -328,6 +406,7 @@ namespace phylanx { namespace ir
         node_data& operator=(node_data<U> const& d)
         {
             data_ = init_data_from_type(d);
+            track_allocation(true);
             return *this;
         }
 
@@ -423,6 +502,10 @@ namespace phylanx { namespace ir
         /// instance of node_data
         bool is_ref() const;
 
+        /// Return the number of bytes of the storage owned by this instance
+        /// (zero for references to other instances and for scalars)
+        std::int64_t owned_bytes() const;
+
         explicit operator bool() const;
 
         bool operator!() const
@@ -455,6 +538,7 @@ namespace phylanx { namespace ir
         void serialize(hpx::serialization::output_archive& ar, unsigned);
 
         storage_type data_;
+        detail::node_data_allocation<T> allocation_;
         /// \endcond
     };
 
@@ -243,6 +243,10 @@ namespace phylanx { namespace ir
 
         reverse_range_iterator invert() const;
 
+        // Access the list element the iterator refers to without copying
+        // it, throws for iterators into integer ranges.
+        execution_tree::primitive_argument_type const& element() const;
+
     private:
         friend class hpx::util::iterator_core_access;
 
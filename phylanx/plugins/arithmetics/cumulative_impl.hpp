@@ -12,12 +12,15 @@
 
 #include <hpx/include/lcos.hpp>
 #include <hpx/include/naming.hpp>
+#include <hpx/include/parallel_for_loop.hpp>
 #include <hpx/include/parallel_scan.hpp>
+#include <hpx/include/runtime.hpp>
 #include <hpx/include/util.hpp>
 #include <hpx/throw_exception.hpp>
 #include <hpx/util/format.hpp>
 #include <hpx/util/optional.hpp>
 
+#include <algorithm>
 #include <array>
 #include <cstddef>
 #include <cstdint>
@@ -35,6 +38,126 @@
 ///////////////////////////////////////////////////////////////////////////////
 namespace phylanx { namespace execution_tree { namespace primitives
 {
+    namespace detail
+    {
+        // minimal number of elements handled by a single HPX thread while
+        // computing a scan
+        constexpr std::size_t cumulative_min_block_size = 32768;
+
+        // Invoke f(i) for all i in [0, count), run the invocations in
+        // parallel if each of them processes enough elements.
+        template <typename F>
+        void cumulative_for_slices(
+            std::size_t count, std::size_t slice_size, F&& f)
+        {
+            if (count < 2 || count * slice_size < cumulative_min_block_size)
+            {
+                for (std::size_t i = 0; i != count; ++i)
+                {
+                    f(i);
+                }
+                return;
+            }
+
+            hpx::parallel::for_loop(hpx::parallel::execution::par,
+                std::size_t(0), count, std::forward<F>(f));
+        }
+
+        ///////////////////////////////////////////////////////////////////////
+        // Blocked two-pass scan of rows x columns elements (accessed through
+        // row_begin(row)) into the contiguous memory referred to by dest. The
+        // elements are split into blocks, the first pass computes the total
+        // of each block in parallel, the second pass scans each block in
+        // parallel, starting off the exclusive scan of the block totals.
+        template <typename Op, typename T, typename RowBegin>
+        void cumulative_flat_scan(std::size_t rows, std::size_t columns,
+            RowBegin&& row_begin, T* dest)
+        {
+            std::size_t size = rows * columns;
+            if (size == 0)
+            {
+                return;
+            }
+
+            std::size_t nblocks = (std::min)(
+                std::size_t(4 * hpx::get_os_thread_count()),
+                size / cumulative_min_block_size);
+
+            if (nblocks < 2)
+            {
+                T init = Op::template initial<T>();
+                for (std::size_t row = 0; row != rows; ++row)
+                {
+                    auto first = row_begin(row);
+                    T* last = Op{}(first, first + columns,
+                        dest + row * columns, init);
+                    init = *(last - 1);
+                }
+                return;
+            }
+
+            std::size_t block_size = (size + nblocks - 1) / nblocks;
+
+            // invoke f(first, last, offset) for all row segments of a block
+            auto for_each_segment = [&](std::size_t block, auto&& f)
+            {
+                std::size_t lo = block * block_size;
+                std::size_t hi = (std::min)(size, lo + block_size);
+                while (lo < hi)
+                {
+                    std::size_t row = lo / columns;
+                    std::size_t col = lo % columns;
+                    std::size_t count = (std::min)(columns - col, hi - lo);
+
+                    auto first = row_begin(row) + col;
+                    f(first, first + count, lo);
+                    lo += count;
+                }
+            };
+
+            // pass 1: compute the total of each block
+            std::vector<T> totals(nblocks);
+            hpx::parallel::for_loop(hpx::parallel::execution::par,
+                std::size_t(0), nblocks,
+                [&](std::size_t block)
+                {
+                    T total = Op::template initial<T>();
+                    for_each_segment(block,
+                        [&](auto first, auto last, std::size_t)
+                        {
+                            for (/**/; first != last; ++first)
+                            {
+                                total = Op::combine(total, T(*first));
+                            }
+                        });
+                    totals[block] = total;
+                });
+
+            // exclusive scan of the block totals
+            T carry = Op::template initial<T>();
+            for (auto& total : totals)
+            {
+                T next = Op::combine(carry, total);
+                total = carry;
+                carry = next;
+            }
+
+            // pass 2: scan each of the blocks
+            hpx::parallel::for_loop(hpx::parallel::execution::par,
+                std::size_t(0), nblocks,
+                [&](std::size_t block)
+                {
+                    T init = totals[block];
+                    for_each_segment(block,
+                        [&](auto first, auto last, std::size_t offset)
+                        {
+                            T* end = Op{}(first, last, dest + offset, init);
+                            init = *(end - 1);
+                        });
+                });
+        }
+    }
+
     ///////////////////////////////////////////////////////////////////////////
     template <typename Op, typename Derived>
     cumulative<Op, Derived>::cumulative(primitive_arguments_type&& operands,
@@ -96,7 +219,8 @@ namespace phylanx { namespace execution_tree { namespace primitives
         auto v = value.vector();
         blaze::DynamicVector<T> result(v.size());
 
-        Op{}(v.begin(), v.end(), result.begin(), Op::template initial<T>());
+        detail::cumulative_flat_scan<Op>(std::size_t(1), v.size(),
+            [&](std::size_t) { return v.begin(); }, result.data());
 
         return primitive_argument_type{std::move(result)};
     }
@@ -116,14 +240,8 @@ namespace phylanx { namespace execution_tree { namespace primitives
         auto m = value.matrix();
         blaze::DynamicVector<T> result(m.rows() * m.columns());
 
-        T init = Op::template initial<T>();
-        auto last = result.begin();
-
-        for (std::size_t row = 0; row != m.rows(); ++row)
-        {
-            last = Op{}(m.begin(row), m.end(row), last, init);
-            init = *(last - 1);
-        }
+        detail::cumulative_flat_scan<Op>(m.rows(), m.columns(),
+            [&](std::size_t row) { return m.begin(row); }, result.data());
 
         return primitive_argument_type{std::move(result)};
     }
@@ -142,14 +260,16 @@ namespace phylanx { namespace execution_tree { namespace primitives
         auto m = value.matrix();
         blaze::DynamicMatrix<T> result(m.rows(), m.columns());
 
-        T init = Op::template initial<T>();
-        for (std::size_t col = 0; col != m.columns(); ++col)
-        {
-            auto column = blaze::column(m, col);
-            auto result_column = blaze::column(result, col);
+        // the columns are independent of each other
+        detail::cumulative_for_slices(m.columns(), m.rows(),
+            [&](std::size_t col)
+            {
+                auto column = blaze::column(m, col);
+                auto result_column = blaze::column(result, col);
 
-            Op{}(column.begin(), column.end(), result_column.begin(), init);
-        }
+                Op{}(column.begin(), column.end(), result_column.begin(),
+                    Op::template initial<T>());
+            });
 
         return primitive_argument_type{std::move(result)};
     }
@@ -168,11 +288,13 @@ namespace phylanx { namespace execution_tree { namespace primitives
         auto m = value.matrix();
         blaze::DynamicMatrix<T> result(m.rows(), m.columns());
 
-        T init = Op::template initial<T>();
-        for (std::size_t row = 0; row != m.rows(); ++row)
-        {
-            Op{}(m.begin(row), m.end(row), result.begin(row), init);
-        }
+        // the rows are independent of each other
+        detail::cumulative_for_slices(m.rows(), m.columns(),
+            [&](std::size_t row)
+            {
+                Op{}(m.begin(row), m.end(row), result.begin(row),
+                    Op::template initial<T>());
+            });
 
         return primitive_argument_type{std::move(result)};
     }
@@ -226,18 +348,13 @@ namespace phylanx { namespace execution_tree { namespace primitives
         auto t = value.tensor();
         blaze::DynamicVector<T> result(t.pages() * t.rows() * t.columns());
 
-        T init = Op::template initial<T>();
-        auto last = result.begin();
-
-        for (std::size_t page = 0; page != t.pages(); ++page)
-        {
-            auto ps = blaze::pageslice(t, page);
-            for (std::size_t row = 0; row != t.rows(); ++row)
+        std::size_t rows = t.rows();
+        detail::cumulative_flat_scan<Op>(t.pages() * rows, t.columns(),
+            [&](std::size_t row)
             {
-                last = Op{}(ps.begin(row), ps.end(row), last, init);
-                init = *(last - 1);
-            }
-        }
+                return t.begin(row % rows, row / rows);
+            },
+            result.data());
 
         return primitive_argument_type{std::move(result)};
     }
@@ -256,19 +373,22 @@ namespace phylanx { namespace execution_tree { namespace primitives
         auto t = value.tensor();
 
         blaze::DynamicTensor<T> result(t.pages(), t.rows(), t.columns());
-        T init = Op::template initial<T>();
-        for (std::size_t i = 0; i != t.rows(); ++i)
-        {
-            auto slice = blaze::rowslice(t, i);
-            auto result_slice = blaze::rowslice(result, i);
-            for (std::size_t j = 0; j != blaze::rows(slice); ++j)
+
+        // the row slices are independent of each other
+        detail::cumulative_for_slices(t.rows(), t.pages() * t.columns(),
+            [&](std::size_t i)
             {
-                auto row = blaze::row(slice, j);
-                auto result_row = blaze::row(result_slice, j);
+                auto slice = blaze::rowslice(t, i);
+                auto result_slice = blaze::rowslice(result, i);
+                for (std::size_t j = 0; j != blaze::rows(slice); ++j)
+                {
+                    auto row = blaze::row(slice, j);
+                    auto result_row = blaze::row(result_slice, j);
 
-                Op{}(row.begin(), row.end(), result_row.begin(), init);
-            }
-        }
+                    Op{}(row.begin(), row.end(), result_row.begin(),
+                        Op::template initial<T>());
+                }
+            });
 
         return primitive_argument_type{std::move(result)};
     }
@@ -287,19 +407,22 @@ namespace phylanx { namespace execution_tree { namespace primitives
         auto t = value.tensor();
 
         blaze::DynamicTensor<T> result(t.pages(), t.rows(), t.columns());
-        T init = Op::template initial<T>();
-        for (std::size_t k = 0; k != t.pages(); ++k)
-        {
-            auto slice = blaze::pageslice(t, k);
-            auto result_slice = blaze::pageslice(result, k);
-            for (std::size_t j = 0; j != blaze::columns(slice); ++j)
+
+        // the page slices are independent of each other
+        detail::cumulative_for_slices(t.pages(), t.rows() * t.columns(),
+            [&](std::size_t k)
             {
-                auto col = blaze::column(slice, j);
-                auto result_col = blaze::column(result_slice, j);
+                auto slice = blaze::pageslice(t, k);
+                auto result_slice = blaze::pageslice(result, k);
+                for (std::size_t j = 0; j != blaze::columns(slice); ++j)
+                {
+                    auto col = blaze::column(slice, j);
+                    auto result_col = blaze::column(result_slice, j);
 
-                Op{}(col.begin(), col.end(), result_col.begin(), init);
-            }
-        }
+                    Op{}(col.begin(), col.end(), result_col.begin(),
+                        Op::template initial<T>());
+                }
+            });
 
         return primitive_argument_type{std::move(result)};
     }
@@ -318,19 +441,22 @@ namespace phylanx { namespace execution_tree { namespace primitives
         auto t = value.tensor();
 
         blaze::DynamicTensor<T> result(t.pages(), t.rows(), t.columns());
-        T init = Op::template initial<T>();
-        for (std::size_t k = 0; k != t.pages(); ++k)
-        {
-            auto slice = blaze::pageslice(t, k);
-            auto result_slice = blaze::pageslice(result, k);
-            for (std::size_t j = 0; j != blaze::rows(slice); ++j)
+
+        // the page slices are independent of each other
+        detail::cumulative_for_slices(t.pages(), t.rows() * t.columns(),
+            [&](std::size_t k)
             {
-                auto row = blaze::row(slice, j);
-                auto result_row = blaze::row(result_slice, j);
+                auto slice = blaze::pageslice(t, k);
+                auto result_slice = blaze::pageslice(result, k);
+                for (std::size_t j = 0; j != blaze::rows(slice); ++j)
+                {
+                    auto row = blaze::row(slice, j);
+                    auto result_row = blaze::row(result_slice, j);
 
-                Op{}(row.begin(), row.end(), result_row.begin(), init);
-            }
-        }
+                    Op{}(row.begin(), row.end(), result_row.begin(),
+                        Op::template initial<T>());
+                }
+            });
 
         return primitive_argument_type{std::move(result)};
     }
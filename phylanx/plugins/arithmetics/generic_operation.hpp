@@ -13,6 +13,7 @@
 #include <phylanx/execution_tree/primitives/node_data_helpers.hpp>
 #include <phylanx/execution_tree/primitives/primitive_component_base.hpp>
 #include <phylanx/ir/node_data.hpp>
+#include <phylanx/util/vector_math.hpp>
 
 #include <hpx/lcos/future.hpp>
 
@@ -68,6 +69,9 @@ namespace phylanx { namespace execution_tree { namespace primitives
         primitive_argument_type generic1d(primitive_argument_type&& op) const;
         primitive_argument_type generic2d(primitive_argument_type&& op) const;
 
+        // evaluate the function using the vectorized kernels, if available
+        primitive_argument_type generic_math(arg_type<double>&& op) const;
+
         template <typename T>
         static std::map<std::string, scalar_function_ptr<T>> const&
             get_0d_map();
@@ -108,6 +112,8 @@ namespace phylanx { namespace execution_tree { namespace primitives
         std::string func_name_;
         node_data_type dtype_;
         bool retain_argument_type_;
+        bool has_math_function_;
+        util::math_function math_function_;
     };
 
     inline primitive create_generic_operation(hpx::id_type const& locality,
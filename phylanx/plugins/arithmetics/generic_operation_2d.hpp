@@ -487,7 +487,7 @@ namespace phylanx { namespace execution_tree { namespace primitives
     generic_operation::get_2d_function(std::string const& funcname,
         std::string const& name, std::string const& codename)
     {
-        auto func_map = get_2d_map<T>();
+        auto const& func_map = get_2d_map<T>();
         auto it = func_map.find(funcname);
         if (it == func_map.end())
         {
@@ -498,7 +498,7 @@ namespace phylanx { namespace execution_tree { namespace primitives
     generic_operation::get_3d_function(std::string const& funcname,
         std::string const& name, std::string const& codename)
     {
-        auto func_map = get_3d_map<T>();
+        auto const& func_map = get_3d_map<T>();
         auto it = func_map.find(funcname);
         if (it == func_map.end())
         {
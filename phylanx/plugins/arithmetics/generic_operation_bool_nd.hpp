@@ -37,7 +37,7 @@ namespace phylanx { namespace execution_tree { namespace primitives
     generic_operation_bool::get_0d_function(std::string const& funcname,
         std::string const& name, std::string const& codename)
     {
-        auto func_map = get_0d_map<T>();
+        auto const& func_map = get_0d_map<T>();
         auto it = func_map.find(funcname);
         if (it == func_map.end())
         {
@@ -55,7 +55,7 @@ namespace phylanx { namespace execution_tree { namespace primitives
     generic_operation_bool::get_1d_function(std::string const& funcname,
         std::string const& name, std::string const& codename)
     {
-        auto func_map = get_1d_map<T>();
+        auto const& func_map = get_1d_map<T>();
         auto it = func_map.find(funcname);
         if (it == func_map.end())
         {
@@ -73,7 +73,7 @@ namespace phylanx { namespace execution_tree { namespace primitives
     generic_operation_bool::get_2d_function(std::string const& funcname,
         std::string const& name, std::string const& codename)
     {
-        auto func_map = get_2d_map<T>();
+        auto const& func_map = get_2d_map<T>();
         auto it = func_map.find(funcname);
         if (it == func_map.end())
         {
@@ -92,7 +92,7 @@ namespace phylanx { namespace execution_tree { namespace primitives
     generic_operation_bool::get_3d_function(std::string const& funcname,
         std::string const& name, std::string const& codename)
     {
-        auto func_map = get_3d_map<T>();
+        auto const& func_map = get_3d_map<T>();
         auto it = func_map.find(funcname);
         if (it == func_map.end())
         {
@@ -16,8 +16,10 @@
 #include <phylanx/plugins/controls/if_conditional.hpp>
 #include <phylanx/plugins/controls/fmap_operation.hpp>
 #include <phylanx/plugins/controls/parallel_block_operation.hpp>
+#include <phylanx/plugins/controls/parallel_for_each.hpp>
 #include <phylanx/plugins/controls/parallel_map_operation.hpp>
 #include <phylanx/plugins/controls/range_operation.hpp>
+#include <phylanx/plugins/controls/vmap_operation.hpp>
 #include <phylanx/plugins/controls/while_operation.hpp>
 
 #endif
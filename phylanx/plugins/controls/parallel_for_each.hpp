@@ -0,0 +1,83 @@
+// Copyright (c) 2019 Hartmut Kaiser
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#if !defined(PHYLANX_PRIMITIVES_PARALLEL_FOR_EACH_JUL_03_2019_1145AM)
+#define PHYLANX_PRIMITIVES_PARALLEL_FOR_EACH_JUL_03_2019_1145AM
+
+#include <phylanx/config.hpp>
+#include <phylanx/execution_tree/primitives/base_primitive.hpp>
+#include <phylanx/execution_tree/primitives/primitive_component_base.hpp>
+#include <phylanx/util/chunk_policy.hpp>
+
+#include <hpx/lcos/future.hpp>
+
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace phylanx { namespace execution_tree { namespace primitives
+{
+    /// parallel_for_each(func, range, schedule, chunk_size) invokes func for
+    /// each element of range, the iterations are split into chunks according
+    /// to the given schedule ('auto', 'static', 'dynamic', or 'guided').
+    ///
+    /// parallel_reduce(func, range, reduce_func, initial, schedule,
+    /// chunk_size) additionally combines the values returned by all
+    /// invocations of func using reduce_func.
+    class parallel_for_each
+      : public primitive_component_base
+      , public std::enable_shared_from_this<parallel_for_each>
+    {
+    public:
+        static std::vector<match_pattern_type> const match_data;
+
+        parallel_for_each() = default;
+
+        parallel_for_each(primitive_arguments_type&& operands,
+            std::string const& name, std::string const& codename);
+
+    protected:
+        hpx::future<primitive_argument_type> eval(
+            primitive_arguments_type const& operands,
+            primitive_arguments_type const& args,
+            eval_context ctx) const override;
+
+    private:
+        util::chunk_policy extract_chunk_policy(
+            primitive_argument_type const& schedule,
+            primitive_argument_type const& chunk_size) const;
+        primitive const* extract_invocable(
+            primitive_argument_type const& f, char const* argname) const;
+
+        hpx::future<primitive_argument_type> for_each(
+            primitive_arguments_type const& operands,
+            primitive_arguments_type const& args, eval_context ctx) const;
+        hpx::future<primitive_argument_type> reduce(
+            primitive_arguments_type const& operands,
+            primitive_arguments_type const& args, eval_context ctx) const;
+
+    private:
+        bool reduce_;
+    };
+
+    inline primitive create_parallel_for_each(hpx::id_type const& locality,
+        primitive_arguments_type&& operands,
+        std::string const& name = "", std::string const& codename = "")
+    {
+        return create_primitive_component(locality, "parallel_for_each",
+            std::move(operands), name, codename);
+    }
+
+    inline primitive create_parallel_reduce(hpx::id_type const& locality,
+        primitive_arguments_type&& operands,
+        std::string const& name = "", std::string const& codename = "")
+    {
+        return create_primitive_component(locality, "parallel_reduce",
+            std::move(operands), name, codename);
+    }
+}}}
+
+#endif
@@ -0,0 +1,77 @@
+// Copyright (c) 2019 Hartmut Kaiser
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#if !defined(PHYLANX_VMAP_OPERATION_JUL_02_2019_0915AM)
+#define PHYLANX_VMAP_OPERATION_JUL_02_2019_0915AM
+
+#include <phylanx/config.hpp>
+#include <phylanx/execution_tree/primitives/base_primitive.hpp>
+#include <phylanx/execution_tree/primitives/primitive_component_base.hpp>
+
+#include <hpx/lcos/future.hpp>
+
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace phylanx { namespace execution_tree { namespace primitives
+{
+    /// vmap(func, a, lift) applies func to every element of a 1-d array, or
+    /// to every row of a 2-d array. If func is composed of element-wise
+    /// operations only (or lift is true), func is invoked once for the whole
+    /// array instead of once per element or row.
+    class vmap_operation
+      : public primitive_component_base
+      , public std::enable_shared_from_this<vmap_operation>
+    {
+    public:
+        static match_pattern_type const match_data;
+
+        vmap_operation() = default;
+
+        vmap_operation(primitive_arguments_type&& operands,
+            std::string const& name, std::string const& codename);
+
+    protected:
+        hpx::future<primitive_argument_type> eval(
+            primitive_arguments_type const& operands,
+            primitive_arguments_type const& args,
+            eval_context ctx) const override;
+
+    private:
+        bool can_lift(primitive const* p) const;
+
+        primitive_argument_type vmap_lifted(primitive const* p,
+            primitive_argument_type&& arg, eval_context ctx) const;
+
+        template <typename T>
+        primitive_argument_type combine_results(
+            primitive_arguments_type&& results) const;
+        primitive_argument_type combine_results(
+            primitive_arguments_type&& results) const;
+
+        template <typename T>
+        primitive_argument_type vmap_1d(primitive const* p,
+            ir::node_data<T>&& arg, eval_context ctx) const;
+        template <typename T>
+        primitive_argument_type vmap_2d(primitive const* p,
+            ir::node_data<T>&& arg, eval_context ctx) const;
+
+        template <typename T>
+        primitive_argument_type vmap(primitive const* p,
+            ir::node_data<T>&& arg, eval_context ctx) const;
+    };
+
+    inline primitive create_vmap_operation(hpx::id_type const& locality,
+        primitive_arguments_type&& operands,
+        std::string const& name = "", std::string const& codename = "")
+    {
+        return create_primitive_component(
+            locality, "vmap", std::move(operands), name, codename);
+    }
+}}}
+
+#endif
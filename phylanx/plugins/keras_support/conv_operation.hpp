@@ -0,0 +1,102 @@
+// Copyright (c) 2019 Hartmut Kaiser
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#if !defined(PHYLANX_PLUGINS_CONV_OPERATION_JUL_15_2019_1115AM)
+#define PHYLANX_PLUGINS_CONV_OPERATION_JUL_15_2019_1115AM
+
+#include <phylanx/config.hpp>
+#include <phylanx/execution_tree/primitives/base_primitive.hpp>
+#include <phylanx/execution_tree/primitives/detail/sliding_window.hpp>
+#include <phylanx/execution_tree/primitives/primitive_component_base.hpp>
+#include <phylanx/ir/node_data.hpp>
+
+#include <hpx/lcos/future.hpp>
+
+#include <array>
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace phylanx { namespace execution_tree { namespace primitives
+{
+    /// \brief Strided and dilated 1-D and 2-D convolutions (more precisely:
+    /// cross-correlations, as in Keras) with 'valid', 'same', or 'causal'
+    /// padding.
+    ///
+    /// Convolutions with unit strides are evaluated directly, accumulating
+    /// the (vectorized) contributions of every kernel element. Strided
+    /// convolutions gather the input windows into a matrix first (im2col)
+    /// and evaluate a single matrix product. Batches are processed in
+    /// parallel.
+    class conv_operation
+      : public primitive_component_base
+      , public std::enable_shared_from_this<conv_operation>
+    {
+    public:
+        enum conv_mode
+        {
+            conv_mode_1d,
+            conv_mode_2d
+        };
+
+    protected:
+        hpx::future<primitive_argument_type> eval(
+            primitive_arguments_type const& operands,
+            primitive_arguments_type const& args,
+            eval_context ctx) const override;
+
+    public:
+        static std::vector<match_pattern_type> const match_data;
+
+        conv_operation() = default;
+
+        conv_operation(primitive_arguments_type&& operands,
+            std::string const& name, std::string const& codename);
+
+    private:
+        struct parameters
+        {
+            std::array<std::size_t, 2> strides_;
+            std::array<std::size_t, 2> dilation_;
+            execution_tree::detail::padding_mode padding_;
+        };
+
+        parameters extract_parameters(primitive_arguments_type const& args,
+            std::size_t dims) const;
+
+        primitive_argument_type conv1d(ir::node_data<double>&& x,
+            ir::node_data<double>&& kernel, parameters const& p) const;
+        primitive_argument_type conv1d_vector(ir::node_data<double>&& x,
+            ir::node_data<double>&& kernel, parameters const& p) const;
+        primitive_argument_type conv1d_channels(ir::node_data<double>&& x,
+            ir::node_data<double>&& kernel, parameters const& p) const;
+
+        primitive_argument_type conv2d(ir::node_data<double>&& x,
+            ir::node_data<double>&& kernel, parameters const& p) const;
+
+    private:
+        conv_mode mode_;
+    };
+
+    inline primitive create_conv1d_operation(hpx::id_type const& locality,
+        primitive_arguments_type&& operands,
+        std::string const& name = "", std::string const& codename = "")
+    {
+        return create_primitive_component(
+            locality, "conv1d", std::move(operands), name, codename);
+    }
+
+    inline primitive create_conv2d_operation(hpx::id_type const& locality,
+        primitive_arguments_type&& operands,
+        std::string const& name = "", std::string const& codename = "")
+    {
+        return create_primitive_component(
+            locality, "conv2d", std::move(operands), name, codename);
+    }
+}}}
+
+#endif
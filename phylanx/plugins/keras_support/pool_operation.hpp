@@ -0,0 +1,92 @@
+// Copyright (c) 2019 Hartmut Kaiser
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#if !defined(PHYLANX_PLUGINS_POOL_OPERATION_JUL_15_2019_0340PM)
+#define PHYLANX_PLUGINS_POOL_OPERATION_JUL_15_2019_0340PM
+
+#include <phylanx/config.hpp>
+#include <phylanx/execution_tree/primitives/base_primitive.hpp>
+#include <phylanx/execution_tree/primitives/detail/sliding_window.hpp>
+#include <phylanx/execution_tree/primitives/primitive_component_base.hpp>
+#include <phylanx/ir/node_data.hpp>
+
+#include <hpx/lcos/future.hpp>
+
+#include <array>
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace phylanx { namespace execution_tree { namespace primitives
+{
+    /// \brief Max and average pooling over 1-D windows (of inputs shaped
+    /// (batch, steps, channels)) or 2-D windows (of single channel inputs
+    /// shaped (batch, rows, columns)).
+    ///
+    /// Windows reaching into the padding consider the valid input elements
+    /// only, i.e. average pooling divides by the number of valid elements.
+    /// All channels of a window are processed at once, batches are processed
+    /// in parallel.
+    class pool_operation
+      : public primitive_component_base
+      , public std::enable_shared_from_this<pool_operation>
+    {
+    public:
+        enum pool_mode
+        {
+            pool_mode_max,
+            pool_mode_avg
+        };
+
+    protected:
+        hpx::future<primitive_argument_type> eval(
+            primitive_arguments_type const& operands,
+            primitive_arguments_type const& args,
+            eval_context ctx) const override;
+
+    public:
+        static std::vector<match_pattern_type> const match_data;
+
+        pool_operation() = default;
+
+        pool_operation(primitive_arguments_type&& operands,
+            std::string const& name, std::string const& codename);
+
+    private:
+        primitive_argument_type pool1d(ir::node_data<double>&& x,
+            std::size_t pool_size, std::size_t stride,
+            execution_tree::detail::padding_mode padding) const;
+        primitive_argument_type pool2d(ir::node_data<double>&& x,
+            std::array<std::size_t, 2> const& pool_size,
+            std::array<std::size_t, 2> const& strides,
+            execution_tree::detail::padding_mode padding) const;
+
+        execution_tree::detail::padding_mode extract_padding(
+            primitive_arguments_type const& args) const;
+
+    private:
+        pool_mode mode_;
+    };
+
+    inline primitive create_max_pool_operation(hpx::id_type const& locality,
+        primitive_arguments_type&& operands,
+        std::string const& name = "", std::string const& codename = "")
+    {
+        return create_primitive_component(
+            locality, "max_pool", std::move(operands), name, codename);
+    }
+
+    inline primitive create_avg_pool_operation(hpx::id_type const& locality,
+        primitive_arguments_type&& operands,
+        std::string const& name = "", std::string const& codename = "")
+    {
+        return create_primitive_component(
+            locality, "avg_pool", std::move(operands), name, codename);
+    }
+}}}
+
+#endif
@@ -0,0 +1,70 @@
+// Copyright (c) 2019 Hartmut Kaiser
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#if !defined(PHYLANX_PLUGINS_SOFTMAX_CROSS_ENTROPY_JUL_17_2019_1040AM)
+#define PHYLANX_PLUGINS_SOFTMAX_CROSS_ENTROPY_JUL_17_2019_1040AM
+
+#include <phylanx/config.hpp>
+#include <phylanx/execution_tree/primitives/base_primitive.hpp>
+#include <phylanx/execution_tree/primitives/primitive_component_base.hpp>
+#include <phylanx/ir/node_data.hpp>
+
+#include <hpx/lcos/future.hpp>
+
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace phylanx { namespace execution_tree { namespace primitives
+{
+    /// \brief Computes the categorical cross entropy between the softmax of
+    /// the given logits and the given labels along the last axis, i.e.
+    /// -sum(labels * log_softmax(logits), axis=-1), without materializing
+    /// the softmax. The labels are either probabilities of the same shape
+    /// as the logits (e.g. one-hot encoded) or integer class indices with
+    /// one dimension less than the logits.
+    class softmax_cross_entropy_operation
+      : public primitive_component_base
+      , public std::enable_shared_from_this<softmax_cross_entropy_operation>
+    {
+    protected:
+        hpx::future<primitive_argument_type> eval(
+            primitive_arguments_type const& operands,
+            primitive_arguments_type const& args,
+            eval_context ctx) const override;
+
+    public:
+        static match_pattern_type const match_data;
+
+        softmax_cross_entropy_operation() = default;
+
+        softmax_cross_entropy_operation(primitive_arguments_type&& operands,
+            std::string const& name, std::string const& codename);
+
+    private:
+        primitive_argument_type cross_entropy1d(ir::node_data<double>&& logits,
+            ir::node_data<double>&& labels) const;
+        primitive_argument_type cross_entropy2d(ir::node_data<double>&& logits,
+            ir::node_data<double>&& labels) const;
+#if defined(PHYLANX_HAVE_BLAZE_TENSOR)
+        primitive_argument_type cross_entropy3d(ir::node_data<double>&& logits,
+            ir::node_data<double>&& labels) const;
+#endif
+
+        std::size_t extract_label(double label, std::size_t classes) const;
+    };
+
+    inline primitive create_softmax_cross_entropy_operation(
+        hpx::id_type const& locality, primitive_arguments_type&& operands,
+        std::string const& name = "", std::string const& codename = "")
+    {
+        return create_primitive_component(locality, "softmax_cross_entropy",
+            std::move(operands), name, codename);
+    }
+}}}
+
+#endif
@@ -29,11 +29,23 @@ namespace phylanx {  namespace execution_tree {  namespace primitives  {
 /// \param a      The scalar, vector, or matrix to perform softmax over
 /// \param axis   Optional. The default is the last axis (axis == -1). Effective
 ///               when the array is >1d
+///
+/// log_softmax(a, axis) returns log(softmax(a, axis)), computed without
+/// evaluating the softmax first. Both are evaluated line by line (in
+/// parallel for large arrays), subtracting the maximum of each line before
+/// exponentiating.
 
     class softmax_operation
         : public primitive_component_base
         , public std::enable_shared_from_this<softmax_operation>
     {
+    public:
+        enum softmax_mode
+        {
+            softmax_mode_softmax,
+            softmax_mode_log
+        };
+
     protected:
         hpx::future<primitive_argument_type> eval(
             primitive_arguments_type const& operands,
@@ -43,7 +55,7 @@ namespace phylanx {  namespace execution_tree {  namespace primitives  {
         using arg_type = ir::node_data<val_type>;
 
     public:
-        static match_pattern_type const match_data;
+        static std::vector<match_pattern_type> const match_data;
 
         softmax_operation() = default;
 
@@ -65,6 +77,9 @@ namespace phylanx {  namespace execution_tree {  namespace primitives  {
         primitive_argument_type softmax3d(
             arg_type&& arg, std::int64_t axis) const;
 #endif
+
+    private:
+        softmax_mode mode_;
     };
     inline primitive create_softmax_operation(hpx::id_type const& locality,
         primitive_arguments_type&& operands,
@@ -73,6 +88,14 @@ namespace phylanx {  namespace execution_tree {  namespace primitives  {
         return create_primitive_component(
             locality, "softmax", std::move(operands), name, codename);
     }
+
+    inline primitive create_log_softmax_operation(hpx::id_type const& locality,
+        primitive_arguments_type&& operands,
+        std::string const& name = "", std::string const& codename = "")
+    {
+        return create_primitive_component(
+            locality, "log_softmax", std::move(operands), name, codename);
+    }
 }}}
 
 #endif
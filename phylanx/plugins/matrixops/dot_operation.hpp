@@ -12,6 +12,7 @@
 #include <phylanx/execution_tree/primitives/base_primitive.hpp>
 #include <phylanx/execution_tree/primitives/primitive_component_base.hpp>
 #include <phylanx/ir/node_data.hpp>
+#include <phylanx/util/gemm.hpp>
 
 #include <hpx/lcos/future.hpp>
 
@@ -54,6 +55,8 @@ namespace phylanx { namespace execution_tree { namespace primitives
 
     private:
         void positivize_axis(val_type& axis, std::size_t const& dim) const;
+        util::gemm_backend extract_gemm_backend(
+            std::string const& backend) const;
 
         template <typename T>
         blaze::DynamicVector<T> convert_to_1d(ir::node_data<T>&& arr) const;
@@ -99,11 +102,11 @@ namespace phylanx { namespace execution_tree { namespace primitives
             primitive_argument_type&& lhs, primitive_argument_type&& rhs) const;
         primitive_argument_type dot1d(
             primitive_argument_type&& lhs, primitive_argument_type&& rhs) const;
-        primitive_argument_type dot2d(
-            primitive_argument_type&& lhs, primitive_argument_type&& rhs) const;
+        primitive_argument_type dot2d(primitive_argument_type&& lhs,
+            primitive_argument_type&& rhs, util::gemm_backend backend) const;
 
-        primitive_argument_type dot_nd(
-            primitive_argument_type&& lhs, primitive_argument_type&& rhs) const;
+        primitive_argument_type dot_nd(primitive_argument_type&& lhs,
+            primitive_argument_type&& rhs, util::gemm_backend backend) const;
 
         template <typename T>
         primitive_argument_type dot0d(
@@ -132,16 +135,17 @@ namespace phylanx { namespace execution_tree { namespace primitives
             ir::node_data<T>&& lhs, ir::node_data<T>&& rhs) const;
 
         template <typename T>
-        primitive_argument_type dot2d(
-            ir::node_data<T>&& lhs, ir::node_data<T>&& rhs) const;
+        primitive_argument_type dot2d(ir::node_data<T>&& lhs,
+            ir::node_data<T>&& rhs, util::gemm_backend backend) const;
         template <typename T>
         primitive_argument_type dot2d0d(
             ir::node_data<T>&& lhs, ir::node_data<T>&& rhs) const;
         template <typename T>
-        primitive_argument_type dot2d1d(
-            ir::node_data<T>&& lhs, ir::node_data<T>&& rhs) const;
+        primitive_argument_type dot2d1d(ir::node_data<T>&& lhs,
+            ir::node_data<T>&& rhs, util::gemm_backend backend) const;
         template <typename Matrix1, typename Matrix2>
-        primitive_argument_type dot2d2d(Matrix1&& lhs, Matrix2&& rhs) const;
+        primitive_argument_type dot2d2d(Matrix1&& lhs, Matrix2&& rhs,
+            util::gemm_backend backend) const;
 
 #if defined(PHYLANX_HAVE_BLAZE_TENSOR)
         template <typename T>
@@ -12,6 +12,7 @@
 #include <phylanx/execution_tree/primitives/node_data_helpers.hpp>
 #include <phylanx/ir/node_data.hpp>
 #include <phylanx/plugins/matrixops/dot_operation.hpp>
+#include <phylanx/util/gemm.hpp>
 
 #include <hpx/include/lcos.hpp>
 #include <hpx/include/naming.hpp>
@@ -19,6 +20,7 @@
 #include <hpx/throw_exception.hpp>
 
 #include <cstddef>
+#include <cstdint>
 #include <memory>
 #include <string>
 #include <type_traits>
@@ -276,8 +278,8 @@ namespace phylanx { namespace execution_tree { namespace primitives
     }
 
     template <typename T>
-    primitive_argument_type dot_operation::dot2d1d(
-        ir::node_data<T>&& lhs, ir::node_data<T>&& rhs) const
+    primitive_argument_type dot_operation::dot2d1d(ir::node_data<T>&& lhs,
+        ir::node_data<T>&& rhs, util::gemm_backend backend) const
     {
         if (lhs.dimension(1) != rhs.size())
         {
@@ -287,13 +289,31 @@ namespace phylanx { namespace execution_tree { namespace primitives
                     "the operands have incompatible number of dimensions"));
         }
 
-        rhs = lhs.matrix() * rhs.vector();
+        auto m = lhs.matrix();
+        std::size_t const work = m.rows() * m.columns();
+
+        std::int64_t t = hpx::util::high_resolution_clock::now();
+
+        if (util::use_tiled_gemm(backend, work))
+        {
+            blaze::DynamicVector<T> result(m.rows());
+            util::tiled_gemv(m, rhs.vector(), result);
+            rhs = std::move(result);
+        }
+        else
+        {
+            rhs = m * rhs.vector();
+        }
+
+        util::record_gemm(2 * std::int64_t(work),
+            hpx::util::high_resolution_clock::now() - t);
+
         return primitive_argument_type{std::move(rhs)};
     }
 
     template <typename Matrix1, typename Matrix2>
     primitive_argument_type dot_operation::dot2d2d(
-        Matrix1&& lhs, Matrix2&& rhs) const
+        Matrix1&& lhs, Matrix2&& rhs, util::gemm_backend backend) const
     {
         if (lhs.columns() != rhs.rows())
         {
@@ -302,8 +322,26 @@ namespace phylanx { namespace execution_tree { namespace primitives
                 generate_error_message(
                     "the operands have incompatible number of dimensions"));
         }
+
+        std::size_t const work = lhs.rows() * lhs.columns() * rhs.columns();
+
+        std::int64_t t = hpx::util::high_resolution_clock::now();
+
         using T = blaze::ElementType_t<typename std::decay<Matrix1>::type>;
-        blaze::DynamicMatrix<T> result = lhs * rhs;
+        blaze::DynamicMatrix<T> result;
+        if (util::use_tiled_gemm(backend, work))
+        {
+            result.resize(lhs.rows(), rhs.columns(), false);
+            util::tiled_gemm(lhs, rhs, result);
+        }
+        else
+        {
+            result = lhs * rhs;
+        }
+
+        util::record_gemm(2 * std::int64_t(work),
+            hpx::util::high_resolution_clock::now() - t);
+
         return primitive_argument_type{std::move(result)};
     }
 
@@ -338,8 +376,8 @@ namespace phylanx { namespace execution_tree { namespace primitives
     // Multiply a matrix with a vector
     // Regular matrix multiplication
     template <typename T>
-    primitive_argument_type dot_operation::dot2d(
-        ir::node_data<T>&& lhs, ir::node_data<T>&& rhs) const
+    primitive_argument_type dot_operation::dot2d(ir::node_data<T>&& lhs,
+        ir::node_data<T>&& rhs, util::gemm_backend backend) const
     {
         switch (rhs.num_dimensions())
         {
@@ -349,11 +387,11 @@ namespace phylanx { namespace execution_tree { namespace primitives
 
         case 1:
             // If is_matrix(lhs) && is_vector(rhs)
-            return dot2d1d(std::move(lhs), std::move(rhs));
+            return dot2d1d(std::move(lhs), std::move(rhs), backend);
 
         case 2:
             // If is_matrix(lhs) && is_matrix(rhs)
-            return dot2d2d(lhs.matrix(), rhs.matrix());
+            return dot2d2d(lhs.matrix(), rhs.matrix(), backend);
 
 #if defined(PHYLANX_HAVE_BLAZE_TENSOR)
         case 3:
@@ -1074,7 +1112,8 @@ namespace phylanx { namespace execution_tree { namespace primitives
                     return dot1d2d(std::move(lhs), std::move(rhs));
 
                 else if(axis_a == 0 && axis_b == 1)
-                    return dot2d1d(std::move(rhs), std::move(lhs));
+                    return dot2d1d(std::move(rhs), std::move(lhs),
+                        util::default_gemm_backend());
 
                 HPX_THROW_EXCEPTION(hpx::bad_parameter,
                     "dot_operation::tensordot_range_of_scalars",
@@ -1112,7 +1151,8 @@ namespace phylanx { namespace execution_tree { namespace primitives
                     return dot1d2d(std::move(rhs), std::move(lhs));
 
                 else if (axis_a == 1 && axis_b == 0)
-                    return dot2d1d(std::move(lhs), std::move(rhs));
+                    return dot2d1d(std::move(lhs), std::move(rhs),
+                        util::default_gemm_backend());
 
                 HPX_THROW_EXCEPTION(hpx::bad_parameter,
                     "dot_operation::tensordot_range_of_scalars",
@@ -1124,16 +1164,19 @@ namespace phylanx { namespace execution_tree { namespace primitives
             else if (b_dims == 2)
             {
                 if (axis_a == 0 && axis_b == 0)
-                    return dot2d2d(blaze::trans(lhs.matrix()), rhs.matrix());
+                    return dot2d2d(blaze::trans(lhs.matrix()), rhs.matrix(),
+                        util::default_gemm_backend());
 
                 else if(axis_a == 0 && axis_b == 1)
                     return tensordot2d2d_0_1(std::move(lhs), std::move(rhs));
 
                 else if(axis_a == 1 && axis_b == 0)
-                    return dot2d2d(lhs.matrix(), rhs.matrix());
+                    return dot2d2d(lhs.matrix(), rhs.matrix(),
+                        util::default_gemm_backend());
 
                 else if(axis_a == 1 && axis_b == 1)
-                    return dot2d2d(lhs.matrix(), blaze::trans(rhs.matrix()));
+                    return dot2d2d(lhs.matrix(), blaze::trans(rhs.matrix()),
+                        util::default_gemm_backend());
 
                 HPX_THROW_EXCEPTION(hpx::bad_parameter,
                     "dot_operation::tensordot_range_of_scalars",
@@ -0,0 +1,66 @@
+// Copyright (c) 2019 Hartmut Kaiser
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#if !defined(PHYLANX_EINSUM_JUL_12_2019_0940AM)
+#define PHYLANX_EINSUM_JUL_12_2019_0940AM
+
+#include <phylanx/config.hpp>
+#include <phylanx/execution_tree/primitives/base_primitive.hpp>
+#include <phylanx/execution_tree/primitives/primitive_component_base.hpp>
+#include <phylanx/ir/node_data.hpp>
+
+#include <hpx/lcos/future.hpp>
+
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace phylanx { namespace execution_tree { namespace primitives
+{
+    /// \brief Implementation of einsum as a Phylanx primitive. The operands
+    /// are contracted pairwise in the order which minimizes the overall
+    /// number of operations. Every pairwise contraction is mapped onto a
+    /// (batched) matrix product operating directly on the memory of the
+    /// operands whenever their layout allows for it.
+    class einsum
+      : public primitive_component_base
+      , public std::enable_shared_from_this<einsum>
+    {
+    protected:
+        hpx::future<primitive_argument_type> eval(
+            primitive_arguments_type const& operands,
+            primitive_arguments_type const& args,
+            eval_context ctx) const override;
+
+    public:
+        static match_pattern_type const match_data;
+
+        einsum() = default;
+
+        einsum(primitive_arguments_type&& operands,
+            std::string const& name, std::string const& codename);
+
+    private:
+        struct subscripts;
+
+        subscripts parse_subscripts(std::string const& spec,
+            std::vector<ir::node_data<double>> const& arrays) const;
+
+        primitive_argument_type einsum_args(
+            primitive_arguments_type&& args) const;
+    };
+
+    inline primitive create_einsum(hpx::id_type const& locality,
+        primitive_arguments_type&& operands,
+        std::string const& name = "", std::string const& codename = "")
+    {
+        return create_primitive_component(
+            locality, "einsum", std::move(operands), name, codename);
+    }
+}}}
+
+#endif
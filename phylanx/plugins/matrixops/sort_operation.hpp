@@ -0,0 +1,111 @@
+// Copyright (c) 2019 Hartmut Kaiser
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#if !defined(PHYLANX_SORT_OPERATION_JUL_05_2019_0225PM)
+#define PHYLANX_SORT_OPERATION_JUL_05_2019_0225PM
+
+#include <phylanx/config.hpp>
+#include <phylanx/execution_tree/primitives/base_primitive.hpp>
+#include <phylanx/execution_tree/primitives/node_data_helpers.hpp>
+#include <phylanx/execution_tree/primitives/primitive_component_base.hpp>
+#include <phylanx/ir/node_data.hpp>
+
+#include <hpx/lcos/future.hpp>
+#include <hpx/util/optional.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace phylanx { namespace execution_tree { namespace primitives
+{
+    /// \brief Implementation of sort, argsort, and searchsorted as Phylanx
+    /// primitives. These are intended to behave like the corresponding NumPy
+    /// functions. Long sequences are sorted using the parallel HPX sort.
+    class sort_operation
+      : public primitive_component_base
+      , public std::enable_shared_from_this<sort_operation>
+    {
+    public:
+        enum sort_mode
+        {
+            sort_mode_sort,             // sort
+            sort_mode_argsort,          // argsort
+            sort_mode_searchsorted      // searchsorted
+        };
+
+    protected:
+        hpx::future<primitive_argument_type> eval(
+            primitive_arguments_type const& operands,
+            primitive_arguments_type const& args,
+            eval_context ctx) const override;
+
+    public:
+        static std::vector<match_pattern_type> const match_data;
+
+        sort_operation() = default;
+
+        sort_operation(primitive_arguments_type&& operands,
+            std::string const& name, std::string const& codename);
+
+    private:
+        primitive_argument_type sort(primitive_arguments_type&& args) const;
+        primitive_argument_type searchsorted(
+            primitive_arguments_type&& args) const;
+
+        template <typename T>
+        primitive_argument_type sort0d(ir::node_data<T>&& arg) const;
+        template <typename T>
+        primitive_argument_type sort1d(ir::node_data<T>&& arg) const;
+        template <typename T>
+        primitive_argument_type sort2d_flatten(ir::node_data<T>&& arg) const;
+        template <typename T>
+        primitive_argument_type sort2d_rows(ir::node_data<T>&& arg) const;
+        template <typename T>
+        primitive_argument_type sort2d_columns(ir::node_data<T>&& arg) const;
+        template <typename T>
+        primitive_argument_type sort2d(ir::node_data<T>&& arg,
+            hpx::util::optional<std::int64_t> const& axis) const;
+        template <typename T>
+        primitive_argument_type sort_helper(ir::node_data<T>&& arg,
+            hpx::util::optional<std::int64_t> const& axis) const;
+
+        template <typename T>
+        primitive_argument_type searchsorted(ir::node_data<T>&& a,
+            ir::node_data<T>&& v, bool right) const;
+
+    private:
+        sort_mode mode_;
+    };
+
+    inline primitive create_sort_operation(hpx::id_type const& locality,
+        primitive_arguments_type&& operands,
+        std::string const& name = "", std::string const& codename = "")
+    {
+        return create_primitive_component(
+            locality, "sort", std::move(operands), name, codename);
+    }
+
+    inline primitive create_argsort_operation(hpx::id_type const& locality,
+        primitive_arguments_type&& operands,
+        std::string const& name = "", std::string const& codename = "")
+    {
+        return create_primitive_component(
+            locality, "argsort", std::move(operands), name, codename);
+    }
+
+    inline primitive create_searchsorted_operation(
+        hpx::id_type const& locality, primitive_arguments_type&& operands,
+        std::string const& name = "", std::string const& codename = "")
+    {
+        return create_primitive_component(
+            locality, "searchsorted", std::move(operands), name, codename);
+    }
+}}}
+
+#endif
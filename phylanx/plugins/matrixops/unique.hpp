@@ -23,7 +23,9 @@
 namespace phylanx { namespace execution_tree { namespace primitives
 {
     /// \brief Implementation of unique as a Phylanx primitive.
-    /// Returns the sorted unique elements of array a.
+    /// Returns the sorted unique elements of array a. Optionally returns the
+    /// indices of the first occurrences of the unique values and the number
+    /// of times each of the unique values appears in a.
     /// This implementation is intended to behave like [NumPy implementation of unique]
     /// (https://docs.scipy.org/doc/numpy-1.15.0/reference/generated/numpy.unique.html).
     /// \param a an array
@@ -46,30 +48,40 @@ namespace phylanx { namespace execution_tree { namespace primitives
                std::string const &codename);
 
     private:
-        primitive_argument_type unique0d(primitive_arguments_type &&args) const;
+        struct options;
 
-        primitive_argument_type unique1d(primitive_arguments_type &&args) const;
+        primitive_argument_type unique0d(
+            primitive_arguments_type&& args, options const& opts) const;
 
-        primitive_argument_type unique2d(primitive_arguments_type &&args) const;
+        primitive_argument_type unique1d(
+            primitive_arguments_type&& args, options const& opts) const;
 
-        template<typename T>
-        primitive_argument_type unique0d(ir::node_data <T> &&args) const;
+        primitive_argument_type unique2d(
+            primitive_arguments_type&& args, options const& opts) const;
 
-        template<typename T>
-        primitive_argument_type unique1d(ir::node_data <T> &&args) const;
+        template <typename T>
+        primitive_argument_type unique0d(
+            ir::node_data<T>&& arg, options const& opts) const;
+
+        template <typename T>
+        primitive_argument_type unique1d(
+            ir::node_data<T>&& arg, options const& opts) const;
 
-        template<typename T>
-        primitive_argument_type unique2d_flatten(ir::node_data <T> &&arg) const;
+        template <typename T>
+        primitive_argument_type unique2d_flatten(
+            ir::node_data<T>&& arg, options const& opts) const;
 
-        template<typename T>
-        primitive_argument_type unique2d_x_axis(ir::node_data <T> &&arg) const;
+        template <typename T>
+        primitive_argument_type unique2d_x_axis(
+            ir::node_data<T>&& arg, options const& opts) const;
 
-        template<typename T>
-        primitive_argument_type unique2d_y_axis(ir::node_data <T> &&arg) const;
+        template <typename T>
+        primitive_argument_type unique2d_y_axis(
+            ir::node_data<T>&& arg, options const& opts) const;
 
         template <typename T>
-        primitive_argument_type unique2d(std::size_t numargs,
-            ir::node_data<T>&& arg, std::int64_t axis) const;
+        primitive_argument_type unique2d(
+            ir::node_data<T>&& arg, options const& opts) const;
     };
 
     inline primitive create_unique(hpx::id_type const& locality,
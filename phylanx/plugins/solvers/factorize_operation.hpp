@@ -0,0 +1,95 @@
+//  Copyright (c) 2019 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#if !defined(PHYLANX_PLUGINS_FACTORIZE_OPERATION_JUL_10_2019_0330PM)
+#define PHYLANX_PLUGINS_FACTORIZE_OPERATION_JUL_10_2019_0330PM
+
+#include <phylanx/config.hpp>
+#include <phylanx/execution_tree/primitives/base_primitive.hpp>
+#include <phylanx/execution_tree/primitives/primitive_component_base.hpp>
+#include <phylanx/ir/node_data.hpp>
+#include <phylanx/ir/ranges.hpp>
+#include <phylanx/util/factorization.hpp>
+
+#include <hpx/lcos/future.hpp>
+
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace phylanx { namespace execution_tree { namespace primitives
+{
+    /// \brief Factorize a square matrix once and solve linear systems for
+    /// many right hand sides using this factorization.
+    ///
+    /// factorize(a, kind) returns a factorization object which can be stored
+    /// in a variable (and serialized) like any other value. Its contents are
+    /// an implementation detail. solve(f, b) solves a * x = b using the
+    /// factorization of a.
+    class factorize_operation
+      : public primitive_component_base
+      , public std::enable_shared_from_this<factorize_operation>
+    {
+    public:
+        enum factorize_mode
+        {
+            factorize_mode_factorize,
+            factorize_mode_solve
+        };
+
+    protected:
+        hpx::future<primitive_argument_type> eval(
+            primitive_arguments_type const& operands,
+            primitive_arguments_type const& args,
+            eval_context ctx) const override;
+
+    public:
+        static std::vector<match_pattern_type> const match_data;
+
+        factorize_operation() = default;
+
+        factorize_operation(primitive_arguments_type&& operands,
+            std::string const& name, std::string const& codename);
+
+    private:
+        primitive_argument_type factorize(
+            primitive_argument_type&& a, util::factorization_kind kind) const;
+        primitive_argument_type solve(
+            primitive_argument_type&& f, primitive_argument_type&& b) const;
+        template <typename MT>
+        primitive_argument_type solve(util::factorization_kind kind,
+            MT const& factors, int const* pivots,
+            primitive_argument_type&& b) const;
+
+        util::factorization_kind extract_kind(
+            primitive_argument_type const& kind) const;
+        util::factorization_kind extract_factorization(
+            ir::range const& elements) const;
+        util::factorization::matrix_type extract_square_matrix(
+            primitive_argument_type&& a) const;
+
+    private:
+        factorize_mode mode_;
+    };
+
+    inline primitive create_factorize_operation(hpx::id_type const& locality,
+        primitive_arguments_type&& operands,
+        std::string const& name = "", std::string const& codename = "")
+    {
+        return create_primitive_component(
+            locality, "factorize", std::move(operands), name, codename);
+    }
+
+    inline primitive create_solve_operation(hpx::id_type const& locality,
+        primitive_arguments_type&& operands,
+        std::string const& name = "", std::string const& codename = "")
+    {
+        return create_primitive_component(
+            locality, "solve", std::move(operands), name, codename);
+    }
+}}}
+
+#endif
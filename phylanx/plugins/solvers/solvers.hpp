@@ -7,6 +7,7 @@
 #define PHYLANX_PLUGINS_SOLVERS_PRIMITIVES_MAY_11_2018_1030AM
 
 #include <phylanx/plugins/solvers/decomposition.hpp>
+#include <phylanx/plugins/solvers/factorize_operation.hpp>
 #include <phylanx/plugins/solvers/linear_solver.hpp>
 
 #endif
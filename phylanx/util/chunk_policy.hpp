@@ -0,0 +1,105 @@
+//  Copyright (c) 2019 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#if !defined(PHYLANX_UTIL_CHUNK_POLICY_JUL_03_2019_1105AM)
+#define PHYLANX_UTIL_CHUNK_POLICY_JUL_03_2019_1105AM
+
+#include <phylanx/config.hpp>
+
+#include <hpx/include/parallel_executor_parameters.hpp>
+#include <hpx/include/parallel_execution_policy.hpp>
+
+#include <cstddef>
+#include <string>
+#include <utility>
+
+namespace phylanx { namespace util
+{
+    ///////////////////////////////////////////////////////////////////////////
+    // The schedule used to split an iteration space into chunks which are
+    // executed by a single HPX thread each.
+    enum chunk_schedule
+    {
+        chunk_schedule_auto,        // measure the first iterations to decide
+        chunk_schedule_static,      // equally sized chunks
+        chunk_schedule_dynamic,     // fixed size chunks, handed out on demand
+        chunk_schedule_guided       // exponentially decreasing chunk sizes
+    };
+
+    struct chunk_policy
+    {
+        chunk_policy(chunk_schedule schedule = chunk_schedule_auto,
+                std::size_t chunk_size = 0)
+          : schedule_(schedule)
+          , chunk_size_(chunk_size)
+        {}
+
+        chunk_schedule schedule_;
+
+        // the (minimal) chunk size, zero selects the default of the schedule
+        std::size_t chunk_size_;
+    };
+
+    // Convert the given name into a chunk_schedule, return false if the name
+    // is not known.
+    inline bool parse_chunk_schedule(
+        std::string const& name, chunk_schedule& schedule)
+    {
+        if (name == "auto")
+        {
+            schedule = chunk_schedule_auto;
+        }
+        else if (name == "static")
+        {
+            schedule = chunk_schedule_static;
+        }
+        else if (name == "dynamic")
+        {
+            schedule = chunk_schedule_dynamic;
+        }
+        else if (name == "guided")
+        {
+            schedule = chunk_schedule_guided;
+        }
+        else
+        {
+            return false;
+        }
+        return true;
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    // Invoke f with the given execution policy rebound to the executor
+    // parameters which implement the chunk policy.
+    template <typename ExPolicy, typename F>
+    auto with_chunk_policy(
+        ExPolicy&& policy, chunk_policy const& chunking, F&& f)
+    {
+        namespace execution = hpx::parallel::execution;
+
+        switch (chunking.schedule_)
+        {
+        case chunk_schedule_static:
+            return f(policy.with(
+                execution::static_chunk_size(chunking.chunk_size_)));
+
+        case chunk_schedule_dynamic:
+            return f(policy.with(execution::dynamic_chunk_size(
+                chunking.chunk_size_ == 0 ? 1 : chunking.chunk_size_)));
+
+        case chunk_schedule_guided:
+            return f(policy.with(execution::guided_chunk_size(
+                chunking.chunk_size_ == 0 ? 1 : chunking.chunk_size_)));
+
+        case chunk_schedule_auto: HPX_FALLTHROUGH;
+        default:
+            break;
+        }
+
+        return f(policy.with(execution::auto_chunk_size()));
+    }
+}}
+
+#endif
@@ -0,0 +1,143 @@
+//  Copyright (c) 2019 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#if !defined(PHYLANX_UTIL_FACTORIZATION_JUL_10_2019_0315PM)
+#define PHYLANX_UTIL_FACTORIZATION_JUL_10_2019_0315PM
+
+#include <phylanx/config.hpp>
+
+#include <cstddef>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <blaze/Math.h>
+
+namespace phylanx { namespace util
+{
+    ///////////////////////////////////////////////////////////////////////////
+    enum class factorization_kind
+    {
+        lu,             // general square matrices (getrf)
+        cholesky,       // symmetric positive definite matrices (potrf)
+        ldlt            // symmetric indefinite matrices (sytrf)
+    };
+
+    inline char const* factorization_kind_name(factorization_kind kind)
+    {
+        switch (kind)
+        {
+        case factorization_kind::cholesky:
+            return "cholesky";
+        case factorization_kind::ldlt:
+            return "ldlt";
+        case factorization_kind::lu: HPX_FALLTHROUGH;
+        default:
+            break;
+        }
+        return "lu";
+    }
+
+    inline bool parse_factorization_kind(
+        std::string const& name, factorization_kind& kind)
+    {
+        if (name == "lu")
+        {
+            kind = factorization_kind::lu;
+        }
+        else if (name == "cholesky")
+        {
+            kind = factorization_kind::cholesky;
+        }
+        else if (name == "ldlt")
+        {
+            kind = factorization_kind::ldlt;
+        }
+        else
+        {
+            return false;
+        }
+        return true;
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    // Factorization of a square matrix as computed by LAPACK. The factors
+    // are stored row-major, like any other matrix value. Blaze hands
+    // row-major matrices to LAPACK as their transpose and adjusts the
+    // requested operation accordingly, so solve consumes the factors in
+    // place, as long as it is given them in the layout they were computed in.
+    struct factorization
+    {
+        using matrix_type = blaze::DynamicMatrix<double>;
+
+        factorization_kind kind_;
+        matrix_type factors_;
+        std::vector<int> pivots_;     // empty for Cholesky factorizations
+    };
+
+    // Factorize the given matrix, the matrix is overwritten by the factors.
+    inline factorization factorize(
+        factorization::matrix_type&& a, factorization_kind kind)
+    {
+        factorization f{kind, std::move(a), {}};
+
+        switch (kind)
+        {
+        case factorization_kind::cholesky:
+            blaze::potrf(f.factors_, 'L');
+            break;
+
+        case factorization_kind::ldlt:
+            f.pivots_.resize(f.factors_.rows());
+            blaze::sytrf(f.factors_, 'L', f.pivots_.data());
+            break;
+
+        case factorization_kind::lu: HPX_FALLTHROUGH;
+        default:
+            f.pivots_.resize(f.factors_.rows());
+            blaze::getrf(f.factors_, f.pivots_.data());
+            break;
+        }
+
+        return f;
+    }
+
+    // Solve a * x = b using the factors (and pivots) of a as computed by
+    // factorize, the factors may be any row-major view of the computed
+    // ones. The right hand side(s) b are overwritten by the solution. If b
+    // is a matrix, it has to be column-major, every column is a right hand
+    // side.
+    template <typename MT, typename RHS>
+    void solve(factorization_kind kind, MT const& factors, int const* pivots,
+        RHS& b)
+    {
+        static_assert(!blaze::IsColumnMajorMatrix<MT>::value,
+            "the factors have to be stored row-major");
+
+        switch (kind)
+        {
+        case factorization_kind::cholesky:
+            blaze::potrs(factors, b, 'L');
+            break;
+
+        case factorization_kind::ldlt:
+            blaze::sytrs(factors, b, 'L', pivots);
+            break;
+
+        case factorization_kind::lu: HPX_FALLTHROUGH;
+        default:
+            blaze::getrs(factors, b, 'N', pivots);
+            break;
+        }
+    }
+
+    template <typename RHS>
+    void solve(factorization const& f, RHS& b)
+    {
+        solve(f.kind_, f.factors_, f.pivots_.data(), b);
+    }
+}}
+
+#endif
@@ -0,0 +1,171 @@
+//  Copyright (c) 2019 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#if !defined(PHYLANX_UTIL_GEMM_JUL_11_2019_1010AM)
+#define PHYLANX_UTIL_GEMM_JUL_11_2019_1010AM
+
+#include <phylanx/config.hpp>
+
+#include <hpx/include/parallel_for_loop.hpp>
+#include <hpx/include/runtime.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+#include <blaze/Math.h>
+
+namespace phylanx { namespace util
+{
+    ///////////////////////////////////////////////////////////////////////////
+    // The backend used to evaluate products of 2-D operands
+    enum class gemm_backend
+    {
+        automatic,      // tiled for large operands, blaze otherwise
+        blaze,          // let blaze evaluate the product
+        tiled           // tiles are evaluated by separate HPX threads
+    };
+
+    // Convert the given name into a gemm_backend, return false if the name
+    // is not known.
+    PHYLANX_EXPORT bool parse_gemm_backend(
+        std::string const& name, gemm_backend& backend);
+
+    // The backend selected by the configuration entry phylanx.dot.backend
+    // (default: 'auto').
+    PHYLANX_EXPORT gemm_backend default_gemm_backend();
+
+    // The minimal edge length of a tile (phylanx.dot.tile_size, default: 64)
+    PHYLANX_EXPORT std::size_t gemm_tile_size();
+
+    // The number of multiply-adds above which the automatic backend switches
+    // to the tiled evaluation (phylanx.dot.min_parallel_work, default: 2^22).
+    PHYLANX_EXPORT std::size_t gemm_min_parallel_work();
+
+    ///////////////////////////////////////////////////////////////////////////
+    // Performance counter data for all products of 2-D operands
+    PHYLANX_EXPORT void record_gemm(std::int64_t flop, std::int64_t duration);
+
+    PHYLANX_EXPORT std::int64_t gemm_flop_count(bool reset);
+    PHYLANX_EXPORT std::int64_t gemm_time(bool reset);
+
+    // The achieved performance in MFLOP/s since the last reset
+    PHYLANX_EXPORT std::int64_t gemm_mflops(bool reset);
+
+    ///////////////////////////////////////////////////////////////////////////
+    namespace detail
+    {
+        inline std::size_t num_tiles(std::size_t n, std::size_t tile_size)
+        {
+            return (n + tile_size - 1) / tile_size;
+        }
+
+        // Grow the tile size until there are no more than a few tiles per
+        // worker thread. This keeps the scheduling overhead low if the
+        // product is evaluated while other work is running concurrently.
+        inline std::size_t adjust_tile_size(
+            std::size_t m, std::size_t n, std::size_t tile_size)
+        {
+            std::size_t const max_tiles = 4 * hpx::get_num_worker_threads();
+            tile_size = (std::max)(tile_size, std::size_t(1));
+            while (num_tiles(m, tile_size) * num_tiles(n, tile_size) >
+                max_tiles)
+            {
+                tile_size *= 2;
+            }
+            return tile_size;
+        }
+    }
+
+    // Decide whether a product requiring the given number of multiply-adds
+    // should be evaluated using the tiled backend.
+    inline bool use_tiled_gemm(gemm_backend backend, std::size_t work)
+    {
+        switch (backend)
+        {
+        case gemm_backend::tiled:
+            return true;
+
+        case gemm_backend::blaze:
+            return false;
+
+        case gemm_backend::automatic: HPX_FALLTHROUGH;
+        default:
+            break;
+        }
+        return work >= gemm_min_parallel_work() &&
+            hpx::get_num_worker_threads() > 1;
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    // c = a * b, c has to be sized appropriately. The result is split into
+    // tiles, every tile is computed by a separate HPX thread. The tiles are
+    // evaluated by blaze's serial kernels, which avoids blaze spawning its
+    // own threads from within the tasks.
+    template <typename Matrix1, typename Matrix2, typename Result>
+    void tiled_gemm(Matrix1 const& a, Matrix2 const& b, Result& c,
+        std::size_t tile_size = gemm_tile_size())
+    {
+        std::size_t const m = a.rows();
+        std::size_t const n = b.columns();
+        std::size_t const k = a.columns();
+
+        if (m == 0 || n == 0)
+        {
+            return;
+        }
+
+        tile_size = detail::adjust_tile_size(m, n, tile_size);
+
+        std::size_t const column_tiles = detail::num_tiles(n, tile_size);
+        std::size_t const tiles =
+            detail::num_tiles(m, tile_size) * column_tiles;
+
+        hpx::parallel::for_loop(hpx::parallel::execution::par,
+            std::size_t(0), tiles,
+            [&](std::size_t t)
+            {
+                std::size_t const i = (t / column_tiles) * tile_size;
+                std::size_t const j = (t % column_tiles) * tile_size;
+                std::size_t const rows = (std::min)(tile_size, m - i);
+                std::size_t const columns = (std::min)(tile_size, n - j);
+
+                blaze::submatrix(c, i, j, rows, columns) = blaze::serial(
+                    blaze::submatrix(a, i, 0, rows, k) *
+                    blaze::submatrix(b, 0, j, k, columns));
+            });
+    }
+
+    // y = a * x, y has to be sized appropriately. The rows of a are split
+    // into blocks, every block is computed by a separate HPX thread.
+    template <typename Matrix, typename Vector, typename Result>
+    void tiled_gemv(Matrix const& a, Vector const& x, Result& y,
+        std::size_t tile_size = gemm_tile_size())
+    {
+        std::size_t const m = a.rows();
+        std::size_t const n = a.columns();
+
+        if (m == 0)
+        {
+            return;
+        }
+
+        tile_size = detail::adjust_tile_size(m, 1, tile_size);
+
+        hpx::parallel::for_loop(hpx::parallel::execution::par,
+            std::size_t(0), detail::num_tiles(m, tile_size),
+            [&](std::size_t t)
+            {
+                std::size_t const i = t * tile_size;
+                std::size_t const rows = (std::min)(tile_size, m - i);
+
+                blaze::subvector(y, i, rows) =
+                    blaze::serial(blaze::submatrix(a, i, 0, rows, n) * x);
+            });
+    }
+}}
+
+#endif
@@ -7,16 +7,19 @@
 #define PHYLANX_UTIL_HASHED_STRING_JAN_05_2019_0555PM
 
 #include <phylanx/config.hpp>
+#include <phylanx/util/interned_string.hpp>
 
 #include <hpx/runtime/serialization/serialization_fwd.hpp>
 #include <hpx/util/jenkins_hash.hpp>
 
 #include <iosfwd>
 #include <string>
-#include <utility>
 
 namespace phylanx { namespace util
 {
+    // The key is stored in the symbol table, copying and comparing hashed
+    // strings does not touch the characters unless the hashes of two
+    // different keys collide.
     struct hashed_string
     {
         using hasher = hpx::util::jenkins_hash;
@@ -26,27 +29,36 @@ namespace phylanx { namespace util
 
         hashed_string(std::string const& key)
           : key_(key)
-          , hash_(hasher{}(key_))
         {
         }
 
-        hashed_string(std::string&& key)
-          : key_(std::move(key))
-          , hash_(hasher{}(key_))
+        hashed_string(char const* key)
+          : key_(key)
         {
         }
 
-        hashed_string(char const* key)
+        hashed_string(interned_string const& key)
           : key_(key)
-          , hash_(hasher{}(key_))
         {
         }
 
+        friend bool operator==(hashed_string const& lhs,
+            hashed_string const& rhs)
+        {
+            return lhs.key_ == rhs.key_;
+        }
+        friend bool operator!=(hashed_string const& lhs,
+            hashed_string const& rhs)
+        {
+            return lhs.key_ != rhs.key_;
+        }
+
         friend bool operator<(hashed_string const& lhs,
             hashed_string const& rhs)
         {
-            return (lhs.hash_ < rhs.hash_) ||
-                (lhs.hash_ == rhs.hash_ && lhs.key_ < rhs.key_);
+            return lhs.key_ != rhs.key_ &&
+                ((lhs.hash() < rhs.hash()) ||
+                    (lhs.hash() == rhs.hash() && lhs.key() < rhs.key()));
         }
 
         PHYLANX_EXPORT friend std::ostream& operator<<(std::ostream& os,
@@ -54,12 +66,17 @@ namespace phylanx { namespace util
 
         std::string const& key() const
         {
-            return key_;
+            return key_.str();
         }
 
         size_type hash() const
         {
-            return hash_;
+            return key_.hash();
+        }
+
+        interned_string const& symbol() const
+        {
+            return key_;
         }
 
     private:
@@ -69,8 +86,7 @@ namespace phylanx { namespace util
         PHYLANX_EXPORT void serialize(hpx::serialization::input_archive& ar,
             unsigned);
 
-        std::string key_;
-        size_type hash_;
+        interned_string key_;
     };
 }}
 
@@ -0,0 +1,138 @@
+//  Copyright (c) 2019 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#if !defined(PHYLANX_UTIL_INTERNED_STRING_HPP)
+#define PHYLANX_UTIL_INTERNED_STRING_HPP
+
+#include <phylanx/config.hpp>
+
+#include <hpx/runtime/serialization/serialization_fwd.hpp>
+#include <hpx/util/jenkins_hash.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <iosfwd>
+#include <string>
+
+namespace phylanx { namespace util
+{
+    namespace detail
+    {
+        // an entry of the symbol table, entries are never removed
+        struct interned_string_entry
+        {
+            std::string const* key;
+            hpx::util::jenkins_hash::size_type hash;
+            std::uint32_t id;
+        };
+
+        // Return the entry for the given string, create it if needed
+        PHYLANX_EXPORT interned_string_entry const* intern(
+            std::string const& key);
+
+        // Return the entry representing the empty string
+        PHYLANX_EXPORT interned_string_entry const* empty_interned_string();
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// A string stored in the (per-locality) symbol table.
+    ///
+    /// Equal strings share a single table entry, which makes copying,
+    /// comparing, and hashing interned strings O(1). The hash is computed
+    /// once when a string is added to the table. Serialization transfers the
+    /// characters, the receiving locality interns them into its own table.
+    ///
+    /// This is the key type of hashed_string, i.e. of the compiler
+    /// environment and of the variable maps used during evaluation. Names
+    /// are kept as plain strings elsewhere (ast::identifier, the instance
+    /// names of the primitives, primitive_name_parts), they are interned
+    /// when used as a key. Constructing an interned_string from a
+    /// std::string looks it up in the table (see
+    /// tests/performance/hashed_string.cpp for the cost of this).
+    class interned_string
+    {
+    public:
+        using size_type = hpx::util::jenkins_hash::size_type;
+
+        interned_string()
+          : entry_(detail::empty_interned_string())
+        {
+        }
+
+        interned_string(std::string const& key)
+          : entry_(detail::intern(key))
+        {
+        }
+
+        interned_string(char const* key)
+          : entry_(detail::intern(std::string(key)))
+        {
+        }
+
+        std::string const& str() const
+        {
+            return *entry_->key;
+        }
+
+        size_type hash() const
+        {
+            return entry_->hash;
+        }
+
+        /// The locality-local id of the string, ids are assigned from a
+        /// counter when the strings are added to the table
+        std::uint32_t id() const
+        {
+            return entry_->id;
+        }
+
+        bool empty() const
+        {
+            return entry_->key->empty();
+        }
+
+        friend bool operator==(
+            interned_string const& lhs, interned_string const& rhs)
+        {
+            return lhs.entry_ == rhs.entry_;
+        }
+        friend bool operator!=(
+            interned_string const& lhs, interned_string const& rhs)
+        {
+            return lhs.entry_ != rhs.entry_;
+        }
+
+        PHYLANX_EXPORT friend std::ostream& operator<<(
+            std::ostream& os, interned_string const& s);
+
+    private:
+        friend class hpx::serialization::access;
+        PHYLANX_EXPORT void serialize(hpx::serialization::output_archive& ar,
+            unsigned);
+        PHYLANX_EXPORT void serialize(hpx::serialization::input_archive& ar,
+            unsigned);
+
+        detail::interned_string_entry const* entry_;
+    };
+
+    /// Return the number of strings stored in the symbol table of this
+    /// locality
+    PHYLANX_EXPORT std::size_t interned_string_count();
+}}
+
+namespace std
+{
+    template <>
+    struct hash<phylanx::util::interned_string>
+    {
+        std::size_t operator()(phylanx::util::interned_string const& s) const
+        {
+            return std::size_t(s.hash());
+        }
+    };
+}
+
+#endif
@@ -0,0 +1,106 @@
+//  Copyright (c) 2019 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#if !defined(PHYLANX_UTIL_PARALLEL_SORT_JUL_05_2019_0210PM)
+#define PHYLANX_UTIL_PARALLEL_SORT_JUL_05_2019_0210PM
+
+#include <phylanx/config.hpp>
+
+#include <hpx/include/parallel_sort.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <iterator>
+#include <numeric>
+#include <utility>
+#include <vector>
+
+namespace phylanx { namespace util
+{
+    // sequences shorter than this are sorted sequentially
+    constexpr std::size_t parallel_sort_threshold = 16384;
+
+    ///////////////////////////////////////////////////////////////////////////
+    // operator< is not a strict weak ordering for floating point values if
+    // NaNs are involved, order those after all other values instead (as
+    // NumPy does).
+    struct less_nan_last
+    {
+        template <typename T>
+        bool operator()(T const& lhs, T const& rhs) const
+        {
+            return lhs < rhs;
+        }
+
+        bool operator()(double lhs, double rhs) const
+        {
+            return !std::isnan(lhs) && (std::isnan(rhs) || lhs < rhs);
+        }
+    };
+
+    ///////////////////////////////////////////////////////////////////////////
+    // Sort the given sequence, use the parallel HPX sort for long sequences.
+    template <typename Iter, typename Compare>
+    void parallel_sort(Iter first, Iter last, Compare&& comp)
+    {
+        if (std::size_t(std::distance(first, last)) < parallel_sort_threshold)
+        {
+            std::sort(first, last, std::forward<Compare>(comp));
+            return;
+        }
+
+        hpx::parallel::sort(hpx::parallel::execution::par, first, last,
+            std::forward<Compare>(comp));
+    }
+
+    template <typename Iter>
+    void parallel_sort(Iter first, Iter last)
+    {
+        parallel_sort(first, last, less_nan_last{});
+    }
+
+    // Sorting booleans does not require any comparisons, simply count the
+    // number of zeros.
+    template <typename Iter>
+    void counting_sort(Iter first, Iter last)
+    {
+        std::size_t zeros = std::count(first, last, 0);
+        std::fill(first, std::next(first, zeros), 0);
+        std::fill(std::next(first, zeros), last, 1);
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    // Return the indices [0, n) ordered such that the referenced elements are
+    // sorted with respect to less(i, j). Indices of equal elements stay in
+    // their original order.
+    template <typename Less>
+    std::vector<std::int64_t> sorted_indices(std::size_t n, Less&& less)
+    {
+        std::vector<std::int64_t> indices(n);
+        std::iota(indices.begin(), indices.end(), std::int64_t(0));
+
+        parallel_sort(indices.begin(), indices.end(),
+            [&](std::int64_t lhs, std::int64_t rhs)
+            {
+                if (less(lhs, rhs))
+                {
+                    return true;
+                }
+                if (less(rhs, lhs))
+                {
+                    return false;
+                }
+                return lhs < rhs;
+            });
+
+        return indices;
+    }
+}}
+
+#endif
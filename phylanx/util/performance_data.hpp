@@ -127,5 +127,56 @@ namespace phylanx { namespace util
     ///
     PHYLANX_EXPORT std::map<std::string, std::vector<std::int64_t>>
     retrieve_counter_data(hpx::id_type const& locality_id = hpx::find_here());
+
+    /// Retrieve the statistics aggregated over all instances of each
+    /// primitive type
+    ///
+    /// \param reset   Reset the statistics after retrieving them
+    /// \param locality_id The locality the statistics are going to be
+    ///                 queried from
+    ///
+    /// \return a std::map containing key/value pairs of primitive types/
+    ///         statistics: the number of live instances, the number of
+    ///         evaluations, the total, minimal, and maximal evaluation time
+    ///         (ns), the size of all produced results (bytes), followed by
+    ///         the histogram of the evaluation times (see
+    ///         execution_tree::primitives::primitive_type_statistics)
+    ///
+    /// \note Statistics are collected only for primitive types for which the
+    ///       measurements were enabled, e.g. by calling enable_measurements()
+    ///       or by querying the /phylanx/primitives/<type>/statistics
+    ///       performance counter.
+    ///
+    /// \exception hpx::exception
+    ///
+    PHYLANX_EXPORT std::map<std::string, std::vector<std::int64_t>>
+    retrieve_primitive_statistics(bool reset = false,
+        hpx::id_type const& locality_id = hpx::find_here());
+
+    /// Retrieve the number of bytes of array data held by each primitive
+    /// instance on this locality
+    ///
+    /// \return a std::map containing key/value pairs of primitive
+    ///         instances (names)/bytes held by the instance (for variables
+    ///         this includes the value the variable is bound to)
+    ///
+    PHYLANX_EXPORT std::map<std::string, std::int64_t> retrieve_memory_usage();
+
+    /// Retrieve the memory statistics of the array data owned by all
+    /// node_data instances on this locality (only the array data allocated
+    /// while the memory accounting is enabled is accounted for, see
+    /// node_data<T>::enable_memory_accounting and phylanx.memory_accounting)
+    ///
+    /// \param reset   Reset the high water marks and the copy counts after
+    ///                 retrieving them
+    ///
+    /// \return a std::map containing key/value pairs of element types
+    ///         ("double", "int64", "uint8")/statistics: the number of bytes
+    ///         currently allocated, the high water mark of the allocated
+    ///         bytes, the number of deep copies, and the number of bytes
+    ///         copied by those
+    ///
+    PHYLANX_EXPORT std::map<std::string, std::vector<std::int64_t>>
+    retrieve_node_data_memory(bool reset = false);
 }}
 #endif
@@ -0,0 +1,143 @@
+//  Copyright (c) 2019 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#if !defined(PHYLANX_UTIL_PHILOX_JUL_08_2019_1040AM)
+#define PHYLANX_UTIL_PHILOX_JUL_08_2019_1040AM
+
+#include <phylanx/config.hpp>
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+
+namespace phylanx { namespace util
+{
+    ///////////////////////////////////////////////////////////////////////////
+    // Counter based random number generator (Philox4x32-10, see Salmon et.al.,
+    // 'Parallel Random Numbers: As Easy as 1, 2, 3', SC'11). The generated
+    // sequence is a pure function of the key and the counter, which allows
+    // to generate independent parts of the sequence concurrently: the
+    // generator for the element block 'n' is philox4x32(key, n).
+    //
+    // The class satisfies the UniformRandomBitGenerator requirements and can
+    // be used with all of the standard distributions.
+    class philox4x32
+    {
+    private:
+        using counter_type = std::array<std::uint32_t, 4>;
+        using key_type = std::array<std::uint32_t, 2>;
+
+        static constexpr std::uint32_t multiplier0 = 0xD2511F53;
+        static constexpr std::uint32_t multiplier1 = 0xCD9E8D57;
+        static constexpr std::uint32_t weyl0 = 0x9E3779B9;
+        static constexpr std::uint32_t weyl1 = 0xBB67AE85;
+
+        static void mulhilo(std::uint32_t a, std::uint32_t b,
+            std::uint32_t& hi, std::uint32_t& lo)
+        {
+            std::uint64_t product = std::uint64_t(a) * std::uint64_t(b);
+            hi = std::uint32_t(product >> 32);
+            lo = std::uint32_t(product);
+        }
+
+        static void round(counter_type& ctr, key_type const& key)
+        {
+            std::uint32_t hi0, lo0, hi1, lo1;
+            mulhilo(multiplier0, ctr[0], hi0, lo0);
+            mulhilo(multiplier1, ctr[2], hi1, lo1);
+            ctr = counter_type{
+                hi1 ^ ctr[1] ^ key[0], lo1, hi0 ^ ctr[3] ^ key[1], lo0};
+        }
+
+        void generate()
+        {
+            counter_type ctr = counter_;
+            key_type key = key_;
+            for (int i = 0; i != 9; ++i)
+            {
+                round(ctr, key);
+                key[0] += weyl0;
+                key[1] += weyl1;
+            }
+            round(ctr, key);
+
+            output_ = ctr;
+            next_ = 0;
+
+            // advance the (128 bit) counter
+            if (++counter_[0] == 0 && ++counter_[1] == 0 &&
+                ++counter_[2] == 0)
+            {
+                ++counter_[3];
+            }
+        }
+
+    public:
+        using result_type = std::uint32_t;
+
+        // The key selects the sequence, the stream selects an independent
+        // subsequence of 2^66 numbers within it.
+        explicit philox4x32(std::uint64_t key = 0, std::uint64_t stream = 0)
+          : counter_{0, 0, std::uint32_t(stream), std::uint32_t(stream >> 32)}
+          , key_{std::uint32_t(key), std::uint32_t(key >> 32)}
+          , output_{}
+          , next_(4)
+        {
+        }
+
+        static constexpr result_type (min)()
+        {
+            return 0;
+        }
+        static constexpr result_type (max)()
+        {
+            return (std::numeric_limits<result_type>::max)();
+        }
+
+        result_type operator()()
+        {
+            if (next_ == 4)
+            {
+                generate();
+            }
+            return output_[next_++];
+        }
+
+        // skip the given number of generated values
+        void discard(std::uint64_t n)
+        {
+            std::uint64_t const available = 4 - next_;
+            if (n < available)
+            {
+                next_ += std::size_t(n);
+                return;
+            }
+            n -= available;
+
+            std::uint64_t const blocks = n / 4;
+            std::uint64_t const low =
+                (std::uint64_t(counter_[1]) << 32) | counter_[0];
+            std::uint64_t const new_low = low + blocks;
+            if (new_low < low && ++counter_[2] == 0)
+            {
+                ++counter_[3];
+            }
+            counter_[0] = std::uint32_t(new_low);
+            counter_[1] = std::uint32_t(new_low >> 32);
+
+            generate();
+            next_ = std::size_t(n % 4);
+        }
+
+    private:
+        counter_type counter_;
+        key_type key_;
+        counter_type output_;
+        std::size_t next_;
+    };
+}}
+
+#endif
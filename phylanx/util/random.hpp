@@ -20,6 +20,11 @@ namespace phylanx { namespace util
 
     PHYLANX_EXPORT extern std::mt19937 rng_;    // The Mersenne twister generator.
 
+    // Return a new key for the counter based generator (util::philox4x32).
+    // Every call returns a different key, the sequence of keys is determined
+    // by the current seed.
+    PHYLANX_EXPORT std::uint64_t next_random_key();
+
     PHYLANX_EXPORT void set_seed(std::uint32_t seed);
 
     PHYLANX_EXPORT std::uint32_t get_seed();
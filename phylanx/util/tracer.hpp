@@ -0,0 +1,94 @@
+//  Copyright (c) 2019 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#if !defined(PHYLANX_UTIL_TRACER_JUL_22_2019_1105AM)
+#define PHYLANX_UTIL_TRACER_JUL_22_2019_1105AM
+
+#include <phylanx/config.hpp>
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <iosfwd>
+#include <string>
+
+namespace phylanx { namespace util
+{
+    ///////////////////////////////////////////////////////////////////////////
+    // The shape and the size of a value seen by a traced evaluation
+    struct trace_shape
+    {
+        std::int32_t num_dimensions = -1;       // -1: not an array
+        std::array<std::uint32_t, PHYLANX_MAX_DIMENSIONS> dimensions = {};
+        std::uint64_t bytes = 0;
+    };
+
+    // A single evaluation of a primitive, all times are in nanoseconds
+    struct trace_event
+    {
+        std::uint32_t name = 0;             // see register_trace_name
+        std::uint32_t thread = 0;           // worker thread starting the eval
+        std::uint64_t begin = 0;
+        std::uint64_t end = 0;
+
+        std::uint32_t num_inputs = 0;
+        std::uint64_t input_bytes = 0;      // summed over all inputs
+        std::array<trace_shape, 2> inputs;  // the first two inputs only
+        trace_shape result;
+    };
+
+    ///////////////////////////////////////////////////////////////////////////
+    namespace detail
+    {
+        PHYLANX_EXPORT extern std::atomic<bool> trace_enabled;
+    }
+
+    // Return whether evaluations are currently being recorded. This is
+    // checked for every evaluation, it has to be as cheap as possible.
+    inline bool tracing_enabled()
+    {
+        return detail::trace_enabled.load(std::memory_order_relaxed);
+    }
+
+    // Start recording evaluations, this discards all previously recorded
+    // events. Every worker thread records into its own ring buffer holding
+    // phylanx.trace.buffer_size events (default: 65536), older events are
+    // overwritten once the buffer is full.
+    PHYLANX_EXPORT void start_trace();
+
+    // Stop recording evaluations, the recorded events are kept
+    PHYLANX_EXPORT void stop_trace();
+
+    // Register the name of a traced primitive instance, the returned id is
+    // stored in the events. The display name is shown as the name of the
+    // event, the instance name is added to its arguments. The id is stored
+    // in the given variable (initialized to -1), the name is registered only
+    // once even if this is called concurrently for the same instance.
+    PHYLANX_EXPORT std::uint32_t register_trace_name(
+        std::atomic<std::int64_t>& id, std::string const& display_name,
+        std::string const& instance_name);
+
+    // Add an event to the ring buffer of the current worker thread
+    PHYLANX_EXPORT void record_trace_event(trace_event const& event);
+
+    // The number of recorded events which were overwritten before they could
+    // be written
+    PHYLANX_EXPORT std::uint64_t dropped_trace_events();
+
+    ///////////////////////////////////////////////////////////////////////////
+    // Write all recorded events in the Chrome trace event format (JSON),
+    // which can be loaded by chrome://tracing and by the Perfetto UI. Return
+    // the number of written events.
+    //
+    // This may be called while events are being recorded, events which are
+    // overwritten while they are written may be inconsistent, though.
+    PHYLANX_EXPORT std::size_t write_trace(std::ostream& os);
+
+    // Write all recorded events to the given file (see write_trace)
+    PHYLANX_EXPORT std::size_t dump_trace(std::string const& filename);
+}}
+
+#endif
@@ -0,0 +1,71 @@
+//  Copyright (c) 2019 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#if !defined(PHYLANX_UTIL_VECTOR_MATH_JUL_19_2019_0930AM)
+#define PHYLANX_UTIL_VECTOR_MATH_JUL_19_2019_0930AM
+
+#include <phylanx/config.hpp>
+
+#include <cstddef>
+#include <string>
+
+namespace phylanx { namespace util
+{
+    ///////////////////////////////////////////////////////////////////////////
+    // The elementwise functions which have vectorized implementations
+    enum class math_function
+    {
+        exp,
+        log,
+        tanh,
+        erf,
+        erfc,
+        cbrt,
+        asinh
+    };
+
+    // Convert the given (PhySL) function name into a math_function, return
+    // false if there is no vectorized implementation for the function.
+    PHYLANX_EXPORT bool parse_math_function(
+        std::string const& name, math_function& f);
+
+    ///////////////////////////////////////////////////////////////////////////
+    // The implementation used to evaluate the elementwise functions
+    enum class math_accuracy
+    {
+        accurate,       // the functions of the standard library
+        fast            // vectorized kernels, accurate to a few ulp
+    };
+
+    // Convert the given name into a math_accuracy, return false if the name
+    // is not known.
+    PHYLANX_EXPORT bool parse_math_accuracy(
+        std::string const& name, math_accuracy& accuracy);
+
+    // The implementation selected by the configuration entry
+    // phylanx.math.accuracy (default: 'accurate').
+    PHYLANX_EXPORT math_accuracy default_math_accuracy();
+
+    // The number of elements above which the functions are evaluated by
+    // several HPX threads (phylanx.math.min_parallel_size, default: 2^16).
+    PHYLANX_EXPORT std::size_t math_min_parallel_size();
+
+    ///////////////////////////////////////////////////////////////////////////
+    // out(i, j) = f(in(i, j)) for an array of the given number of rows and
+    // columns. The rows are stored consecutively, the first elements of
+    // neighboring rows are in_spacing (out_spacing) elements apart. The
+    // input and the output may refer to the same memory.
+    //
+    // The fast kernels are compiled for several instruction sets (AVX-512,
+    // AVX2, and the baseline), the best one supported by the CPU is selected
+    // at runtime. Their maximal errors are 1 ulp for exp and log, 2 ulp for
+    // tanh and asinh, 3 ulp for erf and cbrt, and 6 ulp for erfc.
+    PHYLANX_EXPORT void apply_math_function(math_function f,
+        double const* in, std::size_t in_spacing, double* out,
+        std::size_t out_spacing, std::size_t rows, std::size_t columns,
+        math_accuracy accuracy = default_math_accuracy());
+}}
+
+#endif
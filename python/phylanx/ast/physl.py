@@ -11,6 +11,7 @@ import inspect
 import numpy as np
 import phylanx.execution_tree
 from phylanx import compiler_state, PhylanxSession
+from .physl_cache import physl_cache
 
 
 mapped_methods = {
@@ -356,34 +357,65 @@ class PhySL:
             self.file_name = "<none>"
 
         self.performance = self.kwargs.get('performance', False)
+        self.specialize = self.kwargs.get('specialize', False)
         self.localities = self.kwargs.get('localities')
         self.__perfdata__ = (None, None, None)
 
-        # Add arguments of the function to the list of discovered variables.
-        if inspect.isfunction(tree.body[0]):
-            for arg in tree.body[0].args.args:
-                self.defined.add(arg.arg)
-        else:
+        # Reuse previously generated PhySL if the function has not changed.
+        self.cache_key = self.kwargs.get('cache_key')
+        cached_src = None
+        if self.cache_key is not None:
+            cached_src = physl_cache.get(self.cache_key)
+
+        if cached_src is not None:
+            self.ir = None
+            self.__src__ = cached_src
+
+            # the generated code does not refer to classes defined before
             PhySL.defined_classes = {}
+        else:
+            # Add arguments of the function to the list of discovered
+            # variables.
+            if inspect.isfunction(tree.body[0]):
+                for arg in tree.body[0].args.args:
+                    self.defined.add(arg.arg)
+            else:
+                PhySL.defined_classes = {}
+
+            self.ir = self.apply_rule(tree.body[0])
+            check_return(self.ir)
+            self.__src__ = self.generate_physl(self.ir)
 
-        self.ir = self.apply_rule(tree.body[0])
-        check_return(self.ir)
-        self.__src__ = self.generate_physl(self.ir)
+            if self.cache_key is not None:
+                physl_cache.store(self.cache_key, self.__src__, self.kwargs)
 
         if self.kwargs.get("debug"):
             print_physl_src(self.__src__)
             print(end="", flush="")
 
         if PhylanxSession.is_initialized:
-            if "compiler_state" in self.kwargs:
-                PhySL.compiler_state = self.kwargs['compiler_state']
-            # the static method compiler_state is constructed only once
-            elif PhySL.compiler_state is None:
-                PhySL.compiler_state = compiler_state()
+            self.compile()
+
+    def compile(self):
+        """compile the generated PhySL into the current compiler state,
+           unless the very same code was compiled into it before"""
 
+        if "compiler_state" in self.kwargs:
+            PhySL.compiler_state = self.kwargs['compiler_state']
+        # the static method compiler_state is constructed only once
+        elif PhySL.compiler_state is None:
+            PhySL.compiler_state = compiler_state()
+
+        func_name = self.wrapped_function.__name__
+        if self.cache_key is None or not physl_cache.is_compiled(
+                self.cache_key, func_name, PhySL.compiler_state):
             phylanx.execution_tree.compile(
                 self.file_name, self.__src__, PhySL.compiler_state)
-            self.is_compiled = True
+            if self.cache_key is not None:
+                physl_cache.mark_compiled(
+                    self.cache_key, func_name, PhySL.compiler_state)
+
+        self.is_compiled = True
 
     def generate_physl(self, ir):
         if len(ir) == 2 and isinstance(ir[0], str) and isinstance(
@@ -445,9 +477,14 @@ class PhySL:
                         PhySL.compiler_state, True)
 
             func_name = self.outer.wrapped_function.__name__
-            result = phylanx.execution_tree.eval(
-                self.outer.file_name, func_name, PhySL.compiler_state,
-                *self.args)
+            if self.outer.specialize:
+                result = phylanx.execution_tree.eval_specialized(
+                    self.outer.file_name, func_name, self.outer.__src__,
+                    PhySL.compiler_state, *self.args)
+            else:
+                result = phylanx.execution_tree.eval(
+                    self.outer.file_name, func_name, PhySL.compiler_state,
+                    *self.args)
 
             if self.outer.performance:
                 treedata = phylanx.execution_tree.retrieve_tree_topology(
@@ -468,14 +505,7 @@ class PhySL:
             PhylanxSession.init(1)
 
         if not self.is_compiled:
-            if "compiler_state" in self.kwargs:
-                PhySL.compiler_state = self.kwargs['compiler_state']
-            elif PhySL.compiler_state is None:
-                PhySL.compiler_state = compiler_state()
-
-            phylanx.execution_tree.compile(
-                self.file_name, self.__src__, PhySL.compiler_state)
-            self.is_compiled = True
+            self.compile()
 
         return self.eval_wrapper(self, args)
 
@@ -810,7 +840,7 @@ class PhySL:
             'list': 'for_each',
             'slice': 'for_each',
             'range': 'for_each',
-            'prange': 'parallel_map'
+            'prange': 'parallel_for_each'
         }
 
         target = self.apply_rule(node.target)
@@ -824,12 +854,23 @@ class PhySL:
         symbol_name = mapping_function[iteration_space[0].split('$', 1)[0]]
         symbol = get_symbol_info(node, symbol_name)
 
+        # the keyword arguments of `prange` (schedule, chunk_size) are passed
+        # on to `parallel_for_each`.
+        chunking = ()
+        if symbol_name == 'parallel_for_each':
+            args = iteration_space[1]
+            is_kwarg = [isinstance(arg, list) and isinstance(arg[0], str) and
+                        arg[0].startswith('__arg') for arg in args]
+            chunking = tuple(a for a, kw in zip(args, is_kwarg) if kw)
+            iteration_space[1] = tuple(
+                a for a, kw in zip(args, is_kwarg) if not kw)
+
         # replace keyword `prange` to `range` for compatibility with Phylanx.
         iteration_space[0] = iteration_space[0].replace('prange', 'range')
         body = self.block(node.body)
         # orelse = self.block(node.orelse)
         op = get_symbol_info(node, 'lambda')
-        return [symbol, ([op, (target, body)], iteration_space)]
+        return [symbol, ([op, (target, body)], iteration_space) + chunking]
         # return [symbol, (target, iteration_space, body, orelse)]
 
     def _FunctionDef(self, node):
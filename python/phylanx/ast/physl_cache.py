@@ -0,0 +1,182 @@
+# Copyright (c) 2019 Hartmut Kaiser
+#
+# Distributed under the Boost Software License, Version 1.0. (See accompanying
+# file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+"""Content-addressed cache of PhySL code generated by the `@Phylanx` decorator.
+
+Generated PhySL is keyed by a hash of the decorated function's source, its
+location (line numbers are embedded into the generated code), the decorator
+options and globals affecting code generation and the Phylanx version. Entries are kept in
+memory for the lifetime of the process and, if a cache directory is
+configured, on disk as well. The cache additionally remembers which entries
+have already been compiled into a given compiler state so that re-decorating
+an unchanged function does not recompile it.
+
+The on-disk cache is enabled by either passing `cache_dir=<path>` to the
+decorator or by setting the environment variable `PHYLANX_CACHE_DIR`.
+"""
+
+import os
+import hashlib
+import tempfile
+
+# decorator options which influence the generated PhySL code
+_code_generation_kwargs = ['target', 'debug']
+
+
+def phylanx_version():
+    """Returns the version string of the loaded Phylanx extension module."""
+
+    # __version__ is defined by the extension module only, the star-import
+    # in the phylanx package skips names starting with an underscore
+    try:
+        from phylanx import _phylanx as module
+    except ImportError:
+        try:
+            from phylanx import _phylanxd as module
+        except ImportError:
+            return '<unknown>'
+    return getattr(module, '__version__', '<unknown>')
+
+
+def codegen_globals(fglobals):
+    """Returns the values of the globals of the decorated function which
+       influence the generated PhySL code (see PhySL._With)."""
+
+    if not fglobals:
+        return ''
+
+    result = []
+    for name in sorted(fglobals.keys()):
+        value = fglobals[name]
+        if name == 'parallel':
+            parallel = value
+        else:
+            parallel = getattr(value, 'parallel', None)
+        is_parallel_block = getattr(parallel, 'is_parallel_block', None)
+        if callable(is_parallel_block):
+            try:
+                result.append('%s=%s' % (name, is_parallel_block()))
+            except Exception:
+                pass
+    return ','.join(result)
+
+
+def cache_key(python_src, file_name, lineno, kwargs):
+    """Computes the content-addressed key for the given function source."""
+
+    h = hashlib.sha256()
+    h.update(phylanx_version().encode('utf-8'))
+    h.update(b'\0')
+    h.update(str(file_name).encode('utf-8'))
+    h.update(b'\0')
+    h.update(str(lineno).encode('utf-8'))
+    h.update(b'\0')
+    for key in _code_generation_kwargs:
+        h.update(('%s=%s' % (key, kwargs.get(key))).encode('utf-8'))
+        h.update(b'\0')
+    h.update(codegen_globals(kwargs.get('fglobals')).encode('utf-8'))
+    h.update(b'\0')
+    h.update(python_src.encode('utf-8'))
+    return h.hexdigest()
+
+
+class PhySLCache:
+    """Two-level (memory and optional disk) cache of generated PhySL."""
+
+    def __init__(self):
+        self.entries = {}
+        self.compiled = {}
+        self.hits = 0
+        self.misses = 0
+
+    def cache_dir(self, kwargs):
+        """Returns the on-disk cache directory or None if disabled."""
+
+        cache_dir = kwargs.get('cache_dir')
+        if cache_dir is None:
+            cache_dir = os.environ.get('PHYLANX_CACHE_DIR')
+        return cache_dir
+
+    def lookup(self, key, kwargs):
+        """Returns the cached PhySL source for key, or None."""
+
+        src = self.entries.get(key)
+        if src is None:
+            src = self._load(key, self.cache_dir(kwargs))
+            if src is not None:
+                self.entries[key] = src
+
+        if src is None:
+            self.misses += 1
+        else:
+            self.hits += 1
+        return src
+
+    def get(self, key):
+        """Returns the in-memory entry for key without touching the disk or
+           the hit/miss statistics."""
+
+        return self.entries.get(key)
+
+    def store(self, key, src, kwargs):
+        """Stores the generated PhySL source for key."""
+
+        self.entries[key] = src
+        self._save(key, src, self.cache_dir(kwargs))
+
+    def is_compiled(self, key, name, state):
+        """Returns whether key is the code most recently compiled for the
+           function name into the given state."""
+
+        entry = self.compiled.get(id(state))
+        return entry is not None and entry[0] is state and \
+            entry[1].get(name) == key
+
+    def mark_compiled(self, key, name, state):
+        """Records that key has been compiled for name into the given state."""
+
+        entry = self.compiled.get(id(state))
+        if entry is None or entry[0] is not state:
+            # hold on to the state to prevent its id from being reused
+            entry = (state, {})
+            self.compiled[id(state)] = entry
+        entry[1][name] = key
+
+    def clear(self):
+        """Drops all in-memory entries, the on-disk cache is left intact."""
+
+        self.entries.clear()
+        self.compiled.clear()
+        self.hits = 0
+        self.misses = 0
+
+    def _load(self, key, cache_dir):
+        if not cache_dir:
+            return None
+
+        try:
+            with open(os.path.join(cache_dir, key + '.physl'), 'r') as f:
+                return f.read()
+        except (IOError, OSError):
+            return None
+
+    def _save(self, key, src, cache_dir):
+        if not cache_dir:
+            return
+
+        # write to a temporary file first to keep concurrently running
+        # processes from seeing partially written entries
+        try:
+            os.makedirs(cache_dir, exist_ok=True)
+            fd, tmp_name = tempfile.mkstemp(dir=cache_dir, suffix='.tmp')
+            with os.fdopen(fd, 'w') as f:
+                f.write(src)
+            os.replace(tmp_name, os.path.join(cache_dir, key + '.physl'))
+        except (IOError, OSError):
+            pass
+
+
+# the process-wide cache instance used by the decorator
+physl_cache = PhySLCache()
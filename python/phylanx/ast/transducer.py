@@ -11,6 +11,7 @@ import inspect
 import phylanx
 from .physl import PhySL
 from .openscop import OpenSCoP
+from .physl_cache import physl_cache, cache_key
 from phylanx import execution_tree
 from phylanx.ast import generate_ast as generate_phylanx_ast
 from phylanx.exceptions import InvalidDecoratorArgumentError
@@ -27,7 +28,10 @@ def Phylanx(__phylanx_arg=None, **kwargs):
                 'target',
                 'compiler_state',
                 'performance',
-                'localities'
+                'localities',
+                'cache',
+                'cache_dir',
+                'specialize'
             ]
 
             self.backends_map = {'PhySL': PhySL, 'OpenSCoP': OpenSCoP}
@@ -43,7 +47,20 @@ def Phylanx(__phylanx_arg=None, **kwargs):
                 kwargs['fglobals'] = f.__globals__
 
             python_src = self.get_python_src(f)
-            python_ast = self.get_python_ast(python_src, f)
+
+            # Generated PhySL is cached based on the function's source, the
+            # Python AST has to be built only if there is no cache entry.
+            python_ast = None
+            kwargs.pop('cache_key', None)
+            if self.backend == 'PhySL' and kwargs.get('cache', True):
+                actual_lineno = inspect.getsourcelines(f)[-1]
+                kwargs['cache_key'] = cache_key(
+                    python_src, inspect.getsourcefile(f), actual_lineno,
+                    kwargs)
+
+            if kwargs.get('cache_key') is None or physl_cache.lookup(
+                    kwargs['cache_key'], kwargs) is None:
+                python_ast = self.get_python_ast(python_src, f)
 
             self.backend = self.backends_map[self.backend](f, python_ast, kwargs)
             self.__src__ = self.backend.__src__
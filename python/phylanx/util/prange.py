@@ -8,15 +8,24 @@ allows users to explicitly define a parallel range to process
 over - might be a nice place to add in hpx-smart-executor logic
 
 https://github.com/numba/numba/blob/master/numba/special.py
+
+Inside of @Phylanx functions a loop over a prange is executed by
+parallel_for_each. The optional keyword arguments select how the iterations
+are split into chunks:
+
+    schedule: one of 'auto' (default), 'static', 'dynamic', or 'guided'
+    chunk_size: the (minimal) number of iterations per chunk
 '''
 
 
 class prange(object):
-    def __init__(self, *args):
+    def __init__(self, *args, schedule=None, chunk_size=None):
         # remember range(0, n) iteration space
         # remember range(0, n, k) iteration broken into chunks
         #
         self.iterspace = range(*args)
+        self.schedule = schedule
+        self.chunk_size = chunk_size
 
     def __iter__(self):
         for i in self.iterspace:
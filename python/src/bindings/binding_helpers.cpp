@@ -111,6 +111,53 @@ namespace phylanx { namespace bindings
             });
     }
 
+    phylanx::execution_tree::primitive_argument_type specialized_evaluator(
+        std::string const& file_name, std::string const& func_name,
+        std::string const& xexpr_str, compiler_state& c, pybind11::args args)
+    {
+        pybind11::gil_scoped_release release;       // release GIL
+
+        return hpx::threads::run_as_hpx_thread(
+            [&]() -> phylanx::execution_tree::primitive_argument_type
+            {
+                // Make sure None is printed as "None"
+                phylanx::util::none_wrapper wrap_cout(hpx::cout);
+                phylanx::util::none_wrapper wrap_debug(hpx::consolestream);
+
+                // (re-)create the specializations if the function was not
+                // seen before or if its source code has changed
+                auto& entry = c.specializations[func_name];
+                if (!entry.second || entry.first != xexpr_str)
+                {
+                    entry.first = xexpr_str;
+                    entry.second = phylanx::execution_tree::compile_specialized(
+                        file_name, xexpr_str, func_name, c.eval_snippets,
+                        c.eval_env, c.eval_ctx);
+                }
+
+                phylanx::execution_tree::primitive_arguments_type keep_alive;
+                keep_alive.reserve(args.size());
+                phylanx::execution_tree::primitive_arguments_type fargs;
+                fargs.reserve(args.size());
+
+                {
+                    pybind11::gil_scoped_acquire acquire;
+                    for (auto const& item : args)
+                    {
+                        using phylanx::execution_tree::primitive_argument_type;
+
+                        primitive_argument_type value =
+                            item.cast<primitive_argument_type>();
+
+                        keep_alive.emplace_back(std::move(value));
+                        fargs.emplace_back(extract_ref_value(keep_alive.back()));
+                    }
+                }
+
+                return (*entry.second)(std::move(fargs), c.eval_ctx);
+            });
+    }
+
     ///////////////////////////////////////////////////////////////////////////
     // initialize measurements for tree evaluations
     std::vector<std::string> enable_measurements(compiler_state& c,
@@ -18,6 +18,8 @@
 #include <cstdint>
 #include <exception>
 #include <list>
+#include <map>
+#include <memory>
 #include <sstream>
 #include <string>
 #include <utility>
@@ -46,6 +48,14 @@ namespace phylanx { namespace bindings
         bool enable_measurements;
         std::vector<std::string> primitive_instances;
 
+        // functions specialized on their argument signatures, the source
+        // code is kept to detect redefinitions
+        std::map<std::string,
+            std::pair<std::string,
+                std::shared_ptr<
+                    phylanx::execution_tree::compiler::specialized_function>>>
+            specializations;
+
         static pybind11::object import_phylanx()
         {
 #if defined(_DEBUG)
@@ -187,6 +197,12 @@ namespace phylanx { namespace bindings
         std::string const& file_name, std::string const& xexpr_str,
         compiler_state& c, pybind11::args args);
 
+    // evaluate compiled function using a variant specialized on the argument
+    // signature
+    phylanx::execution_tree::primitive_argument_type specialized_evaluator(
+        std::string const& file_name, std::string const& func_name,
+        std::string const& xexpr_str, compiler_state& c, pybind11::args args);
+
     ///////////////////////////////////////////////////////////////////////////
     // initialize measurements for tree evaluations
     std::vector<std::string> enable_measurements(
@@ -140,6 +140,11 @@ void phylanx::bindings::bind_execution_tree(pybind11::module m)
         },
         "compile and evaluate a numerical expression in PhySL");
 
+    execution_tree.def("eval_specialized",
+        phylanx::bindings::specialized_evaluator,
+        "evaluate a compiled function using a variant specialized on the "
+        "dtypes and shapes of the given arguments");
+
     // expose functionalities needed for accessing performance data
     execution_tree.def("enable_measurements",
         phylanx::bindings::enable_measurements,
@@ -16,6 +16,7 @@
 
 #include <hpx/include/iostreams.hpp>
 
+#include <cstddef>
 #include <cstdint>
 #include <vector>
 #include <map>
@@ -111,4 +112,95 @@ void phylanx::bindings::bind_util(pybind11::module m)
             return strm.str();
         },
         "return all the output generated through the debug() primitive");
+
+    util.def(
+        "start_trace",
+        []() {
+            pybind11::gil_scoped_release release;    // release GIL
+            phylanx::util::start_trace();
+        },
+        "start recording the evaluations of all primitives");
+    util.def(
+        "stop_trace",
+        []() {
+            pybind11::gil_scoped_release release;    // release GIL
+            phylanx::util::stop_trace();
+        },
+        "stop recording the evaluations of primitives");
+    util.def(
+        "dump_trace",
+        [](std::string const& filename) -> std::size_t {
+            pybind11::gil_scoped_release release;    // release GIL
+            return phylanx::util::dump_trace(filename);
+        },
+        "write the recorded evaluations to the given file (Chrome trace "
+        "event format, can be loaded by the Perfetto UI)");
+    util.def(
+        "trace_data",
+        []() -> std::string {
+            pybind11::gil_scoped_release release;    // release GIL
+            std::ostringstream strm;
+            phylanx::util::write_trace(strm);
+            return strm.str();
+        },
+        "return the recorded evaluations as a JSON string (Chrome trace "
+        "event format)");
+
+    util.def(
+        "primitive_statistics",
+        [](bool reset) -> std::map<std::string, std::vector<std::int64_t>> {
+            pybind11::gil_scoped_release release;    // release GIL
+            return hpx::threads::run_as_hpx_thread([&]() {
+                return phylanx::util::retrieve_primitive_statistics(reset);
+            });
+        },
+        pybind11::arg("reset") = false,
+        "return the evaluation statistics aggregated for each primitive type "
+        "(instances, count, total/min/max time in ns, result bytes, "
+        "followed by a histogram of the evaluation times)");
+
+    util.def(
+        "memory_report",
+        [](bool reset) -> pybind11::dict {
+            std::map<std::string, std::vector<std::int64_t>> types;
+            std::map<std::string, std::int64_t> instances;
+            {
+                pybind11::gil_scoped_release release;    // release GIL
+                hpx::threads::run_as_hpx_thread([&]() {
+                    types = phylanx::util::retrieve_node_data_memory(reset);
+                    instances = phylanx::util::retrieve_memory_usage();
+                });
+            }
+
+            pybind11::dict primitives;
+            pybind11::dict variables;
+            for (auto const& instance : instances)
+            {
+                phylanx::execution_tree::compiler::primitive_name_parts parts;
+                if (phylanx::execution_tree::compiler::parse_primitive_name(
+                        instance.first, parts) &&
+                    parts.primitive == "variable")
+                {
+                    variables[pybind11::str(instance.first)] = instance.second;
+                }
+                else if (instance.second != 0)
+                {
+                    primitives[pybind11::str(instance.first)] =
+                        instance.second;
+                }
+            }
+
+            pybind11::dict result;
+            result["types"] = types;
+            result["primitives"] = primitives;
+            result["variables"] = variables;
+            return result;
+        },
+        pybind11::arg("reset") = false,
+        "return the memory held by array data on this locality: for each "
+        "element type the allocated bytes, the high water mark, the number "
+        "of deep copies and the copied bytes ('types', requires "
+        "phylanx.memory_accounting=1), and the bytes held by each primitive "
+        "instance holding any ('primitives') and by each variable "
+        "('variables')");
 }
@@ -0,0 +1,981 @@
+//  Copyright (c) 2019 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <phylanx/config.hpp>
+#include <phylanx/ast/flat_ast.hpp>
+#include <phylanx/ast/node.hpp>
+#include <phylanx/ir/node_data.hpp>
+#include <phylanx/util/variant.hpp>
+
+#include <hpx/throw_exception.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <memory>
+#include <string>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include <blaze/Math.h>
+#if defined(PHYLANX_HAVE_BLAZE_TENSOR)
+#include <blaze_tensor/Math.h>
+#endif
+
+#if !defined(_WIN32)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace phylanx { namespace ast
+{
+    namespace
+    {
+        ///////////////////////////////////////////////////////////////////////
+        constexpr char flat_ast_magic[8] = {
+            'P', 'H', 'Y', 'S', 'L', 'A', 'S', 'T'};
+        constexpr std::uint32_t flat_ast_version = 1;
+        constexpr std::uint32_t flat_ast_byte_order = 0x01020304;
+
+        static_assert(sizeof(flat_ast::node) == 28,
+            "flat_ast::node must not contain any padding");
+        static_assert(sizeof(flat_ast::header) % 8 == 0,
+            "flat_ast::header must preserve the alignment of the sections");
+
+        inline std::uint64_t align8(std::uint64_t offset)
+        {
+            return (offset + 7) & ~std::uint64_t(7);
+        }
+
+        // offsets of the sections of the encoded data
+        struct section_offsets
+        {
+            explicit section_offsets(flat_ast::header const& h)
+            {
+                words = sizeof(flat_ast::header);
+                nodes = words + std::uint64_t(h.data_count) * 8;
+                children = align8(nodes +
+                    std::uint64_t(h.node_count) * sizeof(flat_ast::node));
+                string_offsets = align8(
+                    children + std::uint64_t(h.child_count) * 4);
+                strings = align8(
+                    string_offsets + (std::uint64_t(h.string_count) + 1) * 4);
+                end = strings + h.string_bytes;
+            }
+
+            std::uint64_t words;
+            std::uint64_t nodes;
+            std::uint64_t children;
+            std::uint64_t string_offsets;
+            std::uint64_t strings;
+            std::uint64_t end;
+        };
+
+        ///////////////////////////////////////////////////////////////////////
+        // Encode a list of ASTs. Children are encoded before their parents,
+        // which makes every child index smaller than the index of its parent.
+        class flat_ast_builder
+        {
+            using node = flat_ast::node;
+            using node_kind = flat_ast::node_kind;
+
+        public:
+            std::vector<char> encode(std::vector<ast::expression> const& exprs)
+            {
+                std::vector<std::uint32_t> roots;
+                roots.reserve(exprs.size());
+                for (auto const& expr : exprs)
+                {
+                    roots.push_back(add(expr));
+                }
+                std::uint32_t const root_first = add_children(roots);
+
+                flat_ast::header h{};
+                std::copy(std::begin(flat_ast_magic), std::end(flat_ast_magic),
+                    std::begin(h.magic));
+                h.version = flat_ast_version;
+                h.byte_order = flat_ast_byte_order;
+                h.data_count = std::uint32_t(words_.size());
+                h.node_count = std::uint32_t(nodes_.size());
+                h.child_count = std::uint32_t(children_.size());
+                h.string_count = std::uint32_t(string_offsets_.size() - 1);
+                h.string_bytes = std::uint32_t(strings_.size());
+                h.root_first = root_first;
+                h.root_count = std::uint32_t(roots.size());
+
+                section_offsets const offsets(h);
+
+                std::vector<char> buffer(offsets.end, '\0');
+                std::memcpy(buffer.data(), &h, sizeof(h));
+                copy_section(buffer, offsets.words, words_);
+                copy_section(buffer, offsets.nodes, nodes_);
+                copy_section(buffer, offsets.children, children_);
+                copy_section(buffer, offsets.string_offsets, string_offsets_);
+                std::copy(strings_.begin(), strings_.end(),
+                    buffer.begin() + offsets.strings);
+
+                return buffer;
+            }
+
+        private:
+            template <typename T>
+            static void copy_section(std::vector<char>& buffer,
+                std::uint64_t offset, std::vector<T> const& section)
+            {
+                if (!section.empty())
+                {
+                    std::memcpy(buffer.data() + offset, section.data(),
+                        section.size() * sizeof(T));
+                }
+            }
+
+            ///////////////////////////////////////////////////////////////////
+            std::uint32_t intern(std::string const& str)
+            {
+                auto it = string_ids_.find(str);
+                if (it != string_ids_.end())
+                {
+                    return it->second;
+                }
+
+                std::uint32_t const id =
+                    std::uint32_t(string_offsets_.size() - 1);
+                strings_ += str;
+                string_offsets_.push_back(std::uint32_t(strings_.size()));
+                string_ids_.emplace(str, id);
+                return id;
+            }
+
+            std::uint32_t add_children(std::vector<std::uint32_t> const& kids)
+            {
+                std::uint32_t const first = std::uint32_t(children_.size());
+                children_.insert(children_.end(), kids.begin(), kids.end());
+                return first;
+            }
+
+            static node make_node(node_kind kind, tagged const& t)
+            {
+                node n{};
+                n.kind = kind;
+                if (t.col == -1)
+                {
+                    n.line = -1;
+                    n.column = -1;
+                }
+                else
+                {
+                    n.line = std::int32_t(t.id);
+                    n.column = std::int32_t(t.col);
+                }
+                return n;
+            }
+
+            std::uint32_t add_node(
+                node n, std::vector<std::uint32_t> const& kids = {})
+            {
+                n.first_child = add_children(kids);
+                n.child_count = std::uint32_t(kids.size());
+                nodes_.push_back(n);
+                return std::uint32_t(nodes_.size() - 1);
+            }
+
+            ///////////////////////////////////////////////////////////////////
+            std::uint32_t add(ast::expression const& expr)
+            {
+                std::vector<std::uint32_t> kids;
+                kids.reserve(expr.rest.size() + 1);
+
+                kids.push_back(add(expr.first));
+                for (auto const& op : expr.rest)
+                {
+                    node n = make_node(node_kind::operation, tagged(-1, -1));
+                    n.op = std::uint8_t(op.operator_);
+                    kids.push_back(add_node(n, {add(op.operand_)}));
+                }
+
+                return add_node(
+                    make_node(node_kind::expression, tagged(-1, -1)), kids);
+            }
+
+            std::uint32_t add(ast::operand const& op)
+            {
+                switch (op.index())
+                {
+                case 1:     // phylanx::util::recursive_wrapper<primary_expr>
+                    return add(util::get<1>(op.get()).get());
+
+                case 2:     // phylanx::util::recursive_wrapper<unary_expr>
+                    {
+                        auto const& ue = util::get<2>(op.get()).get();
+                        node n = make_node(node_kind::unary_expr, ue);
+                        n.op = std::uint8_t(ue.operator_);
+                        return add_node(n, {add(ue.operand_)});
+                    }
+
+                default:
+                    break;
+                }
+                return add_node(make_node(node_kind::nil, tagged(-1, -1)));
+            }
+
+            std::uint32_t add(ast::primary_expr const& pe)
+            {
+                switch (pe.index())
+                {
+                case 1:     // bool
+                    {
+                        node n = make_node(node_kind::boolean, pe);
+                        n.value = util::get<1>(pe.get()) ? 1 : 0;
+                        return add_node(n);
+                    }
+
+                case 2:     // phylanx::ir::node_data<double>
+                    return add_data(node_kind::double_data,
+                        util::get<2>(pe.get()), pe);
+
+                case 3:     // identifier
+                    {
+                        auto const& id = util::get<3>(pe.get());
+                        node n = make_node(node_kind::identifier, id);
+                        n.value = intern(id.name);
+                        return add_node(n);
+                    }
+
+                case 4:     // std::string
+                    {
+                        node n = make_node(node_kind::string, pe);
+                        n.value = intern(util::get<4>(pe.get()));
+                        return add_node(n);
+                    }
+
+                case 5:     // phylanx::ir::node_data<std::int64_t>
+                    return add_data(node_kind::int64_data,
+                        util::get<5>(pe.get()), pe);
+
+                case 6:     // phylanx::util::recursive_wrapper<expression>
+                    return add_node(make_node(node_kind::parenthesized, pe),
+                        {add(util::get<6>(pe.get()).get())});
+
+                case 7:     // phylanx::util::recursive_wrapper<function_call>
+                    {
+                        auto const& fc = util::get<7>(pe.get()).get();
+
+                        std::vector<std::uint32_t> kids;
+                        kids.reserve(fc.args.size());
+                        for (auto const& arg : fc.args)
+                        {
+                            kids.push_back(add(arg));
+                        }
+
+                        node n = make_node(
+                            node_kind::function_call, fc.function_name);
+                        n.value = intern(fc.function_name.name);
+                        n.extra = intern(fc.attribute);
+                        return add_node(n, kids);
+                    }
+
+                case 8:     // phylanx::util::recursive_wrapper<std::vector<ast::expression>>
+                    {
+                        auto const& l = util::get<8>(pe.get()).get();
+
+                        std::vector<std::uint32_t> kids;
+                        kids.reserve(l.size());
+                        for (auto const& expr : l)
+                        {
+                            kids.push_back(add(expr));
+                        }
+                        return add_node(make_node(node_kind::list, pe), kids);
+                    }
+
+                case 0: HPX_FALLTHROUGH;    // nil
+                default:
+                    break;
+                }
+                return add_node(make_node(node_kind::nil, pe));
+            }
+
+            ///////////////////////////////////////////////////////////////////
+            // numeric data is stored as its extents followed by the values
+            template <typename T>
+            void add_word(T value)
+            {
+                static_assert(sizeof(T) == sizeof(std::uint64_t),
+                    "the data section holds 8-byte values only");
+
+                std::uint64_t word;
+                std::memcpy(&word, &value, sizeof(word));
+                words_.push_back(word);
+            }
+
+            template <typename T>
+            std::uint32_t add_data(node_kind kind,
+                ir::node_data<T> const& nd, tagged const& t)
+            {
+                node n = make_node(kind, t);
+                n.value = std::uint32_t(words_.size());
+
+                switch (nd.num_dimensions())
+                {
+                case 0:
+                    add_word(nd.scalar());
+                    break;
+
+                case 1:
+                    {
+                        auto v = nd.vector();
+                        add_word(std::uint64_t(v.size()));
+                        for (std::size_t i = 0; i != v.size(); ++i)
+                        {
+                            add_word(T(v[i]));
+                        }
+                    }
+                    break;
+
+                case 2:
+                    {
+                        auto m = nd.matrix();
+                        add_word(std::uint64_t(m.rows()));
+                        add_word(std::uint64_t(m.columns()));
+                        for (std::size_t i = 0; i != m.rows(); ++i)
+                        {
+                            for (std::size_t j = 0; j != m.columns(); ++j)
+                            {
+                                add_word(T(m(i, j)));
+                            }
+                        }
+                    }
+                    break;
+
+#if defined(PHYLANX_HAVE_BLAZE_TENSOR)
+                case 3:
+                    {
+                        auto t = nd.tensor();
+                        add_word(std::uint64_t(t.pages()));
+                        add_word(std::uint64_t(t.rows()));
+                        add_word(std::uint64_t(t.columns()));
+                        for (std::size_t k = 0; k != t.pages(); ++k)
+                        {
+                            for (std::size_t i = 0; i != t.rows(); ++i)
+                            {
+                                for (std::size_t j = 0; j != t.columns(); ++j)
+                                {
+                                    add_word(T(t(k, i, j)));
+                                }
+                            }
+                        }
+                    }
+                    break;
+#endif
+
+                default:
+                    HPX_THROW_EXCEPTION(hpx::bad_parameter,
+                        "phylanx::ast::flat_ast",
+                        "unsupported dimensionality of numeric literal");
+                }
+
+                n.dimensions = std::uint8_t(nd.num_dimensions());
+                return add_node(n);
+            }
+
+            std::vector<std::uint64_t> words_;
+            std::vector<node> nodes_;
+            std::vector<std::uint32_t> children_;
+            std::vector<std::uint32_t> string_offsets_{0};
+            std::string strings_;
+            std::unordered_map<std::string, std::uint32_t> string_ids_;
+        };
+
+        ///////////////////////////////////////////////////////////////////////
+        // verify the structure of the encoded data, this guarantees that all
+        // indices are in range and that the nodes form a tree (every node is
+        // referenced at most once, which bounds the size of the expanded
+        // expressions by the size of the encoded data)
+        class flat_ast_verifier
+        {
+            using node = flat_ast::node;
+            using node_kind = flat_ast::node_kind;
+
+        public:
+            flat_ast_verifier(char const* data, std::size_t size,
+                    char const* source)
+              : data_(data)
+              , size_(size)
+              , source_(source)
+            {
+            }
+
+            void verify() const
+            {
+                if (size_ < sizeof(flat_ast::header) ||
+                    !flat_ast::is_flat_ast(data_, size_))
+                {
+                    error("the data doesn't hold an encoded AST");
+                }
+                if (reinterpret_cast<std::uintptr_t>(data_) % 8 != 0)
+                {
+                    error("the encoded AST is not properly aligned");
+                }
+
+                auto const& h =
+                    *reinterpret_cast<flat_ast::header const*>(data_);
+                if (h.version != flat_ast_version)
+                {
+                    error("unsupported version of the encoded AST");
+                }
+                if (h.byte_order != flat_ast_byte_order)
+                {
+                    error("the encoded AST uses a different byte order");
+                }
+
+                section_offsets const offsets(h);
+                if (offsets.end > size_)
+                {
+                    error("the encoded AST is truncated");
+                }
+
+                auto const* string_offsets =
+                    reinterpret_cast<std::uint32_t const*>(
+                        data_ + offsets.string_offsets);
+                if (string_offsets[0] != 0 ||
+                    string_offsets[h.string_count] != h.string_bytes)
+                {
+                    error("inconsistent string table");
+                }
+                for (std::uint32_t i = 0; i != h.string_count; ++i)
+                {
+                    if (string_offsets[i] > string_offsets[i + 1])
+                    {
+                        error("inconsistent string table");
+                    }
+                }
+
+                auto const* nodes =
+                    reinterpret_cast<node const*>(data_ + offsets.nodes);
+                auto const* children = reinterpret_cast<std::uint32_t const*>(
+                    data_ + offsets.children);
+
+                if (std::uint64_t(h.root_first) + h.root_count > h.child_count)
+                {
+                    error("root index out of range");
+                }
+
+                std::vector<bool> referenced(h.node_count, false);
+                for (std::uint32_t i = 0; i != h.root_count; ++i)
+                {
+                    std::uint32_t const root = children[h.root_first + i];
+                    if (root >= h.node_count ||
+                        nodes[root].kind != node_kind::expression)
+                    {
+                        error("invalid root node");
+                    }
+                    reference(referenced, root);
+                }
+
+                for (std::uint32_t i = 0; i != h.node_count; ++i)
+                {
+                    verify_node(h, nodes, children, i, referenced);
+                }
+            }
+
+        private:
+            void error(char const* msg) const
+            {
+                HPX_THROW_EXCEPTION(hpx::bad_parameter, source_,
+                    std::string("invalid flat AST: ") + msg);
+            }
+
+            // a node shared by several parents would be expanded once for
+            // each of them, possibly exponentially many times
+            void reference(
+                std::vector<bool>& referenced, std::uint32_t index) const
+            {
+                if (referenced[index])
+                {
+                    error("node is referenced more than once");
+                }
+                referenced[index] = true;
+            }
+
+            static bool is_operand(node_kind kind)
+            {
+                return kind != node_kind::expression &&
+                    kind != node_kind::operation;
+            }
+
+            void verify_node(flat_ast::header const& h, node const* nodes,
+                std::uint32_t const* children, std::uint32_t index,
+                std::vector<bool>& referenced) const
+            {
+                node const& n = nodes[index];
+                if (std::uint64_t(n.first_child) + n.child_count >
+                    h.child_count)
+                {
+                    error("child index out of range");
+                }
+
+                // children are always encoded before their parents
+                for (std::uint32_t i = 0; i != n.child_count; ++i)
+                {
+                    std::uint32_t const child = children[n.first_child + i];
+                    if (child >= index)
+                    {
+                        error("invalid child index");
+                    }
+                    reference(referenced, child);
+                }
+
+                auto child_kind = [&](std::uint32_t i) {
+                    return nodes[children[n.first_child + i]].kind;
+                };
+
+                switch (n.kind)
+                {
+                case node_kind::expression:
+                    if (n.child_count == 0 || !is_operand(child_kind(0)))
+                    {
+                        error("invalid expression node");
+                    }
+                    for (std::uint32_t i = 1; i != n.child_count; ++i)
+                    {
+                        if (child_kind(i) != node_kind::operation)
+                        {
+                            error("invalid expression node");
+                        }
+                    }
+                    break;
+
+                case node_kind::operation: HPX_FALLTHROUGH;
+                case node_kind::unary_expr:
+                    if (n.child_count != 1 || !is_operand(child_kind(0)) ||
+                        n.op > std::uint8_t(ast::optoken::op_unknown))
+                    {
+                        error("invalid operation node");
+                    }
+                    break;
+
+                case node_kind::nil: HPX_FALLTHROUGH;
+                case node_kind::boolean:
+                    if (n.child_count != 0)
+                    {
+                        error("invalid literal node");
+                    }
+                    break;
+
+                case node_kind::identifier: HPX_FALLTHROUGH;
+                case node_kind::string:
+                    if (n.child_count != 0 || n.value >= h.string_count)
+                    {
+                        error("invalid string node");
+                    }
+                    break;
+
+                case node_kind::double_data: HPX_FALLTHROUGH;
+                case node_kind::int64_data:
+                    verify_data(h, n);
+                    break;
+
+                case node_kind::parenthesized:
+                    if (n.child_count != 1 ||
+                        child_kind(0) != node_kind::expression)
+                    {
+                        error("invalid parenthesized expression node");
+                    }
+                    break;
+
+                case node_kind::function_call:
+                    if (n.value >= h.string_count ||
+                        n.extra >= h.string_count)
+                    {
+                        error("invalid function call node");
+                    }
+                    HPX_FALLTHROUGH;
+
+                case node_kind::list:
+                    for (std::uint32_t i = 0; i != n.child_count; ++i)
+                    {
+                        if (child_kind(i) != node_kind::expression)
+                        {
+                            error("invalid argument node");
+                        }
+                    }
+                    break;
+
+                default:
+                    error("unknown node kind");
+                }
+            }
+
+            void verify_data(flat_ast::header const& h, node const& n) const
+            {
+                if (n.child_count != 0 ||
+                    n.dimensions > ir::node_data<double>::max_dimensions)
+                {
+                    error("invalid numeric literal node");
+                }
+
+                std::uint64_t const extents = n.value;
+                std::uint64_t const values = extents + n.dimensions;
+                if (values > h.data_count)
+                {
+                    error("numeric literal out of range");
+                }
+
+                auto const* words = reinterpret_cast<std::uint64_t const*>(
+                    data_ + sizeof(flat_ast::header));
+
+                std::uint64_t count = 1;
+                for (std::uint8_t i = 0; i != n.dimensions; ++i)
+                {
+                    std::uint64_t const extent = words[extents + i];
+                    if (extent > h.data_count)
+                    {
+                        error("numeric literal out of range");
+                    }
+                    count *= extent;
+                    if (count > h.data_count)
+                    {
+                        error("numeric literal out of range");
+                    }
+                }
+                if (values + count > h.data_count)
+                {
+                    error("numeric literal out of range");
+                }
+            }
+
+            char const* data_;
+            std::size_t size_;
+            char const* source_;
+        };
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    flat_ast::flat_ast(std::vector<ast::expression> const& exprs)
+    {
+        auto buffer = std::make_shared<std::vector<char>>(
+            flat_ast_builder{}.encode(exprs));
+
+        char const* data = buffer->data();
+        std::size_t const size = buffer->size();
+        attach(std::move(buffer), data, size, "phylanx::ast::flat_ast");
+    }
+
+    flat_ast flat_ast::from_buffer(std::vector<char> buffer)
+    {
+        auto storage = std::make_shared<std::vector<char>>(std::move(buffer));
+
+        flat_ast result;
+        char const* data = storage->data();
+        std::size_t const size = storage->size();
+        result.attach(std::move(storage), data, size,
+            "phylanx::ast::flat_ast::from_buffer");
+        return result;
+    }
+
+    flat_ast flat_ast::load(std::string const& path)
+    {
+#if !defined(_WIN32)
+        int fd = ::open(path.c_str(), O_RDONLY);
+        if (fd == -1)
+        {
+            HPX_THROW_EXCEPTION(hpx::filesystem_error,
+                "phylanx::ast::flat_ast::load",
+                "failed to open the specified file: " + path);
+        }
+
+        struct stat st;
+        if (::fstat(fd, &st) != 0 || st.st_size == 0)
+        {
+            ::close(fd);
+            HPX_THROW_EXCEPTION(hpx::filesystem_error,
+                "phylanx::ast::flat_ast::load",
+                "failed to read the specified file: " + path);
+        }
+
+        std::size_t const size = std::size_t(st.st_size);
+        void* addr = ::mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+        ::close(fd);
+
+        if (addr == MAP_FAILED)
+        {
+            HPX_THROW_EXCEPTION(hpx::filesystem_error,
+                "phylanx::ast::flat_ast::load",
+                "failed to map the specified file: " + path);
+        }
+
+        std::shared_ptr<void const> storage(addr,
+            [size](void const* p) { ::munmap(const_cast<void*>(p), size); });
+
+        flat_ast result;
+        result.attach(std::move(storage), static_cast<char const*>(addr),
+            size, "phylanx::ast::flat_ast::load");
+        return result;
+#else
+        std::ifstream strm(path, std::ios::binary | std::ios::ate);
+        if (!strm.good())
+        {
+            HPX_THROW_EXCEPTION(hpx::filesystem_error,
+                "phylanx::ast::flat_ast::load",
+                "failed to open the specified file: " + path);
+        }
+
+        std::vector<char> buffer(std::size_t(strm.tellg()));
+        strm.seekg(0, std::ios::beg);
+        if (!strm.read(buffer.data(), buffer.size()))
+        {
+            HPX_THROW_EXCEPTION(hpx::filesystem_error,
+                "phylanx::ast::flat_ast::load",
+                "failed to read the specified file: " + path);
+        }
+        return from_buffer(std::move(buffer));
+#endif
+    }
+
+    void flat_ast::save(std::string const& path) const
+    {
+        std::ofstream strm(path, std::ios::binary);
+        if (!strm.good() || !strm.write(data_, size_))
+        {
+            HPX_THROW_EXCEPTION(hpx::filesystem_error,
+                "phylanx::ast::flat_ast::save",
+                "failed to write the specified file: " + path);
+        }
+    }
+
+    bool flat_ast::is_flat_ast(char const* data, std::size_t size)
+    {
+        return size >= sizeof(header) &&
+            std::equal(std::begin(flat_ast_magic), std::end(flat_ast_magic),
+                data);
+    }
+
+    void flat_ast::attach(std::shared_ptr<void const> storage,
+        char const* data, std::size_t size, char const* source)
+    {
+        flat_ast_verifier(data, size, source).verify();
+
+        storage_ = std::move(storage);
+        data_ = data;
+        size_ = size;
+
+        header_ = reinterpret_cast<header const*>(data);
+
+        section_offsets const offsets(*header_);
+        words_ = reinterpret_cast<std::uint64_t const*>(data + offsets.words);
+        nodes_ = reinterpret_cast<node const*>(data + offsets.nodes);
+        children_ =
+            reinterpret_cast<std::uint32_t const*>(data + offsets.children);
+        string_offsets_ = reinterpret_cast<std::uint32_t const*>(
+            data + offsets.string_offsets);
+        strings_ = data + offsets.strings;
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    std::string flat_ast::get_string(std::uint32_t id) const
+    {
+        return std::string(strings_ + string_offsets_[id],
+            strings_ + string_offsets_[id + 1]);
+    }
+
+    bool flat_ast::string_equals(std::uint32_t id, char const* str) const
+    {
+        std::size_t const size =
+            string_offsets_[id + 1] - string_offsets_[id];
+        return std::strlen(str) == size &&
+            std::memcmp(strings_ + string_offsets_[id], str, size) == 0;
+    }
+
+    ast::expression flat_ast::expression(std::size_t root) const
+    {
+        return expand_expression(this->root(root));
+    }
+
+    std::vector<ast::expression> flat_ast::expressions() const
+    {
+        std::vector<ast::expression> result;
+        result.reserve(root_count());
+        for (std::size_t i = 0; i != root_count(); ++i)
+        {
+            result.emplace_back(expression(i));
+        }
+        return result;
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    namespace
+    {
+        template <typename Ast>
+        void set_tag(Ast& ast, flat_ast::node const& n)
+        {
+            if (n.column != -1)
+            {
+                ast.id = n.line;
+                ast.col = n.column;
+            }
+        }
+    }
+
+    ast::expression flat_ast::expand_expression(node const& n) const
+    {
+        ast::expression result(expand_operand(child(n, 0)));
+
+        result.rest.reserve(n.child_count - 1);
+        for (std::size_t i = 1; i != n.child_count; ++i)
+        {
+            node const& op = child(n, i);
+            result.rest.emplace_back(
+                ast::optoken(op.op), expand_operand(child(op, 0)));
+        }
+        return result;
+    }
+
+    ast::operand flat_ast::expand_operand(node const& n) const
+    {
+        if (n.kind == node_kind::unary_expr)
+        {
+            ast::unary_expr ue(ast::optoken(n.op), expand_operand(child(n, 0)));
+            set_tag(ue, n);
+            return ast::operand(std::move(ue));
+        }
+        return ast::operand(expand_primary(n));
+    }
+
+    template <typename T>
+    ast::primary_expr flat_ast::expand_data(node const& n) const
+    {
+        std::uint64_t const* extents = words_ + n.value;
+        std::uint64_t const* values = extents + n.dimensions;
+
+        switch (n.dimensions)
+        {
+        case 0:
+            {
+                T value;
+                std::memcpy(&value, values, sizeof(T));
+                return ast::primary_expr(ir::node_data<T>(value));
+            }
+
+        case 1:
+            {
+                blaze::DynamicVector<T> v(extents[0]);
+                std::memcpy(v.data(), values, v.size() * sizeof(T));
+                return ast::primary_expr(ir::node_data<T>(std::move(v)));
+            }
+
+        case 2:
+            {
+                blaze::DynamicMatrix<T> m(extents[0], extents[1]);
+                for (std::size_t i = 0; i != m.rows(); ++i)
+                {
+                    std::memcpy(m.data(i), values + i * m.columns(),
+                        m.columns() * sizeof(T));
+                }
+                return ast::primary_expr(ir::node_data<T>(std::move(m)));
+            }
+
+#if defined(PHYLANX_HAVE_BLAZE_TENSOR)
+        case 3:
+            {
+                blaze::DynamicTensor<T> t(extents[0], extents[1], extents[2]);
+                for (std::size_t k = 0; k != t.pages(); ++k)
+                {
+                    for (std::size_t i = 0; i != t.rows(); ++i)
+                    {
+                        for (std::size_t j = 0; j != t.columns(); ++j)
+                        {
+                            std::memcpy(&t(k, i, j), values++, sizeof(T));
+                        }
+                    }
+                }
+                return ast::primary_expr(ir::node_data<T>(std::move(t)));
+            }
+#endif
+
+        default:
+            break;
+        }
+
+        HPX_THROW_EXCEPTION(hpx::bad_parameter,
+            "phylanx::ast::flat_ast::expression",
+            "unsupported dimensionality of numeric literal");
+    }
+
+    ast::primary_expr flat_ast::expand_primary(node const& n) const
+    {
+        ast::primary_expr result;
+
+        switch (n.kind)
+        {
+        case node_kind::boolean:
+            result = ast::primary_expr(n.value != 0);
+            break;
+
+        case node_kind::identifier:
+            {
+                ast::identifier id(get_string(n.value));
+                set_tag(id, n);
+                return ast::primary_expr(std::move(id));
+            }
+
+        case node_kind::string:
+            result = ast::primary_expr(get_string(n.value));
+            break;
+
+        case node_kind::double_data:
+            result = expand_data<double>(n);
+            break;
+
+        case node_kind::int64_data:
+            result = expand_data<std::int64_t>(n);
+            break;
+
+        case node_kind::parenthesized:
+            result = ast::primary_expr(expand_expression(child(n, 0)));
+            break;
+
+        case node_kind::function_call:
+            {
+                ast::identifier name(get_string(n.value));
+                set_tag(name, n);
+
+                std::vector<ast::expression> args;
+                args.reserve(n.child_count);
+                for (std::size_t i = 0; i != n.child_count; ++i)
+                {
+                    args.emplace_back(expand_expression(child(n, i)));
+                }
+
+                return ast::primary_expr(ast::function_call(std::move(name),
+                    get_string(n.extra), std::move(args)));
+            }
+
+        case node_kind::list:
+            {
+                std::vector<ast::expression> l;
+                l.reserve(n.child_count);
+                for (std::size_t i = 0; i != n.child_count; ++i)
+                {
+                    l.emplace_back(expand_expression(child(n, i)));
+                }
+                result = ast::primary_expr(std::move(l));
+            }
+            break;
+
+        case node_kind::nil: HPX_FALLTHROUGH;
+        default:
+            result = ast::primary_expr(ast::nil{});
+            break;
+        }
+
+        set_tag(result, n);
+        return result;
+    }
+}}
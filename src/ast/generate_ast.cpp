@@ -1,4 +1,4 @@
-//  Copyright (c) 2017-2018 Hartmut Kaiser
+//  Copyright (c) 2017-2019 Hartmut Kaiser
 //
 //  Distributed under the Boost Software License, Version 1.0. (See accompanying
 //  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
@@ -7,6 +7,7 @@
 #include <phylanx/ast/generate_ast.hpp>
 #include <phylanx/ast/node.hpp>
 #include <phylanx/ast/parser/expression.hpp>
+#include <phylanx/ast/parser/physl_parser.hpp>
 #include <phylanx/ast/parser/skipper.hpp>
 
 #include <hpx/throw_exception.hpp>
@@ -218,6 +219,13 @@ namespace phylanx { namespace ast
     {
         ir::reset_enable_counts_on_exit on_exit;
 
+        return parser::parse_physl(input);
+    }
+
+    std::vector<ast::expression> generate_ast_qi(std::string const& input)
+    {
+        ir::reset_enable_counts_on_exit on_exit;
+
         using iterator = std::string::const_iterator;
 
         iterator first = input.begin();
@@ -237,7 +245,7 @@ namespace phylanx { namespace ast
                 boost::spirit::qi::skip_flag::postskip, asts))
         {
             HPX_THROW_EXCEPTION(hpx::bad_parameter,
-                "phylanx::ast::generate_ast", strm.str());
+                "phylanx::ast::generate_ast_qi", strm.str());
         }
 
         if (first != last)
@@ -245,7 +253,7 @@ namespace phylanx { namespace ast
             error_handler("Error! ", "Incomplete parse:", first);
 
             HPX_THROW_EXCEPTION(hpx::bad_parameter,
-                "phylanx::ast::generate_ast", strm.str());
+                "phylanx::ast::generate_ast_qi", strm.str());
         }
 
         // replace compile-tags with line/column information
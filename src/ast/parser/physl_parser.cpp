@@ -0,0 +1,1088 @@
+//  Copyright (c) 2019 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <phylanx/config.hpp>
+#include <phylanx/ast/node.hpp>
+#include <phylanx/ast/parser/error_handler.hpp>
+#include <phylanx/ast/parser/physl_parser.hpp>
+#include <phylanx/ir/node_data.hpp>
+
+#include <hpx/throw_exception.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <limits>
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <blaze/Math.h>
+#if defined(PHYLANX_HAVE_BLAZE_TENSOR)
+#include <blaze_tensor/Math.h>
+#endif
+
+namespace phylanx { namespace ast { namespace parser
+{
+    namespace
+    {
+        ///////////////////////////////////////////////////////////////////////
+        // character classification, independent of the current locale
+        inline bool is_digit(char c)
+        {
+            return c >= '0' && c <= '9';
+        }
+
+        inline bool is_alpha(char c)
+        {
+            return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z');
+        }
+
+        inline bool is_identifier_start(char c)
+        {
+            return is_alpha(c) || c == '_';
+        }
+
+        inline bool is_identifier_char(char c)
+        {
+            return is_alpha(c) || is_digit(c) || c == '_';
+        }
+
+        inline bool is_hex_digit(char c)
+        {
+            return is_digit(c) || (c >= 'a' && c <= 'f') ||
+                (c >= 'A' && c <= 'F');
+        }
+
+        inline int hex_value(char c)
+        {
+            if (is_digit(c))
+            {
+                return c - '0';
+            }
+            return (c >= 'a' && c <= 'f') ? c - 'a' + 10 : c - 'A' + 10;
+        }
+
+        inline char to_lower(char c)
+        {
+            return (c >= 'A' && c <= 'Z') ? char(c - 'A' + 'a') : c;
+        }
+
+        constexpr std::size_t number_buffer_size = 64;
+
+#if defined(PHYLANX_HAVE_BLAZE_TENSOR)
+        constexpr std::size_t max_array_dimensions = 3;
+#else
+        constexpr std::size_t max_array_dimensions = 2;
+#endif
+
+        ///////////////////////////////////////////////////////////////////////
+        // The numbers of a numeric array literal, stored flat in row-major
+        // order. The values are collected as integers as long as possible,
+        // the first non-integral value converts everything to double.
+        struct array_literal
+        {
+            std::vector<std::int64_t> ints;
+            std::vector<double> doubles;
+            bool is_double = false;
+
+            // nesting level of the numbers, zero as long as it is unknown
+            std::size_t dimensions = 0;
+
+            std::array<std::size_t, max_array_dimensions> extents;
+            std::array<bool, max_array_dimensions> has_extent{};
+
+            void to_double()
+            {
+                doubles.reserve(ints.size());
+                for (std::int64_t v : ints)
+                {
+                    doubles.push_back(double(v));
+                }
+                ints.clear();
+                is_double = true;
+            }
+        };
+
+        template <typename T>
+        ast::primary_expr make_array(
+            std::vector<T> const& values, array_literal const& data)
+        {
+            switch (data.dimensions)
+            {
+            case 1:
+                {
+                    blaze::DynamicVector<T> v(values.size());
+                    std::copy(values.begin(), values.end(), v.begin());
+                    return ast::primary_expr(ir::node_data<T>(std::move(v)));
+                }
+
+            case 2:
+                {
+                    std::size_t const rows = data.extents[0];
+                    std::size_t const columns = data.extents[1];
+
+                    blaze::DynamicMatrix<T> m(rows, columns);
+                    for (std::size_t i = 0; i != rows; ++i)
+                    {
+                        auto row = values.begin() + i * columns;
+                        std::copy(row, row + columns, m.begin(i));
+                    }
+                    return ast::primary_expr(ir::node_data<T>(std::move(m)));
+                }
+
+#if defined(PHYLANX_HAVE_BLAZE_TENSOR)
+            case 3:
+                {
+                    std::size_t const pages = data.extents[0];
+                    std::size_t const rows = data.extents[1];
+                    std::size_t const columns = data.extents[2];
+
+                    blaze::DynamicTensor<T> t(pages, rows, columns);
+                    auto value = values.begin();
+                    for (std::size_t k = 0; k != pages; ++k)
+                    {
+                        for (std::size_t i = 0; i != rows; ++i)
+                        {
+                            for (std::size_t j = 0; j != columns; ++j)
+                            {
+                                t(k, i, j) = *value++;
+                            }
+                        }
+                    }
+                    return ast::primary_expr(ir::node_data<T>(std::move(t)));
+                }
+#endif
+
+            default:
+                break;
+            }
+            return ast::primary_expr{};
+        }
+
+        ///////////////////////////////////////////////////////////////////////
+        // Recursive descent parser for PhySL, this mirrors the rules of the
+        // Spirit grammar in expression_def.hpp. Line and column information
+        // is maintained while skipping over the input, which allows to tag
+        // the AST nodes as soon as they are created.
+        class physl_parser
+        {
+        public:
+            explicit physl_parser(std::string const& input)
+              : first_(input.data())
+              , last_(input.data() + input.size())
+              , it_(first_)
+              , line_start_(first_)
+              , line_(1)
+            {
+            }
+
+            std::vector<ast::expression> parse()
+            {
+                std::vector<ast::expression> result;
+
+                ast::expression expr;
+                while (parse_expr(expr))
+                {
+                    result.emplace_back(std::move(expr));
+                    expr = ast::expression{};
+                }
+
+                skip();
+                if (it_ != last_)
+                {
+                    error("Error! ", "Incomplete parse:", it_);
+                }
+                return result;
+            }
+
+        private:
+            ///////////////////////////////////////////////////////////////////
+            // error reporting uses the same format as the Spirit grammar
+            void error(
+                char const* message, char const* what, char const* pos) const
+            {
+                std::vector<char const*> iters;
+                std::stringstream strm;
+                error_handler<char const*> handler(first_, last_, strm, iters);
+
+                handler(message, what, pos);
+
+                HPX_THROW_EXCEPTION(hpx::bad_parameter,
+                    "phylanx::ast::generate_ast", strm.str());
+            }
+
+            void expected(char const* what) const
+            {
+                error("Error! Expecting ", what, it_);
+            }
+
+            void expect(char c, char const* what)
+            {
+                skip();
+                if (it_ == last_ || *it_ != c)
+                {
+                    expected(what);
+                }
+                ++it_;
+            }
+
+            ///////////////////////////////////////////////////////////////////
+            // The position is counted the same way as by the Spirit based
+            // parser: every CR and every LF starts a new line, columns are
+            // one-based.
+            ast::tagged position() const
+            {
+                return ast::tagged(std::int64_t(line_),
+                    std::int64_t(it_ - line_start_ + 1));
+            }
+
+            void newline(char const* next)
+            {
+                ++line_;
+                line_start_ = next;
+            }
+
+            // account for the line breaks inside of a token
+            void count_lines(char const* first, char const* last)
+            {
+                for (/**/; first != last; ++first)
+                {
+                    if (*first == '\r' || *first == '\n')
+                    {
+                        newline(first + 1);
+                    }
+                }
+            }
+
+            struct state
+            {
+                char const* it;
+                char const* line_start;
+                std::size_t line;
+            };
+
+            state save() const
+            {
+                return state{it_, line_start_, line_};
+            }
+
+            void restore(state const& s)
+            {
+                it_ = s.it;
+                line_start_ = s.line_start;
+                line_ = s.line;
+            }
+
+            ///////////////////////////////////////////////////////////////////
+            // skip whitespace and comments (/* */, //, and #)
+            void skip()
+            {
+                while (it_ != last_)
+                {
+                    char const c = *it_;
+                    if (c == '\r' || c == '\n')
+                    {
+                        newline(++it_);
+                    }
+                    else if (c == ' ' || c == '\t' || c == '\v' || c == '\f')
+                    {
+                        ++it_;
+                    }
+                    else if (c == '#' ||
+                        (c == '/' && it_ + 1 != last_ && it_[1] == '/'))
+                    {
+                        // the line break itself is handled by the next pass
+                        while (it_ != last_ && *it_ != '\r' && *it_ != '\n')
+                        {
+                            ++it_;
+                        }
+                    }
+                    else if (c == '/' && it_ + 1 != last_ && it_[1] == '*')
+                    {
+                        char const* end = it_ + 2;
+                        while (end != last_ &&
+                            !(*end == '*' && end + 1 != last_ && end[1] == '/'))
+                        {
+                            ++end;
+                        }
+                        if (end == last_)
+                        {
+                            return;     // unterminated comment is no comment
+                        }
+                        count_lines(it_, end);
+                        it_ = end + 2;
+                    }
+                    else
+                    {
+                        break;
+                    }
+                }
+            }
+
+            ///////////////////////////////////////////////////////////////////
+            // expr: unary_expr >> *(binary_op > unary_expr)
+            bool parse_expr(ast::expression& expr)
+            {
+                if (!parse_unary_expr(expr.first))
+                {
+                    return false;
+                }
+
+                ast::optoken op;
+                while (parse_binary_op(op))
+                {
+                    ast::operand rhs;
+                    if (!parse_unary_expr(rhs))
+                    {
+                        expected("<unary_expr>");
+                    }
+                    expr.rest.emplace_back(op, std::move(rhs));
+                }
+                return true;
+            }
+
+            bool parse_binary_op(ast::optoken& op)
+            {
+                skip();
+                if (it_ == last_)
+                {
+                    return false;
+                }
+
+                char const next = (it_ + 1 != last_) ? it_[1] : '\0';
+                std::size_t length = 1;
+                switch (*it_)
+                {
+                case '|':
+                    if (next != '|')
+                    {
+                        return false;
+                    }
+                    op = ast::optoken::op_logical_or;
+                    length = 2;
+                    break;
+
+                case '&':
+                    if (next != '&')
+                    {
+                        return false;
+                    }
+                    op = ast::optoken::op_logical_and;
+                    length = 2;
+                    break;
+
+                case '=':
+                    if (next != '=')
+                    {
+                        return false;
+                    }
+                    op = ast::optoken::op_equal;
+                    length = 2;
+                    break;
+
+                case '!':
+                    if (next != '=')
+                    {
+                        return false;
+                    }
+                    op = ast::optoken::op_not_equal;
+                    length = 2;
+                    break;
+
+                case '<':
+                    if (next == '=')
+                    {
+                        op = ast::optoken::op_less_equal;
+                        length = 2;
+                    }
+                    else
+                    {
+                        op = ast::optoken::op_less;
+                    }
+                    break;
+
+                case '>':
+                    if (next == '=')
+                    {
+                        op = ast::optoken::op_greater_equal;
+                        length = 2;
+                    }
+                    else
+                    {
+                        op = ast::optoken::op_greater;
+                    }
+                    break;
+
+                case '+':
+                    op = ast::optoken::op_plus;
+                    break;
+
+                case '-':
+                    op = ast::optoken::op_minus;
+                    break;
+
+                case '*':
+                    op = ast::optoken::op_times;
+                    break;
+
+                case '/':
+                    op = ast::optoken::op_divide;
+                    break;
+
+                case '%':
+                    op = ast::optoken::op_mod;
+                    break;
+
+                default:
+                    return false;
+                }
+
+                it_ += length;
+                return true;
+            }
+
+            ///////////////////////////////////////////////////////////////////
+            // unary_expr: primary_expr | (unary_op > unary_expr)
+            bool parse_unary_expr(ast::operand& result)
+            {
+                skip();
+                if (it_ == last_)
+                {
+                    return false;
+                }
+
+                ast::tagged const pos = position();
+                if (parse_primary_expr(result, pos))
+                {
+                    return true;
+                }
+
+                ast::optoken op;
+                switch (*it_)
+                {
+                case '+':
+                    op = ast::optoken::op_positive;
+                    break;
+
+                case '-':
+                    op = ast::optoken::op_negative;
+                    break;
+
+                case '!':
+                    op = ast::optoken::op_not;
+                    break;
+
+                default:
+                    return false;
+                }
+                ++it_;
+
+                ast::operand operand;
+                if (!parse_unary_expr(operand))
+                {
+                    expected("<unary_expr>");
+                }
+                result = ast::operand(ast::unary_expr(op, std::move(operand)));
+                return true;
+            }
+
+            ///////////////////////////////////////////////////////////////////
+            // literals are tagged with the position of the enclosing unary
+            // expression, all other primary expressions carry their tag in
+            // the identifier they hold
+            static ast::operand tagged_literal(
+                ast::primary_expr&& pe, ast::tagged const& pos)
+            {
+                pe.id = pos.id;
+                pe.col = pos.col;
+                return ast::operand(std::move(pe));
+            }
+
+            bool parse_primary_expr(
+                ast::operand& result, ast::tagged const& pos)
+            {
+                char const c = *it_;
+
+                // strict_double, this includes 'nan' and 'inf'
+                double d = 0.0;
+                char const* end = scan_double(it_, d, true);
+                if (end != it_)
+                {
+                    it_ = end;
+                    result = tagged_literal(ast::primary_expr(d), pos);
+                    return true;
+                }
+
+                // function_call | identifier
+                if (is_identifier_start(c))
+                {
+                    parse_identifier_or_call(result);
+                    return true;
+                }
+
+                // list
+                if (c == '\'')
+                {
+                    state const s = save();
+                    ++it_;
+                    skip();
+                    if (it_ == last_ || *it_ != '(')
+                    {
+                        restore(s);
+                        return false;
+                    }
+                    ++it_;
+
+                    std::vector<ast::expression> args;
+                    parse_argument_list(args);
+                    expect(')', "')'");
+
+                    result = tagged_literal(
+                        ast::primary_expr(std::move(args)), pos);
+                    return true;
+                }
+
+                // long_long
+                std::int64_t value = 0;
+                bool overflow = false;
+                end = scan_integer(it_, value, overflow);
+                if (end != it_)
+                {
+                    if (overflow)
+                    {
+                        error("Error! ", "Integer literal out of range", it_);
+                    }
+                    it_ = end;
+                    result = tagged_literal(ast::primary_expr(value), pos);
+                    return true;
+                }
+
+                switch (c)
+                {
+                case '"':       // string
+                    {
+                        std::string str;
+                        parse_string(str);
+                        result = tagged_literal(
+                            ast::primary_expr(std::move(str)), pos);
+                    }
+                    return true;
+
+                case '[':       // int64/double vector, matrix, tensor
+                    result = tagged_literal(parse_array(), pos);
+                    return true;
+
+                case '(':       // '(' > expr > ')'
+                    {
+                        ++it_;
+                        ast::expression expr;
+                        if (!parse_expr(expr))
+                        {
+                            expected("<expr>");
+                        }
+                        expect(')', "')'");
+                        result = ast::operand(
+                            ast::primary_expr(std::move(expr)));
+                    }
+                    return true;
+
+                default:
+                    break;
+                }
+                return false;
+            }
+
+            ///////////////////////////////////////////////////////////////////
+            // function_call: identifier >> attribute >> ('(' > args > ')')
+            void parse_identifier_or_call(ast::operand& result)
+            {
+                ast::identifier id;
+                parse_identifier(id);
+
+                state const s = save();
+
+                std::string attribute;
+                skip();
+                if (it_ != last_ && *it_ == '{')
+                {
+                    char const* begin = ++it_;
+                    while (it_ != last_ && *it_ != '}')
+                    {
+                        ++it_;
+                    }
+                    if (it_ == last_)
+                    {
+                        expected("'}'");
+                    }
+                    count_lines(begin, it_);
+                    attribute.assign(begin, it_);
+                    ++it_;
+                    skip();
+                }
+
+                if (it_ == last_ || *it_ != '(')
+                {
+                    // not a function call, leave the attribute for the caller
+                    restore(s);
+                    result = ast::operand(std::move(id));
+                    return;
+                }
+                ++it_;
+
+                std::vector<ast::expression> args;
+                parse_argument_list(args);
+                expect(')', "')'");
+
+                result = ast::operand(ast::primary_expr(ast::function_call(
+                    std::move(id), std::move(attribute), std::move(args))));
+            }
+
+            // identifier: name >> -('$' > long_long) >> -('$' > long_long)
+            void parse_identifier(ast::identifier& id)
+            {
+                ast::tagged const pos = position();
+
+                char const* begin = it_;
+                while (it_ != last_ && is_identifier_char(*it_))
+                {
+                    ++it_;
+                }
+                id.name.assign(begin, it_);
+
+                id.id = parse_identifier_tag();
+                id.col = parse_identifier_tag();
+
+                if (id.id < 0 && id.col == -1)
+                {
+                    id.id = pos.id;
+                    id.col = pos.col;
+                }
+            }
+
+            std::int64_t parse_identifier_tag()
+            {
+                state const s = save();
+                skip();
+                if (it_ == last_ || *it_ != '$')
+                {
+                    restore(s);
+                    return -1;
+                }
+                ++it_;
+                skip();
+
+                std::int64_t value = 0;
+                bool overflow = false;
+                char const* end = scan_integer(it_, value, overflow);
+                if (end == it_ || overflow)
+                {
+                    expected("<long_long>");
+                }
+                it_ = end;
+                return value;
+            }
+
+            // argument_list: -(expr % ',')
+            void parse_argument_list(std::vector<ast::expression>& args)
+            {
+                ast::expression expr;
+                if (!parse_expr(expr))
+                {
+                    return;
+                }
+                args.emplace_back(std::move(expr));
+
+                while (true)
+                {
+                    state const s = save();
+                    skip();
+                    if (it_ == last_ || *it_ != ',')
+                    {
+                        restore(s);
+                        return;
+                    }
+                    ++it_;
+
+                    expr = ast::expression{};
+                    if (!parse_expr(expr))
+                    {
+                        restore(s);
+                        return;
+                    }
+                    args.emplace_back(std::move(expr));
+                }
+            }
+
+            ///////////////////////////////////////////////////////////////////
+            // string: '"' > *(unesc_char | "\\x" >> hex | (char_ - '"')) > '"'
+            void parse_string(std::string& str)
+            {
+                char const* begin = ++it_;
+                while (true)
+                {
+                    // copy runs of plain characters in one go
+                    char const* run = it_;
+                    while (it_ != last_ && *it_ != '"' && *it_ != '\\')
+                    {
+                        ++it_;
+                    }
+                    str.append(run, it_);
+
+                    if (it_ == last_)
+                    {
+                        expected("'\"'");
+                    }
+                    if (*it_ == '"')
+                    {
+                        break;
+                    }
+
+                    // *it_ == '\\'
+                    char const next = (it_ + 1 != last_) ? it_[1] : '\0';
+                    char unescaped = '\0';
+                    switch (next)
+                    {
+                    case 'a': unescaped = '\a'; break;
+                    case 'b': unescaped = '\b'; break;
+                    case 'f': unescaped = '\f'; break;
+                    case 'n': unescaped = '\n'; break;
+                    case 'r': unescaped = '\r'; break;
+                    case 't': unescaped = '\t'; break;
+                    case 'v': unescaped = '\v'; break;
+                    case '\\': unescaped = '\\'; break;
+                    case '\'': unescaped = '\''; break;
+                    case '"': unescaped = '"'; break;
+
+                    case 'x':
+                        if (it_ + 2 != last_ && is_hex_digit(it_[2]))
+                        {
+                            int value = hex_value(it_[2]);
+                            it_ += 3;
+                            if (it_ != last_ && is_hex_digit(*it_))
+                            {
+                                value = value * 16 + hex_value(*it_++);
+                            }
+                            str.push_back(char(value));
+                            continue;
+                        }
+                        HPX_FALLTHROUGH;
+
+                    default:
+                        // not an escape sequence, keep the backslash
+                        str.push_back('\\');
+                        ++it_;
+                        continue;
+                    }
+
+                    str.push_back(unescaped);
+                    it_ += 2;
+                }
+
+                count_lines(begin, it_);
+                ++it_;
+            }
+
+            ///////////////////////////////////////////////////////////////////
+            // Numeric array literals, the innermost lists hold the numbers.
+            // All numbers are integers for int64 arrays, otherwise the array
+            // holds doubles.
+            ast::primary_expr parse_array()
+            {
+                array_literal data;
+
+                ++it_;
+                parse_array_elements(data, 0);
+
+                if (data.is_double)
+                {
+                    return make_array(data.doubles, data);
+                }
+                return make_array(data.ints, data);
+            }
+
+            void parse_array_elements(array_literal& data, std::size_t level)
+            {
+                skip();
+                if (it_ != last_ && *it_ == ']')
+                {
+                    ++it_;
+                    set_dimensions(data, level + 1);
+                    set_extent(data, level, 0);
+                    return;
+                }
+
+                std::size_t count = 0;
+                while (true)
+                {
+                    skip();
+                    if (it_ != last_ && *it_ == '[')
+                    {
+                        if ((data.dimensions != 0 &&
+                                data.dimensions <= level + 1) ||
+                            level + 1 == max_array_dimensions)
+                        {
+                            expected("<number>");
+                        }
+                        ++it_;
+                        parse_array_elements(data, level + 1);
+                    }
+                    else
+                    {
+                        set_dimensions(data, level + 1);
+                        parse_array_element(data);
+                    }
+                    ++count;
+
+                    skip();
+                    if (it_ == last_ || *it_ != ',')
+                    {
+                        break;
+                    }
+                    ++it_;
+                }
+
+                expect(']', "']'");
+                set_extent(data, level, count);
+            }
+
+            void parse_array_element(array_literal& data)
+            {
+                if (!data.is_double)
+                {
+                    std::int64_t value = 0;
+                    bool overflow = false;
+                    char const* end = scan_integer(it_, value, overflow);
+
+                    double real = 0.0;
+                    if (end != it_ && !overflow &&
+                        scan_double(it_, real, true) == it_)
+                    {
+                        data.ints.push_back(value);
+                        it_ = end;
+                        return;
+                    }
+                    data.to_double();
+                }
+
+                double value = 0.0;
+                char const* end = scan_double(it_, value, false);
+                if (end == it_)
+                {
+                    expected("<number>");
+                }
+                data.doubles.push_back(value);
+                it_ = end;
+            }
+
+            void set_dimensions(array_literal& data, std::size_t dimensions)
+            {
+                if (data.dimensions == 0)
+                {
+                    data.dimensions = dimensions;
+                }
+                else if (data.dimensions != dimensions)
+                {
+                    expected("'['");
+                }
+            }
+
+            void set_extent(
+                array_literal& data, std::size_t level, std::size_t extent)
+            {
+                if (!data.has_extent[level])
+                {
+                    data.extents[level] = extent;
+                    data.has_extent[level] = true;
+                }
+                else if (data.extents[level] != extent)
+                {
+                    error("Error! ",
+                        "Array literal with elements of different sizes",
+                        it_ - 1);
+                }
+            }
+
+            ///////////////////////////////////////////////////////////////////
+            // Scan a floating point number, returns 'first' if none was
+            // found. A strict number requires a decimal point or an exponent.
+            char const* scan_double(
+                char const* first, double& value, bool strict) const
+            {
+                char const* p = first;
+                bool negative = false;
+                if (p != last_ && (*p == '+' || *p == '-'))
+                {
+                    negative = *p++ == '-';
+                }
+
+                char const* digits = p;
+                while (p != last_ && is_digit(*p))
+                {
+                    ++p;
+                }
+                bool has_digits = p != digits;
+                bool is_real = false;
+
+                if (p != last_ && *p == '.')
+                {
+                    char const* fraction = p + 1;
+                    while (fraction != last_ && is_digit(*fraction))
+                    {
+                        ++fraction;
+                    }
+                    if (has_digits || fraction != p + 1)
+                    {
+                        has_digits = true;
+                        is_real = true;
+                        p = fraction;
+                    }
+                }
+
+                if (!has_digits)
+                {
+                    return scan_special(first, p, negative, value);
+                }
+
+                if (p != last_ && (*p == 'e' || *p == 'E'))
+                {
+                    char const* exponent = p + 1;
+                    if (exponent != last_ &&
+                        (*exponent == '+' || *exponent == '-'))
+                    {
+                        ++exponent;
+                    }
+                    char const* exp_digits = exponent;
+                    while (exponent != last_ && is_digit(*exponent))
+                    {
+                        ++exponent;
+                    }
+                    if (exponent != exp_digits)
+                    {
+                        is_real = true;
+                        p = exponent;
+                    }
+                }
+
+                if (strict && !is_real)
+                {
+                    return first;
+                }
+
+                // strtod could read past the scanned number (for instance
+                // hexadecimal numbers), convert a terminated copy instead
+                std::size_t const length = std::size_t(p - first);
+                if (length < number_buffer_size)
+                {
+                    std::array<char, number_buffer_size> buffer;
+                    std::copy(first, p, buffer.begin());
+                    buffer[length] = '\0';
+                    value = std::strtod(buffer.data(), nullptr);
+                }
+                else
+                {
+                    value = std::strtod(std::string(first, p).c_str(), nullptr);
+                }
+                return p;
+            }
+
+            // 'nan', 'inf', and 'infinity' (case insensitive)
+            char const* scan_special(char const* first, char const* p,
+                bool negative, double& value) const
+            {
+                auto matches = [&](char const* word) -> char const* {
+                    char const* q = p;
+                    for (/**/; *word != '\0'; ++word, ++q)
+                    {
+                        if (q == last_ || to_lower(*q) != *word)
+                        {
+                            return nullptr;
+                        }
+                    }
+                    return (q == last_ || !is_identifier_char(*q)) ? q
+                                                                   : nullptr;
+                };
+
+                if (char const* end = matches("nan"))
+                {
+                    value = std::numeric_limits<double>::quiet_NaN();
+                    return end;
+                }
+
+                char const* end = matches("inf");
+                if (end == nullptr)
+                {
+                    end = matches("infinity");
+                }
+                if (end != nullptr)
+                {
+                    value = negative ? -std::numeric_limits<double>::infinity()
+                                     : std::numeric_limits<double>::infinity();
+                    return end;
+                }
+                return first;
+            }
+
+            // Scan a (signed) integer, returns 'first' if none was found
+            char const* scan_integer(
+                char const* first, std::int64_t& value, bool& overflow) const
+            {
+                char const* p = first;
+                bool negative = false;
+                if (p != last_ && (*p == '+' || *p == '-'))
+                {
+                    negative = *p++ == '-';
+                }
+
+                char const* digits = p;
+                std::uint64_t const limit = negative ?
+                    std::uint64_t((std::numeric_limits<std::int64_t>::max)()) +
+                        1 :
+                    std::uint64_t((std::numeric_limits<std::int64_t>::max)());
+
+                std::uint64_t result = 0;
+                overflow = false;
+                for (/**/; p != last_ && is_digit(*p); ++p)
+                {
+                    std::uint64_t const digit = std::uint64_t(*p - '0');
+                    if (result > (limit - digit) / 10)
+                    {
+                        overflow = true;
+                    }
+                    else
+                    {
+                        result = result * 10 + digit;
+                    }
+                }
+
+                if (p == digits)
+                {
+                    return first;
+                }
+
+                value = negative ? std::int64_t(0 - result) :
+                                   std::int64_t(result);
+                return p;
+            }
+
+            char const* first_;
+            char const* last_;
+            char const* it_;
+
+            char const* line_start_;
+            std::size_t line_;
+
+        };
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    std::vector<ast::expression> parse_physl(std::string const& input)
+    {
+        return physl_parser(input).parse();
+    }
+}}}
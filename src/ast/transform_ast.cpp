@@ -1,4 +1,4 @@
-//  Copyright (c) 2017-2018 Hartmut Kaiser
+//  Copyright (c) 2017-2019 Hartmut Kaiser
 //
 //  Distributed under the Boost Software License, Version 1.0. (See accompanying
 //  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
@@ -11,7 +11,13 @@
 #include <phylanx/ast/traverse.hpp>
 #include <phylanx/util/variant.hpp>
 
+#include <hpx/throw_exception.hpp>
+
+#include <algorithm>
+#include <cstddef>
 #include <map>
+#include <numeric>
+#include <ostream>
 #include <string>
 #include <utility>
 #include <vector>
@@ -498,6 +504,23 @@ namespace phylanx { namespace ast
             std::vector<expression> args = simplify(fc.args);
             return function_call{fc.function_name, std::move(args)};
         }
+
+        ///////////////////////////////////////////////////////////////////////
+        // replace the placeholders in the replacement expression of a rule
+        // with the expressions they were matched against
+        expression substitute(expression const& replace,
+            std::multimap<std::string, expression> const& placeholders)
+        {
+            expression result{replace};
+            for (auto const& placeholder : placeholders)
+            {
+                result = transduce(result,
+                    identifier{placeholder.first}, placeholder.second);
+            }
+
+            // simplify tree (eliminate expressions with only one operand)
+            return simplify(result);
+        }
     }
 
     expression transform_ast(expression const& in, transform_rule const& rule)
@@ -524,15 +547,7 @@ namespace phylanx { namespace ast
             return detail::simplify(expression{std::move(op), std::move(ops)});
         }
 
-        expression result{rule.second};
-        for (auto const& placeholder : placeholders)
-        {
-            result = detail::transduce(result,
-                identifier{placeholder.first}, placeholder.second);
-        }
-
-        // simplify tree (eliminate expressions with only one operand)
-        return detail::simplify(result);
+        return detail::substitute(rule.second, placeholders);
     }
 
 
@@ -580,4 +595,362 @@ namespace phylanx { namespace ast
 
         return result;
     }
+
+    ///////////////////////////////////////////////////////////////////////////
+    rule_set::rule_set(
+            std::vector<transform_rule> rules, std::size_t max_rewrites)
+      : rules_(std::move(rules))
+      , max_rewrites_(max_rewrites)
+    {
+        for (std::size_t i = 0; i != rules_.size(); ++i)
+        {
+            add_to_index(i, rules_[i].first);
+        }
+        statistics_.applications.resize(rules_.size(), 0);
+    }
+
+    // The index mirrors the checks performed by match_ast: binary expressions
+    // match only if their leading operators are the same, unary expressions
+    // only if their operators are the same, and function calls only if their
+    // names and (unless there are ellipses) their numbers of arguments are
+    // the same.
+    void rule_set::add_to_index(std::size_t rule, expression const& match)
+    {
+        expression const& expr = detail::extract_expression(match);
+        if (detail::is_placeholder(expr))
+        {
+            any_rules_.push_back(rule);
+            return;
+        }
+
+        if (!expr.rest.empty())
+        {
+            binary_rules_[std::size_t(expr.rest.front().operator_)].push_back(
+                rule);
+            return;
+        }
+
+        switch (expr.first.index())
+        {
+        case 1:     // phylanx::util::recursive_wrapper<primary_expr>
+            {
+                primary_expr const& pe = util::get<1>(expr.first.var).get();
+                if (pe.index() == 3)
+                {
+                    // identifier
+                    identifier_rules_[util::get<3>(pe.var).name].push_back(
+                        rule);
+                    return;
+                }
+                if (pe.index() == 7)
+                {
+                    // phylanx::util::recursive_wrapper<function_call>
+                    function_call const& fc = util::get<7>(pe.var).get();
+                    if (detail::is_placeholder(fc.function_name))
+                    {
+                        any_call_rules_.push_back(rule);
+                        return;
+                    }
+
+                    call_rules& rules = call_rules_[fc.function_name.name];
+                    if (std::any_of(fc.args.begin(), fc.args.end(),
+                            [](expression const& arg)
+                            {
+                                return detail::is_placeholder_ellipses(arg);
+                            }))
+                    {
+                        rules.variadic.push_back(rule);
+                    }
+                    else
+                    {
+                        rules.by_arity[fc.args.size()].push_back(rule);
+                    }
+                    return;
+                }
+            }
+            break;
+
+        case 2:     // phylanx::util::recursive_wrapper<unary_expr>
+            unary_rules_[std::size_t(
+                util::get<2>(expr.first.var).get().operator_)].push_back(rule);
+            return;
+
+        case 0: HPX_FALLTHROUGH;    // nil
+        default:
+            break;
+        }
+
+        // literals are tried for all expressions
+        any_rules_.push_back(rule);
+    }
+
+    void rule_set::append_candidates(rule_indices const& rules)
+    {
+        candidates_.insert(candidates_.end(), rules.begin(), rules.end());
+    }
+
+    void rule_set::collect_candidates(expression const& e)
+    {
+        candidates_.clear();
+
+        expression const& expr = detail::extract_expression(e);
+        bool match_all = detail::is_placeholder(expr);
+
+        if (!match_all)
+        {
+            append_candidates(any_rules_);
+
+            if (!expr.rest.empty())
+            {
+                append_candidates(
+                    binary_rules_[std::size_t(expr.rest.front().operator_)]);
+            }
+            else if (expr.first.index() == 2)
+            {
+                // phylanx::util::recursive_wrapper<unary_expr>
+                append_candidates(unary_rules_[std::size_t(
+                    util::get<2>(expr.first.var).get().operator_)]);
+            }
+            else if (expr.first.index() == 1)
+            {
+                // phylanx::util::recursive_wrapper<primary_expr>
+                primary_expr const& pe = util::get<1>(expr.first.var).get();
+                if (pe.index() == 3)
+                {
+                    // identifier
+                    auto it = identifier_rules_.find(util::get<3>(pe.var).name);
+                    if (it != identifier_rules_.end())
+                    {
+                        append_candidates(it->second);
+                    }
+                }
+                else if (pe.index() == 7)
+                {
+                    // phylanx::util::recursive_wrapper<function_call>
+                    function_call const& fc = util::get<7>(pe.var).get();
+
+                    // calls with placeholders may match any rule
+                    match_all = detail::is_placeholder(fc.function_name) ||
+                        std::any_of(fc.args.begin(), fc.args.end(),
+                            [](expression const& arg)
+                            {
+                                return detail::is_placeholder_ellipses(arg);
+                            });
+
+                    append_candidates(any_call_rules_);
+
+                    auto it = call_rules_.find(fc.function_name.name);
+                    if (it != call_rules_.end())
+                    {
+                        append_candidates(it->second.variadic);
+
+                        auto arity = it->second.by_arity.find(fc.args.size());
+                        if (arity != it->second.by_arity.end())
+                        {
+                            append_candidates(arity->second);
+                        }
+                    }
+                }
+            }
+        }
+
+        if (match_all)
+        {
+            candidates_.resize(rules_.size());
+            std::iota(candidates_.begin(), candidates_.end(), std::size_t(0));
+            return;
+        }
+
+        // rules are applied in the order they were given
+        std::sort(candidates_.begin(), candidates_.end());
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    bool rule_set::rewrite(expression& expr, std::size_t& budget)
+    {
+        // transform all nested expressions first
+        bool modified = rewrite_children(expr, budget);
+
+        std::multimap<std::string, expression> placeholders;
+        while (true)
+        {
+            ++statistics_.expressions_visited;
+            collect_candidates(expr);
+
+            std::size_t matched = rules_.size();
+            for (std::size_t rule : candidates_)
+            {
+                ++statistics_.match_attempts;
+                if (match_ast(expr, rules_[rule].first,
+                        detail::on_placeholder_match{placeholders}))
+                {
+                    matched = rule;
+                    break;
+                }
+                placeholders.clear();
+            }
+
+            if (matched == rules_.size())
+            {
+                return modified;        // reached a fixpoint
+            }
+
+            transform_rule const& rule = rules_[matched];
+            if (budget == 0)
+            {
+                HPX_THROW_EXCEPTION(hpx::bad_parameter,
+                    "phylanx::ast::rule_set::apply",
+                    "the transformation rules did not reach a fixpoint "
+                    "after " + std::to_string(max_rewrites_) +
+                        " rewrites, last applied rule: " +
+                        ast::to_string(rule.first) + " : " +
+                        ast::to_string(rule.second));
+            }
+            --budget;
+
+            ++statistics_.rewrites;
+            ++statistics_.applications[matched];
+
+            expr = detail::substitute(rule.second, placeholders);
+            placeholders.clear();
+            modified = true;
+
+            // the replacement may expose new opportunities for rewrites
+            rewrite_children(expr, budget);
+        }
+    }
+
+    bool rule_set::rewrite_children(expression& expr, std::size_t& budget)
+    {
+        bool modified = rewrite_children(expr.first, budget);
+        for (auto& op : expr.rest)
+        {
+            modified = rewrite_children(op.operand_, budget) || modified;
+        }
+        return modified;
+    }
+
+    bool rule_set::rewrite_children(operand& op, std::size_t& budget)
+    {
+        switch (op.index())
+        {
+        case 1:     // phylanx::util::recursive_wrapper<primary_expr>
+            {
+                primary_expr& pe = util::get<1>(op.var).get();
+                if (pe.index() != 6)
+                {
+                    return rewrite_children(pe, budget);
+                }
+
+                // phylanx::util::recursive_wrapper<expression>
+                expression& expr = util::get<6>(pe.var).get();
+                if (!rewrite(expr, budget))
+                {
+                    return false;
+                }
+
+                // collapse rewritten expressions consisting of only one
+                // operand (see simplify)
+                if (expr.rest.empty() && expr.first.index() != 0)
+                {
+                    operand first = std::move(expr.first);
+                    op = std::move(first);
+                }
+                return true;
+            }
+
+        case 2:     // phylanx::util::recursive_wrapper<unary_expr>
+            return rewrite_children(
+                util::get<2>(op.var).get().operand_, budget);
+
+        case 0: HPX_FALLTHROUGH;    // nil
+        default:
+            return false;
+        }
+    }
+
+    bool rule_set::rewrite_children(primary_expr& pe, std::size_t& budget)
+    {
+        switch (pe.index())
+        {
+        case 6:     // phylanx::util::recursive_wrapper<expression>
+            return rewrite(util::get<6>(pe.var).get(), budget);
+
+        case 7:     // phylanx::util::recursive_wrapper<function_call>
+            {
+                bool modified = false;
+                for (auto& arg : util::get<7>(pe.var).get().args)
+                {
+                    modified = rewrite(arg, budget) || modified;
+                }
+                return modified;
+            }
+
+        case 8:
+            // phylanx::util::recursive_wrapper<std::vector<ast::expression>>
+            {
+                bool modified = false;
+                for (auto& expr : util::get<8>(pe.var).get())
+                {
+                    modified = rewrite(expr, budget) || modified;
+                }
+                return modified;
+            }
+
+        case 0: HPX_FALLTHROUGH;    // nil
+        case 1: HPX_FALLTHROUGH;    // bool
+        case 2: HPX_FALLTHROUGH;    // phylanx::ir::node_data<double>
+        case 3: HPX_FALLTHROUGH;    // identifier
+        case 4: HPX_FALLTHROUGH;    // std::string
+        case 5: HPX_FALLTHROUGH;    // phylanx::ir::node_data<std::int64_t>
+        default:
+            return false;
+        }
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    bool rule_set::apply(expression& expr)
+    {
+        if (rules_.empty())
+        {
+            return false;
+        }
+
+        std::size_t budget = max_rewrites_;
+        return rewrite(expr, budget);
+    }
+
+    bool rule_set::apply(std::vector<expression>& exprs)
+    {
+        bool modified = false;
+        for (auto& expr : exprs)
+        {
+            modified = apply(expr) || modified;
+        }
+        return modified;
+    }
+
+    void rule_set::reset_statistics()
+    {
+        statistics_ = transform_statistics{};
+        statistics_.applications.resize(rules_.size(), 0);
+    }
+
+    void rule_set::print_statistics(std::ostream& os) const
+    {
+        os << "rules: " << rules_.size()
+           << ", expressions visited: " << statistics_.expressions_visited
+           << ", match attempts: " << statistics_.match_attempts
+           << ", rewrites: " << statistics_.rewrites << "\n";
+
+        for (std::size_t i = 0; i != rules_.size(); ++i)
+        {
+            if (statistics_.applications[i] != 0)
+            {
+                os << "  " << statistics_.applications[i] << ": "
+                   << ast::to_string(rules_[i].first) << " : "
+                   << ast::to_string(rules_[i].second) << "\n";
+            }
+        }
+    }
 }}
@@ -1,9 +1,10 @@
-// Copyright (c) 2017-2018 Hartmut Kaiser
+// Copyright (c) 2017-2019 Hartmut Kaiser
 //
 // Distributed under the Boost Software License, Version 1.0. (See accompanying
 // file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
 
 #include <phylanx/config.hpp>
+#include <phylanx/ast/flat_ast.hpp>
 #include <phylanx/ast/generate_ast.hpp>
 #include <phylanx/ast/node.hpp>
 #include <phylanx/execution_tree/compile.hpp>
@@ -15,6 +16,8 @@
 
 #include <algorithm>
 #include <cstddef>
+#include <list>
+#include <memory>
 #include <string>
 #include <utility>
 #include <vector>
@@ -29,6 +32,7 @@ namespace phylanx { namespace execution_tree
             compiler::environment& env, hpx::id_type const& default_locality)
         {
             ++snippets.compile_id_;
+            snippets.types_.infer(name, expr, snippets.compile_id_ - 1);
             return compiler::compile(name, expr, snippets, env,
                 compiler::generate_patterns(), default_locality);
         }
@@ -41,6 +45,7 @@ namespace phylanx { namespace execution_tree
                 compiler::default_environment(default_locality);
 
             ++snippets.compile_id_;
+            snippets.types_.infer(name, expr, snippets.compile_id_ - 1);
             return compiler::compile(name, expr, snippets, env,
                 compiler::generate_patterns(), default_locality);
         }
@@ -52,6 +57,7 @@ namespace phylanx { namespace execution_tree
             hpx::id_type const& default_locality)
         {
             ++snippets.compile_id_;
+            snippets.types_.infer(name, expr, snippets.compile_id_ - 1);
             return compiler::compile(
                 name, expr, snippets, env, patterns, default_locality);
         }
@@ -66,6 +72,9 @@ namespace phylanx { namespace execution_tree
     {
         compiler::entry_point entry_point(name);
 
+        // variables modified by later expressions have no known type
+        snippets.types_.prescan(exprs);
+
         for (auto const& expr : exprs)
         {
             // always keep objects alive that are generated by the compiler
@@ -84,6 +93,9 @@ namespace phylanx { namespace execution_tree
     {
         compiler::entry_point entry_point(name);
 
+        // variables modified by later expressions have no known type
+        snippets.types_.prescan(exprs);
+
         for (auto const& expr : exprs)
         {
             // always keep objects alive that are generated by the compiler
@@ -103,6 +115,28 @@ namespace phylanx { namespace execution_tree
             name, ast::generate_ast(expr), snippets, env, default_locality);
     }
 
+    compiler::entry_point const& compile(std::string const& name,
+        ast::flat_ast const& ast, compiler::function_list& snippets,
+        compiler::environment& env, hpx::id_type const& default_locality)
+    {
+        compiler::entry_point entry_point(name);
+
+        // variables modified by later expressions have no known type, the
+        // store() targets are collected from the flat nodes directly
+        snippets.types_.prescan(ast);
+
+        // the expressions are expanded one at a time
+        for (std::size_t i = 0; i != ast.root_count(); ++i)
+        {
+            // always keep objects alive that are generated by the compiler
+            entry_point.add_entry_point(detail::compile(
+                name, ast.expression(i), snippets, env, default_locality));
+        }
+
+        // always return the last of all generated compiler-functions
+        return snippets.program_.add_entry_point(std::move(entry_point));
+    }
+
     compiler::entry_point const& compile(std::string const& name,
         std::vector<ast::expression> const& exprs,
         compiler::function_list& snippets, hpx::id_type const& default_locality)
@@ -112,6 +146,9 @@ namespace phylanx { namespace execution_tree
 
         compiler::entry_point entry_point(name);
 
+        // variables modified by later expressions have no known type
+        snippets.types_.prescan(exprs);
+
         for (auto const& expr : exprs)
         {
             // always keep objects alive that are generated by the compiler
@@ -162,6 +199,66 @@ namespace phylanx { namespace execution_tree
             "<unknown>", ast::generate_ast(expr), snippets, default_locality);
     }
 
+    ///////////////////////////////////////////////////////////////////////////
+    namespace detail
+    {
+        compiler::function compile_entry_point(std::string const& name,
+            std::string const& expr, std::string const& func_name,
+            compiler::function_list& snippets, compiler::environment& env,
+            eval_context ctx, hpx::id_type const& default_locality)
+        {
+            // add all definitions to the given environment
+            compile(name, expr, snippets, env, default_locality).run(ctx);
+
+            // extract the function object representing the entry point
+            auto const& f = compile(name, func_name, snippets, env,
+                default_locality);
+            return compiler::function{f.run(ctx), func_name};
+        }
+    }
+
+    std::shared_ptr<compiler::specialized_function> compile_specialized(
+        std::string const& name, std::string const& expr,
+        std::string const& func_name, compiler::function_list& snippets,
+        compiler::environment& env, eval_context ctx,
+        std::size_t max_variants, hpx::id_type const& default_locality)
+    {
+        compiler::function generic = detail::compile_entry_point(
+            name, expr, func_name, snippets, env, ctx, default_locality);
+
+        // every variant is compiled into its own nested environment to avoid
+        // its definitions to shadow the ones of the generic function
+        auto envs = std::make_shared<std::list<compiler::environment>>();
+
+        return std::make_shared<compiler::specialized_function>(
+            std::move(generic),
+            [=, &snippets, &env](compiler::argument_signature const& sig)
+            ->  compiler::function
+            {
+                envs->emplace_back(&env);
+
+                // the argument types are known while compiling a variant
+                snippets.types_.annotate(
+                    func_name, compiler::inferred_argument_types(sig));
+
+                compiler::function f;
+                try
+                {
+                    f = detail::compile_entry_point(name, expr, func_name,
+                        snippets, envs->back(), ctx, default_locality);
+                }
+                catch (...)
+                {
+                    snippets.types_.clear_annotations();
+                    throw;
+                }
+
+                snippets.types_.clear_annotations();
+                return f;
+            },
+            max_variants);
+    }
+
     ///////////////////////////////////////////////////////////////////////////
     /// Add the given variable to the compilation environment
     compiler::function define_variable(std::string const& codename,
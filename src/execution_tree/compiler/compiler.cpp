@@ -1259,9 +1259,35 @@ namespace phylanx { namespace execution_tree { namespace compiler
                     name_, id));
         }
 
+        // select the typed variant of an operation whose dtype is known at
+        // compile time, this spares it determining the common type of its
+        // operands at runtime
+        std::string typed_primitive_name(
+            std::string const& name, ast::tagged const& id)
+        {
+            std::string typed_name;
+            switch (snippets_.types_.operation_dtype(
+                snippets_.compile_id_ - 1, id, name))
+            {
+            case node_data_type_double:
+                typed_name = name + "__float";
+                break;
+
+            case node_data_type_int64:
+                typed_name = name + "__int";
+                break;
+
+            default:
+                return name;
+            }
+            return env_.find(typed_name) != nullptr ? typed_name : name;
+        }
+
         function handle_placeholders(placeholder_map_type& placeholders,
-            std::string const& name, ast::tagged id)
+            std::string const& pattern_name, ast::tagged id)
         {
+            std::string const name = typed_primitive_name(pattern_name, id);
+
             // add sequence number for this primitive component
             std::size_t sequence_number =
                 snippets_.sequence_numbers_[name]++;
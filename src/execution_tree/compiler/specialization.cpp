@@ -0,0 +1,201 @@
+// Copyright (c) 2019 Hartmut Kaiser
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <phylanx/config.hpp>
+#include <phylanx/execution_tree/compiler/specialization.hpp>
+#include <phylanx/execution_tree/compiler/type_inference.hpp>
+#include <phylanx/execution_tree/primitives/base_primitive.hpp>
+
+#include <hpx/include/util.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace phylanx { namespace execution_tree { namespace compiler
+{
+    ///////////////////////////////////////////////////////////////////////////
+    bool extract_argument_signature(
+        arguments_type const& args, argument_signature& sig)
+    {
+        sig.clear();
+
+        for (auto const& arg : args)
+        {
+            switch (arg.index())
+            {
+            case primitive_argument_type::bool_index: HPX_FALLTHROUGH;
+            case primitive_argument_type::int64_index: HPX_FALLTHROUGH;
+            case primitive_argument_type::float64_index:
+                if (!sig.push_back(argument_signature_entry{
+                        std::uint8_t(arg.index()),
+                        std::uint8_t(extract_numeric_value_dimension(arg))}))
+                {
+                    return false;
+                }
+                break;
+
+            default:
+                return false;
+            }
+        }
+        return true;
+    }
+
+    std::ostream& operator<<(std::ostream& os, argument_signature const& sig)
+    {
+        static char const* const dtypes[] = {
+            "nil", "bool", "int", "string", "float"
+        };
+
+        os << "(";
+        bool first = true;
+        for (auto const& entry : sig)
+        {
+            if (!first)
+            {
+                os << ", ";
+            }
+            first = false;
+
+            os << (entry.index_ < 5 ? dtypes[entry.index_] : "<unknown>")
+               << "[" << std::size_t(entry.ndim_) << "d]";
+        }
+        os << ")";
+        return os;
+    }
+
+    std::vector<inferred_type> inferred_argument_types(
+        argument_signature const& sig)
+    {
+        std::vector<inferred_type> result;
+        result.reserve(sig.size());
+
+        for (auto const& entry : sig)
+        {
+            node_data_type dtype = node_data_type_unknown;
+            switch (entry.index_)
+            {
+            case primitive_argument_type::bool_index:
+                dtype = node_data_type_bool;
+                break;
+
+            case primitive_argument_type::int64_index:
+                dtype = node_data_type_int64;
+                break;
+
+            case primitive_argument_type::float64_index:
+                dtype = node_data_type_double;
+                break;
+
+            default:
+                break;
+            }
+
+            // the extents are not known, they may differ between calls
+            result.push_back(inferred_type(dtype, std::int64_t(entry.ndim_)));
+        }
+        return result;
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    specialized_function::specialized_function(function generic,
+            compile_function compile, std::size_t max_variants)
+      : generic_(std::move(generic))
+      , compile_(std::move(compile))
+      , max_variants_(max_variants)
+      , variants_(nullptr)
+      , specialized_calls_(0)
+      , generic_calls_(0)
+    {
+        tables_.emplace_back();
+        variants_.store(&tables_.back(), std::memory_order_release);
+    }
+
+    function const* specialized_function::find_variant(
+        variants_table const& variants, argument_signature const& sig)
+    {
+        // there are only a few variants, a linear search is fastest
+        for (auto const& v : variants)
+        {
+            if (v.signature_ == sig)
+            {
+                return v.function_;
+            }
+        }
+        return nullptr;
+    }
+
+    function const& specialized_function::generic_call() const
+    {
+        generic_calls_.fetch_add(1, std::memory_order_relaxed);
+        return generic_;
+    }
+
+    function const& specialized_function::select(
+        arguments_type const& args) const
+    {
+        argument_signature sig;
+        if (!compile_ || !extract_argument_signature(args, sig))
+        {
+            return generic_call();
+        }
+
+        {
+            variants_table const& variants =
+                *variants_.load(std::memory_order_acquire);
+
+            if (function const* f = find_variant(variants, sig))
+            {
+                specialized_calls_.fetch_add(1, std::memory_order_relaxed);
+                return *f;
+            }
+
+            if (variants.size() >= max_variants_)
+            {
+                return generic_call();
+            }
+        }
+
+        // compilations are serialized as they modify the shared compiler
+        // state, this also protects the list of tables
+        std::lock_guard<compile_mutex_type> l(compile_mtx_);
+
+        // another thread may have created the variant in the meantime
+        variants_table const& variants =
+            *variants_.load(std::memory_order_acquire);
+
+        if (function const* f = find_variant(variants, sig))
+        {
+            specialized_calls_.fetch_add(1, std::memory_order_relaxed);
+            return *f;
+        }
+
+        if (variants.size() >= max_variants_)
+        {
+            return generic_call();
+        }
+
+        functions_.push_back(compile_(sig));
+
+        // publish a new table, the current one may still be in use
+        tables_.push_back(variants);
+        tables_.back().push_back(variant{sig, &functions_.back()});
+        variants_.store(&tables_.back(), std::memory_order_release);
+
+        specialized_calls_.fetch_add(1, std::memory_order_relaxed);
+        return functions_.back();
+    }
+
+    result_type specialized_function::operator()(
+        arguments_type&& args, eval_context ctx) const
+    {
+        return select(args)(std::move(args), std::move(ctx));
+    }
+}}}
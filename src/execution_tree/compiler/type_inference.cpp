@@ -0,0 +1,1006 @@
+// Copyright (c) 2019 Hartmut Kaiser
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <phylanx/config.hpp>
+#include <phylanx/ast/detail/is_function_call.hpp>
+#include <phylanx/ast/detail/is_identifier.hpp>
+#include <phylanx/ast/detail/tagged_id.hpp>
+#include <phylanx/ast/flat_ast.hpp>
+#include <phylanx/ast/node.hpp>
+#include <phylanx/execution_tree/compiler/type_inference.hpp>
+#include <phylanx/execution_tree/primitives/node_data_helpers.hpp>
+#include <phylanx/util/variant.hpp>
+
+#include <hpx/throw_exception.hpp>
+#include <hpx/util/format.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <ostream>
+#include <set>
+#include <sstream>
+#include <string>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+namespace phylanx { namespace execution_tree { namespace compiler
+{
+    ///////////////////////////////////////////////////////////////////////////
+    constexpr std::int64_t inferred_type::unknown;
+
+    std::ostream& operator<<(std::ostream& os, inferred_type const& t)
+    {
+        static char const* const dtypes[] = {"float", "int", "bool"};
+
+        os << (t.has_dtype() ? dtypes[t.dtype] : "<unknown>") << "[";
+        if (!t.has_ndim())
+        {
+            os << "...";
+        }
+        for (std::int64_t i = 0; i < t.ndim; ++i)
+        {
+            if (i != 0)
+            {
+                os << "x";
+            }
+            if (t.dims[i] == inferred_type::unknown)
+            {
+                os << "?";
+            }
+            else
+            {
+                os << t.dims[i];
+            }
+        }
+        os << "]";
+        return os;
+    }
+
+    inferred_type join(inferred_type const& lhs, inferred_type const& rhs)
+    {
+        inferred_type result;
+        if (lhs.dtype == rhs.dtype)
+        {
+            result.dtype = lhs.dtype;
+        }
+        if (lhs.ndim == rhs.ndim)
+        {
+            result.ndim = lhs.ndim;
+            for (std::int64_t i = 0; i < lhs.ndim; ++i)
+            {
+                if (lhs.dims[i] == rhs.dims[i])
+                {
+                    result.dims[i] = lhs.dims[i];
+                }
+            }
+        }
+        return result;
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    namespace detail
+    {
+        // find the names of all variables that are the target of a store()
+        struct store_target_collector
+        {
+            void operator()(ast::expression const& expr) const
+            {
+                (*this)(expr.first);
+                for (auto const& op : expr.rest)
+                {
+                    (*this)(op.operand_);
+                }
+            }
+
+            void operator()(ast::operand const& op) const
+            {
+                switch (op.index())
+                {
+                case 1:
+                    (*this)(util::get<1>(op.get()).get());
+                    break;
+
+                case 2:
+                    (*this)(util::get<2>(op.get()).get().operand_);
+                    break;
+
+                default:
+                    break;
+                }
+            }
+
+            void operator()(ast::primary_expr const& pe) const
+            {
+                switch (pe.index())
+                {
+                case 6:     // expression
+                    (*this)(util::get<6>(pe.get()).get());
+                    break;
+
+                case 7:     // function_call
+                    (*this)(util::get<7>(pe.get()).get());
+                    break;
+
+                case 8:     // list
+                    for (auto const& expr : util::get<8>(pe.get()).get())
+                    {
+                        (*this)(expr);
+                    }
+                    break;
+
+                default:
+                    break;
+                }
+            }
+
+            void operator()(ast::function_call const& fc) const
+            {
+                if (fc.function_name.name == "store" && !fc.args.empty() &&
+                    ast::detail::is_identifier(fc.args[0]))
+                {
+                    stored_.insert(
+                        ast::detail::identifier_name(fc.args[0]));
+                }
+                for (auto const& expr : fc.args)
+                {
+                    (*this)(expr);
+                }
+            }
+
+            std::set<std::string>& stored_;
+        };
+
+        ///////////////////////////////////////////////////////////////////////
+        std::string extract_dtype_suffix(
+            std::string const& name, node_data_type& dtype)
+        {
+            // skip the leading underscores of the internal operators
+            std::string::size_type p = name.find("__", 1);
+            if (p != std::string::npos)
+            {
+                dtype = map_dtype(name.substr(p + 2));
+                return name.substr(0, p);
+            }
+            dtype = node_data_type_unknown;
+            return name;
+        }
+
+        template <typename T>
+        inferred_type literal_type(
+            ir::node_data<T> const& data, node_data_type dtype)
+        {
+            inferred_type result(dtype, data.num_dimensions());
+
+            auto dims = data.dimensions();
+            for (std::size_t i = 0; i != data.num_dimensions(); ++i)
+            {
+                result.dims[i] = std::int64_t(dims[i]);
+            }
+            return result;
+        }
+
+        // extract the value of a non-negative integer literal
+        bool extract_integer_literal(
+            ast::expression const& expr, std::int64_t& value)
+        {
+            if (!expr.rest.empty() || expr.first.index() != 1)
+            {
+                return false;
+            }
+
+            ast::primary_expr const& pe =
+                util::get<1>(expr.first.get()).get();
+            if (pe.index() != 5)
+            {
+                return false;
+            }
+
+            auto const& data = util::get<5>(pe.get());
+            if (data.num_dimensions() != 0 || data.scalar() < 0)
+            {
+                return false;
+            }
+
+            value = data.scalar();
+            return true;
+        }
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    struct inference_visitor
+    {
+        using scope_type = std::map<std::string, inferred_type>;
+
+        inference_visitor(type_inference& types, std::string const& codename)
+          : types_(types)
+          , codename_(codename)
+          , loop_depth_(0)
+        {
+        }
+
+        ///////////////////////////////////////////////////////////////////////
+        std::string generate_error_message(
+            std::string const& msg, ast::tagged const& id) const
+        {
+            return hpx::util::format(
+                PHYLANX_FORMAT_SPEC(1)
+                    "(" PHYLANX_FORMAT_SPEC(2) ", " PHYLANX_FORMAT_SPEC(3) "): "
+                    PHYLANX_FORMAT_SPEC(4), codename_, id.id, id.col, msg);
+        }
+
+        [[noreturn]] void report_mismatch(std::string const& name,
+            inferred_type const& lhs, inferred_type const& rhs,
+            ast::tagged const& id) const
+        {
+            std::ostringstream strm;
+            strm << "the operands of '" << name
+                 << "' have incompatible shapes: " << lhs << " and " << rhs;
+
+            HPX_THROW_EXCEPTION(hpx::bad_parameter,
+                "phylanx::execution_tree::compiler::type_inference",
+                generate_error_message(strm.str(), id));
+        }
+
+        // remember the type of the primitive created for the given node,
+        // nodes that map onto the same primitive name but disagree on their
+        // type are ambiguous (unknown types are removed after the analysis)
+        void record(ast::tagged const& id, std::string const& name,
+            inferred_type const& type, bool replace = false)
+        {
+            type_inference::key_type key{id.id, id.col, name};
+            if (ambiguous_.find(key) != ambiguous_.end())
+            {
+                return;
+            }
+
+            auto it = types_.results_.find(key);
+            if (it == types_.results_.end())
+            {
+                types_.results_.emplace(std::move(key), type);
+            }
+            else if (replace || it->second == type)
+            {
+                it->second = type;
+            }
+            else
+            {
+                types_.results_.erase(it);
+                ambiguous_.insert(std::move(key));
+            }
+        }
+
+        ///////////////////////////////////////////////////////////////////////
+        inferred_type lookup(std::string const& name) const
+        {
+            // the variable may have been modified after its definition
+            if (types_.stored_.find(name) != types_.stored_.end())
+            {
+                return inferred_type{};
+            }
+
+            for (auto it = scopes_.rbegin(); it != scopes_.rend(); ++it)
+            {
+                auto var = it->find(name);
+                if (var != it->end())
+                {
+                    return var->second;
+                }
+            }
+
+            // global variables may be modified by code compiled later on
+            auto var = types_.globals_.find(name);
+            if (var != types_.globals_.end())
+            {
+                inferred_type result = var->second;
+                result.dtype = node_data_type_unknown;
+                return result;
+            }
+
+            // predefined constants
+            if (name == "true" || name == "false")
+            {
+                return inferred_type(node_data_type_bool, 0);
+            }
+            if (name == "inf" || name == "ninf" || name == "nan" ||
+                name == "NZERO" || name == "PZERO" || name == "euler" ||
+                name == "euler_gamma" || name == "pi")
+            {
+                return inferred_type(node_data_type_double, 0);
+            }
+            return inferred_type{};
+        }
+
+        void bind(std::string const& name, inferred_type type)
+        {
+            // variables that are modified can't be assumed to keep their
+            // type, the same is true for variables defined inside loops
+            if (loop_depth_ != 0 ||
+                types_.stored_.find(name) != types_.stored_.end())
+            {
+                type = inferred_type{};
+            }
+
+            // a variable defined more than once (e.g. in both branches of
+            // an if) keeps only what all of its definitions agree on
+            scope_type& scope =
+                scopes_.empty() ? types_.globals_ : scopes_.back();
+            auto it = scope.find(name);
+            if (it != scope.end())
+            {
+                it->second = join(it->second, type);
+            }
+            else
+            {
+                scope.emplace(name, std::move(type));
+            }
+        }
+
+        ///////////////////////////////////////////////////////////////////////
+        // broadcast the shapes of the operands of an element-wise operation
+        inferred_type broadcast(std::string const& name,
+            inferred_type const& lhs, inferred_type const& rhs,
+            ast::tagged const& id) const
+        {
+            inferred_type result;
+            if (lhs.ndim == 0)
+            {
+                result = rhs;
+            }
+            else if (rhs.ndim == 0)
+            {
+                result = lhs;
+            }
+            else if (lhs.has_ndim() && rhs.has_ndim())
+            {
+                result.ndim = (std::max)(lhs.ndim, rhs.ndim);
+
+                // align trailing dimensions
+                for (std::int64_t i = 0; i != result.ndim; ++i)
+                {
+                    std::int64_t const li = lhs.ndim - result.ndim + i;
+                    std::int64_t const ri = rhs.ndim - result.ndim + i;
+
+                    std::int64_t const l = li < 0 ? 1 : lhs.dims[li];
+                    std::int64_t const r = ri < 0 ? 1 : rhs.dims[ri];
+
+                    if (l == inferred_type::unknown)
+                    {
+                        result.dims[i] = (r == 1) ? inferred_type::unknown : r;
+                    }
+                    else if (r == inferred_type::unknown)
+                    {
+                        result.dims[i] = (l == 1) ? inferred_type::unknown : l;
+                    }
+                    else if (l == r || r == 1)
+                    {
+                        result.dims[i] = l;
+                    }
+                    else if (l == 1)
+                    {
+                        result.dims[i] = r;
+                    }
+                    else
+                    {
+                        report_mismatch(name, lhs, rhs, id);
+                    }
+                }
+            }
+            result.dtype = node_data_type_unknown;
+            return result;
+        }
+
+        inferred_type elementwise(std::string const& name,
+            inferred_type const& lhs, inferred_type const& rhs,
+            ast::tagged const& id) const
+        {
+            inferred_type result = broadcast(name, lhs, rhs, id);
+            if (name == "__eq" || name == "__ne" || name == "__lt" ||
+                name == "__le" || name == "__gt" || name == "__ge")
+            {
+                result.dtype = node_data_type_bool;
+            }
+            else if (lhs.has_dtype() && rhs.has_dtype())
+            {
+                // the widest type wins, arithmetic operations on booleans
+                // and integer divisions are left to the runtime
+                node_data_type dtype = (std::min)(lhs.dtype, rhs.dtype);
+                if (dtype == node_data_type_double ||
+                    (dtype == node_data_type_int64 && name != "__div"))
+                {
+                    result.dtype = dtype;
+                }
+            }
+            return result;
+        }
+
+        static char const* operator_name(ast::optoken op)
+        {
+            switch (op)
+            {
+            case ast::optoken::op_plus:          return "__add";
+            case ast::optoken::op_minus:         return "__sub";
+            case ast::optoken::op_times:         return "__mul";
+            case ast::optoken::op_divide:        return "__div";
+            case ast::optoken::op_equal:         return "__eq";
+            case ast::optoken::op_not_equal:     return "__ne";
+            case ast::optoken::op_less:          return "__lt";
+            case ast::optoken::op_less_equal:    return "__le";
+            case ast::optoken::op_greater:       return "__gt";
+            case ast::optoken::op_greater_equal: return "__ge";
+            default:
+                break;
+            }
+            return nullptr;
+        }
+
+        ///////////////////////////////////////////////////////////////////////
+        inferred_type operator()(ast::expression const& expr)
+        {
+            inferred_type lhs = (*this)(expr.first);
+            if (expr.rest.empty())
+            {
+                return lhs;
+            }
+
+            auto it = expr.rest.begin();
+            return binary(lhs, ast::detail::tagged_id(expr.first), 0, it,
+                expr.rest.end());
+        }
+
+        // precedence climbing over the operations of an expression, chains
+        // of the same (variadic) operation map onto a single primitive
+        inferred_type binary(inferred_type lhs, ast::tagged const& id,
+            int min_precedence, std::vector<ast::operation>::const_iterator& it,
+            std::vector<ast::operation>::const_iterator end)
+        {
+            ast::optoken prev = ast::optoken::op_unknown;
+            while (it != end &&
+                ast::precedence_of(it->operator_) >= min_precedence)
+            {
+                ast::optoken const op = it->operator_;
+                int const precedence = ast::precedence_of(op);
+
+                ast::tagged const rhs_id = ast::detail::tagged_id(it->operand_);
+                inferred_type rhs = (*this)(it->operand_);
+
+                ++it;
+                while (it != end &&
+                    ast::precedence_of(it->operator_) > precedence)
+                {
+                    rhs = binary(rhs, rhs_id, precedence + 1, it, end);
+                }
+
+                char const* name = operator_name(op);
+                if (name == nullptr)
+                {
+                    lhs = inferred_type{};
+                }
+                else
+                {
+                    lhs = elementwise(name, lhs, rhs, id);
+                    record(id, name, lhs, op == prev);
+                }
+                prev = op;
+            }
+            return lhs;
+        }
+
+        inferred_type operator()(ast::operand const& op)
+        {
+            switch (op.index())
+            {
+            case 1:
+                return (*this)(util::get<1>(op.get()).get(),
+                    ast::detail::tagged_id(op));
+
+            case 2:
+                return (*this)(util::get<2>(op.get()).get());
+
+            default:
+                break;
+            }
+            return inferred_type{};
+        }
+
+        inferred_type operator()(ast::unary_expr const& ue)
+        {
+            inferred_type type = (*this)(ue.operand_);
+            switch (ue.operator_)
+            {
+            case ast::optoken::op_positive:
+                return type;
+
+            case ast::optoken::op_negative:
+                if (type.dtype == node_data_type_bool)
+                {
+                    type.dtype = node_data_type_unknown;
+                }
+                record(ast::detail::tagged_id(ue), "__minus", type);
+                return type;
+
+            default:
+                break;
+            }
+            return inferred_type{};
+        }
+
+        inferred_type operator()(
+            ast::primary_expr const& pe, ast::tagged const& id)
+        {
+            switch (pe.index())
+            {
+            case 1:     // bool
+                return inferred_type(node_data_type_bool, 0);
+
+            case 2:     // phylanx::ir::node_data<double>
+                return detail::literal_type(
+                    util::get<2>(pe.get()), node_data_type_double);
+
+            case 3:     // identifier
+                return lookup(util::get<3>(pe.get()).name);
+
+            case 5:     // phylanx::ir::node_data<std::int64_t>
+                return detail::literal_type(
+                    util::get<5>(pe.get()), node_data_type_int64);
+
+            case 6:     // expression
+                return (*this)(util::get<6>(pe.get()).get());
+
+            case 7:     // function_call
+                return (*this)(util::get<7>(pe.get()).get(), id);
+
+            case 8:     // list
+                for (auto const& expr : util::get<8>(pe.get()).get())
+                {
+                    (*this)(expr);
+                }
+                break;
+
+            default:
+                break;
+            }
+            return inferred_type{};
+        }
+
+        ///////////////////////////////////////////////////////////////////////
+        inferred_type operator()(
+            ast::function_call const& fc, ast::tagged const& id)
+        {
+            std::string const& fullname = fc.function_name.name;
+            std::vector<ast::expression> const& args = fc.args;
+
+            if (fullname == "define")
+            {
+                return handle_define(args);
+            }
+            if (fullname == "lambda")
+            {
+                return handle_function(std::string(), args, 0);
+            }
+
+            bool const is_loop = fullname == "while" || fullname == "for" ||
+                fullname == "for_each" || fullname == "parallel_map" ||
+                fullname == "fmap";
+            if (is_loop)
+            {
+                ++loop_depth_;
+            }
+
+            std::vector<inferred_type> types;
+            types.reserve(args.size());
+            for (auto const& arg : args)
+            {
+                types.push_back((*this)(arg));
+            }
+
+            if (is_loop)
+            {
+                --loop_depth_;
+                return inferred_type{};
+            }
+
+            node_data_type dtype = node_data_type_unknown;
+            std::string const name =
+                detail::extract_dtype_suffix(fullname, dtype);
+
+            inferred_type result = evaluate(name, dtype, args, types, id);
+            record(id, fullname, result);
+            return result;
+        }
+
+        inferred_type evaluate(std::string const& name, node_data_type dtype,
+            std::vector<ast::expression> const& args,
+            std::vector<inferred_type> const& types, ast::tagged const& id)
+        {
+            if (name == "__add" || name == "__sub" || name == "__mul" ||
+                name == "__div")
+            {
+                if (types.empty())
+                {
+                    return inferred_type{};
+                }
+                inferred_type result = types[0];
+                for (std::size_t i = 1; i != types.size(); ++i)
+                {
+                    result = elementwise(name, result, types[i], id);
+                }
+                return result;
+            }
+
+            if (name == "__eq" || name == "__ne" || name == "__lt" ||
+                name == "__le" || name == "__gt" || name == "__ge")
+            {
+                if (types.size() != 2)
+                {
+                    return inferred_type{};     // propagate_type given
+                }
+                return elementwise(name, types[0], types[1], id);
+            }
+
+            if (name == "__minus" && types.size() == 1)
+            {
+                inferred_type result = types[0];
+                if (result.dtype == node_data_type_bool)
+                {
+                    result.dtype = node_data_type_unknown;
+                }
+                return result;
+            }
+
+            if (name == "block" && !types.empty())
+            {
+                return types.back();
+            }
+
+            if (name == "if" && types.size() == 3)
+            {
+                return join(types[1], types[2]);
+            }
+
+            if (name == "constant" && !types.empty() && types.size() <= 2)
+            {
+                inferred_type result = types.size() == 2 ?
+                    shape_of(args[1]) :
+                    inferred_type(node_data_type_unknown,
+                        types[0].ndim == 0 ? 0 : inferred_type::unknown);
+                result.dtype = dtype != node_data_type_unknown ?
+                    dtype : types[0].dtype;
+                return result;
+            }
+
+            if (name == "random" && !types.empty() && types.size() <= 2)
+            {
+                // the distribution determines the type of the values
+                inferred_type result = shape_of(args[0]);
+                if (types.size() == 1)
+                {
+                    result.dtype = node_data_type_double;
+                }
+                return result;
+            }
+
+            if (name == "dot" && (types.size() == 2 || types.size() == 3))
+            {
+                return dot(name, types[0], types[1], id);
+            }
+
+            if (name == "transpose" && types.size() == 1)
+            {
+                inferred_type result = types[0];
+                std::reverse(&result.dims[0],
+                    &result.dims[0] + (std::max)(result.ndim, std::int64_t(0)));
+                return result;
+            }
+
+            return inferred_type{};
+        }
+
+        // the shape specification of constant() and random()
+        inferred_type shape_of(ast::expression const& expr) const
+        {
+            inferred_type result;
+
+            std::int64_t value = 0;
+            if (detail::extract_integer_literal(expr, value))
+            {
+                result.ndim = 1;
+                result.dims[0] = value;
+                return result;
+            }
+
+            std::vector<ast::expression> elements;
+            if (expr.rest.empty() && expr.first.index() == 1)
+            {
+                ast::primary_expr const& pe =
+                    util::get<1>(expr.first.get()).get();
+                if (pe.index() == 8)
+                {
+                    elements = util::get<8>(pe.get()).get();
+                }
+                else if (pe.index() == 7)
+                {
+                    auto const& fc = util::get<7>(pe.get()).get();
+                    if (fc.function_name.name != "list" &&
+                        fc.function_name.name != "make_list")
+                    {
+                        return result;
+                    }
+                    elements = fc.args;
+                }
+                else
+                {
+                    return result;
+                }
+            }
+
+            if (elements.empty() || elements.size() > PHYLANX_MAX_DIMENSIONS)
+            {
+                return result;
+            }
+
+            for (std::size_t i = 0; i != elements.size(); ++i)
+            {
+                if (!detail::extract_integer_literal(elements[i], value))
+                {
+                    return inferred_type{};
+                }
+                result.dims[i] = value;
+            }
+            result.ndim = std::int64_t(elements.size());
+            return result;
+        }
+
+        inferred_type dot(std::string const& name, inferred_type const& lhs,
+            inferred_type const& rhs, ast::tagged const& id) const
+        {
+            inferred_type result;
+            if (lhs.has_dtype() && rhs.has_dtype())
+            {
+                node_data_type dtype = (std::min)(lhs.dtype, rhs.dtype);
+                if (dtype != node_data_type_bool)
+                {
+                    result.dtype = dtype;
+                }
+            }
+
+            if (lhs.ndim == 0 || rhs.ndim == 0)
+            {
+                result.ndim = lhs.ndim == 0 ? rhs.ndim : lhs.ndim;
+                result.dims = lhs.ndim == 0 ? rhs.dims : lhs.dims;
+                return result;
+            }
+
+            if (!lhs.has_ndim() || !rhs.has_ndim() || lhs.ndim > 2 ||
+                rhs.ndim > 2)
+            {
+                return result;
+            }
+
+            // the contracted dimensions have to match
+            std::int64_t const l = lhs.dims[lhs.ndim - 1];
+            std::int64_t const r = rhs.dims[0];
+            if (l != inferred_type::unknown && r != inferred_type::unknown &&
+                l != r)
+            {
+                report_mismatch(name, lhs, rhs, id);
+            }
+
+            result.ndim = lhs.ndim + rhs.ndim - 2;
+            if (lhs.ndim == 2)
+            {
+                result.dims[0] = lhs.dims[0];
+            }
+            if (rhs.ndim == 2)
+            {
+                result.dims[result.ndim - 1] = rhs.dims[1];
+            }
+            return result;
+        }
+
+        ///////////////////////////////////////////////////////////////////////
+        inferred_type handle_define(std::vector<ast::expression> const& args)
+        {
+            if (args.size() < 2 || !ast::detail::is_identifier(args[0]))
+            {
+                for (auto const& arg : args)
+                {
+                    (*this)(arg);
+                }
+                return inferred_type{};
+            }
+
+            std::string const name = ast::detail::identifier_name(args[0]);
+            if (args.size() == 2)
+            {
+                // variable definition
+                bind(name, (*this)(args[1]));
+                return inferred_type{};
+            }
+
+            // function definition, the function can be invoked recursively
+            bind(name, inferred_type{});
+            return handle_function(name, args, 1);
+        }
+
+        inferred_type handle_function(std::string const& name,
+            std::vector<ast::expression> const& args, std::size_t first)
+        {
+            if (args.size() <= first)
+            {
+                return inferred_type{};
+            }
+
+            std::vector<inferred_type> const* annotations = nullptr;
+            if (!name.empty())
+            {
+                auto it = types_.annotations_.find(name);
+                if (it != types_.annotations_.end() &&
+                    it->second.size() == args.size() - first - 1)
+                {
+                    annotations = &it->second;
+                }
+            }
+
+            // the body of a function is executed in its own scope, its
+            // arguments are unknown unless annotated
+            scopes_.emplace_back();
+
+            std::size_t const saved_loop_depth = loop_depth_;
+            loop_depth_ = 0;
+
+            for (std::size_t i = first; i != args.size() - 1; ++i)
+            {
+                std::string argname;
+                if (ast::detail::is_identifier(args[i]))
+                {
+                    argname = ast::detail::identifier_name(args[i]);
+                }
+                else if (ast::detail::is_function_call(args[i]) &&
+                    ast::detail::function_name(args[i]) == "__arg")
+                {
+                    auto fargs = ast::detail::function_arguments(args[i]);
+                    if (!fargs.empty() && ast::detail::is_identifier(fargs[0]))
+                    {
+                        argname = ast::detail::identifier_name(fargs[0]);
+                    }
+                }
+
+                if (!argname.empty())
+                {
+                    bind(argname, annotations != nullptr ?
+                        (*annotations)[i - first] : inferred_type{});
+                }
+            }
+
+            (*this)(args.back());
+
+            loop_depth_ = saved_loop_depth;
+            scopes_.pop_back();
+
+            return inferred_type{};
+        }
+
+        type_inference& types_;
+        std::string const& codename_;
+        std::vector<scope_type> scopes_;
+        std::set<type_inference::key_type> ambiguous_;
+        std::size_t loop_depth_;
+    };
+
+    ///////////////////////////////////////////////////////////////////////////
+    void type_inference::annotate(
+        std::string const& function_name, std::vector<inferred_type> args)
+    {
+        annotations_[function_name] = std::move(args);
+    }
+
+    void type_inference::clear_annotations()
+    {
+        annotations_.clear();
+    }
+
+    void type_inference::prescan(ast::expression const& expr)
+    {
+        detail::store_target_collector{stored_}(expr);
+    }
+
+    void type_inference::prescan(std::vector<ast::expression> const& exprs)
+    {
+        detail::store_target_collector collect{stored_};
+        for (auto const& expr : exprs)
+        {
+            collect(expr);
+        }
+    }
+
+    // all nodes of the flat encoding are visited in the order they are
+    // stored in, there is no need to expand the expressions
+    void type_inference::prescan(ast::flat_ast const& flat)
+    {
+        using node_kind = ast::flat_ast::node_kind;
+
+        for (std::uint32_t i = 0; i != flat.node_count(); ++i)
+        {
+            auto const& n = flat.get_node(i);
+            if (n.kind != node_kind::function_call || n.child_count == 0 ||
+                !flat.string_equals(n.value, "store"))
+            {
+                continue;
+            }
+
+            // the first argument must be an expression consisting of an
+            // identifier only
+            auto const& arg = flat.child(n, 0);
+            if (arg.kind != node_kind::expression || arg.child_count != 1)
+            {
+                continue;
+            }
+
+            auto const& target = flat.child(arg, 0);
+            if (target.kind == node_kind::identifier)
+            {
+                std::string name = flat.get_string(target.value);
+                if (!name.empty())
+                {
+                    stored_.insert(std::move(name));
+                }
+            }
+        }
+    }
+
+    inferred_type type_inference::infer(std::string const& codename,
+        ast::expression const& expr, std::size_t compile_id)
+    {
+        prescan(expr);
+
+        results_.clear();
+
+        inference_visitor visitor(*this, codename);
+        inferred_type result = visitor(expr);
+
+        for (auto it = results_.begin(); it != results_.end(); /**/)
+        {
+            if (it->second.is_unknown())
+            {
+                it = results_.erase(it);
+            }
+            else
+            {
+                ++it;
+            }
+        }
+
+        compile_id_ = compile_id;
+        return result;
+    }
+
+    node_data_type type_inference::operation_dtype(std::size_t compile_id,
+        ast::tagged const& id, std::string const& name) const
+    {
+        // the results of another expression can't be used
+        if (compile_id != compile_id_)
+        {
+            return node_data_type_unknown;
+        }
+
+        // the result of these operations has the dtype the operation is
+        // performed in
+        if (name != "__add" && name != "__sub" && name != "__mul" &&
+            name != "__div" && name != "__minus")
+        {
+            return node_data_type_unknown;
+        }
+
+        auto it = results_.find(key_type{id.id, id.col, name});
+        if (it == results_.end())
+        {
+            return node_data_type_unknown;
+        }
+        return it->second.dtype;
+    }
+}}}
@@ -138,6 +138,9 @@ namespace phylanx { namespace execution_tree
                 PHYLANX_MATCH_DATA(format_string),
                 PHYLANX_MATCH_DATA(string_output),
                 PHYLANX_MATCH_DATA(assert_condition),
+                PHYLANX_MATCH_DATA_VERBATIM(trace_operation::match_data[0]),
+                PHYLANX_MATCH_DATA_VERBATIM(trace_operation::match_data[1]),
+                PHYLANX_MATCH_DATA_VERBATIM(trace_operation::match_data[2]),
 
                 // special purpose primitives
                 PHYLANX_MATCH_DATA(store_operation),
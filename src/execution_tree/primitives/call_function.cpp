@@ -119,6 +119,7 @@ namespace phylanx { namespace execution_tree { namespace primitives
         }
 
         operands_[0] = extract_copy_value(std::move(data[0]), name_, codename_);
+        update_memory_usage();
     }
 
     topology call_function::expression_topology(
@@ -118,6 +118,7 @@ namespace phylanx { namespace execution_tree { namespace primitives
 
         operands_[0] = extract_copy_value(std::move(data), name_, codename_);
         value_set_ = true;
+        update_memory_usage();
     }
 
     topology function::expression_topology(std::set<std::string>&& functions,
@@ -144,6 +144,7 @@ namespace phylanx { namespace execution_tree { namespace primitives
         {
             operands_[0] = std::move(data[0]);
         }
+        update_memory_usage();
     }
 
     topology lambda::expression_topology(std::set<std::string>&& functions,
@@ -50,7 +50,8 @@ namespace phylanx { namespace execution_tree
             name = std::move(name_parts.primitive);
         }
 
-        auto p = name.find("__");
+        // skip the leading underscores of the internal operators (__add)
+        auto p = name.find("__", 1);
         if (p != std::string::npos)
         {
             return map_dtype(std::string(&name[p + 2], name.size() - p - 2));
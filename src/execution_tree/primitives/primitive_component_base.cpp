@@ -7,9 +7,13 @@
 #include <phylanx/execution_tree/compiler/primitive_name.hpp>
 #include <phylanx/execution_tree/primitives/base_primitive.hpp>
 #include <phylanx/execution_tree/primitives/primitive_component_base.hpp>
+#include <phylanx/execution_tree/primitives/primitive_registry.hpp>
+#include <phylanx/ir/node_data.hpp>
 #include <phylanx/util/scoped_timer.hpp>
+#include <phylanx/util/tracer.hpp>
 
 #include <hpx/include/lcos.hpp>
+#include <hpx/include/runtime.hpp>
 #include <hpx/include/util.hpp>
 #include <hpx/runtime/config_entry.hpp>
 #include <hpx/runtime/launch_policy.hpp>
@@ -44,6 +48,26 @@ namespace phylanx { namespace execution_tree { namespace primitives
 #if defined(HPX_HAVE_APEX)
         eval_name_ = name_ + "::eval";
 #endif
+
+        update_memory_usage();
+
+        // register this instance with the primitive registry of this
+        // locality, unnamed primitives are not registered
+        compiler::primitive_name_parts name_parts;
+        if (!name_.empty() && compiler::parse_primitive_name(name_, name_parts))
+        {
+            sequence_number_ = name_parts.sequence_number;
+            type_data_ = &get_primitive_type_data(name_parts.primitive);
+            type_data_->add_instance(sequence_number_, this);
+        }
+    }
+
+    primitive_component_base::~primitive_component_base()
+    {
+        if (type_data_ != nullptr)
+        {
+            type_data_->remove_instance(sequence_number_, this);
+        }
     }
 
     namespace detail
@@ -60,6 +84,131 @@ namespace phylanx { namespace execution_tree { namespace primitives
 
             T t_;
         };
+
+        ///////////////////////////////////////////////////////////////////////
+        template <typename T>
+        void trace_node_data(ir::node_data<T> const& data,
+            util::trace_shape& shape)
+        {
+            auto const dims = data.dimensions();
+            shape.num_dimensions = std::int32_t(data.num_dimensions());
+            for (std::int32_t i = 0; i != shape.num_dimensions; ++i)
+            {
+                shape.dimensions[i] = std::uint32_t(dims[i]);
+            }
+            shape.bytes = data.size() * sizeof(T);
+        }
+
+        void record_shape(primitive_argument_type const& value,
+            util::trace_shape& shape)
+        {
+            switch (value.index())
+            {
+            case 1:     // ir::node_data<std::uint8_t>
+                trace_node_data(util::get<1>(value), shape);
+                break;
+
+            case 2:     // ir::node_data<std::int64_t>
+                trace_node_data(util::get<2>(value), shape);
+                break;
+
+            case 4:     // ir::node_data<double>
+                trace_node_data(util::get<4>(value), shape);
+                break;
+
+            default:
+                break;
+            }
+        }
+
+        // Tracing records the shapes of the (already evaluated) arguments
+        // passed to eval and the shape of the result.
+        util::trace_event begin_trace_event(std::uint32_t name,
+            primitive_argument_type const* params, std::size_t count)
+        {
+            util::trace_event event;
+            event.name = name;
+            event.thread = std::uint32_t(hpx::get_worker_thread_num());
+            event.num_inputs = std::uint32_t(count);
+
+            for (std::size_t i = 0; i != count; ++i)
+            {
+                util::trace_shape shape;
+                record_shape(params[i], shape);
+                event.input_bytes += shape.bytes;
+                if (i < event.inputs.size())
+                {
+                    event.inputs[i] = shape;
+                }
+            }
+
+            event.begin = hpx::util::high_resolution_clock::now();
+            return event;
+        }
+
+        hpx::future<primitive_argument_type> end_trace_event(
+            util::trace_event&& event,
+            hpx::future<primitive_argument_type>&& f)
+        {
+            return f.then(hpx::launch::sync,
+                [event = std::move(event)](
+                    hpx::future<primitive_argument_type>&& f) mutable
+                -> primitive_argument_type
+                {
+                    event.end = hpx::util::high_resolution_clock::now();
+                    if (f.has_exception())
+                    {
+                        util::record_trace_event(event);
+                        return f.get();         // rethrow exception
+                    }
+
+                    primitive_argument_type result = f.get();
+                    record_shape(result, event.result);
+                    util::record_trace_event(event);
+                    return result;
+                });
+        }
+
+        ///////////////////////////////////////////////////////////////////////
+        // add the duration and the result size of the evaluation to the
+        // statistics of the type of the evaluated primitive
+        hpx::future<primitive_argument_type> record_statistics(
+            primitive_type_data& data, std::uint64_t started_at,
+            hpx::future<primitive_argument_type>&& f)
+        {
+            return f.then(hpx::launch::sync,
+                [&data, started_at](hpx::future<primitive_argument_type>&& f)
+                -> primitive_argument_type
+                {
+                    std::int64_t const duration =
+                        hpx::util::high_resolution_clock::now() - started_at;
+                    if (f.has_exception())
+                    {
+                        data.record_eval(duration, 0);
+                        return f.get();         // rethrow exception
+                    }
+
+                    primitive_argument_type result = f.get();
+
+                    util::trace_shape shape;
+                    record_shape(result, shape);
+                    data.record_eval(duration, std::int64_t(shape.bytes));
+
+                    return result;
+                });
+        }
+    }
+
+    std::uint32_t primitive_component_base::trace_name() const
+    {
+        std::int64_t const name =
+            trace_name_.load(std::memory_order_relaxed);
+        if (name != -1)
+        {
+            return std::uint32_t(name);
+        }
+        return util::register_trace_name(trace_name_,
+            compiler::extract_primitive_name(name_), name_);
     }
 
     std::string primitive_component_base::extract_function_name(
@@ -101,7 +250,12 @@ namespace phylanx { namespace execution_tree { namespace primitives
 #endif
 
         // perform measurements only when needed
-        bool enable_timer = measurements_enabled_ || (execute_directly_ == -1);
+        bool const collect_statistics = type_data_ != nullptr &&
+            (measurements_enabled_ || type_data_->measurements_enabled());
+        bool enable_timer = collect_statistics || measurements_enabled_ ||
+            (execute_directly_ == -1);
+        std::uint64_t const started_at = collect_statistics ?
+            hpx::util::high_resolution_clock::now() : 0;
 
         util::scoped_timer<std::int64_t> timer(eval_duration_, enable_timer);
         if (enable_timer)
@@ -109,7 +263,18 @@ namespace phylanx { namespace execution_tree { namespace primitives
             ++eval_count_;
         }
 
-        auto f = this->eval(params, std::move(ctx));
+        hpx::future<primitive_argument_type> f;
+        if (util::tracing_enabled())
+        {
+            auto event = detail::begin_trace_event(
+                trace_name(), params.data(), params.size());
+            f = detail::end_trace_event(
+                std::move(event), this->eval(params, std::move(ctx)));
+        }
+        else
+        {
+            f = this->eval(params, std::move(ctx));
+        }
 
         if (enable_timer && !f.is_ready())
         {
@@ -122,6 +287,11 @@ namespace phylanx { namespace execution_tree { namespace primitives
             state->set_on_completed(keep_alive(std::move(timer)));
         }
 
+        if (collect_statistics)
+        {
+            return detail::record_statistics(
+                *type_data_, started_at, std::move(f));
+        }
         return f;
     }
 
@@ -133,7 +303,12 @@ namespace phylanx { namespace execution_tree { namespace primitives
 #endif
 
         // perform measurements only when needed
-        bool enable_timer = measurements_enabled_ || (execute_directly_ == -1);
+        bool const collect_statistics = type_data_ != nullptr &&
+            (measurements_enabled_ || type_data_->measurements_enabled());
+        bool enable_timer = collect_statistics || measurements_enabled_ ||
+            (execute_directly_ == -1);
+        std::uint64_t const started_at = collect_statistics ?
+            hpx::util::high_resolution_clock::now() : 0;
 
         util::scoped_timer<std::int64_t> timer(eval_duration_, enable_timer);
         if (enable_timer)
@@ -141,7 +316,17 @@ namespace phylanx { namespace execution_tree { namespace primitives
             ++eval_count_;
         }
 
-        auto f = this->eval(std::move(param), std::move(ctx));
+        hpx::future<primitive_argument_type> f;
+        if (util::tracing_enabled())
+        {
+            auto event = detail::begin_trace_event(trace_name(), &param, 1);
+            f = detail::end_trace_event(std::move(event),
+                this->eval(std::move(param), std::move(ctx)));
+        }
+        else
+        {
+            f = this->eval(std::move(param), std::move(ctx));
+        }
 
         if (enable_timer && !f.is_ready())
         {
@@ -154,6 +339,11 @@ namespace phylanx { namespace execution_tree { namespace primitives
             state->set_on_completed(keep_alive(std::move(timer)));
         }
 
+        if (collect_statistics)
+        {
+            return detail::record_statistics(
+                *type_data_, started_at, std::move(f));
+        }
         return f;
     }
 
@@ -287,6 +477,42 @@ namespace phylanx { namespace execution_tree { namespace primitives
         return hpx::util::get_and_reset_value(execute_directly_, reset);
     }
 
+    std::int64_t primitive_component_base::get_memory_usage() const
+    {
+        return memory_usage_.load(std::memory_order_relaxed);
+    }
+
+    void primitive_component_base::update_memory_usage(
+        std::int64_t extra_bytes) const
+    {
+        std::int64_t bytes = extra_bytes;
+        for (auto const& operand : operands_)
+        {
+            bytes += owned_bytes(operand);
+        }
+        memory_usage_.store(bytes, std::memory_order_relaxed);
+    }
+
+    std::int64_t primitive_component_base::owned_bytes(
+        primitive_argument_type const& value)
+    {
+        switch (value.index())
+        {
+        case 1:     // ir::node_data<std::uint8_t>
+            return util::get<1>(value).owned_bytes();
+
+        case 2:     // ir::node_data<std::int64_t>
+            return util::get<2>(value).owned_bytes();
+
+        case 4:     // ir::node_data<double>
+            return util::get<4>(value).owned_bytes();
+
+        default:
+            break;
+        }
+        return 0;
+    }
+
     void primitive_component_base::enable_measurements()
     {
         measurements_enabled_ = true;
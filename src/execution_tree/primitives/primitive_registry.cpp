@@ -0,0 +1,337 @@
+//  Copyright (c) 2019 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <phylanx/config.hpp>
+#include <phylanx/execution_tree/compiler/primitive_name.hpp>
+#include <phylanx/execution_tree/primitives/primitive_component_base.hpp>
+#include <phylanx/execution_tree/primitives/primitive_registry.hpp>
+
+#include <hpx/lcos/local/spinlock.hpp>
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace phylanx { namespace execution_tree { namespace primitives
+{
+    ///////////////////////////////////////////////////////////////////////////
+    std::vector<std::int64_t> primitive_type_statistics::values() const
+    {
+        std::vector<std::int64_t> result{instances, eval_count,
+            eval_duration, min_duration, max_duration, result_bytes};
+        result.insert(result.end(), histogram.begin(), histogram.end());
+        return result;
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    namespace detail
+    {
+        std::size_t duration_bucket(std::int64_t duration)
+        {
+            std::size_t bucket = 0;
+            for (std::uint64_t d = std::uint64_t(duration) >> 10; d != 0;
+                 d >>= 1)
+            {
+                ++bucket;
+            }
+            return bucket < primitive_duration_buckets ?
+                bucket : primitive_duration_buckets - 1;
+        }
+
+        void update_min(std::atomic<std::int64_t>& value, std::int64_t v)
+        {
+            std::int64_t current = value.load(std::memory_order_relaxed);
+            while (v < current &&
+                !value.compare_exchange_weak(
+                    current, v, std::memory_order_relaxed))
+            {
+            }
+        }
+
+        void update_max(std::atomic<std::int64_t>& value, std::int64_t v)
+        {
+            std::int64_t current = value.load(std::memory_order_relaxed);
+            while (v > current &&
+                !value.compare_exchange_weak(
+                    current, v, std::memory_order_relaxed))
+            {
+            }
+        }
+
+        constexpr std::int64_t no_min_duration =
+            (std::numeric_limits<std::int64_t>::max)();
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    primitive_type_data::primitive_type_data(std::string const& type)
+      : type_(type)
+      , measurements_enabled_(false)
+      , eval_count_(0)
+      , eval_duration_(0)
+      , min_duration_(detail::no_min_duration)
+      , max_duration_(0)
+      , result_bytes_(0)
+    {
+        for (auto& bucket : histogram_)
+        {
+            bucket.store(0, std::memory_order_relaxed);
+        }
+    }
+
+    void primitive_type_data::enable_measurements()
+    {
+        measurements_enabled_.store(true, std::memory_order_relaxed);
+    }
+
+    void primitive_type_data::record_eval(
+        std::int64_t duration, std::int64_t result_bytes)
+    {
+        eval_count_.fetch_add(1, std::memory_order_relaxed);
+        eval_duration_.fetch_add(duration, std::memory_order_relaxed);
+        result_bytes_.fetch_add(result_bytes, std::memory_order_relaxed);
+
+        detail::update_min(min_duration_, duration);
+        detail::update_max(max_duration_, duration);
+
+        histogram_[detail::duration_bucket(duration)].fetch_add(
+            1, std::memory_order_relaxed);
+    }
+
+    primitive_type_statistics primitive_type_data::statistics(bool reset)
+    {
+        primitive_type_statistics result;
+
+        {
+            std::lock_guard<mutex_type> l(mtx_);
+            result.instances = std::int64_t(instances_.size());
+        }
+
+        if (reset)
+        {
+            result.eval_count = eval_count_.exchange(0);
+            result.eval_duration = eval_duration_.exchange(0);
+            result.min_duration =
+                min_duration_.exchange(detail::no_min_duration);
+            result.max_duration = max_duration_.exchange(0);
+            result.result_bytes = result_bytes_.exchange(0);
+            for (std::size_t i = 0; i != primitive_duration_buckets; ++i)
+            {
+                result.histogram[i] = histogram_[i].exchange(0);
+            }
+        }
+        else
+        {
+            result.eval_count = eval_count_.load();
+            result.eval_duration = eval_duration_.load();
+            result.min_duration = min_duration_.load();
+            result.max_duration = max_duration_.load();
+            result.result_bytes = result_bytes_.load();
+            for (std::size_t i = 0; i != primitive_duration_buckets; ++i)
+            {
+                result.histogram[i] = histogram_[i].load();
+            }
+        }
+
+        if (result.min_duration == detail::no_min_duration)
+        {
+            result.min_duration = 0;
+        }
+        return result;
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    // Instances are removed by the destructor of primitive_component_base,
+    // so only data held by the base class may be accessed here (no virtual
+    // functions), the derived part of the instance may be destroyed already.
+    std::int64_t primitive_type_data::instance_value(
+        primitive_component_base const* instance, instance_counter counter,
+        bool reset)
+    {
+        switch (counter)
+        {
+        case eval_count:
+            return instance->get_eval_count(reset);
+
+        case eval_duration:
+            return instance->get_eval_duration(reset);
+
+        case direct_execution:
+            return instance->get_direct_execution(reset);
+
+        case memory_usage:
+            return instance->get_memory_usage();
+
+        default:
+            break;
+        }
+        return 0;
+    }
+
+    std::vector<std::int64_t> primitive_type_data::instance_values(
+        instance_counter counter, bool reset) const
+    {
+        std::vector<std::int64_t> result;
+
+        std::lock_guard<mutex_type> l(mtx_);
+        result.reserve(instances_.size());
+        for (auto const& instance : instances_)
+        {
+            result.push_back(
+                instance_value(instance.second, counter, reset));
+        }
+        return result;
+    }
+
+    bool primitive_type_data::instance_values(std::string const& name,
+        std::vector<instance_counter> const& counters,
+        std::vector<std::int64_t>& values) const
+    {
+        compiler::primitive_name_parts name_parts;
+        if (!compiler::parse_primitive_name(name, name_parts))
+        {
+            return false;
+        }
+
+        std::lock_guard<mutex_type> l(mtx_);
+
+        auto it = instances_.find(
+            instance_key(name_parts.sequence_number, name));
+        if (it == instances_.end())
+        {
+            return false;
+        }
+
+        values.clear();
+        values.reserve(counters.size());
+        for (auto counter : counters)
+        {
+            values.push_back(
+                instance_value(it->second, counter, false));
+        }
+        return true;
+    }
+
+    std::vector<primitive_type_data::instance_entry>
+    primitive_type_data::instances(
+        std::vector<instance_counter> const& counters, bool reset) const
+    {
+        std::vector<instance_entry> result;
+
+        std::lock_guard<mutex_type> l(mtx_);
+        result.reserve(instances_.size());
+        for (auto const& instance : instances_)
+        {
+            std::vector<std::int64_t> values;
+            values.reserve(counters.size());
+            for (auto counter : counters)
+            {
+                values.push_back(
+                    instance_value(instance.second, counter, reset));
+            }
+            result.emplace_back(instance.first.second, std::move(values));
+        }
+        return result;
+    }
+
+    void primitive_type_data::add_instance(std::int64_t sequence_number,
+        primitive_component_base const* instance)
+    {
+        std::lock_guard<mutex_type> l(mtx_);
+        instances_.emplace(
+            instance_key(sequence_number, instance->name_), instance);
+    }
+
+    void primitive_type_data::remove_instance(std::int64_t sequence_number,
+        primitive_component_base const* instance)
+    {
+        std::lock_guard<mutex_type> l(mtx_);
+
+        auto r = instances_.equal_range(
+            instance_key(sequence_number, instance->name_));
+        for (auto it = r.first; it != r.second; ++it)
+        {
+            if (it->second == instance)
+            {
+                instances_.erase(it);
+                break;
+            }
+        }
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    namespace detail
+    {
+        struct primitive_registry
+        {
+            using mutex_type = hpx::lcos::local::spinlock;
+
+            mutex_type mtx_;
+            std::map<std::string, std::unique_ptr<primitive_type_data>>
+                types_;
+        };
+
+        primitive_registry& get_primitive_registry()
+        {
+            static primitive_registry registry;
+            return registry;
+        }
+    }
+
+    primitive_type_data& get_primitive_type_data(std::string const& type)
+    {
+        auto& registry = detail::get_primitive_registry();
+
+        std::lock_guard<detail::primitive_registry::mutex_type> l(
+            registry.mtx_);
+
+        auto it = registry.types_.find(type);
+        if (it == registry.types_.end())
+        {
+            it = registry.types_
+                     .emplace(type, std::unique_ptr<primitive_type_data>(
+                                        new primitive_type_data(type)))
+                     .first;
+        }
+        return *it->second;
+    }
+
+    primitive_type_data* find_primitive_type_data(std::string const& type)
+    {
+        auto& registry = detail::get_primitive_registry();
+
+        std::lock_guard<detail::primitive_registry::mutex_type> l(
+            registry.mtx_);
+
+        auto it = registry.types_.find(type);
+        if (it == registry.types_.end())
+        {
+            return nullptr;
+        }
+        return it->second.get();
+    }
+
+    std::vector<primitive_type_data*> all_primitive_type_data()
+    {
+        auto& registry = detail::get_primitive_registry();
+
+        std::lock_guard<detail::primitive_registry::mutex_type> l(
+            registry.mtx_);
+
+        std::vector<primitive_type_data*> result;
+        result.reserve(registry.types_.size());
+        for (auto const& type : registry.types_)
+        {
+            result.push_back(type.second.get());
+        }
+        return result;
+    }
+}}}
@@ -0,0 +1,176 @@
+//  Copyright (c) 2019 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <phylanx/config.hpp>
+#include <phylanx/execution_tree/compiler/primitive_name.hpp>
+#include <phylanx/execution_tree/primitives/trace_operation.hpp>
+#include <phylanx/util/tracer.hpp>
+
+#include <hpx/include/lcos.hpp>
+#include <hpx/include/naming.hpp>
+#include <hpx/include/util.hpp>
+#include <hpx/throw_exception.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+///////////////////////////////////////////////////////////////////////////////
+namespace phylanx { namespace execution_tree { namespace primitives
+{
+    ///////////////////////////////////////////////////////////////////////////
+    primitive create_start_trace(hpx::id_type const& locality,
+        primitive_arguments_type&& operands,
+        std::string const& name, std::string const& codename)
+    {
+        static std::string type("start_trace");
+        return create_primitive_component(
+            locality, type, std::move(operands), name, codename);
+    }
+
+    primitive create_stop_trace(hpx::id_type const& locality,
+        primitive_arguments_type&& operands,
+        std::string const& name, std::string const& codename)
+    {
+        static std::string type("stop_trace");
+        return create_primitive_component(
+            locality, type, std::move(operands), name, codename);
+    }
+
+    primitive create_dump_trace(hpx::id_type const& locality,
+        primitive_arguments_type&& operands,
+        std::string const& name, std::string const& codename)
+    {
+        static std::string type("dump_trace");
+        return create_primitive_component(
+            locality, type, std::move(operands), name, codename);
+    }
+
+    std::vector<match_pattern_type> const trace_operation::match_data =
+    {
+        hpx::util::make_tuple("start_trace",
+            std::vector<std::string>{"start_trace()"},
+            &create_start_trace, &create_primitive<trace_operation>,
+            R"(
+            Args:
+
+            Returns:
+
+            Start recording the evaluations of all primitives, this discards
+            all previously recorded events.)"
+            ),
+
+        hpx::util::make_tuple("stop_trace",
+            std::vector<std::string>{"stop_trace()"},
+            &create_stop_trace, &create_primitive<trace_operation>,
+            R"(
+            Args:
+
+            Returns:
+
+            Stop recording the evaluations of primitives, the recorded events
+            are kept.)"
+            ),
+
+        hpx::util::make_tuple("dump_trace",
+            std::vector<std::string>{"dump_trace(_1)"},
+            &create_dump_trace, &create_primitive<trace_operation>,
+            R"(filename
+            Args:
+
+                filename (string) : the name of the file to write the recorded
+                    events to
+
+            Returns:
+
+            The number of written events. The file uses the Chrome trace
+            event format, it can be loaded by chrome://tracing or by the
+            Perfetto UI.)"
+            )
+    };
+
+    ///////////////////////////////////////////////////////////////////////////
+    namespace detail
+    {
+        trace_operation::trace_mode extract_trace_mode(std::string const& name)
+        {
+            compiler::primitive_name_parts name_parts;
+            if (!compiler::parse_primitive_name(name, name_parts))
+            {
+                if (name.find("dump_trace") != std::string::npos)
+                {
+                    return trace_operation::trace_dump;
+                }
+                if (name.find("stop_trace") != std::string::npos)
+                {
+                    return trace_operation::trace_stop;
+                }
+                return trace_operation::trace_start;
+            }
+
+            if (name_parts.primitive == "dump_trace")
+            {
+                return trace_operation::trace_dump;
+            }
+            if (name_parts.primitive == "stop_trace")
+            {
+                return trace_operation::trace_stop;
+            }
+            return trace_operation::trace_start;
+        }
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    trace_operation::trace_operation(
+            primitive_arguments_type && operands,
+            std::string const& name, std::string const& codename)
+      : primitive_component_base(std::move(operands), name, codename)
+      , mode_(detail::extract_trace_mode(name_))
+    {}
+
+    hpx::future<primitive_argument_type> trace_operation::eval(
+        primitive_arguments_type const& operands,
+        primitive_arguments_type const& args, eval_context ctx) const
+    {
+        if (mode_ != trace_dump)
+        {
+            if (!operands.empty())
+            {
+                HPX_THROW_EXCEPTION(hpx::bad_parameter,
+                    "trace_operation::eval",
+                    generate_error_message("expected no arguments"));
+            }
+
+            if (mode_ == trace_start)
+            {
+                util::start_trace();
+            }
+            else
+            {
+                util::stop_trace();
+            }
+            return hpx::make_ready_future(primitive_argument_type{});
+        }
+
+        if (operands.size() != 1 || !valid(operands[0]))
+        {
+            HPX_THROW_EXCEPTION(hpx::bad_parameter,
+                "trace_operation::eval",
+                generate_error_message(
+                    "the dump_trace primitive requires exactly one valid "
+                        "argument (the file name)"));
+        }
+
+        std::string filename = string_operand_sync(
+            operands[0], args, name_, codename_, std::move(ctx));
+
+        std::size_t const count = util::dump_trace(filename);
+        return hpx::make_ready_future(
+            primitive_argument_type{std::int64_t(count)});
+    }
+}}}
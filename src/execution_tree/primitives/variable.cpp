@@ -14,6 +14,7 @@
 #include <hpx/util/unlock_guard.hpp>
 
 #include <cstddef>
+#include <cstdint>
 #include <memory>
 #include <mutex>
 #include <set>
@@ -67,6 +68,7 @@ namespace phylanx { namespace execution_tree { namespace primitives
             operands_[0] =
                 extract_copy_value(std::move(operands_[0]), name_, codename_);
             value_set_ = true;
+            update_memory_usage();
         }
     }
 
@@ -166,6 +168,7 @@ namespace phylanx { namespace execution_tree { namespace primitives
         {
             bound_value_ = extract_ref_value(operands_[0], name_, codename_);
         }
+        update_memory_usage(owned_bytes(bound_value_));
 
         return true;
     }
@@ -187,6 +190,7 @@ namespace phylanx { namespace execution_tree { namespace primitives
                 codename_, std::move(ctx)),
             std::move(data[0]), name_, codename_);
         bound_value_ = std::move(result);
+        update_memory_usage(owned_bytes(bound_value_));
     }
 
     void variable::store2dslice(primitive_arguments_type&& data,
@@ -208,6 +212,7 @@ namespace phylanx { namespace execution_tree { namespace primitives
                 data[2], std::move(params), name_, codename_, std::move(ctx)),
             std::move(data[0]), name_, codename_);
         bound_value_ = std::move(result);
+        update_memory_usage(owned_bytes(bound_value_));
     }
 
 #if defined(PHYLANX_HAVE_BLAZE_TENSOR)
@@ -231,6 +236,7 @@ namespace phylanx { namespace execution_tree { namespace primitives
                     std::move(ctx)),
                 std::move(data[0]), name_, codename_);
         bound_value_ = std::move(result);
+        update_memory_usage(owned_bytes(bound_value_));
     }
 #endif
 
@@ -263,6 +269,7 @@ namespace phylanx { namespace execution_tree { namespace primitives
             operands_[0] =
                 extract_copy_value(std::move(data[0]), name_, codename_);
             value_set_ = true;
+            update_memory_usage(owned_bytes(bound_value_));
         }
         else
         {
@@ -271,6 +278,7 @@ namespace phylanx { namespace execution_tree { namespace primitives
             case 1:
                 bound_value_ =
                     extract_copy_value(std::move(data[0]), name_, codename_);
+                update_memory_usage(owned_bytes(bound_value_));
                 return;
 
             case 2:
@@ -332,6 +340,7 @@ namespace phylanx { namespace execution_tree { namespace primitives
             bound_value_ =
                 extract_copy_value(std::move(data), name_, codename_);
         }
+        update_memory_usage(owned_bytes(bound_value_));
     }
 
     ///////////////////////////////////////////////////////////////////////////
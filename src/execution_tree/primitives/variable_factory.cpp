@@ -83,6 +83,7 @@ namespace phylanx { namespace execution_tree { namespace primitives
                     "called only once"));
         }
         operands_[0] = std::move(data);
+        update_memory_usage();
     }
 
 
@@ -100,6 +100,113 @@ namespace phylanx { namespace ir
         return hpx::util::get_and_reset_value(count_move_assignments_, reset);
     }
 
+    ///////////////////////////////////////////////////////////////////////////
+    // memory accounting data (separately for each node_data<T>)
+    static std::atomic<bool> enable_memory_accounting_;
+
+    namespace detail
+    {
+        template <typename T>
+        struct node_data_memory
+        {
+            static std::atomic<std::int64_t> allocated_;
+            static std::atomic<std::int64_t> high_water_;
+            static std::atomic<std::int64_t> deep_copies_;
+            static std::atomic<std::int64_t> deep_copy_bytes_;
+        };
+
+        template <typename T>
+        std::atomic<std::int64_t> node_data_memory<T>::allocated_(0);
+        template <typename T>
+        std::atomic<std::int64_t> node_data_memory<T>::high_water_(0);
+        template <typename T>
+        std::atomic<std::int64_t> node_data_memory<T>::deep_copies_(0);
+        template <typename T>
+        std::atomic<std::int64_t> node_data_memory<T>::deep_copy_bytes_(0);
+    }
+
+    template <typename T>
+    void node_data<T>::account_allocation(std::int64_t bytes)
+    {
+        using memory = detail::node_data_memory<T>;
+
+        std::int64_t const allocated =
+            memory::allocated_.fetch_add(bytes, std::memory_order_relaxed) +
+            bytes;
+
+        std::int64_t high_water =
+            memory::high_water_.load(std::memory_order_relaxed);
+        while (allocated > high_water &&
+            !memory::high_water_.compare_exchange_weak(
+                high_water, allocated, std::memory_order_relaxed))
+        {
+        }
+    }
+
+    template <typename T>
+    bool node_data<T>::enable_memory_accounting(bool enable)
+    {
+        return enable_memory_accounting_.exchange(
+            enable, std::memory_order_relaxed);
+    }
+
+    template <typename T>
+    void node_data<T>::track_allocation(bool deep_copy)
+    {
+        // storage accounted for before the accounting was disabled is
+        // still released
+        if (!enable_memory_accounting_.load(std::memory_order_relaxed))
+        {
+            allocation_.update(0);
+            return;
+        }
+
+        std::int64_t const bytes = owned_bytes();
+        allocation_.update(bytes);
+
+        if (deep_copy && bytes != 0)
+        {
+            using memory = detail::node_data_memory<T>;
+            memory::deep_copies_.fetch_add(1, std::memory_order_relaxed);
+            memory::deep_copy_bytes_.fetch_add(
+                bytes, std::memory_order_relaxed);
+        }
+    }
+
+    template <typename T>
+    std::int64_t node_data<T>::allocated_bytes(bool)
+    {
+        return detail::node_data_memory<T>::allocated_.load(
+            std::memory_order_relaxed);
+    }
+
+    // resetting the high water mark restarts it at the current allocation
+    template <typename T>
+    std::int64_t node_data<T>::allocated_bytes_high_water(bool reset)
+    {
+        using memory = detail::node_data_memory<T>;
+        if (reset)
+        {
+            return memory::high_water_.exchange(
+                memory::allocated_.load(std::memory_order_relaxed));
+        }
+        return memory::high_water_.load(std::memory_order_relaxed);
+    }
+
+    template <typename T>
+    std::int64_t node_data<T>::deep_copy_count(bool reset)
+    {
+        return hpx::util::get_and_reset_value(
+            detail::node_data_memory<T>::deep_copies_, reset);
+    }
+
+    template <typename T>
+    std::int64_t node_data<T>::deep_copy_bytes(bool reset)
+    {
+        return hpx::util::get_and_reset_value(
+            detail::node_data_memory<T>::deep_copy_bytes_, reset);
+    }
+
     ///////////////////////////////////////////////////////////////////////////
     /// Create node data for a 0-dimensional value
     template <typename T>
@@ -136,6 +243,7 @@ namespace phylanx { namespace ir
       : data_(values)
     {
         increment_copy_construction_count();
+        track_allocation(true);
     }
 
     template <typename T>
@@ -143,6 +251,7 @@ namespace phylanx { namespace ir
         : data_(std::move(values))
     {
         increment_move_construction_count();
+        track_allocation();
     }
 
     template <typename T>
@@ -167,6 +276,8 @@ namespace phylanx { namespace ir
         {
             data_ = storage0d_type();
         }
+
+        track_allocation();
     }
 
     template <typename T>
@@ -191,6 +302,8 @@ namespace phylanx { namespace ir
         {
             data_ = default_value;
         }
+
+        track_allocation();
     }
 
     template <typename T>
@@ -214,6 +327,7 @@ namespace phylanx { namespace ir
       : data_(values)
     {
         increment_copy_construction_count();
+        track_allocation(true);
     }
 
     template <typename T>
@@ -221,6 +335,7 @@ namespace phylanx { namespace ir
       : data_(std::move(values))
     {
         increment_move_construction_count();
+        track_allocation();
     }
 
     template <typename T>
@@ -245,6 +360,7 @@ namespace phylanx { namespace ir
       : data_(values)
     {
         increment_copy_construction_count();
+        track_allocation(true);
     }
 
     template <typename T>
@@ -252,6 +368,7 @@ namespace phylanx { namespace ir
       : data_(std::move(values))
     {
         increment_move_construction_count();
+        track_allocation();
     }
 
     template <typename T>
@@ -280,6 +397,8 @@ namespace phylanx { namespace ir
         {
             util::get<storage1d>(data_)[i] = values[i];
         }
+
+        track_allocation();
     }
 
     template <typename T>
@@ -297,6 +416,8 @@ namespace phylanx { namespace ir
                 util::get<storage2d>(data_)(i, j) = row[j];
             }
         }
+
+        track_allocation();
     }
 
 #if defined(PHYLANX_HAVE_BLAZE_TENSOR)
@@ -322,6 +443,8 @@ namespace phylanx { namespace ir
                 }
             }
         }
+
+        track_allocation();
     }
 #endif
 
@@ -395,13 +518,16 @@ namespace phylanx { namespace ir
     node_data<T>::node_data(node_data const& d)
       : data_(init_data_from(d))
     {
+        track_allocation(true);
     }
 
     template <typename T>
     node_data<T>::node_data(node_data&& d)
       : data_(std::move(d.data_))
+      , allocation_(std::move(d.allocation_))
     {
         increment_move_construction_count();
+        track_allocation();
     }
 
     template <typename T>
@@ -409,6 +535,7 @@ namespace phylanx { namespace ir
     {
         increment_copy_assignment_count();
         data_ = val;
+        track_allocation();
         return *this;
     }
 
@@ -417,6 +544,7 @@ namespace phylanx { namespace ir
     {
         increment_copy_assignment_count();
         data_ = val;
+        track_allocation();
         return *this;
     }
 
@@ -425,6 +553,7 @@ namespace phylanx { namespace ir
     {
         increment_move_assignment_count();
         data_ = std::move(val);
+        track_allocation();
         return *this;
     }
 
@@ -433,6 +562,7 @@ namespace phylanx { namespace ir
     {
         increment_copy_assignment_count();
         data_ = val;
+        track_allocation(true);
         return *this;
     }
 
@@ -441,6 +571,7 @@ namespace phylanx { namespace ir
     {
         increment_move_assignment_count();
         data_ = std::move(val);
+        track_allocation();
         return *this;
     }
 
@@ -450,6 +581,7 @@ namespace phylanx { namespace ir
         increment_move_assignment_count();
         data_ = custom_storage1d_type{
             const_cast<T*>(val.data()), val.size(), val.spacing()};
+        track_allocation();
         return *this;
     }
 
@@ -458,6 +590,7 @@ namespace phylanx { namespace ir
     {
         increment_move_assignment_count();
         data_ = std::move(val);
+        track_allocation();
         return *this;
     }
 
@@ -466,6 +599,7 @@ namespace phylanx { namespace ir
     {
         increment_copy_assignment_count();
         data_ = val;
+        track_allocation(true);
         return *this;
     }
 
@@ -474,6 +608,7 @@ namespace phylanx { namespace ir
     {
         increment_move_assignment_count();
         data_ = std::move(val);
+        track_allocation();
         return *this;
     }
 
@@ -483,6 +618,7 @@ namespace phylanx { namespace ir
         increment_move_assignment_count();
         data_ = custom_storage2d_type{const_cast<T*>(val.data()), val.rows(),
             val.columns(), val.spacing()};
+        track_allocation();
         return *this;
     }
 
@@ -491,6 +627,7 @@ namespace phylanx { namespace ir
     {
         increment_move_assignment_count();
         data_ = std::move(val);
+        track_allocation();
         return *this;
     }
 
@@ -500,6 +637,7 @@ namespace phylanx { namespace ir
     {
         increment_copy_assignment_count();
         data_ = val;
+        track_allocation(true);
         return *this;
     }
 
@@ -508,6 +646,7 @@ namespace phylanx { namespace ir
     {
         increment_move_assignment_count();
         data_ = std::move(val);
+        track_allocation();
         return *this;
     }
 
@@ -517,6 +656,7 @@ namespace phylanx { namespace ir
         increment_move_assignment_count();
         data_ = custom_storage3d_type{const_cast<T*>(val.data()), val.pages(),
             val.rows(), val.columns(), val.spacing()};
+        track_allocation();
         return *this;
     }
 
@@ -525,6 +665,7 @@ namespace phylanx { namespace ir
     {
         increment_move_assignment_count();
         data_ = std::move(val);
+        track_allocation();
         return *this;
     }
 #endif
@@ -539,6 +680,7 @@ namespace phylanx { namespace ir
         {
             util::get<storage1d>(data_)[i] = values[i];
         }
+        track_allocation();
         return *this;
     }
 
@@ -557,6 +699,7 @@ namespace phylanx { namespace ir
                 util::get<storage2d>(data_)(i, j) = row[j];
             }
         }
+        track_allocation();
         return *this;
     }
 
@@ -583,6 +726,7 @@ namespace phylanx { namespace ir
                 }
             }
         }
+        track_allocation();
         return *this;
     }
 #endif
@@ -659,6 +803,7 @@ namespace phylanx { namespace ir
         if (this != &d)
         {
             data_ = copy_data_from(d);
+            track_allocation(true);
         }
         return *this;
     }
@@ -670,7 +815,9 @@ namespace phylanx { namespace ir
         {
             increment_move_assignment_count();
             data_ = std::move(d.data_);
+            allocation_ = std::move(d.allocation_);
         }
+        track_allocation();
         return *this;
     }
 
@@ -2025,6 +2172,30 @@ namespace phylanx { namespace ir
             "node_data object holds unsupported data type");
     }
 
+    template <typename T>
+    std::int64_t node_data<T>::owned_bytes() const
+    {
+        switch(data_.index())
+        {
+        case storage1d:
+            return std::int64_t(
+                util::get<storage1d>(data_).capacity() * sizeof(T));
+
+        case storage2d:
+            return std::int64_t(
+                util::get<storage2d>(data_).capacity() * sizeof(T));
+
+#if defined(PHYLANX_HAVE_BLAZE_TENSOR)
+        case storage3d:
+            return std::int64_t(
+                util::get<storage3d>(data_).capacity() * sizeof(T));
+#endif
+        default:
+            break;
+        }
+        return 0;
+    }
+
     /// Return whether the internal representation is referring to another
     /// instance of node_data
     template <typename T>
@@ -2682,6 +2853,8 @@ namespace phylanx { namespace ir
                 "node_data<T>::serialize",
                 "node_data object holds unsupported data type");
         }
+
+        track_allocation();
     }
 }}
 
@@ -48,6 +48,27 @@ namespace phylanx { namespace ir
             "range_iterator object holds unsupported data type");
     }
 
+    execution_tree::primitive_argument_type const&
+    range_iterator::element() const
+    {
+        switch (it_.index())
+        {
+        case 1:    // args_iterator_type
+            return *(util::get<1>(it_));
+
+        case 2:    // args_const_iterator_type
+            return *(util::get<2>(it_));
+
+        case 0: HPX_FALLTHROUGH;    // int_range_type
+        default:
+            break;
+        }
+
+        HPX_THROW_EXCEPTION(hpx::invalid_status,
+            "phylanx::ir::range_iterator::element",
+            "range_iterator object does not refer to a list element");
+    }
+
     execution_tree::primitive_argument_type range_iterator::dereference() const
     {
         switch (it_.index())
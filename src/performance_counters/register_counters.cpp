@@ -7,21 +7,18 @@
 #include <phylanx/config.hpp>
 #include <phylanx/execution_tree/compile.hpp>
 #include <phylanx/execution_tree/compiler/primitive_name.hpp>
-#include <phylanx/execution_tree/primitives/primitive_component.hpp>
+#include <phylanx/execution_tree/primitives/primitive_registry.hpp>
 #include <phylanx/ir/node_data.hpp>
+#include <phylanx/util/gemm.hpp>
 
-#include <hpx/include/agas.hpp>
 #include <hpx/include/components.hpp>
 #include <hpx/include/performance_counters.hpp>
 #include <hpx/include/util.hpp>
 
 #include <atomic>
 #include <cstdint>
-#include <memory>
 #include <string>
-#include <utility>
 #include <vector>
-#include <map>
 
 #include <boost/spirit/include/qi_char.hpp>
 #include <boost/spirit/include/qi_difference.hpp>
@@ -60,27 +57,59 @@ namespace phylanx { namespace performance_counters
         }
     }
 
+    namespace et = phylanx::execution_tree;
+
+    ///////////////////////////////////////////////////////////////////////////
+    // All primitive counters are served from the primitive registry of this
+    // locality, which avoids scanning the AGAS symbolic namespace for the
+    // instances of the primitive type.
     class primitive_counter
       : public hpx::performance_counters::base_performance_counter<
             primitive_counter>
     {
     public:
+        enum counter_kind
+        {
+            eval_count,             // per instance: number of evaluations
+            eval_duration,          // per instance: time spent in eval
+            direct_execution,       // per instance: executed directly
+            memory_usage,           // per instance: bytes of array data
+            statistics              // aggregated over all instances
+        };
+
         primitive_counter()
           : first_init_(false)
-          , duration_counter_(false)
+          , kind_(eval_count)
         {}
 
         primitive_counter(hpx::performance_counters::counter_info const& info)
           : hpx::performance_counters::base_performance_counter<
                 primitive_counter>(info)
           , first_init_(false)
-          , duration_counter_(false)
+          , kind_(eval_count)
+          , type_(detail::extract_primitive_type(info))
         {
             hpx::performance_counters::counter_path_elements paths;
             hpx::performance_counters::get_counter_path_elements(
                 info.fullname_, paths);
-            duration_counter_ =
-                paths.countername_.find("time") != std::string::npos;
+
+            if (paths.countername_.find("statistics") != std::string::npos)
+            {
+                kind_ = statistics;
+            }
+            else if (paths.countername_.find("memory") != std::string::npos)
+            {
+                kind_ = memory_usage;
+            }
+            else if (paths.countername_.find("eval_direct") !=
+                std::string::npos)
+            {
+                kind_ = direct_execution;
+            }
+            else if (paths.countername_.find("time") != std::string::npos)
+            {
+                kind_ = eval_duration;
+            }
         }
 
         // Produce the counter value
@@ -100,243 +129,74 @@ namespace phylanx { namespace performance_counters
             value.status_ = hpx::performance_counters::status_new_data;
             value.count_ = ++invocation_count_;
 
-            std::vector<std::int64_t> result;
-            result.reserve(instances_.size());
-
-            // Extract the values from instances_
-            for (auto const& instance : instances_)
-            {
-                if (duration_counter_)
-                {
-                    result.push_back(instance->get_eval_duration(reset));
-                }
-                else
-                {
-                    result.push_back(instance->get_eval_count(reset));
-                }
-            }
-
-            value.values_ = std::move(result);
+            value.values_ = get_values(reset);
 
             return value;
         }
 
-        // Retrieve the list of existing primitives for the current execution
-        // tree and keep it
+        // Enable the measurements for all instances of the primitive type,
+        // instances created later on are measured as well
         void reinit(bool reset) override
         {
-            // Structure of primitives in symbolic namespace:
-            //     /phylanx/<primitive>$<sequence-nr>[$<instance>]/<compile_id>$<tag>
-            auto entries = hpx::agas::find_symbols(hpx::launch::sync,
-                "/phylanx/" + detail::extract_primitive_type(info_) + "$*");
-
-            // TODO: Only keep entries that live on this locality.
-            // This will be a problem when Phylanx becomes distributed.
-            std::map<std::int64_t, base_primitive_ptr> instances_sorted;
-
-            for (auto const& value : entries)
+            auto& data = et::primitives::get_primitive_type_data(type_);
+            if (kind_ != direct_execution && kind_ != memory_usage)
             {
-                auto const& instance = hpx::get_ptr<
-                    phylanx::execution_tree::primitives::primitive_component>(
-                        hpx::launch::sync, value.second);
-
-                auto instance_info =
-                    phylanx::execution_tree::compiler::parse_primitive_name(
-                        value.first);
-
-                instance->enable_measurements();
-
-                // Consider the reset flag
-                if (reset)
-                {
-                    if (duration_counter_)
-                    {
-                        instance->get_eval_duration(true);
-                    }
-                    else
-                    {
-                        instance->get_eval_count(true);
-                    }
-                }
-                instances_sorted[instance_info.sequence_number] = instance;
+                data.enable_measurements();
             }
 
-            instances_.clear();
-            instances_.reserve(entries.size());
-
-            for (auto && value : instances_sorted)
+            // Consider the reset flag
+            if (reset)
             {
-                instances_.emplace_back(std::move(value.second));
+                get_values(true);
             }
 
             first_init_ = true;
         }
 
     private:
-        using base_primitive_ptr = std::shared_ptr<
-            phylanx::execution_tree::primitives::primitive_component>;
-
-        std::vector<base_primitive_ptr> instances_;
-        std::atomic<bool> first_init_;
-        bool duration_counter_;
-    };
-
-    hpx::naming::gid_type primitive_counter_creator(
-        hpx::performance_counters::counter_info const& info,
-        hpx::error_code& ec)
-    {
-        namespace pc = hpx::performance_counters;
-
-        // Break down the counter name
-        pc::counter_path_elements paths;
-        pc::get_counter_path_elements(info.fullname_, paths, ec);
-        if (ec) return hpx::naming::invalid_gid;
-
-        // If another counter's name was give
-        if (paths.parentinstance_is_basename_)
+        // The per-instance values are ordered by the sequence numbers of the
+        // instances
+        std::vector<std::int64_t> get_values(bool reset) const
         {
-            HPX_THROWS_IF(ec,
-                hpx::bad_parameter,
-                "primitive_counter_creator",
-                "invalid counter instance parent name: " +
-                paths.parentinstancename_);
-            return hpx::naming::invalid_gid;
-        }
+            using et::primitives::primitive_type_data;
 
-        if (paths.instancename_ == "total" && paths.instanceindex_ == -1)
-        {
-            pc::counter_info complemented_info = info;
-            pc::complement_counter_info(complemented_info, info, ec);
-            if (ec) return hpx::naming::invalid_gid;
-
-            hpx::naming::gid_type id;
-            try
+            primitive_type_data* data =
+                et::primitives::find_primitive_type_data(type_);
+            if (data == nullptr)
             {
-                // Try constructing the actual counter
-                using primitive_counter_type =
-                    hpx::components::component<primitive_counter>;
-
-                id = hpx::components::server::construct<primitive_counter_type>(
-                    complemented_info);
-            }
-            catch (hpx::exception const& e)
-            {
-                if (&ec == &hpx::throws)
-                    throw;
-                ec = hpx::make_error_code(e.get_error(), e.what());
-                return hpx::naming::invalid_gid;
+                return std::vector<std::int64_t>{};
             }
 
-            if (&ec != &hpx::throws)
-                ec = hpx::make_success_code();
-            return id;
-        }
-
-        HPX_THROWS_IF(ec,
-            hpx::bad_parameter,
-            "primitive_counter_creator",
-            "invalid counter instance name: " + paths.instancename_);
-        return hpx::naming::invalid_gid;
-    }
-
-    ///////////////////////////////////////////////////////////////////////////
-    class direct_execution_counter
-      : public hpx::performance_counters::base_performance_counter<
-            direct_execution_counter>
-    {
-    public:
-        direct_execution_counter()
-          : first_init_(false)
-        {}
-
-        direct_execution_counter(
-                hpx::performance_counters::counter_info const& info)
-          : hpx::performance_counters::base_performance_counter<
-                direct_execution_counter>(info)
-          , first_init_(false)
-        {}
-
-        // Produce the counter value
-        hpx::performance_counters::counter_values_array
-        get_counter_values_array(bool reset) override
-        {
-            // Need to call reinit here if it has never been called before.
-            bool expected = false;
-            if (first_init_.compare_exchange_strong(expected, true))
-            {
-                reinit(false);
-            }
-
-            hpx::performance_counters::counter_values_array value;
-
-            value.time_ = static_cast<std::int64_t>(hpx::get_system_uptime());
-            value.status_ = hpx::performance_counters::status_new_data;
-            value.count_ = ++invocation_count_;
-
-            std::vector<std::int64_t> result;
-            result.reserve(instances_.size());
-
-            // Extract the values from instances_
-            for (auto const& instance : instances_)
+            switch (kind_)
             {
-                result.push_back(instance->get_direct_execution(reset));
-            }
-
-            value.values_ = std::move(result);
+            case eval_duration:
+                return data->instance_values(
+                    primitive_type_data::eval_duration, reset);
 
-            return value;
-        }
+            case direct_execution:
+                return data->instance_values(
+                    primitive_type_data::direct_execution, reset);
 
-        // Retrieve the list of existing primitives for the current execution
-        // tree and keep it
-        void reinit(bool reset) override
-        {
-            // Structure of primitives in symbolic namespace:
-            //     /phylanx/<primitive>$<sequence-nr>[$<instance>]/<compile_id>$<tag>
-            auto entries = hpx::agas::find_symbols(hpx::launch::sync,
-                "/phylanx/" + detail::extract_primitive_type(info_) + "$*");
+            case memory_usage:
+                return data->instance_values(
+                    primitive_type_data::memory_usage, reset);
 
-            // TODO: Only keep entries that live on this locality.
-            // This will be a problem when Phylanx becomes distributed.
-            std::map<std::int64_t, base_primitive_ptr> instances_sorted;
+            case statistics:
+                return data->statistics(reset).values();
 
-            for (auto const& value : entries)
-            {
-                auto const& instance = hpx::get_ptr<
-                    phylanx::execution_tree::primitives::primitive_component>(
-                        hpx::launch::sync, value.second);
-
-                auto instance_info =
-                    phylanx::execution_tree::compiler::parse_primitive_name(
-                        value.first);
-
-                // Consider the reset flag
-                if (reset)
-                {
-                    instance->get_direct_execution(true);
-                }
-                instances_sorted[instance_info.sequence_number] = instance;
+            default:
+                break;
             }
-
-            instances_.clear();
-            instances_.reserve(entries.size());
-            for (auto const& value : instances_sorted)
-            {
-                instances_.push_back(value.second);
-            }
-
-            first_init_ = true;
+            return data->instance_values(
+                primitive_type_data::eval_count, reset);
         }
 
-    private:
-        using base_primitive_ptr = std::shared_ptr<
-            phylanx::execution_tree::primitives::primitive_component>;
-
-        std::vector<base_primitive_ptr> instances_;
         std::atomic<bool> first_init_;
+        counter_kind kind_;
+        std::string type_;
     };
 
-    hpx::naming::gid_type direct_execution_counter_creator(
+    hpx::naming::gid_type primitive_counter_creator(
         hpx::performance_counters::counter_info const& info,
         hpx::error_code& ec)
     {
@@ -354,7 +214,7 @@ namespace phylanx { namespace performance_counters
                 hpx::bad_parameter,
                 "primitive_counter_creator",
                 "invalid counter instance parent name: " +
-                    paths.parentinstancename_);
+                paths.parentinstancename_);
             return hpx::naming::invalid_gid;
         }
 
@@ -368,11 +228,11 @@ namespace phylanx { namespace performance_counters
             try
             {
                 // Try constructing the actual counter
-                using direct_execution_counter_type =
-                    hpx::components::component<direct_execution_counter>;
+                using primitive_counter_type =
+                    hpx::components::component<primitive_counter>;
 
-                id = hpx::components::server::construct<
-                    direct_execution_counter_type>(complemented_info);
+                id = hpx::components::server::construct<primitive_counter_type>(
+                    complemented_info);
             }
             catch (hpx::exception const& e)
             {
@@ -426,9 +286,105 @@ namespace phylanx { namespace performance_counters
             "returns the current value of the move-assignment count of "
                 "any node_data<double>");
 
+        // memory held by node_data<double>
+        hpx::performance_counters::install_counter_type(
+            "/phylanx/node_data_double/memory/allocated",
+            &ir::node_data<double>::allocated_bytes,
+            "returns the number of bytes of array data currently owned by "
+                "all node_data<double>", "bytes");
+
+        hpx::performance_counters::install_counter_type(
+            "/phylanx/node_data_double/memory/high_water",
+            &ir::node_data<double>::allocated_bytes_high_water,
+            "returns the maximal number of bytes of array data owned by "
+                "all node_data<double> at any time since the last reset",
+            "bytes");
+
+        hpx::performance_counters::install_counter_type(
+            "/phylanx/node_data_double/count/deep_copies",
+            &ir::node_data<double>::deep_copy_count,
+            "returns the number of copies of the array data of any "
+                "node_data<double>");
+
+        hpx::performance_counters::install_counter_type(
+            "/phylanx/node_data_double/memory/deep_copies",
+            &ir::node_data<double>::deep_copy_bytes,
+            "returns the number of bytes copied by all copies of the "
+                "array data of any node_data<double>", "bytes");
+
+        // memory held by node_data<std::int64_t>
+        hpx::performance_counters::install_counter_type(
+            "/phylanx/node_data_int64/memory/allocated",
+            &ir::node_data<std::int64_t>::allocated_bytes,
+            "returns the number of bytes of array data currently owned by "
+                "all node_data<std::int64_t>", "bytes");
+
+        hpx::performance_counters::install_counter_type(
+            "/phylanx/node_data_int64/memory/high_water",
+            &ir::node_data<std::int64_t>::allocated_bytes_high_water,
+            "returns the maximal number of bytes of array data owned by "
+                "all node_data<std::int64_t> at any time since the last reset",
+            "bytes");
+
+        hpx::performance_counters::install_counter_type(
+            "/phylanx/node_data_int64/count/deep_copies",
+            &ir::node_data<std::int64_t>::deep_copy_count,
+            "returns the number of copies of the array data of any "
+                "node_data<std::int64_t>");
+
+        hpx::performance_counters::install_counter_type(
+            "/phylanx/node_data_int64/memory/deep_copies",
+            &ir::node_data<std::int64_t>::deep_copy_bytes,
+            "returns the number of bytes copied by all copies of the "
+                "array data of any node_data<std::int64_t>", "bytes");
+
+        // memory held by node_data<std::uint8_t>
+        hpx::performance_counters::install_counter_type(
+            "/phylanx/node_data_uint8/memory/allocated",
+            &ir::node_data<std::uint8_t>::allocated_bytes,
+            "returns the number of bytes of array data currently owned by "
+                "all node_data<std::uint8_t>", "bytes");
+
+        hpx::performance_counters::install_counter_type(
+            "/phylanx/node_data_uint8/memory/high_water",
+            &ir::node_data<std::uint8_t>::allocated_bytes_high_water,
+            "returns the maximal number of bytes of array data owned by "
+                "all node_data<std::uint8_t> at any time since the last reset",
+            "bytes");
+
+        hpx::performance_counters::install_counter_type(
+            "/phylanx/node_data_uint8/count/deep_copies",
+            &ir::node_data<std::uint8_t>::deep_copy_count,
+            "returns the number of copies of the array data of any "
+                "node_data<std::uint8_t>");
+
+        hpx::performance_counters::install_counter_type(
+            "/phylanx/node_data_uint8/memory/deep_copies",
+            &ir::node_data<std::uint8_t>::deep_copy_bytes,
+            "returns the number of bytes copied by all copies of the "
+                "array data of any node_data<std::uint8_t>", "bytes");
+
+        // products of 2-D operands (dot, tensordot)
+        hpx::performance_counters::install_counter_type(
+            "/phylanx/dot/count/flop",
+            &util::gemm_flop_count,
+            "returns the number of floating point operations performed by "
+                "products of matrices with matrices or vectors", "flop");
+
+        hpx::performance_counters::install_counter_type(
+            "/phylanx/dot/time/eval",
+            &util::gemm_time,
+            "returns the time spent evaluating products of matrices with "
+                "matrices or vectors", "ns");
+
+        hpx::performance_counters::install_counter_type(
+            "/phylanx/dot/performance",
+            &util::gemm_mflops,
+            "returns the performance achieved by products of matrices with "
+                "matrices or vectors since the last reset", "MFLOP/s");
+
         // Iterate and register a time and count performance counter per each
         // primitive
-        namespace et = phylanx::execution_tree;
         for (auto const& pattern : et::get_all_known_patterns())
         {
             // The name of the primitive
@@ -462,7 +418,29 @@ namespace phylanx { namespace performance_counters
                 "returns a list whose elements contain whether "
                     "the eval function for the " + name + " primitive "
                     "was executed directly",
-                &direct_execution_counter_creator,
+                &primitive_counter_creator,
+                &hpx::performance_counters::locality_counter_discoverer);
+
+            // Register a memory usage performance counter
+            hpx::performance_counters::install_counter_type(
+                "/phylanx/primitives/" + name + "/memory",
+                hpx::performance_counters::counter_raw_values,
+                "returns a list whose elements contain the number of bytes "
+                    "of array data held by each " + name + " primitive",
+                &primitive_counter_creator,
+                &hpx::performance_counters::locality_counter_discoverer,
+                HPX_PERFORMANCE_COUNTER_V1, "bytes");
+
+            // Register a performance counter aggregating all instances
+            hpx::performance_counters::install_counter_type(
+                "/phylanx/primitives/" + name + "/statistics",
+                hpx::performance_counters::counter_raw_values,
+                "returns the statistics of all evaluations of " + name +
+                    " primitives: the number of instances, the number of "
+                    "evaluations, the total, minimal and maximal evaluation "
+                    "time (ns), the size of the produced results (bytes), "
+                    "followed by a histogram of the evaluation times",
+                &primitive_counter_creator,
                 &hpx::performance_counters::locality_counter_discoverer);
         }
     }
@@ -477,10 +455,3 @@ using primitive_counter = phylanx::performance_counters::primitive_counter;
 HPX_REGISTER_DERIVED_COMPONENT_FACTORY(
     primitive_counter_type, primitive_counter, "base_performance_counter");
 
-using direct_execution_type = hpx::components::component<
-    phylanx::performance_counters::direct_execution_counter>;
-using direct_execution_counter =
-    phylanx::performance_counters::direct_execution_counter;
-
-HPX_REGISTER_DERIVED_COMPONENT_FACTORY(
-    direct_execution_type, direct_execution_counter, "base_performance_counter");
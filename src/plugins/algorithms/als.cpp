@@ -5,6 +5,7 @@
 
 #include <phylanx/config.hpp>
 #include <phylanx/plugins/algorithms/als.hpp>
+#include <phylanx/util/factorization.hpp>
 
 #include <hpx/include/iostreams.hpp>
 #include <hpx/include/lcos.hpp>
@@ -162,10 +163,17 @@ namespace phylanx { namespace execution_tree { namespace primitives
                 diag = conf_u;
                 blaze::DynamicVector<double> p_u =
                     blaze::map(conf_u, [&](double x) { return (x != 0.0); });
-                auto A = (blaze::trans(Y) * c_u) * Y + YtY;
-                auto b = (blaze::trans(Y) * (c_u + I_i)) * (p_u);
-                auto row_x = blaze::row(X, u);
-                row_x = (trans(b) * blaze::inv(A));
+                util::factorization::matrix_type A =
+                    (blaze::trans(Y) * c_u) * Y + YtY;
+                blaze::DynamicVector<double> b =
+                    (blaze::trans(Y) * (c_u + I_i)) * (p_u);
+
+                // A is symmetric positive definite (the confidences are
+                // non-negative and YtY is regularized), so b' * inv(A) ==
+                // trans(x) with A * x = b
+                util::solve(util::factorize(std::move(A),
+                                util::factorization_kind::cholesky), b);
+                blaze::row(X, u) = blaze::trans(b);
             }
 
             for (std::int64_t i = 0; i < num_items; i++)
@@ -175,10 +183,14 @@ namespace phylanx { namespace execution_tree { namespace primitives
                 diag = conf_i;
                 blaze::DynamicVector<double> p_i =
                     blaze::map(conf_i, [&](double x) { return (x != 0.0); });
-                auto A = (blaze::trans(X) * c_i) * X + XtX;
-                auto b = (blaze::trans(X) * (c_i + I_u)) * (p_i);
-                auto row_y = blaze::row(Y, i);
-                row_y = (trans(b) * blaze::inv(A));
+                util::factorization::matrix_type A =
+                    (blaze::trans(X) * c_i) * X + XtX;
+                blaze::DynamicVector<double> b =
+                    (blaze::trans(X) * (c_i + I_u)) * (p_i);
+
+                util::solve(util::factorize(std::move(A),
+                                util::factorization_kind::cholesky), b);
+                blaze::row(Y, i) = blaze::trans(b);
             }
         }
 
@@ -56,6 +56,12 @@ namespace phylanx { namespace execution_tree { namespace primitives
                 return T(1);
             }
 
+            template <typename T>
+            static T combine(T lhs, T rhs)
+            {
+                return T(lhs * rhs);
+            }
+
             template <typename InIter, typename OutIter, typename T>
             OutIter operator()(
                 InIter begin, InIter end, OutIter dest, T init) const
@@ -9,6 +9,7 @@
 #include <phylanx/execution_tree/primitives/node_data_helpers.hpp>
 #include <phylanx/ir/node_data.hpp>
 #include <phylanx/plugins/arithmetics/generic_operation.hpp>
+#include <phylanx/util/vector_math.hpp>
 
 #include <hpx/include/lcos.hpp>
 #include <hpx/include/naming.hpp>
@@ -23,6 +24,11 @@
 #include <utility>
 #include <vector>
 
+#include <blaze/Math.h>
+#if defined(PHYLANX_HAVE_BLAZE_TENSOR)
+#include <blaze_tensor/Math.h>
+#endif
+
 ///////////////////////////////////////////////////////////////////////////////
 namespace phylanx { namespace execution_tree { namespace primitives
 {
@@ -111,6 +117,8 @@ namespace phylanx { namespace execution_tree { namespace primitives
       , dtype_(extract_dtype(name_))
       , retain_argument_type_(detail::extract_argument_handling_mode(
             func_name_, name_, codename_))
+      , has_math_function_(
+            util::parse_math_function(func_name_, math_function_))
     {
     }
 
@@ -193,6 +201,11 @@ namespace phylanx { namespace execution_tree { namespace primitives
         case node_data_type_double:
         case node_data_type_bool:
         case node_data_type_unknown:
+            if (has_math_function_)
+            {
+                return generic_math(
+                    extract_numeric_value(std::move(op), name_, codename_));
+            }
             return generic1d(
                 extract_numeric_value(std::move(op), name_, codename_));
         }
@@ -221,6 +234,11 @@ namespace phylanx { namespace execution_tree { namespace primitives
         case node_data_type_double:
         case node_data_type_bool:
         case node_data_type_unknown:
+            if (has_math_function_)
+            {
+                return generic_math(
+                    extract_numeric_value(std::move(op), name_, codename_));
+            }
             return generic2d(
                 extract_numeric_value(std::move(op), name_, codename_));
         }
@@ -250,6 +268,11 @@ namespace phylanx { namespace execution_tree { namespace primitives
         case node_data_type_double:
         case node_data_type_bool:
         case node_data_type_unknown:
+            if (has_math_function_)
+            {
+                return generic_math(
+                    extract_numeric_value(std::move(op), name_, codename_));
+            }
             return generic3d(
                 extract_numeric_value(std::move(op), name_, codename_));
         }
@@ -260,6 +283,79 @@ namespace phylanx { namespace execution_tree { namespace primitives
     }
 #endif
 
+    ///////////////////////////////////////////////////////////////////////////
+    primitive_argument_type generic_operation::generic_math(
+        arg_type<double>&& op) const
+    {
+        switch (op.num_dimensions())
+        {
+        case 1:
+            {
+                auto v = op.vector();
+                if (op.is_ref())
+                {
+                    blaze::DynamicVector<double> result(v.size());
+                    util::apply_math_function(math_function_, v.data(),
+                        v.size(), result.data(), result.size(), 1, v.size());
+                    return primitive_argument_type{std::move(result)};
+                }
+
+                util::apply_math_function(math_function_, v.data(), v.size(),
+                    v.data(), v.size(), 1, v.size());
+                return primitive_argument_type{std::move(op)};
+            }
+
+        case 2:
+            {
+                auto m = op.matrix();
+                if (op.is_ref())
+                {
+                    blaze::DynamicMatrix<double> result(m.rows(), m.columns());
+                    util::apply_math_function(math_function_, m.data(),
+                        m.spacing(), result.data(), result.spacing(),
+                        m.rows(), m.columns());
+                    return primitive_argument_type{std::move(result)};
+                }
+
+                util::apply_math_function(math_function_, m.data(),
+                    m.spacing(), m.data(), m.spacing(), m.rows(),
+                    m.columns());
+                return primitive_argument_type{std::move(op)};
+            }
+
+#if defined(PHYLANX_HAVE_BLAZE_TENSOR)
+        case 3:
+            {
+                // the pages of a tensor are stored consecutively, which
+                // allows to treat it as a matrix of pages * rows rows
+                auto t = op.tensor();
+                if (op.is_ref())
+                {
+                    blaze::DynamicTensor<double> result(
+                        t.pages(), t.rows(), t.columns());
+                    util::apply_math_function(math_function_, t.data(),
+                        t.spacing(), result.data(), result.spacing(),
+                        t.pages() * t.rows(), t.columns());
+                    return primitive_argument_type{std::move(result)};
+                }
+
+                util::apply_math_function(math_function_, t.data(),
+                    t.spacing(), t.data(), t.spacing(), t.pages() * t.rows(),
+                    t.columns());
+                return primitive_argument_type{std::move(op)};
+            }
+#endif
+
+        default:
+            break;
+        }
+
+        HPX_THROW_EXCEPTION(hpx::bad_parameter,
+            "generic_operation::generic_math",
+            generate_error_message(
+                "operand has unsupported number of dimensions"));
+    }
+
     ///////////////////////////////////////////////////////////////////////////
     hpx::future<primitive_argument_type> generic_operation::eval(
         primitive_arguments_type const& operands,
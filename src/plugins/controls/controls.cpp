@@ -29,10 +29,16 @@ PHYLANX_REGISTER_PLUGIN_FACTORY(fmap_operation_plugin,
     phylanx::execution_tree::primitives::fmap_operation::match_data);
 PHYLANX_REGISTER_PLUGIN_FACTORY(parallel_block_operation_plugin,
     phylanx::execution_tree::primitives::parallel_block_operation::match_data);
+PHYLANX_REGISTER_PLUGIN_FACTORY(parallel_for_each_plugin,
+    phylanx::execution_tree::primitives::parallel_for_each::match_data[0]);
+PHYLANX_REGISTER_PLUGIN_FACTORY(parallel_reduce_plugin,
+    phylanx::execution_tree::primitives::parallel_for_each::match_data[1]);
 PHYLANX_REGISTER_PLUGIN_FACTORY(parallel_map_operation_plugin,
     phylanx::execution_tree::primitives::parallel_map_operation::match_data);
 PHYLANX_REGISTER_PLUGIN_FACTORY(range_operation_plugin,
     phylanx::execution_tree::primitives::range_operation::match_data);
+PHYLANX_REGISTER_PLUGIN_FACTORY(vmap_operation_plugin,
+    phylanx::execution_tree::primitives::vmap_operation::match_data);
 PHYLANX_REGISTER_PLUGIN_FACTORY(while_operation_plugin,
     phylanx::execution_tree::primitives::while_operation::match_data);
 
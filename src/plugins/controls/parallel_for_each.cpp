@@ -0,0 +1,398 @@
+// Copyright (c) 2019 Hartmut Kaiser
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <phylanx/config.hpp>
+#include <phylanx/execution_tree/compiler/primitive_name.hpp>
+#include <phylanx/execution_tree/primitives/detail/indexed_range.hpp>
+#include <phylanx/plugins/controls/parallel_for_each.hpp>
+#include <phylanx/util/chunk_policy.hpp>
+
+#include <hpx/include/lcos.hpp>
+#include <hpx/include/naming.hpp>
+#include <hpx/include/parallel_for_loop.hpp>
+#include <hpx/include/parallel_reduce.hpp>
+#include <hpx/include/util.hpp>
+#include <hpx/throw_exception.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+///////////////////////////////////////////////////////////////////////////////
+namespace phylanx { namespace execution_tree { namespace primitives
+{
+    ///////////////////////////////////////////////////////////////////////////
+    std::vector<match_pattern_type> const parallel_for_each::match_data =
+    {
+        match_pattern_type{"parallel_for_each",
+            std::vector<std::string>{
+                "parallel_for_each(_1, _2, __arg(_3_schedule, nil), "
+                    "__arg(_4_chunk_size, nil))"
+            },
+            &create_parallel_for_each, &create_primitive<parallel_for_each>,
+            R"(func, range, schedule, chunk_size
+            Args:
+
+                func (function) : a function that takes one argument
+                range (iter) : an iterator
+                schedule (string, optional) : the way the iterations are
+                    split into chunks, one of 'auto' (default), 'static',
+                    'dynamic', or 'guided'
+                chunk_size (int, optional) : the number of iterations per
+                    chunk ('static', 'dynamic'), or the minimal number of
+                    iterations per chunk ('guided')
+
+            Returns:
+
+                nil
+
+            The function `func` is invoked concurrently for all elements of
+            the given range. Each chunk of iterations is executed by a single
+            HPX thread.)"
+        },
+        match_pattern_type{"parallel_reduce",
+            std::vector<std::string>{
+                "parallel_reduce(_1, _2, _3, __arg(_4_initial, nil), "
+                    "__arg(_5_schedule, nil), __arg(_6_chunk_size, nil))"
+            },
+            &create_parallel_reduce, &create_primitive<parallel_for_each>,
+            R"(func, range, reduce_func, initial, schedule, chunk_size
+            Args:
+
+                func (function) : a function that takes one argument
+                range (iter) : an iterator
+                reduce_func (function) : an associative function that takes
+                    two arguments and combines them into one value
+                initial (optional) : the initial value of the reduction
+                schedule (string, optional) : the way the iterations are
+                    split into chunks, one of 'auto' (default), 'static',
+                    'dynamic', or 'guided'
+                chunk_size (int, optional) : the number of iterations per
+                    chunk ('static', 'dynamic'), or the minimal number of
+                    iterations per chunk ('guided')
+
+            Returns:
+
+                The result of combining the values returned from invoking
+                `func` for all elements of `range` using `reduce_func`, or
+                `initial` if the range is empty.
+
+            Examples:
+
+                parallel_reduce(lambda(x, x * x), range(4), lambda(a, b, a + b))
+
+            Evaluates to 14.)"
+        }
+    };
+
+    ///////////////////////////////////////////////////////////////////////////
+    namespace detail
+    {
+        bool extract_if_reduce(std::string const& name)
+        {
+            compiler::primitive_name_parts name_parts;
+            if (compiler::parse_primitive_name(name, name_parts))
+            {
+                return name_parts.primitive == "parallel_reduce";
+            }
+            return name.find("parallel_reduce") == 0;
+        }
+    }
+
+    parallel_for_each::parallel_for_each(
+            primitive_arguments_type&& operands,
+            std::string const& name, std::string const& codename)
+      : primitive_component_base(std::move(operands), name, codename)
+      , reduce_(detail::extract_if_reduce(name_))
+    {}
+
+    ///////////////////////////////////////////////////////////////////////////
+    util::chunk_policy parallel_for_each::extract_chunk_policy(
+        primitive_argument_type const& schedule,
+        primitive_argument_type const& chunk_size) const
+    {
+        util::chunk_policy result;
+
+        if (valid(schedule))
+        {
+            std::string name =
+                extract_string_value(schedule, name_, codename_);
+            if (!util::parse_chunk_schedule(name, result.schedule_))
+            {
+                HPX_THROW_EXCEPTION(hpx::bad_parameter,
+                    "parallel_for_each::extract_chunk_policy",
+                    generate_error_message(
+                        "the schedule must be one of 'auto', 'static', "
+                        "'dynamic', or 'guided', got: '" + name + "'"));
+            }
+        }
+
+        if (valid(chunk_size))
+        {
+            std::int64_t size = extract_scalar_integer_value(
+                chunk_size, name_, codename_);
+            if (size < 0)
+            {
+                HPX_THROW_EXCEPTION(hpx::bad_parameter,
+                    "parallel_for_each::extract_chunk_policy",
+                    generate_error_message(
+                        "the chunk size must not be negative"));
+            }
+            result.chunk_size_ = static_cast<std::size_t>(size);
+        }
+
+        return result;
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    namespace detail
+    {
+        // keep the function and the iteration space alive while the parallel
+        // loop is running
+        struct parallel_for_each_state
+        {
+            parallel_for_each_state(
+                    primitive_argument_type&& func, ir::range&& list)
+              : func_(std::move(func))
+              , elements_(std::move(list))
+            {}
+
+            primitive_argument_type func_;
+            indexed_range elements_;
+            primitive_arguments_type results_;
+        };
+    }
+
+    primitive const* parallel_for_each::extract_invocable(
+        primitive_argument_type const& f, char const* argname) const
+    {
+        primitive const* p = util::get_if<primitive>(&f);
+        if (p == nullptr)
+        {
+            HPX_THROW_EXCEPTION(hpx::bad_parameter,
+                "parallel_for_each::extract_invocable",
+                generate_error_message(std::string("the ") + argname +
+                    " argument must be an invocable object"));
+        }
+        return p;
+    }
+
+    hpx::future<primitive_argument_type> parallel_for_each::for_each(
+        primitive_arguments_type const& operands,
+        primitive_arguments_type const& args, eval_context ctx) const
+    {
+        primitive_argument_type schedule, chunk_size;
+        if (operands.size() > 2 && valid(operands[2]))
+        {
+            schedule =
+                value_operand_sync(operands[2], args, name_, codename_, ctx);
+        }
+        if (operands.size() > 3 && valid(operands[3]))
+        {
+            chunk_size =
+                value_operand_sync(operands[3], args, name_, codename_, ctx);
+        }
+
+        util::chunk_policy chunking =
+            extract_chunk_policy(schedule, chunk_size);
+
+        ctx.remove_mode(eval_dont_wrap_functions);
+
+        auto this_ = this->shared_from_this();
+        return hpx::dataflow(hpx::launch::sync, hpx::util::unwrapping(
+            [this_ = std::move(this_), chunking, ctx](
+                    primitive_argument_type&& bound_func, ir::range&& list)
+            ->  hpx::future<primitive_argument_type>
+            {
+                auto state = std::make_shared<detail::parallel_for_each_state>(
+                    std::move(bound_func), std::move(list));
+
+                primitive const* p =
+                    this_->extract_invocable(state->func_, "first");
+
+                auto f = util::with_chunk_policy(
+                    hpx::parallel::execution::par(
+                        hpx::parallel::execution::task),
+                    chunking,
+                    [&](auto&& policy)
+                    {
+                        return hpx::parallel::for_loop(
+                            std::forward<decltype(policy)>(policy),
+                            std::size_t(0), state->elements_.size(),
+                            [state, p, ctx](std::size_t i)
+                            {
+                                p->eval(hpx::launch::sync,
+                                    state->elements_[i], ctx);
+                            });
+                    });
+
+                return f.then(hpx::launch::sync,
+                    [state = std::move(state), ctx](hpx::future<void>&& f)
+                    ->  primitive_argument_type
+                    {
+                        f.get();        // propagate exceptions
+                        return primitive_argument_type{};
+                    });
+            }),
+            value_operand(operands[0], args, name_, codename_,
+                add_mode(ctx, eval_dont_evaluate_lambdas)),
+            list_operand(operands[1], args, name_, codename_, ctx));
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    hpx::future<primitive_argument_type> parallel_for_each::reduce(
+        primitive_arguments_type const& operands,
+        primitive_arguments_type const& args, eval_context ctx) const
+    {
+        primitive_argument_type schedule, chunk_size;
+        if (operands.size() > 4 && valid(operands[4]))
+        {
+            schedule =
+                value_operand_sync(operands[4], args, name_, codename_, ctx);
+        }
+        if (operands.size() > 5 && valid(operands[5]))
+        {
+            chunk_size =
+                value_operand_sync(operands[5], args, name_, codename_, ctx);
+        }
+
+        util::chunk_policy chunking =
+            extract_chunk_policy(schedule, chunk_size);
+
+        ctx.remove_mode(eval_dont_wrap_functions);
+
+        auto initial = operands.size() > 3 && valid(operands[3]) ?
+            value_operand(operands[3], args, name_, codename_, ctx) :
+            hpx::make_ready_future(primitive_argument_type{});
+
+        auto this_ = this->shared_from_this();
+        return hpx::dataflow(hpx::launch::sync, hpx::util::unwrapping(
+            [this_ = std::move(this_), chunking, ctx](
+                    primitive_argument_type&& bound_func, ir::range&& list,
+                    primitive_argument_type&& bound_reduce,
+                    primitive_argument_type&& initial)
+            ->  hpx::future<primitive_argument_type>
+            {
+                auto state = std::make_shared<detail::parallel_for_each_state>(
+                    std::move(bound_func), std::move(list));
+
+                primitive const* p =
+                    this_->extract_invocable(state->func_, "first");
+                this_->extract_invocable(bound_reduce, "third");
+
+                state->results_.resize(state->elements_.size());
+
+                auto f = util::with_chunk_policy(
+                    hpx::parallel::execution::par(
+                        hpx::parallel::execution::task),
+                    chunking,
+                    [&](auto&& policy)
+                    {
+                        return hpx::parallel::for_loop(
+                            std::forward<decltype(policy)>(policy),
+                            std::size_t(0), state->elements_.size(),
+                            [state, p, ctx](std::size_t i)
+                            {
+                                state->results_[i] = p->eval(hpx::launch::sync,
+                                    state->elements_[i], ctx);
+                            });
+                    });
+
+                return f.then(hpx::launch::async,
+                    [state = std::move(state), chunking, ctx,
+                        bound_reduce = std::move(bound_reduce),
+                        initial = std::move(initial)](hpx::future<void>&& f)
+                    ->  primitive_argument_type
+                    {
+                        f.get();        // propagate exceptions
+
+                        primitive const* r =
+                            util::get_if<primitive>(&bound_reduce);
+
+                        // nil is used as the identity of the reduction
+                        auto op = [r, &ctx](primitive_argument_type const& lhs,
+                            primitive_argument_type const& rhs)
+                        ->  primitive_argument_type
+                        {
+                            if (!valid(lhs))
+                            {
+                                return rhs;
+                            }
+                            if (!valid(rhs))
+                            {
+                                return lhs;
+                            }
+
+                            primitive_arguments_type args;
+                            args.reserve(2);
+                            args.push_back(lhs);
+                            args.push_back(rhs);
+                            return r->eval(
+                                hpx::launch::sync, std::move(args), ctx);
+                        };
+
+                        auto result = util::with_chunk_policy(
+                            hpx::parallel::execution::par, chunking,
+                            [&](auto&& policy)
+                            {
+                                return hpx::parallel::reduce(
+                                    std::forward<decltype(policy)>(policy),
+                                    state->results_.begin(),
+                                    state->results_.end(),
+                                    primitive_argument_type{}, op);
+                            });
+
+                        return op(initial, result);
+                    });
+            }),
+            value_operand(operands[0], args, name_, codename_,
+                add_mode(ctx, eval_dont_evaluate_lambdas)),
+            list_operand(operands[1], args, name_, codename_, ctx),
+            value_operand(operands[2], args, name_, codename_,
+                add_mode(ctx, eval_dont_evaluate_lambdas)),
+            std::move(initial));
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    hpx::future<primitive_argument_type> parallel_for_each::eval(
+        primitive_arguments_type const& operands,
+        primitive_arguments_type const& args, eval_context ctx) const
+    {
+        std::size_t const min_operands = reduce_ ? 3 : 2;
+        std::size_t const max_operands = reduce_ ? 6 : 4;
+        if (operands.size() < min_operands || operands.size() > max_operands)
+        {
+            HPX_THROW_EXCEPTION(hpx::bad_parameter,
+                "parallel_for_each::eval",
+                generate_error_message(reduce_ ?
+                    "the parallel_reduce primitive requires between three "
+                        "and six operands" :
+                    "the parallel_for_each primitive requires between two "
+                        "and four operands"));
+        }
+
+        for (std::size_t i = 0; i != min_operands; ++i)
+        {
+            if (!valid(operands[i]))
+            {
+                HPX_THROW_EXCEPTION(hpx::bad_parameter,
+                    "parallel_for_each::eval",
+                    generate_error_message(
+                        "the parallel_for_each primitive requires that the "
+                            "arguments given by the operands array are "
+                            "valid"));
+            }
+        }
+
+        if (reduce_)
+        {
+            return reduce(operands, args, std::move(ctx));
+        }
+        return for_each(operands, args, std::move(ctx));
+    }
+}}}
@@ -4,10 +4,13 @@
 // file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
 
 #include <phylanx/config.hpp>
+#include <phylanx/execution_tree/primitives/detail/indexed_range.hpp>
 #include <phylanx/plugins/controls/parallel_map_operation.hpp>
 
 #include <hpx/include/lcos.hpp>
 #include <hpx/include/naming.hpp>
+#include <hpx/include/parallel_executor_parameters.hpp>
+#include <hpx/include/parallel_for_loop.hpp>
 #include <hpx/include/util.hpp>
 #include <hpx/throw_exception.hpp>
 
@@ -54,6 +57,57 @@ namespace phylanx { namespace execution_tree { namespace primitives
       : primitive_component_base(std::move(operands), name, codename)
     {}
 
+    ///////////////////////////////////////////////////////////////////////////
+    namespace detail
+    {
+        // keep the function, the lists, and the results alive while the
+        // parallel loop is running
+        struct parallel_map_state
+          : std::enable_shared_from_this<parallel_map_state>
+        {
+            explicit parallel_map_state(primitive_argument_type&& func)
+              : func_(std::move(func))
+            {}
+
+            hpx::future<primitive_argument_type> invoke(eval_context ctx)
+            {
+                primitive const* p = util::get_if<primitive>(&func_);
+
+                auto this_ = this->shared_from_this();
+                auto f = hpx::parallel::for_loop(
+                    hpx::parallel::execution::par(
+                        hpx::parallel::execution::task)
+                        .with(hpx::parallel::execution::auto_chunk_size()),
+                    std::size_t(0), results_.size(),
+                    [this_, p, ctx](std::size_t i)
+                    {
+                        // each invocation has its own argument set
+                        primitive_arguments_type args;
+                        args.reserve(this_->lists_.size());
+                        for (auto const& list : this_->lists_)
+                        {
+                            args.push_back(list[i]);
+                        }
+                        this_->results_[i] =
+                            p->eval(hpx::launch::sync, std::move(args), ctx);
+                    });
+
+                return f.then(hpx::launch::sync,
+                    [this_ = std::move(this_)](hpx::future<void>&& f)
+                    ->  primitive_argument_type
+                    {
+                        f.get();        // propagate exceptions
+                        return primitive_argument_type{
+                            std::move(this_->results_)};
+                    });
+            }
+
+            primitive_argument_type func_;
+            std::vector<indexed_range> lists_;
+            primitive_arguments_type results_;
+        };
+    }
+
     hpx::future<primitive_argument_type> parallel_map_operation::map_1(
         primitive_arguments_type const& operands,
         primitive_arguments_type const& args, eval_context ctx) const
@@ -74,27 +128,15 @@ namespace phylanx { namespace execution_tree { namespace primitives
                                 "object"));
                 }
 
-                // Concurrently evaluate all operations
-                std::vector<hpx::future<primitive_argument_type>,
-                    arguments_allocator<hpx::future<primitive_argument_type>>>
-                    result;
-                result.reserve(list.size());
-
-                for (auto && elem : list)
-                {
-                    // Evaluate function for each of the argument sets
-                    primitive_arguments_type args;
-                    args.emplace_back(std::move(elem));
-                    result.push_back(p->eval(std::move(args), ctx));
-                }
+                // Concurrently evaluate all operations, the iterations are
+                // split into chunks to avoid creating one HPX thread for each
+                // of the list elements
+                auto state = std::make_shared<detail::parallel_map_state>(
+                    std::move(bound_func));
+                state->lists_.emplace_back(std::move(list));
+                state->results_.resize(state->lists_[0].size());
 
-                return hpx::dataflow(hpx::launch::sync, hpx::util::unwrapping(
-                    [](primitive_arguments_type&& result)
-                    -> primitive_argument_type
-                    {
-                        return primitive_argument_type{std::move(result)};
-                    }),
-                    std::move(result));
+                return state->invoke(ctx);
             }),
             value_operand(operands_[0], args, name_, codename_,
                 add_mode(ctx, eval_dont_evaluate_lambdas)),
@@ -142,45 +184,19 @@ namespace phylanx { namespace execution_tree { namespace primitives
                     }
                 }
 
-                // Concurrently evaluate all operations
-                std::size_t numlists = lists.size();
-
-                std::vector<ir::range_iterator,
-                    arguments_allocator<ir::range_iterator>> iters;
-                iters.reserve(numlists);
-
-                for (auto const& j : lists)
+                // Concurrently evaluate all operations, the iterations are
+                // split into chunks to avoid creating one HPX thread for each
+                // of the list elements
+                auto state = std::make_shared<detail::parallel_map_state>(
+                    std::move(bound_func));
+                state->lists_.reserve(lists.size());
+                for (auto&& list : lists)
                 {
-                    iters.push_back(j.begin());
+                    state->lists_.emplace_back(std::move(list));
                 }
+                state->results_.resize(size);
 
-                std::vector<hpx::future<primitive_argument_type>,
-                    arguments_allocator<hpx::future<primitive_argument_type>>>
-                    result;
-                result.reserve(size);
-
-                for (std::size_t i = 0; i != size; ++i)
-                {
-                    primitive_arguments_type args;
-                    args.reserve(numlists);
-
-                    // Each invocation has its own argument set
-                    for (ir::range_iterator& j : iters)
-                    {
-                        args.push_back(*j++);
-                    }
-
-                    // Evaluate function for each of the argument sets
-                    result.push_back(p->eval(std::move(args), ctx));
-                }
-
-                return hpx::dataflow(hpx::launch::sync, hpx::util::unwrapping(
-                    [](primitive_arguments_type&& result)
-                    -> primitive_argument_type
-                    {
-                        return primitive_argument_type{std::move(result)};
-                    }),
-                    std::move(result));
+                return state->invoke(ctx);
             }),
             value_operand(operands_[0], args, name_, codename_,
                 add_mode(ctx,
@@ -0,0 +1,399 @@
+// Copyright (c) 2019 Hartmut Kaiser
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <phylanx/config.hpp>
+#include <phylanx/execution_tree/compiler/primitive_name.hpp>
+#include <phylanx/execution_tree/primitives/node_data_helpers.hpp>
+#include <phylanx/plugins/controls/vmap_operation.hpp>
+
+#include <hpx/include/lcos.hpp>
+#include <hpx/include/naming.hpp>
+#include <hpx/include/parallel_for_loop.hpp>
+#include <hpx/include/util.hpp>
+#include <hpx/throw_exception.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <set>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <blaze/Math.h>
+
+///////////////////////////////////////////////////////////////////////////////
+namespace phylanx { namespace execution_tree { namespace primitives
+{
+    ///////////////////////////////////////////////////////////////////////////
+    match_pattern_type const vmap_operation::match_data =
+    {
+        hpx::util::make_tuple("vmap",
+            std::vector<std::string>{"vmap(_1, _2, __arg(_3_lift, nil))"},
+            &create_vmap_operation, &create_primitive<vmap_operation>,
+            R"(func, a, lift
+            Args:
+
+                func (function) : a function that takes a single argument
+                a (array) : a 1-d or 2-d array, func is applied to each
+                    element (1-d) or to each row (2-d) of a
+                lift (bool, optional) : if true, func is invoked once for the
+                    whole array, if false, func is invoked once per element or
+                    row. If not given, func is invoked once for the whole
+                    array if it is composed of element-wise operations only.
+
+            Returns:
+
+                An array holding the results of applying `func` to each
+                element or row of `a`.
+
+            Examples:
+
+                vmap(lambda(x, x * x), [1, 2, 3])
+
+            Evaluates to [1, 4, 9])"
+            )
+    };
+
+    ///////////////////////////////////////////////////////////////////////////
+    vmap_operation::vmap_operation(
+            primitive_arguments_type&& operands,
+            std::string const& name, std::string const& codename)
+      : primitive_component_base(std::move(operands), name, codename)
+    {}
+
+    ///////////////////////////////////////////////////////////////////////////
+    namespace detail
+    {
+        // primitives that operate element-wise and preserve the shape of
+        // their arguments, a function composed of these only (and the
+        // arguments it was invoked with) can be applied to a whole array at
+        // once
+        std::set<std::string> const& elementwise_primitives()
+        {
+            static std::set<std::string> const primitives = {
+                "access-argument", "lambda",
+                "__add", "__sub", "__mul", "__div", "__minus",
+                "__eq", "__ne", "__lt", "__le", "__gt", "__ge",
+                "__and", "__or", "__not",
+                "absolute", "floor", "ceil", "trunc", "rint", "sqrt",
+                "invsqrt", "cbrt", "invcbrt", "exp", "exp2", "exp10", "log",
+                "log2", "log10", "sin", "cos", "tan", "sinh", "cosh", "tanh",
+                "arcsin", "arccos", "arctan", "arcsinh", "arccosh", "arctanh",
+                "erf", "erfc", "square", "sign",
+                "maximum", "minimum", "power", "sigmoid", "softplus",
+                "hard_sigmoid"
+            };
+            return primitives;
+        }
+
+        bool is_elementwise(topology const& t)
+        {
+            if (!t.name_.empty())
+            {
+                std::string type = compiler::extract_primitive_name(t.name_);
+                if (elementwise_primitives().count(type) == 0)
+                {
+                    return false;
+                }
+            }
+
+            return std::all_of(t.children_.begin(), t.children_.end(),
+                [](topology const& child) { return is_elementwise(child); });
+        }
+    }
+
+    bool vmap_operation::can_lift(primitive const* p) const
+    {
+        return detail::is_elementwise(p->expression_topology(
+            hpx::launch::sync, std::set<std::string>{},
+            std::set<std::string>{}));
+    }
+
+    primitive_argument_type vmap_operation::vmap_lifted(primitive const* p,
+        primitive_argument_type&& arg, eval_context ctx) const
+    {
+        std::size_t size = extract_numeric_value_dimensions(
+            arg, name_, codename_)[0];
+
+        auto result = p->eval(hpx::launch::sync, std::move(arg), ctx);
+
+        // the result must have the same leading dimension as the argument
+        if (extract_numeric_value_dimension(result, name_, codename_) == 0 ||
+            extract_numeric_value_dimensions(result, name_, codename_)[0] !=
+                size)
+        {
+            HPX_THROW_EXCEPTION(hpx::bad_parameter,
+                "vmap_operation::vmap_lifted",
+                generate_error_message(
+                    "the lifted function returned a value with a leading "
+                    "dimension different from the one of its argument"));
+        }
+        return result;
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    // all results must have the same shape, scalars are combined into a
+    // vector, vectors are combined into a matrix
+    template <typename T>
+    primitive_argument_type vmap_operation::combine_results(
+        primitive_arguments_type&& results) const
+    {
+        std::size_t dim =
+            extract_numeric_value_dimension(results[0], name_, codename_);
+        std::size_t size =
+            extract_numeric_value_dimensions(results[0], name_, codename_)[0];
+
+        if (dim == 0)
+        {
+            blaze::DynamicVector<T> result(results.size());
+            for (std::size_t i = 0; i != results.size(); ++i)
+            {
+                if (extract_numeric_value_dimension(
+                        results[i], name_, codename_) != 0)
+                {
+                    HPX_THROW_EXCEPTION(hpx::bad_parameter,
+                        "vmap_operation::combine_results",
+                        generate_error_message(
+                            "all invocations of the function must return "
+                            "values of the same shape"));
+                }
+                result[i] = extract_scalar_data<T>(
+                    std::move(results[i]), name_, codename_);
+            }
+            return primitive_argument_type{std::move(result)};
+        }
+
+        if (dim == 1)
+        {
+            blaze::DynamicMatrix<T> result(results.size(), size);
+            for (std::size_t i = 0; i != results.size(); ++i)
+            {
+                auto r = extract_node_data<T>(
+                    std::move(results[i]), name_, codename_);
+                if (r.num_dimensions() != 1 || r.size() != size)
+                {
+                    HPX_THROW_EXCEPTION(hpx::bad_parameter,
+                        "vmap_operation::combine_results",
+                        generate_error_message(
+                            "all invocations of the function must return "
+                            "values of the same shape"));
+                }
+                blaze::row(result, i) = blaze::trans(r.vector());
+            }
+            return primitive_argument_type{std::move(result)};
+        }
+
+        HPX_THROW_EXCEPTION(hpx::bad_parameter,
+            "vmap_operation::combine_results",
+            generate_error_message(
+                "the invoked function returned an unexpected type (should "
+                "be a scalar or a vector value)"));
+    }
+
+    // the type of the combined result is the common type of the results of
+    // all invocations (as for a lifted function), not the type of the array
+    // the function was applied to
+    primitive_argument_type vmap_operation::combine_results(
+        primitive_arguments_type&& results) const
+    {
+        switch (extract_common_type(results))
+        {
+        case node_data_type_bool:
+            return combine_results<std::uint8_t>(std::move(results));
+
+        case node_data_type_int64:
+            return combine_results<std::int64_t>(std::move(results));
+
+        case node_data_type_unknown: HPX_FALLTHROUGH;
+        case node_data_type_double:
+            return combine_results<double>(std::move(results));
+
+        default:
+            break;
+        }
+
+        HPX_THROW_EXCEPTION(hpx::bad_parameter,
+            "vmap_operation::combine_results",
+            generate_error_message(
+                "the invoked function returned a value of unsupported type"));
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    template <typename T>
+    primitive_argument_type vmap_operation::vmap_1d(primitive const* p,
+        ir::node_data<T>&& arg, eval_context ctx) const
+    {
+        auto v = arg.vector();
+        if (v.size() == 0)
+        {
+            return primitive_argument_type{blaze::DynamicVector<T>{}};
+        }
+
+        primitive_arguments_type results(v.size());
+        hpx::parallel::for_loop(hpx::parallel::execution::par,
+            std::size_t(0), v.size(),
+            [&](std::size_t i)
+            {
+                results[i] = p->eval(hpx::launch::sync,
+                    primitive_argument_type{v[i]}, ctx);
+
+                if (extract_numeric_value_dimension(
+                        results[i], name_, codename_) != 0)
+                {
+                    HPX_THROW_EXCEPTION(hpx::bad_parameter,
+                        "vmap_operation::vmap_1d",
+                        generate_error_message(
+                            "the invoked function returned an unexpected "
+                            "type (should be a scalar value)"));
+                }
+            });
+
+        return combine_results(std::move(results));
+    }
+
+    template <typename T>
+    primitive_argument_type vmap_operation::vmap_2d(primitive const* p,
+        ir::node_data<T>&& arg, eval_context ctx) const
+    {
+        auto m = arg.matrix();
+        if (m.rows() == 0)
+        {
+            return primitive_argument_type{blaze::DynamicVector<T>{}};
+        }
+
+        primitive_arguments_type results(m.rows());
+        hpx::parallel::for_loop(hpx::parallel::execution::par,
+            std::size_t(0), m.rows(),
+            [&](std::size_t i)
+            {
+                blaze::DynamicVector<T> row{blaze::trans(blaze::row(m, i))};
+                results[i] = p->eval(hpx::launch::sync,
+                    primitive_argument_type{std::move(row)}, ctx);
+            });
+
+        return combine_results(std::move(results));
+    }
+
+    template <typename T>
+    primitive_argument_type vmap_operation::vmap(primitive const* p,
+        ir::node_data<T>&& arg, eval_context ctx) const
+    {
+        switch (arg.num_dimensions())
+        {
+        case 1:
+            return vmap_1d(p, std::move(arg), std::move(ctx));
+
+        case 2:
+            return vmap_2d(p, std::move(arg), std::move(ctx));
+
+        default:
+            break;
+        }
+
+        HPX_THROW_EXCEPTION(hpx::bad_parameter,
+            "vmap_operation::vmap",
+            generate_error_message(
+                "the second argument to vmap must be a 1-d or 2-d array"));
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    hpx::future<primitive_argument_type> vmap_operation::eval(
+        primitive_arguments_type const& operands,
+        primitive_arguments_type const& args, eval_context ctx) const
+    {
+        if (operands.size() < 2 || operands.size() > 3)
+        {
+            HPX_THROW_EXCEPTION(hpx::bad_parameter,
+                "vmap_operation::eval",
+                generate_error_message(
+                    "the vmap primitive requires two or three operands"));
+        }
+
+        if (!valid(operands[0]) || !valid(operands[1]))
+        {
+            HPX_THROW_EXCEPTION(hpx::bad_parameter,
+                "vmap_operation::eval",
+                generate_error_message(
+                    "the vmap primitive requires that the arguments given "
+                        "by the operands array are valid"));
+        }
+
+        primitive_argument_type lift;
+        if (operands.size() == 3 && valid(operands[2]))
+        {
+            lift = value_operand_sync(
+                operands[2], args, name_, codename_, ctx);
+        }
+
+        auto this_ = this->shared_from_this();
+        return hpx::dataflow(hpx::launch::sync, hpx::util::unwrapping(
+            [this_ = std::move(this_), lift = std::move(lift), ctx](
+                    primitive_argument_type&& bound_func,
+                    primitive_argument_type&& arg)
+            ->  primitive_argument_type
+            {
+                primitive const* p = util::get_if<primitive>(&bound_func);
+                if (p == nullptr)
+                {
+                    HPX_THROW_EXCEPTION(hpx::bad_parameter,
+                        "vmap_operation::eval",
+                        this_->generate_error_message(
+                            "the first argument to vmap must be an invocable "
+                                "object"));
+                }
+
+                if (!is_numeric_operand(arg))
+                {
+                    HPX_THROW_EXCEPTION(hpx::bad_parameter,
+                        "vmap_operation::eval",
+                        this_->generate_error_message(
+                            "the second argument to vmap must be an array"));
+                }
+
+                bool do_lift = valid(lift) ?
+                    bool(extract_scalar_boolean_value(
+                        lift, this_->name_, this_->codename_)) :
+                    this_->can_lift(p);
+
+                if (do_lift)
+                {
+                    return this_->vmap_lifted(p, std::move(arg), ctx);
+                }
+
+                switch (extract_common_type(arg))
+                {
+                case node_data_type_bool:
+                    return this_->vmap(p,
+                        extract_boolean_value_strict(std::move(arg),
+                            this_->name_, this_->codename_), ctx);
+
+                case node_data_type_int64:
+                    return this_->vmap(p,
+                        extract_integer_value_strict(std::move(arg),
+                            this_->name_, this_->codename_), ctx);
+
+                case node_data_type_unknown: HPX_FALLTHROUGH;
+                case node_data_type_double:
+                    return this_->vmap(p,
+                        extract_numeric_value(std::move(arg),
+                            this_->name_, this_->codename_), ctx);
+
+                default:
+                    break;
+                }
+
+                HPX_THROW_EXCEPTION(hpx::bad_parameter,
+                    "vmap_operation::eval",
+                    this_->generate_error_message(
+                        "the second argument to vmap has an unsupported "
+                        "type"));
+            }),
+            value_operand(operands[0], args, name_, codename_,
+                add_mode(ctx, eval_dont_evaluate_lambdas)),
+            value_operand(operands[1], args, name_, codename_, ctx));
+    }
+}}}
@@ -5,6 +5,7 @@
 // file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
 
 #include <phylanx/config.hpp>
+#include <phylanx/execution_tree/primitives/detail/batched_gemm.hpp>
 #include <phylanx/execution_tree/primitives/node_data_helpers.hpp>
 #include <phylanx/ir/node_data.hpp>
 #include <phylanx/plugins/keras_support/batch_dot_operation.hpp>
@@ -178,12 +179,17 @@ namespace phylanx { namespace execution_tree { namespace primitives
         auto m1 = lhs.matrix();
         auto m2 = rhs.matrix();
 
-        blaze::DynamicMatrix<T> result(m1.rows(), 1);
+        blaze::DynamicMatrix<T> result(m1.rows(), 1, T(0));
 
-        for (std::size_t i = 0; i != m1.rows(); ++i)
-
-            blaze::row(result, i) =
-                blaze::dot(blaze::row(m1, i), blaze::row(m2, i));
+        if (m1.columns() != 0)
+        {
+            detail::batched_gemm(m1.rows(),
+                [&](std::size_t i) { return detail::row_view(m1, i); },
+                [&](std::size_t i) {
+                    return detail::column_view_of_row(m2, i);
+                },
+                [&](std::size_t i) { return detail::row_view(result, i); });
+        }
 
         return primitive_argument_type{std::move(result)};
     }
@@ -196,11 +202,15 @@ namespace phylanx { namespace execution_tree { namespace primitives
         auto m = lhs.matrix();
         auto t = rhs.tensor();
 
-        blaze::DynamicMatrix<T> result(t.pages(), t.columns());
-
-        for (std::size_t i = 0; i != m.rows(); ++i)
+        blaze::DynamicMatrix<T> result(t.pages(), t.columns(), T(0));
 
-            blaze::row(result, i) = blaze::row(m, i) * blaze::pageslice(t, i);
+        if (m.columns() != 0 && t.columns() != 0)
+        {
+            detail::batched_gemm(m.rows(),
+                [&](std::size_t i) { return detail::row_view(m, i); },
+                [&](std::size_t i) { return detail::page_view(t, i); },
+                [&](std::size_t i) { return detail::row_view(result, i); });
+        }
 
         return primitive_argument_type{std::move(result)};
     }
@@ -212,11 +222,15 @@ namespace phylanx { namespace execution_tree { namespace primitives
         auto m = lhs.matrix();
         auto t = rhs.tensor();
 
-        blaze::DynamicMatrix<T> result(t.pages(), t.rows());
+        blaze::DynamicMatrix<T> result(t.pages(), t.rows(), T(0));
 
-        for (std::size_t i = 0; i != t.pages(); ++i)
-            blaze::row(result, i) =
-                blaze::row(m, i) * blaze::trans(blaze::pageslice(t, i));
+        if (m.columns() != 0 && t.rows() != 0)
+        {
+            detail::batched_gemm(t.pages(),
+                [&](std::size_t i) { return detail::row_view(m, i); },
+                [&](std::size_t i) { return detail::page_view(t, i).trans(); },
+                [&](std::size_t i) { return detail::row_view(result, i); });
+        }
 
         return primitive_argument_type{std::move(result)};
     }
@@ -292,12 +306,15 @@ namespace phylanx { namespace execution_tree { namespace primitives
         auto m = rhs.matrix();
         auto t = lhs.tensor();
 
-        blaze::DynamicMatrix<T> result(t.pages(), t.rows());
-
-        for (std::size_t i = 0; i != t.pages(); ++i)
+        blaze::DynamicMatrix<T> result(t.pages(), t.rows(), T(0));
 
-            blaze::row(result, i) =
-                blaze::row(m, i) * blaze::trans(blaze::pageslice(t, i));
+        if (m.columns() != 0 && t.rows() != 0)
+        {
+            detail::batched_gemm(t.pages(),
+                [&](std::size_t i) { return detail::row_view(m, i); },
+                [&](std::size_t i) { return detail::page_view(t, i).trans(); },
+                [&](std::size_t i) { return detail::row_view(result, i); });
+        }
 
         return primitive_argument_type{std::move(result)};
     }
@@ -309,10 +326,15 @@ namespace phylanx { namespace execution_tree { namespace primitives
         auto m = rhs.matrix();
         auto t = lhs.tensor();
 
-        blaze::DynamicMatrix<T> result(t.pages(), t.columns());
+        blaze::DynamicMatrix<T> result(t.pages(), t.columns(), T(0));
 
-        for (std::size_t i = 0; i != t.pages(); ++i)
-            blaze::row(result, i) = blaze::row(m, i) * blaze::pageslice(t, i);
+        if (m.columns() != 0 && t.columns() != 0)
+        {
+            detail::batched_gemm(t.pages(),
+                [&](std::size_t i) { return detail::row_view(m, i); },
+                [&](std::size_t i) { return detail::page_view(t, i); },
+                [&](std::size_t i) { return detail::row_view(result, i); });
+        }
 
         return primitive_argument_type{std::move(result)};
     }
@@ -338,12 +360,17 @@ namespace phylanx { namespace execution_tree { namespace primitives
         auto t1 = lhs.tensor();
         auto t2 = rhs.tensor();
 
-        blaze::DynamicTensor<T> result(t1.pages(), t1.rows(), t2.columns());
+        blaze::DynamicTensor<T> result(
+            t1.pages(), t1.rows(), t2.columns(), T(0));
 
-        for (std::size_t i = 0; i != t1.pages(); ++i)
-
-            blaze::pageslice(result, i) =
-                blaze::pageslice(t1, i) * blaze::pageslice(t2, i);
+        if (result.rows() != 0 && result.columns() != 0 &&
+            t1.columns() != 0)
+        {
+            detail::batched_gemm(t1.pages(),
+                [&](std::size_t i) { return detail::page_view(t1, i); },
+                [&](std::size_t i) { return detail::page_view(t2, i); },
+                [&](std::size_t i) { return detail::page_view(result, i); });
+        }
 
         return primitive_argument_type{std::move(result)};
     }
@@ -355,12 +382,17 @@ namespace phylanx { namespace execution_tree { namespace primitives
         auto t1 = lhs.tensor();
         auto t2 = rhs.tensor();
 
-        blaze::DynamicTensor<T> result(t1.pages(), t1.columns(), t2.columns());
+        blaze::DynamicTensor<T> result(
+            t1.pages(), t1.columns(), t2.columns(), T(0));
 
-        for (std::size_t i = 0; i != t1.pages(); ++i)
-
-            blaze::pageslice(result, i) =
-                blaze::trans(blaze::pageslice(t1, i)) * blaze::pageslice(t2, i);
+        if (result.rows() != 0 && result.columns() != 0 &&
+            t1.rows() != 0)
+        {
+            detail::batched_gemm(t1.pages(),
+                [&](std::size_t i) { return detail::page_view(t1, i).trans(); },
+                [&](std::size_t i) { return detail::page_view(t2, i); },
+                [&](std::size_t i) { return detail::page_view(result, i); });
+        }
 
         return primitive_argument_type{std::move(result)};
     }
@@ -372,12 +404,17 @@ namespace phylanx { namespace execution_tree { namespace primitives
         auto t1 = lhs.tensor();
         auto t2 = rhs.tensor();
 
-        blaze::DynamicTensor<T> result(t1.pages(), t1.rows(), t2.rows());
+        blaze::DynamicTensor<T> result(
+            t1.pages(), t1.rows(), t2.rows(), T(0));
 
-        for (std::size_t i = 0; i != t1.pages(); ++i)
-
-            blaze::pageslice(result, i) =
-                blaze::pageslice(t1, i) * blaze::trans(blaze::pageslice(t2, i));
+        if (result.rows() != 0 && result.columns() != 0 &&
+            t1.columns() != 0)
+        {
+            detail::batched_gemm(t1.pages(),
+                [&](std::size_t i) { return detail::page_view(t1, i); },
+                [&](std::size_t i) { return detail::page_view(t2, i).trans(); },
+                [&](std::size_t i) { return detail::page_view(result, i); });
+        }
 
         return primitive_argument_type{std::move(result)};
     }
@@ -389,12 +426,17 @@ namespace phylanx { namespace execution_tree { namespace primitives
         auto t1 = lhs.tensor();
         auto t2 = rhs.tensor();
 
-        blaze::DynamicTensor<T> result(t1.pages(), t1.columns(), t2.rows());
+        blaze::DynamicTensor<T> result(
+            t1.pages(), t1.columns(), t2.rows(), T(0));
 
-        for (std::size_t i = 0; i != t1.pages(); ++i)
-
-            blaze::pageslice(result, i) =
-                blaze::trans(blaze::pageslice(t2, i) * blaze::pageslice(t1, i));
+        if (result.rows() != 0 && result.columns() != 0 &&
+            t1.rows() != 0)
+        {
+            detail::batched_gemm(t1.pages(),
+                [&](std::size_t i) { return detail::page_view(t1, i).trans(); },
+                [&](std::size_t i) { return detail::page_view(t2, i).trans(); },
+                [&](std::size_t i) { return detail::page_view(result, i); });
+        }
 
         return primitive_argument_type{std::move(result)};
     }
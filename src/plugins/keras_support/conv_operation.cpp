@@ -0,0 +1,564 @@
+// Copyright (c) 2019 Hartmut Kaiser
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <phylanx/config.hpp>
+#include <phylanx/execution_tree/compiler/primitive_name.hpp>
+#include <phylanx/execution_tree/primitives/detail/sliding_window.hpp>
+#include <phylanx/execution_tree/primitives/node_data_helpers.hpp>
+#include <phylanx/ir/node_data.hpp>
+#include <phylanx/plugins/keras_support/conv_operation.hpp>
+
+#include <hpx/include/lcos.hpp>
+#include <hpx/include/naming.hpp>
+#include <hpx/include/util.hpp>
+#include <hpx/throw_exception.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <blaze/Math.h>
+
+#if defined(PHYLANX_HAVE_BLAZE_TENSOR)
+#include <blaze_tensor/Math.h>
+#endif
+
+///////////////////////////////////////////////////////////////////////////////
+namespace phylanx { namespace execution_tree { namespace primitives
+{
+    ///////////////////////////////////////////////////////////////////////////
+    std::vector<match_pattern_type> const conv_operation::match_data =
+    {
+        match_pattern_type{"conv1d",
+            std::vector<std::string>{
+                "conv1d(_1, _2, __arg(_3_strides, nil), "
+                    "__arg(_4_padding, nil), __arg(_5_dilation_rate, nil))"},
+            &create_conv1d_operation, &create_primitive<conv_operation>, R"(
+            x, kernel, strides, padding, dilation_rate
+            Args:
+
+                x (array) : the input, either a vector, a matrix of shape
+                    (steps, channels), or a tensor of shape
+                    (batch, steps, channels)
+                kernel (array) : a vector if x is a vector, otherwise a
+                    tensor of shape (kernel_size, channels, filters)
+                strides (optional, int) : the stride, defaults to 1
+                padding (optional, string) : 'valid' (the default), 'same',
+                    or 'causal'
+                dilation_rate (optional, int) : the dilation rate, defaults
+                    to 1
+
+            Returns:
+
+            The 1-D convolution of `x` with `kernel`, the result has the
+            shape (batch, new_steps, filters) (without the batch dimension
+            if `x` is a matrix, a vector if `x` is a vector).)"
+        },
+        match_pattern_type{"conv2d",
+            std::vector<std::string>{
+                "conv2d(_1, _2, __arg(_3_strides, nil), "
+                    "__arg(_4_padding, nil), __arg(_5_dilation_rate, nil))"},
+            &create_conv2d_operation, &create_primitive<conv_operation>, R"(
+            x, kernel, strides, padding, dilation_rate
+            Args:
+
+                x (array) : the (single channel) input, either a matrix of
+                    shape (rows, columns) or a tensor of shape
+                    (batch, rows, columns)
+                kernel (matrix) : the kernel of shape
+                    (kernel_rows, kernel_columns)
+                strides (optional, int or tuple of 2 ints) : the strides,
+                    defaults to 1
+                padding (optional, string) : 'valid' (the default), or
+                    'same'
+                dilation_rate (optional, int or tuple of 2 ints) : the
+                    dilation rate, defaults to 1
+
+            Returns:
+
+            The 2-D convolution of `x` with `kernel`, the result has the
+            shape (batch, new_rows, new_columns) (without the batch
+            dimension if `x` is a matrix).)"
+        }
+    };
+
+    ///////////////////////////////////////////////////////////////////////////
+    namespace detail
+    {
+        conv_operation::conv_mode extract_conv_mode(std::string const& name)
+        {
+            compiler::primitive_name_parts name_parts;
+            if (!compiler::parse_primitive_name(name, name_parts))
+            {
+                if (name.find("conv2d") != std::string::npos)
+                {
+                    return conv_operation::conv_mode_2d;
+                }
+                return conv_operation::conv_mode_1d;
+            }
+
+            if (name_parts.primitive == "conv2d")
+            {
+                return conv_operation::conv_mode_2d;
+            }
+            return conv_operation::conv_mode_1d;
+        }
+
+        ///////////////////////////////////////////////////////////////////////
+        // Compute the output rows [first, last) of the 1-D convolution of x
+        // (steps, channels) with the given weights (kernel_size * channels,
+        // filters).
+        template <typename Input, typename Output>
+        void conv1d_rows(Input const& x,
+            blaze::DynamicMatrix<double> const& weights, Output& out,
+            execution_tree::detail::window_geometry const& g,
+            std::size_t first, std::size_t last)
+        {
+            std::size_t const channels = x.columns();
+            std::size_t const filters = weights.columns();
+
+            if (g.stride_ == 1)
+            {
+                // accumulate the contribution of every kernel element, the
+                // corresponding input rows are contiguous
+                blaze::submatrix(out, first, 0, last - first, filters) = 0.0;
+                for (std::size_t k = 0; k != g.window_; ++k)
+                {
+                    auto const range = g.valid_outputs(k);
+                    std::size_t const begin = (std::max)(range[0], first);
+                    std::size_t const end = (std::min)(range[1], last);
+                    if (begin >= end)
+                    {
+                        continue;
+                    }
+
+                    blaze::submatrix(out, begin, 0, end - begin, filters) +=
+                        blaze::serial(
+                            blaze::submatrix(x,
+                                std::size_t(g.input_index(begin, k)), 0,
+                                end - begin, channels) *
+                            blaze::submatrix(weights, k * channels, 0,
+                                channels, filters));
+                }
+                return;
+            }
+
+            // gather the input windows (im2col) and evaluate a single product
+            blaze::DynamicMatrix<double> windows(
+                last - first, g.window_ * channels, 0.0);
+            for (std::size_t i = first; i != last; ++i)
+            {
+                auto window = blaze::row(windows, i - first);
+                for (std::size_t k = 0; k != g.window_; ++k)
+                {
+                    std::ptrdiff_t const index = g.input_index(i, k);
+                    if (g.is_valid(index))
+                    {
+                        blaze::subvector(window, k * channels, channels) =
+                            blaze::row(x, std::size_t(index));
+                    }
+                }
+            }
+
+            blaze::submatrix(out, first, 0, last - first, filters) =
+                blaze::serial(windows * weights);
+        }
+
+        ///////////////////////////////////////////////////////////////////////
+        // Compute the output rows [first, last) of the 2-D convolution of x
+        // with the row-wise flattened kernel.
+        template <typename Input, typename Output>
+        void conv2d_rows(Input const& x,
+            blaze::DynamicVector<double> const& weights, Output& out,
+            execution_tree::detail::window_geometry const& rows,
+            execution_tree::detail::window_geometry const& columns,
+            std::size_t first, std::size_t last)
+        {
+            std::size_t const out_columns = columns.output_size_;
+
+            if (rows.stride_ == 1 && columns.stride_ == 1)
+            {
+                // accumulate the contribution of every kernel element
+                blaze::submatrix(out, first, 0, last - first, out_columns) =
+                    0.0;
+                for (std::size_t ki = 0; ki != rows.window_; ++ki)
+                {
+                    auto const row_range = rows.valid_outputs(ki);
+                    std::size_t const begin = (std::max)(row_range[0], first);
+                    std::size_t const end = (std::min)(row_range[1], last);
+                    if (begin >= end)
+                    {
+                        continue;
+                    }
+
+                    for (std::size_t kj = 0; kj != columns.window_; ++kj)
+                    {
+                        auto const column_range = columns.valid_outputs(kj);
+                        if (column_range[0] >= column_range[1])
+                        {
+                            continue;
+                        }
+
+                        std::size_t const n = column_range[1] - column_range[0];
+                        blaze::submatrix(out, begin, column_range[0],
+                            end - begin, n) +=
+                            weights[ki * columns.window_ + kj] *
+                            blaze::submatrix(x,
+                                std::size_t(rows.input_index(begin, ki)),
+                                std::size_t(
+                                    columns.input_index(column_range[0], kj)),
+                                end - begin, n);
+                    }
+                }
+                return;
+            }
+
+            // gather the input windows (im2col), every output element
+            // corresponds to one row
+            blaze::DynamicMatrix<double> windows(
+                (last - first) * out_columns, weights.size(), 0.0);
+            for (std::size_t i = first; i != last; ++i)
+            {
+                for (std::size_t j = 0; j != out_columns; ++j)
+                {
+                    auto window =
+                        blaze::row(windows, (i - first) * out_columns + j);
+                    for (std::size_t ki = 0; ki != rows.window_; ++ki)
+                    {
+                        std::ptrdiff_t const ri = rows.input_index(i, ki);
+                        if (!rows.is_valid(ri))
+                        {
+                            continue;
+                        }
+                        for (std::size_t kj = 0; kj != columns.window_; ++kj)
+                        {
+                            std::ptrdiff_t const ci =
+                                columns.input_index(j, kj);
+                            if (columns.is_valid(ci))
+                            {
+                                window[ki * columns.window_ + kj] =
+                                    x(std::size_t(ri), std::size_t(ci));
+                            }
+                        }
+                    }
+                }
+            }
+
+            blaze::DynamicVector<double> values =
+                blaze::serial(windows * weights);
+            for (std::size_t i = first; i != last; ++i)
+            {
+                blaze::row(out, i) = blaze::trans(blaze::subvector(
+                    values, (i - first) * out_columns, out_columns));
+            }
+        }
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    conv_operation::conv_operation(primitive_arguments_type&& operands,
+            std::string const& name, std::string const& codename)
+      : primitive_component_base(std::move(operands), name, codename)
+      , mode_(detail::extract_conv_mode(name_))
+    {}
+
+    ///////////////////////////////////////////////////////////////////////////
+    conv_operation::parameters conv_operation::extract_parameters(
+        primitive_arguments_type const& args, std::size_t dims) const
+    {
+        primitive_argument_type const none;
+
+        parameters p;
+        p.strides_ = execution_tree::detail::extract_window_sizes(
+            args.size() > 2 ? args[2] : none, dims, 1, "strides", name_,
+            codename_);
+        p.dilation_ = execution_tree::detail::extract_window_sizes(
+            args.size() > 4 ? args[4] : none, dims, 1, "dilation rate",
+            name_, codename_);
+
+        p.padding_ = execution_tree::detail::padding_mode::valid;
+        if (args.size() > 3 && valid(args[3]))
+        {
+            std::string padding =
+                extract_string_value(args[3], name_, codename_);
+            if (!execution_tree::detail::parse_padding_mode(
+                    padding, p.padding_) ||
+                (dims != 1 &&
+                    p.padding_ == execution_tree::detail::padding_mode::causal))
+            {
+                HPX_THROW_EXCEPTION(hpx::bad_parameter,
+                    "conv_operation::extract_parameters",
+                    generate_error_message(
+                        "unknown padding '" + padding + "', expected " +
+                        (dims == 1 ? "'valid', 'same', or 'causal'" :
+                                     "'valid', or 'same'")));
+            }
+        }
+        return p;
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    primitive_argument_type conv_operation::conv1d_vector(
+        ir::node_data<double>&& x, ir::node_data<double>&& kernel,
+        parameters const& p) const
+    {
+        auto v = x.vector();
+        auto w = kernel.vector();
+
+        auto const g = execution_tree::detail::make_window_geometry(
+            v.size(), w.size(), p.strides_[0], p.dilation_[0], p.padding_);
+
+        blaze::DynamicVector<double> result(g.output_size_, 0.0);
+        for (std::size_t k = 0; k != g.window_; ++k)
+        {
+            auto const range = g.valid_outputs(k);
+            if (range[0] >= range[1])
+            {
+                continue;
+            }
+
+            if (g.stride_ == 1)
+            {
+                std::size_t const n = range[1] - range[0];
+                blaze::subvector(result, range[0], n) += w[k] *
+                    blaze::subvector(
+                        v, std::size_t(g.input_index(range[0], k)), n);
+            }
+            else
+            {
+                for (std::size_t i = range[0]; i != range[1]; ++i)
+                {
+                    result[i] += w[k] * v[std::size_t(g.input_index(i, k))];
+                }
+            }
+        }
+
+        return primitive_argument_type{std::move(result)};
+    }
+
+    primitive_argument_type conv_operation::conv1d_channels(
+        ir::node_data<double>&& x, ir::node_data<double>&& kernel,
+        parameters const& p) const
+    {
+#if defined(PHYLANX_HAVE_BLAZE_TENSOR)
+        auto k = kernel.tensor();
+
+        std::size_t const steps = x.dimension(x.num_dimensions() - 2);
+        std::size_t const channels = k.rows();
+        std::size_t const filters = k.columns();
+
+        if (x.dimension(x.num_dimensions() - 1) != channels)
+        {
+            HPX_THROW_EXCEPTION(hpx::bad_parameter,
+                "conv_operation::conv1d_channels",
+                generate_error_message(
+                    "the number of input channels of the kernel does not "
+                    "match the number of channels of the input"));
+        }
+
+        // flatten the kernel into a (kernel_size * channels, filters) matrix
+        blaze::DynamicMatrix<double> weights(k.pages() * channels, filters);
+        for (std::size_t i = 0; i != k.pages(); ++i)
+        {
+            blaze::submatrix(weights, i * channels, 0, channels, filters) =
+                blaze::pageslice(k, i);
+        }
+
+        auto const g = execution_tree::detail::make_window_geometry(steps,
+            k.pages(), p.strides_[0], p.dilation_[0], p.padding_);
+
+        std::size_t const work_per_row = weights.rows() * filters;
+
+        if (x.num_dimensions() == 2)
+        {
+            auto m = x.matrix();
+            blaze::DynamicMatrix<double> result(g.output_size_, filters);
+
+            execution_tree::detail::for_each_window_block(1, g.output_size_,
+                work_per_row,
+                [&](std::size_t, std::size_t first, std::size_t last)
+                {
+                    detail::conv1d_rows(m, weights, result, g, first, last);
+                });
+
+            return primitive_argument_type{std::move(result)};
+        }
+
+        auto t = x.tensor();
+        blaze::DynamicTensor<double> result(
+            t.pages(), g.output_size_, filters);
+
+        execution_tree::detail::for_each_window_block(t.pages(),
+            g.output_size_, work_per_row,
+            [&](std::size_t batch, std::size_t first, std::size_t last)
+            {
+                auto out = blaze::pageslice(result, batch);
+                detail::conv1d_rows(blaze::pageslice(t, batch), weights, out,
+                    g, first, last);
+            });
+
+        return primitive_argument_type{std::move(result)};
+#else
+        HPX_THROW_EXCEPTION(hpx::bad_parameter,
+            "conv_operation::conv1d_channels",
+            generate_error_message(
+                "convolutions of multi-channel inputs require support for "
+                "tensors"));
+#endif
+    }
+
+    primitive_argument_type conv_operation::conv1d(ir::node_data<double>&& x,
+        ir::node_data<double>&& kernel, parameters const& p) const
+    {
+        if (x.num_dimensions() == 1 && kernel.num_dimensions() == 1)
+        {
+            return conv1d_vector(std::move(x), std::move(kernel), p);
+        }
+
+        if ((x.num_dimensions() == 2 || x.num_dimensions() == 3) &&
+            kernel.num_dimensions() == 3)
+        {
+            return conv1d_channels(std::move(x), std::move(kernel), p);
+        }
+
+        HPX_THROW_EXCEPTION(hpx::bad_parameter, "conv_operation::conv1d",
+            generate_error_message(
+                "conv1d requires either a vector input and a vector kernel, "
+                "or an input of shape (batch, steps, channels) or "
+                "(steps, channels) and a kernel of shape "
+                "(kernel_size, channels, filters)"));
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    primitive_argument_type conv_operation::conv2d(ir::node_data<double>&& x,
+        ir::node_data<double>&& kernel, parameters const& p) const
+    {
+        if ((x.num_dimensions() != 2 && x.num_dimensions() != 3) ||
+            kernel.num_dimensions() != 2)
+        {
+            HPX_THROW_EXCEPTION(hpx::bad_parameter, "conv_operation::conv2d",
+                generate_error_message(
+                    "conv2d requires an input of shape (batch, rows, columns) "
+                    "or (rows, columns) and a kernel of shape "
+                    "(kernel_rows, kernel_columns)"));
+        }
+
+        auto k = kernel.matrix();
+
+        // flatten the kernel row-wise
+        blaze::DynamicVector<double> weights(k.rows() * k.columns());
+        for (std::size_t i = 0; i != k.rows(); ++i)
+        {
+            blaze::subvector(weights, i * k.columns(), k.columns()) =
+                blaze::trans(blaze::row(k, i));
+        }
+
+        std::size_t const dims = x.num_dimensions();
+        auto const rows = execution_tree::detail::make_window_geometry(
+            x.dimension(dims - 2), k.rows(), p.strides_[0], p.dilation_[0],
+            p.padding_);
+        auto const columns = execution_tree::detail::make_window_geometry(
+            x.dimension(dims - 1), k.columns(), p.strides_[1], p.dilation_[1],
+            p.padding_);
+
+        std::size_t const work_per_row = columns.output_size_ * weights.size();
+
+        if (dims == 2)
+        {
+            auto m = x.matrix();
+            blaze::DynamicMatrix<double> result(
+                rows.output_size_, columns.output_size_);
+
+            execution_tree::detail::for_each_window_block(1,
+                rows.output_size_, work_per_row,
+                [&](std::size_t, std::size_t first, std::size_t last)
+                {
+                    detail::conv2d_rows(
+                        m, weights, result, rows, columns, first, last);
+                });
+
+            return primitive_argument_type{std::move(result)};
+        }
+
+#if defined(PHYLANX_HAVE_BLAZE_TENSOR)
+        auto t = x.tensor();
+        blaze::DynamicTensor<double> result(
+            t.pages(), rows.output_size_, columns.output_size_);
+
+        execution_tree::detail::for_each_window_block(t.pages(),
+            rows.output_size_, work_per_row,
+            [&](std::size_t batch, std::size_t first, std::size_t last)
+            {
+                auto out = blaze::pageslice(result, batch);
+                detail::conv2d_rows(blaze::pageslice(t, batch), weights, out,
+                    rows, columns, first, last);
+            });
+
+        return primitive_argument_type{std::move(result)};
+#else
+        HPX_THROW_EXCEPTION(hpx::bad_parameter, "conv_operation::conv2d",
+            generate_error_message(
+                "batched convolutions require support for tensors"));
+#endif
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    hpx::future<primitive_argument_type> conv_operation::eval(
+        primitive_arguments_type const& operands,
+        primitive_arguments_type const& args, eval_context ctx) const
+    {
+        if (operands.size() < 2 || operands.size() > 5)
+        {
+            HPX_THROW_EXCEPTION(hpx::bad_parameter,
+                "conv_operation::eval",
+                generate_error_message(
+                    "the conv_operation primitive requires between two and "
+                    "five operands"));
+        }
+
+        if (!valid(operands[0]) || !valid(operands[1]))
+        {
+            HPX_THROW_EXCEPTION(hpx::bad_parameter,
+                "conv_operation::eval",
+                generate_error_message(
+                    "the conv_operation primitive requires that the "
+                    "arguments given by the operands array are valid"));
+        }
+
+        auto this_ = this->shared_from_this();
+        return hpx::dataflow(hpx::launch::sync,
+            hpx::util::unwrapping([this_ = std::move(this_)](
+                                      primitive_arguments_type&& args)
+                                      -> primitive_argument_type {
+                std::size_t const dims =
+                    this_->mode_ == conv_mode_2d ? 2 : 1;
+                parameters const p = this_->extract_parameters(args, dims);
+
+                auto x = extract_numeric_value(
+                    std::move(args[0]), this_->name_, this_->codename_);
+                auto kernel = extract_numeric_value(
+                    std::move(args[1]), this_->name_, this_->codename_);
+
+                if (kernel.size() == 0)
+                {
+                    HPX_THROW_EXCEPTION(hpx::bad_parameter,
+                        "conv_operation::eval",
+                        this_->generate_error_message(
+                            "the kernel must not be empty"));
+                }
+
+                if (dims == 2)
+                {
+                    return this_->conv2d(std::move(x), std::move(kernel), p);
+                }
+                return this_->conv1d(std::move(x), std::move(kernel), p);
+            }),
+            detail::map_operands(operands, functional::value_operand{}, args,
+                name_, codename_, std::move(ctx)));
+    }
+}}}
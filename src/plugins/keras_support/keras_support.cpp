@@ -13,6 +13,10 @@ PHYLANX_REGISTER_PLUGIN_MODULE();
 
 PHYLANX_REGISTER_PLUGIN_FACTORY(batch_dot_operation_plugin,
     phylanx::execution_tree::primitives::batch_dot_operation::match_data);
+PHYLANX_REGISTER_PLUGIN_FACTORY(conv1d_operation_plugin,
+    phylanx::execution_tree::primitives::conv_operation::match_data[0]);
+PHYLANX_REGISTER_PLUGIN_FACTORY(conv2d_operation_plugin,
+    phylanx::execution_tree::primitives::conv_operation::match_data[1]);
 PHYLANX_REGISTER_PLUGIN_FACTORY(elu_operation_plugin,
     phylanx::execution_tree::primitives::elu_operation::match_data);
 PHYLANX_REGISTER_PLUGIN_FACTORY(hard_sigmoid_operation_plugin,
@@ -21,9 +25,18 @@ PHYLANX_REGISTER_PLUGIN_FACTORY(l2_normalize_operation_plugin,
     phylanx::execution_tree::primitives::l2_normalize_operation::match_data);
 PHYLANX_REGISTER_PLUGIN_FACTORY(one_hot_operation_plugin,
     phylanx::execution_tree::primitives::one_hot_operation::match_data);
+PHYLANX_REGISTER_PLUGIN_FACTORY(max_pool_operation_plugin,
+    phylanx::execution_tree::primitives::pool_operation::match_data[0]);
+PHYLANX_REGISTER_PLUGIN_FACTORY(avg_pool_operation_plugin,
+    phylanx::execution_tree::primitives::pool_operation::match_data[1]);
 PHYLANX_REGISTER_PLUGIN_FACTORY(sigmoid_operation_plugin,
     phylanx::execution_tree::primitives::sigmoid_operation::match_data);
 PHYLANX_REGISTER_PLUGIN_FACTORY(softmax_operation_plugin,
-    phylanx::execution_tree::primitives::softmax_operation::match_data);
+    phylanx::execution_tree::primitives::softmax_operation::match_data[0]);
+PHYLANX_REGISTER_PLUGIN_FACTORY(log_softmax_operation_plugin,
+    phylanx::execution_tree::primitives::softmax_operation::match_data[1]);
+PHYLANX_REGISTER_PLUGIN_FACTORY(softmax_cross_entropy_operation_plugin,
+    phylanx::execution_tree::primitives::softmax_cross_entropy_operation::
+        match_data);
 PHYLANX_REGISTER_PLUGIN_FACTORY(softplus_operation_plugin,
     phylanx::execution_tree::primitives::softplus_operation::match_data);
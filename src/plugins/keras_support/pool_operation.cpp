@@ -0,0 +1,466 @@
+// Copyright (c) 2019 Hartmut Kaiser
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <phylanx/config.hpp>
+#include <phylanx/execution_tree/compiler/primitive_name.hpp>
+#include <phylanx/execution_tree/primitives/detail/sliding_window.hpp>
+#include <phylanx/execution_tree/primitives/node_data_helpers.hpp>
+#include <phylanx/ir/node_data.hpp>
+#include <phylanx/plugins/keras_support/pool_operation.hpp>
+
+#include <hpx/include/lcos.hpp>
+#include <hpx/include/naming.hpp>
+#include <hpx/include/util.hpp>
+#include <hpx/throw_exception.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <limits>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <blaze/Math.h>
+
+#if defined(PHYLANX_HAVE_BLAZE_TENSOR)
+#include <blaze_tensor/Math.h>
+#endif
+
+///////////////////////////////////////////////////////////////////////////////
+namespace phylanx { namespace execution_tree { namespace primitives
+{
+    ///////////////////////////////////////////////////////////////////////////
+    namespace detail
+    {
+        std::string pool_docstring(char const* kind)
+        {
+            return std::string(R"(
+            x, pool_size, strides, padding
+            Args:
+
+                x (array) : the input, either a matrix of shape
+                    (steps, channels) or a tensor of shape
+                    (batch, steps, channels) for 1-D pooling, or a matrix of
+                    shape (rows, columns) or a tensor of shape
+                    (batch, rows, columns) for 2-D pooling
+                pool_size (int or tuple of ints) : the size of the pooling
+                    window, a tuple of two ints selects 2-D pooling
+                strides (optional, int or tuple of ints) : the strides,
+                    defaults to pool_size
+                padding (optional, string) : 'valid' (the default), or
+                    'same'
+
+            Returns:
+
+            The )") + kind + R"( over all windows of `x`.)";
+        }
+    }
+
+    std::vector<match_pattern_type> const pool_operation::match_data =
+    {
+        match_pattern_type{"max_pool",
+            std::vector<std::string>{
+                "max_pool(_1, _2, __arg(_3_strides, nil), "
+                    "__arg(_4_padding, nil))"},
+            &create_max_pool_operation, &create_primitive<pool_operation>,
+            detail::pool_docstring("maximum")
+        },
+        match_pattern_type{"avg_pool",
+            std::vector<std::string>{
+                "avg_pool(_1, _2, __arg(_3_strides, nil), "
+                    "__arg(_4_padding, nil))"},
+            &create_avg_pool_operation, &create_primitive<pool_operation>,
+            detail::pool_docstring("average")
+        }
+    };
+
+    ///////////////////////////////////////////////////////////////////////////
+    namespace detail
+    {
+        pool_operation::pool_mode extract_pool_mode(std::string const& name)
+        {
+            compiler::primitive_name_parts name_parts;
+            if (!compiler::parse_primitive_name(name, name_parts))
+            {
+                if (name.find("avg_pool") != std::string::npos)
+                {
+                    return pool_operation::pool_mode_avg;
+                }
+                return pool_operation::pool_mode_max;
+            }
+
+            if (name_parts.primitive == "avg_pool")
+            {
+                return pool_operation::pool_mode_avg;
+            }
+            return pool_operation::pool_mode_max;
+        }
+
+        ///////////////////////////////////////////////////////////////////////
+        // Compute the output rows [first, last) of the 1-D pooling of x
+        // (steps, channels), all channels of a step are combined at once.
+        template <typename Input, typename Output>
+        void pool1d_rows(Input const& x, Output& out,
+            execution_tree::detail::window_geometry const& g, bool average,
+            std::size_t first, std::size_t last)
+        {
+            for (std::size_t i = first; i != last; ++i)
+            {
+                auto result = blaze::row(out, i);
+
+                std::size_t count = 0;
+                for (std::size_t k = 0; k != g.window_; ++k)
+                {
+                    std::ptrdiff_t const index = g.input_index(i, k);
+                    if (!g.is_valid(index))
+                    {
+                        continue;
+                    }
+
+                    auto input = blaze::row(x, std::size_t(index));
+                    if (count++ == 0)
+                    {
+                        result = input;
+                    }
+                    else if (average)
+                    {
+                        result += input;
+                    }
+                    else
+                    {
+                        result = blaze::max(result, input);
+                    }
+                }
+
+                if (count == 0)
+                {
+                    result = 0.0;
+                }
+                else if (average && count != 1)
+                {
+                    result *= 1.0 / double(count);
+                }
+            }
+        }
+
+        ///////////////////////////////////////////////////////////////////////
+        // Compute the output rows [first, last) of the 2-D pooling of x
+        // (rows, columns). The number of valid window elements in every
+        // output column is given by column_counts.
+        template <typename Input, typename Output>
+        void pool2d_rows(Input const& x, Output& out,
+            execution_tree::detail::window_geometry const& rows,
+            execution_tree::detail::window_geometry const& columns,
+            blaze::DynamicVector<double, blaze::rowVector> const&
+                column_counts,
+            bool average, std::size_t first, std::size_t last)
+        {
+            for (std::size_t i = first; i != last; ++i)
+            {
+                auto result = blaze::row(out, i);
+                result = average ? 0.0 : -std::numeric_limits<double>::max();
+
+                std::size_t row_count = 0;
+                for (std::size_t ki = 0; ki != rows.window_; ++ki)
+                {
+                    std::ptrdiff_t const ri = rows.input_index(i, ki);
+                    if (!rows.is_valid(ri))
+                    {
+                        continue;
+                    }
+                    ++row_count;
+
+                    auto input = blaze::row(x, std::size_t(ri));
+                    for (std::size_t kj = 0; kj != columns.window_; ++kj)
+                    {
+                        auto const range = columns.valid_outputs(kj);
+                        if (range[0] >= range[1])
+                        {
+                            continue;
+                        }
+
+                        std::size_t const n = range[1] - range[0];
+                        std::size_t const ci =
+                            std::size_t(columns.input_index(range[0], kj));
+                        auto target = blaze::subvector(result, range[0], n);
+
+                        if (columns.stride_ == 1)
+                        {
+                            auto source = blaze::subvector(input, ci, n);
+                            if (average)
+                            {
+                                target += source;
+                            }
+                            else
+                            {
+                                target = blaze::max(target, source);
+                            }
+                            continue;
+                        }
+
+                        for (std::size_t j = 0; j != n; ++j)
+                        {
+                            double const value =
+                                input[ci + j * columns.stride_];
+                            if (average)
+                            {
+                                target[j] += value;
+                            }
+                            else
+                            {
+                                target[j] = (std::max)(target[j], value);
+                            }
+                        }
+                    }
+                }
+
+                if (row_count == 0)
+                {
+                    result = 0.0;
+                }
+                else if (average)
+                {
+                    result /= double(row_count) * column_counts;
+                }
+            }
+        }
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    pool_operation::pool_operation(primitive_arguments_type&& operands,
+            std::string const& name, std::string const& codename)
+      : primitive_component_base(std::move(operands), name, codename)
+      , mode_(detail::extract_pool_mode(name_))
+    {}
+
+    ///////////////////////////////////////////////////////////////////////////
+    execution_tree::detail::padding_mode pool_operation::extract_padding(
+        primitive_arguments_type const& args) const
+    {
+        execution_tree::detail::padding_mode result =
+            execution_tree::detail::padding_mode::valid;
+        if (args.size() > 3 && valid(args[3]))
+        {
+            std::string padding =
+                extract_string_value(args[3], name_, codename_);
+            if (!execution_tree::detail::parse_padding_mode(padding, result) ||
+                result == execution_tree::detail::padding_mode::causal)
+            {
+                HPX_THROW_EXCEPTION(hpx::bad_parameter,
+                    "pool_operation::extract_padding",
+                    generate_error_message("unknown padding '" + padding +
+                        "', expected 'valid', or 'same'"));
+            }
+        }
+        return result;
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    primitive_argument_type pool_operation::pool1d(ir::node_data<double>&& x,
+        std::size_t pool_size, std::size_t stride,
+        execution_tree::detail::padding_mode padding) const
+    {
+        std::size_t const dims = x.num_dimensions();
+        if (dims != 2 && dims != 3)
+        {
+            HPX_THROW_EXCEPTION(hpx::bad_parameter, "pool_operation::pool1d",
+                generate_error_message(
+                    "1-D pooling requires an input of shape "
+                    "(batch, steps, channels) or (steps, channels)"));
+        }
+
+        bool const average = mode_ == pool_mode_avg;
+        auto const g = execution_tree::detail::make_window_geometry(
+            x.dimension(int(dims) - 2), pool_size, stride, 1, padding);
+        std::size_t const channels = x.dimension(int(dims) - 1);
+
+        if (dims == 2)
+        {
+            auto m = x.matrix();
+            blaze::DynamicMatrix<double> result(g.output_size_, channels);
+
+            execution_tree::detail::for_each_window_block(1, g.output_size_,
+                pool_size * channels,
+                [&](std::size_t, std::size_t first, std::size_t last)
+                {
+                    detail::pool1d_rows(m, result, g, average, first, last);
+                });
+
+            return primitive_argument_type{std::move(result)};
+        }
+
+#if defined(PHYLANX_HAVE_BLAZE_TENSOR)
+        auto t = x.tensor();
+        blaze::DynamicTensor<double> result(
+            t.pages(), g.output_size_, channels);
+
+        execution_tree::detail::for_each_window_block(t.pages(),
+            g.output_size_, pool_size * channels,
+            [&](std::size_t batch, std::size_t first, std::size_t last)
+            {
+                auto out = blaze::pageslice(result, batch);
+                detail::pool1d_rows(blaze::pageslice(t, batch), out, g,
+                    average, first, last);
+            });
+
+        return primitive_argument_type{std::move(result)};
+#else
+        HPX_THROW_EXCEPTION(hpx::bad_parameter, "pool_operation::pool1d",
+            generate_error_message(
+                "batched pooling requires support for tensors"));
+#endif
+    }
+
+    primitive_argument_type pool_operation::pool2d(ir::node_data<double>&& x,
+        std::array<std::size_t, 2> const& pool_size,
+        std::array<std::size_t, 2> const& strides,
+        execution_tree::detail::padding_mode padding) const
+    {
+        std::size_t const dims = x.num_dimensions();
+        if (dims != 2 && dims != 3)
+        {
+            HPX_THROW_EXCEPTION(hpx::bad_parameter, "pool_operation::pool2d",
+                generate_error_message(
+                    "2-D pooling requires an input of shape "
+                    "(batch, rows, columns) or (rows, columns)"));
+        }
+
+        bool const average = mode_ == pool_mode_avg;
+        auto const rows = execution_tree::detail::make_window_geometry(
+            x.dimension(int(dims) - 2), pool_size[0], strides[0], 1, padding);
+        auto const columns = execution_tree::detail::make_window_geometry(
+            x.dimension(int(dims) - 1), pool_size[1], strides[1], 1, padding);
+
+        // number of valid window elements for every output column
+        blaze::DynamicVector<double, blaze::rowVector> column_counts(
+            columns.output_size_, 0.0);
+        for (std::size_t kj = 0; kj != columns.window_; ++kj)
+        {
+            auto const range = columns.valid_outputs(kj);
+            for (std::size_t j = range[0]; j < range[1]; ++j)
+            {
+                column_counts[j] += 1.0;
+            }
+        }
+
+        std::size_t const work_per_row =
+            columns.output_size_ * pool_size[0] * pool_size[1];
+
+        if (dims == 2)
+        {
+            auto m = x.matrix();
+            blaze::DynamicMatrix<double> result(
+                rows.output_size_, columns.output_size_);
+
+            execution_tree::detail::for_each_window_block(1,
+                rows.output_size_, work_per_row,
+                [&](std::size_t, std::size_t first, std::size_t last)
+                {
+                    detail::pool2d_rows(m, result, rows, columns,
+                        column_counts, average, first, last);
+                });
+
+            return primitive_argument_type{std::move(result)};
+        }
+
+#if defined(PHYLANX_HAVE_BLAZE_TENSOR)
+        auto t = x.tensor();
+        blaze::DynamicTensor<double> result(
+            t.pages(), rows.output_size_, columns.output_size_);
+
+        execution_tree::detail::for_each_window_block(t.pages(),
+            rows.output_size_, work_per_row,
+            [&](std::size_t batch, std::size_t first, std::size_t last)
+            {
+                auto out = blaze::pageslice(result, batch);
+                detail::pool2d_rows(blaze::pageslice(t, batch), out, rows,
+                    columns, column_counts, average, first, last);
+            });
+
+        return primitive_argument_type{std::move(result)};
+#else
+        HPX_THROW_EXCEPTION(hpx::bad_parameter, "pool_operation::pool2d",
+            generate_error_message(
+                "batched pooling requires support for tensors"));
+#endif
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    hpx::future<primitive_argument_type> pool_operation::eval(
+        primitive_arguments_type const& operands,
+        primitive_arguments_type const& args, eval_context ctx) const
+    {
+        if (operands.size() < 2 || operands.size() > 4)
+        {
+            HPX_THROW_EXCEPTION(hpx::bad_parameter,
+                "pool_operation::eval",
+                generate_error_message(
+                    "the pool_operation primitive requires between two and "
+                    "four operands"));
+        }
+
+        if (!valid(operands[0]) || !valid(operands[1]))
+        {
+            HPX_THROW_EXCEPTION(hpx::bad_parameter,
+                "pool_operation::eval",
+                generate_error_message(
+                    "the pool_operation primitive requires that the "
+                    "arguments given by the operands array are valid"));
+        }
+
+        auto this_ = this->shared_from_this();
+        return hpx::dataflow(hpx::launch::sync,
+            hpx::util::unwrapping([this_ = std::move(this_)](
+                                      primitive_arguments_type&& args)
+                                      -> primitive_argument_type {
+                // a pool size given as a tuple of two ints selects 2-D
+                // pooling
+                std::size_t dims = 1;
+                if (is_list_operand_strict(args[1]))
+                {
+                    dims = extract_list_value_size(
+                        args[1], this_->name_, this_->codename_);
+                }
+
+                if (dims != 1 && dims != 2)
+                {
+                    HPX_THROW_EXCEPTION(hpx::bad_parameter,
+                        "pool_operation::eval",
+                        this_->generate_error_message(
+                            "the pool size must be an int or a tuple of "
+                            "one or two ints"));
+                }
+
+                auto const pool_size =
+                    execution_tree::detail::extract_window_sizes(args[1],
+                        dims, 1, "pool size", this_->name_, this_->codename_);
+
+                // the strides default to the pool size
+                auto strides = pool_size;
+                if (args.size() > 2 && valid(args[2]))
+                {
+                    strides = execution_tree::detail::extract_window_sizes(
+                        args[2], dims, 1, "strides", this_->name_,
+                        this_->codename_);
+                }
+
+                auto const padding = this_->extract_padding(args);
+                auto x = extract_numeric_value(
+                    std::move(args[0]), this_->name_, this_->codename_);
+
+                if (dims == 2)
+                {
+                    return this_->pool2d(
+                        std::move(x), pool_size, strides, padding);
+                }
+                return this_->pool1d(
+                    std::move(x), pool_size[0], strides[0], padding);
+            }),
+            detail::map_operands(operands, functional::value_operand{}, args,
+                name_, codename_, std::move(ctx)));
+    }
+}}}
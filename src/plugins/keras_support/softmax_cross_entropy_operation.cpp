@@ -0,0 +1,278 @@
+// Copyright (c) 2019 Hartmut Kaiser
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <phylanx/config.hpp>
+#include <phylanx/execution_tree/primitives/detail/softmax.hpp>
+#include <phylanx/ir/node_data.hpp>
+#include <phylanx/plugins/keras_support/softmax_cross_entropy_operation.hpp>
+
+#include <hpx/include/lcos.hpp>
+#include <hpx/include/naming.hpp>
+#include <hpx/include/util.hpp>
+#include <hpx/throw_exception.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <blaze/Math.h>
+#if defined(PHYLANX_HAVE_BLAZE_TENSOR)
+#include <blaze_tensor/Math.h>
+#endif
+
+///////////////////////////////////////////////////////////////////////////////
+namespace phylanx { namespace execution_tree { namespace primitives
+{
+    ///////////////////////////////////////////////////////////////////////////
+    match_pattern_type const softmax_cross_entropy_operation::match_data =
+    {
+        hpx::util::make_tuple("softmax_cross_entropy",
+        std::vector<std::string>{"softmax_cross_entropy(_1, _2)"},
+        &create_softmax_cross_entropy_operation,
+        &create_primitive<softmax_cross_entropy_operation>,
+        R"(logits, labels
+        Args:
+
+            logits (array_like) : the unnormalized scores, the classes
+                are along the last axis
+            labels (array_like) : either the target probabilities (of the
+                same shape as logits, e.g. one-hot encoded), or the target
+                class indices (with one dimension less than logits)
+
+        Returns:
+
+        The cross entropy between the softmax of the logits and the labels,
+        i.e. -sum(labels * log_softmax(logits), axis=-1). This is evaluated
+        without computing the softmax explicitly, which is both faster and
+        more accurate.)")
+    };
+
+    ///////////////////////////////////////////////////////////////////////////
+    softmax_cross_entropy_operation::softmax_cross_entropy_operation(
+            primitive_arguments_type&& operands,
+            std::string const& name, std::string const& codename)
+      : primitive_component_base(std::move(operands), name, codename)
+    {}
+
+    std::size_t softmax_cross_entropy_operation::extract_label(
+        double label, std::size_t classes) const
+    {
+        if (label < 0 || label >= double(classes) ||
+            label != double(std::int64_t(label)))
+        {
+            HPX_THROW_EXCEPTION(hpx::bad_parameter,
+                "softmax_cross_entropy_operation::extract_label",
+                generate_error_message(
+                    "the class indices must be integers in the range "
+                    "[0, number of classes)"));
+        }
+        return std::size_t(label);
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    primitive_argument_type softmax_cross_entropy_operation::cross_entropy1d(
+        ir::node_data<double>&& logits, ir::node_data<double>&& labels) const
+    {
+        auto v = logits.vector();
+
+        if (labels.num_dimensions() == 0)
+        {
+            return primitive_argument_type{
+                execution_tree::detail::sparse_softmax_cross_entropy_line(
+                    v, extract_label(labels.scalar(), v.size()))};
+        }
+
+        return primitive_argument_type{
+            execution_tree::detail::softmax_cross_entropy_line(
+                v, labels.vector())};
+    }
+
+    primitive_argument_type softmax_cross_entropy_operation::cross_entropy2d(
+        ir::node_data<double>&& logits, ir::node_data<double>&& labels) const
+    {
+        auto m = logits.matrix();
+        blaze::DynamicVector<double> result(m.rows());
+
+        if (labels.num_dimensions() == 1)
+        {
+            auto l = labels.vector();
+            for (std::size_t i = 0; i != l.size(); ++i)
+            {
+                extract_label(l[i], m.columns());
+            }
+
+            execution_tree::detail::for_each_line(m.rows(), m.columns(),
+                [&](std::size_t i)
+                {
+                    result[i] = execution_tree::detail::
+                        sparse_softmax_cross_entropy_line(
+                            blaze::row(m, i), std::size_t(l[i]));
+                });
+
+            return primitive_argument_type{std::move(result)};
+        }
+
+        auto l = labels.matrix();
+        execution_tree::detail::for_each_line(m.rows(), m.columns(),
+            [&](std::size_t i)
+            {
+                result[i] = execution_tree::detail::softmax_cross_entropy_line(
+                    blaze::row(m, i), blaze::row(l, i));
+            });
+
+        return primitive_argument_type{std::move(result)};
+    }
+
+#if defined(PHYLANX_HAVE_BLAZE_TENSOR)
+    primitive_argument_type softmax_cross_entropy_operation::cross_entropy3d(
+        ir::node_data<double>&& logits, ir::node_data<double>&& labels) const
+    {
+        auto t = logits.tensor();
+        std::size_t const rows = t.rows();
+        blaze::DynamicMatrix<double> result(t.pages(), rows);
+
+        if (labels.num_dimensions() == 2)
+        {
+            auto l = labels.matrix();
+            for (std::size_t i = 0; i != l.rows(); ++i)
+            {
+                for (std::size_t j = 0; j != l.columns(); ++j)
+                {
+                    extract_label(l(i, j), t.columns());
+                }
+            }
+
+            execution_tree::detail::for_each_line(t.pages() * rows,
+                t.columns(),
+                [&](std::size_t i)
+                {
+                    std::size_t const page = i / rows;
+                    std::size_t const row = i % rows;
+                    result(page, row) = execution_tree::detail::
+                        sparse_softmax_cross_entropy_line(
+                            blaze::row(blaze::pageslice(t, page), row),
+                            std::size_t(l(page, row)));
+                });
+
+            return primitive_argument_type{std::move(result)};
+        }
+
+        auto l = labels.tensor();
+        execution_tree::detail::for_each_line(t.pages() * rows, t.columns(),
+            [&](std::size_t i)
+            {
+                std::size_t const page = i / rows;
+                std::size_t const row = i % rows;
+                result(page, row) =
+                    execution_tree::detail::softmax_cross_entropy_line(
+                        blaze::row(blaze::pageslice(t, page), row),
+                        blaze::row(blaze::pageslice(l, page), row));
+            });
+
+        return primitive_argument_type{std::move(result)};
+    }
+#endif
+
+    ///////////////////////////////////////////////////////////////////////////
+    hpx::future<primitive_argument_type> softmax_cross_entropy_operation::eval(
+        primitive_arguments_type const& operands,
+        primitive_arguments_type const& args,
+        eval_context ctx) const
+    {
+        if (operands.size() != 2)
+        {
+            HPX_THROW_EXCEPTION(hpx::bad_parameter,
+                "softmax_cross_entropy_operation::eval",
+                generate_error_message(
+                    "the softmax_cross_entropy primitive requires exactly "
+                    "two operands"));
+        }
+
+        if (!valid(operands[0]) || !valid(operands[1]))
+        {
+            HPX_THROW_EXCEPTION(hpx::bad_parameter,
+                "softmax_cross_entropy_operation::eval",
+                generate_error_message(
+                    "the softmax_cross_entropy primitive requires that the "
+                    "arguments given by the operands array are valid"));
+        }
+
+        auto this_ = this->shared_from_this();
+        return hpx::dataflow(hpx::launch::sync,
+            hpx::util::unwrapping([this_ = std::move(this_)](
+                                      primitive_arguments_type&& args)
+                                      -> primitive_argument_type {
+                auto logits = extract_numeric_value(
+                    std::move(args[0]), this_->name_, this_->codename_);
+                auto labels = extract_numeric_value(
+                    std::move(args[1]), this_->name_, this_->codename_);
+
+                std::size_t const dims = logits.num_dimensions();
+
+                // dense labels have the same shape as the logits, sparse
+                // labels lack the last dimension
+                bool shapes_match = false;
+                if (labels.num_dimensions() == dims)
+                {
+                    shapes_match =
+                        labels.dimensions() == logits.dimensions();
+                }
+                else if (labels.num_dimensions() + 1 == dims)
+                {
+                    shapes_match = true;
+                    for (std::size_t i = 0; i + 1 < dims; ++i)
+                    {
+                        if (labels.dimension(int(i)) !=
+                            logits.dimension(int(i)))
+                        {
+                            shapes_match = false;
+                        }
+                    }
+                }
+
+                if (dims == 0 || logits.dimension(int(dims) - 1) == 0 ||
+                    !shapes_match)
+                {
+                    HPX_THROW_EXCEPTION(hpx::bad_parameter,
+                        "softmax_cross_entropy_operation::eval",
+                        this_->generate_error_message(
+                            "the labels must either have the same shape as "
+                            "the logits, or the shape of the logits without "
+                            "the last dimension"));
+                }
+
+                switch (dims)
+                {
+                case 1:
+                    return this_->cross_entropy1d(
+                        std::move(logits), std::move(labels));
+
+                case 2:
+                    return this_->cross_entropy2d(
+                        std::move(logits), std::move(labels));
+
+#if defined(PHYLANX_HAVE_BLAZE_TENSOR)
+                case 3:
+                    return this_->cross_entropy3d(
+                        std::move(logits), std::move(labels));
+#endif
+
+                default:
+                    break;
+                }
+
+                HPX_THROW_EXCEPTION(hpx::bad_parameter,
+                    "softmax_cross_entropy_operation::eval",
+                    this_->generate_error_message(
+                        "the logits have an unsupported number of "
+                        "dimensions"));
+            }),
+            detail::map_operands(operands, functional::value_operand{}, args,
+                name_, codename_, std::move(ctx)));
+    }
+}}}
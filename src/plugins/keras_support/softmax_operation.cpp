@@ -5,6 +5,8 @@
 // file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
 
 #include <phylanx/config.hpp>
+#include <phylanx/execution_tree/compiler/primitive_name.hpp>
+#include <phylanx/execution_tree/primitives/detail/softmax.hpp>
 #include <phylanx/ir/node_data.hpp>
 #include <phylanx/plugins/keras_support/softmax_operation.hpp>
 
@@ -30,7 +32,7 @@
 namespace phylanx { namespace execution_tree { namespace primitives
 {
     ///////////////////////////////////////////////////////////////////////////
-    match_pattern_type const softmax_operation::match_data =
+    std::vector<match_pattern_type> const softmax_operation::match_data =
     {
         hpx::util::make_tuple("softmax",
         std::vector<std::string>{"softmax(_1)","softmax(_1,_2)"},
@@ -47,54 +49,160 @@ namespace phylanx { namespace execution_tree { namespace primitives
 
         Returns an array of the same shape which is the normalized exponential
         function of the given array.  The resulting array consists of real
-        values in the range (0..1], which add up to 1 in direction of the given axis)")
+        values in the range (0..1], which add up to 1 in direction of the given axis)"),
+
+        hpx::util::make_tuple("log_softmax",
+        std::vector<std::string>{"log_softmax(_1)","log_softmax(_1,_2)"},
+        &create_log_softmax_operation, &create_primitive<softmax_operation>,
+        R"(a, axis
+        Args:
+
+            a (array_like) : input array
+            axis (optional, integer): an axis to compute the log_softmax
+                along. The default is the last axis (axis == -1) of an
+                array. Axis is effective for >1d arrays.
+
+        Returns:
+
+        Returns an array of the same shape holding the logarithm of the
+        softmax of the given array. This is more accurate than computing
+        log(softmax(a, axis)).)")
     };
 
+    ///////////////////////////////////////////////////////////////////////////
+    namespace detail
+    {
+        softmax_operation::softmax_mode extract_softmax_mode(
+            std::string const& name)
+        {
+            compiler::primitive_name_parts name_parts;
+            if (!compiler::parse_primitive_name(name, name_parts))
+            {
+                if (name.find("log_softmax") != std::string::npos)
+                {
+                    return softmax_operation::softmax_mode_log;
+                }
+                return softmax_operation::softmax_mode_softmax;
+            }
+
+            if (name_parts.primitive == "log_softmax")
+            {
+                return softmax_operation::softmax_mode_log;
+            }
+            return softmax_operation::softmax_mode_softmax;
+        }
+
+        template <typename In, typename Out>
+        void apply_softmax(
+            softmax_operation::softmax_mode mode, In const& in, Out&& out)
+        {
+            if (mode == softmax_operation::softmax_mode_log)
+            {
+                execution_tree::detail::log_softmax_line(
+                    in, std::forward<Out>(out));
+            }
+            else
+            {
+                execution_tree::detail::softmax_line(
+                    in, std::forward<Out>(out));
+            }
+        }
+
+        // Apply the softmax to all lines of data, storing the results in the
+        // corresponding lines of result (which may be the same as data).
+        // line(a, i) returns a view of the i-th line of a.
+        template <typename Data, typename Result, typename Line>
+        void softmax_lines(softmax_operation::softmax_mode mode,
+            Data& data, Result& result, std::size_t lines,
+            std::size_t length, Line const& line)
+        {
+            execution_tree::detail::for_each_line(lines, length,
+                [&](std::size_t i)
+                {
+                    apply_softmax(mode, line(data, i), line(result, i));
+                });
+        }
+
+        struct row_line
+        {
+            template <typename Matrix>
+            auto operator()(Matrix& m, std::size_t i) const
+            {
+                return blaze::row(m, i);
+            }
+        };
+
+        struct column_line
+        {
+            template <typename Matrix>
+            auto operator()(Matrix& m, std::size_t i) const
+            {
+                return blaze::column(m, i);
+            }
+        };
+    }
+
     ///////////////////////////////////////////////////////////////////////////
     softmax_operation::softmax_operation(primitive_arguments_type&& operands,
         std::string const& name, std::string const& codename)
       : primitive_component_base(std::move(operands), name, codename)
+      , mode_(detail::extract_softmax_mode(name_))
     {}
 
     primitive_argument_type softmax_operation::softmax0d() const
     {
-        return primitive_argument_type{static_cast<double>(1.)};
+        return primitive_argument_type{
+            static_cast<double>(mode_ == softmax_mode_log ? 0. : 1.)};
     }
 
     ///////////////////////////////////////////////////////////////////////////
     primitive_argument_type softmax_operation::softmax1d(arg_type&& arg) const
     {
+        auto v = arg.vector();
         if (!arg.is_ref())
         {
-            arg.vector() = blaze::softmax(arg.vector());
+            detail::apply_softmax(mode_, v, v);
             return primitive_argument_type{std::move(arg)};
         }
-        return primitive_argument_type{blaze::softmax(arg.vector())};
+
+        blaze::DynamicVector<val_type> result(v.size());
+        detail::apply_softmax(mode_, v, result);
+        return primitive_argument_type{std::move(result)};
     }
 
     ///////////////////////////////////////////////////////////////////////////
     primitive_argument_type softmax_operation::softmax2d_axis0(
         arg_type&& arg) const
     {
+        auto m = arg.matrix();
         if (!arg.is_ref())
         {
-            arg.matrix() = blaze::softmax<blaze::columnwise>(arg.matrix());
+            detail::softmax_lines(mode_, m, m, m.columns(), m.rows(),
+                detail::column_line{});
             return primitive_argument_type{std::move(arg)};
         }
-        return primitive_argument_type{
-            blaze::softmax<blaze::columnwise>(arg.matrix())};
+
+        blaze::DynamicMatrix<val_type> result(m.rows(), m.columns());
+        detail::softmax_lines(mode_, m, result, m.columns(), m.rows(),
+            detail::column_line{});
+        return primitive_argument_type{std::move(result)};
     }
 
     primitive_argument_type softmax_operation::softmax2d_axis1(
         arg_type&& arg) const
     {
+        auto m = arg.matrix();
         if (!arg.is_ref())
         {
-            arg.matrix() = blaze::softmax<blaze::rowwise>(arg.matrix());
+            detail::softmax_lines(
+                mode_, m, m, m.rows(), m.columns(), detail::row_line{});
             return primitive_argument_type{std::move(arg)};
         }
-        return primitive_argument_type{
-            blaze::softmax<blaze::rowwise>(arg.matrix())};
+
+        blaze::DynamicMatrix<val_type> result(m.rows(), m.columns());
+        detail::softmax_lines(
+            mode_, m, result, m.rows(), m.columns(), detail::row_line{});
+        return primitive_argument_type{std::move(result)};
     }
 
     primitive_argument_type softmax_operation::softmax2d(
@@ -122,73 +230,94 @@ namespace phylanx { namespace execution_tree { namespace primitives
 
     ///////////////////////////////////////////////////////////////////////////
 #if defined(PHYLANX_HAVE_BLAZE_TENSOR)
-    primitive_argument_type softmax_operation::softmax3d_axis0(
-        arg_type&& arg) const
+    namespace detail
     {
-        auto t = arg.tensor();
-        if (!arg.is_ref())
+        // the lines along the pages are the rows of the row slices
+        struct page_line
         {
-            for (std::size_t i = 0; i != t.rows(); ++i)
+            std::size_t columns_;
+
+            template <typename Tensor>
+            auto operator()(Tensor& t, std::size_t i) const
             {
-                blaze::rowslice(t, i) =
-                    blaze::softmax<blaze::rowwise>(blaze::rowslice(t, i));
+                return blaze::row(
+                    blaze::rowslice(t, i / columns_), i % columns_);
             }
-            return primitive_argument_type{std::move(arg)};
-        }
+        };
 
-        blaze::DynamicTensor<val_type> result(t.pages(), t.rows(), t.columns());
-        for (std::size_t i = 0; i != t.rows(); ++i)
+        struct tensor_column_line
         {
-            auto slice = blaze::rowslice(t, i);
-            blaze::rowslice(result, i) = blaze::softmax<blaze::rowwise>(slice);
-        }
-        return primitive_argument_type{std::move(result)};
-    }
+            std::size_t columns_;
 
-    primitive_argument_type softmax_operation::softmax3d_axis1(
-        arg_type&& arg) const
-    {
-        auto t = arg.tensor();
-        if (!arg.is_ref())
+            template <typename Tensor>
+            auto operator()(Tensor& t, std::size_t i) const
+            {
+                return blaze::column(
+                    blaze::pageslice(t, i / columns_), i % columns_);
+            }
+        };
+
+        struct tensor_row_line
         {
-            for (std::size_t i = 0; i != arg.tensor().columns(); ++i)
+            std::size_t rows_;
+
+            template <typename Tensor>
+            auto operator()(Tensor& t, std::size_t i) const
             {
-                blaze::columnslice(t, i) =
-                    blaze::softmax<blaze::rowwise>(blaze::columnslice(t, i));
+                return blaze::row(blaze::pageslice(t, i / rows_), i % rows_);
             }
-            return primitive_argument_type{std::move(arg)};
-        }
+        };
 
-        blaze::DynamicTensor<val_type> result(t.pages(), t.rows(), t.columns());
-        for (std::size_t i = 0; i != t.columns(); ++i)
+        template <typename Line>
+        primitive_argument_type softmax3d(
+            softmax_operation::softmax_mode mode, ir::node_data<double>&& arg,
+            std::size_t lines, std::size_t length, Line const& line)
         {
-            auto slice = blaze::columnslice(t, i);
-            blaze::columnslice(result, i) = blaze::softmax<blaze::rowwise>(slice);
+            auto t = arg.tensor();
+            if (!arg.is_ref())
+            {
+                softmax_lines(mode, t, t, lines, length, line);
+                return primitive_argument_type{std::move(arg)};
+            }
+
+            blaze::DynamicTensor<double> result(
+                t.pages(), t.rows(), t.columns());
+            softmax_lines(mode, t, result, lines, length, line);
+            return primitive_argument_type{std::move(result)};
         }
-        return primitive_argument_type{std::move(result)};
+    }
+
+    primitive_argument_type softmax_operation::softmax3d_axis0(
+        arg_type&& arg) const
+    {
+        std::size_t const pages = arg.dimension(0);
+        std::size_t const rows = arg.dimension(1);
+        std::size_t const columns = arg.dimension(2);
+
+        return detail::softmax3d(mode_, std::move(arg), rows * columns, pages,
+            detail::page_line{columns});
+    }
+
+    primitive_argument_type softmax_operation::softmax3d_axis1(
+        arg_type&& arg) const
+    {
+        std::size_t const pages = arg.dimension(0);
+        std::size_t const rows = arg.dimension(1);
+        std::size_t const columns = arg.dimension(2);
+
+        return detail::softmax3d(mode_, std::move(arg), pages * columns, rows,
+            detail::tensor_column_line{columns});
     }
 
     primitive_argument_type softmax_operation::softmax3d_axis2(
         arg_type&& arg) const
     {
-        auto t = arg.tensor();
-        if (!arg.is_ref())
-        {
-            for (std::size_t i = 0; i != arg.tensor().pages(); ++i)
-            {
-                blaze::pageslice(t, i) =
-                    blaze::softmax<blaze::rowwise>(blaze::pageslice(t, i));
-            }
-            return primitive_argument_type{std::move(arg)};
-        }
+        std::size_t const pages = arg.dimension(0);
+        std::size_t const rows = arg.dimension(1);
+        std::size_t const columns = arg.dimension(2);
 
-        blaze::DynamicTensor<val_type> result(t.pages(), t.rows(), t.columns());
-        for (std::size_t i = 0; i != t.pages(); ++i)
-        {
-            auto slice = blaze::pageslice(t, i);
-            blaze::pageslice(result, i) = blaze::softmax<blaze::rowwise>(slice);
-        }
-        return primitive_argument_type{std::move(result)};
+        return detail::softmax3d(mode_, std::move(arg), pages * rows, columns,
+            detail::tensor_row_line{rows});
     }
 
     primitive_argument_type softmax_operation::softmax3d(
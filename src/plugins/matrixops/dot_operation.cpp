@@ -43,13 +43,20 @@ namespace phylanx { namespace execution_tree { namespace primitives
 
             Computes the outer product of two arrays. Always returns a matrix)"},
 
-        match_pattern_type{"dot", std::vector<std::string>{"dot(_1, _2)"},
+        match_pattern_type{"dot",
+            std::vector<std::string>{"dot(_1, _2)", "dot(_1, _2, _3)"},
             &create_dot_operation, &create_primitive<dot_operation>, R"(
-            a, b
+            a, b, backend
             Args:
 
                 a (array) : a scalar, vector, matrix or a tensor
                 b (array) : a scalar, vector, matrix or a tensor
+                backend (optional, string) : the backend used for products
+                    of matrices with matrices or vectors: 'blaze' (evaluate
+                    using blaze), 'tiled' (split the result into tiles which
+                    are computed by separate HPX threads), or 'auto' (use
+                    'tiled' for large operands only). The default is taken
+                    from the configuration entry `phylanx.dot.backend`.
 
             Returns:
 
@@ -125,6 +132,21 @@ namespace phylanx { namespace execution_tree { namespace primitives
         }
     }
 
+    util::gemm_backend dot_operation::extract_gemm_backend(
+        std::string const& backend) const
+    {
+        util::gemm_backend result = util::gemm_backend::automatic;
+        if (!util::parse_gemm_backend(backend, result))
+        {
+            HPX_THROW_EXCEPTION(hpx::bad_parameter,
+                "dot_operation::extract_gemm_backend",
+                generate_error_message(
+                    "unknown backend '" + backend +
+                    "', expected 'auto', 'blaze', or 'tiled'"));
+        }
+        return result;
+    }
+
     ///////////////////////////////////////////////////////////////////////////
     primitive_argument_type dot_operation::dot0d(
         primitive_argument_type&& lhs, primitive_argument_type&& rhs) const
@@ -190,26 +212,29 @@ namespace phylanx { namespace execution_tree { namespace primitives
                     "be numeric data types"));
     }
 
-    primitive_argument_type dot_operation::dot2d(
-        primitive_argument_type&& lhs, primitive_argument_type&& rhs) const
+    primitive_argument_type dot_operation::dot2d(primitive_argument_type&& lhs,
+        primitive_argument_type&& rhs, util::gemm_backend backend) const
     {
         switch (extract_common_type(lhs, rhs))
         {
         case node_data_type_bool:
             return dot2d(
                 extract_boolean_value(std::move(lhs), name_, codename_),
-                extract_boolean_value(std::move(rhs), name_, codename_));
+                extract_boolean_value(std::move(rhs), name_, codename_),
+                backend);
 
         case node_data_type_int64:
             return dot2d(
                 extract_integer_value(std::move(lhs), name_, codename_),
-                extract_integer_value(std::move(rhs), name_, codename_));
+                extract_integer_value(std::move(rhs), name_, codename_),
+                backend);
 
         case node_data_type_unknown: HPX_FALLTHROUGH;
         case node_data_type_double:
             return dot2d(
                 extract_numeric_value(std::move(lhs), name_, codename_),
-                extract_numeric_value(std::move(rhs), name_, codename_));
+                extract_numeric_value(std::move(rhs), name_, codename_),
+                backend);
 
         default:
             break;
@@ -496,8 +521,8 @@ namespace phylanx { namespace execution_tree { namespace primitives
     }
 
     ///////////////////////////////////////////////////////////////////////////
-    primitive_argument_type dot_operation::dot_nd(
-        primitive_argument_type&& lhs, primitive_argument_type&& rhs) const
+    primitive_argument_type dot_operation::dot_nd(primitive_argument_type&& lhs,
+        primitive_argument_type&& rhs, util::gemm_backend backend) const
     {
         switch (extract_numeric_value_dimension(lhs, name_, codename_))
         {
@@ -508,7 +533,7 @@ namespace phylanx { namespace execution_tree { namespace primitives
             return dot1d(std::move(lhs), std::move(rhs));
 
         case 2:
-            return dot2d(std::move(lhs), std::move(rhs));
+            return dot2d(std::move(lhs), std::move(rhs), backend);
 
 #if defined(PHYLANX_HAVE_BLAZE_TENSOR)
         case 3:
@@ -598,7 +623,8 @@ namespace phylanx { namespace execution_tree { namespace primitives
                 return outer_nd(std::move(lhs), std::move(rhs));
 
             case 1:
-                return dot_nd(std::move(lhs), std::move(rhs));
+                return dot_nd(std::move(lhs), std::move(rhs),
+                    util::default_gemm_backend());
 
             case 2:
                 return contraction_nd(std::move(lhs), std::move(rhs));
@@ -677,7 +703,8 @@ namespace phylanx { namespace execution_tree { namespace primitives
 
                 else if (this_->mode_ == dot_product)
 
-                    return this_->dot_nd(std::move(op1), std::move(op2));
+                    return this_->dot_nd(std::move(op1), std::move(op2),
+                        util::default_gemm_backend());
 
                 else if (this_->mode_ == doubledot_product)
 
@@ -694,11 +721,26 @@ namespace phylanx { namespace execution_tree { namespace primitives
         }
         else if (operands.size() == 3 && valid(operands[2]))
         {
-            if (this_->mode_ == dot_product || this_->mode_ == outer_product)
+            if (this_->mode_ == outer_product)
                 HPX_THROW_EXCEPTION(hpx::bad_parameter,
                     "dot_operation::eval",
                     this_->generate_error_message(
-                        "the dot/outer product requires exactly two operands"));
+                        "the outer product requires exactly two operands"));
+            else if (this_->mode_ == dot_product)
+            {
+                return hpx::dataflow(hpx::launch::sync,
+                    hpx::util::unwrapping(
+                        [this_ = std::move(this_)](
+                            primitive_argument_type&& op1,
+                            primitive_argument_type&& op2,
+                            std::string&& backend) -> primitive_argument_type {
+                        return this_->dot_nd(std::move(op1), std::move(op2),
+                            this_->extract_gemm_backend(backend));
+                    }),
+                    value_operand(operands[0], args, name_, codename_, ctx),
+                    value_operand(operands[1], args, name_, codename_, ctx),
+                    string_operand(operands[2], args, name_, codename_, ctx));
+            }
             else if (this_->mode_ == doubledot_product)
             {
                 return hpx::dataflow(hpx::launch::sync,
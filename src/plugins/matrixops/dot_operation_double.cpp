@@ -23,7 +23,8 @@ namespace phylanx { namespace execution_tree { namespace primitives
         ir::node_data<double>&&, ir::node_data<double>&&) const;
 
     template primitive_argument_type dot_operation::dot2d(
-        ir::node_data<double>&&, ir::node_data<double>&&) const;
+        ir::node_data<double>&&, ir::node_data<double>&&,
+        util::gemm_backend) const;
 
 #if defined(PHYLANX_HAVE_BLAZE_TENSOR)
     template primitive_argument_type dot_operation::dot3d(
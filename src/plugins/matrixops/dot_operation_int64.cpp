@@ -25,7 +25,8 @@ namespace phylanx { namespace execution_tree { namespace primitives
         ir::node_data<std::int64_t>&&, ir::node_data<std::int64_t>&&) const;
 
     template primitive_argument_type dot_operation::dot2d(
-        ir::node_data<std::int64_t>&&, ir::node_data<std::int64_t>&&) const;
+        ir::node_data<std::int64_t>&&, ir::node_data<std::int64_t>&&,
+        util::gemm_backend) const;
 
 #if defined(PHYLANX_HAVE_BLAZE_TENSOR)
     template primitive_argument_type dot_operation::dot3d(
@@ -0,0 +1,1054 @@
+// Copyright (c) 2019 Hartmut Kaiser
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <phylanx/config.hpp>
+#include <phylanx/execution_tree/primitives/detail/batched_gemm.hpp>
+#include <phylanx/execution_tree/primitives/node_data_helpers.hpp>
+#include <phylanx/ir/node_data.hpp>
+#include <phylanx/plugins/matrixops/einsum.hpp>
+#include <phylanx/util/gemm.hpp>
+
+#include <hpx/include/lcos.hpp>
+#include <hpx/include/naming.hpp>
+#include <hpx/include/parallel_for_loop.hpp>
+#include <hpx/include/util.hpp>
+#include <hpx/throw_exception.hpp>
+#include <hpx/util/format.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cctype>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <blaze/Math.h>
+#if defined(PHYLANX_HAVE_BLAZE_TENSOR)
+#include <blaze_tensor/Math.h>
+#endif
+
+///////////////////////////////////////////////////////////////////////////////
+namespace phylanx { namespace execution_tree { namespace primitives
+{
+    ///////////////////////////////////////////////////////////////////////////
+    match_pattern_type const einsum::match_data =
+    {
+        match_pattern_type{"einsum",
+            std::vector<std::string>{"einsum(_1, __2)"},
+            &create_einsum, &create_primitive<einsum>, R"(
+            subscripts, *operands
+            Args:
+
+                subscripts (string) : the subscripts for the summation, a
+                    comma separated list of labels (one letter per
+                    dimension) for each of the operands, optionally
+                    followed by '->' and the labels of the result. If the
+                    result labels are not given, the result holds the labels
+                    appearing exactly once, in alphabetical order.
+                *operands (arrays) : the operands
+
+            Returns:
+
+            The Einstein summation of the operands as specified by the
+            subscripts, e.g. einsum("ij,jk->ik", a, b) is the matrix product
+            of a and b. The result is computed in double precision.)"
+        }
+    };
+
+    ///////////////////////////////////////////////////////////////////////////
+    struct einsum::subscripts
+    {
+        std::vector<std::string> inputs_;
+        std::string output_;
+
+        // the extent of every label, indexed by the label character
+        std::array<std::size_t, 128> extents_;
+    };
+
+    ///////////////////////////////////////////////////////////////////////////
+    namespace detail
+    {
+        // A labeled (strided) view of a dense array of arbitrary rank. Arrays
+        // created while evaluating the contraction own their (row-major)
+        // storage.
+        struct einsum_array
+        {
+            std::size_t size() const
+            {
+                std::size_t result = 1;
+                for (std::size_t n : shape_)
+                {
+                    result *= n;
+                }
+                return result;
+            }
+
+            std::string labels_;                // one label per dimension
+            std::vector<std::size_t> shape_;
+            std::vector<std::ptrdiff_t> strides_;
+            double const* data_ = nullptr;
+            std::shared_ptr<std::vector<double>> storage_;
+        };
+
+        einsum_array make_einsum_array(
+            std::string labels, std::vector<std::size_t> shape)
+        {
+            einsum_array result;
+            result.labels_ = std::move(labels);
+            result.shape_ = std::move(shape);
+            result.strides_.resize(result.shape_.size());
+
+            std::ptrdiff_t stride = 1;
+            for (std::size_t i = result.shape_.size(); i != 0; --i)
+            {
+                result.strides_[i - 1] = stride;
+                stride *= std::ptrdiff_t(result.shape_[i - 1]);
+            }
+
+            result.storage_ =
+                std::make_shared<std::vector<double>>(result.size(), 0.0);
+            result.data_ = result.storage_->data();
+            return result;
+        }
+
+        // Create a view of the given node_data, the node_data has to outlive
+        // the view
+        einsum_array make_einsum_view(
+            ir::node_data<double> const& nd, std::string const& labels)
+        {
+            einsum_array result;
+            result.labels_ = labels;
+
+            switch (nd.num_dimensions())
+            {
+            case 0:
+                result = make_einsum_array(labels, {});
+                result.storage_->front() = nd.scalar();
+                break;
+
+            case 1:
+                {
+                    auto v = nd.vector();
+                    result.shape_ = {v.size()};
+                    result.strides_ = {1};
+                    result.data_ = v.data();
+                }
+                break;
+
+            case 2:
+                {
+                    auto m = nd.matrix();
+                    result.shape_ = {m.rows(), m.columns()};
+                    result.strides_ = {std::ptrdiff_t(m.spacing()), 1};
+                    result.data_ = m.data();
+                }
+                break;
+
+#if defined(PHYLANX_HAVE_BLAZE_TENSOR)
+            case 3:
+                {
+                    auto t = nd.tensor();
+                    result.shape_ = {t.pages(), t.rows(), t.columns()};
+                    result.strides_ = {
+                        std::ptrdiff_t(t.rows() * t.spacing()),
+                        std::ptrdiff_t(t.spacing()), 1};
+                    result.data_ = t.data();
+                }
+                break;
+#endif
+            default:
+                break;
+            }
+            return result;
+        }
+
+        ///////////////////////////////////////////////////////////////////////
+        // Invoke f(offset) for all elements of the given strided index space,
+        // the elements are visited in row-major order.
+        template <typename F>
+        void for_each_offset(std::vector<std::size_t> const& shape,
+            std::vector<std::ptrdiff_t> const& strides, F&& f)
+        {
+            for (std::size_t n : shape)
+            {
+                if (n == 0)
+                {
+                    return;
+                }
+            }
+
+            std::size_t const rank = shape.size();
+            std::vector<std::size_t> index(rank, 0);
+            std::ptrdiff_t offset = 0;
+
+            while (true)
+            {
+                f(offset);
+
+                // advance the multi-dimensional index
+                std::size_t d = rank;
+                while (true)
+                {
+                    if (d == 0)
+                    {
+                        return;
+                    }
+
+                    --d;
+                    if (++index[d] != shape[d])
+                    {
+                        offset += strides[d];
+                        break;
+                    }
+
+                    offset -= std::ptrdiff_t(shape[d] - 1) * strides[d];
+                    index[d] = 0;
+                }
+            }
+        }
+
+        // Replace repeated labels of an operand by a single dimension
+        // iterating over the diagonal, this does not copy any data.
+        einsum_array take_diagonals(einsum_array a)
+        {
+            for (std::size_t i = 0; i < a.labels_.size(); ++i)
+            {
+                std::size_t j = a.labels_.find(a.labels_[i], i + 1);
+                while (j != std::string::npos)
+                {
+                    a.strides_[i] += a.strides_[j];
+
+                    a.labels_.erase(j, 1);
+                    a.shape_.erase(a.shape_.begin() + j);
+                    a.strides_.erase(a.strides_.begin() + j);
+
+                    j = a.labels_.find(a.labels_[i], j);
+                }
+            }
+            return a;
+        }
+
+        // Create a row-major copy of the given array holding the dimensions
+        // given by labels (in this order), all other dimensions are summed.
+        einsum_array reduce(einsum_array const& a, std::string const& labels)
+        {
+            std::vector<std::size_t> shape, summed_shape;
+            std::vector<std::ptrdiff_t> strides, summed_strides;
+
+            for (char l : labels)
+            {
+                std::size_t p = a.labels_.find(l);
+                shape.push_back(a.shape_[p]);
+                strides.push_back(a.strides_[p]);
+            }
+            for (std::size_t i = 0; i != a.labels_.size(); ++i)
+            {
+                if (labels.find(a.labels_[i]) == std::string::npos)
+                {
+                    summed_shape.push_back(a.shape_[i]);
+                    summed_strides.push_back(a.strides_[i]);
+                }
+            }
+
+            einsum_array result = make_einsum_array(labels, std::move(shape));
+
+            double* out = result.storage_->data();
+            double const* in = a.data_;
+
+            switch (summed_shape.size())
+            {
+            case 0:
+                for_each_offset(result.shape_, strides,
+                    [&](std::ptrdiff_t offset) { *out++ = in[offset]; });
+                break;
+
+            case 1:
+                {
+                    std::size_t const n = summed_shape[0];
+                    std::ptrdiff_t const stride = summed_strides[0];
+                    for_each_offset(result.shape_, strides,
+                        [&](std::ptrdiff_t offset)
+                        {
+                            double sum = 0.0;
+                            for (std::size_t k = 0; k != n; ++k)
+                            {
+                                sum += in[offset + std::ptrdiff_t(k) * stride];
+                            }
+                            *out++ = sum;
+                        });
+                }
+                break;
+
+            default:
+                for_each_offset(result.shape_, strides,
+                    [&](std::ptrdiff_t offset)
+                    {
+                        double sum = 0.0;
+                        for_each_offset(summed_shape, summed_strides,
+                            [&](std::ptrdiff_t s) { sum += in[offset + s]; });
+                        *out++ = sum;
+                    });
+                break;
+            }
+
+            return result;
+        }
+
+        ///////////////////////////////////////////////////////////////////////
+        // A group of dimensions collapsed into a single one
+        struct einsum_extent
+        {
+            std::size_t extent_ = 1;
+            std::ptrdiff_t stride_ = 0;
+        };
+
+        // Collapse the dimensions given by the labels (in this order) into a
+        // single dimension, returns false if this is not possible without
+        // copying the data.
+        bool collapse(einsum_array const& a, std::string const& labels,
+            einsum_extent& result)
+        {
+            result = einsum_extent{};
+            for (auto it = labels.rbegin(); it != labels.rend(); ++it)
+            {
+                std::size_t p = a.labels_.find(*it);
+                std::size_t const n = a.shape_[p];
+                if (n == 1)
+                {
+                    continue;       // the stride is irrelevant
+                }
+
+                if (result.extent_ == 1)
+                {
+                    result.extent_ = n;
+                    result.stride_ = a.strides_[p];
+                }
+                else if (a.strides_[p] ==
+                    std::ptrdiff_t(result.extent_) * result.stride_)
+                {
+                    result.extent_ *= n;
+                }
+                else
+                {
+                    return false;
+                }
+            }
+            return true;
+        }
+
+        // Order the given labels by decreasing stride in the given array,
+        // this is the order which is most likely to be collapsible
+        std::string order_by_stride(einsum_array const& a, std::string labels)
+        {
+            std::stable_sort(labels.begin(), labels.end(),
+                [&](char lhs, char rhs)
+                {
+                    return std::abs(a.strides_[a.labels_.find(lhs)]) >
+                        std::abs(a.strides_[a.labels_.find(rhs)]);
+                });
+            return labels;
+        }
+
+        ///////////////////////////////////////////////////////////////////////
+        // products with less multiply-adds per batch entry than this are
+        // evaluated by the small matrix kernels
+        constexpr std::size_t einsum_small_gemm = 32768;
+
+        struct einsum_gemm
+        {
+            std::size_t batch_, m_, n_, k_;
+
+            double const* a_;
+            std::ptrdiff_t a_batch_, a_m_, a_k_;
+
+            double const* b_;
+            std::ptrdiff_t b_batch_, b_k_, b_n_;
+
+            double* c_;         // row-major, batch entries are contiguous
+        };
+
+        // Evaluate the product using blaze, SOA and SOB are the storage
+        // orders of the operands.
+        template <bool SOA, bool SOB>
+        void einsum_gemm_blaze(einsum_gemm const& g)
+        {
+            using matrix_a = blaze::CustomMatrix<double const,
+                blaze::unaligned, blaze::unpadded, SOA>;
+            using matrix_b = blaze::CustomMatrix<double const,
+                blaze::unaligned, blaze::unpadded, SOB>;
+            using matrix_c = blaze::CustomMatrix<double, blaze::unaligned,
+                blaze::unpadded, blaze::rowMajor>;
+
+            // the spacing of a matrix is the stride of its outer dimension
+            std::size_t const spacing_a = SOA == blaze::rowMajor ?
+                (std::max)(std::size_t(g.a_m_), g.k_) :
+                (std::max)(std::size_t(g.a_k_), g.m_);
+            std::size_t const spacing_b = SOB == blaze::rowMajor ?
+                (std::max)(std::size_t(g.b_k_), g.n_) :
+                (std::max)(std::size_t(g.b_n_), g.k_);
+
+            auto product = [&](std::size_t i, bool serial)
+            {
+                matrix_a a(g.a_ + std::ptrdiff_t(i) * g.a_batch_, g.m_, g.k_,
+                    spacing_a);
+                matrix_b b(g.b_ + std::ptrdiff_t(i) * g.b_batch_, g.k_, g.n_,
+                    spacing_b);
+                matrix_c c(g.c_ + i * g.m_ * g.n_, g.m_, g.n_);
+
+                if (serial)
+                {
+                    c = blaze::serial(a * b);
+                }
+                else if (util::use_tiled_gemm(util::default_gemm_backend(),
+                             g.m_ * g.n_ * g.k_))
+                {
+                    util::tiled_gemm(a, b, c);
+                }
+                else
+                {
+                    c = a * b;
+                }
+            };
+
+            if (g.batch_ == 1)
+            {
+                product(0, false);
+                return;
+            }
+
+            hpx::parallel::for_loop(hpx::parallel::execution::par,
+                std::size_t(0), g.batch_,
+                [&](std::size_t i) { product(i, true); });
+        }
+
+        // Evaluate the product using the small matrix kernels, those support
+        // arbitrary strides.
+        void einsum_gemm_small(einsum_gemm const& g)
+        {
+            execution_tree::detail::batched_gemm(g.batch_,
+                [&](std::size_t i)
+                {
+                    return execution_tree::detail::strided_matrix<double const>{
+                        g.a_ + std::ptrdiff_t(i) * g.a_batch_, g.m_, g.k_,
+                        g.a_m_, g.a_k_};
+                },
+                [&](std::size_t i)
+                {
+                    return execution_tree::detail::strided_matrix<double const>{
+                        g.b_ + std::ptrdiff_t(i) * g.b_batch_, g.k_, g.n_,
+                        g.b_k_, g.b_n_};
+                },
+                [&](std::size_t i)
+                {
+                    return execution_tree::detail::strided_matrix<double>{
+                        g.c_ + i * g.m_ * g.n_, g.m_, g.n_,
+                        std::ptrdiff_t(g.n_), 1};
+                });
+        }
+
+        // Contract a and b, the result holds the dimensions given by keep
+        // (in an unspecified order).
+        einsum_array contract(
+            einsum_array a, einsum_array b, std::string const& keep)
+        {
+            // sum over dimensions not needed anymore
+            auto needed = [&](einsum_array const& x, einsum_array const& y)
+            {
+                std::string result;
+                for (char l : x.labels_)
+                {
+                    if (keep.find(l) != std::string::npos ||
+                        y.labels_.find(l) != std::string::npos)
+                    {
+                        result.push_back(l);
+                    }
+                }
+                return result;
+            };
+
+            std::string const needed_a = needed(a, b);
+            if (needed_a.size() != a.labels_.size())
+            {
+                a = reduce(a, needed_a);
+            }
+            std::string const needed_b = needed(b, a);
+            if (needed_b.size() != b.labels_.size())
+            {
+                b = reduce(b, needed_b);
+            }
+
+            // classify the labels
+            std::string batch, free_a, free_b, summed;
+            for (char l : a.labels_)
+            {
+                bool const in_b = b.labels_.find(l) != std::string::npos;
+                bool const kept = keep.find(l) != std::string::npos;
+                if (in_b)
+                {
+                    (kept ? batch : summed).push_back(l);
+                }
+                else
+                {
+                    free_a.push_back(l);
+                }
+            }
+            for (char l : b.labels_)
+            {
+                if (a.labels_.find(l) == std::string::npos)
+                {
+                    free_b.push_back(l);
+                }
+            }
+
+            batch = order_by_stride(a, std::move(batch));
+            summed = order_by_stride(a, std::move(summed));
+            free_a = order_by_stride(a, std::move(free_a));
+            free_b = order_by_stride(b, std::move(free_b));
+
+            // copy operands only if their layout can't be described by a
+            // (batched) strided matrix
+            einsum_extent a_batch, a_m, a_k, b_batch, b_k, b_n;
+            if (!collapse(a, batch, a_batch) || !collapse(a, free_a, a_m) ||
+                !collapse(a, summed, a_k))
+            {
+                a = reduce(a, batch + free_a + summed);
+                collapse(a, batch, a_batch);
+                collapse(a, free_a, a_m);
+                collapse(a, summed, a_k);
+            }
+            if (!collapse(b, batch, b_batch) || !collapse(b, summed, b_k) ||
+                !collapse(b, free_b, b_n))
+            {
+                b = reduce(b, batch + summed + free_b);
+                collapse(b, batch, b_batch);
+                collapse(b, summed, b_k);
+                collapse(b, free_b, b_n);
+            }
+
+            std::vector<std::size_t> shape;
+            for (char l : batch + free_a)
+            {
+                shape.push_back(a.shape_[a.labels_.find(l)]);
+            }
+            for (char l : free_b)
+            {
+                shape.push_back(b.shape_[b.labels_.find(l)]);
+            }
+
+            einsum_array result =
+                make_einsum_array(batch + free_a + free_b, std::move(shape));
+
+            einsum_gemm g{a_batch.extent_, a_m.extent_, b_n.extent_,
+                a_k.extent_, a.data_, a_batch.stride_, a_m.stride_,
+                a_k.stride_, b.data_, b_batch.stride_, b_k.stride_,
+                b_n.stride_, result.storage_->data()};
+
+            if (result.size() == 0 || g.k_ == 0)
+            {
+                return result;
+            }
+
+            std::int64_t t = hpx::util::high_resolution_clock::now();
+
+            if (g.m_ * g.n_ * g.k_ < einsum_small_gemm)
+            {
+                einsum_gemm_small(g);
+            }
+            else
+            {
+                // blaze requires one of the strides of each operand to be one
+                auto unit_stride = [](std::size_t n, std::ptrdiff_t stride)
+                {
+                    return n == 1 || stride == 1;
+                };
+
+                if (!unit_stride(g.k_, g.a_k_) && !unit_stride(g.m_, g.a_m_))
+                {
+                    a = reduce(a, batch + free_a + summed);
+                    g.a_ = a.data_;
+                    g.a_batch_ = std::ptrdiff_t(g.m_ * g.k_);
+                    g.a_m_ = std::ptrdiff_t(g.k_);
+                    g.a_k_ = 1;
+                }
+                if (!unit_stride(g.n_, g.b_n_) && !unit_stride(g.k_, g.b_k_))
+                {
+                    b = reduce(b, batch + summed + free_b);
+                    g.b_ = b.data_;
+                    g.b_batch_ = std::ptrdiff_t(g.k_ * g.n_);
+                    g.b_k_ = std::ptrdiff_t(g.n_);
+                    g.b_n_ = 1;
+                }
+
+                bool const a_row_major = unit_stride(g.k_, g.a_k_);
+                bool const b_row_major = unit_stride(g.n_, g.b_n_);
+
+                if (a_row_major && b_row_major)
+                {
+                    einsum_gemm_blaze<blaze::rowMajor, blaze::rowMajor>(g);
+                }
+                else if (a_row_major)
+                {
+                    einsum_gemm_blaze<blaze::rowMajor, blaze::columnMajor>(g);
+                }
+                else if (b_row_major)
+                {
+                    einsum_gemm_blaze<blaze::columnMajor, blaze::rowMajor>(g);
+                }
+                else
+                {
+                    einsum_gemm_blaze<blaze::columnMajor, blaze::columnMajor>(
+                        g);
+                }
+            }
+
+            util::record_gemm(std::int64_t(2 * g.batch_ * g.m_ * g.n_ * g.k_),
+                hpx::util::high_resolution_clock::now() - t);
+
+            return result;
+        }
+
+        ///////////////////////////////////////////////////////////////////////
+        // Planning of the contraction order
+        struct einsum_plan_step
+        {
+            std::size_t lhs_, rhs_;     // indices of the contracted operands
+            std::string result_;        // labels of the result
+        };
+
+        struct einsum_planner
+        {
+            // the labels of the result of contracting lhs and rhs, these are
+            // all labels needed by the output or any of the other operands
+            std::string result_labels(std::vector<std::string> const& ops,
+                std::size_t lhs, std::size_t rhs) const
+            {
+                std::string result;
+                for (char l : ops[lhs] + ops[rhs])
+                {
+                    if (result.find(l) != std::string::npos)
+                    {
+                        continue;
+                    }
+
+                    bool needed = output_.find(l) != std::string::npos;
+                    for (std::size_t i = 0; !needed && i != ops.size(); ++i)
+                    {
+                        needed = i != lhs && i != rhs &&
+                            ops[i].find(l) != std::string::npos;
+                    }
+
+                    if (needed)
+                    {
+                        result.push_back(l);
+                    }
+                }
+                return result;
+            }
+
+            double size(std::string const& labels) const
+            {
+                double result = 1.0;
+                for (char l : labels)
+                {
+                    result *= double(extents_[std::size_t(l)]);
+                }
+                return result;
+            }
+
+            // the number of multiply-adds needed for contracting lhs and rhs
+            double cost(std::string const& lhs, std::string const& rhs) const
+            {
+                std::string labels = lhs;
+                for (char l : rhs)
+                {
+                    if (labels.find(l) == std::string::npos)
+                    {
+                        labels.push_back(l);
+                    }
+                }
+                return size(labels);
+            }
+
+            static std::vector<std::string> apply(
+                std::vector<std::string> ops, einsum_plan_step const& step)
+            {
+                ops.erase(ops.begin() + step.rhs_);
+                ops.erase(ops.begin() + step.lhs_);
+                ops.push_back(step.result_);
+                return ops;
+            }
+
+            // exhaustive search for the cheapest order, used for a small
+            // number of operands only
+            void optimal(std::vector<std::string> const& ops,
+                std::vector<einsum_plan_step>& steps, double cost_so_far,
+                std::vector<einsum_plan_step>& best, double& best_cost) const
+            {
+                if (ops.size() == 1)
+                {
+                    if (cost_so_far < best_cost)
+                    {
+                        best_cost = cost_so_far;
+                        best = steps;
+                    }
+                    return;
+                }
+
+                for (std::size_t i = 0; i != ops.size(); ++i)
+                {
+                    for (std::size_t j = i + 1; j != ops.size(); ++j)
+                    {
+                        double const c =
+                            cost_so_far + cost(ops[i], ops[j]);
+                        if (c >= best_cost)
+                        {
+                            continue;
+                        }
+
+                        steps.push_back(
+                            einsum_plan_step{i, j, result_labels(ops, i, j)});
+                        optimal(apply(ops, steps.back()), steps, c, best,
+                            best_cost);
+                        steps.pop_back();
+                    }
+                }
+            }
+
+            // contract the pair of operands which reduces the overall size of
+            // the operands the most, prefer cheaper contractions otherwise
+            std::vector<einsum_plan_step> greedy(
+                std::vector<std::string> ops) const
+            {
+                std::vector<einsum_plan_step> result;
+                while (ops.size() > 1)
+                {
+                    einsum_plan_step best{0, 1, {}};
+                    double best_gain = (std::numeric_limits<double>::max)();
+                    double best_cost = (std::numeric_limits<double>::max)();
+
+                    for (std::size_t i = 0; i != ops.size(); ++i)
+                    {
+                        for (std::size_t j = i + 1; j != ops.size(); ++j)
+                        {
+                            std::string labels = result_labels(ops, i, j);
+                            double const gain = size(labels) -
+                                size(ops[i]) - size(ops[j]);
+                            double const c = cost(ops[i], ops[j]);
+                            if (gain < best_gain ||
+                                (gain == best_gain && c < best_cost))
+                            {
+                                best = einsum_plan_step{
+                                    i, j, std::move(labels)};
+                                best_gain = gain;
+                                best_cost = c;
+                            }
+                        }
+                    }
+
+                    ops = apply(std::move(ops), best);
+                    result.push_back(std::move(best));
+                }
+                return result;
+            }
+
+            std::vector<einsum_plan_step> plan(
+                std::vector<std::string> const& ops) const
+            {
+                if (ops.size() > einsum_max_optimal)
+                {
+                    return greedy(ops);
+                }
+
+                std::vector<einsum_plan_step> steps, best;
+                double best_cost = (std::numeric_limits<double>::max)();
+                optimal(ops, steps, 0.0, best, best_cost);
+                return best;
+            }
+
+            // the maximal number of operands for the exhaustive search
+            static constexpr std::size_t einsum_max_optimal = 6;
+
+            std::string const& output_;
+            std::array<std::size_t, 128> const& extents_;
+        };
+
+        ///////////////////////////////////////////////////////////////////////
+        primitive_argument_type einsum_result(einsum_array const& a)
+        {
+            double const* data = a.data_;
+            switch (a.shape_.size())
+            {
+            case 0:
+                return primitive_argument_type{ir::node_data<double>{*data}};
+
+            case 1:
+                {
+                    blaze::DynamicVector<double> result(a.shape_[0]);
+                    std::copy(data, data + a.shape_[0], result.begin());
+                    return primitive_argument_type{std::move(result)};
+                }
+
+            case 2:
+                {
+                    blaze::DynamicMatrix<double> result(
+                        a.shape_[0], a.shape_[1]);
+                    for (std::size_t i = 0; i != a.shape_[0]; ++i)
+                    {
+                        data = std::copy(data, data + a.shape_[1],
+                            result.begin(i));
+                    }
+                    return primitive_argument_type{std::move(result)};
+                }
+
+#if defined(PHYLANX_HAVE_BLAZE_TENSOR)
+            case 3:
+                {
+                    blaze::DynamicTensor<double> result(
+                        a.shape_[0], a.shape_[1], a.shape_[2]);
+                    for (std::size_t k = 0; k != a.shape_[0]; ++k)
+                    {
+                        for (std::size_t i = 0; i != a.shape_[1]; ++i)
+                        {
+                            for (std::size_t j = 0; j != a.shape_[2]; ++j)
+                            {
+                                result(k, i, j) = *data++;
+                            }
+                        }
+                    }
+                    return primitive_argument_type{std::move(result)};
+                }
+#endif
+            default:
+                break;
+            }
+
+            HPX_THROW_EXCEPTION(hpx::bad_parameter,
+                "einsum::detail::einsum_result",
+                "unsupported number of dimensions of the result");
+        }
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    namespace detail
+    {
+        bool is_einsum_label(char l)
+        {
+            return (l >= 'a' && l <= 'z') || (l >= 'A' && l <= 'Z');
+        }
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    einsum::einsum(primitive_arguments_type&& operands,
+            std::string const& name, std::string const& codename)
+      : primitive_component_base(std::move(operands), name, codename)
+    {}
+
+    ///////////////////////////////////////////////////////////////////////////
+    einsum::subscripts einsum::parse_subscripts(std::string const& spec,
+        std::vector<ir::node_data<double>> const& arrays) const
+    {
+        subscripts result;
+        result.extents_.fill(0);
+
+        std::string s;
+        std::remove_copy_if(spec.begin(), spec.end(), std::back_inserter(s),
+            [](char c) { return std::isspace(static_cast<unsigned char>(c)); });
+
+        std::size_t const arrow = s.find("->");
+        std::string const inputs = s.substr(0, arrow);
+
+        std::size_t start = 0;
+        while (true)
+        {
+            std::size_t const comma = inputs.find(',', start);
+            result.inputs_.push_back(inputs.substr(start, comma - start));
+            if (comma == std::string::npos)
+            {
+                break;
+            }
+            start = comma + 1;
+        }
+
+        if (result.inputs_.size() != arrays.size())
+        {
+            HPX_THROW_EXCEPTION(hpx::bad_parameter,
+                "einsum::parse_subscripts",
+                generate_error_message(
+                    "the number of subscripts does not match the number of "
+                    "operands"));
+        }
+
+        std::array<std::size_t, 128> counts;
+        counts.fill(0);
+
+        for (std::size_t i = 0; i != arrays.size(); ++i)
+        {
+            std::string const& labels = result.inputs_[i];
+            if (labels.size() != arrays[i].num_dimensions())
+            {
+                HPX_THROW_EXCEPTION(hpx::bad_parameter,
+                    "einsum::parse_subscripts",
+                    generate_error_message(hpx::util::format(
+                        "the subscripts for operand {} do not match the "
+                        "number of its dimensions", i)));
+            }
+
+            for (std::size_t d = 0; d != labels.size(); ++d)
+            {
+                char const l = labels[d];
+                if (!detail::is_einsum_label(l))
+                {
+                    HPX_THROW_EXCEPTION(hpx::bad_parameter,
+                        "einsum::parse_subscripts",
+                        generate_error_message(
+                            "invalid subscript '" + std::string(1, l) +
+                            "', subscripts have to be letters (ellipses are "
+                            "not supported)"));
+                }
+
+                std::size_t const extent = arrays[i].dimension(d);
+                std::size_t& e = result.extents_[std::size_t(l)];
+                if (counts[std::size_t(l)]++ != 0 && e != extent)
+                {
+                    HPX_THROW_EXCEPTION(hpx::bad_parameter,
+                        "einsum::parse_subscripts",
+                        generate_error_message(
+                            "the dimensions labeled '" + std::string(1, l) +
+                            "' have different extents"));
+                }
+                e = extent;
+            }
+        }
+
+        if (arrow != std::string::npos)
+        {
+            result.output_ = s.substr(arrow + 2);
+            for (std::size_t d = 0; d != result.output_.size(); ++d)
+            {
+                char const l = result.output_[d];
+                if (!detail::is_einsum_label(l) ||
+                    counts[std::size_t(l)] == 0 ||
+                    result.output_.find(l, d + 1) != std::string::npos)
+                {
+                    HPX_THROW_EXCEPTION(hpx::bad_parameter,
+                        "einsum::parse_subscripts",
+                        generate_error_message(
+                            "the output subscript '" + std::string(1, l) +
+                            "' is invalid, repeated, or does not appear in "
+                            "any of the inputs"));
+                }
+            }
+        }
+        else
+        {
+            // the labels appearing exactly once, in alphabetical order
+            for (std::size_t l = 0; l != counts.size(); ++l)
+            {
+                if (counts[l] == 1)
+                {
+                    result.output_.push_back(char(l));
+                }
+            }
+        }
+
+        if (result.output_.size() > PHYLANX_MAX_DIMENSIONS)
+        {
+            HPX_THROW_EXCEPTION(hpx::bad_parameter,
+                "einsum::parse_subscripts",
+                generate_error_message(
+                    "the result has too many dimensions"));
+        }
+
+        return result;
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    primitive_argument_type einsum::einsum_args(
+        primitive_arguments_type&& args) const
+    {
+        std::string spec = extract_string_value(args[0], name_, codename_);
+
+        // the operands have to be kept alive while the views are in use
+        std::vector<ir::node_data<double>> arrays;
+        arrays.reserve(args.size() - 1);
+        for (std::size_t i = 1; i != args.size(); ++i)
+        {
+            arrays.push_back(
+                extract_numeric_value(std::move(args[i]), name_, codename_));
+        }
+
+        subscripts const s = parse_subscripts(spec, arrays);
+
+        std::vector<detail::einsum_array> ops;
+        std::vector<std::string> labels;
+        ops.reserve(arrays.size());
+        for (std::size_t i = 0; i != arrays.size(); ++i)
+        {
+            ops.push_back(detail::take_diagonals(
+                detail::make_einsum_view(arrays[i], s.inputs_[i])));
+            labels.push_back(ops.back().labels_);
+        }
+
+        // contract the operands pairwise in the planned order
+        detail::einsum_planner planner{s.output_, s.extents_};
+        for (auto const& step : planner.plan(labels))
+        {
+            detail::einsum_array lhs = std::move(ops[step.lhs_]);
+            detail::einsum_array rhs = std::move(ops[step.rhs_]);
+
+            ops.erase(ops.begin() + step.rhs_);
+            ops.erase(ops.begin() + step.lhs_);
+
+            ops.push_back(detail::contract(
+                std::move(lhs), std::move(rhs), step.result_));
+        }
+
+        return detail::einsum_result(detail::reduce(ops[0], s.output_));
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    hpx::future<primitive_argument_type> einsum::eval(
+        primitive_arguments_type const& operands,
+        primitive_arguments_type const& args, eval_context ctx) const
+    {
+        if (operands.size() < 2)
+        {
+            HPX_THROW_EXCEPTION(hpx::bad_parameter,
+                "einsum::eval",
+                generate_error_message(
+                    "the einsum primitive requires the subscripts and at "
+                    "least one operand"));
+        }
+
+        for (auto const& operand : operands)
+        {
+            if (!valid(operand))
+            {
+                HPX_THROW_EXCEPTION(hpx::bad_parameter,
+                    "einsum::eval",
+                    generate_error_message(
+                        "the einsum primitive requires that the arguments "
+                        "given by the operands array are valid"));
+            }
+        }
+
+        auto this_ = this->shared_from_this();
+        return hpx::dataflow(hpx::launch::sync,
+            hpx::util::unwrapping(
+                [this_ = std::move(this_)](primitive_arguments_type&& args)
+                -> primitive_argument_type
+                {
+                    return this_->einsum_args(std::move(args));
+                }),
+            detail::map_operands(operands, functional::value_operand{}, args,
+                name_, codename_, std::move(ctx)));
+    }
+}}}
@@ -17,6 +17,8 @@ PHYLANX_REGISTER_PLUGIN_FACTORY(argmax_plugin,
     phylanx::execution_tree::primitives::argmax::match_data);
 PHYLANX_REGISTER_PLUGIN_FACTORY(argmin_plugin,
     phylanx::execution_tree::primitives::argmin::match_data);
+PHYLANX_REGISTER_PLUGIN_FACTORY(argsort_operation_plugin,
+    phylanx::execution_tree::primitives::sort_operation::match_data[1]);
 PHYLANX_REGISTER_PLUGIN_FACTORY(clip_plugin,
     phylanx::execution_tree::primitives::clip::match_data);
 PHYLANX_REGISTER_PLUGIN_FACTORY(count_nonzero_operation_plugin,
@@ -41,6 +43,8 @@ PHYLANX_REGISTER_PLUGIN_FACTORY(dot_operation_plugin,
 PHYLANX_REGISTER_PLUGIN_FACTORY(dstack_operation_plugin,
     phylanx::execution_tree::primitives::stack_operation::match_data[3]);
 #endif
+PHYLANX_REGISTER_PLUGIN_FACTORY(einsum_plugin,
+    phylanx::execution_tree::primitives::einsum::match_data);
 PHYLANX_REGISTER_PLUGIN_FACTORY(expand_dims_plugin,
     phylanx::execution_tree::primitives::expand_dims::match_data);
 PHYLANX_REGISTER_PLUGIN_FACTORY(extract_shape_plugin,
@@ -91,12 +95,16 @@ PHYLANX_REGISTER_PLUGIN_FACTORY(reshape_operation_plugin,
     phylanx::execution_tree::primitives::reshape_operation::match_data[0]);
 PHYLANX_REGISTER_PLUGIN_FACTORY(row_slicing_operation_plugin,
     phylanx::execution_tree::primitives::slicing_operation::match_data[1]);
+PHYLANX_REGISTER_PLUGIN_FACTORY(searchsorted_operation_plugin,
+    phylanx::execution_tree::primitives::sort_operation::match_data[2]);
 PHYLANX_REGISTER_PLUGIN_FACTORY(shuffle_operation_plugin,
     phylanx::execution_tree::primitives::shuffle_operation::match_data);
 PHYLANX_REGISTER_PLUGIN_FACTORY(size_plugin,
     phylanx::execution_tree::primitives::size_operation::match_data);
 PHYLANX_REGISTER_PLUGIN_FACTORY(slicing_operation_plugin,
     phylanx::execution_tree::primitives::slicing_operation::match_data[0]);
+PHYLANX_REGISTER_PLUGIN_FACTORY(sort_operation_plugin,
+    phylanx::execution_tree::primitives::sort_operation::match_data[0]);
 PHYLANX_REGISTER_PLUGIN_FACTORY(squeeze_operation_plugin,
     phylanx::execution_tree::primitives::squeeze_operation::match_data);
 PHYLANX_REGISTER_PLUGIN_FACTORY(stack_operation_plugin,
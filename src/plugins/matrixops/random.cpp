@@ -7,15 +7,18 @@
 #include <phylanx/execution_tree/primitives/generic_function.hpp>
 #include <phylanx/ir/node_data.hpp>
 #include <phylanx/plugins/matrixops/random.hpp>
+#include <phylanx/util/philox.hpp>
 #include <phylanx/util/random.hpp>
 #include <phylanx/util/truncated_normal_distribution.hpp>
 
 #include <hpx/include/lcos.hpp>
 #include <hpx/include/naming.hpp>
+#include <hpx/include/parallel_for_loop.hpp>
 #include <hpx/include/util.hpp>
 #include <hpx/util/assert.hpp>
 #include <hpx/throw_exception.hpp>
 
+#include <algorithm>
 #include <array>
 #include <cmath>
 #include <cstddef>
@@ -292,11 +295,51 @@ namespace phylanx { namespace execution_tree { namespace primitives
     ///////////////////////////////////////////////////////////////////////////
     namespace detail
     {
+        ///////////////////////////////////////////////////////////////////////
+        // Arrays are filled in blocks of this many consecutive elements, each
+        // block is generated from its own stream of the counter based
+        // generator. The result does not depend on the number of threads.
+        constexpr std::size_t random_block_size = 4096;
+
+        template <typename Dist, typename F>
+        void randomize_blocks(Dist const& dist, std::size_t size, F&& f)
+        {
+            std::uint64_t const key = util::next_random_key();
+            std::size_t const blocks =
+                (size + random_block_size - 1) / random_block_size;
+
+            auto fill_block = [&](std::size_t block)
+            {
+                util::philox4x32 gen(key, block);
+
+                Dist d(dist);
+                d.reset();
+
+                std::size_t const begin = block * random_block_size;
+                std::size_t const end =
+                    (std::min)(begin + random_block_size, size);
+                f(begin, end, d, gen);
+            };
+
+            if (blocks < 2)
+            {
+                for (std::size_t block = 0; block != blocks; ++block)
+                {
+                    fill_block(block);
+                }
+                return;
+            }
+
+            hpx::parallel::for_loop(hpx::parallel::execution::par,
+                std::size_t(0), blocks, fill_block);
+        }
+
         ///////////////////////////////////////////////////////////////////////
         template <typename Dist, typename T>
         primitive_argument_type randomize(Dist& dist, T& d)
         {
-            d = dist(util::rng_);
+            util::philox4x32 gen(util::next_random_key());
+            d = dist(gen);
             return primitive_argument_type{d};
         }
 
@@ -304,12 +347,15 @@ namespace phylanx { namespace execution_tree { namespace primitives
         primitive_argument_type randomize(
             Dist& dist, blaze::DynamicVector<T>& v)
         {
-            std::size_t const size = v.size();
-
-            for (std::size_t i = 0; i != size; ++i)
-            {
-                v[i] = dist(util::rng_);
-            }
+            randomize_blocks(dist, v.size(),
+                [&](std::size_t begin, std::size_t end, Dist& d,
+                    util::philox4x32& gen)
+                {
+                    for (std::size_t i = begin; i != end; ++i)
+                    {
+                        v[i] = d(gen);
+                    }
+                });
 
             return primitive_argument_type{std::move(v)};
         }
@@ -318,17 +364,29 @@ namespace phylanx { namespace execution_tree { namespace primitives
         primitive_argument_type randomize(
             Dist& dist, blaze::DynamicMatrix<T>& m)
         {
-            std::size_t const rows = m.rows();
             std::size_t const columns = m.columns();
-
-            for (std::size_t i = 0; i != rows; ++i)
+            if (columns == 0)
             {
-                for (std::size_t j = 0; j != columns; ++j)
-                {
-                    m(i, j) = dist(util::rng_);
-                }
+                return primitive_argument_type{std::move(m)};
             }
 
+            randomize_blocks(dist, m.rows() * columns,
+                [&](std::size_t begin, std::size_t end, Dist& d,
+                    util::philox4x32& gen)
+                {
+                    std::size_t i = begin / columns;
+                    std::size_t j = begin % columns;
+                    for (std::size_t n = begin; n != end; ++n)
+                    {
+                        m(i, j) = d(gen);
+                        if (++j == columns)
+                        {
+                            j = 0;
+                            ++i;
+                        }
+                    }
+                });
+
             return primitive_argument_type{std::move(m)};
         }
 
@@ -337,20 +395,34 @@ namespace phylanx { namespace execution_tree { namespace primitives
         primitive_argument_type randomize(
             Dist& dist, blaze::DynamicTensor<T>& t)
         {
-            std::size_t const pages = t.pages();
             std::size_t const rows = t.rows();
             std::size_t const columns = t.columns();
-
-            for (std::size_t k = 0; k != pages; ++k)
+            if (rows == 0 || columns == 0)
             {
-                for (std::size_t i = 0; i != rows; ++i)
+                return primitive_argument_type{std::move(t)};
+            }
+
+            randomize_blocks(dist, t.pages() * rows * columns,
+                [&](std::size_t begin, std::size_t end, Dist& d,
+                    util::philox4x32& gen)
                 {
-                    for (std::size_t j = 0; j != columns; ++j)
+                    std::size_t k = begin / (rows * columns);
+                    std::size_t i = (begin / columns) % rows;
+                    std::size_t j = begin % columns;
+                    for (std::size_t n = begin; n != end; ++n)
                     {
-                        t(k, i, j) = dist(util::rng_);
+                        t(k, i, j) = d(gen);
+                        if (++j == columns)
+                        {
+                            j = 0;
+                            if (++i == rows)
+                            {
+                                i = 0;
+                                ++k;
+                            }
+                        }
                     }
-                }
-            }
+                });
 
             return primitive_argument_type{std::move(t)};
         }
@@ -8,16 +8,20 @@
 #include <phylanx/execution_tree/primitives/node_data_helpers.hpp>
 #include <phylanx/plugins/matrixops/shuffle_operation.hpp>
 #include <phylanx/util/matrix_iterators.hpp>
+#include <phylanx/util/parallel_sort.hpp>
+#include <phylanx/util/philox.hpp>
 #include <phylanx/util/random.hpp>
 #include <phylanx/util/detail/bad_swap.hpp>
 
 #include <hpx/include/lcos.hpp>
 #include <hpx/include/naming.hpp>
+#include <hpx/include/parallel_for_loop.hpp>
 #include <hpx/include/util.hpp>
 #include <hpx/throw_exception.hpp>
 
 #include <algorithm>
 #include <cstddef>
+#include <cstdint>
 #include <memory>
 #include <numeric>
 #include <random>
@@ -56,13 +60,70 @@ namespace phylanx { namespace execution_tree { namespace primitives
       : primitive_component_base(std::move(operands), name, codename)
     {}
 
+    ///////////////////////////////////////////////////////////////////////////
+    namespace detail
+    {
+        // number of consecutive sort keys generated from the same stream
+        constexpr std::size_t shuffle_block_size = 4096;
+
+        // Generate a random permutation of [0, size) by sorting random keys
+        // in parallel. Ties (which are very unlikely) are broken by index.
+        std::vector<std::int64_t> random_permutation(std::size_t size)
+        {
+            std::uint64_t const key = util::next_random_key();
+            std::vector<std::uint64_t> keys(size);
+
+            std::size_t const blocks =
+                (size + shuffle_block_size - 1) / shuffle_block_size;
+            hpx::parallel::for_loop(hpx::parallel::execution::par,
+                std::size_t(0), blocks,
+                [&](std::size_t block)
+                {
+                    util::philox4x32 gen(key, block);
+
+                    std::size_t const begin = block * shuffle_block_size;
+                    std::size_t const end =
+                        (std::min)(begin + shuffle_block_size, size);
+                    for (std::size_t i = begin; i != end; ++i)
+                    {
+                        std::uint64_t const hi = gen();
+                        keys[i] = (hi << 32) | gen();
+                    }
+                });
+
+            return util::sorted_indices(size,
+                [&](std::int64_t lhs, std::int64_t rhs)
+                {
+                    return keys[lhs] < keys[rhs];
+                });
+        }
+    }
+
     ///////////////////////////////////////////////////////////////////////////
     template <typename T>
     primitive_argument_type shuffle_operation::shuffle_1d(
         ir::node_data<T>&& arg) const
     {
         auto x = arg.vector();
-        std::shuffle(x.begin(), x.end(), util::rng_);
+
+        if (x.size() < util::parallel_sort_threshold)
+        {
+            util::philox4x32 gen(util::next_random_key());
+            std::shuffle(x.begin(), x.end(), gen);
+
+            return primitive_argument_type{std::move(arg)};
+        }
+
+        std::vector<std::int64_t> permutation =
+            detail::random_permutation(x.size());
+
+        blaze::DynamicVector<T> values = x;
+        hpx::parallel::for_loop(hpx::parallel::execution::par,
+            std::size_t(0), x.size(),
+            [&](std::size_t i)
+            {
+                x[i] = values[permutation[i]];
+            });
 
         return primitive_argument_type{std::move(arg)};
     }
@@ -73,9 +134,27 @@ namespace phylanx { namespace execution_tree { namespace primitives
     {
         auto x = arg.matrix();
 
-        util::matrix_row_iterator<decltype(x)> x_begin(x);
-        util::matrix_row_iterator<decltype(x)> x_end(x, x.rows());
-        std::shuffle(x_begin, x_end, util::rng_);
+        if (x.rows() < util::parallel_sort_threshold)
+        {
+            util::philox4x32 gen(util::next_random_key());
+
+            util::matrix_row_iterator<decltype(x)> x_begin(x);
+            util::matrix_row_iterator<decltype(x)> x_end(x, x.rows());
+            std::shuffle(x_begin, x_end, gen);
+
+            return primitive_argument_type{std::move(arg)};
+        }
+
+        std::vector<std::int64_t> permutation =
+            detail::random_permutation(x.rows());
+
+        blaze::DynamicMatrix<T> values = x;
+        hpx::parallel::for_loop(hpx::parallel::execution::par,
+            std::size_t(0), x.rows(),
+            [&](std::size_t i)
+            {
+                blaze::row(x, i) = blaze::row(values, permutation[i]);
+            });
 
         return primitive_argument_type{std::move(arg)};
     }
@@ -0,0 +1,563 @@
+// Copyright (c) 2019 Hartmut Kaiser
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <phylanx/config.hpp>
+#include <phylanx/execution_tree/compiler/primitive_name.hpp>
+#include <phylanx/execution_tree/primitives/node_data_helpers.hpp>
+#include <phylanx/ir/node_data.hpp>
+#include <phylanx/plugins/matrixops/sort_operation.hpp>
+#include <phylanx/util/parallel_sort.hpp>
+
+#include <hpx/include/lcos.hpp>
+#include <hpx/include/naming.hpp>
+#include <hpx/include/parallel_for_loop.hpp>
+#include <hpx/include/util.hpp>
+#include <hpx/throw_exception.hpp>
+#include <hpx/util/optional.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <numeric>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <blaze/Math.h>
+
+///////////////////////////////////////////////////////////////////////////////
+namespace phylanx { namespace execution_tree { namespace primitives
+{
+    ///////////////////////////////////////////////////////////////////////////
+    std::vector<match_pattern_type> const sort_operation::match_data =
+    {
+        match_pattern_type{"sort",
+            std::vector<std::string>{"sort(_1, __arg(_2_axis, -1))"},
+            &create_sort_operation, &create_primitive<sort_operation>, R"(
+            a, axis
+            Args:
+
+                a (array_like) : input array
+                axis (optional, int) : axis along which to sort, the default
+                    is -1 (the last axis). If axis is nil, the array is
+                    flattened before sorting.
+
+            Returns:
+
+            A sorted copy of the array.)"
+        },
+        match_pattern_type{"argsort",
+            std::vector<std::string>{"argsort(_1, __arg(_2_axis, -1))"},
+            &create_argsort_operation, &create_primitive<sort_operation>, R"(
+            a, axis
+            Args:
+
+                a (array_like) : input array
+                axis (optional, int) : axis along which to sort, the default
+                    is -1 (the last axis). If axis is nil, the flattened array
+                    is used.
+
+            Returns:
+
+            The indices that would sort the array. The relative order of
+            equal elements is preserved.)"
+        },
+        match_pattern_type{"searchsorted",
+            std::vector<std::string>{
+                "searchsorted(_1, _2, __arg(_3_side, nil))"
+            },
+            &create_searchsorted_operation, &create_primitive<sort_operation>,
+            R"(
+            a, v, side
+            Args:
+
+                a (vector) : input array, sorted in ascending order
+                v (array_like) : values to insert into a
+                side (optional, string) : if 'left' (the default), the index
+                    of the first suitable location is returned, if 'right',
+                    the last such index is returned.
+
+            Returns:
+
+            The indices into a such that, if the corresponding elements in v
+            were inserted before the indices, the order of a would be
+            preserved.)"
+        }
+    };
+
+    ///////////////////////////////////////////////////////////////////////////
+    namespace detail
+    {
+        sort_operation::sort_mode extract_sort_mode(std::string const& name)
+        {
+            compiler::primitive_name_parts name_parts;
+            std::string primitive = name;
+            if (compiler::parse_primitive_name(name, name_parts))
+            {
+                primitive = name_parts.primitive;
+            }
+
+            if (primitive.find("argsort") == 0)
+            {
+                return sort_operation::sort_mode_argsort;
+            }
+            if (primitive.find("searchsorted") == 0)
+            {
+                return sort_operation::sort_mode_searchsorted;
+            }
+            return sort_operation::sort_mode_sort;
+        }
+
+        // minimal number of elements processed by one HPX thread when
+        // sorting the rows or columns of a matrix
+        constexpr std::size_t sort_min_slice_elements = 16384;
+
+        template <typename F>
+        void sort_for_slices(std::size_t count, std::size_t slice_size, F&& f)
+        {
+            if (count < 2 || count * slice_size < sort_min_slice_elements)
+            {
+                for (std::size_t i = 0; i != count; ++i)
+                {
+                    f(i);
+                }
+                return;
+            }
+
+            hpx::parallel::for_loop(hpx::parallel::execution::par,
+                std::size_t(0), count, std::forward<F>(f));
+        }
+
+        // sort the values in place, booleans are sorted by counting
+        template <typename Iter>
+        void sort_values(Iter first, Iter last, std::false_type)
+        {
+            util::parallel_sort(first, last);
+        }
+
+        template <typename Iter>
+        void sort_values(Iter first, Iter last, std::true_type)
+        {
+            util::counting_sort(first, last);
+        }
+
+        template <typename T, typename Iter>
+        void sort_values(Iter first, Iter last)
+        {
+            sort_values(first, last,
+                typename std::is_same<T, std::uint8_t>::type{});
+        }
+
+        // indices sorting the given sequence, sequentially
+        template <typename Slice>
+        void argsort_slice(Slice const& values, std::vector<std::int64_t>& idx)
+        {
+            idx.resize(values.size());
+            std::iota(idx.begin(), idx.end(), std::int64_t(0));
+            std::stable_sort(idx.begin(), idx.end(),
+                [&](std::int64_t lhs, std::int64_t rhs)
+                {
+                    return util::less_nan_last{}(values[lhs], values[rhs]);
+                });
+        }
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    sort_operation::sort_operation(primitive_arguments_type&& operands,
+            std::string const& name, std::string const& codename)
+      : primitive_component_base(std::move(operands), name, codename)
+      , mode_(detail::extract_sort_mode(name_))
+    {}
+
+    ///////////////////////////////////////////////////////////////////////////
+    template <typename T>
+    primitive_argument_type sort_operation::sort0d(ir::node_data<T>&& arg) const
+    {
+        if (mode_ == sort_mode_argsort)
+        {
+            return primitive_argument_type{
+                blaze::DynamicVector<std::int64_t>(1, 0)};
+        }
+        return primitive_argument_type{
+            blaze::DynamicVector<T>(1, arg.scalar())};
+    }
+
+    template <typename T>
+    primitive_argument_type sort_operation::sort1d(ir::node_data<T>&& arg) const
+    {
+        auto v = arg.vector();
+
+        if (mode_ == sort_mode_argsort)
+        {
+            std::vector<std::int64_t> indices = util::sorted_indices(
+                v.size(), [&](std::int64_t lhs, std::int64_t rhs)
+                {
+                    return util::less_nan_last{}(v[lhs], v[rhs]);
+                });
+
+            blaze::DynamicVector<std::int64_t> result(indices.size());
+            std::copy(indices.begin(), indices.end(), result.begin());
+            return primitive_argument_type{std::move(result)};
+        }
+
+        blaze::DynamicVector<T> result = v;
+        detail::sort_values<T>(result.begin(), result.end());
+        return primitive_argument_type{std::move(result)};
+    }
+
+    template <typename T>
+    primitive_argument_type sort_operation::sort2d_flatten(
+        ir::node_data<T>&& arg) const
+    {
+        auto m = arg.matrix();
+
+        blaze::DynamicVector<T> flat(m.rows() * m.columns());
+        auto d = flat.begin();
+        for (std::size_t row = 0; row != m.rows(); ++row)
+        {
+            d = std::copy(m.begin(row), m.end(row), d);
+        }
+
+        return sort1d(ir::node_data<T>{std::move(flat)});
+    }
+
+    template <typename T>
+    primitive_argument_type sort_operation::sort2d_rows(
+        ir::node_data<T>&& arg) const
+    {
+        auto m = arg.matrix();
+
+        if (mode_ == sort_mode_argsort)
+        {
+            blaze::DynamicMatrix<std::int64_t> result(m.rows(), m.columns());
+            detail::sort_for_slices(m.rows(), m.columns(),
+                [&](std::size_t row)
+                {
+                    std::vector<std::int64_t> indices;
+                    detail::argsort_slice(blaze::row(m, row), indices);
+                    std::copy(
+                        indices.begin(), indices.end(), result.begin(row));
+                });
+            return primitive_argument_type{std::move(result)};
+        }
+
+        blaze::DynamicMatrix<T> result = m;
+        detail::sort_for_slices(m.rows(), m.columns(),
+            [&](std::size_t row)
+            {
+                std::sort(result.begin(row), result.end(row),
+                    util::less_nan_last{});
+            });
+        return primitive_argument_type{std::move(result)};
+    }
+
+    template <typename T>
+    primitive_argument_type sort_operation::sort2d_columns(
+        ir::node_data<T>&& arg) const
+    {
+        auto m = arg.matrix();
+
+        if (mode_ == sort_mode_argsort)
+        {
+            blaze::DynamicMatrix<std::int64_t> result(m.rows(), m.columns());
+            detail::sort_for_slices(m.columns(), m.rows(),
+                [&](std::size_t col)
+                {
+                    std::vector<std::int64_t> indices;
+                    detail::argsort_slice(blaze::column(m, col), indices);
+
+                    auto result_column = blaze::column(result, col);
+                    std::copy(indices.begin(), indices.end(),
+                        result_column.begin());
+                });
+            return primitive_argument_type{std::move(result)};
+        }
+
+        // sort a contiguous copy of each of the columns
+        blaze::DynamicMatrix<T> result(m.rows(), m.columns());
+        detail::sort_for_slices(m.columns(), m.rows(),
+            [&](std::size_t col)
+            {
+                auto column = blaze::column(m, col);
+                std::vector<T> values(column.begin(), column.end());
+                std::sort(values.begin(), values.end(),
+                    util::less_nan_last{});
+
+                auto result_column = blaze::column(result, col);
+                std::copy(values.begin(), values.end(), result_column.begin());
+            });
+        return primitive_argument_type{std::move(result)};
+    }
+
+    template <typename T>
+    primitive_argument_type sort_operation::sort2d(ir::node_data<T>&& arg,
+        hpx::util::optional<std::int64_t> const& axis) const
+    {
+        if (!axis)
+        {
+            return sort2d_flatten(std::move(arg));
+        }
+
+        switch (*axis)
+        {
+        case -2: HPX_FALLTHROUGH;
+        case 0:
+            return sort2d_columns(std::move(arg));
+
+        case -1: HPX_FALLTHROUGH;
+        case 1:
+            return sort2d_rows(std::move(arg));
+
+        default:
+            break;
+        }
+
+        HPX_THROW_EXCEPTION(hpx::bad_parameter,
+            "sort_operation::sort2d",
+            generate_error_message(
+                "operand axis can only be between -2 and 1 for an operand "
+                "that is 2d"));
+    }
+
+    template <typename T>
+    primitive_argument_type sort_operation::sort_helper(ir::node_data<T>&& arg,
+        hpx::util::optional<std::int64_t> const& axis) const
+    {
+        switch (arg.num_dimensions())
+        {
+        case 0:
+            return sort0d(std::move(arg));
+
+        case 1:
+            if (axis && *axis != 0 && *axis != -1)
+            {
+                HPX_THROW_EXCEPTION(hpx::bad_parameter,
+                    "sort_operation::sort_helper",
+                    generate_error_message(
+                        "operand axis can only be -1 or 0 for an operand "
+                        "that is 1d"));
+            }
+            return sort1d(std::move(arg));
+
+        case 2:
+            return sort2d(std::move(arg), axis);
+
+        default:
+            break;
+        }
+
+        HPX_THROW_EXCEPTION(hpx::bad_parameter,
+            "sort_operation::sort_helper",
+            generate_error_message(
+                "operand a has an unsupported number of dimensions"));
+    }
+
+    primitive_argument_type sort_operation::sort(
+        primitive_arguments_type&& args) const
+    {
+        hpx::util::optional<std::int64_t> axis(-1);
+        if (args.size() > 1)
+        {
+            if (valid(args[1]))
+            {
+                axis = extract_scalar_integer_value_strict(
+                    std::move(args[1]), name_, codename_);
+            }
+            else
+            {
+                axis = hpx::util::nullopt;
+            }
+        }
+
+        switch (extract_common_type(args[0]))
+        {
+        case node_data_type_bool:
+            return sort_helper(extract_boolean_value_strict(
+                std::move(args[0]), name_, codename_), axis);
+
+        case node_data_type_int64:
+            return sort_helper(extract_integer_value_strict(
+                std::move(args[0]), name_, codename_), axis);
+
+        case node_data_type_unknown: HPX_FALLTHROUGH;
+        case node_data_type_double:
+            return sort_helper(extract_numeric_value(
+                std::move(args[0]), name_, codename_), axis);
+
+        default:
+            break;
+        }
+
+        HPX_THROW_EXCEPTION(hpx::bad_parameter,
+            "sort_operation::sort",
+            generate_error_message(
+                "the sort primitive requires for all arguments to be numeric "
+                "data types"));
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    template <typename T>
+    primitive_argument_type sort_operation::searchsorted(
+        ir::node_data<T>&& a, ir::node_data<T>&& v, bool right) const
+    {
+        if (a.num_dimensions() != 1)
+        {
+            HPX_THROW_EXCEPTION(hpx::bad_parameter,
+                "sort_operation::searchsorted",
+                generate_error_message(
+                    "the first argument to searchsorted must be a vector"));
+        }
+
+        auto values = a.vector();
+        auto search = [&](T const& val) -> std::int64_t
+        {
+            auto it = right ?
+                std::upper_bound(values.begin(), values.end(), val) :
+                std::lower_bound(values.begin(), values.end(), val);
+            return std::distance(values.begin(), it);
+        };
+
+        switch (v.num_dimensions())
+        {
+        case 0:
+            return primitive_argument_type{search(v.scalar())};
+
+        case 1:
+            {
+                auto vec = v.vector();
+                blaze::DynamicVector<std::int64_t> result(vec.size());
+                detail::sort_for_slices(vec.size(), 1,
+                    [&](std::size_t i)
+                    {
+                        result[i] = search(vec[i]);
+                    });
+                return primitive_argument_type{std::move(result)};
+            }
+
+        case 2:
+            {
+                auto m = v.matrix();
+                blaze::DynamicMatrix<std::int64_t> result(
+                    m.rows(), m.columns());
+                detail::sort_for_slices(m.rows(), m.columns(),
+                    [&](std::size_t row)
+                    {
+                        for (std::size_t col = 0; col != m.columns(); ++col)
+                        {
+                            result(row, col) = search(m(row, col));
+                        }
+                    });
+                return primitive_argument_type{std::move(result)};
+            }
+
+        default:
+            break;
+        }
+
+        HPX_THROW_EXCEPTION(hpx::bad_parameter,
+            "sort_operation::searchsorted",
+            generate_error_message(
+                "operand v has an unsupported number of dimensions"));
+    }
+
+    primitive_argument_type sort_operation::searchsorted(
+        primitive_arguments_type&& args) const
+    {
+        bool right = false;
+        if (args.size() > 2 && valid(args[2]))
+        {
+            std::string side =
+                extract_string_value(std::move(args[2]), name_, codename_);
+            if (side != "left" && side != "right")
+            {
+                HPX_THROW_EXCEPTION(hpx::bad_parameter,
+                    "sort_operation::searchsorted",
+                    generate_error_message(
+                        "side must be either 'left' or 'right'"));
+            }
+            right = (side == "right");
+        }
+
+        switch (extract_common_type(args[0], args[1]))
+        {
+        case node_data_type_bool:
+            return searchsorted(
+                extract_boolean_value(std::move(args[0]), name_, codename_),
+                extract_boolean_value(std::move(args[1]), name_, codename_),
+                right);
+
+        case node_data_type_int64:
+            return searchsorted(
+                extract_integer_value(std::move(args[0]), name_, codename_),
+                extract_integer_value(std::move(args[1]), name_, codename_),
+                right);
+
+        case node_data_type_unknown: HPX_FALLTHROUGH;
+        case node_data_type_double:
+            return searchsorted(
+                extract_numeric_value(std::move(args[0]), name_, codename_),
+                extract_numeric_value(std::move(args[1]), name_, codename_),
+                right);
+
+        default:
+            break;
+        }
+
+        HPX_THROW_EXCEPTION(hpx::bad_parameter,
+            "sort_operation::searchsorted",
+            generate_error_message(
+                "the searchsorted primitive requires for all arguments to be "
+                "numeric data types"));
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    hpx::future<primitive_argument_type> sort_operation::eval(
+        primitive_arguments_type const& operands,
+        primitive_arguments_type const& args, eval_context ctx) const
+    {
+        std::size_t const min_operands =
+            mode_ == sort_mode_searchsorted ? 2 : 1;
+        std::size_t const max_operands =
+            mode_ == sort_mode_searchsorted ? 3 : 2;
+
+        if (operands.size() < min_operands || operands.size() > max_operands)
+        {
+            HPX_THROW_EXCEPTION(hpx::bad_parameter,
+                "sort_operation::eval",
+                generate_error_message(mode_ == sort_mode_searchsorted ?
+                    "the searchsorted primitive requires two or three "
+                        "operands" :
+                    "the sort primitive requires one or two operands"));
+        }
+
+        for (std::size_t i = 0; i != min_operands; ++i)
+        {
+            if (!valid(operands[i]))
+            {
+                HPX_THROW_EXCEPTION(hpx::bad_parameter,
+                    "sort_operation::eval",
+                    generate_error_message(
+                        "the sort primitive requires that the arguments "
+                        "given by the operands array are valid"));
+            }
+        }
+
+        auto this_ = this->shared_from_this();
+        return hpx::dataflow(hpx::launch::sync, hpx::util::unwrapping(
+            [this_ = std::move(this_)](primitive_arguments_type&& args)
+            ->  primitive_argument_type
+            {
+                if (this_->mode_ == sort_mode_searchsorted)
+                {
+                    return this_->searchsorted(std::move(args));
+                }
+                return this_->sort(std::move(args));
+            }),
+            detail::map_operands(operands, functional::value_operand{}, args,
+                name_, codename_, std::move(ctx)));
+    }
+}}}
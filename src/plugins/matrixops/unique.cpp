@@ -9,19 +9,22 @@
 #include <phylanx/execution_tree/primitives/node_data_helpers.hpp>
 #include <phylanx/ir/node_data.hpp>
 #include <phylanx/plugins/matrixops/unique.hpp>
-#include <phylanx/util/matrix_iterators.hpp>
+#include <phylanx/util/parallel_sort.hpp>
 
 #include <hpx/include/lcos.hpp>
 #include <hpx/include/naming.hpp>
 #include <hpx/include/util.hpp>
 #include <hpx/throw_exception.hpp>
-#include <hpx/util/iterator_facade.hpp>
+#include <hpx/util/optional.hpp>
 
 #include <algorithm>
 #include <cstddef>
 #include <cstdint>
 #include <memory>
+#include <numeric>
 #include <string>
+#include <type_traits>
+#include <unordered_map>
 #include <utility>
 #include <vector>
 
@@ -32,19 +35,179 @@ namespace phylanx { namespace execution_tree { namespace primitives
 {
     ///////////////////////////////////////////////////////////////////////////
     match_pattern_type const unique::match_data = {hpx::util::make_tuple(
-        "unique", std::vector<std::string>{"unique(_1)", "unique(_1, _2)"},
+        "unique", std::vector<std::string>{
+            "unique(_1, __arg(_2_axis, nil), __arg(_3_return_index, false), "
+                "__arg(_4_return_counts, false), __arg(_5_sorted, true))"
+        },
         &create_unique, &create_primitive<unique>, R"(
-            a, axis
+            a, axis, return_index, return_counts, sorted
             Args:
 
                 a (array_like) : input array
-                axis (optional, int): which axis of a to use
+                axis (optional, int): which axis of a to use, if not given
+                    the array is flattened
+                return_index (optional, bool): if true, also return the
+                    indices of the first occurrences of the unique values
+                return_counts (optional, bool): if true, also return the
+                    number of times each of the unique values appears in a
+                sorted (optional, bool): if false, the unique values are
+                    returned in the order of their first occurrence
 
             Returns:
 
-            The sorted unique elements of an array."
+            The sorted unique elements of an array. If return_index or
+            return_counts is true, a list holding the unique values followed
+            by the requested indices and counts.
             )")};
 
+    ///////////////////////////////////////////////////////////////////////////
+    struct unique::options
+    {
+        hpx::util::optional<std::int64_t> axis_;
+        bool return_index_ = false;
+        bool return_counts_ = false;
+        bool sorted_ = true;
+    };
+
+    ///////////////////////////////////////////////////////////////////////////
+    namespace detail
+    {
+        // positions of the first occurrences of all distinct elements, and
+        // the number of occurrences of each of them
+        struct unique_groups
+        {
+            std::vector<std::int64_t> first_;
+            std::vector<std::int64_t> counts_;
+        };
+
+        // Find distinct elements by sorting, the groups are ordered by value.
+        template <typename Less, typename Equal>
+        unique_groups unique_sorted(std::size_t n, Less&& less, Equal&& equal)
+        {
+            std::vector<std::int64_t> indices =
+                util::sorted_indices(n, std::forward<Less>(less));
+
+            unique_groups groups;
+            for (std::size_t i = 0; i != n; ++i)
+            {
+                if (i == 0 || !equal(indices[i - 1], indices[i]))
+                {
+                    groups.first_.push_back(indices[i]);
+                    groups.counts_.push_back(1);
+                }
+                else
+                {
+                    ++groups.counts_.back();
+                }
+            }
+            return groups;
+        }
+
+        // Find distinct elements by hashing, the groups are ordered by their
+        // first occurrence.
+        template <typename T, typename Vector>
+        unique_groups unique_hashed(Vector const& v)
+        {
+            std::unordered_map<T, std::size_t> positions;
+            positions.reserve(v.size());
+
+            unique_groups groups;
+            for (std::size_t i = 0; i != v.size(); ++i)
+            {
+                auto p = positions.emplace(v[i], groups.first_.size());
+                if (p.second)
+                {
+                    groups.first_.push_back(std::int64_t(i));
+                    groups.counts_.push_back(1);
+                }
+                else
+                {
+                    ++groups.counts_[p.first->second];
+                }
+            }
+            return groups;
+        }
+
+        // Reorder the groups by their first occurrence.
+        void order_by_first_occurrence(unique_groups& groups)
+        {
+            std::vector<std::size_t> order(groups.first_.size());
+            std::iota(order.begin(), order.end(), std::size_t(0));
+            std::sort(order.begin(), order.end(),
+                [&](std::size_t lhs, std::size_t rhs)
+                {
+                    return groups.first_[lhs] < groups.first_[rhs];
+                });
+
+            unique_groups result;
+            result.first_.reserve(order.size());
+            result.counts_.reserve(order.size());
+            for (std::size_t i : order)
+            {
+                result.first_.push_back(groups.first_[i]);
+                result.counts_.push_back(groups.counts_[i]);
+            }
+            groups = std::move(result);
+        }
+
+        template <typename Iter>
+        void unique_sort_values(Iter first, Iter last, std::false_type)
+        {
+            util::parallel_sort(first, last);
+        }
+
+        template <typename Iter>
+        void unique_sort_values(Iter first, Iter last, std::true_type)
+        {
+            util::counting_sort(first, last);
+        }
+
+        blaze::DynamicVector<std::int64_t> to_vector(
+            std::vector<std::int64_t> const& v)
+        {
+            blaze::DynamicVector<std::int64_t> result(v.size());
+            std::copy(v.begin(), v.end(), result.begin());
+            return result;
+        }
+
+        // Combine the unique values with the requested additional results.
+        primitive_argument_type unique_result(primitive_argument_type&& values,
+            unique_groups const& groups, bool return_index, bool return_counts)
+        {
+            if (!return_index && !return_counts)
+            {
+                return std::move(values);
+            }
+
+            primitive_arguments_type result;
+            result.reserve(3);
+            result.emplace_back(std::move(values));
+            if (return_index)
+            {
+                result.emplace_back(to_vector(groups.first_));
+            }
+            if (return_counts)
+            {
+                result.emplace_back(to_vector(groups.counts_));
+            }
+            return primitive_argument_type{std::move(result)};
+        }
+
+        // Lexicographically compare two rows (columns)
+        template <typename Slice>
+        bool slice_less(Slice const& lhs, Slice const& rhs)
+        {
+            return std::lexicographical_compare(lhs.begin(), lhs.end(),
+                rhs.begin(), rhs.end(), util::less_nan_last{});
+        }
+
+        template <typename Slice>
+        bool slice_equal(Slice const& lhs, Slice const& rhs)
+        {
+            return std::equal(lhs.begin(), lhs.end(), rhs.begin());
+        }
+    }
+
     ///////////////////////////////////////////////////////////////////////////
     unique::unique(primitive_arguments_type && operands,
         std::string const& name, std::string const& codename)
@@ -54,17 +217,22 @@ namespace phylanx { namespace execution_tree { namespace primitives
 
     ///////////////////////////////////////////////////////////////////////////
     template <typename T>
-    primitive_argument_type unique::unique0d(ir::node_data<T> && arg) const
+    primitive_argument_type unique::unique0d(
+        ir::node_data<T>&& arg, options const& opts) const
     {
+        detail::unique_groups groups;
+        groups.first_.push_back(0);
+        groups.counts_.push_back(1);
+
         blaze::DynamicVector<T> result(1UL, arg.scalar());
-        return primitive_argument_type{std::move(result)};
+        return detail::unique_result(primitive_argument_type{std::move(result)},
+            groups, opts.return_index_, opts.return_counts_);
     }
 
-    primitive_argument_type unique::unique0d(primitive_arguments_type && args)
-        const
+    primitive_argument_type unique::unique0d(
+        primitive_arguments_type&& args, options const& opts) const
     {
-        std::size_t numargs = args.size();
-        if (numargs == 2)
+        if (opts.axis_)
         {
             HPX_THROW_EXCEPTION(hpx::bad_parameter,
                 "phylanx::execution_tree::primitives::unique::unique0d",
@@ -75,19 +243,20 @@ namespace phylanx { namespace execution_tree { namespace primitives
         {
         case node_data_type_bool:
             return unique0d(extract_boolean_value_strict(
-                std::move(args[0]), name_, codename_));
+                std::move(args[0]), name_, codename_), opts);
 
         case node_data_type_int64:
             return unique0d(extract_integer_value_strict(
-                std::move(args[0]), name_, codename_));
+                std::move(args[0]), name_, codename_), opts);
 
         case node_data_type_double:
             return unique0d(extract_numeric_value_strict(
-                std::move(args[0]), name_, codename_));
+                std::move(args[0]), name_, codename_), opts);
 
         case node_data_type_unknown:
             return unique0d(
-                extract_numeric_value(std::move(args[0]), name_, codename_));
+                extract_numeric_value(std::move(args[0]), name_, codename_),
+                opts);
 
         default:
             break;
@@ -102,56 +271,82 @@ namespace phylanx { namespace execution_tree { namespace primitives
 
     ///////////////////////////////////////////////////////////////////////////
     template <typename T>
-    primitive_argument_type unique::unique1d(ir::node_data<T> && arg) const
+    primitive_argument_type unique::unique1d(
+        ir::node_data<T>&& arg, options const& opts) const
     {
-        blaze::DynamicVector<T> a = arg.vector();
-        // Sorting the vector
-        std::sort(a.begin(), a.end());
+        auto v = arg.vector();
+
+        if (!opts.return_index_ && !opts.return_counts_ && opts.sorted_)
+        {
+            // only the values are needed, sort a copy and remove duplicates
+            blaze::DynamicVector<T> a = v;
+            detail::unique_sort_values(a.begin(), a.end(),
+                typename std::is_same<T, std::uint8_t>::type{});
+
+            auto ip = std::unique(a.begin(), a.end());
+            a.resize(std::distance(a.begin(), ip));
 
-        // Use std::unique to remove duplicacy
-        auto ip = std::unique(a.begin(), a.end());
+            return primitive_argument_type{std::move(a)};
+        }
 
-        // Resizing the vector to remove undifined elements
-        a.resize(std::distance(a.begin(), ip));
+        detail::unique_groups groups;
+        if (opts.sorted_)
+        {
+            groups = detail::unique_sorted(v.size(),
+                [&](std::int64_t lhs, std::int64_t rhs)
+                {
+                    return util::less_nan_last{}(v[lhs], v[rhs]);
+                },
+                [&](std::int64_t lhs, std::int64_t rhs)
+                {
+                    return v[lhs] == v[rhs];
+                });
+        }
+        else
+        {
+            groups = detail::unique_hashed<T>(v);
+        }
 
-        return primitive_argument_type{std::move(a)};
+        blaze::DynamicVector<T> result(groups.first_.size());
+        for (std::size_t i = 0; i != groups.first_.size(); ++i)
+        {
+            result[i] = v[groups.first_[i]];
+        }
+
+        return detail::unique_result(primitive_argument_type{std::move(result)},
+            groups, opts.return_index_, opts.return_counts_);
     }
 
-    primitive_argument_type unique::unique1d(primitive_arguments_type && args)
-        const
+    primitive_argument_type unique::unique1d(
+        primitive_arguments_type&& args, options const& opts) const
     {
-        std::int64_t axis = 0;
-        std::size_t numargs = args.size();
-        if (numargs == 2)
+        if (opts.axis_ && (*opts.axis_ < -1 || *opts.axis_ > 0))
         {
-            axis = extract_scalar_integer_value(args[1], name_, codename_);
-            if (axis < -1 || axis > 0)
-            {
-                HPX_THROW_EXCEPTION(hpx::bad_parameter,
-                    "phylanx::execution_tree::primitives::argmax::argmax1d",
-                    generate_error_message(
-                        "operand axis can only between -1 and 0 for "
-                        "an a operand that is 1d"));
-            }
+            HPX_THROW_EXCEPTION(hpx::bad_parameter,
+                "phylanx::execution_tree::primitives::unique::unique1d",
+                generate_error_message(
+                    "operand axis can only between -1 and 0 for "
+                    "an a operand that is 1d"));
         }
 
         switch (extract_common_type(args[0]))
         {
         case node_data_type_bool:
             return unique1d(extract_boolean_value_strict(
-                std::move(args[0]), name_, codename_));
+                std::move(args[0]), name_, codename_), opts);
 
         case node_data_type_int64:
             return unique1d(extract_integer_value_strict(
-                std::move(args[0]), name_, codename_));
+                std::move(args[0]), name_, codename_), opts);
 
         case node_data_type_double:
             return unique1d(extract_numeric_value_strict(
-                std::move(args[0]), name_, codename_));
+                std::move(args[0]), name_, codename_), opts);
 
         case node_data_type_unknown:
             return unique1d(
-                extract_numeric_value(std::move(args[0]), name_, codename_));
+                extract_numeric_value(std::move(args[0]), name_, codename_),
+                opts);
 
         default:
             break;
@@ -160,176 +355,146 @@ namespace phylanx { namespace execution_tree { namespace primitives
         HPX_THROW_EXCEPTION(hpx::bad_parameter,
             "phylanx::execution_tree::primitives::unique::unique1d",
             generate_error_message(
-                "the arange primitive requires for all arguments to "
+                "the unique primitive requires for all arguments to "
                 "be numeric data types"));
     }
 
     ///////////////////////////////////////////////////////////////////////////
     template <typename T>
     primitive_argument_type unique::unique2d_flatten(
-        ir::node_data<T>&& arg) const
+        ir::node_data<T>&& arg, options const& opts) const
     {
-        using phylanx::util::matrix_row_iterator;
         auto a = arg.matrix();
 
-        const matrix_row_iterator<decltype(a)> a_begin(a);
-        const matrix_row_iterator<decltype(a)> a_end(a, a.rows());
-
-        blaze::DynamicVector<double> result(a.rows() * a.columns());
-        auto d = result.data();
-
-        for (auto it = a_begin; it != a_end; ++it)
+        blaze::DynamicVector<T> flat(a.rows() * a.columns());
+        auto d = flat.begin();
+        for (std::size_t row = 0; row != a.rows(); ++row)
         {
-            d = std::copy(it->begin(), it->end(), d);
+            d = std::copy(a.begin(row), a.end(row), d);
         }
 
-        // Sorting the vector
-        std::sort(result.begin(), result.end());
-
-        // Use std::unique to remove duplicacy
-        auto ip = std::unique(result.begin(), result.end());
-
-        // Resizing the vector to remove undifined elements
-        result.resize(std::distance(result.begin(), ip));
-
-        return primitive_argument_type{std::move(result)};
+        return unique1d(ir::node_data<T>{std::move(flat)}, opts);
     }
 
     template <typename T>
     primitive_argument_type unique::unique2d_x_axis(
-        ir::node_data<T>&& arg) const
+        ir::node_data<T>&& arg, options const& opts) const
     {
         auto a = arg.matrix();
 
-        using phylanx::util::matrix_row_iterator;
-        matrix_row_iterator<decltype(a)> a_begin(a);
-
-        blaze::DynamicMatrix<T> result(a.rows(), a.columns());
-
-        std::vector<matrix_row_iterator<decltype(a)>> indices(
-            a.rows(), a_begin);
-        std::iota(indices.begin(), indices.end(), a_begin);
-
-        std::sort(indices.begin(), indices.end(),
-            [&](const auto& lhs, const auto& rhs) {
-                return std::lexicographical_compare(
-                    lhs->begin(), lhs->end(), rhs->begin(), rhs->end());
+        detail::unique_groups groups = detail::unique_sorted(a.rows(),
+            [&](std::int64_t lhs, std::int64_t rhs)
+            {
+                return detail::slice_less(
+                    blaze::row(a, lhs), blaze::row(a, rhs));
+            },
+            [&](std::int64_t lhs, std::int64_t rhs)
+            {
+                return detail::slice_equal(
+                    blaze::row(a, lhs), blaze::row(a, rhs));
             });
 
-        for (size_t i = 0; i < a.rows(); i++)
+        if (!opts.sorted_)
+        {
+            detail::order_by_first_occurrence(groups);
+        }
+
+        blaze::DynamicMatrix<T> result(groups.first_.size(), a.columns());
+        for (std::size_t i = 0; i != groups.first_.size(); ++i)
         {
-            blaze::row(result, i) = *(indices[i]);
+            blaze::row(result, i) = blaze::row(a, groups.first_[i]);
         }
 
-        return primitive_argument_type{std::move(result)};
+        return detail::unique_result(primitive_argument_type{std::move(result)},
+            groups, opts.return_index_, opts.return_counts_);
     }
 
     template <typename T>
     primitive_argument_type unique::unique2d_y_axis(
-        ir::node_data<T>&& arg) const
+        ir::node_data<T>&& arg, options const& opts) const
     {
         auto a = arg.matrix();
 
-        using phylanx::util::matrix_column_iterator;
-        matrix_column_iterator<decltype(a)> a_begin(a);
-
-        blaze::DynamicMatrix<T> result(a.rows(), a.columns());
-
-        std::vector<matrix_column_iterator<decltype(a)>> indices(
-            a.columns(), a_begin);
-        std::iota(indices.begin(), indices.end(), a_begin);
-
-        std::sort(indices.begin(), indices.end(),
-            [&](const auto& lhs, const auto& rhs) {
-                return std::lexicographical_compare(
-                    lhs->begin(), lhs->end(), rhs->begin(), rhs->end());
+        detail::unique_groups groups = detail::unique_sorted(a.columns(),
+            [&](std::int64_t lhs, std::int64_t rhs)
+            {
+                return detail::slice_less(
+                    blaze::column(a, lhs), blaze::column(a, rhs));
+            },
+            [&](std::int64_t lhs, std::int64_t rhs)
+            {
+                return detail::slice_equal(
+                    blaze::column(a, lhs), blaze::column(a, rhs));
             });
 
-        for (size_t i = 0; i < a.columns(); i++)
+        if (!opts.sorted_)
+        {
+            detail::order_by_first_occurrence(groups);
+        }
+
+        blaze::DynamicMatrix<T> result(a.rows(), groups.first_.size());
+        for (std::size_t i = 0; i != groups.first_.size(); ++i)
         {
-            blaze::column(result, i) = *(indices[i]);
+            blaze::column(result, i) = blaze::column(a, groups.first_[i]);
         }
 
-        return primitive_argument_type{std::move(result)};
+        return detail::unique_result(primitive_argument_type{std::move(result)},
+            groups, opts.return_index_, opts.return_counts_);
     }
 
     template <typename T>
     primitive_argument_type unique::unique2d(
-        std::size_t numargs, ir::node_data<T>&& arg, std::int64_t axis) const
+        ir::node_data<T>&& arg, options const& opts) const
     {
-        // m should not be empty
-        auto m = arg.matrix();
-
         // `axis` is optional
-        if (numargs == 1)
+        if (!opts.axis_)
         {
-            // Option 1: Flatten and find max
-            return unique2d_flatten(std::move(arg));
+            // Option 1: Flatten and find unique values
+            return unique2d_flatten(std::move(arg), opts);
         }
 
         // `axis` can only be -2, -1, 0, or 1
-        if (axis < -2 || axis > 1)
-        {
-            HPX_THROW_EXCEPTION(hpx::bad_parameter,
-                "unique::unique2d",
-                generate_error_message(
-                    "operand axis can only between -2 and 1 for an an "
-                    "operand that is 2d"));
-        }
-
-        switch (axis)
+        switch (*opts.axis_)
         {
         case -2:
             HPX_FALLTHROUGH;
         case 0:
-            return unique2d_x_axis(std::move(arg));
+            return unique2d_x_axis(std::move(arg), opts);
         case -1:
             HPX_FALLTHROUGH;
         case 1:
-            return unique2d_y_axis(std::move(arg));
+            return unique2d_y_axis(std::move(arg), opts);
 
         default:
             HPX_THROW_EXCEPTION(hpx::bad_parameter,
                 "unique::unique2d",
                 generate_error_message(
-                    "operand has an invalid value for the axis parameter"));
+                    "operand axis can only between -2 and 1 for an an "
+                    "operand that is 2d"));
         }
     }
 
     primitive_argument_type unique::unique2d(
-        primitive_arguments_type&& args) const
+        primitive_arguments_type&& args, options const& opts) const
     {
-        std::int64_t axis = -1;
-        std::size_t numargs = args.size();
-        if (numargs == 2)
-        {
-            axis = extract_scalar_integer_value(args[1], name_, codename_);
-        }
-
         switch (extract_common_type(args[0]))
         {
         case node_data_type_bool:
-            return unique2d(numargs,
-                extract_boolean_value_strict(
-                    std::move(args[0]), name_, codename_),
-                axis);
+            return unique2d(extract_boolean_value_strict(
+                std::move(args[0]), name_, codename_), opts);
 
         case node_data_type_int64:
-            return unique2d(numargs,
-                extract_integer_value_strict(
-                    std::move(args[0]), name_, codename_),
-                axis);
+            return unique2d(extract_integer_value_strict(
+                std::move(args[0]), name_, codename_), opts);
 
         case node_data_type_double:
-            return unique2d(numargs,
-                extract_numeric_value_strict(
-                    std::move(args[0]), name_, codename_),
-                axis);
+            return unique2d(extract_numeric_value_strict(
+                std::move(args[0]), name_, codename_), opts);
 
         case node_data_type_unknown:
-            return unique2d(numargs,
+            return unique2d(
                 extract_numeric_value(std::move(args[0]), name_, codename_),
-                axis);
+                opts);
 
         default:
             break;
@@ -347,24 +512,21 @@ namespace phylanx { namespace execution_tree { namespace primitives
         primitive_arguments_type const& operands,
         primitive_arguments_type const& args, eval_context ctx) const
     {
-        if (operands.empty() || operands.size() > 2)
+        if (operands.empty() || operands.size() > 5)
         {
             HPX_THROW_EXCEPTION(hpx::bad_parameter,
                 "unique::eval",
-                generate_error_message("the unique primitive requires exactly "
-                                       "one or two operands"));
+                generate_error_message("the unique primitive requires "
+                                       "between one and five operands"));
         }
 
-        for (auto const& i : operands)
+        if (!valid(operands[0]))
         {
-            if (!valid(i))
-            {
-                HPX_THROW_EXCEPTION(hpx::bad_parameter,
-                    "unique::eval",
-                    generate_error_message(
-                        "the unique primitive requires that the "
-                        "arguments given by the operands array are valid"));
-            }
+            HPX_THROW_EXCEPTION(hpx::bad_parameter,
+                "unique::eval",
+                generate_error_message(
+                    "the unique primitive requires that the "
+                    "arguments given by the operands array are valid"));
         }
 
         auto this_ = this->shared_from_this();
@@ -372,18 +534,40 @@ namespace phylanx { namespace execution_tree { namespace primitives
             hpx::util::unwrapping([this_ = std::move(this_)](
                                       primitive_arguments_type&& args)
                                       -> primitive_argument_type {
+                options opts;
+                if (args.size() > 1 && valid(args[1]))
+                {
+                    opts.axis_ = extract_scalar_integer_value(
+                        args[1], this_->name_, this_->codename_);
+                }
+                if (args.size() > 2 && valid(args[2]))
+                {
+                    opts.return_index_ = extract_scalar_boolean_value(
+                        args[2], this_->name_, this_->codename_);
+                }
+                if (args.size() > 3 && valid(args[3]))
+                {
+                    opts.return_counts_ = extract_scalar_boolean_value(
+                        args[3], this_->name_, this_->codename_);
+                }
+                if (args.size() > 4 && valid(args[4]))
+                {
+                    opts.sorted_ = extract_scalar_boolean_value(
+                        args[4], this_->name_, this_->codename_);
+                }
+
                 std::size_t a_dims = extract_numeric_value_dimension(
                     args[0], this_->name_, this_->codename_);
                 switch (a_dims)
                 {
                 case 0:
-                    return this_->unique0d(std::move(args));
+                    return this_->unique0d(std::move(args), opts);
 
                 case 1:
-                    return this_->unique1d(std::move(args));
+                    return this_->unique1d(std::move(args), opts);
 
                 case 2:
-                    return this_->unique2d(std::move(args));
+                    return this_->unique2d(std::move(args), opts);
 
                 default:
                     HPX_THROW_EXCEPTION(hpx::bad_parameter,
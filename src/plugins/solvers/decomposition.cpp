@@ -8,6 +8,8 @@
 #include <phylanx/execution_tree/compiler/primitive_name.hpp>
 #include <phylanx/ir/node_data.hpp>
 #include <phylanx/plugins/solvers/decomposition.hpp>
+#include <phylanx/util/philox.hpp>
+#include <phylanx/util/random.hpp>
 
 #include <hpx/include/lcos.hpp>
 #include <hpx/include/naming.hpp>
@@ -15,10 +17,12 @@
 #include <hpx/throw_exception.hpp>
 #include <hpx/util/assert.hpp>
 
+#include <algorithm>
 #include <cmath>
 #include <cstddef>
 #include <map>
 #include <memory>
+#include <random>
 #include <string>
 #include <utility>
 #include <vector>
@@ -29,7 +33,7 @@
 namespace phylanx { namespace execution_tree { namespace primitives
 {
 ///////////////////////////////////////////////////////////////////////////////
-#define PHYLANX_DECOM_MATCH_DATA(name)                                         \
+#define PHYLANX_DECOM_MATCH_DATA(name, doc)                                    \
     match_pattern_type{name, std::vector<std::string>{name "(_1)"},            \
         &create_decomposition, &create_primitive<decomposition>,               \
         "m\n"                                                                  \
@@ -39,42 +43,279 @@ namespace phylanx { namespace execution_tree { namespace primitives
         "\n"                                                                   \
         "Returns:\n"                                                           \
         "\n"                                                                   \
-        "Computes LU decomposition of a general matrix in form of "            \
-        "A = L*U*P where P is a permutation matrix, L is a lower "             \
-        "triangular matrix, and U is an upper triangular matrix. "             \
+        doc                                                                    \
     }                                                                          \
     /**/
 
     std::vector<match_pattern_type> const decomposition::match_data = {
-        PHYLANX_DECOM_MATCH_DATA("lu")};
+        PHYLANX_DECOM_MATCH_DATA("lu",
+            "Computes LU decomposition of a general matrix in form of "
+            "A = L*U*P where P is a permutation matrix, L is a lower "
+            "triangular matrix, and U is an upper triangular matrix. "),
+        PHYLANX_DECOM_MATCH_DATA("cholesky",
+            "Computes the Cholesky decomposition of a symmetric positive "
+            "definite matrix in form of A = L*L' where L is a lower "
+            "triangular matrix. Returns L."),
+        PHYLANX_DECOM_MATCH_DATA("qr",
+            "Computes the QR decomposition of a general matrix in form of "
+            "A = Q*R where Q is an orthogonal matrix and R is an upper "
+            "triangular matrix. Returns the list (Q, R)."),
+        match_pattern_type{"svd",
+            std::vector<std::string>{"svd(_1)", "svd(_1, _2)"},
+            &create_decomposition, &create_primitive<decomposition>, R"(
+            m, k
+            Args:
+
+                m (matrix): a matrix
+                k (optional, int): the number of singular values to compute
+
+            Returns:
+
+            Computes the singular value decomposition of a general matrix in
+            form of A = U*diag(s)*V where the columns of U are the left
+            singular vectors and the rows of V are the right singular
+            vectors. Returns the list (U, s, V). If k is given, only the k
+            largest singular values and the corresponding singular vectors
+            are computed using a randomized algorithm.)"
+        },
+        PHYLANX_DECOM_MATCH_DATA("eigh",
+            "Computes the eigenvalues and eigenvectors of a symmetric matrix, "
+            "only the lower triangle of the matrix is used. "
+            "Returns the list (w, V) where w holds the eigenvalues in "
+            "ascending order and the columns of V are the corresponding "
+            "eigenvectors.")
+    };
 
 #undef PHYLANX_DECOM_MATCH_DATA
 
     ///////////////////////////////////////////////////////////////////////////
-    decomposition::vector_function_ptr decomposition::get_decomposition_map(
-        std::string const& name) const
+    namespace detail
     {
-        static std::map<std::string, vector_function_ptr> decompositions = {{"lu",
-            //computes LU decomposition of a general matrix in form of
-            // A = L*U*P where P is a permutation matrix, L is a lower
-            // triangular matrix, and U is an upper triangular matrix.
-            [](args_type&& args) -> primitive_argument_type {
-                storage2d_type P, L, U;
-
-                if (!args[0].is_ref())
+        using storage1d_type = ir::node_data<double>::storage1d_type;
+        using storage2d_type = ir::node_data<double>::storage2d_type;
+
+        storage2d_type extract_matrix(ir::node_data<double>&& arg)
+        {
+            if (!arg.is_ref())
+            {
+                return std::move(arg.matrix_non_ref());
+            }
+            return storage2d_type{arg.matrix()};
+        }
+
+        void verify_square(storage2d_type const& m, char const* func)
+        {
+            if (m.rows() != m.columns())
+            {
+                HPX_THROW_EXCEPTION(hpx::bad_parameter, func,
+                    "the decomposition requires the operand to be a "
+                    "square matrix");
+            }
+        }
+
+        ///////////////////////////////////////////////////////////////////////
+        // a is overwritten by the factor L
+        primitive_argument_type cholesky(storage2d_type&& a)
+        {
+            verify_square(a, "decomposition::cholesky");
+
+            blaze::potrf(a, 'L');
+
+            // clear the upper triangle, which still holds the operand
+            std::size_t const n = a.rows();
+            for (std::size_t i = 0; i != n; ++i)
+            {
+                for (std::size_t j = i + 1; j != n; ++j)
                 {
-                    blaze::lu(args[0].matrix(), L, U, P);
+                    a(i, j) = 0.0;
                 }
-                else
+            }
+            return primitive_argument_type{std::move(a)};
+        }
+
+        ///////////////////////////////////////////////////////////////////////
+        primitive_argument_type qr(storage2d_type&& a)
+        {
+            storage2d_type q, r;
+            blaze::qr(a, q, r);
+
+            return primitive_argument_type{primitive_arguments_type{
+                primitive_argument_type{std::move(q)},
+                primitive_argument_type{std::move(r)}}};
+        }
+
+        ///////////////////////////////////////////////////////////////////////
+        // number of additional samples and power iterations used by the
+        // randomized SVD
+        constexpr std::size_t randomized_svd_oversampling = 10;
+        constexpr std::size_t randomized_svd_iterations = 2;
+
+        // orthonormal basis of the columns of the given matrix
+        storage2d_type orthonormal_basis(storage2d_type const& y)
+        {
+            storage2d_type q, r;
+            blaze::qr(y, q, r);
+            return q;
+        }
+
+        storage2d_type gaussian_matrix(std::size_t rows, std::size_t columns)
+        {
+            storage2d_type result(rows, columns);
+
+            util::philox4x32 gen(util::next_random_key());
+            std::normal_distribution<double> dist;
+            for (std::size_t i = 0; i != rows; ++i)
+            {
+                for (std::size_t j = 0; j != columns; ++j)
                 {
-                    storage2d_type A{(args[0].matrix())};
-                    blaze::lu(A, L, U, P);
+                    result(i, j) = dist(gen);
                 }
-                return primitive_argument_type{
-                    primitive_arguments_type{
-                        primitive_argument_type{L}, primitive_argument_type{U},
-                        primitive_argument_type{P}}};
-            }}};
+            }
+            return result;
+        }
+
+        primitive_argument_type svd_result(storage2d_type&& u,
+            storage1d_type&& s, storage2d_type&& v, std::size_t k)
+        {
+            if (k < s.size())
+            {
+                u = storage2d_type{blaze::submatrix(u, 0, 0, u.rows(), k)};
+                s = storage1d_type{blaze::subvector(s, 0, k)};
+                v = storage2d_type{blaze::submatrix(v, 0, 0, k, v.columns())};
+            }
+
+            return primitive_argument_type{primitive_arguments_type{
+                primitive_argument_type{std::move(u)},
+                primitive_argument_type{std::move(s)},
+                primitive_argument_type{std::move(v)}}};
+        }
+
+        // Randomized truncated SVD (Halko, Martinsson, Tropp, 'Finding
+        // Structure with Randomness', 2011).
+        primitive_argument_type svd(storage2d_type&& a, std::size_t k)
+        {
+            std::size_t const n = (std::min)(a.rows(), a.columns());
+            std::size_t const l =
+                (std::min)(k + randomized_svd_oversampling, n);
+
+            storage2d_type u, v;
+            storage1d_type s;
+
+            if (l == n)
+            {
+                // the sketch would not be smaller than the matrix itself
+                blaze::svd(a, u, s, v);
+                return svd_result(std::move(u), std::move(s), std::move(v), k);
+            }
+
+            // find an orthonormal basis of the range of a
+            storage2d_type q =
+                orthonormal_basis(a * gaussian_matrix(a.columns(), l));
+            for (std::size_t i = 0; i != randomized_svd_iterations; ++i)
+            {
+                storage2d_type z = orthonormal_basis(blaze::trans(a) * q);
+                q = orthonormal_basis(a * z);
+            }
+
+            // decompose the projection of a onto this basis
+            storage2d_type b = blaze::trans(q) * a;
+            storage2d_type ub;
+            blaze::svd(b, ub, s, v);
+            u = q * ub;
+
+            return svd_result(std::move(u), std::move(s), std::move(v), k);
+        }
+
+        primitive_argument_type svd(storage2d_type&& a)
+        {
+            storage2d_type u, v;
+            storage1d_type s;
+            blaze::svd(a, u, s, v);
+
+            return primitive_argument_type{primitive_arguments_type{
+                primitive_argument_type{std::move(u)},
+                primitive_argument_type{std::move(s)},
+                primitive_argument_type{std::move(v)}}};
+        }
+
+        ///////////////////////////////////////////////////////////////////////
+        // Only the lower triangle of the operand is used, it is assumed to
+        // be symmetric (as numpy.linalg.eigh does, the symmetry is not
+        // verified).
+        primitive_argument_type eigh(storage2d_type&& a)
+        {
+            verify_square(a, "decomposition::eigh");
+
+            // a is overwritten by the eigenvectors, stored in its rows
+            storage1d_type w;
+            blaze::syev(a, w, 'V', 'L');
+
+            return primitive_argument_type{primitive_arguments_type{
+                primitive_argument_type{std::move(w)},
+                primitive_argument_type{storage2d_type{blaze::trans(a)}}}};
+        }
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    decomposition::vector_function_ptr decomposition::get_decomposition_map(
+        std::string const& name) const
+    {
+        static std::map<std::string, vector_function_ptr> decompositions = {
+            {"lu",
+                //computes LU decomposition of a general matrix in form of
+                // A = L*U*P where P is a permutation matrix, L is a lower
+                // triangular matrix, and U is an upper triangular matrix.
+                [](args_type&& args) -> primitive_argument_type {
+                    storage2d_type P, L, U;
+
+                    if (!args[0].is_ref())
+                    {
+                        blaze::lu(args[0].matrix(), L, U, P);
+                    }
+                    else
+                    {
+                        storage2d_type A{(args[0].matrix())};
+                        blaze::lu(A, L, U, P);
+                    }
+                    return primitive_argument_type{
+                        primitive_arguments_type{primitive_argument_type{L},
+                            primitive_argument_type{U},
+                            primitive_argument_type{P}}};
+                }},
+            {"cholesky",
+                [](args_type&& args) -> primitive_argument_type {
+                    return detail::cholesky(
+                        detail::extract_matrix(std::move(args[0])));
+                }},
+            {"qr",
+                [](args_type&& args) -> primitive_argument_type {
+                    return detail::qr(
+                        detail::extract_matrix(std::move(args[0])));
+                }},
+            {"svd",
+                [](args_type&& args) -> primitive_argument_type {
+                    if (args.size() == 2)
+                    {
+                        double k = args[1].scalar();
+                        if (k < 1)
+                        {
+                            HPX_THROW_EXCEPTION(hpx::bad_parameter,
+                                "decomposition::svd",
+                                "the number of singular values to compute "
+                                "must be positive");
+                        }
+                        return detail::svd(
+                            detail::extract_matrix(std::move(args[0])),
+                            std::size_t(k));
+                    }
+                    return detail::svd(
+                        detail::extract_matrix(std::move(args[0])));
+                }},
+            {"eigh",
+                [](args_type&& args) -> primitive_argument_type {
+                    return detail::eigh(
+                        detail::extract_matrix(std::move(args[0])));
+                }}};
         return decompositions[name];
     }
 
@@ -117,17 +358,18 @@ namespace phylanx { namespace execution_tree { namespace primitives
         primitive_arguments_type const& operands,
         primitive_arguments_type const& args, eval_context ctx) const
     {
-        if (operands.size() != 1)
+        if (operands.empty() || operands.size() > 2)
         {
             HPX_THROW_EXCEPTION(hpx::bad_parameter,
                 "decomposition::eval",
                 util::generate_error_message(
                     "the decomposition  primitive "
-                    "requires exactly one operands ",
+                    "requires one or two operands ",
                     name_, codename_));
         }
 
-        if (!valid(operands[0]))
+        if (!valid(operands[0]) ||
+            (operands.size() == 2 && !valid(operands[1])))
         {
             HPX_THROW_EXCEPTION(hpx::bad_parameter,
                 "decomposition_operation::eval",
@@ -155,6 +397,16 @@ namespace phylanx { namespace execution_tree { namespace primitives
                                 this_->name_, this_->codename_));
                     }
 
+                    if (args.size() == 2 && args[1].num_dimensions() != 0)
+                    {
+                        HPX_THROW_EXCEPTION(hpx::bad_parameter,
+                            "decomposition_operation::eval",
+                            util::generate_error_message(
+                                "the decomposition primitive requires the "
+                                "second operand to be a scalar ",
+                                this_->name_, this_->codename_));
+                    }
+
                     return this_->calculate_decomposition(std::move(args));
                 }),
             detail::map_operands(operands, functional::numeric_operand{}, args,
@@ -0,0 +1,293 @@
+//  Copyright (c) 2019 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <phylanx/config.hpp>
+#include <phylanx/execution_tree/compiler/primitive_name.hpp>
+#include <phylanx/execution_tree/primitives/node_data_helpers.hpp>
+#include <phylanx/ir/node_data.hpp>
+#include <phylanx/plugins/solvers/factorize_operation.hpp>
+#include <phylanx/util/factorization.hpp>
+
+#include <hpx/include/lcos.hpp>
+#include <hpx/include/naming.hpp>
+#include <hpx/include/util.hpp>
+#include <hpx/throw_exception.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <blaze/Math.h>
+
+///////////////////////////////////////////////////////////////////////////////
+namespace phylanx { namespace execution_tree { namespace primitives
+{
+    ///////////////////////////////////////////////////////////////////////////
+    std::vector<match_pattern_type> const factorize_operation::match_data =
+    {
+        match_pattern_type{"factorize",
+            std::vector<std::string>{"factorize(_1, __arg(_2_kind, nil))"},
+            &create_factorize_operation,
+            &create_primitive<factorize_operation>, R"(
+            a, kind
+            Args:
+
+                a (matrix) : a square matrix
+                kind (optional, string) : the kind of the factorization,
+                    either 'lu' (the default, for general matrices),
+                    'cholesky' (for symmetric positive definite matrices),
+                    or 'ldlt' (for symmetric indefinite matrices)
+
+            Returns:
+
+            A factorization of `a` to be passed to `solve`. The factorization
+            can be stored in a variable and reused for many right hand sides,
+            its contents are an implementation detail.)"
+        },
+        match_pattern_type{"solve",
+            std::vector<std::string>{"solve(_1, _2)"},
+            &create_solve_operation,
+            &create_primitive<factorize_operation>, R"(
+            f, b
+            Args:
+
+                f (factorization or matrix) : the factorization of a matrix
+                    `a` as returned by `factorize`, or the matrix `a` itself
+                b (vector or matrix) : the right hand side(s), every column
+                    of a matrix is a separate right hand side
+
+            Returns:
+
+            The solution `x` of `a x = b`.)"
+        }
+    };
+
+    ///////////////////////////////////////////////////////////////////////////
+    namespace detail
+    {
+        factorize_operation::factorize_mode extract_factorize_mode(
+            std::string const& name)
+        {
+            compiler::primitive_name_parts name_parts;
+            if (!compiler::parse_primitive_name(name, name_parts))
+            {
+                if (name.find("solve") != std::string::npos)
+                {
+                    return factorize_operation::factorize_mode_solve;
+                }
+                return factorize_operation::factorize_mode_factorize;
+            }
+
+            if (name_parts.primitive == "solve")
+            {
+                return factorize_operation::factorize_mode_solve;
+            }
+            return factorize_operation::factorize_mode_factorize;
+        }
+
+        // The factorization object is represented as a list holding the
+        // kind of the factorization, the factors, and the pivots.
+        constexpr std::size_t factorization_size = 3;
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    factorize_operation::factorize_operation(
+            primitive_arguments_type&& operands,
+            std::string const& name, std::string const& codename)
+      : primitive_component_base(std::move(operands), name, codename)
+      , mode_(detail::extract_factorize_mode(name_))
+    {}
+
+    ///////////////////////////////////////////////////////////////////////////
+    util::factorization_kind factorize_operation::extract_kind(
+        primitive_argument_type const& kind) const
+    {
+        util::factorization_kind result = util::factorization_kind::lu;
+        if (valid(kind))
+        {
+            std::string name = extract_string_value(kind, name_, codename_);
+            if (!util::parse_factorization_kind(name, result))
+            {
+                HPX_THROW_EXCEPTION(hpx::bad_parameter,
+                    "factorize_operation::extract_kind",
+                    generate_error_message(
+                        "unknown factorization kind '" + name +
+                        "', expected 'lu', 'cholesky', or 'ldlt'"));
+            }
+        }
+        return result;
+    }
+
+    util::factorization::matrix_type factorize_operation::extract_square_matrix(
+        primitive_argument_type&& a) const
+    {
+        auto m = extract_numeric_value(std::move(a), name_, codename_);
+        if (m.num_dimensions() != 2 || m.dimension(0) != m.dimension(1))
+        {
+            HPX_THROW_EXCEPTION(hpx::bad_parameter,
+                "factorize_operation::extract_square_matrix",
+                generate_error_message(
+                    "the matrix to factorize has to be square"));
+        }
+        return util::factorization::matrix_type{m.matrix()};
+    }
+
+    util::factorization_kind factorize_operation::extract_factorization(
+        ir::range const& elements) const
+    {
+        util::factorization_kind kind;
+        if (elements.size() !=
+                std::ptrdiff_t(detail::factorization_size) ||
+            !is_string_operand(elements.begin().element()) ||
+            !util::parse_factorization_kind(
+                extract_string_value(
+                    elements.begin().element(), name_, codename_), kind))
+        {
+            HPX_THROW_EXCEPTION(hpx::bad_parameter,
+                "factorize_operation::extract_factorization",
+                generate_error_message(
+                    "the first argument to solve must be a factorization "
+                    "as returned by factorize or a square matrix"));
+        }
+        return kind;
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    primitive_argument_type factorize_operation::factorize(
+        primitive_argument_type&& a, util::factorization_kind kind) const
+    {
+        util::factorization f =
+            util::factorize(extract_square_matrix(std::move(a)), kind);
+
+        blaze::DynamicVector<std::int64_t> pivots(f.pivots_.size());
+        std::copy(f.pivots_.begin(), f.pivots_.end(), pivots.begin());
+
+        return primitive_argument_type{primitive_arguments_type{
+            primitive_argument_type{
+                std::string(util::factorization_kind_name(kind))},
+            primitive_argument_type{std::move(f.factors_)},
+            primitive_argument_type{std::move(pivots)}}};
+    }
+
+    template <typename MT>
+    primitive_argument_type factorize_operation::solve(
+        util::factorization_kind kind, MT const& factors, int const* pivots,
+        primitive_argument_type&& b) const
+    {
+        auto rhs = extract_numeric_value(std::move(b), name_, codename_);
+
+        if (rhs.num_dimensions() == 0 || rhs.num_dimensions() > 2 ||
+            rhs.dimension(0) != factors.rows())
+        {
+            HPX_THROW_EXCEPTION(hpx::bad_parameter,
+                "factorize_operation::solve",
+                generate_error_message(
+                    "the right hand side must be a vector or a matrix with "
+                    "as many rows as the factorized matrix"));
+        }
+
+        if (rhs.num_dimensions() == 1)
+        {
+            blaze::DynamicVector<double> x{rhs.vector()};
+            util::solve(kind, factors, pivots, x);
+            return primitive_argument_type{std::move(x)};
+        }
+
+        blaze::DynamicMatrix<double, blaze::columnMajor> x{rhs.matrix()};
+        util::solve(kind, factors, pivots, x);
+        return primitive_argument_type{blaze::DynamicMatrix<double>{x}};
+    }
+
+    primitive_argument_type factorize_operation::solve(
+        primitive_argument_type&& f, primitive_argument_type&& b) const
+    {
+        // a plain matrix is factorized on the fly
+        if (!is_list_operand_strict(f))
+        {
+            util::factorization factors = util::factorize(
+                extract_square_matrix(std::move(f)),
+                util::factorization_kind::lu);
+            return solve(factors.kind_, factors.factors_,
+                factors.pivots_.data(), std::move(b));
+        }
+
+        // the factors are used in place, only the pivots have to be
+        // converted to the integer type expected by LAPACK
+        ir::range elements = extract_list_value_strict(f, name_, codename_);
+        util::factorization_kind kind = extract_factorization(elements);
+
+        auto it = elements.begin();
+        auto factors =
+            extract_numeric_value((++it).element(), name_, codename_);
+        if (factors.num_dimensions() != 2 ||
+            factors.dimension(0) != factors.dimension(1))
+        {
+            HPX_THROW_EXCEPTION(hpx::bad_parameter,
+                "factorize_operation::solve",
+                generate_error_message("the factorization is malformed"));
+        }
+
+        std::vector<int> pivots;
+        if (kind != util::factorization_kind::cholesky)
+        {
+            auto p = extract_integer_value_strict(
+                (++it).element(), name_, codename_).vector();
+            pivots.assign(p.begin(), p.end());
+        }
+
+        return solve(kind, factors.matrix(), pivots.data(), std::move(b));
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    hpx::future<primitive_argument_type> factorize_operation::eval(
+        primitive_arguments_type const& operands,
+        primitive_arguments_type const& args, eval_context ctx) const
+    {
+        if (operands.empty() || operands.size() > 2 ||
+            (mode_ == factorize_mode_solve && operands.size() != 2))
+        {
+            HPX_THROW_EXCEPTION(hpx::bad_parameter,
+                "factorize_operation::eval",
+                generate_error_message(
+                    "factorize requires one or two operands, solve requires "
+                    "exactly two operands"));
+        }
+
+        if (!valid(operands[0]) ||
+            (mode_ == factorize_mode_solve && !valid(operands[1])))
+        {
+            HPX_THROW_EXCEPTION(hpx::bad_parameter,
+                "factorize_operation::eval",
+                generate_error_message(
+                    "the factorize_operation primitive requires that the "
+                    "arguments given by the operands array are valid"));
+        }
+
+        auto this_ = this->shared_from_this();
+        return hpx::dataflow(hpx::launch::sync,
+            hpx::util::unwrapping([this_ = std::move(this_)](
+                                      primitive_arguments_type&& args)
+                                      -> primitive_argument_type {
+                if (this_->mode_ == factorize_mode_solve)
+                {
+                    return this_->solve(
+                        std::move(args[0]), std::move(args[1]));
+                }
+
+                util::factorization_kind kind = util::factorization_kind::lu;
+                if (args.size() > 1)
+                {
+                    kind = this_->extract_kind(args[1]);
+                }
+                return this_->factorize(std::move(args[0]), kind);
+            }),
+            detail::map_operands(operands, functional::value_operand{}, args,
+                name_, codename_, std::move(ctx)));
+    }
+}}}
@@ -54,3 +54,8 @@ PHYLANX_REGISTER_PLUGIN_FACTORY(phylanx::plugin::decomposition_plugin,
     decomposition_plugin,
     phylanx::execution_tree::primitives::make_list::match_data,
     "_decomposition");
+
+PHYLANX_REGISTER_PLUGIN_FACTORY(factorize_operation_plugin,
+    phylanx::execution_tree::primitives::factorize_operation::match_data[0]);
+PHYLANX_REGISTER_PLUGIN_FACTORY(solve_operation_plugin,
+    phylanx::execution_tree::primitives::factorize_operation::match_data[1]);
@@ -0,0 +1,130 @@
+//  Copyright (c) 2019 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <phylanx/config.hpp>
+#include <phylanx/util/gemm.hpp>
+
+#include <hpx/include/runtime.hpp>
+#include <hpx/include/util.hpp>
+#include <hpx/throw_exception.hpp>
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace phylanx { namespace util
+{
+    ///////////////////////////////////////////////////////////////////////////
+    bool parse_gemm_backend(std::string const& name, gemm_backend& backend)
+    {
+        if (name == "auto")
+        {
+            backend = gemm_backend::automatic;
+        }
+        else if (name == "blaze")
+        {
+            backend = gemm_backend::blaze;
+        }
+        else if (name == "tiled")
+        {
+            backend = gemm_backend::tiled;
+        }
+        else
+        {
+            return false;
+        }
+        return true;
+    }
+
+    gemm_backend default_gemm_backend()
+    {
+        static gemm_backend const backend = []()
+        {
+            std::string const name =
+                hpx::get_config_entry("phylanx.dot.backend", "auto");
+
+            gemm_backend result = gemm_backend::automatic;
+            if (!parse_gemm_backend(name, result))
+            {
+                HPX_THROW_EXCEPTION(hpx::bad_parameter,
+                    "phylanx::util::default_gemm_backend",
+                    "unknown backend specified by phylanx.dot.backend: '" +
+                        name + "', expected 'auto', 'blaze', or 'tiled'");
+            }
+            return result;
+        }();
+        return backend;
+    }
+
+    std::size_t gemm_tile_size()
+    {
+        static std::size_t const tile_size = std::stoul(
+            hpx::get_config_entry("phylanx.dot.tile_size", "64"));
+        return tile_size;
+    }
+
+    std::size_t gemm_min_parallel_work()
+    {
+        static std::size_t const min_work = std::stoul(
+            hpx::get_config_entry("phylanx.dot.min_parallel_work", "4194304"));
+        return min_work;
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    // performance counter data, this is updated by every product, so no
+    // locks are taken and no ordering is required
+    static std::atomic<std::int64_t> gemm_flop_;
+    static std::atomic<std::int64_t> gemm_time_;
+
+    // the performance is calculated from separate accumulators, this allows
+    // to reset it independently from the other counters
+    static std::atomic<std::int64_t> gemm_rate_flop_;
+    static std::atomic<std::int64_t> gemm_rate_time_;
+
+    void record_gemm(std::int64_t flop, std::int64_t duration)
+    {
+        gemm_flop_.fetch_add(flop, std::memory_order_relaxed);
+        gemm_time_.fetch_add(duration, std::memory_order_relaxed);
+
+        gemm_rate_flop_.fetch_add(flop, std::memory_order_relaxed);
+        gemm_rate_time_.fetch_add(duration, std::memory_order_relaxed);
+    }
+
+    std::int64_t gemm_flop_count(bool reset)
+    {
+        return hpx::util::get_and_reset_value(gemm_flop_, reset);
+    }
+
+    std::int64_t gemm_time(bool reset)
+    {
+        return hpx::util::get_and_reset_value(gemm_time_, reset);
+    }
+
+    std::int64_t gemm_mflops(bool reset)
+    {
+        // the two accumulators are not read atomically together, a product
+        // recorded concurrently may be attributed to the next interval
+        std::int64_t flop = 0;
+        std::int64_t time = 0;
+        if (reset)
+        {
+            time = gemm_rate_time_.exchange(0, std::memory_order_relaxed);
+            flop = gemm_rate_flop_.exchange(0, std::memory_order_relaxed);
+        }
+        else
+        {
+            time = gemm_rate_time_.load(std::memory_order_relaxed);
+            flop = gemm_rate_flop_.load(std::memory_order_relaxed);
+        }
+
+        // flop per nanosecond is GFLOP/s
+        if (time == 0)
+        {
+            return 0;
+        }
+        return std::int64_t(1000.0 * double(flop) / double(time));
+    }
+}}
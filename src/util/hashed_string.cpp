@@ -5,6 +5,7 @@
 
 #include <phylanx/config.hpp>
 #include <phylanx/util/hashed_string.hpp>
+#include <phylanx/util/interned_string.hpp>
 
 #include <hpx/include/serialization.hpp>
 
@@ -17,13 +18,13 @@ namespace phylanx { namespace util
     void hashed_string::serialize(
         hpx::serialization::output_archive& ar, unsigned)
     {
-        ar & key_ & hash_;
+        ar & key_;
     }
 
     void hashed_string::serialize(
         hpx::serialization::input_archive& ar, unsigned)
     {
-        ar & key_ & hash_;
+        ar & key_;
     }
 
     ///////////////////////////////////////////////////////////////////////////
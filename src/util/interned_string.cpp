@@ -0,0 +1,138 @@
+//  Copyright (c) 2019 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <phylanx/config.hpp>
+#include <phylanx/util/interned_string.hpp>
+
+#include <hpx/include/serialization.hpp>
+#include <hpx/lcos/local/spinlock.hpp>
+#include <hpx/util/jenkins_hash.hpp>
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <iostream>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+namespace phylanx { namespace util
+{
+    namespace detail
+    {
+        ///////////////////////////////////////////////////////////////////////
+        // The table is split into shards selected by the hash of the string,
+        // each protected by its own lock. Strings are interned whenever a
+        // hashed_string is constructed from a std::string (e.g. by every
+        // lookup in the compiler environment), concurrent compilations
+        // would otherwise serialize on a single lock.
+        struct symbol_table
+        {
+            using mutex_type = hpx::lcos::local::spinlock;
+
+            static constexpr std::size_t num_shards = 32;
+
+            struct shard
+            {
+                mutex_type mtx_;
+                std::unordered_map<std::string, interned_string_entry const*>
+                    strings_;
+                std::deque<interned_string_entry> entries_;
+            };
+
+            symbol_table()
+              : count_(0)
+            {
+                // the empty string always has the id zero
+                empty_ = intern(std::string());
+            }
+
+            interned_string_entry const* intern(std::string const& key)
+            {
+                // the hash is needed for the entry anyway, compute it before
+                // taking the lock
+                hpx::util::jenkins_hash::size_type const hash =
+                    hpx::util::jenkins_hash{}(key);
+
+                shard& s = shards_[hash % num_shards];
+                std::lock_guard<mutex_type> l(s.mtx_);
+
+                auto it = s.strings_.find(key);
+                if (it != s.strings_.end())
+                {
+                    return it->second;
+                }
+
+                // the entry refers to the key stored in the map, which is
+                // stable as the map is node based
+                it = s.strings_.emplace(key, nullptr).first;
+                s.entries_.push_back(interned_string_entry{&it->first, hash,
+                    count_.fetch_add(1, std::memory_order_relaxed)});
+
+                it->second = &s.entries_.back();
+                return it->second;
+            }
+
+            std::size_t size() const
+            {
+                return count_.load(std::memory_order_relaxed);
+            }
+
+            std::array<shard, num_shards> shards_;
+            std::atomic<std::uint32_t> count_;
+            interned_string_entry const* empty_;
+        };
+
+        symbol_table& get_symbol_table()
+        {
+            static symbol_table table;
+            return table;
+        }
+
+        interned_string_entry const* intern(std::string const& key)
+        {
+            return get_symbol_table().intern(key);
+        }
+
+        interned_string_entry const* empty_interned_string()
+        {
+            static interned_string_entry const* empty =
+                get_symbol_table().empty_;
+            return empty;
+        }
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    std::size_t interned_string_count()
+    {
+        return detail::get_symbol_table().size();
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    // ids are valid on the locality that created them only, send the
+    // characters and intern them again on the receiving end
+    void interned_string::serialize(
+        hpx::serialization::output_archive& ar, unsigned)
+    {
+        ar & *entry_->key;
+    }
+
+    void interned_string::serialize(
+        hpx::serialization::input_archive& ar, unsigned)
+    {
+        std::string key;
+        ar & key;
+        entry_ = detail::intern(key);
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    std::ostream& operator<<(std::ostream& os, interned_string const& s)
+    {
+        os << s.str();
+        return os;
+    }
+}}
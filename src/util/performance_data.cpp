@@ -5,8 +5,11 @@
 //  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
 
 #include <phylanx/config.hpp>
+#include <phylanx/execution_tree/compile.hpp>
 #include <phylanx/execution_tree/compiler/primitive_name.hpp>
 #include <phylanx/execution_tree/primitives/primitive_component.hpp>
+#include <phylanx/execution_tree/primitives/primitive_registry.hpp>
+#include <phylanx/ir/node_data.hpp>
 #include <phylanx/util/performance_data.hpp>
 
 #include <hpx/include/agas.hpp>
@@ -55,8 +58,7 @@ namespace phylanx { namespace util
     {
         if (primitive_instances.empty())
         {
-            return enable_measurements(
-                hpx::agas::find_symbols(hpx::launch::sync, "/phylanx/*$*"));
+            return enable_measurements();
         }
 
         using phylanx::execution_tree::primitives::primitive_component;
@@ -115,11 +117,90 @@ namespace phylanx { namespace util
 
     std::vector<std::string> enable_measurements()
     {
-        return enable_measurements(
-            hpx::agas::find_symbols(hpx::launch::sync, "/phylanx/*$*"));
+        using phylanx::execution_tree::primitives::all_primitive_type_data;
+
+        // enabling the measurements for all primitive types covers all
+        // existing (and future) instances
+        std::vector<std::string> result;
+        for (auto* data : all_primitive_type_data())
+        {
+            data->enable_measurements();
+
+            for (auto& entry : data->instances({}, false))
+            {
+                result.push_back(std::move(entry.first));
+            }
+        }
+        return result;
     }
 
     ///////////////////////////////////////////////////////////////////////////
+    namespace detail
+    {
+        using phylanx::execution_tree::primitives::primitive_type_data;
+
+        bool get_instance_counter(std::string const& counter_name_last_part,
+            primitive_type_data::instance_counter& counter)
+        {
+            if (counter_name_last_part == "count/eval")
+            {
+                counter = primitive_type_data::eval_count;
+                return true;
+            }
+            if (counter_name_last_part == "time/eval")
+            {
+                counter = primitive_type_data::eval_duration;
+                return true;
+            }
+            if (counter_name_last_part == "eval_direct")
+            {
+                counter = primitive_type_data::direct_execution;
+                return true;
+            }
+            return false;
+        }
+
+        // Retrieve the counter data of the given primitive instances living
+        // on this locality, return false if any of the counters is not
+        // supported by the primitive registry
+        bool retrieve_local_counter_data(
+            std::vector<std::string> const& primitive_instances,
+            std::vector<std::string> const& counter_name_last_parts,
+            std::map<std::string, std::vector<std::int64_t>>& result)
+        {
+            std::vector<primitive_type_data::instance_counter> counters;
+            counters.reserve(counter_name_last_parts.size());
+
+            for (auto const& counter_name_last_part : counter_name_last_parts)
+            {
+                primitive_type_data::instance_counter counter;
+                if (!get_instance_counter(counter_name_last_part, counter))
+                {
+                    return false;
+                }
+                counters.push_back(counter);
+            }
+
+            for (auto const& name : primitive_instances)
+            {
+                std::vector<std::int64_t> data(counters.size(), 0);
+
+                primitive_type_data* type_data =
+                    phylanx::execution_tree::primitives::
+                        find_primitive_type_data(
+                            phylanx::execution_tree::compiler::
+                                extract_primitive_name(name));
+                if (type_data != nullptr)
+                {
+                    type_data->instance_values(name, counters, data);
+                }
+
+                result.emplace(name, std::move(data));
+            }
+            return true;
+        }
+    }
+
     std::map<std::string, std::vector<std::int64_t>> retrieve_counter_data(
         std::vector<std::string> const& primitive_instances,
         std::vector<std::string> const& counter_name_last_parts,
@@ -134,6 +215,18 @@ namespace phylanx { namespace util
 
         // NOTE: primitive_instances are not verified
 
+        // The data of primitives living on this locality is directly
+        // available from the primitive registry
+        if (locality_id == hpx::find_here())
+        {
+            std::map<std::string, std::vector<std::int64_t>> result;
+            if (detail::retrieve_local_counter_data(
+                    primitive_instances, counter_name_last_parts, result))
+            {
+                return result;
+            }
+        }
+
         // Querying for performance counters is relatively expensive and there
         // is overlap, thus we can use futures
         //   key: primitive type
@@ -279,6 +372,30 @@ namespace phylanx { namespace util
     std::map<std::string, std::vector<std::int64_t>> retrieve_counter_data(
         hpx::naming::id_type const& locality_id)
     {
+        if (locality_id == hpx::find_here())
+        {
+            using phylanx::execution_tree::primitives::all_primitive_type_data;
+            using phylanx::execution_tree::primitives::primitive_type_data;
+
+            // the counters of all instances of a type are collected in one
+            // pass, in the order used by the overload above
+            std::vector<primitive_type_data::instance_counter> const counters{
+                primitive_type_data::eval_count,
+                primitive_type_data::eval_duration,
+                primitive_type_data::direct_execution};
+
+            std::map<std::string, std::vector<std::int64_t>> result;
+            for (auto* data : all_primitive_type_data())
+            {
+                for (auto& entry : data->instances(counters, false))
+                {
+                    result.emplace(
+                        std::move(entry.first), std::move(entry.second));
+                }
+            }
+            return result;
+        }
+
         auto entries =
             hpx::agas::find_symbols(hpx::launch::sync, "/phylanx/*$*");
 
@@ -292,4 +409,88 @@ namespace phylanx { namespace util
 
         return retrieve_counter_data(primitive_instances, locality_id);
     }
+
+    ///////////////////////////////////////////////////////////////////////////
+    std::map<std::string, std::vector<std::int64_t>>
+    retrieve_primitive_statistics(bool reset,
+        hpx::naming::id_type const& locality_id)
+    {
+        std::map<std::string, std::vector<std::int64_t>> result;
+
+        if (locality_id == hpx::find_here())
+        {
+            using phylanx::execution_tree::primitives::all_primitive_type_data;
+
+            for (auto* data : all_primitive_type_data())
+            {
+                result.emplace(data->type(), data->statistics(reset).values());
+            }
+            return result;
+        }
+
+        // query the statistics counters of all known primitive types
+        std::map<std::string,
+            hpx::future<hpx::performance_counters::counter_values_array>>
+            values;
+
+        for (auto const& pattern :
+            phylanx::execution_tree::get_all_known_patterns())
+        {
+            std::string const& type = pattern.data_.primitive_type_;
+            hpx::performance_counters::performance_counter counter(
+                "/phylanx/primitives/" + type + "/statistics", locality_id);
+            values.emplace(type, counter.get_counter_values_array(reset));
+        }
+
+        for (auto& entry : values)
+        {
+            std::vector<std::int64_t> data = entry.second.get().values_;
+            if (!data.empty() && data[0] != 0)
+            {
+                result.emplace(entry.first, std::move(data));
+            }
+        }
+        return result;
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    std::map<std::string, std::int64_t> retrieve_memory_usage()
+    {
+        using phylanx::execution_tree::primitives::all_primitive_type_data;
+        using phylanx::execution_tree::primitives::primitive_type_data;
+
+        std::map<std::string, std::int64_t> result;
+        for (auto* data : all_primitive_type_data())
+        {
+            for (auto& entry : data->instances(
+                     {primitive_type_data::memory_usage}, false))
+            {
+                result.emplace(std::move(entry.first), entry.second[0]);
+            }
+        }
+        return result;
+    }
+
+    namespace detail
+    {
+        template <typename T>
+        std::vector<std::int64_t> node_data_memory(bool reset)
+        {
+            return std::vector<std::int64_t>{
+                ir::node_data<T>::allocated_bytes(reset),
+                ir::node_data<T>::allocated_bytes_high_water(reset),
+                ir::node_data<T>::deep_copy_count(reset),
+                ir::node_data<T>::deep_copy_bytes(reset)};
+        }
+    }
+
+    std::map<std::string, std::vector<std::int64_t>>
+    retrieve_node_data_memory(bool reset)
+    {
+        std::map<std::string, std::vector<std::int64_t>> result;
+        result.emplace("double", detail::node_data_memory<double>(reset));
+        result.emplace("int64", detail::node_data_memory<std::int64_t>(reset));
+        result.emplace("uint8", detail::node_data_memory<std::uint8_t>(reset));
+        return result;
+    }
 }}
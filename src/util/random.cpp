@@ -6,6 +6,7 @@
 
 #include <phylanx/util/random.hpp>
 
+#include <atomic>
 #include <cstdint>
 #include <random>
 
@@ -22,10 +23,23 @@ namespace phylanx { namespace util
 
     std::mt19937 rng_{default_seed()};    // The Mersenne twister generator.
 
+    // The keys handed out for the counter based generator are derived from
+    // the seed and the number of keys generated since the seed was set.
+    std::atomic<std::uint64_t> key_seed_{default_seed()};
+    std::atomic<std::uint64_t> key_count_{0};
+
+    std::uint64_t next_random_key()
+    {
+        return (key_seed_.load() << 32) + key_count_++;
+    }
+
     void set_seed(std::uint32_t seed)
     {
         seed_ = seed;
         rng_.seed(seed_);
+
+        key_seed_ = seed;
+        key_count_ = 0;
     }
 
     std::uint32_t get_seed()
@@ -4,12 +4,19 @@
 //  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
 
 #include <phylanx/config.hpp>
+#include <phylanx/ir/node_data.hpp>
 #include <phylanx/plugins/plugin_factory.hpp>
+#include <phylanx/util/tracer.hpp>
 
 #include <hpx/include/components.hpp>
+#include <hpx/include/runtime.hpp>
+#include <hpx/runtime/config_entry.hpp>
 #include <hpx/runtime/startup_function.hpp>
 #include <hpx/runtime/shutdown_function.hpp>
 
+#include <cstdint>
+#include <string>
+
 namespace phylanx
 {
     namespace performance_counters
@@ -22,6 +29,20 @@ namespace phylanx { namespace util
 {
     phylanx::plugin::plugin_map_type plugin_map;
 
+    // Tracing of all evaluations is enabled for the whole run if
+    // phylanx.trace.file is given, the events are written to that file
+    // (suffixed by the locality id on all but the first locality).
+    std::string trace_file()
+    {
+        std::string filename = hpx::get_config_entry("phylanx.trace.file", "");
+        std::uint32_t const locality = hpx::get_locality_id();
+        if (!filename.empty() && locality != 0)
+        {
+            filename += "." + std::to_string(locality);
+        }
+        return filename;
+    }
+
     ///////////////////////////////////////////////////////////////////////////
     void startup()
     {
@@ -30,10 +51,29 @@ namespace phylanx { namespace util
 
         // register performance counters for all discovered primitives
         performance_counters::startup_counters();
+
+        // the memory accounting of the array data is enabled for the whole
+        // run if phylanx.memory_accounting=1
+        if (hpx::get_config_entry("phylanx.memory_accounting", "0") == "1")
+        {
+            ir::node_data<double>::enable_memory_accounting(true);
+        }
+
+        if (!trace_file().empty())
+        {
+            start_trace();
+        }
     }
 
     void shutdown()
     {
+        std::string const filename = trace_file();
+        if (!filename.empty())
+        {
+            stop_trace();
+            dump_trace(filename);
+        }
+
         // unload all plugin modules
         plugin_map.clear();
     }
@@ -0,0 +1,351 @@
+//  Copyright (c) 2019 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <phylanx/config.hpp>
+#include <phylanx/util/tracer.hpp>
+
+#include <hpx/include/runtime.hpp>
+#include <hpx/lcos/local/spinlock.hpp>
+#include <hpx/throw_exception.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace phylanx { namespace util
+{
+    namespace detail
+    {
+        std::atomic<bool> trace_enabled(false);
+
+        ///////////////////////////////////////////////////////////////////////
+        // A ring buffer of events written by a single thread only
+        struct trace_buffer
+        {
+            explicit trace_buffer(std::size_t size)
+              : events_(size)
+              , count_(0)
+              , start_(0)
+            {}
+
+            void push(trace_event const& event)
+            {
+                std::uint64_t const count =
+                    count_.load(std::memory_order_relaxed);
+                events_[count % events_.size()] = event;
+                count_.store(count + 1, std::memory_order_release);
+            }
+
+            // the first event still to be written, the events pushed before
+            // (re-)starting the trace are skipped
+            std::uint64_t first_event() const
+            {
+                std::uint64_t const count =
+                    count_.load(std::memory_order_acquire);
+                std::uint64_t const size = events_.size();
+                return (std::max)(start_, count > size ? count - size : 0);
+            }
+
+            std::vector<trace_event> events_;
+            std::atomic<std::uint64_t> count_;     // number of events pushed
+
+            // The value of count_ when the trace was last started. count_
+            // itself is modified by the writing thread only, resetting it
+            // would race with events being pushed concurrently. This is
+            // protected by trace_data::mtx_.
+            std::uint64_t start_;
+        };
+
+        struct trace_data
+        {
+            using mutex_type = hpx::lcos::local::spinlock;
+
+            // One buffer per worker thread, the last buffer is shared by all
+            // other threads. The buffers are allocated when the tracing is
+            // enabled for the first time and are never released.
+            std::vector<std::unique_ptr<trace_buffer>> buffers_;
+            mutex_type shared_buffer_mtx_;
+
+            // display names and instance names of the traced primitives
+            std::vector<std::pair<std::string, std::string>> names_;
+            mutex_type mtx_;
+        };
+
+        trace_data& get_trace_data()
+        {
+            static trace_data data;
+            return data;
+        }
+
+        ///////////////////////////////////////////////////////////////////////
+        void write_escaped(std::ostream& os, std::string const& s)
+        {
+            os << '"';
+            for (char c : s)
+            {
+                if (c == '"' || c == '\\')
+                {
+                    os << '\\' << c;
+                }
+                else if (static_cast<unsigned char>(c) < 0x20)
+                {
+                    os << ' ';
+                }
+                else
+                {
+                    os << c;
+                }
+            }
+            os << '"';
+        }
+
+        // the trace event format expects microseconds
+        void write_microseconds(std::ostream& os, std::uint64_t ns)
+        {
+            std::string fraction = std::to_string(ns % 1000);
+            os << ns / 1000 << '.' << std::string(3 - fraction.size(), '0')
+               << fraction;
+        }
+
+        void write_shape(std::ostream& os, trace_shape const& shape)
+        {
+            if (shape.num_dimensions < 0)
+            {
+                os << "\"-\"";
+                return;
+            }
+
+            os << "\"[";
+            for (std::int32_t i = 0; i != shape.num_dimensions; ++i)
+            {
+                if (i != 0)
+                {
+                    os << ", ";
+                }
+                os << shape.dimensions[i];
+            }
+            os << "]\"";
+        }
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    void start_trace()
+    {
+        auto& data = detail::get_trace_data();
+
+        std::lock_guard<detail::trace_data::mutex_type> l(data.mtx_);
+        if (data.buffers_.empty())
+        {
+            std::size_t const size = (std::max)(std::size_t(1),
+                std::size_t(std::stoul(hpx::get_config_entry(
+                    "phylanx.trace.buffer_size", "65536"))));
+
+            std::size_t const num_buffers = hpx::get_os_thread_count() + 1;
+            data.buffers_.reserve(num_buffers);
+            for (std::size_t i = 0; i != num_buffers; ++i)
+            {
+                data.buffers_.emplace_back(new detail::trace_buffer(size));
+            }
+        }
+        else
+        {
+            // discard the events recorded so far
+            for (auto& buffer : data.buffers_)
+            {
+                buffer->start_ =
+                    buffer->count_.load(std::memory_order_acquire);
+            }
+        }
+
+        detail::trace_enabled.store(true, std::memory_order_release);
+    }
+
+    void stop_trace()
+    {
+        detail::trace_enabled.store(false, std::memory_order_release);
+    }
+
+    std::uint32_t register_trace_name(std::atomic<std::int64_t>& id,
+        std::string const& display_name, std::string const& instance_name)
+    {
+        std::int64_t name = id.load(std::memory_order_acquire);
+        if (name != -1)
+        {
+            return std::uint32_t(name);
+        }
+
+        auto& data = detail::get_trace_data();
+
+        std::lock_guard<detail::trace_data::mutex_type> l(data.mtx_);
+
+        // another thread may have registered the name in the meantime
+        name = id.load(std::memory_order_relaxed);
+        if (name == -1)
+        {
+            data.names_.emplace_back(display_name, instance_name);
+            name = std::int64_t(data.names_.size() - 1);
+            id.store(name, std::memory_order_release);
+        }
+        return std::uint32_t(name);
+    }
+
+    void record_trace_event(trace_event const& event)
+    {
+        // the buffers are guaranteed to exist once tracing was enabled
+        if (!detail::trace_enabled.load(std::memory_order_acquire))
+        {
+            return;
+        }
+
+        auto& data = detail::get_trace_data();
+        std::size_t const shared_buffer = data.buffers_.size() - 1;
+
+        // HPX threads are not interrupted while pushing the event, which
+        // makes the buffer of a worker thread single-writer
+        std::size_t const thread = hpx::get_worker_thread_num();
+        if (thread < shared_buffer)
+        {
+            data.buffers_[thread]->push(event);
+            return;
+        }
+
+        std::lock_guard<detail::trace_data::mutex_type> l(
+            data.shared_buffer_mtx_);
+        data.buffers_[shared_buffer]->push(event);
+    }
+
+    std::uint64_t dropped_trace_events()
+    {
+        auto& data = detail::get_trace_data();
+
+        std::lock_guard<detail::trace_data::mutex_type> l(data.mtx_);
+
+        std::uint64_t dropped = 0;
+        for (auto const& buffer : data.buffers_)
+        {
+            dropped += buffer->first_event() - buffer->start_;
+        }
+        return dropped;
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    std::size_t write_trace(std::ostream& os)
+    {
+        auto& data = detail::get_trace_data();
+
+        std::vector<trace_event> events;
+        std::vector<std::pair<std::string, std::string>> names;
+        std::size_t num_buffers = 0;
+
+        {
+            std::lock_guard<detail::trace_data::mutex_type> l(data.mtx_);
+
+            names = data.names_;
+            num_buffers = data.buffers_.size();
+
+            for (auto const& buffer : data.buffers_)
+            {
+                std::uint64_t const first = buffer->first_event();
+                std::uint64_t const count =
+                    buffer->count_.load(std::memory_order_acquire);
+                std::uint64_t const size = buffer->events_.size();
+                for (std::uint64_t i = first; i < count; ++i)
+                {
+                    events.push_back(buffer->events_[i % size]);
+                }
+            }
+        }
+
+        std::uint64_t start = 0;
+        if (!events.empty())
+        {
+            start = std::min_element(events.begin(), events.end(),
+                [](trace_event const& lhs, trace_event const& rhs)
+                {
+                    return lhs.begin < rhs.begin;
+                })->begin;
+        }
+
+        std::uint32_t const pid = hpx::get_locality_id();
+
+        os << "{\"traceEvents\":[\n";
+
+        // name the process and the threads
+        os << "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":" << pid
+           << ",\"args\":{\"name\":\"locality#" << pid << "\"}}";
+        for (std::size_t i = 0; i != num_buffers; ++i)
+        {
+            os << ",\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":" << pid
+               << ",\"tid\":" << i << ",\"args\":{\"name\":\"";
+            if (i + 1 != num_buffers)
+            {
+                os << "worker-thread#" << i;
+            }
+            else
+            {
+                os << "other threads";
+            }
+            os << "\"}}";
+        }
+
+        for (auto const& event : events)
+        {
+            std::string const& display_name = event.name < names.size() ?
+                names[event.name].first : std::string("<unknown>");
+            std::string const& instance_name = event.name < names.size() ?
+                names[event.name].second : std::string("<unknown>");
+
+            os << ",\n{\"name\":";
+            detail::write_escaped(os, display_name);
+            os << ",\"cat\":\"primitive\",\"ph\":\"X\",\"pid\":" << pid
+               << ",\"tid\":"
+               << (std::min)(std::size_t(event.thread), num_buffers - 1)
+               << ",\"ts\":";
+            detail::write_microseconds(os, event.begin - start);
+            os << ",\"dur\":";
+            detail::write_microseconds(
+                os, event.end > event.begin ? event.end - event.begin : 0);
+
+            os << ",\"args\":{\"instance\":";
+            detail::write_escaped(os, instance_name);
+            os << ",\"num_inputs\":" << event.num_inputs;
+            for (std::uint32_t i = 0;
+                 i != (std::min)(event.num_inputs, std::uint32_t(2)); ++i)
+            {
+                os << ",\"input" << i << "\":";
+                detail::write_shape(os, event.inputs[i]);
+            }
+            os << ",\"input_bytes\":" << event.input_bytes
+               << ",\"result\":";
+            detail::write_shape(os, event.result);
+            os << ",\"result_bytes\":" << event.result.bytes << "}}";
+        }
+
+        os << "\n],\n\"displayTimeUnit\":\"ms\",\n\"otherData\":{"
+           << "\"dropped_events\":" << dropped_trace_events() << "}}\n";
+
+        return events.size();
+    }
+
+    std::size_t dump_trace(std::string const& filename)
+    {
+        std::ofstream os(filename.c_str(), std::ios::out | std::ios::trunc);
+        if (!os.is_open())
+        {
+            HPX_THROW_EXCEPTION(hpx::filesystem_error,
+                "phylanx::util::dump_trace",
+                "couldn't open file: " + filename);
+        }
+        return write_trace(os);
+    }
+}}
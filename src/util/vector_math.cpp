@@ -0,0 +1,551 @@
+//  Copyright (c) 2019 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <phylanx/config.hpp>
+#include <phylanx/util/vector_math.hpp>
+
+#include <hpx/include/parallel_for_loop.hpp>
+#include <hpx/include/runtime.hpp>
+#include <hpx/throw_exception.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <string>
+
+///////////////////////////////////////////////////////////////////////////////
+// The fast kernels are written as branch free loops over contiguous memory,
+// which allows the compiler to vectorize them. Where supported, every loop
+// is compiled for several instruction sets, the loader selects the best
+// version for the CPU the code is running on.
+#if defined(__x86_64__) && defined(__linux__) &&                               \
+    ((defined(__GNUC__) && !defined(__clang__) && __GNUC__ >= 6) ||            \
+        (defined(__clang__) && __clang_major__ >= 14))
+#define PHYLANX_MATH_TARGET_CLONES                                             \
+    __attribute__((target_clones("avx512f", "avx2", "default")))
+#else
+#define PHYLANX_MATH_TARGET_CLONES
+#endif
+
+namespace phylanx { namespace util
+{
+    ///////////////////////////////////////////////////////////////////////////
+    bool parse_math_function(std::string const& name, math_function& f)
+    {
+        if (name == "exp")
+        {
+            f = math_function::exp;
+        }
+        else if (name == "log")
+        {
+            f = math_function::log;
+        }
+        else if (name == "tanh")
+        {
+            f = math_function::tanh;
+        }
+        else if (name == "erf")
+        {
+            f = math_function::erf;
+        }
+        else if (name == "erfc")
+        {
+            f = math_function::erfc;
+        }
+        else if (name == "cbrt")
+        {
+            f = math_function::cbrt;
+        }
+        else if (name == "arcsinh")
+        {
+            f = math_function::asinh;
+        }
+        else
+        {
+            return false;
+        }
+        return true;
+    }
+
+    bool parse_math_accuracy(std::string const& name, math_accuracy& accuracy)
+    {
+        if (name == "accurate")
+        {
+            accuracy = math_accuracy::accurate;
+        }
+        else if (name == "fast")
+        {
+            accuracy = math_accuracy::fast;
+        }
+        else
+        {
+            return false;
+        }
+        return true;
+    }
+
+    math_accuracy default_math_accuracy()
+    {
+        static math_accuracy const accuracy = []()
+        {
+            std::string const name =
+                hpx::get_config_entry("phylanx.math.accuracy", "accurate");
+
+            math_accuracy result = math_accuracy::accurate;
+            if (!parse_math_accuracy(name, result))
+            {
+                HPX_THROW_EXCEPTION(hpx::bad_parameter,
+                    "phylanx::util::default_math_accuracy",
+                    "unknown accuracy specified by phylanx.math.accuracy: '" +
+                        name + "', expected 'accurate' or 'fast'");
+            }
+            return result;
+        }();
+        return accuracy;
+    }
+
+    std::size_t math_min_parallel_size()
+    {
+        static std::size_t const min_size = std::stoul(
+            hpx::get_config_entry("phylanx.math.min_parallel_size", "65536"));
+        return min_size;
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    namespace detail
+    {
+        ///////////////////////////////////////////////////////////////////////
+        // Bit manipulation helpers, these compile to plain vector instructions
+        // once the surrounding loop is vectorized.
+        inline std::uint64_t as_bits(double x)
+        {
+            std::uint64_t result;
+            std::memcpy(&result, &x, sizeof(double));
+            return result;
+        }
+
+        inline double as_double(std::uint64_t bits)
+        {
+            double result;
+            std::memcpy(&result, &bits, sizeof(double));
+            return result;
+        }
+
+        // Adding and subtracting 1.5 * 2^52 rounds to the nearest integer for
+        // all |x| < 2^51, the integer ends up in the low bits of the sum.
+        constexpr double round_shifter = 6755399441055744.0;
+
+        inline double round_to_int(double x)
+        {
+            return (x + round_shifter) - round_shifter;
+        }
+
+        // 2^n for integral n in [-1022, 1023]
+        inline double exp2_int(double n)
+        {
+            return as_double(
+                (as_bits(n + round_shifter) - as_bits(round_shifter) + 1023)
+                << 52);
+        }
+
+        // the (unbiased) exponent of a positive normal x, as a double
+        inline double exponent_of(double x)
+        {
+            constexpr double two52 = 4503599627370496.0;
+            return as_double((as_bits(x) >> 52) | as_bits(two52)) - two52 -
+                1023;
+        }
+
+        // x with its exponent replaced by 0, i.e. in [1, 2) for normal x
+        inline double mantissa_of(double x)
+        {
+            return as_double((as_bits(x) & 0x000fffffffffffffull) |
+                0x3ff0000000000000ull);
+        }
+
+        inline double abs_of(double x)
+        {
+            return as_double(as_bits(x) & 0x7fffffffffffffffull);
+        }
+
+        // |x| with the sign of s
+        inline double with_sign_of(double x, double s)
+        {
+            return as_double(as_bits(x) | (as_bits(s) & 0x8000000000000000ull));
+        }
+
+        ///////////////////////////////////////////////////////////////////////
+        // exp(x): x = n * ln(2) + r with |r| <= ln(2) / 2, exp(r) is evaluated
+        // by its Taylor polynomial, 2^n is applied in two steps which keeps the
+        // exponents in range for (gradual) underflow and for n = 1024.
+        inline double exp_kernel(double x)
+        {
+            constexpr double log2e = 1.4426950408889634074;
+            constexpr double ln2_hi = 6.93147180369123816490e-01;
+            constexpr double ln2_lo = 1.90821492927058770002e-10;
+
+            double const xc = x > 709.79 ? 709.79 : (x < -745.2 ? -745.2 : x);
+
+            double const n = round_to_int(xc * log2e);
+            double const r = (xc - n * ln2_hi) - n * ln2_lo;
+
+            double p = 1.0 / 6227020800.0;
+            p = p * r + 1.0 / 479001600.0;
+            p = p * r + 1.0 / 39916800.0;
+            p = p * r + 1.0 / 3628800.0;
+            p = p * r + 1.0 / 362880.0;
+            p = p * r + 1.0 / 40320.0;
+            p = p * r + 1.0 / 5040.0;
+            p = p * r + 1.0 / 720.0;
+            p = p * r + 1.0 / 120.0;
+            p = p * r + 1.0 / 24.0;
+            p = p * r + 1.0 / 6.0;
+            p = p * r + 0.5;
+            p = p * r * r + r + 1.0;
+
+            double const n1 = round_to_int(n * 0.5);
+            double const result = p * exp2_int(n1) * exp2_int(n - n1);
+
+            return x > 709.782712893384 ? HUGE_VAL :
+                (x < -745.1332191019412 ? 0.0 : (x != x ? x : result));
+        }
+
+        ///////////////////////////////////////////////////////////////////////
+        // log(x): x = 2^k * (1 + f) with sqrt(2) / 2 <= 1 + f < sqrt(2),
+        // log(1 + f) = 2s + s * R(s^2) with s = f / (2 + f) (see fdlibm)
+        inline double log_kernel(double x)
+        {
+            constexpr double ln2_hi = 6.93147180369123816490e-01;
+            constexpr double ln2_lo = 1.90821492927058770002e-10;
+            constexpr double two54 = 18014398509481984.0;
+
+            // scale subnormal inputs into the normal range
+            bool const subnormal = x < 2.2250738585072014e-308;
+            double const xs = subnormal ? x * two54 : x;
+
+            double m = mantissa_of(xs);
+            double k = exponent_of(xs) - (subnormal ? 54.0 : 0.0);
+
+            bool const large = m > 1.4142135623730950488;
+            m = large ? m * 0.5 : m;
+            k = large ? k + 1.0 : k;
+
+            double const f = m - 1.0;
+            double const s = f / (2.0 + f);
+            double const z = s * s;
+            double const w = z * z;
+
+            double const t1 = w * (3.999999999940941908e-01 +
+                w * (2.222219843214978396e-01 + w * 1.531383769920937332e-01));
+            double const t2 = z * (6.666666666666735130e-01 +
+                w * (2.857142874366239149e-01 + w * (1.818357216161805012e-01 +
+                w * 1.479819860511658591e-01)));
+            double const r = t1 + t2;
+            double const hfsq = 0.5 * f * f;
+
+            double const result =
+                k * ln2_hi - ((hfsq - (s * (hfsq + r) + k * ln2_lo)) - f);
+
+            return x > 0.0 ? (x == HUGE_VAL ? x : result) :
+                (x == 0.0 ? -HUGE_VAL : (x != x ? x : std::numeric_limits<
+                    double>::quiet_NaN()));
+        }
+
+        ///////////////////////////////////////////////////////////////////////
+        // tanh(x): a rational approximation for small |x| (see Cephes),
+        // 1 - 2 / (exp(2|x|) + 1) otherwise
+        inline double tanh_kernel(double x)
+        {
+            double const z = abs_of(x);
+
+            double const s = x * x;
+            double const p = ((-9.64399179425052238628e-1 * s -
+                9.92877231001918586564e1) * s - 1.61468768441708447952e3);
+            double const q = (((s + 1.12811678491632931402e2) * s +
+                2.23548839060100448583e3) * s + 4.84406305325125486048e3);
+            double const small = z + z * s * p / q;
+
+            double const large = 1.0 - 2.0 / (exp_kernel(2.0 * z) + 1.0);
+
+            return with_sign_of(z < 0.625 ? small : large, x);
+        }
+
+        ///////////////////////////////////////////////////////////////////////
+        // erf(x) and erfc(x): the rational approximations for double precision
+        // used by Boost.Math. The coefficients of the intervals of erfc are
+        // selected per element, which allows to evaluate a single rational
+        // function for all of them.
+        inline double erf_small(double z)
+        {
+            // erf(z) for |z| < 0.5
+            double const zz = z * z;
+            double const p = (((-0.000322780120964605683831 * zz -
+                0.00772758345802133288487) * zz - 0.0509990735146777432841) *
+                zz - 0.338165134459360935041) * zz + 0.0834305892146531832907;
+            double const q = (((0.000370900071787748000569 * zz +
+                0.00858571925074406212772) * zz + 0.0875222600142252549554) *
+                zz + 0.455004033050794024546) * zz + 1.0;
+            return z * (1.044948577880859375 + p / q);
+        }
+
+        inline double erfc_large(double z)
+        {
+            // erfc(z) for z >= 0.5
+            bool const i1 = z < 1.5;
+            bool const i2 = z < 2.5;
+            bool const i3 = z < 4.5;
+
+#define PHYLANX_ERFC_COEFF(c1, c2, c3, c4)                                     \
+    (i1 ? (c1) : (i2 ? (c2) : (i3 ? (c3) : (c4))))
+
+            double const t = i1 ? z - 0.5 :
+                (i2 ? z - 1.5 : (i3 ? z - 3.5 : 1.0 / z));
+
+            double const y = PHYLANX_ERFC_COEFF(0.405935764312744140625,
+                0.50672817230224609375, 0.5405750274658203125,
+                0.5579090118408203125);
+
+            double p =
+                PHYLANX_ERFC_COEFF(0.0, 0.0, 0.0, -2.8175401114513378771);
+            p = p * t + PHYLANX_ERFC_COEFF(0.00180424538297014223957,
+                0.000235839115596880717416, 0.113212406648847561139e-4,
+                -3.22729451764143718517);
+            p = p * t + PHYLANX_ERFC_COEFF(0.0195049001251218801359,
+                0.00323962406290842133584, 0.000250269961544794627958,
+                -2.5518551727311523996);
+            p = p * t + PHYLANX_ERFC_COEFF(0.0888900368967884466578,
+                0.0175679436311802092299, 0.00212825620914618649141,
+                -0.687717681153649930619);
+            p = p * t + PHYLANX_ERFC_COEFF(0.191003695796775433986,
+                0.04394818964209516296, 0.00840807615555585383007,
+                -0.212652252872804219852);
+            p = p * t + PHYLANX_ERFC_COEFF(0.178114665841120341155,
+                0.0386540375035707201728, 0.0137384425896355332126,
+                0.0175389834052493308818);
+            p = p * t + PHYLANX_ERFC_COEFF(-0.098090592216281240205,
+                -0.0243500476207698441272, 0.00295276716530971662634,
+                0.00628057170626964891937);
+
+            double q = PHYLANX_ERFC_COEFF(0.337511472483094676155e-5, 0.0, 0.0,
+                5.48409182238641741584);
+            q = q * t + PHYLANX_ERFC_COEFF(0.0113385233577001411017,
+                0.00410369723978904575884, 0.000479411269521714493907,
+                13.5064170191802889145);
+            q = q * t + PHYLANX_ERFC_COEFF(0.12385097467900864233,
+                0.0563921837420478160373, 0.0105982906484876531489,
+                22.9367376522880577224);
+            q = q * t + PHYLANX_ERFC_COEFF(0.578052804889902404909,
+                0.325732924782444448493, 0.0958492726301061423444,
+                15.930646027911794143);
+            q = q * t + PHYLANX_ERFC_COEFF(1.42628004845511324508,
+                0.982403709157920235114, 0.442597659481563127003,
+                11.0567237927800161565);
+            q = q * t + PHYLANX_ERFC_COEFF(1.84759070983002217845,
+                1.53991494948552447182, 1.04217814166938418171,
+                2.79257750980575282228);
+            q = q * t + 1.0;
+
+#undef PHYLANX_ERFC_COEFF
+
+            // exp(-z^2) is evaluated as exp(-hi^2) * exp(-(z - hi) * (z + hi)),
+            // hi has 26 significant bits only, which makes hi^2 exact
+            double const hi = as_double(as_bits(z) & 0xfffffffff8000000ull);
+            double const e = exp_kernel(-hi * hi) *
+                exp_kernel(-(z - hi) * (z + hi));
+
+            return z == HUGE_VAL ? 0.0 : (y + p / q) * e / z;
+        }
+
+        inline double erf_kernel(double x)
+        {
+            double const z = abs_of(x);
+            double const result = z < 0.5 ? erf_small(z) : 1.0 - erfc_large(z);
+            return x != x ? x : with_sign_of(result, x);
+        }
+
+        inline double erfc_kernel(double x)
+        {
+            double const z = abs_of(x);
+            double const c = z < 0.5 ? 1.0 - erf_small(z) : erfc_large(z);
+            double const result = x < 0.0 ? 2.0 - c : c;
+            return x != x ? x : (z < 0.5 ? 1.0 - erf_small(x) : result);
+        }
+
+        ///////////////////////////////////////////////////////////////////////
+        // cbrt(x): |x| = 2^(3q + r) * m with m in [1, 2), the cube root of
+        // y = 2^r * m is refined from a polynomial estimate by two Halley steps
+        inline double cbrt_kernel(double x)
+        {
+            constexpr double two54 = 18014398509481984.0;
+
+            double const z = abs_of(x);
+            bool const subnormal = z < 2.2250738585072014e-308;
+            double const zs = subnormal ? z * two54 : z;
+
+            double const e = exponent_of(zs) - (subnormal ? 54.0 : 0.0);
+            double qn = round_to_int(e * (1.0 / 3.0));
+            qn = qn * 3.0 > e ? qn - 1.0 : qn;
+            double const rn = e - 3.0 * qn;
+
+            double const m = mantissa_of(zs);
+            double const y = m * (rn == 0.0 ? 1.0 : (rn == 1.0 ? 2.0 : 4.0));
+
+            // estimate of cbrt(m), relative error below 1e-3
+            double t =
+                ((0.0144182 * m - 0.13319) * m + 0.569262) * m + 0.549758;
+            t *= rn == 0.0 ? 1.0 :
+                (rn == 1.0 ? 1.2599210498948731648 : 1.5874010519681994748);
+
+            double t3 = t * t * t;
+            t = t * (t3 + 2.0 * y) / (2.0 * t3 + y);
+            t3 = t * t * t;
+            t -= t * (t3 - y) / (2.0 * t3 + y);
+
+            double const result = t * exp2_int(qn);
+
+            return (z == 0.0 || z == HUGE_VAL || x != x) ?
+                x : with_sign_of(result, x);
+        }
+
+        ///////////////////////////////////////////////////////////////////////
+        // asinh(x) = log1p(|x| + x^2 / (1 + sqrt(1 + x^2))), log1p(u) is
+        // evaluated as log(1 + u) * u / ((1 + u) - 1) which compensates for the
+        // rounding of 1 + u
+        inline double asinh_kernel(double x)
+        {
+            constexpr double ln2 = 6.93147180559945309417e-01;
+
+            double const z = abs_of(x);
+            double const zz = z * z;
+            double const u = z + zz / (1.0 + std::sqrt(1.0 + zz));
+            double const w = 1.0 + u;
+            double const small = w == 1.0 ? u : log_kernel(w) * u / (w - 1.0);
+
+            double const result = z > 268435456.0 ? log_kernel(z) + ln2 : small;
+            return x != x ? x : with_sign_of(result, x);
+        }
+
+        ///////////////////////////////////////////////////////////////////////
+        using loop_type = void(double const*, double*, std::size_t);
+
+#define PHYLANX_MATH_LOOPS(name, stdname)                                      \
+    PHYLANX_MATH_TARGET_CLONES void name##_fast(                               \
+        double const* in, double* out, std::size_t n)                          \
+    {                                                                          \
+        for (std::size_t i = 0; i != n; ++i)                                   \
+        {                                                                      \
+            out[i] = name##_kernel(in[i]);                                     \
+        }                                                                      \
+    }                                                                          \
+    void name##_accurate(double const* in, double* out, std::size_t n)         \
+    {                                                                          \
+        for (std::size_t i = 0; i != n; ++i)                                   \
+        {                                                                      \
+            out[i] = std::stdname(in[i]);                                      \
+        }                                                                      \
+    }                                                                          \
+    /**/
+
+        PHYLANX_MATH_LOOPS(exp, exp)
+        PHYLANX_MATH_LOOPS(log, log)
+        PHYLANX_MATH_LOOPS(tanh, tanh)
+        PHYLANX_MATH_LOOPS(erf, erf)
+        PHYLANX_MATH_LOOPS(erfc, erfc)
+        PHYLANX_MATH_LOOPS(cbrt, cbrt)
+        PHYLANX_MATH_LOOPS(asinh, asinh)
+
+#undef PHYLANX_MATH_LOOPS
+
+        loop_type* get_loop(math_function f, math_accuracy accuracy)
+        {
+            bool const fast = accuracy == math_accuracy::fast;
+            switch (f)
+            {
+            case math_function::exp:
+                return fast ? &exp_fast : &exp_accurate;
+
+            case math_function::log:
+                return fast ? &log_fast : &log_accurate;
+
+            case math_function::tanh:
+                return fast ? &tanh_fast : &tanh_accurate;
+
+            case math_function::erf:
+                return fast ? &erf_fast : &erf_accurate;
+
+            case math_function::erfc:
+                return fast ? &erfc_fast : &erfc_accurate;
+
+            case math_function::cbrt:
+                return fast ? &cbrt_fast : &cbrt_accurate;
+
+            case math_function::asinh:
+                return fast ? &asinh_fast : &asinh_accurate;
+
+            default:
+                break;
+            }
+
+            HPX_THROW_EXCEPTION(hpx::bad_parameter,
+                "phylanx::util::detail::get_loop",
+                "unknown elementwise function requested");
+        }
+
+        // The smallest number of elements handled by a separate HPX thread
+        constexpr std::size_t min_chunk_size = 4096;
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    void apply_math_function(math_function f, double const* in,
+        std::size_t in_spacing, double* out, std::size_t out_spacing,
+        std::size_t rows, std::size_t columns, math_accuracy accuracy)
+    {
+        detail::loop_type* loop = detail::get_loop(f, accuracy);
+
+        std::size_t const size = rows * columns;
+        if (size == 0)
+        {
+            return;
+        }
+
+        // apply the function to the elements [begin, end), counted row by
+        // row, a range may span several rows
+        auto apply_range = [&](std::size_t begin, std::size_t end)
+        {
+            while (begin != end)
+            {
+                std::size_t const row = begin / columns;
+                std::size_t const column = begin % columns;
+                std::size_t const n = (std::min)(columns - column, end - begin);
+
+                loop(in + row * in_spacing + column,
+                    out + row * out_spacing + column, n);
+
+                begin += n;
+            }
+        };
+
+        std::size_t const num_threads = hpx::get_num_worker_threads();
+        if (size < math_min_parallel_size() || num_threads < 2)
+        {
+            apply_range(0, size);
+            return;
+        }
+
+        std::size_t const chunks = (std::min)(4 * num_threads,
+            (size + detail::min_chunk_size - 1) / detail::min_chunk_size);
+
+        hpx::parallel::for_loop(hpx::parallel::execution::par,
+            std::size_t(0), chunks,
+            [&](std::size_t chunk)
+            {
+                apply_range(
+                    size * chunk / chunks, size * (chunk + 1) / chunks);
+            });
+    }
+}}
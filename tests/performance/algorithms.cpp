@@ -0,0 +1,399 @@
+//   Copyright (c) 2019 Hartmut Kaiser
+//
+//   Distributed under the Boost Software License, Version 1.0. (See accompanying
+//   file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// Measure the algorithms from examples/algorithms on generated data of a
+// configurable size. The problem size is the number of samples (users for
+// als). Every algorithm is run once to warm up and then measured for the
+// given number of repetitions. The results are written as JSON (see
+// tools/benchmarks/scaling.py, which runs this benchmark for a range of
+// thread counts and produces strong and weak scaling tables).
+
+#include <phylanx/phylanx.hpp>
+
+#include <hpx/hpx_init.hpp>
+#include <hpx/include/runtime.hpp>
+#include <hpx/include/util.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <limits>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <boost/program_options.hpp>
+
+#include <blaze/Math.h>
+
+#if !defined(_WIN32)
+#include <sys/resource.h>
+#endif
+
+namespace et = phylanx::execution_tree;
+
+///////////////////////////////////////////////////////////////////////////////
+// the PhySL implementations of the algorithms which are not available as
+// primitives (see examples/algorithms)
+char const* const lir_code = R"(block(
+    define(lir, x, y, alpha, iterations,
+        block(
+            define(weights, constant(0.0, shape(x, 1))),
+            define(transx, transpose(x)),
+            define(pred, constant(0.0, shape(x, 0))),
+            define(error, constant(0.0, shape(x, 0))),
+            define(gradient, constant(0.0, shape(x, 1))),
+            define(step, 0),
+            while(
+                step < iterations,
+                block(
+                    store(pred, dot(x, weights)),
+                    store(error, pred - y),
+                    store(gradient, dot(transx, error)),
+                    parallel_block(
+                        store(weights, weights - (alpha * gradient)),
+                        store(step, step + 1)
+                    )
+                )
+            ),
+            weights
+        )
+    ),
+    lir
+))";
+
+char const* const kmeans_code = R"(block(
+    define(closest_centroids, points, centroids, block(
+        define(points_x, add_dim(slice_column(points, 0))),
+        define(points_y, add_dim(slice_column(points, 1))),
+        define(centroids_x, slice_column(centroids, 0)),
+        define(centroids_y, slice_column(centroids, 1)),
+        argmin(sqrt(
+            power(points_x - centroids_x, 2) +
+            power(points_y - centroids_y, 2)
+        ), 0)
+    )),
+    define(move_centroids, points, closest, centroids, block(
+        fmap(lambda(k, block(
+                define(x, closest == k),
+                mean(points * add_dim(x), 1)
+            )),
+            range(shape(centroids, 0))
+        )
+    )),
+    define(kmeans, points, k, iterations, block(
+        define(centroids, slice(points, make_list(0, k))),
+        for(define(i, 0), i < iterations, store(i, i + 1), block(
+            store(centroids,
+                apply(vstack,
+                    move_centroids(points,
+                        closest_centroids(points, centroids), centroids)))
+        )),
+        centroids
+    )),
+    kmeans
+))";
+
+char const* const nn_code = R"(block(
+    define(nn, X, y, num_iter, lr,
+        block(
+            set_seed(0),
+            define(inputlayer_neurons, slice(shape(X), 1)),
+            define(hidden_layer_neurons, inputlayer_neurons / 2),
+            define(output_neurons, slice(shape(y), 0)),
+            define(wh, random(list(inputlayer_neurons, hidden_layer_neurons),
+                "uniform")),
+            define(bh, random(list(1, hidden_layer_neurons), "uniform")),
+            define(wout, random(list(hidden_layer_neurons, output_neurons),
+                "uniform")),
+            define(bout, random(list(1, output_neurons), "uniform")),
+            for_each(lambda(i, block(
+                define(hidden_layer_activations, __div(1, __add(1,
+                    exp(__minus(__add(dot(X, wh), bh)))))),
+                define(output, __div(1, __add(1, exp(__minus(__add(
+                    dot(hidden_layer_activations, wout), bout)))))),
+                define(Error, __sub(y, output)),
+                define(d_output, __mul(Error, __mul(output, __sub(1, output)))),
+                define(d_hidden_layer, __mul(dot(d_output, transpose(wout)),
+                    __mul(hidden_layer_activations,
+                        __sub(1, hidden_layer_activations)))),
+                store(wout, __add(wout, __mul(dot(
+                    transpose(hidden_layer_activations), d_output), lr))),
+                store(bout, __add(bout, __mul(sum(d_output, 0, true), lr))),
+                store(wh, __add(wh, __mul(dot(transpose(X), d_hidden_layer),
+                    lr))),
+                store(bh, __add(bh, __mul(sum(d_hidden_layer, 0, true), lr))))),
+                range(num_iter)
+            ),
+            wh
+        )
+    ),
+    nn
+))";
+
+// als and lra are available as primitives
+char const* const als_code = R"(
+    define(run_als, ratings, regularization, num_factors, iterations, alpha,
+        als(ratings, regularization, num_factors, iterations, alpha))
+    run_als
+)";
+
+char const* const lra_code = R"(
+    define(run_lra, x, y, alpha, iterations, lra(x, y, alpha, iterations))
+    run_lra
+)";
+
+///////////////////////////////////////////////////////////////////////////////
+// the generated data is the same for every run of the benchmark
+struct data_generator
+{
+    explicit data_generator(std::size_t size)
+      : size_(size)
+      , gen_(42)
+    {}
+
+    // the given fraction of the values is zero
+    blaze::DynamicMatrix<double> matrix(std::size_t rows,
+        std::size_t columns, double sparsity = 0.0, double scale = 1.0)
+    {
+        std::uniform_real_distribution<double> dist(0.0, 1.0);
+
+        blaze::DynamicMatrix<double> m(rows, columns);
+        for (std::size_t r = 0; r != rows; ++r)
+        {
+            for (std::size_t c = 0; c != columns; ++c)
+            {
+                double const value = dist(gen_);
+                m(r, c) = value < sparsity ? 0.0 : scale * value;
+            }
+        }
+        return m;
+    }
+
+    blaze::DynamicVector<double> labels(std::size_t size)
+    {
+        std::bernoulli_distribution dist(0.5);
+
+        blaze::DynamicVector<double> v(size);
+        for (auto& value : v)
+        {
+            value = dist(gen_) ? 1.0 : 0.0;
+        }
+        return v;
+    }
+
+    std::size_t size_;
+    std::mt19937 gen_;
+};
+
+struct algorithm
+{
+    char const* name;
+    char const* code;
+    std::int64_t default_iterations;
+
+    // generate the arguments for the given problem size
+    std::function<et::primitive_arguments_type(
+        data_generator&, std::int64_t)> arguments;
+};
+
+std::vector<algorithm> const algorithms =
+{
+    {"als", als_code, 3,
+        [](data_generator& gen, std::int64_t iterations)
+        {
+            // ratings of size users for size / 2 items, 80% unrated
+            std::size_t const items = (std::max)(gen.size_ / 2, std::size_t(2));
+            return et::primitive_arguments_type{
+                et::primitive_argument_type{phylanx::ir::node_data<double>{
+                    gen.matrix(gen.size_, items, 0.8, 5.0)}},
+                et::primitive_argument_type{0.1},
+                et::primitive_argument_type{std::int64_t(10)},
+                et::primitive_argument_type{iterations},
+                et::primitive_argument_type{40.0}};
+        }},
+    {"kmeans", kmeans_code, 10,
+        [](data_generator& gen, std::int64_t iterations)
+        {
+            return et::primitive_arguments_type{
+                et::primitive_argument_type{
+                    phylanx::ir::node_data<double>{gen.matrix(gen.size_, 2)}},
+                et::primitive_argument_type{std::int64_t(3)},
+                et::primitive_argument_type{iterations}};
+        }},
+    {"lir", lir_code, 100,
+        [](data_generator& gen, std::int64_t iterations)
+        {
+            return et::primitive_arguments_type{
+                et::primitive_argument_type{
+                    phylanx::ir::node_data<double>{gen.matrix(gen.size_, 2)}},
+                et::primitive_argument_type{
+                    phylanx::ir::node_data<double>{gen.labels(gen.size_)}},
+                et::primitive_argument_type{1e-4},
+                et::primitive_argument_type{iterations}};
+        }},
+    {"lra", lra_code, 100,
+        [](data_generator& gen, std::int64_t iterations)
+        {
+            return et::primitive_arguments_type{
+                et::primitive_argument_type{
+                    phylanx::ir::node_data<double>{gen.matrix(gen.size_, 2)}},
+                et::primitive_argument_type{
+                    phylanx::ir::node_data<double>{gen.labels(gen.size_)}},
+                et::primitive_argument_type{1e-5},
+                et::primitive_argument_type{iterations}};
+        }},
+    {"nn", nn_code, 10,
+        [](data_generator& gen, std::int64_t iterations)
+        {
+            return et::primitive_arguments_type{
+                et::primitive_argument_type{
+                    phylanx::ir::node_data<double>{gen.matrix(gen.size_, 30)}},
+                et::primitive_argument_type{
+                    phylanx::ir::node_data<double>{gen.labels(gen.size_)}},
+                et::primitive_argument_type{iterations},
+                et::primitive_argument_type{1e-5}};
+        }},
+};
+
+///////////////////////////////////////////////////////////////////////////////
+// the sum of the high water marks of the memory held by the arrays of all
+// element types (the peaks of the types may have occurred at different
+// times, so this is an upper bound of the combined peak)
+std::int64_t peak_array_bytes(bool reset)
+{
+    return phylanx::ir::node_data<double>::allocated_bytes_high_water(reset) +
+        phylanx::ir::node_data<std::int64_t>::allocated_bytes_high_water(
+            reset) +
+        phylanx::ir::node_data<std::uint8_t>::allocated_bytes_high_water(
+            reset);
+}
+
+// the maximal resident set size of this process
+std::int64_t peak_rss_bytes()
+{
+#if !defined(_WIN32)
+    rusage usage;
+    if (getrusage(RUSAGE_SELF, &usage) == 0)
+    {
+#if defined(__APPLE__)
+        return std::int64_t(usage.ru_maxrss);
+#else
+        return std::int64_t(usage.ru_maxrss) * 1024;
+#endif
+    }
+#endif
+    return 0;
+}
+
+int hpx_main(boost::program_options::variables_map& vm)
+{
+    std::string const selected = vm["algorithm"].as<std::string>();
+    std::int64_t const size = vm["size"].as<std::int64_t>();
+    std::int64_t const repetitions =
+        (std::max)(vm["repetitions"].as<std::int64_t>(), std::int64_t(1));
+
+    std::ofstream file;
+    std::string const output = vm["output"].as<std::string>();
+    if (output != "-")
+    {
+        file.open(output.c_str(), std::ios::out | std::ios::trunc);
+        if (!file.is_open())
+        {
+            std::cerr << "algorithms: couldn't open file: " << output << "\n";
+            return hpx::finalize();
+        }
+    }
+    std::ostream& os = file.is_open() ? file : std::cout;
+
+    std::size_t const threads = hpx::get_os_thread_count();
+
+    os << "{\"benchmark\":\"algorithms\",\"threads\":" << threads
+       << ",\n\"results\":[";
+
+    // the peak memory of the arrays is measured by the memory accounting of
+    // node_data, which is disabled by default
+    phylanx::ir::node_data<double>::enable_memory_accounting(true);
+
+    bool first = true;
+    et::compiler::function_list snippets;
+
+    for (auto const& a : algorithms)
+    {
+        if (selected != "all" && selected != a.name)
+        {
+            continue;
+        }
+
+        std::int64_t const iterations = vm.count("iterations") != 0 ?
+            vm["iterations"].as<std::int64_t>() : a.default_iterations;
+
+        data_generator gen(std::size_t(size));
+        et::primitive_arguments_type const args = a.arguments(gen, iterations);
+
+        auto func = et::compile(a.name, a.code, snippets).run();
+
+        // warm up
+        func(args, et::eval_context{});
+        peak_array_bytes(true);
+
+        double total = 0.0;
+        double min_time = (std::numeric_limits<double>::max)();
+        for (std::int64_t i = 0; i != repetitions; ++i)
+        {
+            hpx::util::high_resolution_timer timer;
+            func(args, et::eval_context{});
+            double const elapsed = timer.elapsed();
+
+            total += elapsed;
+            min_time = (std::min)(min_time, elapsed);
+        }
+
+        os << (first ? "\n" : ",\n") << "{\"algorithm\":\"" << a.name
+           << "\",\"size\":" << size << ",\"threads\":" << threads
+           << ",\"iterations\":" << iterations
+           << ",\"repetitions\":" << repetitions
+           << ",\"time_s\":" << total / repetitions
+           << ",\"min_time_s\":" << min_time
+           << ",\"peak_array_bytes\":" << peak_array_bytes(false)
+           << ",\"peak_rss_bytes\":" << peak_rss_bytes() << "}";
+
+        first = false;
+    }
+
+    os << "\n]}\n";
+
+    return hpx::finalize();
+}
+
+int main(int argc, char* argv[])
+{
+    boost::program_options::options_description desc(
+        "usage: algorithms_test [options]");
+    desc.add_options()
+        ("algorithm",
+            boost::program_options::value<std::string>()->default_value("all"),
+            "the algorithm to measure: als, kmeans, lir, lra, nn, or all "
+            "(default: all)")
+        ("size",
+            boost::program_options::value<std::int64_t>()->default_value(1000),
+            "the problem size, i.e. the number of samples (default: 1000)")
+        ("iterations",
+            boost::program_options::value<std::int64_t>(),
+            "the number of iterations of the algorithm (default: depends on "
+            "the algorithm)")
+        ("repetitions",
+            boost::program_options::value<std::int64_t>()->default_value(3),
+            "the number of measured runs (default: 3)")
+        ("output,o",
+            boost::program_options::value<std::string>()->default_value("-"),
+            "the file to write the JSON results to (default: stdout)");
+
+    return hpx::init(desc, argc, argv);
+}
@@ -0,0 +1,132 @@
+//   Copyright (c) 2019 Hartmut Kaiser
+//
+//   Distributed under the Boost Software License, Version 1.0. (See accompanying
+//   file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// Measure the convolution and pooling primitives for typical layer shapes.
+// Unit strides use the direct evaluation, larger strides gather the windows
+// into a matrix first (im2col), which allows to compare both methods.
+
+#include <phylanx/phylanx.hpp>
+
+#include <hpx/hpx_main.hpp>
+#include <hpx/include/util.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+#include <string>
+
+#define ITERATIONS 10
+
+///////////////////////////////////////////////////////////////////////////////
+struct benchmark_case
+{
+    char const* name;
+    char const* data;       // expression creating the input
+    char const* kernel;     // expression creating the kernel
+    char const* expr;       // the benchmarked expression using x and k
+};
+
+benchmark_case const cases[] =
+{
+#if defined(PHYLANX_HAVE_BLAZE_TENSOR)
+    {"conv1d (32 x 1024 x 64, kernel 5 x 64 x 64)",
+        R"(random(make_list(32, 1024, 64), "uniform"))",
+        R"(random(make_list(5, 64, 64), "uniform"))",
+        "conv1d(x, k)"},
+    {"conv1d, same padding",
+        R"(random(make_list(32, 1024, 64), "uniform"))",
+        R"(random(make_list(5, 64, 64), "uniform"))",
+        R"(conv1d(x, k, 1, "same"))"},
+    {"conv1d, stride 2 (im2col)",
+        R"(random(make_list(32, 1024, 64), "uniform"))",
+        R"(random(make_list(5, 64, 64), "uniform"))",
+        "conv1d(x, k, 2)"},
+    {"conv1d, dilation 4",
+        R"(random(make_list(32, 1024, 64), "uniform"))",
+        R"(random(make_list(5, 64, 64), "uniform"))",
+        R"(conv1d(x, k, 1, "causal", 4))"},
+    {"conv2d (32 x 256 x 256, kernel 5 x 5)",
+        R"(random(make_list(32, 256, 256), "uniform"))",
+        R"(random(make_list(5, 5), "uniform"))",
+        "conv2d(x, k)"},
+    {"conv2d, stride 2 (im2col)",
+        R"(random(make_list(32, 256, 256), "uniform"))",
+        R"(random(make_list(5, 5), "uniform"))",
+        R"(conv2d(x, k, 2, "same"))"},
+    {"max_pool (32 x 1024 x 64, pool 4)",
+        R"(random(make_list(32, 1024, 64), "uniform"))", "4",
+        "max_pool(x, k)"},
+    {"avg_pool (32 x 1024 x 64, pool 4)",
+        R"(random(make_list(32, 1024, 64), "uniform"))", "4",
+        "avg_pool(x, k)"},
+    {"max_pool (32 x 256 x 256, pool 2 x 2)",
+        R"(random(make_list(32, 256, 256), "uniform"))", "list(2, 2)",
+        "max_pool(x, k)"},
+    {"avg_pool (32 x 256 x 256, pool 3 x 3, stride 1)",
+        R"(random(make_list(32, 256, 256), "uniform"))", "list(3, 3)",
+        R"(avg_pool(x, k, 1, "same"))"},
+#endif
+    {"conv1d (vector of 2^20 elements, kernel 16)",
+        R"(random(make_list(1048576), "uniform"))",
+        R"(random(make_list(16), "uniform"))",
+        "conv1d(x, k)"},
+    {"conv2d (1024 x 1024, kernel 3 x 3)",
+        R"(random(make_list(1024, 1024), "uniform"))",
+        R"(random(make_list(3, 3), "uniform"))",
+        R"(conv2d(x, k, 1, "same"))"},
+    {"conv2d (1024 x 1024, kernel 3 x 3), stride 2 (im2col)",
+        R"(random(make_list(1024, 1024), "uniform"))",
+        R"(random(make_list(3, 3), "uniform"))",
+        R"(conv2d(x, k, 2, "same"))"},
+    {"max_pool (4096 x 256, pool 4)",
+        R"(random(make_list(4096, 256), "uniform"))", "4",
+        "max_pool(x, k)"},
+};
+
+///////////////////////////////////////////////////////////////////////////////
+double benchmark(phylanx::execution_tree::compiler::function_list& snippets,
+    benchmark_case const& c)
+{
+    auto const& data_code = phylanx::execution_tree::compile(
+        std::string("make_list(") + c.data + ", " + c.kernel + ")", snippets);
+    auto result = data_code.run();
+
+    auto args = phylanx::execution_tree::extract_list_value(result);
+    auto it = args.begin();
+    auto x = *it++;
+    auto k = *it;
+
+    auto const& code = phylanx::execution_tree::compile(
+        std::string("define(run, x, k, ") + c.expr + ")\nrun", snippets);
+    auto bench = code.run();
+
+    // warm up
+    bench(x, k);
+
+    std::uint64_t t = hpx::util::high_resolution_clock::now();
+
+    for (int i = 0; i != ITERATIONS; ++i)
+    {
+        bench(x, k);
+    }
+
+    t = hpx::util::high_resolution_clock::now() - t;
+
+    return (t / 1e6) / ITERATIONS;
+}
+
+int main(int argc, char* argv[])
+{
+    phylanx::execution_tree::compiler::function_list snippets;
+
+    std::cout << "convolution and pooling, time per call in ms\n";
+
+    for (auto const& c : cases)
+    {
+        std::cout << c.name << ": " << benchmark(snippets, c) << "\n";
+    }
+
+    return 0;
+}
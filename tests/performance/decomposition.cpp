@@ -0,0 +1,146 @@
+//   Copyright (c) 2019 Hartmut Kaiser
+//
+//   Distributed under the Boost Software License, Version 1.0. (See accompanying
+//   file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// Compare the decomposition primitives with decompositions implemented
+// element-wise in PhySL (as done in examples/algorithms/qr and
+// examples/algorithms/lu_decomposition).
+
+#include <phylanx/phylanx.hpp>
+
+#include <hpx/hpx_main.hpp>
+#include <hpx/include/util.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+#include <string>
+
+#define MATRIX_SIZE std::int64_t(200)
+
+///////////////////////////////////////////////////////////////////////////////
+// symmetric positive definite random matrix
+std::string const randstr = R"(
+    define(call, n, block(
+        define(x, random(make_list(n, n), "uniform")),
+        dot(x, transpose(x)) + n * identity(n)
+    ))
+    call
+)";
+
+///////////////////////////////////////////////////////////////////////////////
+// modified Gram-Schmidt QR decomposition
+std::string const qr_physl = R"(
+    define(run, A, n, block(
+        define(Q, A + 0.0),
+        define(R, constant(0.0, make_list(n, n))),
+        for_each(
+            lambda(k, block(
+                define(qk, slice(Q, nil, k)),
+                store(slice(R, k, k), sqrt(dot(qk, qk))),
+                store(qk, qk / slice(R, k, k)),
+                store(slice(Q, nil, k), qk),
+                for_each(
+                    lambda(j, block(
+                        define(qj, slice(Q, nil, j)),
+                        store(slice(R, k, j), dot(qk, qj)),
+                        store(slice(Q, nil, j), qj - slice(R, k, j) * qk)
+                    )),
+                    range(k + 1, n)
+                )
+            )),
+            range(n)
+        ),
+        make_list(Q, R)
+    ))
+    run
+)";
+
+// Cholesky-Banachiewicz decomposition
+std::string const cholesky_physl = R"(
+    define(run, A, n, block(
+        define(L, constant(0.0, make_list(n, n))),
+        for_each(
+            lambda(i, for_each(
+                lambda(j, block(
+                    define(s, slice(A, i, j) - dot(
+                        slice(L, i, list(0, j, 1)),
+                        slice(L, j, list(0, j, 1)))),
+                    if(i == j,
+                        store(slice(L, i, j), sqrt(s)),
+                        store(slice(L, i, j), s / slice(L, j, j)))
+                )),
+                range(i + 1)
+            )),
+            range(n)
+        ),
+        L
+    ))
+    run
+)";
+
+std::string const qr_primitive = R"(
+    define(run, A, n, qr(A))
+    run
+)";
+
+std::string const cholesky_primitive = R"(
+    define(run, A, n, cholesky(A))
+    run
+)";
+
+std::string const svd_primitive = R"(
+    define(run, A, n, svd(A))
+    run
+)";
+
+std::string const svd_truncated_primitive = R"(
+    define(run, A, n, svd(A, 10))
+    run
+)";
+
+std::string const eigh_primitive = R"(
+    define(run, A, n, eigh(A))
+    run
+)";
+
+///////////////////////////////////////////////////////////////////////////////
+template <typename Data>
+void benchmark(std::string const& name,
+    phylanx::execution_tree::compiler::function_list& snippets,
+    std::string const& codestr, Data const& a)
+{
+    auto const& code = phylanx::execution_tree::compile(codestr, snippets);
+    auto bench = code.run();
+
+    std::uint64_t t = hpx::util::high_resolution_clock::now();
+
+    bench(a, MATRIX_SIZE);
+
+    t = hpx::util::high_resolution_clock::now() - t;
+
+    std::cout << name << ": " << (t / 1e6) << " ms.\n";
+}
+
+int main(int argc, char* argv[])
+{
+    phylanx::execution_tree::compiler::function_list snippets;
+
+    auto const& rand_code = phylanx::execution_tree::compile(randstr, snippets);
+    auto rand = rand_code.run();
+
+    auto a = rand(MATRIX_SIZE);
+
+    benchmark("qr (PhySL)", snippets, qr_physl, a);
+    benchmark("qr", snippets, qr_primitive, a);
+
+    benchmark("cholesky (PhySL)", snippets, cholesky_physl, a);
+    benchmark("cholesky", snippets, cholesky_primitive, a);
+
+    benchmark("svd", snippets, svd_primitive, a);
+    benchmark("svd (truncated, k=10)", snippets, svd_truncated_primitive, a);
+    benchmark("eigh", snippets, eigh_primitive, a);
+
+    return 0;
+}
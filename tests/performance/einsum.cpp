@@ -0,0 +1,111 @@
+//   Copyright (c) 2019 Hartmut Kaiser
+//
+//   Distributed under the Boost Software License, Version 1.0. (See accompanying
+//   file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// Compare einsum for common contraction patterns with the equivalent
+// expressions using dot, transpose, and the reductions.
+
+#include <phylanx/phylanx.hpp>
+
+#include <hpx/hpx_main.hpp>
+#include <hpx/include/util.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+#include <string>
+
+#define MATRIX_SIZE std::int64_t(500)
+#define ITERATIONS 10
+
+///////////////////////////////////////////////////////////////////////////////
+// every benchmark receives two n x n matrices and a vector of size n
+struct benchmark_pattern
+{
+    char const* name;
+    char const* einsum;
+    char const* reference;
+};
+
+benchmark_pattern const patterns[] =
+{
+    {"matrix product", R"(einsum("ij,jk->ik", a, b))", "dot(a, b)"},
+    {"matrix product (transposed lhs)", R"(einsum("ji,jk->ik", a, b))",
+        "dot(transpose(a), b)"},
+    {"matrix product (transposed rhs)", R"(einsum("ij,kj->ik", a, b))",
+        "dot(a, transpose(b))"},
+    {"transposed result", R"(einsum("ij,jk->ki", a, b))",
+        "transpose(dot(a, b))"},
+    {"matrix vector product", R"(einsum("ij,j->i", a, v))", "dot(a, v)"},
+    {"vector matrix product", R"(einsum("i,ij->j", v, a))", "dot(v, a)"},
+    {"bilinear form", R"(einsum("i,ij,j", v, a, v))", "dot(v, dot(a, v))"},
+    {"matrix chain", R"(einsum("ij,jk,kl->il", a, b, a))",
+        "dot(dot(a, b), a)"},
+    {"frobenius product", R"(einsum("ij,ij", a, b))", "sum(a * b)"},
+    {"trace", R"(einsum("ii", a))", "sum(diag(a))"},
+    {"row sums", R"(einsum("ij->i", a))", "sum(a, 1)"},
+    {"outer product", R"(einsum("i,j->ij", v, v))", "outer(v, v)"},
+};
+
+///////////////////////////////////////////////////////////////////////////////
+template <typename Data>
+double benchmark(phylanx::execution_tree::compiler::function_list& snippets,
+    std::string const& expr, Data const& a, Data const& b, Data const& v)
+{
+    std::string const codestr =
+        "define(run, a, b, v, " + expr + ")\nrun";
+
+    auto const& code = phylanx::execution_tree::compile(codestr, snippets);
+    auto bench = code.run();
+
+    // warm up
+    bench(a, b, v);
+
+    std::uint64_t t = hpx::util::high_resolution_clock::now();
+
+    for (int i = 0; i != ITERATIONS; ++i)
+    {
+        bench(a, b, v);
+    }
+
+    t = hpx::util::high_resolution_clock::now() - t;
+
+    return (t / 1e6) / ITERATIONS;
+}
+
+int main(int argc, char* argv[])
+{
+    phylanx::execution_tree::compiler::function_list snippets;
+
+    auto const& data_code = phylanx::execution_tree::compile(R"(
+        define(data, n, make_list(
+            random(make_list(n, n), "uniform"),
+            random(make_list(n, n), "uniform"),
+            random(make_list(n), "uniform")
+        ))
+        data
+    )", snippets);
+    auto data = data_code.run();
+
+    auto result = data(MATRIX_SIZE);
+    auto args = phylanx::execution_tree::extract_list_value(result);
+    auto it = args.begin();
+    auto a = *it++;
+    auto b = *it++;
+    auto v = *it;
+
+    std::cout << "einsum vs. reference, n = " << MATRIX_SIZE
+              << ", time per call in ms\n";
+
+    for (auto const& p : patterns)
+    {
+        double const t_einsum = benchmark(snippets, p.einsum, a, b, v);
+        double const t_ref = benchmark(snippets, p.reference, a, b, v);
+
+        std::cout << p.name << ": " << t_einsum << " (einsum), " << t_ref
+                  << " (" << p.reference << ")\n";
+    }
+
+    return 0;
+}
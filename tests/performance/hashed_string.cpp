@@ -0,0 +1,198 @@
+//   Copyright (c) 2019 Hartmut Kaiser
+//
+//   Distributed under the Boost Software License, Version 1.0. (See accompanying
+//   file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// Measure the cost of constructing a hashed_string from a std::string, which
+// looks the string up in the symbol table, and of using it as the key of a
+// lookup table the way the compiler environment does (env.find(name)). The
+// interned keys are compared against the previous representation, which
+// stored a copy of the string and its hash in every key. Both are measured
+// on a single thread and on all worker threads concurrently.
+
+#include <phylanx/phylanx.hpp>
+
+#include <hpx/hpx_main.hpp>
+#include <hpx/include/parallel_for_loop.hpp>
+#include <hpx/include/runtime.hpp>
+#include <hpx/include/util.hpp>
+#include <hpx/util/jenkins_hash.hpp>
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+#include <map>
+#include <string>
+#include <vector>
+
+#define ITERATIONS 10
+
+///////////////////////////////////////////////////////////////////////////////
+// the key type used before the strings were interned
+struct copied_string
+{
+    using hasher = hpx::util::jenkins_hash;
+    using size_type = hasher::size_type;
+
+    copied_string(std::string const& key)
+      : key_(key)
+      , hash_(hasher{}(key_))
+    {
+    }
+
+    friend bool operator<(copied_string const& lhs, copied_string const& rhs)
+    {
+        return (lhs.hash_ < rhs.hash_) ||
+            (lhs.hash_ == rhs.hash_ && lhs.key_ < rhs.key_);
+    }
+
+    std::string key_;
+    size_type hash_;
+};
+
+///////////////////////////////////////////////////////////////////////////////
+// names as generated by the Python frontend (tagged identifiers) and the
+// names of some builtins
+std::vector<std::string> generate_names(std::size_t count)
+{
+    char const* const builtins[] = {"define", "block", "if", "while", "dot",
+        "transpose", "constant", "store", "__add", "__mul"};
+
+    std::vector<std::string> names;
+    names.reserve(count);
+    for (std::size_t i = 0; i != count; ++i)
+    {
+        if (i % 4 == 0)
+        {
+            names.push_back(builtins[(i / 4) % 10]);
+        }
+        else
+        {
+            names.push_back("variable" + std::to_string(i) + "$" +
+                std::to_string(i / 10 + 1) + "$" + std::to_string(i % 80));
+        }
+    }
+    return names;
+}
+
+// the time per operation in ns, f is invoked for every name, either on this
+// thread or on all worker threads
+template <typename F>
+double measure(std::vector<std::string> const& names, bool parallel, F&& f)
+{
+    auto run = [&]() {
+        if (parallel)
+        {
+            hpx::parallel::for_loop(hpx::parallel::execution::par,
+                std::size_t(0), names.size(),
+                [&](std::size_t i) { f(names[i]); });
+        }
+        else
+        {
+            for (auto const& name : names)
+            {
+                f(name);
+            }
+        }
+    };
+
+    // warm up, this also interns all names
+    run();
+
+    std::uint64_t t = hpx::util::high_resolution_clock::now();
+
+    for (int i = 0; i != ITERATIONS; ++i)
+    {
+        run();
+    }
+
+    t = hpx::util::high_resolution_clock::now() - t;
+
+    return double(t) / (double(ITERATIONS) * names.size());
+}
+
+///////////////////////////////////////////////////////////////////////////////
+int main(int argc, char* argv[])
+{
+    std::size_t const count = 100000;
+    std::vector<std::string> const names = generate_names(count);
+
+    // lookup tables holding every other name, similar to the compiler
+    // environment, which holds the builtins and the defined variables
+    std::map<copied_string, int> copied_map;
+    std::map<phylanx::util::hashed_string, int> interned_map;
+    for (std::size_t i = 0; i < names.size(); i += 2)
+    {
+        copied_map.emplace(names[i], int(i));
+        interned_map.emplace(names[i], int(i));
+    }
+
+    // accumulate the results to keep the compiler from dropping the work
+    std::atomic<std::size_t> found(0);
+
+    std::cout << "hashed_string, " << count << " names, "
+              << hpx::get_num_worker_threads()
+              << " worker threads, time per operation in ns "
+                 "(copied, interned)\n";
+
+    for (bool parallel : {false, true})
+    {
+        char const* const mode = parallel ? " (parallel)" : "";
+
+        double const copied_construct =
+            measure(names, parallel, [&](std::string const& name) {
+                copied_string key(name);
+                found.fetch_add(key.hash_ & 1, std::memory_order_relaxed);
+            });
+        double const interned_construct =
+            measure(names, parallel, [&](std::string const& name) {
+                phylanx::util::hashed_string key(name);
+                found.fetch_add(key.hash() & 1, std::memory_order_relaxed);
+            });
+
+        std::cout << "construct" << mode << ": " << copied_construct << ", "
+                  << interned_construct << "\n";
+
+        double const copied_find =
+            measure(names, parallel, [&](std::string const& name) {
+                found.fetch_add(copied_map.count(copied_string(name)),
+                    std::memory_order_relaxed);
+            });
+        double const interned_find =
+            measure(names, parallel, [&](std::string const& name) {
+                found.fetch_add(
+                    interned_map.count(phylanx::util::hashed_string(name)),
+                    std::memory_order_relaxed);
+            });
+
+        std::cout << "construct and find" << mode << ": " << copied_find
+                  << ", " << interned_find << "\n";
+    }
+
+    // the keys of the variables accessed during evaluation are constructed
+    // once by the compiler, only the lookup itself is repeated
+    std::vector<copied_string> copied_keys(names.begin(), names.end());
+    std::vector<phylanx::util::hashed_string> interned_keys(
+        names.begin(), names.end());
+
+    double const copied_prebuilt = measure(names, false,
+        [&, i = std::size_t(0)](std::string const&) mutable {
+            found.fetch_add(copied_map.count(copied_keys[i++ % count]),
+                std::memory_order_relaxed);
+        });
+    double const interned_prebuilt = measure(names, false,
+        [&, i = std::size_t(0)](std::string const&) mutable {
+            found.fetch_add(interned_map.count(interned_keys[i++ % count]),
+                std::memory_order_relaxed);
+        });
+
+    std::cout << "find with existing key: " << copied_prebuilt << ", "
+              << interned_prebuilt << "\n";
+
+    std::cout << "(found " << found.load() << ", "
+              << phylanx::util::interned_string_count()
+              << " interned strings)\n";
+
+    return 0;
+}
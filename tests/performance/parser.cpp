@@ -0,0 +1,208 @@
+//   Copyright (c) 2019 Hartmut Kaiser
+//
+//   Distributed under the Boost Software License, Version 1.0. (See accompanying
+//   file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// Measure the throughput of the PhySL parsers on generated programs of a
+// configurable size. The 'code' input resembles the output of the Python
+// frontend (nested function calls with tagged identifiers), the 'arrays'
+// input consists of large numeric array literals. Both the single-pass
+// parser (generate_ast) and the Spirit based parser (generate_ast_qi) are
+// measured, the results are written as JSON.
+
+#include <phylanx/phylanx.hpp>
+
+#include <hpx/hpx_init.hpp>
+#include <hpx/include/util.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <limits>
+#include <random>
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <boost/program_options.hpp>
+
+///////////////////////////////////////////////////////////////////////////////
+// a sequence of function definitions as generated by the Python frontend
+std::string generate_code(std::size_t size)
+{
+    std::ostringstream strm;
+    std::size_t line = 1;
+
+    for (std::size_t f = 0; std::size_t(strm.tellp()) < size; ++f)
+    {
+        strm << "define$" << line << "$0(func" << f << "$" << line
+             << "$7, x$" << line << "$14, y$" << line << "$17,\n";
+        strm << "    block$" << ++line << "$4(\n";
+        strm << "        define$" << ++line << "$8(a$" << line
+             << "$15, x$" << line << "$18 * 2.5 + -y$" << line
+             << "$28 / (1.0 - x$" << line << "$40)),\n";
+        strm << "        if$" << ++line << "$8(a$" << line << "$11 >= 0 && "
+             << "x$" << line << "$21 != y$" << line << "$26,\n";
+        strm << "            store$" << ++line << "$12(a$" << line
+             << "$18, dot$" << line << "$21(a$" << line << "$25, "
+             << "transpose$" << line << "$28(x$" << line << "$38))),\n";
+        strm << "            '(\"result\", a$" << ++line << "$26, " << f
+             << ", " << f << ".5)\n";
+        strm << "        ),  // returns a list\n";
+        strm << "        a$" << (line += 2) << "$8\n";
+        strm << "    )\n";
+        strm << ")\n";
+        line += 2;
+    }
+    return strm.str();
+}
+
+// a sequence of large numeric array literals
+std::string generate_arrays(std::size_t size)
+{
+    std::mt19937 gen(42);
+    std::uniform_real_distribution<double> real_dist(-100.0, 100.0);
+    std::uniform_int_distribution<std::int64_t> int_dist(-1000, 1000);
+
+    std::ostringstream strm;
+    for (std::size_t i = 0; std::size_t(strm.tellp()) < size; ++i)
+    {
+        bool const integral = (i % 2) != 0;
+
+        strm << "define(m" << i << ", [";
+        for (std::size_t row = 0; row != 100; ++row)
+        {
+            strm << (row == 0 ? "[" : ",\n    [");
+            for (std::size_t col = 0; col != 100; ++col)
+            {
+                if (col != 0)
+                {
+                    strm << ", ";
+                }
+                if (integral)
+                {
+                    strm << int_dist(gen);
+                }
+                else
+                {
+                    strm << real_dist(gen);
+                }
+            }
+            strm << "]";
+        }
+        strm << "])\n";
+    }
+    return strm.str();
+}
+
+///////////////////////////////////////////////////////////////////////////////
+struct parser
+{
+    char const* name;
+    std::function<std::vector<phylanx::ast::expression>(
+        std::string const&)> parse;
+};
+
+std::vector<parser> const parsers =
+{
+    {"single_pass", &phylanx::ast::generate_ast},
+    {"spirit", &phylanx::ast::generate_ast_qi},
+};
+
+int hpx_main(boost::program_options::variables_map& vm)
+{
+    std::size_t const size =
+        std::size_t(vm["size"].as<double>() * 1024 * 1024);
+    std::int64_t const repetitions =
+        (std::max)(vm["repetitions"].as<std::int64_t>(), std::int64_t(1));
+
+    std::ofstream file;
+    std::string const output = vm["output"].as<std::string>();
+    if (output != "-")
+    {
+        file.open(output.c_str(), std::ios::out | std::ios::trunc);
+        if (!file.is_open())
+        {
+            std::cerr << "parser: couldn't open file: " << output << "\n";
+            return hpx::finalize();
+        }
+    }
+    std::ostream& os = file.is_open() ? file : std::cout;
+
+    std::pair<char const*, std::string> const inputs[] = {
+        {"code", generate_code(size)},
+        {"arrays", generate_arrays(size)},
+    };
+
+    os << "{\"benchmark\":\"parser\",\n\"results\":[";
+
+    bool first = true;
+    for (auto const& input : inputs)
+    {
+        std::size_t expressions = 0;
+        for (auto const& p : parsers)
+        {
+            // warm up, this also verifies that both parsers agree
+            std::size_t const count = p.parse(input.second).size();
+            if (expressions != 0 && count != expressions)
+            {
+                std::cerr << "parser: " << p.name << " produced " << count
+                          << " expressions instead of " << expressions
+                          << " for input '" << input.first << "'\n";
+            }
+            expressions = count;
+
+            double total = 0.0;
+            double min_time = (std::numeric_limits<double>::max)();
+            for (std::int64_t i = 0; i != repetitions; ++i)
+            {
+                hpx::util::high_resolution_timer timer;
+                auto asts = p.parse(input.second);
+                double const elapsed = timer.elapsed();
+
+                total += elapsed;
+                min_time = (std::min)(min_time, elapsed);
+            }
+
+            double const mbytes =
+                double(input.second.size()) / (1024.0 * 1024.0);
+
+            os << (first ? "\n" : ",\n") << "{\"parser\":\"" << p.name
+               << "\",\"input\":\"" << input.first
+               << "\",\"size\":" << input.second.size()
+               << ",\"expressions\":" << count
+               << ",\"repetitions\":" << repetitions
+               << ",\"time_s\":" << total / repetitions
+               << ",\"min_time_s\":" << min_time
+               << ",\"mb_per_s\":" << mbytes / min_time << "}";
+
+            first = false;
+        }
+    }
+
+    os << "\n]}\n";
+
+    return hpx::finalize();
+}
+
+int main(int argc, char* argv[])
+{
+    boost::program_options::options_description desc(
+        "usage: parser_test [options]");
+    desc.add_options()
+        ("size",
+            boost::program_options::value<double>()->default_value(4.0),
+            "the size of the generated inputs in MB (default: 4)")
+        ("repetitions",
+            boost::program_options::value<std::int64_t>()->default_value(5),
+            "the number of measured runs (default: 5)")
+        ("output,o",
+            boost::program_options::value<std::string>()->default_value("-"),
+            "the file to write the JSON results to (default: stdout)");
+
+    return hpx::init(desc, argc, argv);
+}
@@ -0,0 +1,465 @@
+//   Copyright (c) 2019 Hartmut Kaiser
+//
+//   Distributed under the Boost Software License, Version 1.0. (See accompanying
+//   file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// Measure all registered primitives for arrays of different shapes and
+// element types. Every pattern of the form 'name(_1, ...)' is invoked with
+// each of the generated arguments, combinations rejected by the primitive
+// are silently skipped. The results are written as JSON, one measurement per
+// line, which allows to compare the results of different builds (see
+// tools/benchmarks/compare_benchmarks.py).
+//
+// For each measurement the harness reports the time for the whole invocation
+// (call_ns), the time spent inside the primitive as recorded by the primitive
+// registry (kernel_ns), and the difference of both (dispatch_ns), which is the
+// overhead of invoking the compiled code.
+
+#include <phylanx/phylanx.hpp>
+#include <phylanx/execution_tree/primitives/primitive_registry.hpp>
+
+#include <hpx/hpx_init.hpp>
+#include <hpx/include/runtime.hpp>
+#include <hpx/include/util.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <fstream>
+#include <iostream>
+#include <limits>
+#include <regex>
+#include <set>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <boost/program_options.hpp>
+
+#include <blaze/Math.h>
+#if defined(PHYLANX_HAVE_BLAZE_TENSOR)
+#include <blaze_tensor/Math.h>
+#endif
+
+namespace et = phylanx::execution_tree;
+
+///////////////////////////////////////////////////////////////////////////////
+// primitives which are not meaningful to measure in isolation: control flow,
+// I/O, complete algorithms, and primitives used by the harness itself
+std::set<std::string> const excluded_primitives =
+{
+    "__name", "__type", "access-argument", "access-function",
+    "access-variable", "als", "apply", "assert", "block", "call-function",
+    "cout", "debug", "define", "define-variable", "dump_trace",
+    "enable_tracing", "file_read", "file_read_csv", "file_read_hdf5",
+    "file_write", "file_write_csv", "file_write_hdf5", "filter", "fmap",
+    "fold_left", "fold_right", "for", "for_each", "format", "function", "if",
+    "lambda", "lra", "parallel_block", "parallel_for_each", "parallel_map",
+    "parallel_reduce", "set_seed", "start_trace", "stop_trace", "store",
+    "string", "target-reference", "variable", "variable-factory", "vmap",
+    "while"
+};
+
+// the generated arguments
+struct shape_config
+{
+    char const* size;
+    std::vector<std::size_t> dims;
+};
+
+std::vector<shape_config> const shapes =
+{
+    {"scalar", {}},
+    {"small", {16}}, {"medium", {1024}}, {"large", {65536}},
+    {"small", {8, 8}}, {"medium", {64, 64}}, {"large", {512, 512}},
+#if defined(PHYLANX_HAVE_BLAZE_TENSOR)
+    {"small", {2, 4, 4}}, {"medium", {8, 32, 32}}, {"large", {16, 128, 128}},
+#endif
+};
+
+char const* const dtypes[] = {"float64", "int64", "bool"};
+
+///////////////////////////////////////////////////////////////////////////////
+// Extract the function name and the number of arguments from a pattern like
+// 'sum(_1, __arg(_2_axis, nil))' (optional arguments are not passed). Return
+// false for patterns which can't be invoked with arrays only.
+bool parse_pattern(
+    std::string const& pattern, std::string& name, std::size_t& num_args)
+{
+    std::size_t const open = pattern.find('(');
+    if (open == std::string::npos || open == 0 || pattern.back() != ')')
+    {
+        return false;           // operators, e.g. '_1 + __2'
+    }
+
+    name = pattern.substr(0, open);
+    if (name.find_first_of(" +-*/%<>=!&|") != std::string::npos)
+    {
+        return false;
+    }
+
+    // split the argument list at the top-level commas
+    std::vector<std::string> args;
+    std::string arg;
+    int nesting = 0;
+    for (char c : pattern.substr(open + 1, pattern.size() - open - 2))
+    {
+        if (c == ',' && nesting == 0)
+        {
+            args.push_back(arg);
+            arg.clear();
+            continue;
+        }
+        if (c == '(')
+        {
+            ++nesting;
+        }
+        else if (c == ')')
+        {
+            --nesting;
+        }
+        if (c != ' ')
+        {
+            arg += c;
+        }
+    }
+    if (!arg.empty())
+    {
+        args.push_back(arg);
+    }
+
+    static std::regex const placeholder("__?[0-9]+(_[A-Za-z0-9_]*)?");
+
+    num_args = 0;
+    for (auto const& a : args)
+    {
+        if (a.compare(0, 6, "__arg(") == 0)
+        {
+            continue;
+        }
+        if (!std::regex_match(a, placeholder))
+        {
+            return false;       // literal arguments
+        }
+        ++num_args;
+    }
+    return num_args != 0 && num_args <= 3;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// the values avoid zeros to keep log, division and friends well-defined
+template <typename T>
+T generate_value(std::size_t i)
+{
+    if (std::is_same<T, std::uint8_t>::value)
+    {
+        return T(i % 2);
+    }
+    return T(1 + i % 7);
+}
+
+template <typename T>
+et::primitive_argument_type generate_argument(
+    std::vector<std::size_t> const& dims)
+{
+    std::size_t i = 0;
+    switch (dims.size())
+    {
+    case 1:
+        {
+            blaze::DynamicVector<T> v(dims[0]);
+            for (auto& value : v)
+            {
+                value = generate_value<T>(i++);
+            }
+            return et::primitive_argument_type{
+                phylanx::ir::node_data<T>{std::move(v)}};
+        }
+
+    case 2:
+        {
+            blaze::DynamicMatrix<T> m(dims[0], dims[1]);
+            for (std::size_t r = 0; r != m.rows(); ++r)
+            {
+                for (auto& value : blaze::row(m, r))
+                {
+                    value = generate_value<T>(i++);
+                }
+            }
+            return et::primitive_argument_type{
+                phylanx::ir::node_data<T>{std::move(m)}};
+        }
+
+#if defined(PHYLANX_HAVE_BLAZE_TENSOR)
+    case 3:
+        {
+            blaze::DynamicTensor<T> t(dims[0], dims[1], dims[2]);
+            for (std::size_t p = 0; p != t.pages(); ++p)
+            {
+                for (std::size_t r = 0; r != t.rows(); ++r)
+                {
+                    for (std::size_t c = 0; c != t.columns(); ++c)
+                    {
+                        t(p, r, c) = generate_value<T>(i++);
+                    }
+                }
+            }
+            return et::primitive_argument_type{
+                phylanx::ir::node_data<T>{std::move(t)}};
+        }
+#endif
+
+    default:
+        break;
+    }
+    return et::primitive_argument_type{
+        phylanx::ir::node_data<T>{generate_value<T>(0)}};
+}
+
+et::primitive_argument_type generate_argument(
+    std::string const& dtype, std::vector<std::size_t> const& dims)
+{
+    if (dtype == "int64")
+    {
+        return generate_argument<std::int64_t>(dims);
+    }
+    if (dtype == "bool")
+    {
+        return generate_argument<std::uint8_t>(dims);
+    }
+    return generate_argument<double>(dims);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+struct timing
+{
+    std::int64_t iterations = 0;
+    double call_ns = 0;
+    double min_call_ns = 0;
+};
+
+// Invoke the given function until min_time seconds have elapsed or
+// max_iterations invocations were done. The first invocation is not
+// measured, it throws if the primitive does not support the arguments.
+template <typename F>
+timing measure(F&& f, double min_time, std::int64_t max_iterations)
+{
+    f();
+
+    std::uint64_t total = 0;
+    std::uint64_t min_duration = (std::numeric_limits<std::uint64_t>::max)();
+
+    timing result;
+    while (result.iterations < max_iterations &&
+        total < std::uint64_t(min_time * 1e9))
+    {
+        std::uint64_t t = hpx::util::high_resolution_clock::now();
+        f();
+        t = hpx::util::high_resolution_clock::now() - t;
+
+        total += t;
+        min_duration = (std::min)(min_duration, t);
+        ++result.iterations;
+    }
+
+    if (result.iterations != 0)
+    {
+        result.call_ns = double(total) / result.iterations;
+        result.min_call_ns = double(min_duration);
+    }
+    return result;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+void write_dims(std::ostream& os, std::vector<std::size_t> const& dims)
+{
+    os << '[';
+    for (std::size_t i = 0; i != dims.size(); ++i)
+    {
+        if (i != 0)
+        {
+            os << ',';
+        }
+        os << dims[i];
+    }
+    os << ']';
+}
+
+int hpx_main(boost::program_options::variables_map& vm)
+{
+    std::regex const filter(vm["primitives"].as<std::string>());
+    std::string const sizes = vm["sizes"].as<std::string>();
+    double const min_time = vm["min_time"].as<double>();
+    std::int64_t const max_iterations = vm["max_iterations"].as<std::int64_t>();
+
+    std::ofstream file;
+    std::string const output = vm["output"].as<std::string>();
+    if (output != "-")
+    {
+        file.open(output.c_str(), std::ios::out | std::ios::trunc);
+        if (!file.is_open())
+        {
+            std::cerr << "primitives: couldn't open file: " << output << "\n";
+            return hpx::finalize();
+        }
+    }
+    std::ostream& os = file.is_open() ? file : std::cout;
+
+    et::compiler::function_list snippets;
+
+    // the overhead of invoking compiled code doing nothing
+    auto const& identity = et::compile(
+        "identity", "define(bench, a0, a0)\nbench", snippets);
+    auto identity_func = identity.run();
+
+    et::primitive_arguments_type const identity_args{
+        generate_argument("float64", {})};
+    timing const baseline = measure(
+        [&]() { return identity_func(identity_args, et::eval_context{}); },
+        min_time, max_iterations);
+
+    os << "{\"benchmark\":\"primitives\",\"threads\":"
+       << hpx::get_os_thread_count() << ",\"baseline_ns\":"
+       << baseline.call_ns << ",\n\"results\":[";
+
+    bool first = true;
+    std::size_t measured = 0;
+    std::set<std::pair<std::string, std::size_t>> seen;
+
+    for (auto const& pattern : et::get_all_known_patterns())
+    {
+        std::string const& type = pattern.data_.primitive_type_;
+        if (excluded_primitives.count(type) != 0 ||
+            !std::regex_search(type, filter))
+        {
+            continue;
+        }
+
+        auto& type_data = et::primitives::get_primitive_type_data(type);
+        type_data.enable_measurements();
+
+        for (auto const& p : pattern.data_.patterns_)
+        {
+            std::string name;
+            std::size_t num_args = 0;
+            if (!parse_pattern(p, name, num_args) ||
+                !seen.emplace(name, num_args).second)
+            {
+                continue;
+            }
+
+            std::string codestr = "define(bench";
+            std::string call = name + "(";
+            for (std::size_t i = 0; i != num_args; ++i)
+            {
+                std::string const arg = "a" + std::to_string(i);
+                codestr += ", " + arg;
+                call += (i == 0 ? "" : ", ") + arg;
+            }
+            codestr += ", " + call + "))\nbench";
+
+            et::compiler::function bench_func;
+            try
+            {
+                auto const& code = et::compile(name, codestr, snippets);
+                bench_func = code.run();
+            }
+            catch (std::exception const&)
+            {
+                continue;
+            }
+
+            for (char const* dtype : dtypes)
+            {
+                for (auto const& shape : shapes)
+                {
+                    if (std::string(shape.size) != "scalar" &&
+                        sizes.find(shape.size) == std::string::npos)
+                    {
+                        continue;
+                    }
+
+                    et::primitive_arguments_type const args(
+                        num_args, generate_argument(dtype, shape.dims));
+
+                    // discard the evaluations of the previous measurement
+                    type_data.statistics(true);
+
+                    timing t;
+                    try
+                    {
+                        t = measure(
+                            [&]() {
+                                return bench_func(args, et::eval_context{});
+                            },
+                            min_time, max_iterations);
+                    }
+                    catch (std::exception const&)
+                    {
+                        continue;       // arguments not supported
+                    }
+
+                    // the registry has recorded the warm-up run as well
+                    auto const stats = type_data.statistics(true);
+                    double const kernel_ns = stats.eval_count == 0 ? 0.0 :
+                        double(stats.eval_duration) / stats.eval_count;
+
+                    os << (first ? "\n" : ",\n") << "{\"primitive\":\""
+                       << type << "\",\"pattern\":\"" << name << "/"
+                       << num_args << "\",\"dtype\":\"" << dtype
+                       << "\",\"size\":\"" << shape.size << "\",\"shape\":";
+                    write_dims(os, shape.dims);
+                    os << ",\"iterations\":" << t.iterations
+                       << ",\"call_ns\":" << t.call_ns
+                       << ",\"min_call_ns\":" << t.min_call_ns
+                       << ",\"kernel_ns\":" << kernel_ns
+                       << ",\"dispatch_ns\":"
+                       << (std::max)(0.0, t.call_ns - kernel_ns) << "}";
+
+                    first = false;
+                    ++measured;
+                }
+            }
+        }
+    }
+
+    os << "\n]}\n";
+
+    if (file.is_open())
+    {
+        std::cout << "primitives: " << measured
+                  << " measurements written to " << output << "\n";
+    }
+
+    return hpx::finalize();
+}
+
+int main(int argc, char* argv[])
+{
+    boost::program_options::options_description desc(
+        "usage: primitives_test [options]");
+    desc.add_options()
+        ("primitives",
+            boost::program_options::value<std::string>()->default_value(""),
+            "measure the primitive types matching this regular expression "
+            "only (default: all)")
+        ("sizes",
+            boost::program_options::value<std::string>()->default_value(
+                "small,medium,large"),
+            "the array sizes to measure (default: small,medium,large)")
+        ("min_time",
+            boost::program_options::value<double>()->default_value(0.05),
+            "the minimal time to spend on each measurement in seconds "
+            "(default: 0.05)")
+        ("max_iterations",
+            boost::program_options::value<std::int64_t>()->default_value(1000),
+            "the maximal number of invocations for each measurement "
+            "(default: 1000)")
+        ("output,o",
+            boost::program_options::value<std::string>()->default_value("-"),
+            "the file to write the JSON results to (default: stdout)");
+
+    return hpx::init(desc, argc, argv);
+}
@@ -0,0 +1,101 @@
+//   Copyright (c) 2019 Hartmut Kaiser
+//
+//   Distributed under the Boost Software License, Version 1.0. (See accompanying
+//   file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// Measure the elementwise transcendental functions on large vectors: blaze's
+// (serial) evaluation, the standard library functions evaluated in parallel
+// chunks ('accurate'), and the vectorized kernels ('fast').
+
+#include <phylanx/phylanx.hpp>
+#include <phylanx/util/vector_math.hpp>
+
+#include <hpx/hpx_main.hpp>
+#include <hpx/include/util.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+
+#include <blaze/Math.h>
+
+#define ITERATIONS 10
+
+///////////////////////////////////////////////////////////////////////////////
+template <typename F>
+double measure(F&& f)
+{
+    // warm up
+    f();
+
+    std::uint64_t t = hpx::util::high_resolution_clock::now();
+
+    for (int i = 0; i != ITERATIONS; ++i)
+    {
+        f();
+    }
+
+    t = hpx::util::high_resolution_clock::now() - t;
+
+    return (t / 1e6) / ITERATIONS;
+}
+
+template <typename Blaze>
+void benchmark(char const* name, phylanx::util::math_function f,
+    blaze::DynamicVector<double> const& x, Blaze&& blaze_func)
+{
+    blaze::DynamicVector<double> result(x.size());
+
+    double const blaze_time = measure(
+        [&]() { result = blaze::serial(blaze_func(x)); });
+
+    double const accurate_time = measure([&]() {
+        phylanx::util::apply_math_function(f, x.data(), x.size(),
+            result.data(), result.size(), 1, x.size(),
+            phylanx::util::math_accuracy::accurate);
+    });
+
+    double const fast_time = measure([&]() {
+        phylanx::util::apply_math_function(f, x.data(), x.size(),
+            result.data(), result.size(), 1, x.size(),
+            phylanx::util::math_accuracy::fast);
+    });
+
+    std::cout << name << ": " << blaze_time << ", " << accurate_time << ", "
+              << fast_time << "\n";
+}
+
+int main(int argc, char* argv[])
+{
+    std::size_t const size = 1 << 22;
+
+    blaze::DynamicVector<double> x(size);
+    blaze::DynamicVector<double> positive(size);
+    for (std::size_t i = 0; i != size; ++i)
+    {
+        x[i] = 8.0 * double(i) / double(size) - 4.0;
+        positive[i] = 1e-3 + 100.0 * double(i) / double(size);
+    }
+
+    using phylanx::util::math_function;
+
+    std::cout << "elementwise functions of " << size
+              << " elements, time per call in ms (blaze, accurate, fast)\n";
+
+    benchmark("exp", math_function::exp, x,
+        [](auto const& v) { return blaze::exp(v); });
+    benchmark("log", math_function::log, positive,
+        [](auto const& v) { return blaze::log(v); });
+    benchmark("tanh", math_function::tanh, x,
+        [](auto const& v) { return blaze::tanh(v); });
+    benchmark("erf", math_function::erf, x,
+        [](auto const& v) { return blaze::erf(v); });
+    benchmark("erfc", math_function::erfc, x,
+        [](auto const& v) { return blaze::erfc(v); });
+    benchmark("cbrt", math_function::cbrt, x,
+        [](auto const& v) { return blaze::cbrt(v); });
+    benchmark("arcsinh", math_function::asinh, x,
+        [](auto const& v) { return blaze::asinh(v); });
+
+    return 0;
+}
@@ -0,0 +1,168 @@
+//   Copyright (c) 2019 Hartmut Kaiser
+//
+//   Distributed under the Boost Software License, Version 1.0. (See accompanying
+//   file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <phylanx/phylanx.hpp>
+
+#include <hpx/hpx_main.hpp>
+#include <hpx/util/lightweight_test.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <utility>
+#include <vector>
+
+///////////////////////////////////////////////////////////////////////////////
+char const* const code = R"(
+    define(fact, n,
+        if(n <= 1, 1, n * fact(n - 1))
+    )
+    define(v, [1.0, 2.5, -3.0])
+    define(m, [[1, 2, 3], [4, 5, 6]])
+    define(s, "string", '(true, nil, 42, 1.5, "string"))
+    func{attribute}(-a, !b, (c + d) * e)
+    fact(5)
+)";
+
+void test_roundtrip(std::vector<phylanx::ast::expression> const& expected,
+    phylanx::ast::flat_ast const& flat)
+{
+    HPX_TEST_EQ(flat.root_count(), expected.size());
+
+    auto exprs = flat.expressions();
+    HPX_TEST_EQ(exprs.size(), expected.size());
+    for (std::size_t i = 0; i != exprs.size() && i != expected.size(); ++i)
+    {
+        HPX_TEST_EQ(exprs[i], expected[i]);
+        HPX_TEST_EQ(phylanx::ast::to_string(exprs[i], true),
+            phylanx::ast::to_string(expected[i], true));
+    }
+}
+
+void test_flat_ast()
+{
+    auto ast = phylanx::ast::generate_ast(code);
+    phylanx::ast::flat_ast flat(ast);
+
+    test_roundtrip(ast, flat);
+
+    // all names are stored once
+    HPX_TEST_LT(flat.string_count(), std::size_t(20));
+
+    // reload from the raw bytes
+    std::vector<char> bytes(flat.data(), flat.data() + flat.size());
+    HPX_TEST(phylanx::ast::flat_ast::is_flat_ast(bytes.data(), bytes.size()));
+    test_roundtrip(ast, phylanx::ast::flat_ast::from_buffer(bytes));
+
+    // write to and load (memory-map) from a file
+    std::string const path = "flat_ast_test.ast";
+    flat.save(path);
+    test_roundtrip(ast, phylanx::ast::flat_ast::load(path));
+    std::remove(path.c_str());
+}
+
+void test_invalid_flat_ast()
+{
+    auto ast = phylanx::ast::generate_ast(code);
+    phylanx::ast::flat_ast flat(ast);
+
+    // truncated data
+    {
+        std::vector<char> bytes(flat.data(), flat.data() + flat.size() / 2);
+
+        bool caught_exception = false;
+        try
+        {
+            phylanx::ast::flat_ast::from_buffer(std::move(bytes));
+        }
+        catch (hpx::exception const&)
+        {
+            caught_exception = true;
+        }
+        HPX_TEST(caught_exception);
+    }
+
+    // child index out of range
+    {
+        std::vector<char> bytes(flat.data(), flat.data() + flat.size());
+
+        auto const& h =
+            *reinterpret_cast<phylanx::ast::flat_ast::header const*>(
+                bytes.data());
+        std::size_t const nodes_offset =
+            sizeof(phylanx::ast::flat_ast::header) + h.data_count * 8;
+
+        auto* nodes = reinterpret_cast<phylanx::ast::flat_ast::node*>(
+            bytes.data() + nodes_offset);
+        nodes[h.node_count - 1].first_child = h.child_count;
+
+        bool caught_exception = false;
+        try
+        {
+            phylanx::ast::flat_ast::from_buffer(std::move(bytes));
+        }
+        catch (hpx::exception const&)
+        {
+            caught_exception = true;
+        }
+        HPX_TEST(caught_exception);
+    }
+    // shared nodes (here: the same top-level expression used twice), these
+    // would be expanded more than once
+    {
+        std::vector<char> bytes(flat.data(), flat.data() + flat.size());
+
+        auto const& h =
+            *reinterpret_cast<phylanx::ast::flat_ast::header const*>(
+                bytes.data());
+        std::size_t const nodes_offset =
+            sizeof(phylanx::ast::flat_ast::header) + h.data_count * 8;
+        std::size_t const children_offset = nodes_offset +
+            (h.node_count * sizeof(phylanx::ast::flat_ast::node) + 7) / 8 * 8;
+
+        auto* children = reinterpret_cast<std::uint32_t*>(
+            bytes.data() + children_offset);
+        children[h.root_first + 1] = children[h.root_first];
+
+        bool caught_exception = false;
+        try
+        {
+            phylanx::ast::flat_ast::from_buffer(std::move(bytes));
+        }
+        catch (hpx::exception const&)
+        {
+            caught_exception = true;
+        }
+        HPX_TEST(caught_exception);
+    }
+}
+
+void test_compile_flat_ast()
+{
+    phylanx::ast::flat_ast flat(phylanx::ast::generate_ast(R"(
+        define(fact, n, if(n <= 1, 1, n * fact(n - 1)))
+        fact(5)
+    )"));
+
+    phylanx::execution_tree::compiler::function_list snippets;
+    phylanx::execution_tree::compiler::environment env =
+        phylanx::execution_tree::compiler::default_environment();
+
+    auto const& f =
+        phylanx::execution_tree::compile("flat_ast", flat, snippets, env);
+
+    HPX_TEST_EQ(phylanx::execution_tree::extract_scalar_integer_value(f.run()),
+        std::int64_t(120));
+}
+
+int main(int argc, char* argv[])
+{
+    test_flat_ast();
+    test_invalid_flat_ast();
+    test_compile_flat_ast();
+
+    return hpx::util::report_errors();
+}
@@ -0,0 +1,170 @@
+//   Copyright (c) 2019 Hartmut Kaiser
+//
+//   Distributed under the Boost Software License, Version 1.0. (See accompanying
+//   file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <phylanx/phylanx.hpp>
+
+#include <hpx/hpx_main.hpp>
+#include <hpx/util/lightweight_test.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+///////////////////////////////////////////////////////////////////////////////
+// collect the line/column information of all tagged nodes
+using tags = std::vector<std::pair<std::int64_t, std::int64_t>>;
+
+void collect_tags(phylanx::ast::expression const& expr, tags& result);
+
+void collect_tags(phylanx::ast::tagged const& t, tags& result)
+{
+    if (t.col != -1)
+    {
+        result.emplace_back(t.id, t.col);
+    }
+}
+
+void collect_tags(phylanx::ast::operand const& op, tags& result)
+{
+    if (op.index() == 2)
+    {
+        auto const& ue = phylanx::util::get<2>(op.get()).get();
+        collect_tags(static_cast<phylanx::ast::tagged const&>(ue), result);
+        collect_tags(ue.operand_, result);
+        return;
+    }
+    if (op.index() != 1)
+    {
+        return;
+    }
+
+    auto const& pe = phylanx::util::get<1>(op.get()).get();
+    collect_tags(static_cast<phylanx::ast::tagged const&>(pe), result);
+
+    switch (pe.index())
+    {
+    case 3:     // identifier
+        collect_tags(phylanx::util::get<3>(pe.get()), result);
+        break;
+
+    case 6:     // expression
+        collect_tags(phylanx::util::get<6>(pe.get()).get(), result);
+        break;
+
+    case 7:     // function_call
+        {
+            auto const& fc = phylanx::util::get<7>(pe.get()).get();
+            collect_tags(fc.function_name, result);
+            for (auto const& arg : fc.args)
+            {
+                collect_tags(arg, result);
+            }
+        }
+        break;
+
+    case 8:     // list
+        for (auto const& expr : phylanx::util::get<8>(pe.get()).get())
+        {
+            collect_tags(expr, result);
+        }
+        break;
+
+    default:
+        break;
+    }
+}
+
+void collect_tags(phylanx::ast::expression const& expr, tags& result)
+{
+    collect_tags(expr.first, result);
+    for (auto const& op : expr.rest)
+    {
+        collect_tags(op.operand_, result);
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// the single-pass parser has to produce the same ASTs as the Spirit grammar
+void test_parser(std::string const& code)
+{
+    auto expected = phylanx::ast::generate_ast_qi(code);
+    auto exprs = phylanx::ast::generate_ast(code);
+
+    HPX_TEST_EQ(exprs.size(), expected.size());
+    for (std::size_t i = 0; i != exprs.size() && i != expected.size(); ++i)
+    {
+        HPX_TEST_EQ(exprs[i], expected[i]);
+        HPX_TEST_EQ(phylanx::ast::to_string(exprs[i], true),
+            phylanx::ast::to_string(expected[i], true));
+
+        tags expected_tags, actual_tags;
+        collect_tags(expected[i], expected_tags);
+        collect_tags(exprs[i], actual_tags);
+        HPX_TEST(actual_tags == expected_tags);
+    }
+}
+
+void test_parse_error(std::string const& code)
+{
+    bool caught_exception = false;
+    try
+    {
+        phylanx::ast::generate_ast(code);
+    }
+    catch (hpx::exception const&)
+    {
+        caught_exception = true;
+    }
+    HPX_TEST(caught_exception);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+int main(int argc, char* argv[])
+{
+    test_parser("A");
+    test_parser("A$1$2");
+    test_parser("A + B * C - -D");
+    test_parser("A <= B || !C && D != E % F");
+    test_parser("func{attribute}(A, B)");
+    test_parser("'(true, 1, '(1.0, A, A + B))");
+    test_parser("'()");
+    test_parser("1.0 / (1.0 + exp(-dot(A, B)))");
+    test_parser("-1 + +2.5e3 - .5 * 1.");
+    test_parser(R"("string\x20to\x200unescape\x3a\x20\n\r\t\"\'\x41")");
+    test_parser("[]");
+    test_parser("[1, 2, 3]");
+    test_parser("[1.0, -2, 3e2]");
+    test_parser("[[1, 2], [3, 4], [5, 6]]");
+    test_parser("[[1, -1, 0], [0, 1, 0.5], [0, 0, 1]]");
+#if defined(PHYLANX_HAVE_BLAZE_TENSOR)
+    test_parser("[[[1, 2], [3, 4]], [[5, 6.0], [7, 8]]]");
+#endif
+    test_parser("a b c(d)");
+
+    // comments and line breaks
+    test_parser(R"(
+        # bash-style comment
+        block(
+            define(x, 42),  // C++-style comment
+            /* multi-line
+               comment */ define(y, "multi-line
+string"),
+            x + y
+        )
+    )");
+    test_parser("f(x)\r\ng(y)\r\n");
+
+    test_parse_error("f(a, b");
+    test_parse_error("[1, 2,]");
+    test_parse_error("[[1, 2], [3]]");
+    test_parse_error("[1, [2]]");
+    test_parse_error("\"unterminated");
+    test_parse_error("a = b");
+    test_parse_error("A + ");
+
+    return hpx::util::report_errors();
+}
@@ -1,4 +1,4 @@
-//   Copyright (c) 2017-2018 Hartmut Kaiser
+//   Copyright (c) 2017-2019 Hartmut Kaiser
 //
 //   Distributed under the Boost Software License, Version 1.0. (See accompanying
 //   file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
@@ -8,9 +8,11 @@
 #include <hpx/hpx_main.hpp>
 #include <hpx/util/lightweight_test.hpp>
 
+#include <cstddef>
 #include <iostream>
 #include <string>
 #include <utility>
+#include <vector>
 
 void test_transform_ast(char const* matchstr, char const* rulestr,
     char const* replacestr, char const* expectedstr)
@@ -30,6 +32,75 @@ void test_transform_ast(char const* matchstr, char const* rulestr,
     HPX_TEST_EQ(result, expected);
 }
 
+///////////////////////////////////////////////////////////////////////////////
+phylanx::ast::rule_set make_rule_set(
+    std::vector<std::pair<char const*, char const*>> const& rules,
+    std::size_t max_rewrites = 10000)
+{
+    std::vector<phylanx::ast::transform_rule> result;
+    for (auto const& r : rules)
+    {
+        result.emplace_back(phylanx::ast::generate_ast(r.first)[0],
+            phylanx::ast::generate_ast(r.second)[0]);
+    }
+    return phylanx::ast::rule_set(std::move(result), max_rewrites);
+}
+
+void test_rule_set(char const* matchstr,
+    std::vector<std::pair<char const*, char const*>> const& rules,
+    char const* expectedstr)
+{
+    auto ast = phylanx::ast::generate_ast(matchstr);
+
+    auto r = make_rule_set(rules);
+    r.apply(ast);
+
+    std::cout << phylanx::ast::to_string(ast[0]) << '\n';
+
+    HPX_TEST_EQ(ast, phylanx::ast::generate_ast(expectedstr));
+}
+
+void test_rule_set_statistics()
+{
+    auto ast = phylanx::ast::generate_ast("f(A * B, C)");
+
+    auto r = make_rule_set(
+        {{"foo(_1)", "bar(_1)"}, {"_1 * _2", "add(_1, _2)"}});
+    HPX_TEST(r.apply(ast));
+    HPX_TEST_EQ(ast, phylanx::ast::generate_ast("f(add(A, B), C)"));
+
+    // only the rule sharing the operator of 'A * B' was tried
+    auto const& stats = r.statistics();
+    HPX_TEST_EQ(stats.match_attempts, std::size_t(1));
+    HPX_TEST_EQ(stats.rewrites, std::size_t(1));
+    HPX_TEST_EQ(stats.applications.size(), std::size_t(2));
+    HPX_TEST_EQ(stats.applications[0], std::size_t(0));
+    HPX_TEST_EQ(stats.applications[1], std::size_t(1));
+
+    // applying the rules again does not modify anything
+    r.reset_statistics();
+    HPX_TEST(!r.apply(ast));
+    HPX_TEST_EQ(r.statistics().rewrites, std::size_t(0));
+}
+
+void test_rule_set_nonterminating()
+{
+    auto ast = phylanx::ast::generate_ast("A * B");
+    auto r = make_rule_set({{"_1 * _2", "_2 * _1"}}, 100);
+
+    bool caught_exception = false;
+    try
+    {
+        r.apply(ast);
+    }
+    catch (hpx::exception const&)
+    {
+        caught_exception = true;
+    }
+    HPX_TEST(caught_exception);
+}
+
+///////////////////////////////////////////////////////////////////////////////
 int main(int argc, char* argv[])
 {
     // simple non-recursive transforms
@@ -61,6 +132,20 @@ int main(int argc, char* argv[])
     test_transform_ast("define(multiply, A, B, A * B)", "_1 * _2", "mul(_2, _1)",
         "define(multiply, A, B, mul(B, A))");
 
+    // rules are applied bottom-up until none of them matches anymore
+    test_rule_set("f(A * B, (C * D) * E)", {{"_1 * _2", "add(_1, _2)"}},
+        "f(add(A, B), add(add(C, D), E))");
+    test_rule_set("A * B",
+        {{"add(_1, _2)", "sum(_1, _2)"}, {"_1 * _2", "add(_1, _2)"}},
+        "sum(A, B)");
+    test_rule_set("f(-A, B)", {{"-_1", "neg(_1)"}}, "f(neg(A), B)");
+    test_rule_set("f(A, g(B))", {{"g(_1)", "_1"}, {"f(_1, _2)", "_1 + _2"}},
+        "A + B");
+    test_rule_set("f(A, B)", {{"h(_1)", "_1"}, {"f(_1, _2)", "g(_2)"}}, "g(B)");
+
+    test_rule_set_statistics();
+    test_rule_set_nonterminating();
+
     return hpx::util::report_errors();
 }
 
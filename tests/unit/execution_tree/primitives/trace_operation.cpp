@@ -0,0 +1,123 @@
+// Copyright (c) 2019 Hartmut Kaiser
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <phylanx/phylanx.hpp>
+#include <phylanx/util/tracer.hpp>
+
+#include <hpx/hpx_main.hpp>
+#include <hpx/util/lightweight_test.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <string>
+
+///////////////////////////////////////////////////////////////////////////////
+phylanx::execution_tree::primitive_argument_type compile_and_run(
+    std::string const& codestr)
+{
+    phylanx::execution_tree::compiler::function_list snippets;
+    phylanx::execution_tree::compiler::environment env =
+        phylanx::execution_tree::compiler::default_environment();
+
+    auto const& code = phylanx::execution_tree::compile(codestr, snippets, env);
+    return code.run();
+}
+
+std::string trace_data(std::size_t& count)
+{
+    std::ostringstream strm;
+    count = phylanx::util::write_trace(strm);
+    return strm.str();
+}
+
+///////////////////////////////////////////////////////////////////////////////
+void test_trace_events()
+{
+    compile_and_run(R"(block(
+        start_trace(),
+        define(x, [[1.0, 2.0, 3.0], [4.0, 5.0, 6.0]]),
+        define(y, x + x),
+        stop_trace(),
+        y
+    ))");
+
+    HPX_TEST(!phylanx::util::tracing_enabled());
+
+    std::size_t count = 0;
+    std::string const data = trace_data(count);
+
+    HPX_TEST_LT(std::size_t(0), count);
+    HPX_TEST_NEQ(data.find("\"traceEvents\""), std::string::npos);
+    HPX_TEST_NEQ(data.find("\"__add\""), std::string::npos);
+    HPX_TEST_NEQ(data.find("\"result\":\"[2, 3]\""), std::string::npos);
+    HPX_TEST_NEQ(data.find("\"result_bytes\":48"), std::string::npos);
+
+    // nothing is recorded while tracing is disabled
+    compile_and_run("[1.0, 2.0] * 2.0");
+
+    std::size_t new_count = 0;
+    trace_data(new_count);
+    HPX_TEST_EQ(count, new_count);
+}
+
+void test_restart_trace()
+{
+    compile_and_run(R"(block(
+        start_trace(),
+        define(x, [1.0, 2.0, 3.0]),
+        stop_trace(),
+        x * x
+    ))");
+
+    std::size_t count = 0;
+    trace_data(count);
+    HPX_TEST_LT(std::size_t(0), count);
+
+    // restarting the trace discards the events recorded so far
+    phylanx::util::start_trace();
+    phylanx::util::stop_trace();
+
+    trace_data(count);
+    HPX_TEST_EQ(count, std::size_t(0));
+    HPX_TEST_EQ(phylanx::util::dropped_trace_events(), std::uint64_t(0));
+}
+
+void test_dump_trace()
+{
+    std::string const filename = "trace_operation_test.json";
+
+    auto result = compile_and_run(R"(block(
+        start_trace(),
+        define(x, [1.0, 2.0, 3.0]),
+        define(y, exp(x)),
+        stop_trace(),
+        dump_trace(")" + filename + R"(")
+    ))");
+
+    HPX_TEST_LT(std::int64_t(0),
+        phylanx::execution_tree::extract_scalar_integer_value(result));
+
+    std::ifstream in(filename.c_str());
+    HPX_TEST(in.is_open());
+
+    std::stringstream strm;
+    strm << in.rdbuf();
+    HPX_TEST_NEQ(strm.str().find("\"exp\""), std::string::npos);
+
+    in.close();
+    std::remove(filename.c_str());
+}
+
+int main(int argc, char* argv[])
+{
+    test_trace_events();
+    test_restart_trace();
+    test_dump_trace();
+
+    return hpx::util::report_errors();
+}
@@ -0,0 +1,183 @@
+// Copyright (c) 2019 Hartmut Kaiser
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <phylanx/phylanx.hpp>
+
+#include <hpx/hpx_main.hpp>
+#include <hpx/util/lightweight_test.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <utility>
+
+#include <blaze/Math.h>
+
+///////////////////////////////////////////////////////////////////////////////
+char const* const code = R"(
+    define(f, a, b, a + b)
+)";
+
+void test_specialized_function()
+{
+    using namespace phylanx::execution_tree;
+
+    compiler::function_list snippets;
+    compiler::environment env = compiler::default_environment();
+    eval_context ctx;
+
+    auto f = compile_specialized(
+        "specialization", code, "f", snippets, env, ctx, 2);
+
+    HPX_TEST_EQ(f->num_variants(), std::size_t(0));
+
+    // scalar arguments create the first variant
+    {
+        primitive_arguments_type args{
+            primitive_argument_type{1.0}, primitive_argument_type{2.0}};
+        auto result = (*f)(std::move(args), ctx);
+        HPX_TEST_EQ(extract_scalar_numeric_value(result), 3.0);
+        HPX_TEST_EQ(f->num_variants(), std::size_t(1));
+    }
+
+    // same signature reuses the existing variant
+    {
+        primitive_arguments_type args{
+            primitive_argument_type{3.0}, primitive_argument_type{4.0}};
+        auto result = (*f)(std::move(args), ctx);
+        HPX_TEST_EQ(extract_scalar_numeric_value(result), 7.0);
+        HPX_TEST_EQ(f->num_variants(), std::size_t(1));
+        HPX_TEST_EQ(f->specialized_calls(), std::int64_t(2));
+    }
+
+    // a different dimensionality creates a second variant
+    {
+        blaze::DynamicVector<double> v{1.0, 2.0, 3.0};
+        primitive_arguments_type args{
+            primitive_argument_type{v}, primitive_argument_type{1.0}};
+        auto result = (*f)(std::move(args), ctx);
+        HPX_TEST_EQ(extract_numeric_value(result).vector(),
+            (blaze::DynamicVector<double>{2.0, 3.0, 4.0}));
+        HPX_TEST_EQ(f->num_variants(), std::size_t(2));
+    }
+
+    // different extents of the same dimensionality reuse the variant
+    {
+        blaze::DynamicVector<double> v{1.0, 2.0, 3.0, 4.0, 5.0};
+        primitive_arguments_type args{
+            primitive_argument_type{v}, primitive_argument_type{2.0}};
+        auto result = (*f)(std::move(args), ctx);
+        HPX_TEST_EQ(extract_numeric_value(result).vector(),
+            (blaze::DynamicVector<double>{3.0, 4.0, 5.0, 6.0, 7.0}));
+        HPX_TEST_EQ(f->num_variants(), std::size_t(2));
+        HPX_TEST_EQ(f->specialized_calls(), std::int64_t(4));
+    }
+
+    // maximum number of variants reached, fall back to generic function
+    {
+        primitive_arguments_type args{primitive_argument_type{std::int64_t(1)},
+            primitive_argument_type{std::int64_t(2)}};
+        auto result = (*f)(std::move(args), ctx);
+        HPX_TEST_EQ(extract_scalar_integer_value(result), std::int64_t(3));
+        HPX_TEST_EQ(f->num_variants(), std::size_t(2));
+        HPX_TEST_EQ(f->generic_calls(), std::int64_t(1));
+    }
+}
+
+// the variants are compiled knowing the types of their arguments
+void test_typed_variants()
+{
+    using namespace phylanx::execution_tree;
+
+    compiler::function_list snippets;
+    compiler::environment env = compiler::default_environment();
+    eval_context ctx;
+
+    auto f = compile_specialized(
+        "specialization", code, "f", snippets, env, ctx);
+
+    auto compiled_code = [&]() -> std::string {
+        return newick_tree(
+            "specialization", snippets.program_.get_expression_topology());
+    };
+
+    // the generic function determines the dtype at runtime
+    HPX_TEST(compiled_code().find("/phylanx/__add$") != std::string::npos);
+    HPX_TEST(compiled_code().find("/phylanx/__add__") == std::string::npos);
+
+    {
+        blaze::DynamicVector<std::int64_t> v{1, 2, 3};
+        primitive_arguments_type args{
+            primitive_argument_type{v}, primitive_argument_type{v}};
+        auto result = (*f)(std::move(args), ctx);
+        HPX_TEST_EQ(extract_integer_value(result).vector(),
+            (blaze::DynamicVector<std::int64_t>{2, 4, 6}));
+        HPX_TEST(compiled_code().find("/phylanx/__add__int$") !=
+            std::string::npos);
+    }
+
+    {
+        blaze::DynamicVector<double> v{1.0, 2.0, 3.0};
+        primitive_arguments_type args{primitive_argument_type{v},
+            primitive_argument_type{std::int64_t(1)}};
+        auto result = (*f)(std::move(args), ctx);
+        HPX_TEST_EQ(extract_numeric_value(result).vector(),
+            (blaze::DynamicVector<double>{2.0, 3.0, 4.0}));
+        HPX_TEST(compiled_code().find("/phylanx/__add__float$") !=
+            std::string::npos);
+    }
+
+    HPX_TEST_EQ(f->num_variants(), std::size_t(2));
+}
+
+void test_argument_signature()
+{
+    using namespace phylanx::execution_tree;
+
+    compiler::argument_signature sig1, sig2;
+
+    HPX_TEST(compiler::extract_argument_signature(
+        primitive_arguments_type{primitive_argument_type{1.0}}, sig1));
+    HPX_TEST(compiler::extract_argument_signature(
+        primitive_arguments_type{primitive_argument_type{2.0}}, sig2));
+    HPX_TEST(sig1 == sig2);
+
+    // the extents are not part of the signature
+    HPX_TEST(compiler::extract_argument_signature(
+        primitive_arguments_type{
+            primitive_argument_type{blaze::DynamicVector<double>(3)}},
+        sig1));
+    HPX_TEST(compiler::extract_argument_signature(
+        primitive_arguments_type{
+            primitive_argument_type{blaze::DynamicVector<double>(5)}},
+        sig2));
+    HPX_TEST(sig1 == sig2);
+
+    HPX_TEST(compiler::extract_argument_signature(
+        primitive_arguments_type{primitive_argument_type{std::int64_t(2)}},
+        sig2));
+    HPX_TEST(!(sig1 == sig2));
+
+    // strings can't be specialized on
+    HPX_TEST(!compiler::extract_argument_signature(
+        primitive_arguments_type{primitive_argument_type{std::string("a")}},
+        sig2));
+
+    // neither can too many arguments
+    HPX_TEST(!compiler::extract_argument_signature(
+        primitive_arguments_type(
+            compiler::argument_signature::max_arguments + 1,
+            primitive_argument_type{1.0}),
+        sig2));
+}
+
+int main(int argc, char* argv[])
+{
+    test_argument_signature();
+    test_specialized_function();
+    test_typed_variants();
+
+    return hpx::util::report_errors();
+}
@@ -0,0 +1,272 @@
+// Copyright (c) 2019 Hartmut Kaiser
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <phylanx/phylanx.hpp>
+
+#include <hpx/hpx_main.hpp>
+#include <hpx/util/lightweight_test.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <string>
+#include <vector>
+
+#include <blaze/Math.h>
+
+using phylanx::execution_tree::compiler::inferred_type;
+using phylanx::execution_tree::compiler::type_inference;
+
+///////////////////////////////////////////////////////////////////////////////
+inferred_type make_type(phylanx::execution_tree::node_data_type dtype,
+    std::initializer_list<std::int64_t> dims)
+{
+    inferred_type result(dtype, std::int64_t(dims.size()));
+    std::size_t i = 0;
+    for (std::int64_t dim : dims)
+    {
+        result.dims[i++] = dim;
+    }
+    return result;
+}
+
+inferred_type infer(type_inference& types, std::string const& code)
+{
+    auto exprs = phylanx::ast::generate_ast(code);
+    types.prescan(exprs);
+
+    inferred_type result;
+    for (auto const& expr : exprs)
+    {
+        result = types.infer("type_inference", expr, 0);
+    }
+    return result;
+}
+
+bool infer_throws(type_inference& types, std::string const& code)
+{
+    try
+    {
+        infer(types, code);
+    }
+    catch (hpx::exception const&)
+    {
+        return true;
+    }
+    return false;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+void test_literals()
+{
+    using namespace phylanx::execution_tree;
+
+    type_inference types;
+
+    HPX_TEST_EQ(infer(types, "42"), make_type(node_data_type_int64, {}));
+    HPX_TEST_EQ(infer(types, "[1.0, 2.0]"),
+        make_type(node_data_type_double, {2}));
+    HPX_TEST_EQ(infer(types, "[[1, 2, 3], [4, 5, 6]] + [1.0, 2.0, 3.0]"),
+        make_type(node_data_type_double, {2, 3}));
+    HPX_TEST_EQ(infer(types, "[1, 2] < 3"),
+        make_type(node_data_type_bool, {2}));
+    HPX_TEST_EQ(infer(types, "-[[1, 2]]"),
+        make_type(node_data_type_int64, {1, 2}));
+    HPX_TEST(infer(types, "\"string\"").is_unknown());
+}
+
+void test_builtins()
+{
+    using namespace phylanx::execution_tree;
+
+    type_inference types;
+
+    HPX_TEST_EQ(infer(types, "constant__int(0, list(2, 3))"),
+        make_type(node_data_type_int64, {2, 3}));
+    HPX_TEST_EQ(infer(types, "constant(1.0, 4)"),
+        make_type(node_data_type_double, {4}));
+    HPX_TEST_EQ(infer(types, "random(list(3, 4))"),
+        make_type(node_data_type_double, {3, 4}));
+    HPX_TEST_EQ(infer(types, "transpose(random(list(3, 4)))"),
+        make_type(node_data_type_double, {4, 3}));
+    HPX_TEST_EQ(infer(types, "dot(random(list(3, 4)), [1, 2, 3, 4])"),
+        make_type(node_data_type_double, {3}));
+    HPX_TEST_EQ(infer(types, "if(true, [1, 2], [3, 4])"),
+        make_type(node_data_type_int64, {2}));
+
+    // the shape is known, the dtype is not
+    inferred_type t = infer(types, "if(true, [1, 2], [3.0, 4.0])");
+    HPX_TEST(!t.has_dtype());
+    HPX_TEST(t.has_shape());
+}
+
+void test_variables()
+{
+    using namespace phylanx::execution_tree;
+
+    type_inference types;
+
+    // the dtype of global variables is not assumed to be known
+    inferred_type t = infer(types, R"(
+            define(x, constant__int(0, list(2, 3)))
+            block(define(y, random(3)), dot(x, y))
+        )");
+    HPX_TEST(!t.has_dtype());
+    HPX_TEST_EQ(t.ndim, std::int64_t(1));
+    HPX_TEST_EQ(t.dims[0], std::int64_t(2));
+
+    // variables modified by store() have no known type
+    HPX_TEST(!infer_throws(types, R"(
+            define(z, [1, 2])
+            store(z, [1, 2, 3])
+            z + [1, 2, 3]
+        )"));
+
+    // function arguments are unknown unless annotated
+    HPX_TEST(!infer_throws(types, "define(f, a, b, a + b)"));
+
+    types.annotate("f",
+        {make_type(node_data_type_double, {3}),
+            make_type(node_data_type_double, {4})});
+    HPX_TEST(infer_throws(types, "define(f, a, b, a + b)"));
+
+    types.clear_annotations();
+    HPX_TEST(!infer_throws(types, "define(f, a, b, a + b)"));
+}
+
+// the store() targets are collected from the flat encoding without
+// expanding it
+void test_flat_prescan()
+{
+    auto exprs = phylanx::ast::generate_ast(R"(
+            define(z, [1, 2])
+            z + [1, 2, 3]
+            block(store(z, [1, 2, 3]))
+        )");
+
+    auto infer_all = [&](type_inference& types) {
+        try
+        {
+            for (auto const& expr : exprs)
+            {
+                types.infer("type_inference", expr, 0);
+            }
+        }
+        catch (hpx::exception const&)
+        {
+            return false;
+        }
+        return true;
+    };
+
+    // without the prescan the store() is seen only after z was used
+    {
+        type_inference types;
+        HPX_TEST(!infer_all(types));
+    }
+
+    {
+        type_inference types;
+        types.prescan(phylanx::ast::flat_ast(exprs));
+        HPX_TEST(infer_all(types));
+    }
+}
+
+void test_mismatches()
+{
+    type_inference types;
+
+    HPX_TEST(infer_throws(types, "[1, 2] + [1, 2, 3]"));
+    HPX_TEST(infer_throws(types, "[[1, 2], [3, 4]] * [1, 2, 3]"));
+    HPX_TEST(infer_throws(types, "dot(random(list(2, 3)), random(2))"));
+    HPX_TEST(infer_throws(types, "__sub(random(4), [1, 2])"));
+
+    // broadcasting
+    HPX_TEST(!infer_throws(types, "[[1, 2, 3]] + [[1], [2]]"));
+    HPX_TEST(!infer_throws(types, "random(list(2, 3)) + 1"));
+
+    // mismatches are reported by the compiler, before any execution
+    phylanx::execution_tree::compiler::function_list snippets;
+    phylanx::execution_tree::compiler::environment env =
+        phylanx::execution_tree::compiler::default_environment();
+
+    bool caught_exception = false;
+    try
+    {
+        phylanx::execution_tree::compile(
+            "type_inference", "[1, 2] + [1, 2, 3]", snippets, env);
+    }
+    catch (hpx::exception const&)
+    {
+        caught_exception = true;
+    }
+    HPX_TEST(caught_exception);
+}
+
+void test_operation_dtypes()
+{
+    using namespace phylanx::execution_tree;
+
+    type_inference types;
+
+    auto exprs = phylanx::ast::generate_ast("[1.0, 2.0] + [3, 4]");
+    types.infer("operation_dtypes", exprs[0], 42);
+
+    phylanx::ast::tagged id = phylanx::ast::detail::tagged_id(exprs[0]);
+    HPX_TEST_EQ(types.operation_dtype(42, id, "__add"),
+        node_data_type_double);
+
+    // nothing is known for other compile ids or operations
+    HPX_TEST_EQ(types.operation_dtype(43, id, "__add"),
+        node_data_type_unknown);
+    HPX_TEST_EQ(types.operation_dtype(42, id, "__sub"),
+        node_data_type_unknown);
+
+    // integer divisions are left to the runtime
+    exprs = phylanx::ast::generate_ast("[1, 2] / [3, 4]");
+    types.infer("operation_dtypes", exprs[0], 44);
+
+    id = phylanx::ast::detail::tagged_id(exprs[0]);
+    HPX_TEST_EQ(types.operation_dtype(44, id, "__div"),
+        node_data_type_unknown);
+
+    // the typed operations selected by the compiler produce the same
+    // results as the generic ones
+    compiler::function_list snippets;
+    auto const& f = compile("operation_dtypes", R"(
+            define(f, n, block(
+                define(x, constant(1.0, list(2, 2))),
+                define(y, [[1, 2], [3, 4]]),
+                list(x + [1.0, 2.0], -(y * 2), y - 1, x / n)
+            ))
+            f(2)
+        )", snippets);
+
+    primitive_argument_type value = f.run();
+    auto result = extract_list_value(value);
+    auto it = result.begin();
+
+    HPX_TEST_EQ(extract_numeric_value(*it++).matrix(),
+        (blaze::DynamicMatrix<double>{{2.0, 3.0}, {2.0, 3.0}}));
+    HPX_TEST(is_integer_operand_strict(*it));
+    HPX_TEST_EQ(extract_integer_value(*it++).matrix(),
+        (blaze::DynamicMatrix<std::int64_t>{{-2, -4}, {-6, -8}}));
+    HPX_TEST_EQ(extract_integer_value(*it++).matrix(),
+        (blaze::DynamicMatrix<std::int64_t>{{0, 1}, {2, 3}}));
+    HPX_TEST_EQ(extract_numeric_value(*it++).matrix(),
+        (blaze::DynamicMatrix<double>{{0.5, 0.5}, {0.5, 0.5}}));
+}
+
+int main(int argc, char* argv[])
+{
+    test_literals();
+    test_builtins();
+    test_variables();
+    test_flat_prescan();
+    test_mismatches();
+    test_operation_dtypes();
+
+    return hpx::util::report_errors();
+}
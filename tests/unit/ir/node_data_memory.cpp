@@ -0,0 +1,135 @@
+//  Copyright (c) 2019 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <phylanx/phylanx.hpp>
+
+#include <hpx/hpx_main.hpp>
+#include <hpx/util/lightweight_test.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <string>
+#include <utility>
+
+#include <blaze/Math.h>
+
+using node_data = phylanx::ir::node_data<double>;
+
+///////////////////////////////////////////////////////////////////////////////
+void test_node_data_memory()
+{
+    bool const enabled = node_data::enable_memory_accounting(true);
+
+    std::int64_t const allocated = node_data::allocated_bytes(false);
+    std::int64_t const deep_copies = node_data::deep_copy_count(false);
+
+    {
+        node_data v(blaze::DynamicVector<double>(1000, 1.0));
+        std::int64_t const bytes = v.owned_bytes();
+
+        HPX_TEST_LTE(std::int64_t(1000 * sizeof(double)), bytes);
+        HPX_TEST_EQ(node_data::allocated_bytes(false), allocated + bytes);
+        HPX_TEST_EQ(node_data::deep_copy_count(false), deep_copies);
+
+        // references don't own any storage
+        node_data r = v.ref();
+        HPX_TEST_EQ(r.owned_bytes(), std::int64_t(0));
+        HPX_TEST_EQ(node_data::allocated_bytes(false), allocated + bytes);
+
+        // copies of the storage are accounted for as deep copies
+        {
+            node_data c(v);
+            HPX_TEST_EQ(node_data::allocated_bytes(false),
+                allocated + bytes + c.owned_bytes());
+            HPX_TEST_EQ(node_data::deep_copy_count(false), deep_copies + 1);
+            HPX_TEST_LTE(node_data::allocated_bytes(false),
+                node_data::allocated_bytes_high_water(false));
+        }
+        HPX_TEST_EQ(node_data::allocated_bytes(false), allocated + bytes);
+
+        // moving the storage doesn't change the accounted size
+        node_data m(std::move(v));
+        HPX_TEST_EQ(node_data::allocated_bytes(false), allocated + bytes);
+
+        // replacing the storage releases it
+        m = 42.0;
+        HPX_TEST_EQ(node_data::allocated_bytes(false), allocated);
+    }
+
+    HPX_TEST_EQ(node_data::allocated_bytes(false), allocated);
+
+    // resetting the high water mark restarts it at the current allocation
+    node_data::allocated_bytes_high_water(true);
+    HPX_TEST_EQ(node_data::allocated_bytes_high_water(false),
+        node_data::allocated_bytes(false));
+
+    node_data::enable_memory_accounting(enabled);
+}
+
+void test_disabled_accounting()
+{
+    bool const enabled = node_data::enable_memory_accounting(true);
+
+    node_data tracked(blaze::DynamicVector<double>(1000, 1.0));
+    std::int64_t const bytes = tracked.owned_bytes();
+    std::int64_t const allocated = node_data::allocated_bytes(false);
+
+    node_data::enable_memory_accounting(false);
+    {
+        // storage allocated while the accounting is disabled is ignored
+        node_data v(blaze::DynamicVector<double>(1000, 1.0));
+        node_data c(v);
+        HPX_TEST_EQ(node_data::allocated_bytes(false), allocated);
+    }
+    HPX_TEST_EQ(node_data::allocated_bytes(false), allocated);
+
+    // storage accounted for before is still released
+    tracked = 42.0;
+    HPX_TEST_EQ(node_data::allocated_bytes(false), allocated - bytes);
+
+    node_data::enable_memory_accounting(enabled);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+char const* const code = R"(block(
+    define(x, constant(1.0, 1000)),
+    x
+))";
+
+void test_variable_memory()
+{
+    phylanx::execution_tree::compiler::function_list snippets;
+
+    auto const& f = phylanx::execution_tree::compile(code, snippets);
+    auto x = f.run()();
+
+    bool found = false;
+    for (auto const& instance : phylanx::util::retrieve_memory_usage())
+    {
+        phylanx::execution_tree::compiler::primitive_name_parts parts;
+        if (phylanx::execution_tree::compiler::parse_primitive_name(
+                instance.first, parts) &&
+            parts.primitive == "variable" && parts.instance == "x")
+        {
+            HPX_TEST_LTE(std::int64_t(1000 * sizeof(double)), instance.second);
+            found = true;
+        }
+    }
+    HPX_TEST(found);
+
+    auto memory = phylanx::util::retrieve_node_data_memory();
+    HPX_TEST_EQ(memory.size(), std::size_t(3));
+    HPX_TEST_LTE(memory["double"][0], memory["double"][1]);
+}
+
+int main()
+{
+    test_node_data_memory();
+    test_disabled_accounting();
+    test_variable_memory();
+
+    return hpx::util::report_errors();
+}
@@ -0,0 +1,111 @@
+//  Copyright (c) 2019 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <phylanx/phylanx.hpp>
+#include <phylanx/execution_tree/primitives/primitive_registry.hpp>
+
+#include <hpx/hpx_main.hpp>
+#include <hpx/include/performance_counters.hpp>
+#include <hpx/util/lightweight_test.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <numeric>
+#include <string>
+#include <vector>
+
+#include <blaze/Math.h>
+
+///////////////////////////////////////////////////////////////////////////////
+char const* const code = R"(block(
+    define(f, x,
+        block(
+            define(step, 0),
+            define(y, x),
+            while(
+                step < 10,
+                block(
+                    store(y, y + x),
+                    store(step, step + 1)
+                )
+            ),
+            y
+        )
+    ),
+    f
+))";
+
+// index of the values returned for each primitive type
+enum statistics_index
+{
+    instances,
+    eval_count,
+    eval_duration,
+    min_duration,
+    max_duration,
+    result_bytes,
+    histogram
+};
+
+void test_statistics(std::vector<std::int64_t> const& values,
+    std::int64_t expected_instances, std::int64_t expected_count)
+{
+    HPX_TEST_EQ(values.size(),
+        std::size_t(histogram) +
+            phylanx::execution_tree::primitives::primitive_duration_buckets);
+
+    HPX_TEST_EQ(values[instances], expected_instances);
+    HPX_TEST_EQ(values[eval_count], expected_count);
+    HPX_TEST_LTE(values[min_duration], values[max_duration]);
+    HPX_TEST_LTE(values[max_duration], values[eval_duration]);
+
+    // every evaluation was counted in the histogram
+    HPX_TEST_EQ(std::accumulate(values.begin() + histogram, values.end(),
+                    std::int64_t(0)),
+        expected_count);
+}
+
+int main()
+{
+    phylanx::execution_tree::compiler::function_list snippets;
+
+    auto const& f = phylanx::execution_tree::compile(code, snippets);
+    auto func = f.run();
+
+    // enable the collection of the statistics for all primitive types
+    phylanx::util::enable_measurements();
+
+    auto x = phylanx::ir::node_data<double>{
+        blaze::DynamicVector<double>(100, 1.0)};
+    auto const result = func(x);
+
+    std::map<std::string, std::vector<std::int64_t>> statistics =
+        phylanx::util::retrieve_primitive_statistics();
+
+    // y + x and step + 1 were evaluated 10 times each, y + x producing 100
+    // doubles
+    HPX_TEST(statistics.find("__add") != statistics.end());
+    test_statistics(statistics["__add"], 2, 20);
+    HPX_TEST_LTE(std::int64_t(10 * 100 * sizeof(double)),
+        statistics["__add"][result_bytes]);
+
+    HPX_TEST(statistics.find("while") != statistics.end());
+    test_statistics(statistics["while"], 1, 1);
+
+    // the same data is exposed through the statistics performance counter
+    hpx::performance_counters::performance_counter counter(
+        "/phylanx{locality#0/total}/primitives/__lt/statistics");
+
+    auto const values =
+        counter.get_counter_values_array(hpx::launch::sync, true);
+    test_statistics(values.values_, 1, 11);
+
+    // the counter was reset
+    statistics = phylanx::util::retrieve_primitive_statistics();
+    test_statistics(statistics["__lt"], 1, 0);
+
+    return hpx::util::report_errors();
+}
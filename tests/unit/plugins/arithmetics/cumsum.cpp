@@ -217,11 +217,56 @@ void test_cumsum_3d()
 }
 #endif
 
+// inputs large enough to be scanned in parallel
+void test_cumsum_large()
+{
+    {
+        auto result = phylanx::execution_tree::extract_numeric_value(
+            compile_and_run("cumsum(constant(1, 100000))"));
+
+        HPX_TEST_EQ(result.size(), std::size_t(100000));
+        auto v = result.vector();
+        for (std::size_t i = 0; i != v.size(); ++i)
+        {
+            HPX_TEST_EQ(v[i], double(i + 1));
+        }
+    }
+
+    {
+        auto result = phylanx::execution_tree::extract_numeric_value(
+            compile_and_run("cumsum(constant(1, list(300, 400)))"));
+
+        HPX_TEST_EQ(result.size(), std::size_t(120000));
+        auto v = result.vector();
+        for (std::size_t i = 0; i != v.size(); ++i)
+        {
+            HPX_TEST_EQ(v[i], double(i + 1));
+        }
+    }
+
+    {
+        auto result = phylanx::execution_tree::extract_numeric_value(
+            compile_and_run("cumsum(constant(1, list(300, 400)), 0)"));
+
+        auto m = result.matrix();
+        HPX_TEST_EQ(m.rows(), std::size_t(300));
+        HPX_TEST_EQ(m.columns(), std::size_t(400));
+        for (std::size_t i = 0; i != m.rows(); ++i)
+        {
+            for (std::size_t j = 0; j != m.columns(); ++j)
+            {
+                HPX_TEST_EQ(m(i, j), double(i + 1));
+            }
+        }
+    }
+}
+
 int main(int argc, char* argv[])
 {
     test_cumsum_0d();
     test_cumsum_1d();
     test_cumsum_2d();
+    test_cumsum_large();
 
 #if defined(PHYLANX_HAVE_BLAZE_TENSOR)
     test_cumsum_3d();
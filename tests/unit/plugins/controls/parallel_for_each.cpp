@@ -0,0 +1,100 @@
+//   Copyright (c) 2019 Hartmut Kaiser
+//
+//   Distributed under the Boost Software License, Version 1.0. (See accompanying
+//   file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <phylanx/phylanx.hpp>
+
+#include <hpx/hpx_main.hpp>
+#include <hpx/util/lightweight_test.hpp>
+
+#include <cstdint>
+#include <string>
+
+///////////////////////////////////////////////////////////////////////////////
+phylanx::execution_tree::primitive_argument_type compile_and_run(
+    std::string const& codestr)
+{
+    phylanx::execution_tree::compiler::function_list snippets;
+    phylanx::execution_tree::compiler::environment env =
+        phylanx::execution_tree::compiler::default_environment();
+
+    auto const& code = phylanx::execution_tree::compile(codestr, snippets, env);
+    return code.run();
+}
+
+void test_parallel_operation(std::string const& code,
+    std::string const& expected_str)
+{
+    HPX_TEST_EQ(compile_and_run(code), compile_and_run(expected_str));
+}
+
+///////////////////////////////////////////////////////////////////////////////
+void test_parallel_for_each()
+{
+    std::string const code = R"(block(
+            define(a, [0.0, 0.0, 0.0, 0.0, 0.0]),
+            parallel_for_each(
+                lambda(i, store(slice(a, list(i, i + 1, 1), nil), [2.0 * i])),
+                range(5)),
+            a
+        ))";
+
+    test_parallel_operation(code, "[0.0, 2.0, 4.0, 6.0, 8.0]");
+
+    // iterating over a list, specifying the schedule
+    std::string const code_static = R"(block(
+            define(a, [0.0, 0.0, 0.0, 0.0, 0.0]),
+            parallel_for_each(
+                lambda(i, store(slice(a, list(i, i + 1, 1), nil), [1.0])),
+                list(0, 2, 4), "static", 1),
+            a
+        ))";
+
+    test_parallel_operation(code_static, "[1.0, 0.0, 1.0, 0.0, 1.0]");
+
+    test_parallel_operation(
+        "parallel_for_each(lambda(i, i), range(100), \"guided\")",
+        "nil");
+}
+
+void test_parallel_reduce()
+{
+    test_parallel_operation(
+        "parallel_reduce(lambda(x, x * x), range(4), lambda(a, b, a + b))",
+        "14");
+
+    test_parallel_operation(
+        "parallel_reduce(lambda(x, x), range(1000), lambda(a, b, a + b), 42)",
+        "499542");
+
+    test_parallel_operation(
+        R"(parallel_reduce(lambda(x, x), range(1, 1001),
+            lambda(a, b, maximum(a, b)), nil, "dynamic", 10))",
+        "1000");
+
+    // the initial value is returned for empty ranges
+    test_parallel_operation(
+        "parallel_reduce(lambda(x, x), list(), lambda(a, b, a + b), 1)",
+        "1");
+}
+
+void test_parallel_map()
+{
+    std::string const code = R"(
+            parallel_reduce(lambda(x, x),
+                parallel_map(lambda(x, 2 * x), range(10000)),
+                lambda(a, b, a + b))
+        )";
+
+    test_parallel_operation(code, "99990000");
+}
+
+int main(int argc, char* argv[])
+{
+    test_parallel_for_each();
+    test_parallel_reduce();
+    test_parallel_map();
+
+    return hpx::util::report_errors();
+}
@@ -0,0 +1,130 @@
+//   Copyright (c) 2019 Hartmut Kaiser
+//
+//   Distributed under the Boost Software License, Version 1.0. (See accompanying
+//   file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <phylanx/phylanx.hpp>
+
+#include <hpx/hpx_main.hpp>
+#include <hpx/util/lightweight_test.hpp>
+
+#include <cstdint>
+#include <string>
+
+#include <blaze/Math.h>
+
+///////////////////////////////////////////////////////////////////////////////
+phylanx::execution_tree::primitive_argument_type compile_and_run(
+    std::string const& codestr)
+{
+    phylanx::execution_tree::compiler::function_list snippets;
+    phylanx::execution_tree::compiler::environment env =
+        phylanx::execution_tree::compiler::default_environment();
+
+    auto const& code = phylanx::execution_tree::compile(codestr, snippets, env);
+    return code.run();
+}
+
+void test_vmap_operation(std::string const& code,
+    std::string const& expected_str)
+{
+    HPX_TEST_EQ(compile_and_run(code), compile_and_run(expected_str));
+}
+
+///////////////////////////////////////////////////////////////////////////////
+void test_vmap_1d()
+{
+    // element-wise lambda, will be lifted
+    test_vmap_operation(
+        "vmap(lambda(x, x * x + 1), [1, 2, 3])",
+        "[2, 5, 10]");
+
+    test_vmap_operation(
+        "vmap(lambda(x, exp(x) - x), [1.0, 2.0, 3.0])",
+        "exp([1.0, 2.0, 3.0]) - [1.0, 2.0, 3.0]");
+
+    // explicitly disable lifting
+    test_vmap_operation(
+        "vmap(lambda(x, x * x + 1), [1, 2, 3], false)",
+        "[2, 5, 10]");
+
+    // not liftable, evaluated per element
+    test_vmap_operation(
+        "vmap(lambda(x, if(x > 1, x, 0)), [1, 2, 3])",
+        "[0, 2, 3]");
+
+    test_vmap_operation(
+        "vmap(lambda(x, if(x, 1.0, 2.0)), [true, false, true])",
+        "[1.0, 2.0, 1.0]");
+
+    // the result type follows the results of the function
+    test_vmap_operation(
+        "vmap(lambda(x, x / 2.0), [1, 2, 3], false)",
+        "[0.5, 1.0, 1.5]");
+
+    test_vmap_operation(
+        "vmap(lambda(x, sqrt(x)), [1, 4, 9], false)",
+        "[1.0, 2.0, 3.0]");
+
+    test_vmap_operation(
+        "vmap(lambda(x, x > 1), [1.0, 2.0, 3.0], false)",
+        "[false, true, true]");
+}
+
+void test_vmap_2d()
+{
+    // element-wise lambda, will be lifted
+    test_vmap_operation(
+        "vmap(lambda(x, 2 * x), [[1, 2], [3, 4]])",
+        "[[2, 4], [6, 8]]");
+
+    // reduction of each row
+    test_vmap_operation(
+        "vmap(lambda(x, sum(x)), [[1, 2], [3, 4], [5, 6]])",
+        "[3, 7, 11]");
+
+    test_vmap_operation(
+        "vmap(lambda(x, sum(x)), [[1.0, 2.0], [3.0, 4.0]])",
+        "[3.0, 7.0]");
+
+    // each row is mapped onto a vector
+    test_vmap_operation(
+        "vmap(lambda(x, slice(x, list(0, 1))), [[1, 2, 3], [4, 5, 6]])",
+        "[[1], [4]]");
+
+    test_vmap_operation(
+        "vmap(lambda(x, x + 1), [[1, 2], [3, 4]], false)",
+        "[[2, 3], [4, 5]]");
+
+    test_vmap_operation(
+        "vmap(lambda(x, sum(x) / 2.0), [[1, 2], [3, 4]])",
+        "[1.5, 3.5]");
+
+    test_vmap_operation(
+        "vmap(lambda(x, x * 0.5), [[1, 2], [3, 4]], false)",
+        "[[0.5, 1.0], [1.5, 2.0]]");
+}
+
+void test_vmap_func()
+{
+    test_vmap_operation(R"(block(
+            define(f, x, x + 1),
+            vmap(f, [1, 2, 3])
+        ))",
+        "[2, 3, 4]");
+
+    test_vmap_operation(R"(block(
+            define(f, x, x + 1),
+            vmap(f, [1, 2, 3], true)
+        ))",
+        "[2, 3, 4]");
+}
+
+int main(int argc, char* argv[])
+{
+    test_vmap_1d();
+    test_vmap_2d();
+    test_vmap_func();
+
+    return hpx::util::report_errors();
+}
@@ -47,7 +47,22 @@ int main(int argc, char* argv[])
         "batch_dot([[1, 2], [3, 4]], [[-5,-6],[ 7, 8]], make_list(1, 1))",
         "[[-17],[53]]");
 
+    // large batches are processed in parallel
+    test_batch_dot_operation(
+        "batch_dot(constant(1, make_list(4096, 16)), "
+        "constant(2, make_list(4096, 16)))",
+        "constant(32, make_list(4096, 1))");
+
 #if defined(PHYLANX_HAVE_BLAZE_TENSOR)
+    test_batch_dot_operation(
+        "batch_dot(constant(1, make_list(1024, 8, 8)), "
+        "constant(2, make_list(1024, 8, 8)))",
+        "constant(16, make_list(1024, 8, 8))");
+    test_batch_dot_operation(
+        "batch_dot(constant(1, make_list(1024, 8, 5)), "
+        "constant(2, make_list(1024, 8, 3)), make_list(1, 1))",
+        "constant(16, make_list(1024, 5, 3))");
+
     test_batch_dot_operation(
         "batch_dot([[1, 2, 3], [4, 5, 6]], [[[-5,-6, 1, 0],[-7,-8, 1, 0]"
         ",[-1,-2, 13, 2]],[[ 5, 6,-1, 5],[7, 1, 0, 8],[1, 1,-2, 2]]])",
@@ -0,0 +1,151 @@
+// Copyright (c) 2019 Hartmut Kaiser
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <phylanx/phylanx.hpp>
+
+#include <hpx/hpx_main.hpp>
+#include <hpx/include/lcos.hpp>
+#include <hpx/util/lightweight_test.hpp>
+
+#include <exception>
+#include <string>
+
+///////////////////////////////////////////////////////////////////////////////
+phylanx::execution_tree::primitive_argument_type compile_and_run(
+    std::string const& codestr)
+{
+    phylanx::execution_tree::compiler::function_list snippets;
+    phylanx::execution_tree::compiler::environment env =
+        phylanx::execution_tree::compiler::default_environment();
+
+    auto const& code = phylanx::execution_tree::compile(codestr, snippets, env);
+    return code.run();
+}
+
+void test_conv(std::string const& code, std::string const& expectedstr)
+{
+    HPX_TEST_EQ(compile_and_run(code), compile_and_run(expectedstr));
+}
+
+void test_conv_throws(std::string const& code)
+{
+    bool exception_thrown = false;
+    try
+    {
+        compile_and_run(code);
+    }
+    catch (std::exception const&)
+    {
+        exception_thrown = true;
+    }
+    HPX_TEST(exception_thrown);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+void test_conv1d_vector()
+{
+    test_conv("conv1d([1, 2, 3, 4, 5], [1, 0, -1])", "[-2., -2., -2.]");
+    test_conv(R"(conv1d([1, 2, 3, 4, 5], [1, 0, -1], 1, "valid"))",
+        "[-2., -2., -2.]");
+    test_conv(R"(conv1d([1, 2, 3, 4, 5], [1, 0, -1], 1, "same"))",
+        "[-2., -2., -2., -2., 4.]");
+    test_conv(R"(conv1d([1, 2, 3, 4, 5], [1, 0, -1], 1, "causal"))",
+        "[-1., -2., -2., -2., -2.]");
+
+    // strided and dilated convolutions
+    test_conv("conv1d([1, 2, 3, 4, 5], [1, 0, -1], 2)", "[-2., -2.]");
+    test_conv(R"(conv1d([1, 2, 3, 4, 5], [1, 0, -1], 2, "same"))",
+        "[-2., -2., 4.]");
+    test_conv(R"(conv1d([1, 2, 3, 4, 5], [1, 0, -1], 1, "valid", 2))",
+        "[-4.]");
+}
+
+#if defined(PHYLANX_HAVE_BLAZE_TENSOR)
+void test_conv1d_channels()
+{
+    // kernel of shape (kernel_size, channels, filters) = (2, 2, 2)
+    std::string const kernel = "[[[1, 0], [0, 1]], [[1, 1], [-1, 2]]]";
+
+    test_conv("conv1d([[1, 2], [3, 4], [5, 6]], " + kernel + ")",
+        "[[0., 13.], [2., 21.]]");
+    test_conv(R"(conv1d([[1, 2], [3, 4], [5, 6]], )" + kernel +
+            R"(, 1, "same"))",
+        "[[0., 13.], [2., 21.], [5., 6.]]");
+    test_conv(R"(conv1d([[1, 2], [3, 4], [5, 6]], )" + kernel +
+            R"(, 1, "causal"))",
+        "[[-1., 5.], [0., 13.], [2., 21.]]");
+
+    // batches, the strided convolution gathers the windows first
+    std::string const x =
+        "[[[1, 2], [3, 4], [5, 6]], [[0, 1], [1, 0], [2, 2]]]";
+
+    test_conv("conv1d(" + x + ", " + kernel + ")",
+        "[[[0., 13.], [2., 21.]], [[1., 2.], [1., 6.]]]");
+    test_conv("conv1d(" + x + ", " + kernel + ", 2)",
+        "[[[0., 13.]], [[1., 2.]]]");
+    test_conv("conv1d(" + x + ", " + kernel + R"(, 2, "same"))",
+        "[[[0., 13.], [5., 6.]], [[1., 2.], [2., 2.]]]");
+}
+#endif
+
+void test_conv2d()
+{
+    std::string const x = "[[1, 2, 3], [4, 5, 6], [7, 8, 9]]";
+    std::string const kernel = "[[1, 0], [0, -1]]";
+
+    test_conv("conv2d(" + x + ", " + kernel + ")",
+        "[[-4., -4.], [-4., -4.]]");
+    test_conv("conv2d(" + x + ", " + kernel + R"(, 1, "same"))",
+        "[[-4., -4., 3.], [-4., -4., 6.], [7., 8., 9.]]");
+
+    // strided and dilated convolutions
+    test_conv("conv2d(" + x + ", " + kernel + ", 2)", "[[-4.]]");
+    test_conv("conv2d(" + x + ", " + kernel + R"(, 2, "same"))",
+        "[[-4., 3.], [7., 9.]]");
+    test_conv("conv2d(" + x + ", " + kernel + R"(, list(1, 2), "same"))",
+        "[[-4., 3.], [-4., 6.], [7., 9.]]");
+    test_conv("conv2d(" + x + ", " + kernel + R"(, 1, "valid", 2))",
+        "[[-8.]]");
+}
+
+#if defined(PHYLANX_HAVE_BLAZE_TENSOR)
+void test_conv2d_batch()
+{
+    std::string const x = "[[[1, 2, 3], [4, 5, 6], [7, 8, 9]], "
+        "[[2, 4, 6], [8, 10, 12], [14, 16, 18]]]";
+    std::string const kernel = "[[1, 0], [0, -1]]";
+
+    test_conv("conv2d(" + x + ", " + kernel + ")",
+        "[[[-4., -4.], [-4., -4.]], [[-8., -8.], [-8., -8.]]]");
+    test_conv("conv2d(" + x + ", " + kernel + R"(, 2, "same"))",
+        "[[[-4., 3.], [7., 9.]], [[-8., 6.], [14., 18.]]]");
+}
+#endif
+
+void test_conv_errors()
+{
+    test_conv_throws(R"(conv1d([1, 2, 3], [1, 2], 1, "full"))");
+    test_conv_throws("conv1d([1, 2, 3], [1, 2], 0)");
+    test_conv_throws("conv1d([1, 2, 3], [[1, 2]])");
+    test_conv_throws(R"(conv2d([[1, 2], [3, 4]], [[1]], 1, "causal"))");
+    test_conv_throws("conv2d([[1, 2], [3, 4]], [[1]], list(1, 1, 1))");
+    test_conv_throws("conv2d([1, 2, 3], [[1]])");
+}
+
+///////////////////////////////////////////////////////////////////////////////
+int main(int argc, char* argv[])
+{
+    test_conv1d_vector();
+    test_conv2d();
+
+#if defined(PHYLANX_HAVE_BLAZE_TENSOR)
+    test_conv1d_channels();
+    test_conv2d_batch();
+#endif
+
+    test_conv_errors();
+
+    return hpx::util::report_errors();
+}
@@ -0,0 +1,130 @@
+// Copyright (c) 2019 Hartmut Kaiser
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <phylanx/phylanx.hpp>
+
+#include <hpx/hpx_main.hpp>
+#include <hpx/include/lcos.hpp>
+#include <hpx/util/lightweight_test.hpp>
+
+#include <exception>
+#include <string>
+
+///////////////////////////////////////////////////////////////////////////////
+phylanx::execution_tree::primitive_argument_type compile_and_run(
+    std::string const& codestr)
+{
+    phylanx::execution_tree::compiler::function_list snippets;
+    phylanx::execution_tree::compiler::environment env =
+        phylanx::execution_tree::compiler::default_environment();
+
+    auto const& code = phylanx::execution_tree::compile(codestr, snippets, env);
+    return code.run();
+}
+
+void test_pool(std::string const& code, std::string const& expectedstr)
+{
+    HPX_TEST_EQ(compile_and_run(code), compile_and_run(expectedstr));
+}
+
+void test_pool_throws(std::string const& code)
+{
+    bool exception_thrown = false;
+    try
+    {
+        compile_and_run(code);
+    }
+    catch (std::exception const&)
+    {
+        exception_thrown = true;
+    }
+    HPX_TEST(exception_thrown);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+void test_pool1d()
+{
+    std::string const x = "[[1, 8], [2, 7], [3, 6], [4, 5]]";
+
+    test_pool("max_pool(" + x + ", 2)", "[[2., 8.], [4., 6.]]");
+    test_pool("avg_pool(" + x + ", 2)", "[[1.5, 7.5], [3.5, 5.5]]");
+    test_pool("max_pool(" + x + ", list(2))", "[[2., 8.], [4., 6.]]");
+
+    // windows reaching into the padding consider valid elements only
+    test_pool("max_pool(" + x + R"(, 2, 1, "same"))",
+        "[[2., 8.], [3., 7.], [4., 6.], [4., 5.]]");
+    test_pool("avg_pool(" + x + R"(, 2, 1, "same"))",
+        "[[1.5, 7.5], [2.5, 6.5], [3.5, 5.5], [4., 5.]]");
+    test_pool("avg_pool(" + x + R"(, 3, 1, "valid"))",
+        "[[2., 7.], [3., 6.]]");
+}
+
+#if defined(PHYLANX_HAVE_BLAZE_TENSOR)
+void test_pool1d_batch()
+{
+    std::string const x = "[[[1, 8], [2, 7], [3, 6], [4, 5]], "
+        "[[0, 0], [1, -1], [2, -2], [3, -3]]]";
+
+    test_pool("max_pool(" + x + ", 2)",
+        "[[[2., 8.], [4., 6.]], [[1., 0.], [3., -2.]]]");
+    test_pool("avg_pool(" + x + ", 2)",
+        "[[[1.5, 7.5], [3.5, 5.5]], [[0.5, -0.5], [2.5, -2.5]]]");
+}
+#endif
+
+void test_pool2d()
+{
+    std::string const x =
+        "[[1, 2, 3, 4], [5, 6, 7, 8], [9, 10, 11, 12], [13, 14, 15, 16]]";
+
+    test_pool("max_pool(" + x + ", list(2, 2))", "[[6., 8.], [14., 16.]]");
+    test_pool("avg_pool(" + x + ", list(2, 2))",
+        "[[3.5, 5.5], [11.5, 13.5]]");
+    test_pool("max_pool(" + x + ", list(2, 2), 1)",
+        "[[6., 7., 8.], [10., 11., 12.], [14., 15., 16.]]");
+
+    // windows reaching into the padding consider valid elements only
+    test_pool("max_pool(" + x + R"(, list(3, 3), 2, "same"))",
+        "[[11., 12.], [15., 16.]]");
+    test_pool("avg_pool(" + x + R"(, list(3, 3), 2, "same"))",
+        "[[6., 7.5], [12., 13.5]]");
+    test_pool("avg_pool(" + x + R"(, list(2, 2), 1, "same"))",
+        "[[3.5, 4.5, 5.5, 6.], [7.5, 8.5, 9.5, 10.], "
+        "[11.5, 12.5, 13.5, 14.], [13.5, 14.5, 15.5, 16.]]");
+}
+
+#if defined(PHYLANX_HAVE_BLAZE_TENSOR)
+void test_pool2d_batch()
+{
+    std::string const x = "[[[1, 2], [3, 4]], [[-1, -2], [-3, -4]]]";
+
+    test_pool("max_pool(" + x + ", list(2, 2))", "[[[4.]], [[-1.]]]");
+    test_pool("avg_pool(" + x + ", list(2, 2))", "[[[2.5]], [[-2.5]]]");
+}
+#endif
+
+void test_pool_errors()
+{
+    test_pool_throws("max_pool([[1, 2], [3, 4]], list(1, 1, 1))");
+    test_pool_throws("max_pool([[1, 2], [3, 4]], 0)");
+    test_pool_throws(R"(max_pool([[1, 2], [3, 4]], 1, 1, "causal"))");
+    test_pool_throws("avg_pool([1, 2, 3, 4], 2)");
+}
+
+///////////////////////////////////////////////////////////////////////////////
+int main(int argc, char* argv[])
+{
+    test_pool1d();
+    test_pool2d();
+
+#if defined(PHYLANX_HAVE_BLAZE_TENSOR)
+    test_pool1d_batch();
+    test_pool2d_batch();
+#endif
+
+    test_pool_errors();
+
+    return hpx::util::report_errors();
+}
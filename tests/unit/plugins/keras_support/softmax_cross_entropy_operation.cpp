@@ -0,0 +1,117 @@
+// Copyright (c) 2019 Hartmut Kaiser
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <phylanx/phylanx.hpp>
+
+#include <hpx/hpx_main.hpp>
+#include <hpx/include/lcos.hpp>
+#include <hpx/util/lightweight_test.hpp>
+
+#include <cmath>
+#include <exception>
+#include <string>
+
+///////////////////////////////////////////////////////////////////////////////
+phylanx::execution_tree::primitive_argument_type compile_and_run(
+    std::string const& codestr)
+{
+    phylanx::execution_tree::compiler::function_list snippets;
+    phylanx::execution_tree::compiler::environment env =
+        phylanx::execution_tree::compiler::default_environment();
+
+    auto const& code = phylanx::execution_tree::compile(codestr, snippets, env);
+    return code.run();
+}
+
+void test_cross_entropy(std::string const& code, std::string const& expectedstr)
+{
+    HPX_TEST_EQ(compile_and_run(code), compile_and_run(expectedstr));
+}
+
+void test_cross_entropy(std::string const& code, double expected)
+{
+    double const result =
+        phylanx::execution_tree::extract_scalar_numeric_value(
+            compile_and_run(code));
+    HPX_TEST_LT(std::abs(result - expected), 1e-8);
+}
+
+void test_cross_entropy_throws(std::string const& code)
+{
+    bool exception_thrown = false;
+    try
+    {
+        compile_and_run(code);
+    }
+    catch (std::exception const&)
+    {
+        exception_thrown = true;
+    }
+    HPX_TEST(exception_thrown);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+void test_cross_entropy_dense()
+{
+    test_cross_entropy("softmax_cross_entropy([1, 2, 3], [0, 0, 1])",
+        0.40760596);
+    test_cross_entropy("softmax_cross_entropy([1, 2, 3], [1, 0, 0])",
+        2.40760596);
+
+    test_cross_entropy(
+        "softmax_cross_entropy([[1, 2, 3], [4, 1, 2]], "
+            "[[0., 0., 1.], [0., 0.5, 0.5]])",
+        "[0.40760596, 2.66984602]");
+
+    // large logits must not overflow
+    test_cross_entropy(
+        "softmax_cross_entropy([1000, 1001, 1002], [1, 0, 0])",
+        2.40760596);
+}
+
+void test_cross_entropy_sparse()
+{
+    test_cross_entropy("softmax_cross_entropy([1, 2, 3], 2)", 0.40760596);
+    test_cross_entropy(
+        "softmax_cross_entropy([[1, 2, 3], [4, 1, 2]], [2, 0])",
+        "[0.40760596, 0.16984602]");
+}
+
+#if defined(PHYLANX_HAVE_BLAZE_TENSOR)
+void test_cross_entropy_3d()
+{
+    test_cross_entropy(
+        "softmax_cross_entropy([[[1, 2, 3], [4, 1, 2]], [[4, 1, 2], "
+            "[1, 2, 3]]], [[[0, 0, 1], [1, 0, 0]], [[1, 0, 0], [0, 0, 1]]])",
+        "[[0.40760596, 0.16984602], [0.16984602, 0.40760596]]");
+    test_cross_entropy(
+        "softmax_cross_entropy([[[1, 2, 3], [4, 1, 2]], [[4, 1, 2], "
+            "[1, 2, 3]]], [[2, 0], [0, 2]])",
+        "[[0.40760596, 0.16984602], [0.16984602, 0.40760596]]");
+}
+#endif
+
+void test_cross_entropy_errors()
+{
+    test_cross_entropy_throws("softmax_cross_entropy([1, 2, 3], [0, 1])");
+    test_cross_entropy_throws("softmax_cross_entropy([1, 2, 3], 3)");
+    test_cross_entropy_throws("softmax_cross_entropy([1, 2, 3], 0.5)");
+    test_cross_entropy_throws("softmax_cross_entropy([[1, 2], [3, 4]], [0])");
+}
+
+///////////////////////////////////////////////////////////////////////////////
+int main(int argc, char* argv[])
+{
+    test_cross_entropy_dense();
+    test_cross_entropy_sparse();
+
+#if defined(PHYLANX_HAVE_BLAZE_TENSOR)
+    test_cross_entropy_3d();
+#endif
+
+    test_cross_entropy_errors();
+
+    return hpx::util::report_errors();
+}
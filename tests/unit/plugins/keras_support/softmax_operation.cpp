@@ -138,6 +138,102 @@ void test_softmax_operation_2d_row()
         phylanx::execution_tree::extract_numeric_value(f.get()));
 }
 
+void test_softmax_operation_large()
+{
+    // large inputs must not overflow
+    blaze::DynamicVector<double> subject{1001., 1002., 1003.};
+    phylanx::execution_tree::primitive arg =
+        phylanx::execution_tree::primitives::create_variable(
+            hpx::find_here(), phylanx::ir::node_data<double>(subject));
+
+    phylanx::execution_tree::primitive softmax =
+        phylanx::execution_tree::primitives::create_softmax_operation(
+            hpx::find_here(),
+            phylanx::execution_tree::primitive_arguments_type{std::move(arg)});
+
+    hpx::future<phylanx::execution_tree::primitive_argument_type> f =
+        softmax.eval();
+
+    blaze::DynamicVector<double> expected{0.09003057, 0.24472847, 0.66524096};
+
+    HPX_TEST_EQ(phylanx::ir::node_data<double>(std::move(expected)),
+        phylanx::execution_tree::extract_numeric_value(f.get()));
+}
+
+///////////////////////////////////////////////////////////////////////////////
+void test_log_softmax_operation_1d()
+{
+    blaze::DynamicVector<double> subject{1041., 1042., 1043.};
+    phylanx::execution_tree::primitive arg =
+        phylanx::execution_tree::primitives::create_variable(
+            hpx::find_here(), phylanx::ir::node_data<double>(subject));
+
+    phylanx::execution_tree::primitive log_softmax =
+        phylanx::execution_tree::primitives::create_log_softmax_operation(
+            hpx::find_here(),
+            phylanx::execution_tree::primitive_arguments_type{std::move(arg)});
+
+    hpx::future<phylanx::execution_tree::primitive_argument_type> f =
+        log_softmax.eval();
+
+    blaze::DynamicVector<double> expected{
+        -2.40760596, -1.40760596, -0.40760596};
+
+    HPX_TEST_EQ(phylanx::ir::node_data<double>(std::move(expected)),
+        phylanx::execution_tree::extract_numeric_value(f.get()));
+}
+
+void test_log_softmax_operation_2d()
+{
+    blaze::DynamicMatrix<std::int64_t> subject{{1, 2, 3}, {4, 1, 2}};
+    phylanx::execution_tree::primitive arg =
+        phylanx::execution_tree::primitives::create_variable(
+            hpx::find_here(), phylanx::ir::node_data<std::int64_t>(subject));
+
+    phylanx::execution_tree::primitive log_softmax =
+        phylanx::execution_tree::primitives::create_log_softmax_operation(
+            hpx::find_here(),
+            phylanx::execution_tree::primitive_arguments_type{std::move(arg)});
+
+    hpx::future<phylanx::execution_tree::primitive_argument_type> f =
+        log_softmax.eval();
+
+    blaze::DynamicMatrix<double> expected{
+        {-2.40760596, -1.40760596, -0.40760596},
+        {-0.16984602, -3.16984602, -2.16984602}};
+
+    HPX_TEST_EQ(phylanx::ir::node_data<double>(std::move(expected)),
+        phylanx::execution_tree::extract_numeric_value(f.get()));
+}
+
+void test_log_softmax_operation_2d_column()
+{
+    blaze::DynamicMatrix<std::int64_t> subject{{1, 2, 3}, {4, 1, 2}};
+    phylanx::execution_tree::primitive arg0 =
+        phylanx::execution_tree::primitives::create_variable(
+            hpx::find_here(), phylanx::ir::node_data<std::int64_t>(subject));
+
+    phylanx::execution_tree::primitive arg1 =
+        phylanx::execution_tree::primitives::create_variable(
+            hpx::find_here(), phylanx::ir::node_data<std::int64_t>(0));
+
+    phylanx::execution_tree::primitive log_softmax =
+        phylanx::execution_tree::primitives::create_log_softmax_operation(
+            hpx::find_here(),
+            phylanx::execution_tree::primitive_arguments_type{
+                std::move(arg0), std::move(arg1)});
+
+    hpx::future<phylanx::execution_tree::primitive_argument_type> f =
+        log_softmax.eval();
+
+    blaze::DynamicMatrix<double> expected{
+        {-3.04858735, -0.31326169, -0.31326169},
+        {-0.04858735, -1.31326169, -1.31326169}};
+
+    HPX_TEST_EQ(phylanx::ir::node_data<double>(std::move(expected)),
+        phylanx::execution_tree::extract_numeric_value(f.get()));
+}
+
 #if defined(PHYLANX_HAVE_BLAZE_TENSOR)
 void test_softmax_operation_3d()
 {
@@ -275,6 +371,11 @@ int main(int argc, char* argv[])
     test_softmax_operation_2d();
     test_softmax_operation_2d_column();
     test_softmax_operation_2d_row();
+    test_softmax_operation_large();
+
+    test_log_softmax_operation_1d();
+    test_log_softmax_operation_2d();
+    test_log_softmax_operation_2d_column();
 
 #if defined(PHYLANX_HAVE_BLAZE_TENSOR)
     test_softmax_operation_3d();
@@ -12,6 +12,7 @@
 #include <hpx/util/lightweight_test.hpp>
 
 #include <cstdint>
+#include <exception>
 #include <iostream>
 #include <string>
 #include <utility>
@@ -746,6 +747,34 @@ void test_dot_operation(std::string const& code,
     HPX_TEST_EQ(compile_and_run(code), compile_and_run(expected_str));
 }
 
+void test_dot_operation_backends()
+{
+    // the sizes are not multiples of the tile size, all values are integral
+    // to make the results independent of the order of the summation
+    std::string const a = "linearmatrix(150, 130, 0, 1, -2)";
+    std::string const b = "linearmatrix(130, 170, 5, -1, 3)";
+    std::string const v = "slice(linearmatrix(1, 130, -10, 0, 1), 0)";
+
+    for (std::string const backend : {"\"auto\"", "\"tiled\""})
+    {
+        test_dot_operation("dot(" + a + ", " + b + ", " + backend + ")",
+            "dot(" + a + ", " + b + ", \"blaze\")");
+        test_dot_operation("dot(" + a + ", " + v + ", " + backend + ")",
+            "dot(" + a + ", " + v + ", \"blaze\")");
+    }
+
+    bool exception_thrown = false;
+    try
+    {
+        compile_and_run("dot([[1, 2]], [[3], [4]], \"unknown\")");
+    }
+    catch (std::exception const&)
+    {
+        exception_thrown = true;
+    }
+    HPX_TEST(exception_thrown);
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 int main(int argc, char* argv[])
 {
@@ -811,6 +840,7 @@ int main(int argc, char* argv[])
     test_dot_operation_2d2d();
     test_dot_operation_2d2d_lit();
     test_dot_operation_2d2d_numpy();
+    test_dot_operation_backends();
 
 #if defined(PHYLANX_HAVE_BLAZE_TENSOR)
     test_dot_operation("dot(2, [[[1,2,3,4]],[[5,6,7,8]]])",
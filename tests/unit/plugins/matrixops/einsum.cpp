@@ -0,0 +1,158 @@
+// Copyright (c) 2019 Hartmut Kaiser
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <phylanx/phylanx.hpp>
+
+#include <hpx/hpx_main.hpp>
+#include <hpx/include/lcos.hpp>
+#include <hpx/util/lightweight_test.hpp>
+
+#include <exception>
+#include <string>
+
+///////////////////////////////////////////////////////////////////////////////
+phylanx::execution_tree::primitive_argument_type compile_and_run(
+    std::string const& codestr)
+{
+    phylanx::execution_tree::compiler::function_list snippets;
+    phylanx::execution_tree::compiler::environment env =
+        phylanx::execution_tree::compiler::default_environment();
+
+    auto const& code = phylanx::execution_tree::compile(codestr, snippets, env);
+    return code.run();
+}
+
+void test_einsum(std::string const& code, std::string const& expectedstr)
+{
+    HPX_TEST_EQ(compile_and_run(code), compile_and_run(expectedstr));
+}
+
+void test_einsum_throws(std::string const& code)
+{
+    bool exception_thrown = false;
+    try
+    {
+        compile_and_run(code);
+    }
+    catch (std::exception const&)
+    {
+        exception_thrown = true;
+    }
+    HPX_TEST(exception_thrown);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+void test_einsum_single_operand()
+{
+    test_einsum(R"(einsum("ij->ji", [[1, 2, 3], [4, 5, 6]]))",
+        "[[1., 4.], [2., 5.], [3., 6.]]");
+    test_einsum(R"(einsum("ii", [[1, 2], [3, 4]]))", "5.");
+    test_einsum(R"(einsum("ii->i", [[1, 2], [3, 4]]))", "[1., 4.]");
+    test_einsum(R"(einsum("ij->", [[1, 2], [3, 4]]))", "10.");
+    test_einsum(R"(einsum("ij->i", [[1, 2], [3, 4]]))", "[3., 7.]");
+    test_einsum(R"(einsum("ij->j", [[1, 2], [3, 4]]))", "[4., 6.]");
+    test_einsum(R"(einsum("i", [1, 2, 3]))", "[1., 2., 3.]");
+}
+
+void test_einsum_two_operands()
+{
+    // matrix products, with and without transposed operands
+    test_einsum(R"(einsum("ij,jk->ik", [[1, 2], [3, 4]], [[5, 6], [7, 8]]))",
+        "[[19., 22.], [43., 50.]]");
+    test_einsum(R"(einsum("ij,jk", [[1, 2], [3, 4]], [[5, 6], [7, 8]]))",
+        "[[19., 22.], [43., 50.]]");
+    test_einsum(R"(einsum("ji,jk->ik", [[1, 3], [2, 4]], [[5, 6], [7, 8]]))",
+        "[[19., 22.], [43., 50.]]");
+    test_einsum(R"(einsum("ij,kj->ik", [[1, 2], [3, 4]], [[5, 7], [6, 8]]))",
+        "[[19., 22.], [43., 50.]]");
+    test_einsum(R"(einsum("ij,jk->ki", [[1, 2], [3, 4]], [[5, 6], [7, 8]]))",
+        "[[19., 43.], [22., 50.]]");
+
+    // products involving vectors
+    test_einsum(R"(einsum("i,i", [1, 2, 3], [4, 5, 6]))", "32.");
+    test_einsum(R"(einsum("i,j->ij", [1, 2], [3, 4, 5]))",
+        "[[3., 4., 5.], [6., 8., 10.]]");
+    test_einsum(R"(einsum("ij,j->i", [[1, 2], [3, 4]], [1, 1]))", "[3., 7.]");
+    test_einsum(R"(einsum("ij,i->j", [[1, 2], [3, 4]], [1, 1]))", "[4., 6.]");
+
+    // element-wise product and its sum
+    test_einsum(R"(einsum("ij,ij->ij", [[1, 2], [3, 4]], [[5, 6], [7, 8]]))",
+        "[[5., 12.], [21., 32.]]");
+    test_einsum(R"(einsum("ij,ij", [[1, 2], [3, 4]], [[5, 6], [7, 8]]))",
+        "70.");
+
+    // scalar operand
+    test_einsum(R"(einsum(",ij->ij", 2, [[1, 2], [3, 4]]))",
+        "[[2., 4.], [6., 8.]]");
+}
+
+void test_einsum_large()
+{
+    // large enough to be evaluated by the blaze kernels
+    std::string const a = "linearmatrix(60, 70, 0, 1, -2)";
+    std::string const b = "linearmatrix(70, 80, 5, -1, 3)";
+    std::string const bt = "linearmatrix(80, 70, 5, 3, -1)";
+
+    test_einsum("einsum(\"ij,jk->ik\", " + a + ", " + b + ")",
+        "dot(" + a + ", " + b + ")");
+    test_einsum("einsum(\"ij,kj->ik\", " + a + ", " + bt + ")",
+        "dot(" + a + ", " + b + ")");
+    test_einsum("einsum(\"ij,jk->ki\", " + a + ", " + b + ")",
+        "transpose(dot(" + a + ", " + b + "))");
+}
+
+void test_einsum_multiple_operands()
+{
+    std::string const a = "[[1., 2.], [3., 4.]]";
+    std::string const b = "[[0., 1.], [1., 0.]]";
+    std::string const c = "[[2., 0., 1.], [1., 1., 0.]]";
+
+    test_einsum("einsum(\"ij,jk,kl->il\", " + a + ", " + b + ", " + c + ")",
+        "dot(dot(" + a + ", " + b + "), " + c + ")");
+    test_einsum("einsum(\"ij,jk,kl\", " + a + ", " + b + ", " + c + ")",
+        "dot(" + a + ", dot(" + b + ", " + c + "))");
+    test_einsum("einsum(\"i,ij,j\", [1., 2.], " + a + ", [3., 4.])",
+        "dot([1., 2.], dot(" + a + ", [3., 4.]))");
+}
+
+#if defined(PHYLANX_HAVE_BLAZE_TENSOR)
+void test_einsum_tensors()
+{
+    test_einsum(R"(einsum("bij,bjk->bik",
+            [[[1, 2], [3, 4]], [[1, 0], [0, 1]]],
+            [[[1, 0], [0, 1]], [[5, 6], [7, 8]]]))",
+        "[[[1., 2.], [3., 4.]], [[5., 6.], [7., 8.]]]");
+    test_einsum(R"(einsum("ijk,k->ij",
+            [[[1, 2], [3, 4]], [[5, 6], [7, 8]]], [1, -1]))",
+        "[[-1., -1.], [-1., -1.]]");
+    test_einsum(R"(einsum("ijk->kji", [[[1, 2], [3, 4]], [[5, 6], [7, 8]]]))",
+        "[[[1., 5.], [3., 7.]], [[2., 6.], [4., 8.]]]");
+}
+#endif
+
+void test_einsum_errors()
+{
+    test_einsum_throws(R"(einsum("ij,jk", [[1, 2]], [[1, 2]]))");
+    test_einsum_throws(R"(einsum("ij,jk", [[1, 2]]))");
+    test_einsum_throws(R"(einsum("i,i->k", [1, 2], [1, 2]))");
+    test_einsum_throws(R"(einsum("...i", [1, 2]))");
+}
+
+///////////////////////////////////////////////////////////////////////////////
+int main(int argc, char* argv[])
+{
+    test_einsum_single_operand();
+    test_einsum_two_operands();
+    test_einsum_large();
+    test_einsum_multiple_operands();
+
+#if defined(PHYLANX_HAVE_BLAZE_TENSOR)
+    test_einsum_tensors();
+#endif
+
+    test_einsum_errors();
+
+    return hpx::util::report_errors();
+}
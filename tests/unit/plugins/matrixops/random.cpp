@@ -10,6 +10,9 @@
 #include <hpx/include/lcos.hpp>
 #include <hpx/util/lightweight_test.hpp>
 
+#include <cstddef>
+#include <cstdint>
+#include <string>
 #include <utility>
 #include <vector>
 
@@ -86,11 +89,41 @@ void test_random_2d()
     HPX_TEST_EQ(result.dimension(1), 105);
 }
 
+phylanx::execution_tree::primitive_argument_type random_with_seed(
+    std::uint32_t seed, std::size_t rows, std::size_t columns)
+{
+    phylanx::util::set_seed(seed);
+
+    phylanx::execution_tree::primitive const_ =
+        phylanx::execution_tree::primitives::create_random(
+            hpx::find_here(),
+            phylanx::execution_tree::primitive_arguments_type{
+                phylanx::execution_tree::primitive_argument_type{
+                    phylanx::execution_tree::primitive_arguments_type{
+                        std::int64_t(rows), std::int64_t(columns)}},
+                std::string("uniform")
+            });
+
+    return const_.eval().get();
+}
+
+void test_random_seed()
+{
+    // large enough to be generated in parallel
+    auto first = random_with_seed(42, 1013, 517);
+    auto second = random_with_seed(42, 1013, 517);
+    auto third = random_with_seed(43, 1013, 517);
+
+    HPX_TEST_EQ(first, second);
+    HPX_TEST_NEQ(first, third);
+}
+
 int main(int argc, char* argv[])
 {
     test_random_0d();
     test_random_1d();
     test_random_2d();
+    test_random_seed();
 
     return hpx::util::report_errors();
 }
@@ -8,6 +8,7 @@
 #include <hpx/hpx_main.hpp>
 #include <hpx/util/lightweight_test.hpp>
 
+#include <cmath>
 #include <cstddef>
 #include <cstdint>
 #include <random>
@@ -56,12 +57,27 @@ void set_seed(std::uint32_t seed)
 
     call(static_cast<std::int64_t>(seed));
 }
+///////////////////////////////////////////////////////////////////////////////
+// random() draws the key of its generator from util::next_random_key(), peek
+// at the key the next invocation will use by resetting the seed. All arrays
+// generated below fit into a single block, which is generated from stream 0.
+phylanx::util::philox4x32 next_generator(std::uint32_t seed)
+{
+    phylanx::util::set_seed(seed);
+    std::uint64_t key = phylanx::util::next_random_key();
+    phylanx::util::set_seed(seed);
+
+    return phylanx::util::philox4x32(key);
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 // generate single random double value
-template <typename T, typename Gen, typename Dist>
+template <typename T, typename Dist>
 void generate_0d(phylanx::execution_tree::compiler::function const& call,
-    Gen& gen, Dist& dist)
+    std::uint32_t seed, Dist& dist)
 {
+    phylanx::util::philox4x32 gen = next_generator(seed);
+
     phylanx::execution_tree::primitive_arguments_type dims = {
         phylanx::execution_tree::primitive_argument_type{std::int64_t{0}}
     };
@@ -75,10 +91,12 @@ void generate_0d(phylanx::execution_tree::compiler::function const& call,
 }
 
 // generate a random double vector
-template <typename T, typename Gen, typename Dist>
+template <typename T, typename Dist>
 void generate_1d(phylanx::execution_tree::compiler::function const& call,
-    Gen& gen, Dist& dist)
+    std::uint32_t seed, Dist& dist)
 {
+    phylanx::util::philox4x32 gen = next_generator(seed);
+
     phylanx::execution_tree::primitive_arguments_type dims = {
         phylanx::execution_tree::primitive_argument_type{std::int64_t{32}},
         phylanx::execution_tree::primitive_argument_type{std::int64_t{0}}
@@ -97,10 +115,12 @@ void generate_1d(phylanx::execution_tree::compiler::function const& call,
 }
 
 // generate a random double matrix
-template <typename T, typename Gen, typename Dist>
+template <typename T, typename Dist>
 void generate_2d(phylanx::execution_tree::compiler::function const& call,
-    Gen& gen, Dist& dist)
+    std::uint32_t seed, Dist& dist)
 {
+    phylanx::util::philox4x32 gen = next_generator(seed);
+
     phylanx::execution_tree::primitive_arguments_type dims = {
         phylanx::execution_tree::primitive_argument_type{std::int64_t{32}},
         phylanx::execution_tree::primitive_argument_type{std::int64_t{16}}
@@ -123,10 +143,12 @@ void generate_2d(phylanx::execution_tree::compiler::function const& call,
 
 #if defined(PHYLANX_HAVE_BLAZE_TENSOR)
 // generate a random double tensor
-template <typename T, typename Gen, typename Dist>
+template <typename T, typename Dist>
 void generate_3d(phylanx::execution_tree::compiler::function const& call,
-    Gen& gen, Dist& dist)
+    std::uint32_t seed, Dist& dist)
 {
+    phylanx::util::philox4x32 gen = next_generator(seed);
+
     phylanx::execution_tree::primitive_arguments_type dims = {
         phylanx::execution_tree::primitive_argument_type{std::int64_t{3}},
         phylanx::execution_tree::primitive_argument_type{std::int64_t{32}},
@@ -153,7 +175,7 @@ void generate_3d(phylanx::execution_tree::compiler::function const& call,
 #endif
 
 ///////////////////////////////////////////////////////////////////////////////
-void test_normal_distribution_implicit(std::mt19937& gen)
+void test_normal_distribution_implicit(std::uint32_t seed)
 {
     std::string const code = R"(block(
             define(call, size, random(size)),
@@ -164,25 +186,25 @@ void test_normal_distribution_implicit(std::mt19937& gen)
 
     {
         std::normal_distribution<double> dist;
-        generate_0d<double>(call, gen, dist);
+        generate_0d<double>(call, seed, dist);
     }
     {
         std::normal_distribution<double> dist;
-        generate_1d<double>(call, gen, dist);
+        generate_1d<double>(call, seed, dist);
     }
     {
         std::normal_distribution<double> dist;
-        generate_2d<double>(call, gen, dist);
+        generate_2d<double>(call, seed, dist);
     }
 #if defined(PHYLANX_HAVE_BLAZE_TENSOR)
     {
         std::normal_distribution<double> dist;
-        generate_3d<double>(call, gen, dist);
+        generate_3d<double>(call, seed, dist);
     }
 #endif
 }
 
-void test_uniform_distribution_explicit(std::mt19937& gen)
+void test_uniform_distribution_explicit(std::uint32_t seed)
 {
     std::string const code = R"(block(
             define(call, size, random(size, "uniform")),
@@ -193,25 +215,25 @@ void test_uniform_distribution_explicit(std::mt19937& gen)
 
     {
         std::uniform_real_distribution<double> dist;
-        generate_0d<double>(call, gen, dist);
+        generate_0d<double>(call, seed, dist);
     }
     {
         std::uniform_real_distribution<double> dist;
-        generate_1d<double>(call, gen, dist);
+        generate_1d<double>(call, seed, dist);
     }
     {
         std::uniform_real_distribution<double> dist;
-        generate_2d<double>(call, gen, dist);
+        generate_2d<double>(call, seed, dist);
     }
 #if defined(PHYLANX_HAVE_BLAZE_TENSOR)
     {
         std::uniform_real_distribution<double> dist;
-        generate_3d<double>(call, gen, dist);
+        generate_3d<double>(call, seed, dist);
     }
 #endif
 }
 
-void test_uniform_distribution_explicit_params(std::mt19937& gen)
+void test_uniform_distribution_explicit_params(std::uint32_t seed)
 {
     std::string const code = R"(block(
             define(call, size, random(size, list("uniform", 2.0, 4.0))),
@@ -222,26 +244,26 @@ void test_uniform_distribution_explicit_params(std::mt19937& gen)
 
     {
         std::uniform_real_distribution<double> dist{2.0, 4.0};
-        generate_0d<double>(call, gen, dist);
+        generate_0d<double>(call, seed, dist);
     }
     {
         std::uniform_real_distribution<double> dist{2.0, 4.0};
-        generate_1d<double>(call, gen, dist);
+        generate_1d<double>(call, seed, dist);
     }
     {
         std::uniform_real_distribution<double> dist{2.0, 4.0};
-        generate_2d<double>(call, gen, dist);
+        generate_2d<double>(call, seed, dist);
     }
 #if defined(PHYLANX_HAVE_BLAZE_TENSOR)
     {
         std::uniform_real_distribution<double> dist{2.0, 4.0};
-        generate_3d<double>(call, gen, dist);
+        generate_3d<double>(call, seed, dist);
     }
 #endif
 }
 
 ///////////////////////////////////////////////////////////////////////////////
-void test_uniform_int_distribution_explicit(std::mt19937& gen)
+void test_uniform_int_distribution_explicit(std::uint32_t seed)
 {
     std::string const code = R"(block(
             define(call, size, random(size, "uniform_int")),
@@ -252,25 +274,25 @@ void test_uniform_int_distribution_explicit(std::mt19937& gen)
 
     {
         std::uniform_int_distribution<std::int64_t> dist;
-        generate_0d<std::int64_t>(call, gen, dist);
+        generate_0d<std::int64_t>(call, seed, dist);
     }
     {
         std::uniform_int_distribution<std::int64_t> dist;
-        generate_1d<std::int64_t>(call, gen, dist);
+        generate_1d<std::int64_t>(call, seed, dist);
     }
     {
         std::uniform_int_distribution<std::int64_t> dist;
-        generate_2d<std::int64_t>(call, gen, dist);
+        generate_2d<std::int64_t>(call, seed, dist);
     }
 #if defined(PHYLANX_HAVE_BLAZE_TENSOR)
     {
         std::uniform_int_distribution<std::int64_t> dist;
-        generate_3d<std::int64_t>(call, gen, dist);
+        generate_3d<std::int64_t>(call, seed, dist);
     }
 #endif
 }
 
-void test_uniform_int_distribution_explicit_params(std::mt19937& gen)
+void test_uniform_int_distribution_explicit_params(std::uint32_t seed)
 {
     std::string const code = R"(block(
             define(call, size, random(size, list("uniform_int", 200, 400))),
@@ -281,26 +303,26 @@ void test_uniform_int_distribution_explicit_params(std::mt19937& gen)
 
     {
         std::uniform_int_distribution<std::int64_t> dist{200, 400};
-        generate_0d<std::int64_t>(call, gen, dist);
+        generate_0d<std::int64_t>(call, seed, dist);
     }
     {
         std::uniform_int_distribution<std::int64_t> dist{200, 400};
-        generate_1d<std::int64_t>(call, gen, dist);
+        generate_1d<std::int64_t>(call, seed, dist);
     }
     {
         std::uniform_int_distribution<std::int64_t> dist{200, 400};
-        generate_2d<std::int64_t>(call, gen, dist);
+        generate_2d<std::int64_t>(call, seed, dist);
     }
 #if defined(PHYLANX_HAVE_BLAZE_TENSOR)
     {
         std::uniform_int_distribution<std::int64_t> dist{200, 400};
-        generate_3d<std::int64_t>(call, gen, dist);
+        generate_3d<std::int64_t>(call, seed, dist);
     }
 #endif
 }
 
 ///////////////////////////////////////////////////////////////////////////////
-void test_bernoulli_distribution(std::mt19937& gen)
+void test_bernoulli_distribution(std::uint32_t seed)
 {
     std::string const code = R"(block(
             define(call, size, random(size, "bernoulli")),
@@ -311,25 +333,25 @@ void test_bernoulli_distribution(std::mt19937& gen)
 
     {
         std::bernoulli_distribution dist;
-        generate_0d<std::uint8_t>(call, gen, dist);
+        generate_0d<std::uint8_t>(call, seed, dist);
     }
     {
         std::bernoulli_distribution dist;
-        generate_1d<std::uint8_t>(call, gen, dist);
+        generate_1d<std::uint8_t>(call, seed, dist);
     }
     {
         std::bernoulli_distribution dist;
-        generate_2d<std::uint8_t>(call, gen, dist);
+        generate_2d<std::uint8_t>(call, seed, dist);
     }
 #if defined(PHYLANX_HAVE_BLAZE_TENSOR)
     {
         std::bernoulli_distribution dist;
-        generate_3d<std::uint8_t>(call, gen, dist);
+        generate_3d<std::uint8_t>(call, seed, dist);
     }
 #endif
 }
 
-void test_bernoulli_distribution_params(std::mt19937& gen)
+void test_bernoulli_distribution_params(std::uint32_t seed)
 {
     std::string const code = R"(block(
             define(call, size, random(size, list("bernoulli", 0.8))),
@@ -340,26 +362,26 @@ void test_bernoulli_distribution_params(std::mt19937& gen)
 
     {
         std::bernoulli_distribution dist{0.8};
-        generate_0d<std::uint8_t>(call, gen, dist);
+        generate_0d<std::uint8_t>(call, seed, dist);
     }
     {
         std::bernoulli_distribution dist{0.8};
-        generate_1d<std::uint8_t>(call, gen, dist);
+        generate_1d<std::uint8_t>(call, seed, dist);
     }
     {
         std::bernoulli_distribution dist{0.8};
-        generate_2d<std::uint8_t>(call, gen, dist);
+        generate_2d<std::uint8_t>(call, seed, dist);
     }
 #if defined(PHYLANX_HAVE_BLAZE_TENSOR)
     {
         std::bernoulli_distribution dist{0.8};
-        generate_3d<std::uint8_t>(call, gen, dist);
+        generate_3d<std::uint8_t>(call, seed, dist);
     }
 #endif
 }
 
 ///////////////////////////////////////////////////////////////////////////////
-void test_binomial_distribution(std::mt19937& gen)
+void test_binomial_distribution(std::uint32_t seed)
 {
     std::string const code = R"(block(
             define(call, size, random(size, "binomial")),
@@ -370,25 +392,25 @@ void test_binomial_distribution(std::mt19937& gen)
 
     {
         std::binomial_distribution<int> dist;
-        generate_0d<double>(call, gen, dist);
+        generate_0d<double>(call, seed, dist);
     }
     {
         std::binomial_distribution<int> dist;
-        generate_1d<double>(call, gen, dist);
+        generate_1d<double>(call, seed, dist);
     }
     {
         std::binomial_distribution<int> dist;
-        generate_2d<double>(call, gen, dist);
+        generate_2d<double>(call, seed, dist);
     }
 #if defined(PHYLANX_HAVE_BLAZE_TENSOR)
     {
         std::binomial_distribution<int> dist;
-        generate_3d<double>(call, gen, dist);
+        generate_3d<double>(call, seed, dist);
     }
 #endif
 }
 
-void test_binomial_distribution_params(std::mt19937& gen)
+void test_binomial_distribution_params(std::uint32_t seed)
 {
     std::string const code = R"(block(
             define(call, size, random(size, list("binomial", 10, 0.8))),
@@ -399,26 +421,26 @@ void test_binomial_distribution_params(std::mt19937& gen)
 
     {
         std::binomial_distribution<int> dist{10, 0.8};
-        generate_0d<double>(call, gen, dist);
+        generate_0d<double>(call, seed, dist);
     }
     {
         std::binomial_distribution<int> dist{10, 0.8};
-        generate_1d<double>(call, gen, dist);
+        generate_1d<double>(call, seed, dist);
     }
     {
         std::binomial_distribution<int> dist{10, 0.8};
-        generate_2d<double>(call, gen, dist);
+        generate_2d<double>(call, seed, dist);
     }
 #if defined(PHYLANX_HAVE_BLAZE_TENSOR)
     {
         std::binomial_distribution<int> dist{10, 0.8};
-        generate_3d<double>(call, gen, dist);
+        generate_3d<double>(call, seed, dist);
     }
 #endif
 }
 
 ///////////////////////////////////////////////////////////////////////////////
-void test_negative_binomial_distribution(std::mt19937& gen)
+void test_negative_binomial_distribution(std::uint32_t seed)
 {
     std::string const code = R"(block(
             define(call, size, random(size, "negative_binomial")),
@@ -429,25 +451,25 @@ void test_negative_binomial_distribution(std::mt19937& gen)
 
     {
         std::negative_binomial_distribution<int> dist;
-        generate_0d<double>(call, gen, dist);
+        generate_0d<double>(call, seed, dist);
     }
     {
         std::negative_binomial_distribution<int> dist;
-        generate_1d<double>(call, gen, dist);
+        generate_1d<double>(call, seed, dist);
     }
     {
         std::negative_binomial_distribution<int> dist;
-        generate_2d<double>(call, gen, dist);
+        generate_2d<double>(call, seed, dist);
     }
 #if defined(PHYLANX_HAVE_BLAZE_TENSOR)
     {
         std::negative_binomial_distribution<int> dist;
-        generate_3d<double>(call, gen, dist);
+        generate_3d<double>(call, seed, dist);
     }
 #endif
 }
 
-void test_negative_binomial_distribution_params(std::mt19937& gen)
+void test_negative_binomial_distribution_params(std::uint32_t seed)
 {
     std::string const code = R"(block(
             define(call, size, random(size, list("negative_binomial", 10, 0.8))),
@@ -458,26 +480,26 @@ void test_negative_binomial_distribution_params(std::mt19937& gen)
 
     {
         std::negative_binomial_distribution<int> dist{10, 0.8};
-        generate_0d<double>(call, gen, dist);
+        generate_0d<double>(call, seed, dist);
     }
     {
         std::negative_binomial_distribution<int> dist{10, 0.8};
-        generate_1d<double>(call, gen, dist);
+        generate_1d<double>(call, seed, dist);
     }
     {
         std::negative_binomial_distribution<int> dist{10, 0.8};
-        generate_2d<double>(call, gen, dist);
+        generate_2d<double>(call, seed, dist);
     }
 #if defined(PHYLANX_HAVE_BLAZE_TENSOR)
     {
         std::negative_binomial_distribution<int> dist{10, 0.8};
-        generate_3d<double>(call, gen, dist);
+        generate_3d<double>(call, seed, dist);
     }
 #endif
 }
 
 ///////////////////////////////////////////////////////////////////////////////
-void test_geometric_distribution(std::mt19937& gen)
+void test_geometric_distribution(std::uint32_t seed)
 {
     std::string const code = R"(block(
             define(call, size, random(size, "geometric")),
@@ -488,25 +510,25 @@ void test_geometric_distribution(std::mt19937& gen)
 
     {
         std::geometric_distribution<int> dist;
-        generate_0d<double>(call, gen, dist);
+        generate_0d<double>(call, seed, dist);
     }
     {
         std::geometric_distribution<int> dist;
-        generate_1d<double>(call, gen, dist);
+        generate_1d<double>(call, seed, dist);
     }
     {
         std::geometric_distribution<int> dist;
-        generate_2d<double>(call, gen, dist);
+        generate_2d<double>(call, seed, dist);
     }
 #if defined(PHYLANX_HAVE_BLAZE_TENSOR)
     {
         std::geometric_distribution<int> dist;
-        generate_3d<double>(call, gen, dist);
+        generate_3d<double>(call, seed, dist);
     }
 #endif
 }
 
-void test_geometric_distribution_params(std::mt19937& gen)
+void test_geometric_distribution_params(std::uint32_t seed)
 {
     std::string const code = R"(block(
             define(call, size, random(size, list("geometric", 0.8))),
@@ -517,26 +539,26 @@ void test_geometric_distribution_params(std::mt19937& gen)
 
     {
         std::geometric_distribution<int> dist{0.8};
-        generate_0d<double>(call, gen, dist);
+        generate_0d<double>(call, seed, dist);
     }
     {
         std::geometric_distribution<int> dist{0.8};
-        generate_1d<double>(call, gen, dist);
+        generate_1d<double>(call, seed, dist);
     }
     {
         std::geometric_distribution<int> dist{0.8};
-        generate_2d<double>(call, gen, dist);
+        generate_2d<double>(call, seed, dist);
     }
 #if defined(PHYLANX_HAVE_BLAZE_TENSOR)
     {
         std::geometric_distribution<int> dist{0.8};
-        generate_3d<double>(call, gen, dist);
+        generate_3d<double>(call, seed, dist);
     }
 #endif
 }
 
 ///////////////////////////////////////////////////////////////////////////////
-void test_poisson_distribution(std::mt19937& gen)
+void test_poisson_distribution(std::uint32_t seed)
 {
     std::string const code = R"(block(
             define(call, size, random(size, "poisson")),
@@ -547,25 +569,25 @@ void test_poisson_distribution(std::mt19937& gen)
 
     {
         std::poisson_distribution<int> dist;
-        generate_0d<double>(call, gen, dist);
+        generate_0d<double>(call, seed, dist);
     }
     {
         std::poisson_distribution<int> dist;
-        generate_1d<double>(call, gen, dist);
+        generate_1d<double>(call, seed, dist);
     }
     {
         std::poisson_distribution<int> dist;
-        generate_2d<double>(call, gen, dist);
+        generate_2d<double>(call, seed, dist);
     }
 #if defined(PHYLANX_HAVE_BLAZE_TENSOR)
     {
         std::poisson_distribution<int> dist;
-        generate_3d<double>(call, gen, dist);
+        generate_3d<double>(call, seed, dist);
     }
 #endif
 }
 
-void test_poisson_distribution_params(std::mt19937& gen)
+void test_poisson_distribution_params(std::uint32_t seed)
 {
     std::string const code = R"(block(
             define(call, size, random(size, list("poisson", 4))),
@@ -576,26 +598,26 @@ void test_poisson_distribution_params(std::mt19937& gen)
 
     {
         std::poisson_distribution<int> dist{4};
-        generate_0d<double>(call, gen, dist);
+        generate_0d<double>(call, seed, dist);
     }
     {
         std::poisson_distribution<int> dist{4};
-        generate_1d<double>(call, gen, dist);
+        generate_1d<double>(call, seed, dist);
     }
     {
         std::poisson_distribution<int> dist{4};
-        generate_2d<double>(call, gen, dist);
+        generate_2d<double>(call, seed, dist);
     }
 #if defined(PHYLANX_HAVE_BLAZE_TENSOR)
     {
         std::poisson_distribution<int> dist{4};
-        generate_3d<double>(call, gen, dist);
+        generate_3d<double>(call, seed, dist);
     }
 #endif
 }
 
 ///////////////////////////////////////////////////////////////////////////////
-void test_exponential_distribution(std::mt19937& gen)
+void test_exponential_distribution(std::uint32_t seed)
 {
     std::string const code = R"(block(
             define(call, size, random(size, "exponential")),
@@ -606,25 +628,25 @@ void test_exponential_distribution(std::mt19937& gen)
 
     {
         std::exponential_distribution<double> dist;
-        generate_0d<double>(call, gen, dist);
+        generate_0d<double>(call, seed, dist);
     }
     {
         std::exponential_distribution<double> dist;
-        generate_1d<double>(call, gen, dist);
+        generate_1d<double>(call, seed, dist);
     }
     {
         std::exponential_distribution<double> dist;
-        generate_2d<double>(call, gen, dist);
+        generate_2d<double>(call, seed, dist);
     }
 #if defined(PHYLANX_HAVE_BLAZE_TENSOR)
     {
         std::exponential_distribution<double> dist;
-        generate_3d<double>(call, gen, dist);
+        generate_3d<double>(call, seed, dist);
     }
 #endif
 }
 
-void test_exponential_distribution_params(std::mt19937& gen)
+void test_exponential_distribution_params(std::uint32_t seed)
 {
     std::string const code = R"(block(
             define(call, size, random(size, list("exponential", 2.0))),
@@ -635,26 +657,26 @@ void test_exponential_distribution_params(std::mt19937& gen)
 
     {
         std::exponential_distribution<double> dist{2.0};
-        generate_0d<double>(call, gen, dist);
+        generate_0d<double>(call, seed, dist);
     }
     {
         std::exponential_distribution<double> dist{2.0};
-        generate_1d<double>(call, gen, dist);
+        generate_1d<double>(call, seed, dist);
     }
     {
         std::exponential_distribution<double> dist{2.0};
-        generate_2d<double>(call, gen, dist);
+        generate_2d<double>(call, seed, dist);
     }
 #if defined(PHYLANX_HAVE_BLAZE_TENSOR)
     {
         std::exponential_distribution<double> dist{2.0};
-        generate_3d<double>(call, gen, dist);
+        generate_3d<double>(call, seed, dist);
     }
 #endif
 }
 
 ///////////////////////////////////////////////////////////////////////////////
-void test_gamma_distribution(std::mt19937& gen)
+void test_gamma_distribution(std::uint32_t seed)
 {
     std::string const code = R"(block(
             define(call, size, random(size, "gamma")),
@@ -665,25 +687,25 @@ void test_gamma_distribution(std::mt19937& gen)
 
     {
         std::gamma_distribution<double> dist;
-        generate_0d<double>(call, gen, dist);
+        generate_0d<double>(call, seed, dist);
     }
     {
         std::gamma_distribution<double> dist;
-        generate_1d<double>(call, gen, dist);
+        generate_1d<double>(call, seed, dist);
     }
     {
         std::gamma_distribution<double> dist;
-        generate_2d<double>(call, gen, dist);
+        generate_2d<double>(call, seed, dist);
     }
 #if defined(PHYLANX_HAVE_BLAZE_TENSOR)
     {
         std::gamma_distribution<double> dist;
-        generate_3d<double>(call, gen, dist);
+        generate_3d<double>(call, seed, dist);
     }
 #endif
 }
 
-void test_gamma_distribution_params(std::mt19937& gen)
+void test_gamma_distribution_params(std::uint32_t seed)
 {
     std::string const code = R"(block(
             define(call, size, random(size, list("gamma", 0.8, 1.2))),
@@ -694,26 +716,26 @@ void test_gamma_distribution_params(std::mt19937& gen)
 
     {
         std::gamma_distribution<double> dist{0.8, 1.2};
-        generate_0d<double>(call, gen, dist);
+        generate_0d<double>(call, seed, dist);
     }
     {
         std::gamma_distribution<double> dist{0.8, 1.2};
-        generate_1d<double>(call, gen, dist);
+        generate_1d<double>(call, seed, dist);
     }
     {
         std::gamma_distribution<double> dist{0.8, 1.2};
-        generate_2d<double>(call, gen, dist);
+        generate_2d<double>(call, seed, dist);
     }
 #if defined(PHYLANX_HAVE_BLAZE_TENSOR)
     {
         std::gamma_distribution<double> dist{0.8, 1.2};
-        generate_3d<double>(call, gen, dist);
+        generate_3d<double>(call, seed, dist);
     }
 #endif
 }
 
 ///////////////////////////////////////////////////////////////////////////////
-void test_weibull_distribution(std::mt19937& gen)
+void test_weibull_distribution(std::uint32_t seed)
 {
     std::string const code = R"(block(
             define(call, size, random(size, "weibull")),
@@ -724,25 +746,25 @@ void test_weibull_distribution(std::mt19937& gen)
 
     {
         std::weibull_distribution<double> dist;
-        generate_0d<double>(call, gen, dist);
+        generate_0d<double>(call, seed, dist);
     }
     {
         std::weibull_distribution<double> dist;
-        generate_1d<double>(call, gen, dist);
+        generate_1d<double>(call, seed, dist);
     }
     {
         std::weibull_distribution<double> dist;
-        generate_2d<double>(call, gen, dist);
+        generate_2d<double>(call, seed, dist);
     }
 #if defined(PHYLANX_HAVE_BLAZE_TENSOR)
     {
         std::weibull_distribution<double> dist;
-        generate_3d<double>(call, gen, dist);
+        generate_3d<double>(call, seed, dist);
     }
 #endif
 }
 
-void test_weibull_distribution_params(std::mt19937& gen)
+void test_weibull_distribution_params(std::uint32_t seed)
 {
     std::string const code = R"(block(
             define(call, size, random(size, list("weibull", 0.8, 1.2))),
@@ -753,26 +775,26 @@ void test_weibull_distribution_params(std::mt19937& gen)
 
     {
         std::weibull_distribution<double> dist{0.8, 1.2};
-        generate_0d<double>(call, gen, dist);
+        generate_0d<double>(call, seed, dist);
     }
     {
         std::weibull_distribution<double> dist{0.8, 1.2};
-        generate_1d<double>(call, gen, dist);
+        generate_1d<double>(call, seed, dist);
     }
     {
         std::weibull_distribution<double> dist{0.8, 1.2};
-        generate_2d<double>(call, gen, dist);
+        generate_2d<double>(call, seed, dist);
     }
 #if defined(PHYLANX_HAVE_BLAZE_TENSOR)
     {
         std::weibull_distribution<double> dist{0.8, 1.2};
-        generate_3d<double>(call, gen, dist);
+        generate_3d<double>(call, seed, dist);
     }
 #endif
 }
 
 ///////////////////////////////////////////////////////////////////////////////
-void test_extreme_value_distribution(std::mt19937& gen)
+void test_extreme_value_distribution(std::uint32_t seed)
 {
     std::string const code = R"(block(
             define(call, size, random(size, "extreme_value")),
@@ -783,25 +805,25 @@ void test_extreme_value_distribution(std::mt19937& gen)
 
     {
         std::extreme_value_distribution<double> dist;
-        generate_0d<double>(call, gen, dist);
+        generate_0d<double>(call, seed, dist);
     }
     {
         std::extreme_value_distribution<double> dist;
-        generate_1d<double>(call, gen, dist);
+        generate_1d<double>(call, seed, dist);
     }
     {
         std::extreme_value_distribution<double> dist;
-        generate_2d<double>(call, gen, dist);
+        generate_2d<double>(call, seed, dist);
     }
 #if defined(PHYLANX_HAVE_BLAZE_TENSOR)
     {
         std::extreme_value_distribution<double> dist;
-        generate_3d<double>(call, gen, dist);
+        generate_3d<double>(call, seed, dist);
     }
 #endif
 }
 
-void test_extreme_value_distribution_params(std::mt19937& gen)
+void test_extreme_value_distribution_params(std::uint32_t seed)
 {
     std::string const code = R"(block(
             define(call, size, random(size, list("extreme_value", 0.8, 1.2))),
@@ -812,26 +834,26 @@ void test_extreme_value_distribution_params(std::mt19937& gen)
 
     {
         std::extreme_value_distribution<double> dist{0.8, 1.2};
-        generate_0d<double>(call, gen, dist);
+        generate_0d<double>(call, seed, dist);
     }
     {
         std::extreme_value_distribution<double> dist{0.8, 1.2};
-        generate_1d<double>(call, gen, dist);
+        generate_1d<double>(call, seed, dist);
     }
     {
         std::extreme_value_distribution<double> dist{0.8, 1.2};
-        generate_2d<double>(call, gen, dist);
+        generate_2d<double>(call, seed, dist);
     }
 #if defined(PHYLANX_HAVE_BLAZE_TENSOR)
     {
         std::extreme_value_distribution<double> dist{0.8, 1.2};
-        generate_3d<double>(call, gen, dist);
+        generate_3d<double>(call, seed, dist);
     }
 #endif
 }
 
 ///////////////////////////////////////////////////////////////////////////////
-void test_normal_distribution(std::mt19937& gen)
+void test_normal_distribution(std::uint32_t seed)
 {
     std::string const code = R"(block(
             define(call, size, random(size, "normal")),
@@ -842,25 +864,25 @@ void test_normal_distribution(std::mt19937& gen)
 
     {
         std::normal_distribution<double> dist;
-        generate_0d<double>(call, gen, dist);
+        generate_0d<double>(call, seed, dist);
     }
     {
         std::normal_distribution<double> dist;
-        generate_1d<double>(call, gen, dist);
+        generate_1d<double>(call, seed, dist);
     }
     {
         std::normal_distribution<double> dist;
-        generate_2d<double>(call, gen, dist);
+        generate_2d<double>(call, seed, dist);
     }
 #if defined(PHYLANX_HAVE_BLAZE_TENSOR)
     {
         std::normal_distribution<double> dist;
-        generate_3d<double>(call, gen, dist);
+        generate_3d<double>(call, seed, dist);
     }
 #endif
 }
 
-void test_normal_distribution_params(std::mt19937& gen)
+void test_normal_distribution_params(std::uint32_t seed)
 {
     std::string const code = R"(block(
             define(call, size, random(size, list("normal", 0.8, 1.2))),
@@ -871,26 +893,26 @@ void test_normal_distribution_params(std::mt19937& gen)
 
     {
         std::normal_distribution<double> dist{0.8, 1.2};
-        generate_0d<double>(call, gen, dist);
+        generate_0d<double>(call, seed, dist);
     }
     {
         std::normal_distribution<double> dist{0.8, 1.2};
-        generate_1d<double>(call, gen, dist);
+        generate_1d<double>(call, seed, dist);
     }
     {
         std::normal_distribution<double> dist{0.8, 1.2};
-        generate_2d<double>(call, gen, dist);
+        generate_2d<double>(call, seed, dist);
     }
 #if defined(PHYLANX_HAVE_BLAZE_TENSOR)
     {
         std::normal_distribution<double> dist{0.8, 1.2};
-        generate_3d<double>(call, gen, dist);
+        generate_3d<double>(call, seed, dist);
     }
 #endif
 }
 
 ///////////////////////////////////////////////////////////////////////////////
-void test_truncated_normal_distribution(std::mt19937& gen)
+void test_truncated_normal_distribution(std::uint32_t seed)
 {
     std::string const code = R"(block(
             define(call, size, random(size, "truncated_normal")),
@@ -901,25 +923,25 @@ void test_truncated_normal_distribution(std::mt19937& gen)
 
     {
         phylanx::util::truncated_normal_distribution<double> dist;
-        generate_0d<double>(call, gen, dist);
+        generate_0d<double>(call, seed, dist);
     }
     {
         phylanx::util::truncated_normal_distribution<double> dist;
-        generate_1d<double>(call, gen, dist);
+        generate_1d<double>(call, seed, dist);
     }
     {
         phylanx::util::truncated_normal_distribution<double> dist;
-        generate_2d<double>(call, gen, dist);
+        generate_2d<double>(call, seed, dist);
     }
 #if defined(PHYLANX_HAVE_BLAZE_TENSOR)
     {
         phylanx::util::truncated_normal_distribution<double> dist;
-        generate_3d<double>(call, gen, dist);
+        generate_3d<double>(call, seed, dist);
     }
 #endif
 }
 
-void test_truncated_normal_distribution_params(std::mt19937& gen)
+void test_truncated_normal_distribution_params(std::uint32_t seed)
 {
     using namespace phylanx::execution_tree::primitives;
 
@@ -934,26 +956,26 @@ void test_truncated_normal_distribution_params(std::mt19937& gen)
 
     {
         phylanx::util::truncated_normal_distribution<double> dist{0.8, 1.2};
-        generate_0d<double>(call, gen, dist);
+        generate_0d<double>(call, seed, dist);
     }
     {
         phylanx::util::truncated_normal_distribution<double> dist{0.8, 1.2};
-        generate_1d<double>(call, gen, dist);
+        generate_1d<double>(call, seed, dist);
     }
     {
         phylanx::util::truncated_normal_distribution<double> dist{0.8, 1.2};
-        generate_2d<double>(call, gen, dist);
+        generate_2d<double>(call, seed, dist);
     }
 #if defined(PHYLANX_HAVE_BLAZE_TENSOR)
     {
         phylanx::util::truncated_normal_distribution<double> dist{0.8, 1.2};
-        generate_3d<double>(call, gen, dist);
+        generate_3d<double>(call, seed, dist);
     }
 #endif
 }
 
 ///////////////////////////////////////////////////////////////////////////////
-void test_lognormal_distribution(std::mt19937& gen)
+void test_lognormal_distribution(std::uint32_t seed)
 {
     std::string const code = R"(block(
             define(call, size, random(size, "lognormal")),
@@ -964,25 +986,25 @@ void test_lognormal_distribution(std::mt19937& gen)
 
     {
         std::lognormal_distribution<double> dist;
-        generate_0d<double>(call, gen, dist);
+        generate_0d<double>(call, seed, dist);
     }
     {
         std::lognormal_distribution<double> dist;
-        generate_1d<double>(call, gen, dist);
+        generate_1d<double>(call, seed, dist);
     }
     {
         std::lognormal_distribution<double> dist;
-        generate_2d<double>(call, gen, dist);
+        generate_2d<double>(call, seed, dist);
     }
 #if defined(PHYLANX_HAVE_BLAZE_TENSOR)
     {
         std::lognormal_distribution<double> dist;
-        generate_3d<double>(call, gen, dist);
+        generate_3d<double>(call, seed, dist);
     }
 #endif
 }
 
-void test_lognormal_distribution_params(std::mt19937& gen)
+void test_lognormal_distribution_params(std::uint32_t seed)
 {
     std::string const code = R"(block(
             define(call, size, random(size, list("lognormal", 0.8, 1.2))),
@@ -993,26 +1015,26 @@ void test_lognormal_distribution_params(std::mt19937& gen)
 
     {
         std::lognormal_distribution<double> dist{0.8, 1.2};
-        generate_0d<double>(call, gen, dist);
+        generate_0d<double>(call, seed, dist);
     }
     {
         std::lognormal_distribution<double> dist{0.8, 1.2};
-        generate_1d<double>(call, gen, dist);
+        generate_1d<double>(call, seed, dist);
     }
     {
         std::lognormal_distribution<double> dist{0.8, 1.2};
-        generate_2d<double>(call, gen, dist);
+        generate_2d<double>(call, seed, dist);
     }
 #if defined(PHYLANX_HAVE_BLAZE_TENSOR)
     {
         std::lognormal_distribution<double> dist{0.8, 1.2};
-        generate_3d<double>(call, gen, dist);
+        generate_3d<double>(call, seed, dist);
     }
 #endif
 }
 
 ///////////////////////////////////////////////////////////////////////////////
-void test_chi_squared_distribution(std::mt19937& gen)
+void test_chi_squared_distribution(std::uint32_t seed)
 {
     std::string const code = R"(block(
             define(call, size, random(size, "chi_squared")),
@@ -1023,25 +1045,25 @@ void test_chi_squared_distribution(std::mt19937& gen)
 
     {
         std::chi_squared_distribution<double> dist;
-        generate_0d<double>(call, gen, dist);
+        generate_0d<double>(call, seed, dist);
     }
     {
         std::chi_squared_distribution<double> dist;
-        generate_1d<double>(call, gen, dist);
+        generate_1d<double>(call, seed, dist);
     }
     {
         std::chi_squared_distribution<double> dist;
-        generate_2d<double>(call, gen, dist);
+        generate_2d<double>(call, seed, dist);
     }
 #if defined(PHYLANX_HAVE_BLAZE_TENSOR)
     {
         std::chi_squared_distribution<double> dist;
-        generate_3d<double>(call, gen, dist);
+        generate_3d<double>(call, seed, dist);
     }
 #endif
 }
 
-void test_chi_squared_distribution_params(std::mt19937& gen)
+void test_chi_squared_distribution_params(std::uint32_t seed)
 {
     std::string const code = R"(block(
             define(call, size, random(size, list("chi_squared", 0.8))),
@@ -1052,26 +1074,26 @@ void test_chi_squared_distribution_params(std::mt19937& gen)
 
     {
         std::chi_squared_distribution<double> dist{0.8};
-        generate_0d<double>(call, gen, dist);
+        generate_0d<double>(call, seed, dist);
     }
     {
         std::chi_squared_distribution<double> dist{0.8};
-        generate_1d<double>(call, gen, dist);
+        generate_1d<double>(call, seed, dist);
     }
     {
         std::chi_squared_distribution<double> dist{0.8};
-        generate_2d<double>(call, gen, dist);
+        generate_2d<double>(call, seed, dist);
     }
 #if defined(PHYLANX_HAVE_BLAZE_TENSOR)
     {
         std::chi_squared_distribution<double> dist{0.8};
-        generate_3d<double>(call, gen, dist);
+        generate_3d<double>(call, seed, dist);
     }
 #endif
 }
 
 ///////////////////////////////////////////////////////////////////////////////
-void test_cauchy_distribution(std::mt19937& gen)
+void test_cauchy_distribution(std::uint32_t seed)
 {
     std::string const code = R"(block(
             define(call, size, random(size, "cauchy")),
@@ -1082,25 +1104,25 @@ void test_cauchy_distribution(std::mt19937& gen)
 
     {
         std::cauchy_distribution<double> dist;
-        generate_0d<double>(call, gen, dist);
+        generate_0d<double>(call, seed, dist);
     }
     {
         std::cauchy_distribution<double> dist;
-        generate_1d<double>(call, gen, dist);
+        generate_1d<double>(call, seed, dist);
     }
     {
         std::cauchy_distribution<double> dist;
-        generate_2d<double>(call, gen, dist);
+        generate_2d<double>(call, seed, dist);
     }
 #if defined(PHYLANX_HAVE_BLAZE_TENSOR)
     {
         std::cauchy_distribution<double> dist;
-        generate_3d<double>(call, gen, dist);
+        generate_3d<double>(call, seed, dist);
     }
 #endif
 }
 
-void test_cauchy_distribution_params(std::mt19937& gen)
+void test_cauchy_distribution_params(std::uint32_t seed)
 {
     std::string const code = R"(block(
             define(call, size, random(size, list("cauchy", 0.6, 0.8))),
@@ -1111,26 +1133,26 @@ void test_cauchy_distribution_params(std::mt19937& gen)
 
     {
         std::cauchy_distribution<double> dist{0.6, 0.8};
-        generate_0d<double>(call, gen, dist);
+        generate_0d<double>(call, seed, dist);
     }
     {
         std::cauchy_distribution<double> dist{0.6, 0.8};
-        generate_1d<double>(call, gen, dist);
+        generate_1d<double>(call, seed, dist);
     }
     {
         std::cauchy_distribution<double> dist{0.6, 0.8};
-        generate_2d<double>(call, gen, dist);
+        generate_2d<double>(call, seed, dist);
     }
 #if defined(PHYLANX_HAVE_BLAZE_TENSOR)
     {
         std::cauchy_distribution<double> dist{0.6, 0.8};
-        generate_3d<double>(call, gen, dist);
+        generate_3d<double>(call, seed, dist);
     }
 #endif
 }
 
 ///////////////////////////////////////////////////////////////////////////////
-void test_fisher_f_distribution(std::mt19937& gen)
+void test_fisher_f_distribution(std::uint32_t seed)
 {
     std::string const code = R"(block(
             define(call, size, random(size, "fisher_f")),
@@ -1141,25 +1163,25 @@ void test_fisher_f_distribution(std::mt19937& gen)
 
     {
         std::fisher_f_distribution<double> dist;
-        generate_0d<double>(call, gen, dist);
+        generate_0d<double>(call, seed, dist);
     }
     {
         std::fisher_f_distribution<double> dist;
-        generate_1d<double>(call, gen, dist);
+        generate_1d<double>(call, seed, dist);
     }
     {
         std::fisher_f_distribution<double> dist;
-        generate_2d<double>(call, gen, dist);
+        generate_2d<double>(call, seed, dist);
     }
 #if defined(PHYLANX_HAVE_BLAZE_TENSOR)
     {
         std::fisher_f_distribution<double> dist;
-        generate_3d<double>(call, gen, dist);
+        generate_3d<double>(call, seed, dist);
     }
 #endif
 }
 
-void test_fisher_f_distribution_params(std::mt19937& gen)
+void test_fisher_f_distribution_params(std::uint32_t seed)
 {
     std::string const code = R"(block(
             define(call, size, random(size, list("fisher_f", 0.6, 0.8))),
@@ -1170,26 +1192,26 @@ void test_fisher_f_distribution_params(std::mt19937& gen)
 
     {
         std::fisher_f_distribution<double> dist{0.6, 0.8};
-        generate_0d<double>(call, gen, dist);
+        generate_0d<double>(call, seed, dist);
     }
     {
         std::fisher_f_distribution<double> dist{0.6, 0.8};
-        generate_1d<double>(call, gen, dist);
+        generate_1d<double>(call, seed, dist);
     }
     {
         std::fisher_f_distribution<double> dist{0.6, 0.8};
-        generate_2d<double>(call, gen, dist);
+        generate_2d<double>(call, seed, dist);
     }
 #if defined(PHYLANX_HAVE_BLAZE_TENSOR)
     {
         std::fisher_f_distribution<double> dist{0.6, 0.8};
-        generate_3d<double>(call, gen, dist);
+        generate_3d<double>(call, seed, dist);
     }
 #endif
 }
 
 ///////////////////////////////////////////////////////////////////////////////
-void test_student_t_distribution(std::mt19937& gen)
+void test_student_t_distribution(std::uint32_t seed)
 {
     std::string const code = R"(block(
             define(call, size, random(size, "student_t")),
@@ -1200,25 +1222,25 @@ void test_student_t_distribution(std::mt19937& gen)
 
     {
         std::student_t_distribution<double> dist;
-        generate_0d<double>(call, gen, dist);
+        generate_0d<double>(call, seed, dist);
     }
     {
         std::student_t_distribution<double> dist;
-        generate_1d<double>(call, gen, dist);
+        generate_1d<double>(call, seed, dist);
     }
     {
         std::student_t_distribution<double> dist;
-        generate_2d<double>(call, gen, dist);
+        generate_2d<double>(call, seed, dist);
     }
 #if defined(PHYLANX_HAVE_BLAZE_TENSOR)
     {
         std::student_t_distribution<double> dist;
-        generate_3d<double>(call, gen, dist);
+        generate_3d<double>(call, seed, dist);
     }
 #endif
 }
 
-void test_student_t_distribution_params(std::mt19937& gen)
+void test_student_t_distribution_params(std::uint32_t seed)
 {
     std::string const code = R"(block(
             define(call, size, random(size, list("student_t", 0.8))),
@@ -1229,25 +1251,68 @@ void test_student_t_distribution_params(std::mt19937& gen)
 
     {
         std::student_t_distribution<double> dist{0.8};
-        generate_0d<double>(call, gen, dist);
+        generate_0d<double>(call, seed, dist);
     }
     {
         std::student_t_distribution<double> dist{0.8};
-        generate_1d<double>(call, gen, dist);
+        generate_1d<double>(call, seed, dist);
     }
     {
         std::student_t_distribution<double> dist{0.8};
-        generate_2d<double>(call, gen, dist);
+        generate_2d<double>(call, seed, dist);
     }
 #if defined(PHYLANX_HAVE_BLAZE_TENSOR)
     {
         std::student_t_distribution<double> dist{0.8};
-        generate_3d<double>(call, gen, dist);
+        generate_3d<double>(call, seed, dist);
     }
 #endif
 }
 
 ///////////////////////////////////////////////////////////////////////////////
+///////////////////////////////////////////////////////////////////////////////
+// arrays spanning several blocks are generated in parallel, the result
+// depends on the seed only
+void test_reseed(std::uint32_t seed)
+{
+    std::string const code = R"(block(
+            define(call, size, random(size, "uniform")),
+            call
+        ))";
+
+    auto call = compile(code);
+
+    std::size_t const size = 100003;
+    phylanx::execution_tree::primitive_arguments_type dims = {
+        phylanx::execution_tree::primitive_argument_type{std::int64_t(size)}
+    };
+
+    phylanx::util::set_seed(seed);
+    auto first = phylanx::execution_tree::extract_numeric_value(call(dims));
+    auto second = phylanx::execution_tree::extract_numeric_value(call(dims));
+
+    phylanx::util::set_seed(seed);
+    auto repeated = phylanx::execution_tree::extract_numeric_value(call(dims));
+
+    HPX_TEST_EQ(first, repeated);
+    HPX_TEST(!(first == second));
+
+    // the values are uniformly distributed in [0, 1)
+    double sum = 0.0;
+    double sum_squares = 0.0;
+    for (double val : first.vector())
+    {
+        HPX_TEST(val >= 0.0 && val < 1.0);
+        sum += val;
+        sum_squares += val * val;
+    }
+
+    double const mean = sum / size;
+    double const variance = sum_squares / size - mean * mean;
+    HPX_TEST(std::abs(mean - 0.5) < 0.01);
+    HPX_TEST(std::abs(variance - 1.0 / 12.0) < 0.01);
+}
+
 int main(int argc, char* argv[])
 {
     std::uint32_t seed = std::random_device{}();
@@ -1255,63 +1320,63 @@ int main(int argc, char* argv[])
     set_seed(seed);
     HPX_TEST_EQ(get_seed(), seed);
 
-    std::mt19937 gen(seed);
+    test_normal_distribution_implicit(seed);
 
-    test_normal_distribution_implicit(gen);
+    test_uniform_distribution_explicit(seed);
+    test_uniform_distribution_explicit_params(seed);
 
-    test_uniform_distribution_explicit(gen);
-    test_uniform_distribution_explicit_params(gen);
+    test_uniform_int_distribution_explicit(seed);
+    test_uniform_int_distribution_explicit_params(seed);
 
-    test_uniform_int_distribution_explicit(gen);
-    test_uniform_int_distribution_explicit_params(gen);
+    test_bernoulli_distribution(seed);
+    test_bernoulli_distribution_params(seed);
 
-    test_bernoulli_distribution(gen);
-    test_bernoulli_distribution_params(gen);
+    test_binomial_distribution(seed);
+    test_binomial_distribution_params(seed);
 
-    test_binomial_distribution(gen);
-    test_binomial_distribution_params(gen);
+    test_negative_binomial_distribution(seed);
+    test_negative_binomial_distribution_params(seed);
 
-    test_negative_binomial_distribution(gen);
-    test_negative_binomial_distribution_params(gen);
+    test_geometric_distribution(seed);
+    test_geometric_distribution_params(seed);
 
-    test_geometric_distribution(gen);
-    test_geometric_distribution_params(gen);
+    test_poisson_distribution(seed);
+    test_poisson_distribution_params(seed);
 
-    test_poisson_distribution(gen);
-    test_poisson_distribution_params(gen);
+    test_exponential_distribution(seed);
+    test_exponential_distribution_params(seed);
 
-    test_exponential_distribution(gen);
-    test_exponential_distribution_params(gen);
+    test_gamma_distribution(seed);
+    test_gamma_distribution_params(seed);
 
-    test_gamma_distribution(gen);
-    test_gamma_distribution_params(gen);
+    test_weibull_distribution(seed);
+    test_weibull_distribution_params(seed);
 
-    test_weibull_distribution(gen);
-    test_weibull_distribution_params(gen);
+    test_extreme_value_distribution(seed);
+    test_extreme_value_distribution_params(seed);
 
-    test_extreme_value_distribution(gen);
-    test_extreme_value_distribution_params(gen);
+    test_normal_distribution(seed);
+    test_normal_distribution_params(seed);
 
-    test_normal_distribution(gen);
-    test_normal_distribution_params(gen);
+    test_truncated_normal_distribution(seed);
+    test_truncated_normal_distribution_params(seed);
 
-    test_truncated_normal_distribution(gen);
-    test_truncated_normal_distribution_params(gen);
+    test_lognormal_distribution(seed);
+    test_lognormal_distribution_params(seed);
 
-    test_lognormal_distribution(gen);
-    test_lognormal_distribution_params(gen);
+    test_chi_squared_distribution(seed);
+    test_chi_squared_distribution_params(seed);
 
-    test_chi_squared_distribution(gen);
-    test_chi_squared_distribution_params(gen);
+    test_cauchy_distribution(seed);
+    test_cauchy_distribution_params(seed);
 
-    test_cauchy_distribution(gen);
-    test_cauchy_distribution_params(gen);
+    test_fisher_f_distribution(seed);
+    test_fisher_f_distribution_params(seed);
 
-    test_fisher_f_distribution(gen);
-    test_fisher_f_distribution_params(gen);
+    test_student_t_distribution(seed);
+    test_student_t_distribution_params(seed);
 
-    test_student_t_distribution(gen);
-    test_student_t_distribution_params(gen);
+    test_reseed(seed);
 
     return hpx::util::report_errors();
 }
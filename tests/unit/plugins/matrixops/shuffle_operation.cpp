@@ -13,6 +13,8 @@
 #include <hpx/util/lightweight_test.hpp>
 
 #include <algorithm>
+#include <cstddef>
+#include <cstdint>
 #include <utility>
 #include <vector>
 #include <blaze/Math.h>
@@ -113,10 +115,41 @@ void test_shuffle_operation_2d()
     }
 }
 
+void test_shuffle_operation_large()
+{
+    // large enough to be shuffled in parallel
+    std::size_t const size = 100000;
+
+    blaze::DynamicVector<std::int64_t> v(size);
+    for (std::size_t i = 0; i != size; ++i)
+    {
+        v[i] = std::int64_t(i);
+    }
+
+    phylanx::execution_tree::primitive p =
+        phylanx::execution_tree::primitives::create_shuffle_operation(
+            hpx::find_here(),
+            phylanx::execution_tree::primitive_arguments_type{
+                phylanx::ir::node_data<std::int64_t>{v}});
+
+    auto actual = phylanx::execution_tree::extract_integer_value(
+        p.eval().get()).vector();
+
+    // Has it changed?
+    HPX_TEST_NEQ(actual, v);
+
+    // Is it a permutation of the original data?
+    blaze::DynamicVector<std::int64_t> sorted = actual;
+    std::sort(sorted.begin(), sorted.end());
+    HPX_TEST_EQ(sorted, v);
+}
+
 int main(int argc, char* argv[])
 {
     test_shuffle_operation_1d();
 
+    test_shuffle_operation_large();
+
     test_shuffle_operation_2d();
 
     return hpx::util::report_errors();
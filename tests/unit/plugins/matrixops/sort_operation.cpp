@@ -0,0 +1,220 @@
+// Copyright (c) 2019 Hartmut Kaiser
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <phylanx/phylanx.hpp>
+
+#include <hpx/hpx_main.hpp>
+#include <hpx/include/lcos.hpp>
+#include <hpx/util/lightweight_test.hpp>
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <limits>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <blaze/Math.h>
+
+///////////////////////////////////////////////////////////////////////////////
+phylanx::execution_tree::primitive_argument_type compile_and_run(
+    std::string const& codestr)
+{
+    phylanx::execution_tree::compiler::function_list snippets;
+    phylanx::execution_tree::compiler::environment env =
+        phylanx::execution_tree::compiler::default_environment();
+
+    auto const& code = phylanx::execution_tree::compile(codestr, snippets, env);
+    return code.run();
+}
+
+void test_sort_operation(char const* code, char const* expectedstr)
+{
+    HPX_TEST_EQ(compile_and_run(code), compile_and_run(expectedstr));
+}
+
+///////////////////////////////////////////////////////////////////////////////
+void test_sort_large()
+{
+    // long enough to be sorted in parallel
+    std::size_t const size = 100000;
+
+    blaze::DynamicVector<std::int64_t> v(size);
+    blaze::DynamicVector<std::int64_t> expected(size);
+    blaze::DynamicVector<std::int64_t> expected_indices(size);
+    for (std::size_t i = 0; i != size; ++i)
+    {
+        v[i] = std::int64_t(size - i - 1);
+        expected[i] = std::int64_t(i);
+        expected_indices[i] = std::int64_t(size - i - 1);
+    }
+
+    phylanx::execution_tree::primitive sort =
+        phylanx::execution_tree::primitives::create_sort_operation(
+            hpx::find_here(),
+            phylanx::execution_tree::primitive_arguments_type{
+                phylanx::ir::node_data<std::int64_t>{v}});
+
+    HPX_TEST_EQ(phylanx::ir::node_data<std::int64_t>(std::move(expected)),
+        phylanx::execution_tree::extract_integer_value(sort.eval().get()));
+
+    phylanx::execution_tree::primitive argsort =
+        phylanx::execution_tree::primitives::create_argsort_operation(
+            hpx::find_here(),
+            phylanx::execution_tree::primitive_arguments_type{
+                phylanx::ir::node_data<std::int64_t>{std::move(v)}});
+
+    HPX_TEST_EQ(
+        phylanx::ir::node_data<std::int64_t>(std::move(expected_indices)),
+        phylanx::execution_tree::extract_integer_value(argsort.eval().get()));
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// NaNs are ordered after all other values
+void test_sort_nan(std::size_t size)
+{
+    double const nan = std::numeric_limits<double>::quiet_NaN();
+
+    blaze::DynamicVector<double> v(size);
+    for (std::size_t i = 0; i != size; ++i)
+    {
+        v[i] = (i % 3 == 0) ? nan : double(size - i);
+    }
+    std::size_t const nans = (size + 2) / 3;
+
+    phylanx::execution_tree::primitive sort =
+        phylanx::execution_tree::primitives::create_sort_operation(
+            hpx::find_here(),
+            phylanx::execution_tree::primitive_arguments_type{
+                phylanx::ir::node_data<double>{v}});
+
+    phylanx::execution_tree::primitive argsort =
+        phylanx::execution_tree::primitives::create_argsort_operation(
+            hpx::find_here(),
+            phylanx::execution_tree::primitive_arguments_type{
+                phylanx::ir::node_data<double>{v}});
+
+    auto sorted = phylanx::execution_tree::extract_numeric_value(
+        sort.eval().get()).vector();
+    HPX_TEST_EQ(sorted.size(), size);
+    for (std::size_t i = 0; i != size; ++i)
+    {
+        if (i < size - nans)
+        {
+            HPX_TEST(!std::isnan(sorted[i]));
+            HPX_TEST(i == 0 || sorted[i - 1] <= sorted[i]);
+        }
+        else
+        {
+            HPX_TEST(std::isnan(sorted[i]));
+        }
+    }
+
+    // the indices of the NaNs keep their original order
+    auto indices = phylanx::execution_tree::extract_integer_value(
+        argsort.eval().get()).vector();
+    HPX_TEST_EQ(indices.size(), size);
+    for (std::size_t i = 0; i != size; ++i)
+    {
+        if (i < size - nans)
+        {
+            HPX_TEST_EQ(v[indices[i]], sorted[i]);
+        }
+        else
+        {
+            HPX_TEST_EQ(indices[i], std::int64_t(3 * (i - (size - nans))));
+        }
+    }
+}
+
+void test_sort_nan_2d()
+{
+    double const nan = std::numeric_limits<double>::quiet_NaN();
+
+    blaze::DynamicMatrix<double> m{{nan, 2.0, 1.0}, {3.0, nan, 0.0}};
+
+    for (std::int64_t axis : {std::int64_t(0), std::int64_t(1)})
+    {
+        phylanx::execution_tree::primitive p =
+            phylanx::execution_tree::primitives::create_sort_operation(
+                hpx::find_here(),
+                phylanx::execution_tree::primitive_arguments_type{
+                    phylanx::ir::node_data<double>{m},
+                    phylanx::ir::node_data<std::int64_t>{axis}});
+
+        auto result =
+            phylanx::execution_tree::extract_numeric_value(p.eval().get())
+                .matrix();
+
+        if (axis == 1)
+        {
+            HPX_TEST_EQ(result(0, 0), 1.0);
+            HPX_TEST_EQ(result(0, 1), 2.0);
+            HPX_TEST(std::isnan(result(0, 2)));
+            HPX_TEST_EQ(result(1, 0), 0.0);
+            HPX_TEST_EQ(result(1, 1), 3.0);
+            HPX_TEST(std::isnan(result(1, 2)));
+        }
+        else
+        {
+            HPX_TEST_EQ(result(0, 0), 3.0);
+            HPX_TEST(std::isnan(result(1, 0)));
+            HPX_TEST_EQ(result(0, 1), 2.0);
+            HPX_TEST(std::isnan(result(1, 1)));
+            HPX_TEST_EQ(result(0, 2), 0.0);
+            HPX_TEST_EQ(result(1, 2), 1.0);
+        }
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    // sort
+    test_sort_operation("sort(42)", "[42]");
+    test_sort_operation("sort([3, 1, 2])", "[1, 2, 3]");
+    test_sort_operation(
+        "sort([3.0, -1.0, 2.5, -1.0])", "[-1.0, -1.0, 2.5, 3.0]");
+    test_sort_operation("sort([true, false, true])", "[false, true, true]");
+    test_sort_operation(
+        "sort([[3, 1, 2], [0, 5, 4]])", "[[1, 2, 3], [0, 4, 5]]");
+    test_sort_operation(
+        "sort([[3, 1, 2], [0, 5, 4]], 0)", "[[0, 1, 2], [3, 5, 4]]");
+    test_sort_operation(
+        "sort([[3, 1, 2], [0, 5, 4]], -2)", "[[0, 1, 2], [3, 5, 4]]");
+    test_sort_operation(
+        "sort([[3, 1, 2], [0, 5, 4]], nil)", "[0, 1, 2, 3, 4, 5]");
+
+    // argsort
+    test_sort_operation("argsort([3, 1, 2])", "[1, 2, 0]");
+    test_sort_operation("argsort([2, 1, 2, 1])", "[1, 3, 0, 2]");
+    test_sort_operation(
+        "argsort([[3, 1, 2], [0, 5, 4]])", "[[1, 2, 0], [0, 2, 1]]");
+    test_sort_operation(
+        "argsort([[3, 1, 2], [0, 5, 4]], 0)", "[[1, 0, 0], [0, 1, 1]]");
+    test_sort_operation(
+        "argsort([[3, 1, 2], [0, 5, 4]], nil)", "[3, 1, 2, 0, 5, 4]");
+
+    // searchsorted
+    test_sort_operation("searchsorted([1, 2, 3, 4, 5], 3)", "2");
+    test_sort_operation(
+        "searchsorted([1, 2, 3, 4, 5], 3, \"left\")", "2");
+    test_sort_operation(
+        "searchsorted([1, 2, 3, 4, 5], 3, \"right\")", "3");
+    test_sort_operation(
+        "searchsorted([1, 2, 3, 4, 5], [-10, 10, 2, 3])", "[0, 5, 1, 2]");
+    test_sort_operation(
+        "searchsorted([1.0, 2.0, 2.0, 3.0], [[2.0], [2.5]], \"right\")",
+        "[[3], [3]]");
+
+    test_sort_large();
+
+    test_sort_nan(10);
+    test_sort_nan(100000);
+    test_sort_nan_2d();
+
+    return hpx::util::report_errors();
+}
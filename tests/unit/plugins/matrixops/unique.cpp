@@ -13,6 +13,7 @@
 
 #include <cstddef>
 #include <cstdint>
+#include <string>
 #include <utility>
 #include <vector>
 
@@ -137,6 +138,24 @@ void test_unique_2d_y_axis()
     HPX_TEST_EQ(expected, actual);
 }
 
+///////////////////////////////////////////////////////////////////////////////
+phylanx::execution_tree::primitive_argument_type compile_and_run(
+    std::string const& codestr)
+{
+    phylanx::execution_tree::compiler::function_list snippets;
+    phylanx::execution_tree::compiler::environment env =
+        phylanx::execution_tree::compiler::default_environment();
+
+    auto const& code = phylanx::execution_tree::compile(codestr, snippets, env);
+    return code.run();
+}
+
+void test_unique_operation(char const* code, char const* expectedstr)
+{
+    HPX_TEST_EQ(compile_and_run(code), compile_and_run(expectedstr));
+}
+
+///////////////////////////////////////////////////////////////////////////////
 int main(int argc, char* argv[])
 {
     test_unique_0d();
@@ -145,5 +164,22 @@ int main(int argc, char* argv[])
     test_unique_2d_x_axis();
     test_unique_2d_y_axis();
 
+    test_unique_operation("unique([3, 1, 3, 2, 1], nil, true)",
+        "list([1, 2, 3], [1, 3, 0])");
+    test_unique_operation("unique([3, 1, 3, 2, 1], nil, false, true)",
+        "list([1, 2, 3], [2, 1, 2])");
+    test_unique_operation("unique([3, 1, 3, 2, 1], nil, true, true)",
+        "list([1, 2, 3], [1, 3, 0], [2, 1, 2])");
+    test_unique_operation(
+        "unique([3, 1, 3, 2, 1], nil, false, false, false)", "[3, 1, 2]");
+    test_unique_operation(
+        "unique([3, 1, 3, 2, 1], nil, true, true, false)",
+        "list([3, 1, 2], [0, 1, 3], [2, 2, 1])");
+    test_unique_operation("unique([[1, 2], [0, 1], [1, 2]], 0)",
+        "[[0, 1], [1, 2]]");
+    test_unique_operation(
+        "unique([[1, 2], [0, 1], [1, 2]], 0, true, true, false)",
+        "list([[1, 2], [0, 1]], [0, 1], [2, 1])");
+
     return hpx::util::report_errors();
 }
@@ -68,9 +68,93 @@ void test_decomposition(std::string const& func_name)
         *it);
 }
 
+///////////////////////////////////////////////////////////////////////////////
+bool run_decomposition_test(std::string const& codestr)
+{
+    phylanx::execution_tree::compiler::function_list snippets;
+    auto const& code = phylanx::execution_tree::compile(codestr, snippets);
+    auto f = code.run();
+
+    return phylanx::execution_tree::extract_scalar_boolean_value(f()) != 0;
+}
+
+void test_decomposition_cholesky()
+{
+    HPX_TEST(run_decomposition_test(R"(block(
+        define(A, [[4, 12, -16], [12, 37, -43], [-16, -43, 98]]),
+        define(L, cholesky(A)),
+        all(absolute(L - [[2, 0, 0], [6, 1, 0], [-8, 5, 3]]) < 1e-10)
+    ))"));
+}
+
+void test_decomposition_qr()
+{
+    HPX_TEST(run_decomposition_test(R"(block(
+        define(A, [[12, -51, 4], [6, 167, -68], [-4, 24, -41]]),
+        define(f, qr(A)),
+        define(Q, slice(f, 0)),
+        define(R, slice(f, 1)),
+        all(absolute(dot(Q, R) - A) < 1e-10) &&
+            all(absolute(dot(transpose(Q), Q) - identity(3)) < 1e-10) &&
+            absolute(slice(R, 2, 0)) + absolute(slice(R, 2, 1)) +
+                absolute(slice(R, 1, 0)) < 1e-10
+    ))"));
+}
+
+void test_decomposition_svd()
+{
+    HPX_TEST(run_decomposition_test(R"(block(
+        define(A, [[3, 2, 2], [2, 3, -2]]),
+        define(f, svd(A)),
+        define(U, slice(f, 0)),
+        define(s, slice(f, 1)),
+        define(V, slice(f, 2)),
+        all(absolute(s - [5, 3]) < 1e-10) &&
+            all(absolute(dot(dot(U, diag(s)), V) - A) < 1e-10)
+    ))"));
+
+    // a matrix of rank 2, the truncated decomposition is exact
+    HPX_TEST(run_decomposition_test(R"(block(
+        define(x, random(make_list(60, 2))),
+        define(y, random(make_list(2, 40))),
+        define(A, dot(x, y)),
+        define(f, svd(A, 2)),
+        define(U, slice(f, 0)),
+        define(s, slice(f, 1)),
+        define(V, slice(f, 2)),
+        shape(s, 0) == 2 &&
+            all(absolute(dot(dot(U, diag(s)), V) - A) < 1e-8)
+    ))"));
+}
+
+void test_decomposition_eigh()
+{
+    HPX_TEST(run_decomposition_test(R"(block(
+        define(A, [[2, -1, 0], [-1, 2, -1], [0, -1, 2]]),
+        define(f, eigh(A)),
+        define(w, slice(f, 0)),
+        define(V, slice(f, 1)),
+        all(absolute(w - [2 - sqrt(2.0), 2, 2 + sqrt(2.0)]) < 1e-10) &&
+            all(absolute(dot(A, V) - dot(V, diag(w))) < 1e-10)
+    ))"));
+
+    // only the lower triangle is used
+    HPX_TEST(run_decomposition_test(R"(block(
+        define(A, [[2, 7, 7], [-1, 2, 7], [0, -1, 2]]),
+        define(f, eigh(A)),
+        define(w, slice(f, 0)),
+        all(absolute(w - [2 - sqrt(2.0), 2, 2 + sqrt(2.0)]) < 1e-10)
+    ))"));
+}
+
 int main()
 {
     test_decomposition_lu_PhySL();
     test_decomposition("lu");
+
+    test_decomposition_cholesky();
+    test_decomposition_qr();
+    test_decomposition_svd();
+    test_decomposition_eigh();
     return hpx::util::report_errors();
 }
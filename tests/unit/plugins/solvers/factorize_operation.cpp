@@ -0,0 +1,88 @@
+// Copyright (c) 2019 Hartmut Kaiser
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <phylanx/phylanx.hpp>
+
+#include <hpx/hpx_main.hpp>
+#include <hpx/util/lightweight_test.hpp>
+
+#include <string>
+
+///////////////////////////////////////////////////////////////////////////////
+bool run_factorize_test(std::string const& codestr)
+{
+    phylanx::execution_tree::compiler::function_list snippets;
+    auto const& code = phylanx::execution_tree::compile(codestr, snippets);
+    auto f = code.run();
+
+    return phylanx::execution_tree::extract_scalar_boolean_value(f()) != 0;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+void test_factorize_lu()
+{
+    HPX_TEST(run_factorize_test(R"(block(
+        define(A, [[10, -10, 0], [-3, 15, 6], [5, 7, 5]]),
+        define(f, factorize(A)),
+        define(b1, [1, 2, 3]),
+        define(b2, [-4, 0, 7]),
+        all(absolute(dot(A, solve(f, b1)) - b1) < 1e-10) &&
+            all(absolute(dot(A, solve(f, b2)) - b2) < 1e-10)
+    ))"));
+}
+
+void test_factorize_lu_matrix_rhs()
+{
+    HPX_TEST(run_factorize_test(R"(block(
+        define(A, [[10, -10, 0], [-3, 15, 6], [5, 7, 5]]),
+        define(f, factorize(A, "lu")),
+        define(B, [[1, 0], [2, 1], [3, -1]]),
+        define(X, solve(f, B)),
+        shape(X, 0) == 3 && shape(X, 1) == 2 &&
+            all(absolute(dot(A, X) - B) < 1e-10)
+    ))"));
+}
+
+void test_factorize_cholesky()
+{
+    HPX_TEST(run_factorize_test(R"(block(
+        define(A, [[4, 12, -16], [12, 37, -43], [-16, -43, 98]]),
+        define(f, factorize(A, "cholesky")),
+        define(b, [1, 2, 3]),
+        all(absolute(dot(A, solve(f, b)) - b) < 1e-10)
+    ))"));
+}
+
+void test_factorize_ldlt()
+{
+    // symmetric, but indefinite
+    HPX_TEST(run_factorize_test(R"(block(
+        define(A, [[1, 2, 3], [2, -4, 5], [3, 5, 6]]),
+        define(f, factorize(A, "ldlt")),
+        define(B, [[1, 0], [2, 1], [3, -1]]),
+        all(absolute(dot(A, solve(f, B)) - B) < 1e-10)
+    ))"));
+}
+
+void test_solve_matrix()
+{
+    HPX_TEST(run_factorize_test(R"(block(
+        define(A, [[2, 1], [1, 3]]),
+        define(b, [3, 5]),
+        all(absolute(solve(A, b) - [0.8, 1.4]) < 1e-10)
+    ))"));
+}
+
+///////////////////////////////////////////////////////////////////////////////
+int main()
+{
+    test_factorize_lu();
+    test_factorize_lu_matrix_rhs();
+    test_factorize_cholesky();
+    test_factorize_ldlt();
+    test_solve_matrix();
+
+    return hpx::util::report_errors();
+}
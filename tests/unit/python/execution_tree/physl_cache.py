@@ -0,0 +1,54 @@
+# Copyright (c) 2019 Hartmut Kaiser
+#
+# Distributed under the Boost Software License, Version 1.0. (See accompanying
+# file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+import os
+import shutil
+import tempfile
+import numpy as np
+from phylanx import Phylanx
+from phylanx.ast.physl_cache import physl_cache, phylanx_version
+
+cache_dir = tempfile.mkdtemp()
+
+
+def decorate(**kwargs):
+    def foo(m):
+        return np.array([m, 2 * m])
+    return Phylanx(cache_dir=cache_dir, **kwargs)(foo)
+
+
+try:
+    # the version of the extension module is part of the cache key
+    assert phylanx_version() != '<unknown>'
+
+    physl_cache.clear()
+
+    # the first decoration generates PhySL and populates the cache
+    foo1 = decorate()
+    assert physl_cache.misses == 1 and physl_cache.hits == 0
+    assert len(os.listdir(cache_dir)) == 1
+    assert (foo1(1) == np.array([1, 2])).all()
+
+    # decorating the same function again is served from the memory cache
+    foo2 = decorate()
+    assert physl_cache.hits == 1
+    assert foo1.__src__ == foo2.__src__
+    assert (foo2(2) == np.array([2, 4])).all()
+
+    # entries are reloaded from disk after the in-memory cache was dropped
+    physl_cache.clear()
+    foo3 = decorate()
+    assert physl_cache.hits == 1 and physl_cache.misses == 0
+    assert foo1.__src__ == foo3.__src__
+    assert (foo3(3) == np.array([3, 6])).all()
+
+    # caching can be disabled per function
+    physl_cache.clear()
+    foo4 = decorate(cache=False)
+    assert physl_cache.hits == 0 and physl_cache.misses == 0
+    assert foo1.__src__ == foo4.__src__
+
+finally:
+    shutil.rmtree(cache_dir)
@@ -33,3 +33,14 @@ def test_prange_list():
 
 
 test_prange_list()
+
+
+@Phylanx
+def test_prange_schedule():
+    arr = np.array([0, 0, 0, 0, 0, 0, 0, 0])
+    for i in prange(0, 8, schedule="static", chunk_size=2):
+        arr[i] = 2 * i
+    return arr
+
+
+assert (test_prange_schedule() == np.array([0, 2, 4, 6, 8, 10, 12, 14])).all()
@@ -0,0 +1,97 @@
+//  Copyright (c) 2019 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <phylanx/config.hpp>
+#include <phylanx/util/hashed_string.hpp>
+#include <phylanx/util/interned_string.hpp>
+
+#include <hpx/hpx_main.hpp>
+#include <hpx/include/serialization.hpp>
+#include <hpx/util/jenkins_hash.hpp>
+#include <hpx/util/lightweight_test.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+void test_interned_string()
+{
+    phylanx::util::interned_string empty;
+    HPX_TEST(empty.empty());
+    HPX_TEST_EQ(empty.id(), std::uint32_t(0));
+    HPX_TEST(empty == phylanx::util::interned_string(""));
+
+    std::size_t const count = phylanx::util::interned_string_count();
+
+    phylanx::util::interned_string s1("interned_string_test_1");
+    phylanx::util::interned_string s2(std::string("interned_string_test_1"));
+    phylanx::util::interned_string s3("interned_string_test_2");
+
+    HPX_TEST(s1 == s2);
+    HPX_TEST(s1 != s3);
+    HPX_TEST_EQ(s1.id(), s2.id());
+    HPX_TEST_NEQ(s1.id(), s3.id());
+    HPX_TEST_EQ(&s1.str(), &s2.str());
+    HPX_TEST_EQ(s1.str(), std::string("interned_string_test_1"));
+    HPX_TEST_EQ(s1.hash(), hpx::util::jenkins_hash{}(s1.str()));
+
+    HPX_TEST_LTE(count + 2, phylanx::util::interned_string_count());
+
+    std::unordered_set<phylanx::util::interned_string> set;
+    set.insert(s1);
+    set.insert(s2);
+    set.insert(s3);
+    HPX_TEST_EQ(set.size(), std::size_t(2));
+}
+
+void test_hashed_string()
+{
+    std::map<phylanx::util::hashed_string, int> m;
+    m["a"] = 1;
+    m[std::string("b")] = 2;
+    m[phylanx::util::interned_string("c")] = 3;
+    m["a"] = 4;
+
+    HPX_TEST_EQ(m.size(), std::size_t(3));
+    HPX_TEST_EQ(m["a"], 4);
+    HPX_TEST_EQ(m["b"], 2);
+    HPX_TEST_EQ(m["c"], 3);
+
+    phylanx::util::hashed_string h("a");
+    HPX_TEST(h == phylanx::util::hashed_string(std::string("a")));
+    HPX_TEST(h.symbol() == phylanx::util::interned_string("a"));
+    HPX_TEST(!(h < h));
+}
+
+void test_serialization()
+{
+    std::vector<char> buffer;
+    hpx::serialization::output_archive oar(buffer);
+    hpx::serialization::input_archive iar(buffer);
+
+    phylanx::util::interned_string os("interned_string_serialization");
+    phylanx::util::hashed_string oh("hashed_string_serialization");
+    oar << os << oh;
+
+    phylanx::util::interned_string is;
+    phylanx::util::hashed_string ih;
+    iar >> is >> ih;
+
+    HPX_TEST(is == os);
+    HPX_TEST(ih == oh);
+    HPX_TEST_EQ(ih.hash(), oh.hash());
+}
+
+int main()
+{
+    test_interned_string();
+    test_hashed_string();
+    test_serialization();
+
+    return hpx::util::report_errors();
+}
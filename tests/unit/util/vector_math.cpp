@@ -0,0 +1,204 @@
+//  Copyright (c) 2019 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <phylanx/phylanx.hpp>
+#include <phylanx/util/vector_math.hpp>
+
+#include <hpx/hpx_main.hpp>
+#include <hpx/util/lightweight_test.hpp>
+
+#include <cmath>
+#include <cstddef>
+#include <limits>
+#include <string>
+#include <vector>
+
+///////////////////////////////////////////////////////////////////////////////
+struct function_case
+{
+    char const* name;
+    double (*reference)(double);
+    double min, max;            // the range of the tested arguments
+    double tolerance;           // the maximal relative error of the kernel
+};
+
+double ref_exp(double x) { return std::exp(x); }
+double ref_log(double x) { return std::log(x); }
+double ref_tanh(double x) { return std::tanh(x); }
+double ref_erf(double x) { return std::erf(x); }
+double ref_erfc(double x) { return std::erfc(x); }
+double ref_cbrt(double x) { return std::cbrt(x); }
+double ref_asinh(double x) { return std::asinh(x); }
+
+function_case const cases[] =
+{
+    {"exp", &ref_exp, -708.0, 709.0, 4e-16},
+    {"log", &ref_log, 1e-300, 1e300, 4e-16},
+    {"tanh", &ref_tanh, -20.0, 20.0, 8e-16},
+    {"erf", &ref_erf, -6.0, 6.0, 1e-15},
+    {"erfc", &ref_erfc, -6.0, 26.0, 2e-15},
+    {"cbrt", &ref_cbrt, -1e300, 1e300, 1e-15},
+    {"arcsinh", &ref_asinh, -1e10, 1e10, 8e-16}
+};
+
+// arguments spread logarithmically over the given range, for ranges
+// including zero the magnitudes are spread between 0 and the range limits
+std::vector<double> make_arguments(function_case const& c, std::size_t size)
+{
+    std::vector<double> result(size);
+    for (std::size_t i = 0; i != size; ++i)
+    {
+        double const t = double(i) / double(size - 1);
+
+        double x = 0.0;
+        if (c.min < 0)
+        {
+            double const u = 2.0 * t - 1.0;
+            double const limit = u < 0 ? -c.min : c.max;
+            x = std::copysign(
+                std::pow(limit + 1.0, std::abs(u)) - 1.0, u);
+        }
+        else
+        {
+            x = c.min * std::pow(c.max / c.min, t);
+        }
+        result[i] = x < c.min ? c.min : (x > c.max ? c.max : x);
+    }
+    return result;
+}
+
+bool is_close(double value, double expected, double tolerance)
+{
+    if (std::isnan(expected))
+    {
+        return std::isnan(value);
+    }
+    if (std::isinf(expected) || expected == 0.0)
+    {
+        return value == expected;
+    }
+    return std::abs(value - expected) <= tolerance * std::abs(expected);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+void test_function(function_case const& c, phylanx::util::math_accuracy acc)
+{
+    phylanx::util::math_function f;
+    HPX_TEST(phylanx::util::parse_math_function(c.name, f));
+
+    double const tolerance =
+        acc == phylanx::util::math_accuracy::fast ? c.tolerance : 0.0;
+
+    // large enough to be evaluated in parallel
+    std::vector<double> const args = make_arguments(c, 100000);
+    std::vector<double> result(args.size());
+
+    phylanx::util::apply_math_function(f, args.data(), args.size(),
+        result.data(), result.size(), 1, args.size(), acc);
+
+    for (std::size_t i = 0; i != args.size(); ++i)
+    {
+        if (!is_close(result[i], c.reference(args[i]), tolerance))
+        {
+            HPX_TEST_MSG(false, (std::string(c.name) + "(" +
+                std::to_string(args[i]) + ")").c_str());
+            break;
+        }
+    }
+}
+
+void test_special_values(phylanx::util::math_accuracy acc)
+{
+    double const inf = std::numeric_limits<double>::infinity();
+    double const nan = std::numeric_limits<double>::quiet_NaN();
+
+    std::vector<double> const args = {0.0, -0.0, inf, -inf, nan, 1e-310,
+        -1e-310, 0.5, 1.5, 2.5, 4.5, 30.0, -30.0, 710.0, -750.0};
+
+    for (auto const& c : cases)
+    {
+        phylanx::util::math_function f;
+        phylanx::util::parse_math_function(c.name, f);
+
+        std::vector<double> result(args);
+        phylanx::util::apply_math_function(f, result.data(), result.size(),
+            result.data(), result.size(), 1, result.size(), acc);
+
+        for (std::size_t i = 0; i != args.size(); ++i)
+        {
+            double const expected = c.reference(args[i]);
+            HPX_TEST(is_close(result[i], expected, 4 * c.tolerance));
+            if (!std::isnan(expected))
+            {
+                HPX_TEST_EQ(std::signbit(result[i]), std::signbit(expected));
+            }
+        }
+    }
+}
+
+void test_matrix(phylanx::util::math_accuracy acc)
+{
+    // only the elements of the rows are touched, not the padding
+    std::size_t const rows = 7;
+    std::size_t const columns = 13;
+    std::size_t const spacing = 16;
+
+    std::vector<double> in(rows * spacing, -1.0);
+    std::vector<double> out(rows * spacing, -1.0);
+    for (std::size_t i = 0; i != rows; ++i)
+    {
+        for (std::size_t j = 0; j != columns; ++j)
+        {
+            in[i * spacing + j] = 0.1 * double(i * columns + j) - 4.0;
+        }
+    }
+
+    phylanx::util::math_function f;
+    phylanx::util::parse_math_function("tanh", f);
+    phylanx::util::apply_math_function(
+        f, in.data(), spacing, out.data(), spacing, rows, columns, acc);
+
+    for (std::size_t i = 0; i != rows; ++i)
+    {
+        for (std::size_t j = 0; j != spacing; ++j)
+        {
+            double const expected =
+                j < columns ? std::tanh(in[i * spacing + j]) : -1.0;
+            HPX_TEST(is_close(out[i * spacing + j], expected, 1e-15));
+        }
+    }
+}
+
+void test_parse()
+{
+    phylanx::util::math_function f;
+    HPX_TEST(!phylanx::util::parse_math_function("sin", f));
+
+    phylanx::util::math_accuracy acc;
+    HPX_TEST(phylanx::util::parse_math_accuracy("fast", acc));
+    HPX_TEST(acc == phylanx::util::math_accuracy::fast);
+    HPX_TEST(phylanx::util::parse_math_accuracy("accurate", acc));
+    HPX_TEST(acc == phylanx::util::math_accuracy::accurate);
+    HPX_TEST(!phylanx::util::parse_math_accuracy("precise", acc));
+}
+
+///////////////////////////////////////////////////////////////////////////////
+int main(int argc, char* argv[])
+{
+    for (auto acc : {phylanx::util::math_accuracy::accurate,
+             phylanx::util::math_accuracy::fast})
+    {
+        for (auto const& c : cases)
+        {
+            test_function(c, acc);
+        }
+        test_special_values(acc);
+        test_matrix(acc);
+    }
+
+    test_parse();
+
+    return hpx::util::report_errors();
+}
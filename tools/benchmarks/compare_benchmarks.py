@@ -0,0 +1,95 @@
+#!/usr/bin/env python
+# Copyright (c) 2019 Hartmut Kaiser
+#
+# Distributed under the Boost Software License, Version 1.0. (See accompanying
+# file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+# ## Synopsis
+# ```
+# usage: compare_benchmarks.py [-h] [--metric METRIC] [--threshold PERCENT]
+#                              baseline current
+#
+# Compare the JSON results of two runs of a Phylanx benchmark (for instance
+# tests.performance.primitives) and list the measurements which got slower
+#
+# positional arguments:
+#   baseline             results of the reference build
+#   current              results of the build to check
+#
+# optional arguments:
+#   -h, --help           show this help message and exit
+#   --metric METRIC      the value to compare (default: call_ns)
+#   --threshold PERCENT  report changes larger than this (default: 10)
+# ```
+#
+# The script exits with a non-zero status if any regression was found.
+# Measurements are matched by all their non-numeric fields and by the shape,
+# the size, and the number of threads.
+
+import argparse
+import json
+import sys
+
+
+def load_results(filename):
+    with open(filename) as f:
+        return json.load(f)['results']
+
+
+key_fields = ('shape', 'size', 'threads')
+
+
+def result_key(result):
+    return tuple(sorted(
+        (k, json.dumps(v)) for k, v in result.items()
+        if k in key_fields or not isinstance(v, (int, float))))
+
+
+def format_key(key):
+    return ' '.join('%s=%s' % (k, json.loads(v)) for k, v in key)
+
+
+def main():
+    parser = argparse.ArgumentParser(
+        description='Compare the JSON results of two benchmark runs')
+    parser.add_argument('baseline', help='results of the reference build')
+    parser.add_argument('current', help='results of the build to check')
+    parser.add_argument('--metric', default='call_ns',
+                        help='the value to compare (default: call_ns)')
+    parser.add_argument('--threshold', type=float, default=10.0,
+                        help='report changes larger than this percentage '
+                             '(default: 10)')
+    args = parser.parse_args()
+
+    baseline = {result_key(r): r for r in load_results(args.baseline)}
+    current = {result_key(r): r for r in load_results(args.current)}
+
+    regressions = 0
+    improvements = 0
+    for key in sorted(set(baseline) & set(current)):
+        old = baseline[key].get(args.metric)
+        new = current[key].get(args.metric)
+        if not old or new is None:
+            continue
+
+        change = 100.0 * (new - old) / old
+        if change > args.threshold:
+            regressions += 1
+            print('slower  %+7.1f%%  %s' % (change, format_key(key)))
+        elif change < -args.threshold:
+            improvements += 1
+            print('faster  %+7.1f%%  %s' % (change, format_key(key)))
+
+    for key in sorted(set(baseline) - set(current)):
+        print('missing           %s' % format_key(key))
+
+    print('%d measurements compared, %d slower, %d faster, %d missing, '
+          '%d new' % (len(set(baseline) & set(current)), regressions,
+                      improvements, len(set(baseline) - set(current)),
+                      len(set(current) - set(baseline))))
+
+    return 1 if regressions != 0 else 0
+
+
+if __name__ == '__main__':
+    sys.exit(main())
@@ -0,0 +1,149 @@
+#!/usr/bin/env python
+# Copyright (c) 2019 Hartmut Kaiser
+#
+# Distributed under the Boost Software License, Version 1.0. (See accompanying
+# file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+# ## Synopsis
+# ```
+# usage: scaling.py [-h] [--algorithms LIST] [--size SIZE]
+#                   [--threads THREADS] [--mode {strong,weak,both}]
+#                   [--repetitions N] [--output FILE]
+#                   executable
+#
+# Run the algorithm benchmark (tests.performance.algorithms) for a range of
+# HPX thread counts and report the strong and/or weak scaling
+#
+# positional arguments:
+#   executable            path to the algorithms_test executable
+#
+# optional arguments:
+#   -h, --help            show this help message and exit
+#   --algorithms LIST     comma separated algorithms (default: all)
+#   --size SIZE           problem size for a single thread (default: 1000)
+#   --threads THREADS     maximal number of threads (default: all cores)
+#   --mode {strong,weak,both}
+#                         scaling mode (default: both)
+#   --repetitions N       measured runs for each configuration (default: 3)
+#   --output FILE         write the results as JSON to this file
+# ```
+#
+# Strong scaling keeps the problem size fixed, the speedup is t(1) / t(n) and
+# the parallel efficiency is speedup / n. Weak scaling grows the problem size
+# with the number of threads, the parallel efficiency is t(1) / t(n). The
+# written JSON can be compared with tools/benchmarks/compare_benchmarks.py
+# (--metric time_s).
+
+import argparse
+import json
+import multiprocessing
+import os
+import subprocess
+import sys
+import tempfile
+
+algorithms = ['als', 'kmeans', 'lir', 'lra', 'nn']
+
+
+def thread_counts(max_threads):
+    counts = []
+    n = 1
+    while n < max_threads:
+        counts.append(n)
+        n *= 2
+    counts.append(max_threads)
+    return counts
+
+
+def run_benchmark(executable, algorithm, size, threads, repetitions):
+    fd, output = tempfile.mkstemp(suffix='.json')
+    os.close(fd)
+    try:
+        subprocess.check_call([
+            executable, '--algorithm=%s' % algorithm, '--size=%d' % size,
+            '--repetitions=%d' % repetitions, '--output=%s' % output,
+            '--hpx:threads=%d' % threads])
+        with open(output) as f:
+            return json.load(f)['results'][0]
+    finally:
+        os.remove(output)
+
+
+def format_bytes(n):
+    for unit in ['B', 'KB', 'MB', 'GB']:
+        if n < 1024:
+            return '%.1f%s' % (n, unit)
+        n /= 1024.0
+    return '%.1fTB' % n
+
+
+def print_table(mode, algorithm, rows):
+    print('\n%s scaling: %s' % (mode, algorithm))
+    print('%8s %10s %12s %9s %11s %12s %12s' % (
+        'threads', 'size', 'time (s)', 'speedup', 'efficiency',
+        'peak arrays', 'peak rss'))
+    for r in rows:
+        print('%8d %10d %12.4f %9.2f %10.1f%% %12s %12s' % (
+            r['threads'], r['size'], r['time_s'], r['speedup'],
+            100.0 * r['efficiency'], format_bytes(r['peak_array_bytes']),
+            format_bytes(r['peak_rss_bytes'])))
+
+
+def main():
+    parser = argparse.ArgumentParser(
+        description='Run the algorithm benchmark for a range of thread '
+                    'counts and report the strong and/or weak scaling')
+    parser.add_argument('executable',
+                        help='path to the algorithms_test executable')
+    parser.add_argument('--algorithms', default=','.join(algorithms),
+                        help='comma separated algorithms (default: all)')
+    parser.add_argument('--size', type=int, default=1000,
+                        help='problem size for a single thread '
+                             '(default: 1000)')
+    parser.add_argument('--threads', type=int,
+                        default=multiprocessing.cpu_count(),
+                        help='maximal number of threads (default: all cores)')
+    parser.add_argument('--mode', choices=['strong', 'weak', 'both'],
+                        default='both', help='scaling mode (default: both)')
+    parser.add_argument('--repetitions', type=int, default=3,
+                        help='measured runs for each configuration '
+                             '(default: 3)')
+    parser.add_argument('--output', help='write the results as JSON to this '
+                                         'file')
+    args = parser.parse_args()
+
+    modes = ['strong', 'weak'] if args.mode == 'both' else [args.mode]
+
+    results = []
+    for algorithm in args.algorithms.split(','):
+        for mode in modes:
+            rows = []
+            for threads in thread_counts(args.threads):
+                size = args.size * threads if mode == 'weak' else args.size
+                r = run_benchmark(args.executable, algorithm, size, threads,
+                                  args.repetitions)
+
+                base = rows[0]['time_s'] if rows else r['time_s']
+                speedup = base / r['time_s'] if r['time_s'] else 0.0
+                if mode == 'weak':
+                    r['speedup'] = speedup * threads
+                    r['efficiency'] = speedup
+                else:
+                    r['speedup'] = speedup
+                    r['efficiency'] = speedup / threads
+                r['mode'] = mode
+                rows.append(r)
+
+            print_table(mode, algorithm, rows)
+            results.extend(rows)
+
+    if args.output:
+        with open(args.output, 'w') as f:
+            json.dump({'benchmark': 'scaling', 'results': results}, f,
+                      indent=1, sort_keys=True)
+
+    return 0
+
+
+if __name__ == '__main__':
+    sys.exit(main())